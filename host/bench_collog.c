@@ -0,0 +1,207 @@
+// 열 지향 로그 채널 추출 벤치마크
+//
+// 합성 비행 데이터(flight_synth)로 같은 내용의 두 파일을 만듭니다.
+//   - 행 지향: flight_record_t를 그대로 이어 붙인 파일
+//   - 열 지향: 펌웨어 collog 작성기로 기록한 파일
+// 그 뒤 채널 하나(전체 구간 / 60초 구간)를 꺼내는 시간을 비교하고 값이 같은지 확인합니다.
+// 마지막으로 u32 us 타임스탬프가 넘치는(71.6분 이상 켜져 있던) 로그에서 넘침을 가로지르는 구간을 확인합니다.
+//
+// 사용법: bench_collog [size_mb] [dir]
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "collog.h"
+#include "collog_reader.h"
+#include "flight_record.h"
+#include "flight_synth.h"
+
+#define REPEAT 5
+#define WRAP_RECORDS 120000u               // 넘침 확인 로그: 120 s, 60 s 지점에서 u32 타임스탬프가 넘침
+#define WRAP_START_US (UINT32_MAX - 60000000u)
+
+static FILE *out_file;
+
+static bool sink_to_file(const void *data, uint32_t len) {
+    return fwrite(data, 1, len, out_file) == len;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 행 지향 파일 전체를 훑어 필드 하나를 꺼냄 (구간은 타임스탬프로 거름)
+static size_t row_extract(const flight_record_t *recs, size_t n, size_t field_offset, size_t field_size,
+                          uint32_t t0_us, uint32_t t1_us, double *out) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const flight_record_t *r = &recs[i];
+        if (r->timestamp_us < t0_us || r->timestamp_us > t1_us) continue;
+        const uint8_t *p = (const uint8_t *)r + field_offset;
+        if (field_size == 4) {
+            int32_t v;
+            memcpy(&v, p, 4);
+            out[count++] = v;
+        } else {
+            int16_t v;
+            memcpy(&v, p, 2);
+            out[count++] = v;
+        }
+    }
+    return count;
+}
+
+static void compare(const char *label, const collog_reader_t *reader, const flight_record_t *recs, size_t n,
+                    const char *channel, size_t field_offset, size_t field_size, uint32_t t0_us, uint64_t t1_us,
+                    double *a, double *b) {
+    int c = collog_reader_find(reader, channel);
+    uint64_t best_col = UINT64_MAX, best_row = UINT64_MAX;
+    size_t n_col = 0, n_row = 0;
+
+    for (int k = 0; k < REPEAT; ++k) {
+        uint64_t t0 = now_ns();
+        n_col = collog_reader_extract(reader, c, t0_us, t1_us, NULL, a, n);
+        uint64_t t1 = now_ns();
+        n_row = row_extract(recs, n, field_offset, field_size, t0_us, t1_us > UINT32_MAX ? UINT32_MAX : (uint32_t)t1_us,
+                            b);
+        uint64_t t2 = now_ns();
+        if (t1 - t0 < best_col) best_col = t1 - t0;
+        if (t2 - t1 < best_row) best_row = t2 - t1;
+    }
+
+    bool same = n_col == n_row && memcmp(a, b, n_col * sizeof(double)) == 0;
+    printf("%-22s %8zu values  columnar %8.3f ms  row scan %8.3f ms  speedup %6.1fx  %s\n",
+           label, n_col, best_col / 1e6, best_row / 1e6, (double)best_row / best_col, same ? "match" : "MISMATCH");
+}
+
+// 타임스탬프가 넘치는 로그를 기록하고, 넘침 양쪽 10 s씩의 구간을 꺼내 합성 데이터와 비교
+static bool wrap_check(const char *path) {
+    static collog_writer_t w;
+    out_file = fopen(path, "wb");
+    if (!out_file || !collog_writer_init(&w, flight_record_channels, FLIGHT_RECORD_CHANNEL_COUNT, sink_to_file)) {
+        fprintf(stderr, "cannot create %s\n", path);
+        return false;
+    }
+    static uint64_t t_ext[WRAP_RECORDS];
+    static int32_t pressure[WRAP_RECORDS];
+    flight_synth_t synth;
+    flight_synth_init(&synth, WRAP_RECORDS, 2);
+    for (uint32_t i = 0; i < WRAP_RECORDS; ++i) {
+        flight_record_t r;
+        flight_synth_next(&synth, &r);
+        t_ext[i] = (uint64_t)WRAP_START_US + r.timestamp_us;
+        pressure[i] = r.pressure_pa;
+        r.timestamp_us = (uint32_t)t_ext[i];
+        collog_writer_add(&w, &r);
+    }
+    collog_writer_close(&w);
+    fclose(out_file);
+
+    collog_reader_t reader;
+    if (!collog_reader_open(&reader, path, 0, 0)) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    uint64_t wrap_us = (uint64_t)UINT32_MAX + 1u;
+    uint64_t t0_us = wrap_us - 10000000u, t1_us = wrap_us + 10000000u;
+    static uint64_t t[WRAP_RECORDS];
+    static double v[WRAP_RECORDS];
+    int c = collog_reader_find(&reader, "pressure");
+    size_t total = collog_reader_extract(&reader, c, 0, UINT64_MAX, NULL, v, WRAP_RECORDS);
+    size_t n = collog_reader_extract(&reader, c, t0_us, t1_us, t, v, WRAP_RECORDS);
+
+    size_t expected = 0;
+    bool same = total == WRAP_RECORDS;
+    for (uint32_t i = 0; i < WRAP_RECORDS; ++i) {
+        if (t_ext[i] < t0_us || t_ext[i] > t1_us) continue;
+        same = same && expected < n && t[expected] == t_ext[i] && v[expected] == pressure[i];
+        ++expected;
+    }
+    same = same && n == expected;
+    collog_reader_close(&reader);
+    remove(path);
+    printf("%-22s %8zu values  (u32 timestamps wrap at %.1f s, %u chunks)  %s\n", "pressure (across wrap)", n,
+           (double)(wrap_us - WRAP_START_US) / 1e6, w.chunks, same ? "match" : "MISMATCH");
+    return same;
+}
+
+int main(int argc, char **argv) {
+    uint32_t size_mb = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 100;
+    const char *dir = argc > 2 ? argv[2] : ".";
+    size_t n = (size_t)size_mb * 1000000u / sizeof(flight_record_t);
+
+    char row_path[512], col_path[512];
+    snprintf(row_path, sizeof(row_path), "%s/bench_rows.bin", dir);
+    snprintf(col_path, sizeof(col_path), "%s/bench_cols.clg", dir);
+
+    // --- 두 파일 생성 ---
+    static collog_writer_t w;
+    FILE *rows = fopen(row_path, "wb");
+    out_file = fopen(col_path, "wb");
+    if (!rows || !out_file ||
+        !collog_writer_init(&w, flight_record_channels, FLIGHT_RECORD_CHANNEL_COUNT, sink_to_file)) {
+        fprintf(stderr, "cannot create %s / %s\n", row_path, col_path);
+        return 1;
+    }
+
+    flight_synth_t synth;
+    flight_synth_init(&synth, (uint32_t)n, 1);
+    uint64_t write_ns = 0;
+    for (size_t i = 0; i < n; ++i) {
+        flight_record_t r;
+        flight_synth_next(&synth, &r);
+        fwrite(&r, sizeof(r), 1, rows);
+        uint64_t t0 = now_ns();
+        collog_writer_add(&w, &r);
+        write_ns += now_ns() - t0;
+    }
+    collog_writer_close(&w);
+    fclose(rows);
+    fclose(out_file);
+    printf("log: %zu records (%.1f MB), collog writer %.1f ns/record, %u chunks, index %u entries x %u\n",
+           n, n * sizeof(flight_record_t) / 1e6, (double)write_ns / n, w.chunks, w.index_count, w.index_stride);
+
+    // --- 추출 비교 ---
+    collog_reader_t reader;
+    int fd = open(row_path, O_RDONLY);
+    struct stat st;
+    if (!collog_reader_open(&reader, col_path, 0, 0) || fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "cannot open logs\n");
+        return 1;
+    }
+    const flight_record_t *recs = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    double *a = malloc(n * sizeof(double)), *b = malloc(n * sizeof(double));
+    if (recs == MAP_FAILED || !a || !b) return 1;
+
+    uint32_t mid_us = (uint32_t)(n / 2 * 1000u);
+    compare("pressure (all)", &reader, recs, n, "pressure", offsetof(flight_record_t, pressure_pa), 4,
+            0, UINT64_MAX, a, b);
+    compare("accel_z (all)", &reader, recs, n, "accel_z", offsetof(flight_record_t, accel[2]), 2,
+            0, UINT64_MAX, a, b);
+    compare("accel_z (60 s window)", &reader, recs, n, "accel_z", offsetof(flight_record_t, accel[2]), 2,
+            mid_us, mid_us + 60000000u, a, b);
+    compare("pressure (1 s window)", &reader, recs, n, "pressure", offsetof(flight_record_t, pressure_pa), 4,
+            mid_us, mid_us + 1000000u, a, b);
+    char wrap_path[512];
+    snprintf(wrap_path, sizeof(wrap_path), "%s/bench_wrap.clg", dir);
+    bool wrap_ok = wrap_check(wrap_path);
+
+    free(a);
+    free(b);
+    munmap((void *)recs, (size_t)st.st_size);
+    close(fd);
+    collog_reader_close(&reader);
+    remove(row_path);
+    remove(col_path);
+    return wrap_ok ? 0 : 1;
+}
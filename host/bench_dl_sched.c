@@ -0,0 +1,391 @@
+// 하향 링크 패킷 스케줄러 벤치마크 (포화 상태의 급한 이벤트 지연 / 대역 분배 / 연산 시간)
+//
+// 모델 (1 ms 단위, 손실 없는 링크):
+//   - 무선: 공중 전송률 AIR_BPS. UART DMA가 링크 프레임을 한 번에 하나씩 밀어 넣고, 다 나가면 다음 프레임을
+//     꺼냄 (이미 나가기 시작한 프레임은 끊지 않음)
+//   - 송신원 (수요 합이 공중 전송률보다 커서 항상 포화):
+//       이벤트     : flight_event, 평균 EVENT_MEAN_MS 간격 (지수 분포)
+//       텔레메트리 : telemetry 20 Hz + servo_state 10 Hz
+//       진동       : vibration 2 Hz
+//       로그 발췌  : LOG_MS마다 LOG_FRAME_BYTES 프레임 (큐가 차면 다음 차례에 같은 것을 다시 시도)
+//   - 지상국: 링크 프레임을 디코드해 seq 연속성을 확인하고 메시지의 timestamp_ms로 지연/나이를 잼
+//
+// 비교 (큐 메모리는 모두 같음):
+//   fifo       : 큐 하나 (가장 큰 프레임 크기 슬롯), 꼬리 버림
+//   sched      : dl_sched (이벤트 strict, 텔레메트리/진동/로그 가중치 4:1:2. 텔레메트리는 오래된 것을 버리고
+//                진동은 같은 메시지를 덮어씀, 로그는 새 것을 버림 = 송신원이 기다림)
+//   sched+rate : sched + 이벤트/텔레메트리/진동은 tlm_rate가 골라 넣음 (송신 순서 seq로 링크 보고 반영)
+//
+// 출력: 이벤트 지연 p50/p99/최대와 잃은 비율, 텔레메트리/서보 상태/진동 수신율과 수신 시 나이,
+//       로그 처리량, 가중치 클래스끼리 공중 바이트 비율, 버린 프레임 수. 마지막에 enqueue/dequeue 시간
+//
+// 사용법: bench_dl_sched [-n 실행 수]
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dl_sched.h"
+#include "link_frame.h"
+#include "messages.h"
+#include "tlm_rate.h"
+
+#define AIR_BPS 1200.0                        // 9600 baud 무선 모듈
+#define RUN_MS 120000u
+#define EVENT_MEAN_MS 1500.0
+#define TLM_MS 50u
+#define SERVO_MS 100u
+#define VIB_MS 500u
+#define LOG_MS 100u
+#define REPORT_MS 500u
+#define LOG_FRAME_BYTES 200u
+#define LOG_ID 0x7f01u                        // 벤치 전용 로그 발췌 메시지 ([u16 id][u16 seq][u32 offset][data])
+#define MAX_EVENTS 256
+#define LINK_OVERHEAD (LINK_FRAME_MAX_BYTES - LINK_FRAME_MAX_PAYLOAD)
+
+enum { MODE_FIFO, MODE_SCHED, MODE_RATE, MODE_COUNT };
+static const char *MODE_NAMES[MODE_COUNT] = { "fifo", "sched", "sched+rate" };
+
+// 트래픽 종류 (통계용)
+enum { K_EVENT, K_TLM, K_SERVO, K_VIB, K_LOG, K_COUNT };
+
+// dl_sched 클래스
+enum { C_EVENT, C_TLM, C_VIB, C_LOG, C_COUNT };
+
+#define EVENT_SLOTS 8
+#define TLM_SLOTS 4
+#define VIB_SLOTS 2
+#define LOG_SLOTS 8
+#define QUEUE_BYTES                                                                   \
+    (DL_SCHED_STORAGE_BYTES(EVENT_SLOTS, MSG_FLIGHT_EVENT_FRAME_BYTES) +              \
+     DL_SCHED_STORAGE_BYTES(TLM_SLOTS, MSG_MAX_FRAME_BYTES) +                         \
+     DL_SCHED_STORAGE_BYTES(VIB_SLOTS, MSG_VIBRATION_FRAME_BYTES) +                   \
+     DL_SCHED_STORAGE_BYTES(LOG_SLOTS, LOG_FRAME_BYTES))
+#define FIFO_SLOTS (QUEUE_BYTES / (LOG_FRAME_BYTES + 2u))
+
+static uint8_t event_buf[DL_SCHED_STORAGE_BYTES(EVENT_SLOTS, MSG_FLIGHT_EVENT_FRAME_BYTES)];
+static uint8_t tlm_buf[DL_SCHED_STORAGE_BYTES(TLM_SLOTS, MSG_MAX_FRAME_BYTES)];
+static uint8_t vib_buf[DL_SCHED_STORAGE_BYTES(VIB_SLOTS, MSG_VIBRATION_FRAME_BYTES)];
+static uint8_t log_buf[DL_SCHED_STORAGE_BYTES(LOG_SLOTS, LOG_FRAME_BYTES)];
+static uint8_t fifo_buf[QUEUE_BYTES];
+
+static const dl_class_config_t SCHED_CLASSES[C_COUNT] = {
+    [C_EVENT] = { event_buf, MSG_FLIGHT_EVENT_FRAME_BYTES, EVENT_SLOTS, true, 0, DL_DROP_OLDEST },
+    [C_TLM] = { tlm_buf, MSG_MAX_FRAME_BYTES, TLM_SLOTS, false, 4, DL_DROP_OLDEST },
+    [C_VIB] = { vib_buf, MSG_VIBRATION_FRAME_BYTES, VIB_SLOTS, false, 1, DL_DROP_REPLACE },
+    [C_LOG] = { log_buf, LOG_FRAME_BYTES, LOG_SLOTS, false, 2, DL_DROP_NEWEST },
+};
+static const dl_class_config_t FIFO_CLASS = { fifo_buf, LOG_FRAME_BYTES, FIFO_SLOTS, false, 1, DL_DROP_NEWEST };
+
+// sched+rate 모드의 tlm_rate 스트림 (로그 몫을 뺀 용량을 줌)
+enum { S_EVENT, S_TLM, S_SERVO, S_VIB, S_COUNT };
+static const tlm_stream_config_t STREAMS[S_COUNT] = {
+    [S_EVENT] = { MSG_FLIGHT_EVENT_FRAME_BYTES + LINK_OVERHEAD, 0, true, { 0 }, 0 },
+    [S_TLM] = { MSG_TELEMETRY_FRAME_BYTES + LINK_OVERHEAD, 1, false, { 150, 150, 150, 150 }, 50 },
+    [S_SERVO] = { MSG_SERVO_STATE_FRAME_BYTES + LINK_OVERHEAD, 2, false, { 50, 50, 50, 50 }, 20 },
+    [S_VIB] = { MSG_VIBRATION_FRAME_BYTES + LINK_OVERHEAD, 3, false, { 20, 20, 20, 20 }, 5 },
+};
+#define RATE_MAX_BPS 800u
+
+typedef struct {
+    uint32_t rng;
+    dl_sched_t sched;
+    tlm_rate_t rate;
+    // 송신 중인 프레임
+    uint8_t tx[LINK_FRAME_MAX_BYTES];
+    uint32_t tx_len;
+    double tx_left;
+    // 지상국
+    uint16_t rx_seq, rx_frames;
+    bool rx_started;
+    uint32_t seq_errors;
+    // 통계
+    uint32_t lat[MAX_EVENTS];
+    uint32_t raised, received;
+    uint32_t frames[K_COUNT];
+    uint64_t air_bytes[K_COUNT];
+    uint64_t age_sum[K_COUNT];
+    uint32_t log_offset;                      // 다음에 넣을 로그 오프셋 (넣지 못하면 같은 것을 다시 시도)
+} sim_t;
+
+typedef struct {
+    uint32_t lat[MAX_EVENTS * 64];
+    uint32_t lat_count;
+    double raised, received;
+    double frames[K_COUNT], air_bytes[K_COUNT], age_sum[K_COUNT];
+    double dropped;
+    uint32_t seq_errors;
+} result_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double urand(uint32_t *s) {
+    return (double)xorshift(s) / 4294967296.0;
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// --- 메시지 ---
+
+static uint32_t make_frame(int kind, uint32_t t, uint32_t log_offset, uint8_t *buf) {
+    switch (kind) {
+    case K_EVENT: {
+        msg_flight_event_t m = { .timestamp_ms = t, .kind = 4, .flight_phase = 2 };
+        return msg_flight_event_encode(&m, 0, buf, MSG_FLIGHT_EVENT_FRAME_BYTES);
+    }
+    case K_TLM: {
+        msg_telemetry_t m = { .timestamp_ms = t, .flight_phase = 2 };
+        return msg_telemetry_encode(&m, 0, buf, MSG_TELEMETRY_FRAME_BYTES);
+    }
+    case K_SERVO: {
+        msg_servo_state_t m = { .timestamp_ms = t, .count = 3 };
+        return msg_servo_state_encode(&m, 0, buf, MSG_SERVO_STATE_FRAME_BYTES);
+    }
+    case K_VIB: {
+        msg_vibration_t m = { .timestamp_ms = t };
+        return msg_vibration_encode(&m, 0, buf, MSG_VIBRATION_FRAME_BYTES);
+    }
+    default:
+        memset(buf, 0x5a, LOG_FRAME_BYTES);
+        buf[0] = (uint8_t)LOG_ID;
+        buf[1] = (uint8_t)(LOG_ID >> 8);
+        buf[4] = (uint8_t)log_offset;
+        buf[5] = (uint8_t)(log_offset >> 8);
+        buf[6] = (uint8_t)(log_offset >> 16);
+        buf[7] = (uint8_t)(log_offset >> 24);
+        return LOG_FRAME_BYTES;
+    }
+}
+
+static int kind_of(uint16_t id) {
+    switch (id) {
+    case MSG_FLIGHT_EVENT_ID: return K_EVENT;
+    case MSG_TELEMETRY_ID: return K_TLM;
+    case MSG_SERVO_STATE_ID: return K_SERVO;
+    case MSG_VIBRATION_ID: return K_VIB;
+    default: return K_LOG;
+    }
+}
+
+static uint8_t class_of(int mode, int kind) {
+    if (mode == MODE_FIFO) return 0;
+    switch (kind) {
+    case K_EVENT: return C_EVENT;
+    case K_TLM:
+    case K_SERVO: return C_TLM;
+    case K_VIB: return C_VIB;
+    default: return C_LOG;
+    }
+}
+
+static bool offer(sim_t *s, int mode, int kind, uint32_t t) {
+    uint8_t frame[LOG_FRAME_BYTES];
+    uint32_t len = make_frame(kind, t, s->log_offset, frame);
+    return dl_sched_enqueue(&s->sched, class_of(mode, kind), frame, len);
+}
+
+// --- 지상국 ---
+
+static void receive(sim_t *s, uint32_t t) {
+    uint8_t frame[LINK_FRAME_MAX_PAYLOAD];
+    uint32_t len = link_frame_decode(s->tx, s->tx_len - 1u, frame, sizeof(frame));
+    uint16_t id, seq;
+    if (len == 0 || !msg_peek_header(frame, len, &id, &seq)) {
+        ++s->seq_errors;
+        return;
+    }
+    if (s->rx_started && seq != (uint16_t)(s->rx_seq + 1u)) ++s->seq_errors;
+    s->rx_started = true;
+    s->rx_seq = seq;
+    ++s->rx_frames;
+
+    int kind = kind_of(id);
+    ++s->frames[kind];
+    s->air_bytes[kind] += s->tx_len;
+    if (kind == K_LOG) return;
+    uint32_t age = t - get_u32(frame + 4);
+    s->age_sum[kind] += age;
+    if (kind == K_EVENT && s->received < MAX_EVENTS) s->lat[s->received++] = age;
+}
+
+// 1 ms 동안 공중으로 보냄 (쉬는 동안의 시간은 쌓지 않음)
+static void radio_step(sim_t *s, int mode, uint32_t t) {
+    double credit = AIR_BPS / 1000.0;
+    for (;;) {
+        if (s->tx_left <= 0.0) {
+            uint16_t seq;
+            s->tx_len = dl_sched_dequeue(&s->sched, s->tx, sizeof(s->tx), NULL, &seq);
+            if (s->tx_len == 0) return;
+            if (mode == MODE_RATE) tlm_rate_sent(&s->rate, seq, s->tx_len);
+            s->tx_left = s->tx_len;
+        }
+        if (credit < s->tx_left) {
+            s->tx_left -= credit;
+            return;
+        }
+        credit -= s->tx_left;
+        s->tx_left = 0.0;
+        receive(s, t);
+    }
+}
+
+// --- 시뮬레이션 ---
+
+static void simulate(int mode, uint32_t seed, result_t *r) {
+    static sim_t sim;
+    sim_t *s = &sim;
+    memset(s, 0, sizeof(*s));
+    s->rng = seed * 2654435761u + 1u;
+    if (mode == MODE_FIFO) {
+        dl_sched_init(&s->sched, &FIFO_CLASS, 1);
+    } else {
+        dl_sched_init(&s->sched, SCHED_CLASSES, C_COUNT);
+    }
+    if (mode == MODE_RATE) {
+        tlm_rate_init(&s->rate, STREAMS, S_COUNT, RATE_MAX_BPS, TLM_RATE_RSSI_UNKNOWN);
+        tlm_rate_set_phase(&s->rate, 2);
+    }
+
+    uint32_t next_event = 0;
+    for (uint32_t t = 0; t < RUN_MS; ++t) {
+        if (t >= next_event) {
+            next_event = t + 1u + (uint32_t)(-log(1.0 - urand(&s->rng)) * EVENT_MEAN_MS);
+            ++s->raised;
+            if (mode == MODE_RATE) {
+                tlm_rate_event(&s->rate, S_EVENT);
+            } else {
+                offer(s, mode, K_EVENT, t);
+            }
+        }
+
+        if (mode == MODE_RATE) {
+            static const int KIND[S_COUNT] = { K_EVENT, K_TLM, K_SERVO, K_VIB };
+            int i;
+            while ((i = tlm_rate_next(&s->rate, t)) >= 0) offer(s, mode, KIND[i], t);
+            if (t % REPORT_MS == 0 && s->rx_started) tlm_rate_report(&s->rate, s->rx_seq, s->rx_frames, -70, t);
+        } else {
+            if (t % TLM_MS == 0) offer(s, mode, K_TLM, t);
+            if (t % SERVO_MS == 0) offer(s, mode, K_SERVO, t);
+            if (t % VIB_MS == 0) offer(s, mode, K_VIB, t);
+        }
+        if (t % LOG_MS == 0 && offer(s, mode, K_LOG, t)) s->log_offset += LOG_FRAME_BYTES - 8u;
+
+        radio_step(s, mode, t);
+    }
+
+    // 맨 처음 이벤트부터 차례로 도착하므로 (같은 클래스 안에서는 순서 유지) 못 받은 것 = 발생 - 수신
+    for (uint32_t i = 0; i < s->received && r->lat_count < sizeof(r->lat) / sizeof(r->lat[0]); ++i) {
+        r->lat[r->lat_count++] = s->lat[i];
+    }
+    r->raised += s->raised;
+    r->received += s->received;
+    for (int k = 0; k < K_COUNT; ++k) {
+        r->frames[k] += s->frames[k];
+        r->air_bytes[k] += (double)s->air_bytes[k];
+        r->age_sum[k] += (double)s->age_sum[k];
+    }
+    for (uint8_t c = 0; c < s->sched.count; ++c) {
+        // 로그는 넣지 못하면 다시 시도하므로 잃은 것이 아님
+        if (mode != MODE_FIFO && c == C_LOG) continue;
+        r->dropped += s->sched.cls[c].stats.dropped + s->sched.cls[c].stats.replaced;
+    }
+    r->seq_errors += s->seq_errors;
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void print_result(const char *name, result_t *r, uint32_t runs) {
+    qsort(r->lat, r->lat_count, sizeof(r->lat[0]), cmp_u32);
+    uint32_t n = r->lat_count ? r->lat_count : 1;
+    double sec = (double)RUN_MS / 1000.0 * runs;
+    double weighted = r->air_bytes[K_TLM] + r->air_bytes[K_SERVO] + r->air_bytes[K_VIB] + r->air_bytes[K_LOG];
+    if (weighted == 0.0) weighted = 1.0;
+    printf("%-11s %5u %5u %5u %5.1f%% %5.1f/%-5.0f %5.1f/%-5.0f %4.1f/%-5.0f %6.0f %4.0f/%2.0f/%2.0f%% %7.0f %4u\n", name,
+           r->lat[n / 2], r->lat[(uint32_t)(n * 0.99)], r->lat[n - 1], 100.0 * (r->raised - r->received) / r->raised,
+           r->frames[K_TLM] / sec, r->frames[K_TLM] ? r->age_sum[K_TLM] / r->frames[K_TLM] : 0.0,
+           r->frames[K_SERVO] / sec, r->frames[K_SERVO] ? r->age_sum[K_SERVO] / r->frames[K_SERVO] : 0.0,
+           r->frames[K_VIB] / sec, r->frames[K_VIB] ? r->age_sum[K_VIB] / r->frames[K_VIB] : 0.0,
+           r->frames[K_LOG] * (LOG_FRAME_BYTES - 8u) / sec, 100.0 * (r->air_bytes[K_TLM] + r->air_bytes[K_SERVO]) / weighted,
+           100.0 * r->air_bytes[K_VIB] / weighted, 100.0 * r->air_bytes[K_LOG] / weighted, r->dropped / runs, r->seq_errors);
+}
+
+// --- 연산 시간 ---
+
+static void timing(void) {
+    static dl_sched_t s;
+    dl_sched_init(&s, SCHED_CLASSES, C_COUNT);
+    static const int KINDS[] = { K_TLM, K_SERVO, K_VIB, K_LOG, K_TLM, K_EVENT, K_SERVO, K_LOG };
+    enum { NKINDS = sizeof(KINDS) / sizeof(KINDS[0]) };
+    uint8_t frames[NKINDS][LOG_FRAME_BYTES];
+    uint32_t lens[NKINDS];
+    for (int i = 0; i < NKINDS; ++i) lens[i] = make_frame(KINDS[i], (uint32_t)i, 0, frames[i]);
+    uint8_t out[LINK_FRAME_MAX_BYTES];
+    const uint32_t iters = 2000000u;
+    static volatile uint32_t sink;
+
+    // 큐를 절반쯤 채워 두고 넣기/꺼내기를 번갈아 (REPLACE 검색 포함)
+    for (int i = 0; i < NKINDS; ++i) dl_sched_enqueue(&s, class_of(MODE_SCHED, KINDS[i]), frames[i], lens[i]);
+    uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < iters; ++i) {
+        uint32_t k = i % NKINDS;
+        dl_sched_enqueue(&s, class_of(MODE_SCHED, KINDS[k]), frames[k], lens[k]);
+    }
+    double enq_ns = (double)(now_ns() - t0) / iters;
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < iters; ++i) {
+        uint32_t k = i % NKINDS;
+        dl_sched_enqueue(&s, class_of(MODE_SCHED, KINDS[k]), frames[k], lens[k]);
+        sink += dl_sched_dequeue(&s, out, sizeof(out), NULL, NULL);
+    }
+    double pair_ns = (double)(now_ns() - t0) / iters;
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < iters; ++i) {
+        uint32_t k = i % NKINDS;
+        sink += link_frame_encode(frames[k], lens[k], out, sizeof(out));
+    }
+    double enc_ns = (double)(now_ns() - t0) / iters;
+
+    printf("\nhost: enqueue %.1f ns, enqueue + dequeue %.1f ns (그중 link_frame_encode %.1f ns)\n", enq_ns, pair_ns, enc_ns);
+}
+
+int main(int argc, char **argv) {
+    uint32_t runs = 20;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) runs = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    if (runs == 0 || runs > 64) runs = 20;
+
+    static result_t results[MODE_COUNT];
+    for (uint32_t r = 0; r < runs; ++r) {
+        for (int m = 0; m < MODE_COUNT; ++m) simulate(m, r + 1u, &results[m]);
+    }
+
+    printf("공중 %.0f B/s, %u s x %u회, 큐 메모리 %u B (fifo %u 슬롯), 가중치 텔레메트리 4 : 진동 1 : 로그 2\n", AIR_BPS,
+           RUN_MS / 1000u, runs, (unsigned)QUEUE_BYTES, (unsigned)FIFO_SLOTS);
+    printf("%-11s %-17s %6s %11s %11s %10s %6s %12s %7s %4s\n", "", "이벤트 ms p50/p99/max", "lost", "tlm Hz/age",
+           "servo Hz/age", "vib Hz/age", "log B/s", "share t/v/l", "dropped", "seq");
+    for (int m = 0; m < MODE_COUNT; ++m) print_result(MODE_NAMES[m], &results[m], runs);
+    timing();
+    return 0;
+}
@@ -0,0 +1,237 @@
+// 고정소수점 FFT / 진동 분석 벤치마크
+//
+//   1) 정밀도: n = 16 ~ 2048에서 double DFT 대비 SNR (최대 크기 백색 잡음, 작은 사인파 합)
+//   2) 처리량: 호스트에서 FFT 한 번당 시간
+//   3) RP2040 사이클 추정: 나비/비트 역순/창/파워 연산 수 x 손으로 센 Thumb-1 사이클.
+//      실제 값은 CanSat-Galaxy-FxmathBench 펌웨어(fxfft 항목)로 확인
+//   4) 진동 검출: 1 kHz 자이로 모사 신호(바이어스 + 자세 변화 + 공진 2개 + 잡음)에서
+//      vibration_process()가 찾은 주파수/진폭 오차
+//
+// 사용법: bench_fft
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "fxfft.h"
+#include "vibration.h"
+
+#define TIMING_MIN_NS 200000000ull            // 크기마다 0.2초 이상 반복
+
+// RP2040 Thumb-1 사이클 (손으로 센 값, 로드/스토어 2, MULS 1, 분기 2 기준)
+#define CYC_RADIX4 115                        // 8 로드 + 반올림 시프트 8 + 덧셈 16 + 복소 곱 3개 + 8 스토어 + 범위 누적
+#define CYC_RADIX4_TRIVIAL 70                 // 회전 인자 1 (구간 첫 나비)
+#define CYC_RADIX2 30
+#define CYC_BITREV 15                         // 원소당 (교환은 절반 미만)
+#define CYC_SCAN 8                            // 입력 범위 검사, 원소당
+#define CYC_WINDOW 14                         // 평균 제거 + 창, 샘플당
+#define CYC_POWER_PEAK 90                     // 파워 + log2 + 히스토그램 + 극대점 검사, 빈당
+#define CLOCK_HZ 125000000.0
+
+#define GYRO_RATE_HZ 1000
+#define GYRO_BLOCKS 40
+
+typedef struct {
+    double re, im;
+} dcpx_t;
+
+static fxfft_cpx_t buf[FXFFT_MAX_SIZE], input[FXFFT_MAX_SIZE];
+static dcpx_t ref[FXFFT_MAX_SIZE];
+static vibration_t vib;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+// 균등 분포 [-1, 1)
+static double urand(uint32_t *s) {
+    return (double)xorshift(s) / 2147483648.0 - 1.0;
+}
+
+// 정규 분포 (Box-Muller)
+static double nrand(uint32_t *s) {
+    double u1 = ((double)xorshift(s) + 1.0) / 4294967296.0, u2 = (double)xorshift(s) / 4294967296.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// 직접 DFT (double)
+static void dft(const fxfft_cpx_t *x, dcpx_t *out, uint32_t n) {
+    for (uint32_t k = 0; k < n; ++k) {
+        double sr = 0.0, si = 0.0;
+        for (uint32_t i = 0; i < n; ++i) {
+            double w = -2.0 * M_PI * (double)((uint64_t)i * k % n) / (double)n;
+            double c = cos(w), s = sin(w);
+            sr += x[i].re * c - x[i].im * s;
+            si += x[i].re * s + x[i].im * c;
+        }
+        out[k].re = sr;
+        out[k].im = si;
+    }
+}
+
+static double fft_snr_db(uint32_t log2n) {
+    uint32_t n = 1u << log2n;
+    dft(input, ref, n);
+    memcpy(buf, input, n * sizeof(buf[0]));
+    int e = fxfft_forward(buf, (uint8_t)log2n);
+    double scale = ldexp(1.0, e), sig = 0.0, err = 0.0;
+    for (uint32_t k = 0; k < n; ++k) {
+        double dr = buf[k].re * scale - ref[k].re, di = buf[k].im * scale - ref[k].im;
+        sig += ref[k].re * ref[k].re + ref[k].im * ref[k].im;
+        err += dr * dr + di * di;
+    }
+    return 10.0 * log10(sig / (err > 0.0 ? err : 1e-30));
+}
+
+static void accuracy(void) {
+    printf("== 정밀도 (double DFT 대비 SNR) ==\n");
+    printf("%6s %14s %16s\n", "n", "noise_fs_db", "tones_100lsb_db");
+    uint32_t seed = 12345;
+    for (uint32_t log2n = 4; log2n <= FXFFT_MAX_LOG2; ++log2n) {
+        uint32_t n = 1u << log2n;
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i].re = (int16_t)(urand(&seed) * 32767.0);
+            input[i].im = (int16_t)(urand(&seed) * 32767.0);
+        }
+        double snr_noise = fft_snr_db(log2n);
+
+        // 작은 신호: 블록 부동소수점 덕분에 고정 스케일링(단마다 1/4)보다 정밀도가 유지되어야 함
+        for (uint32_t i = 0; i < n; ++i) {
+            double t = (double)i / (double)n;
+            input[i].re = (int16_t)lrint(60.0 * sin(2.0 * M_PI * 3.3 * t) + 40.0 * cos(2.0 * M_PI * 0.21 * n * t));
+            input[i].im = 0;
+        }
+        double snr_tones = fft_snr_db(log2n);
+        printf("%6u %14.1f %16.1f\n", n, snr_noise, snr_tones);
+    }
+}
+
+static void throughput(void) {
+    printf("\n== 처리량 (호스트) / RP2040 125 MHz 추정 ==\n");
+    printf("%6s %10s %12s %12s %14s\n", "n", "host_us", "est_cycles", "est_ms", "est_cpu_1khz");
+    uint32_t seed = 777;
+    for (uint32_t log2n = 8; log2n <= FXFFT_MAX_LOG2; ++log2n) {
+        uint32_t n = 1u << log2n;
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i].re = (int16_t)(urand(&seed) * 20000.0);
+            input[i].im = (int16_t)(urand(&seed) * 20000.0);
+        }
+        uint64_t iters = 0, t0 = now_ns(), dt;
+        do {
+            memcpy(buf, input, n * sizeof(buf[0]));
+            fxfft_forward(buf, (uint8_t)log2n);
+            ++iters;
+            dt = now_ns() - t0;
+        } while (dt < TIMING_MIN_NS);
+        // memcpy 포함 (n x 4 바이트, FFT 대비 무시할 수준)
+
+        // 연산 수: 기수 4 단마다 n/4 나비 (그중 구간 수만큼은 회전 인자 1), 홀수면 기수 2 단 하나
+        uint32_t r4_stages = log2n / 2, bflies = 0, trivial = 0;
+        for (uint32_t s = 0, len = n; s < r4_stages; ++s, len >>= 2) {
+            bflies += n / 4;
+            trivial += n / len;
+        }
+        double cyc = (double)(bflies - trivial) * CYC_RADIX4 + (double)trivial * CYC_RADIX4_TRIVIAL +
+                     (double)(log2n & 1u) * (n / 2) * CYC_RADIX2 + (double)n * (CYC_BITREV + CYC_SCAN);
+        // 진동 분석 한 블록 = FFT + 창 + 파워/피크, 1 kHz 입력이면 n ms마다 한 번
+        double block = cyc + (double)n * CYC_WINDOW + (double)(n / 2) * CYC_POWER_PEAK;
+        double cpu = block / CLOCK_HZ / ((double)n / GYRO_RATE_HZ) * 100.0;
+        printf("%6u %10.2f %12.0f %12.2f %13.2f%%\n", n, (double)dt / 1000.0 / (double)iters, cyc,
+               cyc / CLOCK_HZ * 1000.0, cpu);
+    }
+}
+
+// --- 진동 검출 ---
+
+typedef struct {
+    double freq_hz, amp;
+} tone_t;
+
+static void vibration_detect(void) {
+    // 서보/모터 계열 공진 2개 + 자세 변화(저주파 큰 진폭) + 바이어스 + 백색 잡음
+    const tone_t tones[2] = { { 37.3, 400.0 }, { 112.6, 150.0 } };
+    const double bias = 300.0, attitude_amp = 2000.0, attitude_hz = 0.5, noise_sigma = 40.0;
+
+    if (!vibration_init(&vib, GYRO_RATE_HZ)) {
+        printf("vibration_init failed\n");
+        return;
+    }
+    printf("\n== 진동 검출 (%d Hz 자이로, n = %d, 블록 %d개) ==\n", GYRO_RATE_HZ, VIBRATION_FFT_SIZE, GYRO_BLOCKS);
+
+    uint32_t seed = 4242;
+    double f_err_max[2] = { 0 }, a_err_max[2] = { 0 }, f_err_sum[2] = { 0 };
+    uint32_t found[2] = { 0 }, spurious = 0, results = 0;
+    uint8_t snr_min = 255;
+    int16_t chunk[50];
+    uint64_t t_proc = 0;
+    for (uint32_t i = 0; i < (uint32_t)GYRO_BLOCKS * VIBRATION_FFT_SIZE; i += 50) {
+        for (uint32_t j = 0; j < 50; ++j) {
+            double t = (double)(i + j) / GYRO_RATE_HZ;
+            double v = bias + attitude_amp * sin(2.0 * M_PI * attitude_hz * t) + noise_sigma * nrand(&seed);
+            for (int k = 0; k < 2; ++k) v += tones[k].amp * sin(2.0 * M_PI * tones[k].freq_hz * t + k);
+            chunk[j] = (int16_t)lrint(v);
+        }
+        vibration_add_samples(&vib, chunk, 50);
+
+        uint64_t t0 = now_ns();
+        bool done = vibration_process(&vib);
+        t_proc += now_ns() - t0;
+        if (!done) continue;
+
+        vibration_result_t r;
+        vibration_get_result(&vib, &r);
+        ++results;
+        for (uint8_t p = 0; p < r.count; ++p) {
+            double f = r.peaks[p].freq_dhz / 10.0;
+            int match = -1;
+            for (int k = 0; k < 2; ++k) {
+                if (fabs(f - tones[k].freq_hz) < 2.0 * GYRO_RATE_HZ / VIBRATION_FFT_SIZE) match = k;
+            }
+            if (match < 0) {
+                ++spurious;
+                continue;
+            }
+            ++found[match];
+            double fe = fabs(f - tones[match].freq_hz), ae = fabs(r.peaks[p].amplitude / tones[match].amp - 1.0);
+            f_err_sum[match] += fe;
+            if (fe > f_err_max[match]) f_err_max[match] = fe;
+            if (ae > a_err_max[match]) a_err_max[match] = ae;
+            if (r.peaks[p].snr_db < snr_min) snr_min = r.peaks[p].snr_db;
+        }
+    }
+
+    for (int k = 0; k < 2; ++k) {
+        printf("%.1f Hz (amp %.0f): found %u/%u, freq err mean %.3f max %.3f Hz, amp err max %.1f%%\n",
+               tones[k].freq_hz, tones[k].amp, found[k], results, found[k] ? f_err_sum[k] / found[k] : 0.0,
+               f_err_max[k], a_err_max[k] * 100.0);
+    }
+    printf("spurious peaks %u, min snr %u dB, dropped blocks %u, host %.1f us/block\n", spurious, snr_min,
+           (unsigned)atomic_load(&vib.blocks.dropped), results ? (double)t_proc / 1000.0 / results : 0.0);
+
+    // 제어 루프 노치: 결과 피크를 1 kHz 필터에 그대로 설계
+    vibration_result_t r;
+    fxfilter_biquad_coef_t coef;
+    if (vibration_get_result(&vib, &r) && r.count > 0 && vibration_notch(&r.peaks[0], GYRO_RATE_HZ, 4.0f, &coef)) {
+        printf("notch @ %.1f Hz: b0=%ld b1=%ld b2=%ld a1=%ld a2=%ld (Q14)\n", r.peaks[0].freq_dhz / 10.0,
+               (long)coef.b0, (long)coef.b1, (long)coef.b2, (long)coef.a1, (long)coef.a2);
+    }
+}
+
+int main(void) {
+    fxfft_init();
+    accuracy();
+    throughput();
+    vibration_detect();
+    return 0;
+}
@@ -0,0 +1,318 @@
+// 고정소수점 필터 벤치마크
+//
+//   1) 주파수 응답: 정현파를 블록 단위로 통과시켜 출력 진폭(최소제곱 맞춤)을 double로 설계한
+//      기준 응답 |H(f)|와 dB로 비교 (통과 대역 / 천이 대역 / 저지 대역 최대 오차)
+//   2) 산술 잡음: 백색 잡음 입력에서 같은 (양자화된) 계수의 double 필터 출력과의 SNR
+//   3) 처리량: 입력 샘플/s (블록 256)
+//
+// 필터 설정은 1 kHz IMU -> 125 Hz 기준: 버터워스 4차 50 Hz, 노치 120 Hz,
+// FIR 32탭 4배 데시메이션, CIC 3차 8배 데시메이션.
+//
+// 사용법: bench_fxfilter
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "fxfilter.h"
+
+#define FS_HZ 1000.0
+#define RESPONSE_SAMPLES 32768u
+#define RESPONSE_BLOCK 251u                   // 블록 경계/나머지 처리도 같이 검사
+#define RESPONSE_FREQS 28
+#define NOISE_SAMPLES 65536u
+#define THROUGHPUT_SAMPLES 8000000u
+#define THROUGHPUT_BLOCK 256u
+#define AMPLITUDE 16000.0
+
+#define LP_STAGES 2
+#define LP_FC (50.0 / FS_HZ)
+#define NOTCH_F0 (120.0 / FS_HZ)
+#define NOTCH_Q 4.0
+#define FIR_TAPS 32
+#define FIR_FACTOR 4
+#define FIR_FC (0.4 / FIR_FACTOR)
+#define CIC_ORDER 3
+#define CIC_FACTOR 8
+
+typedef struct {
+    const char *name;
+    uint8_t factor;
+    void (*reset)(void);
+    size_t (*process)(int16_t *buf, size_t n);
+    double (*ref_gain)(double f);             // double 설계의 |H(f)|
+    void (*ref_run)(const int16_t *in, size_t n, double *out); // 양자화된 계수의 double 필터 (데시메이션 포함)
+} filter_case_t;
+
+static fxfilter_biquad_coef_t lp_coef[LP_STAGES], notch_coef;
+static int16_t fir_taps[FIR_TAPS];
+static fxfilter_biquad_t lp, notch;
+static fxfilter_fir_t fir;
+static fxfilter_cic_t cic;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double db(double g) {
+    return 20.0 * log10(g > 1e-12 ? g : 1e-12);
+}
+
+// --- double 기준: 설계 공식을 라이브러리와 독립적으로 다시 계산 ---
+
+static double biquad_gain(double b0, double b1, double b2, double a1, double a2, double f) {
+    double w = 2.0 * M_PI * f, c1 = cos(w), s1 = sin(w), c2 = cos(2.0 * w), s2 = sin(2.0 * w);
+    double nr = b0 + b1 * c1 + b2 * c2, ni = -(b1 * s1 + b2 * s2);
+    double dr = 1.0 + a1 * c1 + a2 * c2, di = -(a1 * s1 + a2 * s2);
+    return sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+static double lp_ref_gain(double f) {
+    double w0 = 2.0 * M_PI * LP_FC, g = 1.0;
+    for (int k = 0; k < LP_STAGES; ++k) {
+        double q = 1.0 / (2.0 * cos((2 * k + 1) * M_PI / (4.0 * LP_STAGES))), alpha = sin(w0) / (2.0 * q);
+        double a0 = 1.0 + alpha, b = (1.0 - cos(w0)) / 2.0;
+        g *= biquad_gain(b / a0, 2.0 * b / a0, b / a0, -2.0 * cos(w0) / a0, (1.0 - alpha) / a0, f);
+    }
+    return g;
+}
+
+static double notch_ref_gain(double f) {
+    double w0 = 2.0 * M_PI * NOTCH_F0, alpha = sin(w0) / (2.0 * NOTCH_Q), a0 = 1.0 + alpha;
+    return biquad_gain(1.0 / a0, -2.0 * cos(w0) / a0, 1.0 / a0, -2.0 * cos(w0) / a0, (1.0 - alpha) / a0, f);
+}
+
+static double fir_ref_gain(double f) {
+    double h[FIR_TAPS], sum = 0.0, re = 0.0, im = 0.0, mid = (FIR_TAPS - 1) / 2.0;
+    for (int k = 0; k < FIR_TAPS; ++k) {
+        double t = k - mid;
+        h[k] = (t == 0.0 ? 2.0 * FIR_FC : sin(2.0 * M_PI * FIR_FC * t) / (M_PI * t)) *
+               (0.54 - 0.46 * cos(2.0 * M_PI * k / (FIR_TAPS - 1)));
+        sum += h[k];
+    }
+    for (int k = 0; k < FIR_TAPS; ++k) {
+        re += h[k] / sum * cos(2.0 * M_PI * f * k);
+        im -= h[k] / sum * sin(2.0 * M_PI * f * k);
+    }
+    return sqrt(re * re + im * im);
+}
+
+static double cic_ref_gain(double f) {
+    double num = sin(M_PI * f * CIC_FACTOR), den = CIC_FACTOR * sin(M_PI * f);
+    return pow(fabs(den == 0.0 ? 1.0 : num / den), CIC_ORDER);
+}
+
+// 양자화된 바이쿼드 계수로 double 직접형 I 필터
+static void biquad_ref_run(const fxfilter_biquad_coef_t *c, int stages, const int16_t *in, size_t n, double *out) {
+    for (size_t i = 0; i < n; ++i) out[i] = in[i];
+    for (int s = 0; s < stages; ++s) {
+        double b0 = c[s].b0 / 16384.0, b1 = c[s].b1 / 16384.0, b2 = c[s].b2 / 16384.0;
+        double a1 = c[s].a1 / 16384.0, a2 = c[s].a2 / 16384.0, x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (size_t i = 0; i < n; ++i) {
+            double x0 = out[i], y0 = b0 * x0 + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            out[i] = y0;
+        }
+    }
+}
+
+static void lp_ref_run(const int16_t *in, size_t n, double *out) {
+    biquad_ref_run(lp_coef, LP_STAGES, in, n, out);
+}
+
+static void notch_ref_run(const int16_t *in, size_t n, double *out) {
+    biquad_ref_run(&notch_coef, 1, in, n, out);
+}
+
+static void fir_ref_run(const int16_t *in, size_t n, double *out) {
+    size_t o = 0;
+    for (size_t i = FIR_FACTOR - 1; i < n; i += FIR_FACTOR) {
+        double acc = 0.0;
+        for (int k = 0; k < FIR_TAPS; ++k) acc += i >= (size_t)k ? fir_taps[k] / 32768.0 * in[i - k] : 0.0;
+        out[o++] = acc;
+    }
+}
+
+static void cic_ref_run(const int16_t *in, size_t n, double *out) {
+    // 이동 평균(R개) N번 = CIC. 적분기 초기값 0이므로 시작 전 입력은 0
+    static double tmp[NOISE_SAMPLES];
+    for (size_t i = 0; i < n; ++i) tmp[i] = in[i];
+    for (int s = 0; s < CIC_ORDER; ++s) {
+        for (size_t i = n; i-- > 0;) {
+            double acc = 0.0;
+            for (int k = 0; k < CIC_FACTOR; ++k) acc += i >= (size_t)k ? tmp[i - k] : 0.0;
+            tmp[i] = acc / CIC_FACTOR;
+        }
+    }
+    size_t o = 0;
+    for (size_t i = CIC_FACTOR - 1; i < n; i += CIC_FACTOR) out[o++] = tmp[i];
+}
+
+// --- 필터 목록 ---
+
+static void lp_reset(void) {
+    fxfilter_biquad_init(&lp, lp_coef, LP_STAGES);
+}
+static size_t lp_process(int16_t *buf, size_t n) {
+    fxfilter_biquad_process(&lp, buf, n);
+    return n;
+}
+static void notch_reset(void) {
+    fxfilter_biquad_init(&notch, &notch_coef, 1);
+}
+static size_t notch_process(int16_t *buf, size_t n) {
+    fxfilter_biquad_process(&notch, buf, n);
+    return n;
+}
+static void fir_reset(void) {
+    fxfilter_fir_init(&fir, fir_taps, FIR_TAPS, FIR_FACTOR);
+}
+static size_t fir_process(int16_t *buf, size_t n) {
+    return fxfilter_fir_process(&fir, buf, n);
+}
+static void cic_reset(void) {
+    fxfilter_cic_init(&cic, CIC_ORDER, CIC_FACTOR);
+}
+static size_t cic_process(int16_t *buf, size_t n) {
+    return fxfilter_cic_process(&cic, buf, n);
+}
+
+static const filter_case_t CASES[] = {
+    {"butter4 lp 50 Hz", 1, lp_reset, lp_process, lp_ref_gain, lp_ref_run},
+    {"notch 120 Hz Q4", 1, notch_reset, notch_process, notch_ref_gain, notch_ref_run},
+    {"fir 32 taps /4", FIR_FACTOR, fir_reset, fir_process, fir_ref_gain, fir_ref_run},
+    {"cic N3 /8", CIC_FACTOR, cic_reset, cic_process, cic_ref_gain, cic_ref_run},
+};
+#define CASE_COUNT (sizeof(CASES) / sizeof(CASES[0]))
+
+// 입력 전체를 block 단위로 통과시키고 출력 개수를 돌려줌
+static size_t run_blocks(const filter_case_t *fc, int16_t *buf, size_t n, size_t block) {
+    size_t out = 0;
+    for (size_t i = 0; i < n; i += block) {
+        size_t len = n - i < block ? n - i : block;
+        size_t got = fc->process(&buf[i], len);
+        memmove(&buf[out], &buf[i], got * sizeof(int16_t));
+        out += got;
+    }
+    return out;
+}
+
+// y ~ a cos + b sin + c 최소제곱 (3x3 정규 방정식, 크래머 공식). 진폭 sqrt(a^2 + b^2)
+static double fit_amplitude(const int16_t *y, size_t start, size_t n, double f) {
+    double m[3][3] = {{0}}, v[3] = {0};
+    for (size_t j = start; j < n; ++j) {
+        double basis[3] = {cos(2.0 * M_PI * f * j), sin(2.0 * M_PI * f * j), 1.0};
+        for (int r = 0; r < 3; ++r) {
+            v[r] += basis[r] * y[j];
+            for (int c = 0; c < 3; ++c) m[r][c] += basis[r] * basis[c];
+        }
+    }
+    double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+                 m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    double da = v[0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (v[1] * m[2][2] - m[1][2] * v[2]) +
+                m[0][2] * (v[1] * m[2][1] - m[1][1] * v[2]);
+    double dbb = m[0][0] * (v[1] * m[2][2] - m[1][2] * v[2]) - v[0] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+                 m[0][2] * (m[1][0] * v[2] - v[1] * m[2][0]);
+    return hypot(da / det, dbb / det);
+}
+
+// --- 1) 주파수 응답 ---
+static void bench_response(const filter_case_t *fc) {
+    static int16_t buf[RESPONSE_SAMPLES];
+    double max_pass = 0.0, max_trans = 0.0, stop_worst = -1e9;
+    printf("%s\n    freq    ref dB   fixed dB   diff\n", fc->name);
+    for (int k = 0; k < RESPONSE_FREQS; ++k) {
+        double f = 0.002 * pow(0.49 / 0.002, (double)k / (RESPONSE_FREQS - 1));
+        double fo = fmod(f * fc->factor, 1.0); // 데시메이션 후 (에일리어싱된) 출력 주파수
+        if (fo < 0.003 || fabs(fo - 0.5) < 0.003 || fo > 0.997) continue; // 맞춤이 퇴화하는 주파수는 건너뜀
+        for (uint32_t i = 0; i < RESPONSE_SAMPLES; ++i) buf[i] = (int16_t)lround(AMPLITUDE * sin(2.0 * M_PI * f * i));
+        fc->reset();
+        size_t n = run_blocks(fc, buf, RESPONSE_SAMPLES, RESPONSE_BLOCK);
+        double ref = db(fc->ref_gain(f)), got = db(fit_amplitude(buf, n / 4, n, fo) / AMPLITUDE);
+        double diff = got - ref;
+        if (ref > -3.0 && fabs(diff) > max_pass) max_pass = fabs(diff);
+        else if (ref > -40.0 && ref <= -3.0 && fabs(diff) > max_trans) max_trans = fabs(diff);
+        else if (ref <= -40.0 && got > stop_worst) stop_worst = got;
+        if (k % 3 == 0 && ref > -100.0) printf("  %5.1f Hz %8.2f %9.2f %7.3f\n", f * FS_HZ, ref, got, diff);
+    }
+    printf("  max |diff|: passband %.3f dB, transition (-3..-40 dB) %.3f dB", max_pass, max_trans);
+    if (stop_worst > -1e9) printf(", stopband (ref < -40 dB) worst %.1f dB", stop_worst);
+    printf("\n");
+}
+
+// --- 2) 산술 잡음 ---
+static void bench_noise(const filter_case_t *fc) {
+    static int16_t in[NOISE_SAMPLES], buf[NOISE_SAMPLES];
+    static double ref[NOISE_SAMPLES];
+    uint32_t seed = 2024;
+    for (uint32_t i = 0; i < NOISE_SAMPLES; ++i) in[i] = (int16_t)((int32_t)(xorshift(&seed) % 16001u) - 8000);
+    memcpy(buf, in, sizeof(in));
+    fc->reset();
+    size_t n = run_blocks(fc, buf, NOISE_SAMPLES, RESPONSE_BLOCK);
+    fc->ref_run(in, NOISE_SAMPLES, ref);
+    double sig = 0.0, err = 0.0, max_err = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double e = buf[i] - ref[i];
+        sig += ref[i] * ref[i];
+        err += e * e;
+        if (fabs(e) > max_err) max_err = fabs(e);
+    }
+    printf("  %-18s SNR vs double %.1f dB, rms error %.3f LSB, max %.2f LSB\n", fc->name,
+           10.0 * log10(sig / (err > 0.0 ? err : 1e-30)), sqrt(err / n), max_err);
+}
+
+// --- 3) 처리량 ---
+static void bench_throughput(const filter_case_t *fc) {
+    static int16_t src[THROUGHPUT_BLOCK], buf[THROUGHPUT_BLOCK];
+    uint32_t seed = 5;
+    for (uint32_t i = 0; i < THROUGHPUT_BLOCK; ++i) src[i] = (int16_t)((int32_t)(xorshift(&seed) % 20001u) - 10000);
+    fc->reset();
+    int64_t sum = 0;
+    uint64_t copy_ns = 0, t0 = now_ns();
+    for (uint32_t done = 0; done < THROUGHPUT_SAMPLES; done += THROUGHPUT_BLOCK) {
+        memcpy(buf, src, sizeof(buf));
+        size_t n = fc->process(buf, THROUGHPUT_BLOCK);
+        sum += buf[n - 1];
+    }
+    uint64_t total = now_ns() - t0;
+    // 블록 복사 시간은 빼고 계산
+    t0 = now_ns();
+    for (uint32_t done = 0; done < THROUGHPUT_SAMPLES; done += THROUGHPUT_BLOCK) {
+        memcpy(buf, src, sizeof(buf));
+        sum += buf[done & (THROUGHPUT_BLOCK - 1)];
+    }
+    copy_ns = now_ns() - t0;
+    double ns = (double)(total > copy_ns ? total - copy_ns : total);
+    printf("  %-18s %7.1f Msamples/s in (%5.2f ns/sample)  [checksum %lld]\n", fc->name,
+           THROUGHPUT_SAMPLES / ns * 1e3, ns / THROUGHPUT_SAMPLES, (long long)sum);
+}
+
+int main(void) {
+    if (!fxfilter_design_butter_lowpass(lp_coef, LP_STAGES, (float)LP_FC) ||
+        !fxfilter_design_notch(&notch_coef, (float)NOTCH_F0, (float)NOTCH_Q) ||
+        !fxfilter_design_fir_lowpass(fir_taps, FIR_TAPS, (float)FIR_FC)) {
+        printf("design failed\n");
+        return 1;
+    }
+    printf("frequency response (fs %.0f Hz, %u samples, blocks of %u):\n", FS_HZ, RESPONSE_SAMPLES, RESPONSE_BLOCK);
+    for (size_t i = 0; i < CASE_COUNT; ++i) bench_response(&CASES[i]);
+    printf("arithmetic noise (white input +-8000, same quantized coefficients in double):\n");
+    for (size_t i = 0; i < CASE_COUNT; ++i) bench_noise(&CASES[i]);
+    printf("throughput (host, blocks of %u):\n", THROUGHPUT_BLOCK);
+    for (size_t i = 0; i < CASE_COUNT; ++i) bench_throughput(&CASES[i]);
+    return 0;
+}
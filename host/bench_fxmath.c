@@ -0,0 +1,216 @@
+// 고정소수점 수학 라이브러리 벤치마크
+//
+//   1) 정밀도: sin/cos는 16비트 각도 65536개 전부, atan2/크기는 정수 격자 전부 + 큰 벡터 무작위,
+//      isqrt는 0 ~ 2^24 전부 + 제곱수 경계 전부를 double 기준값과 비교 (CORDIC / LUT 각각)
+//   2) 호출당 시간: 같은 입력으로 libm float (sinf/cosf, atan2f, hypotf, sqrtf)와 비교
+//
+// 호스트 CPU에는 FPU가 있어 float가 빠르게 나옵니다. RP2040 사이클 수는
+// CANSAT_BUILD_FXMATH_BENCH 펌웨어(fxmath_bench_main.c)로 측정합니다.
+//
+// 사용법: bench_fxmath
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "fxmath.h"
+
+#define GRID_HALF 512                         // atan2 격자: -512 ~ 512 (105만 점)
+#define RANDOM_VECTORS 2000000u
+#define TIMING_INPUTS 4096u
+#define TIMING_ROUNDS 500u
+
+typedef void (*sincos_fn)(fx_angle_t, int16_t *, int16_t *);
+typedef fx_angle_t (*atan2_fn)(int32_t, int32_t, uint32_t *);
+
+typedef struct {
+    double max_angle_lsb, max_mag_rel, max_mag_abs;
+} atan2_err_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+// --- 1) 정밀도 ---
+
+static void check_sincos(const char *label, sincos_fn fn) {
+    int max_err = 0;
+    double sq = 0.0;
+    for (uint32_t a = 0; a < 65536u; ++a) {
+        int16_t s, c;
+        fn((fx_angle_t)a, &s, &c);
+        double rad = a * (2.0 * M_PI / 65536.0);
+        int es = abs(s - (int)lround(sin(rad) * 32767.0)), ec = abs(c - (int)lround(cos(rad) * 32767.0));
+        if (es > max_err) max_err = es;
+        if (ec > max_err) max_err = ec;
+        sq += (double)es * es + (double)ec * ec;
+    }
+    printf("  %-7s sin/cos  max %d LSB, rms %.3f LSB (Q15, all 65536 angles)\n", label, max_err,
+           sqrt(sq / (2.0 * 65536.0)));
+}
+
+static void check_atan2_one(atan2_fn fn, int32_t y, int32_t x, atan2_err_t *e) {
+    uint32_t mag;
+    fx_angle_t a = fn(y, x, &mag);
+    double ref_mag = hypot((double)x, (double)y);
+    if (ref_mag == 0.0) return;
+    double ref = atan2((double)y, (double)x) * (65536.0 / (2.0 * M_PI));
+    double d = fmod((double)a - ref + 3.0 * 32768.0, 65536.0) - 32768.0;
+    if (fabs(d) > e->max_angle_lsb) e->max_angle_lsb = fabs(d);
+    double dm = fabs((double)mag - ref_mag);
+    if (dm > e->max_mag_abs) e->max_mag_abs = dm;
+    if (ref_mag >= 1e6 && dm / ref_mag > e->max_mag_rel) e->max_mag_rel = dm / ref_mag;
+}
+
+static void check_atan2(const char *label, atan2_fn fn) {
+    atan2_err_t grid = {0}, big = {0};
+    for (int32_t y = -GRID_HALF; y <= GRID_HALF; ++y) {
+        for (int32_t x = -GRID_HALF; x <= GRID_HALF; ++x) check_atan2_one(fn, y, x, &grid);
+    }
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < RANDOM_VECTORS; ++i) {
+        int shift = (int)(xorshift(&seed) % 31u); // 크기 2^0 ~ 2^30
+        int32_t x = (int32_t)xorshift(&seed) >> shift, y = (int32_t)xorshift(&seed) >> shift;
+        check_atan2_one(fn, y, x, &big);
+    }
+    printf("  %-7s atan2    max %.3f LSB on %dx%d grid, %.3f LSB on %u random vectors (1 LSB = %.4f deg)\n", label,
+           grid.max_angle_lsb, 2 * GRID_HALF + 1, 2 * GRID_HALF + 1, big.max_angle_lsb, RANDOM_VECTORS,
+           360.0 / 65536.0);
+    printf("  %-7s hypot    max %.2f on grid, relative %.5f%% for |v| >= 1e6\n", label, grid.max_mag_abs,
+           (grid.max_mag_rel > big.max_mag_rel ? grid.max_mag_rel : big.max_mag_rel) * 100.0);
+}
+
+static void check_isqrt(void) {
+    uint32_t bad = 0, checked = 0;
+    for (uint32_t v = 0; v < (1u << 24); ++v, ++checked) {
+        uint32_t r = fx_isqrt(v);
+        bad += (uint64_t)r * r > v || (uint64_t)(r + 1) * (r + 1) <= v;
+    }
+    for (uint32_t k = 4096; k <= 65535u; ++k) { // 제곱수와 그 바로 앞 (2^24 이상)
+        uint32_t sq = k * k;
+        bad += fx_isqrt(sq) != k;
+        bad += fx_isqrt(sq - 1u) != k - 1u;
+        checked += 2;
+    }
+    bad += fx_isqrt(UINT32_MAX) != 65535u;
+    printf("  isqrt    %u wrong of %u (0 - 2^24 all, squares to 2^32)\n", bad, checked + 1);
+}
+
+// --- 2) 호출당 시간 ---
+
+static fx_angle_t angles[TIMING_INPUTS];
+static int32_t vx[TIMING_INPUTS], vy[TIMING_INPUTS];
+static float fangles[TIMING_INPUTS], fx[TIMING_INPUTS], fy[TIMING_INPUTS];
+
+static void print_time(const char *label, uint64_t ns, int64_t checksum) {
+    printf("  %-22s %6.2f ns/call  [checksum %lld]\n", label, (double)ns / (TIMING_INPUTS * TIMING_ROUNDS),
+           (long long)checksum);
+}
+
+static void bench_timing(void) {
+    uint32_t seed = 99;
+    for (uint32_t i = 0; i < TIMING_INPUTS; ++i) {
+        angles[i] = (fx_angle_t)xorshift(&seed);
+        fangles[i] = (float)(angles[i] * (2.0 * M_PI / 65536.0));
+        vx[i] = (int32_t)(xorshift(&seed) % 200001u) - 100000;
+        vy[i] = (int32_t)(xorshift(&seed) % 200001u) - 100000;
+        fx[i] = (float)vx[i];
+        fy[i] = (float)vy[i];
+    }
+    printf("timing (host, %u inputs x %u rounds):\n", TIMING_INPUTS, TIMING_ROUNDS);
+
+    int64_t sum = 0;
+    uint64_t t0 = now_ns();
+    for (uint32_t r = 0; r < TIMING_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < TIMING_INPUTS; ++i) {
+            int16_t s, c;
+            fx_sincos_cordic(angles[i], &s, &c);
+            sum += s - c;
+        }
+    }
+    print_time("fx_sincos_cordic", now_ns() - t0, sum);
+
+    sum = 0;
+    t0 = now_ns();
+    for (uint32_t r = 0; r < TIMING_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < TIMING_INPUTS; ++i) {
+            int16_t s, c;
+            fx_sincos_lut(angles[i], &s, &c);
+            sum += s - c;
+        }
+    }
+    print_time("fx_sincos_lut", now_ns() - t0, sum);
+
+    double fsum = 0.0;
+    t0 = now_ns();
+    for (uint32_t r = 0; r < TIMING_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < TIMING_INPUTS; ++i) fsum += sinf(fangles[i]) - cosf(fangles[i]);
+    }
+    print_time("sinf + cosf", now_ns() - t0, (int64_t)(fsum * 32767.0));
+
+    sum = 0;
+    t0 = now_ns();
+    for (uint32_t r = 0; r < TIMING_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < TIMING_INPUTS; ++i) {
+            uint32_t m;
+            sum += fx_atan2_cordic(vy[i], vx[i], &m) + m;
+        }
+    }
+    print_time("fx_atan2_cordic (+mag)", now_ns() - t0, sum);
+
+    sum = 0;
+    t0 = now_ns();
+    for (uint32_t r = 0; r < TIMING_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < TIMING_INPUTS; ++i) {
+            uint32_t m;
+            sum += fx_atan2_lut(vy[i], vx[i], &m) + m;
+        }
+    }
+    print_time("fx_atan2_lut (+mag)", now_ns() - t0, sum);
+
+    fsum = 0.0;
+    t0 = now_ns();
+    for (uint32_t r = 0; r < TIMING_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < TIMING_INPUTS; ++i) fsum += atan2f(fy[i], fx[i]) + hypotf(fx[i], fy[i]);
+    }
+    print_time("atan2f + hypotf", now_ns() - t0, (int64_t)fsum);
+
+    sum = 0;
+    t0 = now_ns();
+    for (uint32_t r = 0; r < TIMING_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < TIMING_INPUTS; ++i) sum += fx_isqrt((uint32_t)vx[i] * 7u);
+    }
+    print_time("fx_isqrt", now_ns() - t0, sum);
+
+    fsum = 0.0;
+    t0 = now_ns();
+    for (uint32_t r = 0; r < TIMING_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < TIMING_INPUTS; ++i) fsum += sqrtf((float)((uint32_t)vx[i] * 7u));
+    }
+    print_time("sqrtf", now_ns() - t0, (int64_t)fsum);
+}
+
+int main(void) {
+    fxmath_init();
+    printf("fxmath: CORDIC %d iterations, LUT %d bits (%d entries), default %s\n", FXMATH_CORDIC_ITERATIONS,
+           FXMATH_LUT_BITS, 1 << FXMATH_LUT_BITS, FXMATH_USE_LUT ? "LUT" : "CORDIC");
+    printf("accuracy:\n");
+    check_sincos("cordic", fx_sincos_cordic);
+    check_sincos("lut", fx_sincos_lut);
+    check_atan2("cordic", fx_atan2_cordic);
+    check_atan2("lut", fx_atan2_lut);
+    check_isqrt();
+    bench_timing();
+    return 0;
+}
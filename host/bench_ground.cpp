@@ -0,0 +1,285 @@
+// 지상국 디코더/아카이버 벤치마크
+//
+// 합성 비행(telemetry 100 Hz + servo_state 20 Hz, 링크 seq 하나)을 수신기 4대가 받은
+// 것처럼 만듭니다. 수신기마다 손실률, 바이트 손상, 지연이 다르고 수신기 3은 중간에
+// 30 s 동안 끊깁니다.
+//   1) 100x 실시간 재생 : 수신기마다 재생 스레드가 도착 시각에 맞춰 ingest
+//   2) 최대 처리량      : 도착 순서대로 제한 없이 넣으며 워커 수별 처리량 측정
+// 어느 경우든 아카이브가 (a) 적어도 한 수신기가 온전히 받은 메시지를 정확히 한 번씩,
+// (b) timestamp 순서로 담고 있는지 확인합니다.
+//
+// 사용법: bench_ground [paced_seconds] [throughput_seconds]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+extern "C" {
+#include "flight_synth.h"
+#include "link_frame.h"
+#include "messages.h"
+#include "units.h"
+}
+#include "ground_station.hpp"
+
+namespace {
+
+using cansat::ground::ArchiveRecord;
+using cansat::ground::Config;
+using cansat::ground::GroundStation;
+using cansat::ground::Stats;
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned kReceivers = 4;
+constexpr double kReplaySpeed = 100.0;
+
+struct ReceiverModel {
+    double loss;          // 프레임 손실 확률
+    double corrupt;       // 프레임 손상 확률 (바이트 하나)
+    std::uint32_t latency_ms;
+    std::uint32_t jitter_ms;
+    std::uint32_t outage_start_s, outage_len_s;
+};
+
+const ReceiverModel kModels[kReceivers] = {
+    {0.05, 0.01, 20, 10, 0, 0},
+    {0.10, 0.02, 60, 30, 0, 0},
+    {0.20, 0.02, 150, 50, 0, 0},
+    {0.30, 0.05, 300, 40, 200, 30},
+};
+
+// 수신기 하나가 받은 바이트 스트림: events[i] = (도착 시각, 이 시각까지의 누적 바이트)
+struct Stream {
+    std::vector<std::uint8_t> bytes;
+    std::vector<std::pair<std::uint32_t, std::size_t>> events;
+};
+
+struct Flight {
+    Stream streams[kReceivers];
+    std::uint64_t unique_expected = 0;  // 적어도 한 수신기가 온전히 받은 메시지
+    std::uint64_t frames_sent = 0;
+    std::uint32_t end_ms = 0;
+};
+
+std::uint32_t xorshift(std::uint32_t &x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+double uniform(std::uint32_t &x) { return (xorshift(x) >> 8) * (1.0 / 16777216.0); }
+
+Flight make_flight(std::uint32_t seconds) {
+    Flight f;
+    flight_synth_t synth;
+    flight_synth_init(&synth, seconds * 1000u, 7);
+    std::uint32_t rng = 0x12345u;
+    std::uint32_t last_arrival[kReceivers] = {};
+    std::uint16_t seq = 0;
+
+    flight_record_t rec;
+    for (std::uint32_t i = 0; i < seconds * 1000u; ++i) {
+        flight_synth_next(&synth, &rec);
+        bool send_tlm = i % 10 == 0, send_servo = i % 50 == 0;
+        if (!send_tlm && !send_servo) continue;
+        std::uint32_t t_ms = rec.timestamp_us / 1000u;
+
+        for (int k = 0; k < 2; ++k) {
+            std::uint8_t frame[MSG_MAX_FRAME_BYTES];
+            std::uint32_t n;
+            if (k == 0) {
+                if (!send_tlm) continue;
+                msg_telemetry_t m{};
+                m.timestamp_ms = t_ms;
+                m.pressure_pa = rec.pressure_pa;
+                m.temperature_c100 = 1500;
+                m.altitude_cm = static_cast<std::int32_t>(synth.alt_m * 100.0);
+                for (int a = 0; a < 3; ++a) {
+                    m.accel_mg[a] = units_accel_to_mg(rec.accel[a]);
+                    m.gyro_dps10[a] = units_gyro_to_dps10(rec.gyro[a]);
+                }
+                m.battery_mv = 7400;
+                m.flight_phase = 2;
+                n = msg_telemetry_encode(&m, seq++, frame, sizeof(frame));
+            } else {
+                if (!send_servo) continue;
+                msg_servo_state_t m{};
+                m.timestamp_ms = t_ms;
+                m.count = 2;
+                m.attached_mask = 3;
+                m.level[0] = rec.servo_level[0];
+                m.level[1] = rec.servo_level[1];
+                n = msg_servo_state_encode(&m, seq++, frame, sizeof(frame));
+            }
+
+            std::uint8_t link[LINK_FRAME_MAX_BYTES];
+            std::uint32_t link_len = link_frame_encode(frame, n, link, sizeof(link));
+            f.frames_sent++;
+
+            bool intact_any = false;
+            for (unsigned r = 0; r < kReceivers; ++r) {
+                const ReceiverModel &model = kModels[r];
+                std::uint32_t t_s = t_ms / 1000u;
+                if (model.outage_len_s && t_s >= model.outage_start_s && t_s < model.outage_start_s + model.outage_len_s) {
+                    continue;
+                }
+                if (uniform(rng) < model.loss) continue;
+
+                Stream &s = f.streams[r];
+                std::size_t at = s.bytes.size();
+                s.bytes.insert(s.bytes.end(), link, link + link_len);
+                if (uniform(rng) < model.corrupt) {
+                    // 구분자가 아닌 바이트 하나를 0이 아닌 다른 값으로
+                    std::size_t pos = at + xorshift(rng) % (link_len - 1);
+                    std::uint8_t b = static_cast<std::uint8_t>(s.bytes[pos] ^ (1u + xorshift(rng) % 255u));
+                    s.bytes[pos] = b ? b : 1;
+                } else {
+                    intact_any = true;
+                }
+
+                std::uint32_t arrival = t_ms + model.latency_ms + xorshift(rng) % (model.jitter_ms + 1);
+                arrival = std::max(arrival, last_arrival[r]); // 수신기 하나 안에서는 순서 유지
+                last_arrival[r] = arrival;
+                s.events.emplace_back(arrival, s.bytes.size());
+                f.end_ms = std::max(f.end_ms, arrival);
+            }
+            if (intact_any) f.unique_expected++;
+        }
+    }
+    return f;
+}
+
+// 아카이브 검증용 싱크
+struct Checker {
+    std::vector<std::tuple<std::uint32_t, std::uint16_t, std::uint16_t>> keys;
+    std::uint64_t order_violations = 0;
+    std::uint32_t last_ts = 0;
+
+    void operator()(const ArchiveRecord &r) {
+        if (r.timestamp_ms < last_ts) order_violations++;
+        last_ts = r.timestamp_ms;
+        keys.emplace_back(r.timestamp_ms, r.id, r.seq);
+    }
+
+    // 중복 없이 기대 개수만큼 있는지
+    bool ok(std::uint64_t expected) {
+        std::sort(keys.begin(), keys.end());
+        bool unique = std::adjacent_find(keys.begin(), keys.end()) == keys.end();
+        return unique && keys.size() == expected && order_violations == 0;
+    }
+};
+
+void print_result(const char *name, unsigned workers, double sec, const Stats &s, const Flight &f, bool ok) {
+    std::printf("%-10s workers %u  %7.3f s  %8.2f MB/s  %6.2f Mframes/s  in %llu  bad %llu  dup %llu  late %llu  "
+                "written %llu/%llu  %s\n",
+                name, workers, sec, s.bytes_in / 1e6 / sec, s.frames_in / 1e6 / sec,
+                static_cast<unsigned long long>(s.frames_in), static_cast<unsigned long long>(s.bad_frames),
+                static_cast<unsigned long long>(s.duplicates), static_cast<unsigned long long>(s.late),
+                static_cast<unsigned long long>(s.written), static_cast<unsigned long long>(f.unique_expected),
+                ok ? "ok" : "FAILED");
+}
+
+// 1) 수신기마다 재생 스레드 하나, 비행 시각 / kReplaySpeed 에 맞춰 넣음
+bool run_paced(const Flight &f, unsigned workers) {
+    Checker checker;
+    Config config;
+    config.workers = workers;
+    GroundStation station(config, [&](const ArchiveRecord &r) { checker(r); });
+
+    Clock::time_point t0 = Clock::now();
+    std::vector<std::thread> players;
+    for (unsigned r = 0; r < kReceivers; ++r) {
+        players.emplace_back([&, r] {
+            const Stream &s = f.streams[r];
+            std::size_t fed = 0, e = 0;
+            while (e < s.events.size()) {
+                double flight_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() * kReplaySpeed;
+                while (e < s.events.size() && s.events[e].first <= flight_ms) e++;
+                std::size_t upto = e ? s.events[e - 1].second : 0;
+                station.ingest(r, s.bytes.data() + fed, upto - fed);
+                fed = upto;
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+            }
+        });
+    }
+    for (std::thread &t : players) t.join();
+    Clock::time_point fed_done = Clock::now();
+    station.finish();
+    double drain_ms = std::chrono::duration<double, std::milli>(Clock::now() - fed_done).count();
+    double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    Stats s = station.stats();
+    bool ok = checker.ok(f.unique_expected);
+    print_result("100x", workers, sec, s, f, ok);
+    std::printf("           flight %.0f s replayed in %.2f s (target %.2f s), drain after last input %.1f ms\n",
+                f.end_ms / 1000.0, sec, f.end_ms / 1000.0 / kReplaySpeed, drain_ms);
+    return ok;
+}
+
+// 2) 도착 순서대로 제한 없이 (수신기 하나는 한 스레드에서만 ingest)
+bool run_unpaced(const Flight &f, unsigned workers, double *sec_out) {
+    Checker checker;
+    checker.keys.reserve(f.unique_expected);
+    Config config;
+    config.workers = workers;
+    GroundStation station(config, [&](const ArchiveRecord &r) { checker(r); });
+
+    Clock::time_point t0 = Clock::now();
+    std::size_t fed[kReceivers] = {}, e[kReceivers] = {};
+    for (std::uint32_t slice_end = 100; slice_end <= f.end_ms + 100; slice_end += 100) {
+        for (unsigned r = 0; r < kReceivers; ++r) {
+            const Stream &s = f.streams[r];
+            while (e[r] < s.events.size() && s.events[e[r]].first < slice_end) e[r]++;
+            std::size_t upto = e[r] ? s.events[e[r] - 1].second : 0;
+            station.ingest(r, s.bytes.data() + fed[r], upto - fed[r]);
+            fed[r] = upto;
+        }
+    }
+    station.finish();
+    double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    *sec_out = sec;
+
+    Stats s = station.stats();
+    bool ok = checker.ok(f.unique_expected);
+    print_result("max", workers, sec, s, f, ok);
+    if (workers == 1) {
+        // 병렬 구간(디코딩) / 직렬 구간(병합) 비율로 코어 수별 상한 추정 (Amdahl)
+        double par = s.decode_ns / 1e9, ser = s.merge_ns / 1e9;
+        std::printf("           decode %.3f s (parallel) + merge %.3f s (serial): ceiling %.2fx on 4 cores, %.2fx "
+                    "on 8 cores\n",
+                    par, ser, (par + ser) / (par / 4 + ser), (par + ser) / (par / 8 + ser));
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::uint32_t paced_s = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 0)) : 600;
+    std::uint32_t max_s = argc > 2 ? static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 0)) : 3600;
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    bool ok = true;
+    Flight paced = make_flight(paced_s);
+    std::printf("paced flight: %llu frames sent, %llu recoverable\n",
+                static_cast<unsigned long long>(paced.frames_sent),
+                static_cast<unsigned long long>(paced.unique_expected));
+    ok &= run_paced(paced, 2);
+
+    Flight big = make_flight(max_s);
+    std::printf("throughput flight: %llu frames sent, %llu recoverable\n",
+                static_cast<unsigned long long>(big.frames_sent), static_cast<unsigned long long>(big.unique_expected));
+    double base = 0;
+    for (unsigned workers : {1u, 2u, 4u, 8u}) {
+        double sec = 0;
+        ok &= run_unpaced(big, workers, &sec);
+        if (workers == 1) base = sec;
+        std::printf("           speedup vs 1 worker: %.2fx, %.0fx real time\n", base / sec, big.end_ms / 1000.0 / sec);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+// 파라포일 유도 벤치마크
+//
+//   1) 기하 정확도: GPS 해에서 구한 방위각/거리(CORDIC, 고정소수점)를 double 기준값과 비교
+//   2) 주기당 시간: guidance_fix (GPS 해마다) / guidance_step (제어 주기마다)의 평균과 최대
+//   3) 착지 정확도: 바람(세기/방향) x 목표점 x 초기 방위 조합으로 SIL 비행을 돌려
+//      유도한 경우와 유도하지 않은 경우(방위 유지)의 목표점 거리 통계
+//
+// 사용법: bench_guidance [flights_per_case]
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "guidance.h"
+#include "sil_flight.h"
+
+#define GEOMETRY_SAMPLES 200000u
+#define TIMING_CALLS 1000000u
+#define TIMING_BATCH 1000u
+#define WIND_CASES 3
+#define WIND_DIRS 4
+#define TARGET_DIRS 4
+static const double WIND_MPS[WIND_CASES] = {0.0, 0.8, 1.5};
+static const double TARGET_DIST_M[2] = {30.0, 60.0};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double wrap180(double deg) {
+    while (deg > 180.0) deg -= 360.0;
+    while (deg < -180.0) deg += 360.0;
+    return deg;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void print_stat(const char *label, double *v, uint32_t n) {
+    double sum = 0.0;
+    for (uint32_t i = 0; i < n; ++i) sum += v[i];
+    qsort(v, n, sizeof(double), cmp_double);
+    printf("  %-12s mean %6.1f  p50 %6.1f  p90 %6.1f  max %6.1f m\n", label, sum / n, v[n / 2],
+           v[(uint32_t)(0.9 * (n - 1))], v[n - 1]);
+}
+
+// --- 1) 기하 정확도: 목표점에서 최대 5 km, 무작위 위치 ---
+static void bench_geometry(void) {
+    const int32_t lat0 = 375665000, lon0 = 1269780000;
+    const double m_per_e7_lat = 111319.49e-7, m_per_e7_lon = m_per_e7_lat * cos(lat0 * 1e-7 * M_PI / 180.0);
+    guidance_t g;
+    uint32_t seed = 1;
+    double max_bearing = 0.0, max_dist = 0.0, max_rel = 0.0, max_pos = 0.0;
+    for (uint32_t i = 0; i < GEOMETRY_SAMPLES; ++i) {
+        guidance_init(&g, lat0, lon0);
+        double scale = pow(10.0, (xorshift(&seed) % 4000) / 1000.0 - 0.3); // 0.5 m ~ 5 km
+        double ang = (xorshift(&seed) % 3600000) * (2.0 * M_PI / 3600000.0);
+        guidance_fix_t fix = {
+            lat0 + (int32_t)lround(scale * cos(ang) / m_per_e7_lat),
+            lon0 + (int32_t)lround(scale * sin(ang) / m_per_e7_lon),
+            0,
+            0,
+        };
+        guidance_fix(&g, &fix, 0, 0, 0);
+        // 위도/경도 -> 지역 좌표 (cm)
+        double n = (fix.lat_e7 - lat0) * m_per_e7_lat * 100.0, e = (fix.lon_e7 - lon0) * m_per_e7_lon * 100.0;
+        double ep = hypot(g.pos_e - e, g.pos_n - n);
+        if (ep > max_pos) max_pos = ep;
+        // CORDIC: 정수 위치에서 구한 방위각/거리를 double 기준값과 비교
+        double ref_bearing = atan2(-(double)g.pos_e, -(double)g.pos_n) * (180.0 / M_PI);
+        double ref_dist = hypot(g.pos_e, g.pos_n);
+        double eb = fabs(wrap180(FX_ANGLE_TO_DEG(g.bearing) - ref_bearing));
+        double ed = fabs((double)g.dist_cm - ref_dist);
+        if (ref_dist > 0.0 && eb > max_bearing) max_bearing = eb;
+        if (ed > max_dist) max_dist = ed;
+        if (ref_dist > 0.0 && ed / ref_dist > max_rel) max_rel = ed / ref_dist;
+    }
+    printf("geometry: %u random fixes 0.5 m - 5 km from target\n", GEOMETRY_SAMPLES);
+    printf("  lat/lon -> local error max %.2f cm\n", max_pos);
+    printf("  bearing error max %.4f deg (1 LSB = %.4f), distance error max %.1f cm (%.4f%% relative)\n",
+           max_bearing, 360.0 / 65536.0, max_dist, max_rel * 100.0);
+}
+
+// --- 2) 주기당 시간: 목표점 주위 원 궤적의 GPS 해, GPS 해 하나마다 제어 주기 10번 ---
+static void bench_timing(void) {
+    guidance_t g;
+    guidance_init(&g, 375665000, 1269780000);
+    guidance_add_waypoint(&g, 5000, 5000);
+    guidance_add_waypoint(&g, -5000, 5000);
+    guidance_output_t out;
+    uint64_t fix_total = 0, step_total = 0, fix_max = 0, step_max = 0;
+    uint32_t seed = 7, fixes = TIMING_CALLS / 10u;
+    int64_t sink = 0;
+
+    static guidance_fix_t fix_buf[TIMING_BATCH];
+    for (uint32_t done = 0; done < fixes; done += TIMING_BATCH) {
+        for (uint32_t k = 0; k < TIMING_BATCH; ++k) {
+            double a = (done + k) * 0.01;
+            fix_buf[k].lat_e7 = 375665000 + (int32_t)(400.0 * cos(a)) + (int32_t)(xorshift(&seed) % 9u) - 4;
+            fix_buf[k].lon_e7 = 1269780000 + (int32_t)(500.0 * sin(a)) + (int32_t)(xorshift(&seed) % 9u) - 4;
+            fix_buf[k].vel_n_cms = (int32_t)(-200.0 * sin(a));
+            fix_buf[k].vel_e_cms = (int32_t)(200.0 * cos(a));
+        }
+        uint64_t t0 = now_ns();
+        for (uint32_t k = 0; k < TIMING_BATCH; ++k) {
+            guidance_fix(&g, &fix_buf[k], (uint16_t)(k * 97u), 10000 - (int32_t)(k % 5000u), 580);
+        }
+        uint64_t t1 = now_ns();
+        for (uint32_t k = 0; k < TIMING_BATCH * 10u; ++k) {
+            guidance_step(&g, (uint16_t)(k * 13u), (int32_t)(k % 2000u) - 1000, &out);
+            sink += out.brake_left_q15 - out.brake_right_q15;
+            if (k % 10u == 9u) g.steps_since_fix = 0; // GPS 해 주기 흉내 (시간 초과 방지)
+        }
+        uint64_t t2 = now_ns();
+        fix_total += t1 - t0;
+        step_total += t2 - t1;
+        if ((t1 - t0) / TIMING_BATCH > fix_max) fix_max = (t1 - t0) / TIMING_BATCH;
+        if ((t2 - t1) / (TIMING_BATCH * 10u) > step_max) step_max = (t2 - t1) / (TIMING_BATCH * 10u);
+    }
+    printf("timing (host, batches of %u):\n", TIMING_BATCH);
+    printf("  guidance_fix   %6.1f ns/call (slowest batch %llu ns/call)\n", (double)fix_total / fixes,
+           (unsigned long long)fix_max);
+    printf("  guidance_step  %6.1f ns/call (slowest batch %llu ns/call)  [checksum %lld]\n",
+           (double)step_total / (fixes * 10.0), (unsigned long long)step_max, (long long)sink);
+}
+
+// --- 3) 착지 정확도 ---
+static void bench_landing(uint32_t per_case) {
+    uint32_t cases = WIND_CASES * WIND_DIRS * TARGET_DIRS * 2u * per_case;
+    double *guided = malloc(cases * sizeof(double)), *unguided = malloc(cases * sizeof(double));
+    if (!guided || !unguided) return;
+    uint32_t n = 0, failures = 0;
+    uint64_t t0 = now_ns();
+    for (int w = 0; w < WIND_CASES; ++w) {
+        for (int wd = 0; wd < WIND_DIRS; ++wd) {
+            for (int td = 0; td < TARGET_DIRS * 2; ++td) {
+                for (uint32_t k = 0; k < per_case; ++k, ++n) {
+                    sil_model_config_t m;
+                    sil_model_config_default(&m, 16, 17, 18);
+                    double wa = wd * (2.0 * M_PI / WIND_DIRS) + 0.3, ta = (td / 2) * (2.0 * M_PI / TARGET_DIRS);
+                    m.wind_e = WIND_MPS[w] * sin(wa);
+                    m.wind_n = WIND_MPS[w] * cos(wa);
+                    m.yaw0_deg = fmod(37.0 + 137.0 * n, 360.0);
+                    m.seed = n + 1;
+                    double te = TARGET_DIST_M[td % 2] * sin(ta), tn = TARGET_DIST_M[td % 2] * cos(ta);
+
+                    flight_ctrl_config_t ctrl = {
+                        .steer_left_gpio = 16, .steer_right_gpio = 17, .deploy_gpio = 18,
+                        .target_heading_deg = 90.0f,
+                    };
+                    sil_model_local_to_geo(&m, te, tn, &ctrl.target_lat_e7, &ctrl.target_lon_e7);
+                    sil_flight_result_t res;
+                    ctrl.guided = true;
+                    if (!sil_flight_run(&m, &ctrl, NULL, n, &res)) return;
+                    failures += !sil_flight_ok(&res);
+                    guided[n] = res.miss_m;
+                    ctrl.guided = false;
+                    if (!sil_flight_run(&m, &ctrl, NULL, n, &res)) return;
+                    unguided[n] = hypot(res.land_e - te, res.land_n - tn);
+                }
+            }
+        }
+    }
+    printf("landing accuracy: %u flights (wind 0-%.1f m/s x %d dirs, targets %.0f/%.0f m x %d dirs), %.1f s\n", n,
+           WIND_MPS[WIND_CASES - 1], WIND_DIRS, TARGET_DIST_M[0], TARGET_DIST_M[1], TARGET_DIRS,
+           (now_ns() - t0) * 1e-9);
+    print_stat("guided", guided, n);
+    print_stat("unguided", unguided, n);
+    if (failures) printf("  %u guided flights did not land normally\n", failures);
+    free(guided);
+    free(unguided);
+}
+
+int main(int argc, char **argv) {
+    uint32_t per_case = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 2;
+    if (per_case == 0) per_case = 1;
+    bench_geometry();
+    bench_timing();
+    bench_landing(per_case);
+    return 0;
+}
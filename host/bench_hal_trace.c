@@ -0,0 +1,143 @@
+// HAL 입력 기록/재생 벤치마크
+//
+// 같은 SIL 비행들을 기록 없이 / 기록하며 실행해
+//   1) 기록 오버헤드 (SIL 실행 시간 증가율, 그리고 제어 주기 하나의 HAL 이벤트만 기록하는 비용)
+//   2) 트레이스 크기 (비행 1초당 바이트, 이벤트 종류별)
+//   3) 재생 속도와 결정성 (기록한 PWM 출력과 재생 출력이 모두 같은지)
+//   4) 어긋남 검출 (목표 방위를 바꾼 펌웨어로 재생하면 첫 조향 출력에서 멈추는지)
+// 를 측정합니다.
+//
+// 사용법: bench_hal_trace [flights]
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "app_tasks.h"
+#include "hal_trace.h"
+#include "sil_flight.h"
+
+#define REPEAT 5
+#define MICRO_TICKS 1000000u
+
+static const char *const EVENT_NAMES[HAL_TRACE_EV_COUNT] = {"end", "time", "gpio", "input", "irq", "pwm"};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static const flight_ctrl_config_t CTRL = {
+    .steer_left_gpio = 16, .steer_right_gpio = 17, .deploy_gpio = 18,
+    .target_heading_deg = 90.0f,
+};
+
+// 비행 flights개 실행, 물리 스텝 수 반환
+static uint64_t run_flights(uint32_t flights) {
+    uint64_t steps = 0;
+    for (uint32_t f = 0; f < flights; ++f) {
+        sil_model_config_t m;
+        sil_model_config_default(&m, CTRL.steer_left_gpio, CTRL.steer_right_gpio, CTRL.deploy_gpio);
+        m.wind_e = 3.0 * cos(f * 0.7);
+        m.wind_n = 3.0 * sin(f * 0.7);
+        m.yaw0_deg = fmod(37.0 + 137.0 * f, 360.0);
+        m.seed = f + 1;
+        sil_flight_result_t res;
+        if (!sil_flight_run(&m, &CTRL, NULL, f, &res)) return 0;
+        steps += res.steps;
+    }
+    return steps;
+}
+
+int main(int argc, char **argv) {
+    uint32_t flights = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 20;
+    if (flights == 0) flights = 1;
+
+    // --- 1) 오버헤드: 기록 없음 / 기록, 각각 REPEAT번 중 최소 ---
+    uint64_t best_off = UINT64_MAX, best_rec = UINT64_MAX, steps = 0;
+    uint8_t *trace = NULL;
+    size_t trace_len = 0;
+    hal_trace_stats_t stats;
+    for (int r = 0; r < REPEAT; ++r) {
+        uint64_t t0 = now_ns();
+        steps = run_flights(flights);
+        uint64_t dt = now_ns() - t0;
+        if (dt < best_off) best_off = dt;
+
+        free(trace);
+        if (!hal_trace_record_start(1u << 20)) return 1;
+        t0 = now_ns();
+        run_flights(flights);
+        dt = now_ns() - t0;
+        hal_trace_get_stats(&stats);
+        trace = hal_trace_record_stop(&trace_len);
+        if (!trace) {
+            fprintf(stderr, "recording failed: %s\n", hal_trace_error());
+            return 1;
+        }
+        if (dt < best_rec) best_rec = dt;
+    }
+    double flight_s = steps * SIL_PHYSICS_STEP_US * 1e-6;
+    uint32_t ticks = stats.events[HAL_TRACE_EV_IRQ];
+    printf("%u SIL flights, %.0f s of flight, %u control ticks (%u ms)\n", flights, flight_s, ticks,
+           APP_CONTROL_PERIOD_MS);
+    printf("run time: off %.1f ms, recording %.1f ms -> overhead %+.1f%% (%.0f ns per control tick)\n",
+           best_off / 1e6, best_rec / 1e6, 100.0 * ((double)best_rec / best_off - 1.0),
+           ((double)best_rec - best_off) / ticks);
+
+    // 제어 주기 하나의 이벤트(IRQ + TIME + 센서 32 B + 조향 PWM 2개)만 기록하는 비용
+    if (!hal_trace_record_start(64u << 20)) return 1;
+    flight_record_t rec = {0};
+    uint64_t t_micro = now_ns();
+    for (uint32_t i = 0; i < MICRO_TICKS; ++i) {
+        hal_trace_irq(SIL_IRQ_CONTROL);
+        (void)hal_trace_time(i * 20000ull);
+        rec.timestamp_us = i * 20000u;
+        rec.pressure_pa = 101325 - (int32_t)(i % 7);
+        for (int a = 0; a < 3; ++a) {
+            rec.accel[a] = (int16_t)(2048 * (a == 2) + (int16_t)(i * 7 + a) % 25);
+            rec.gyro[a] = (int16_t)((i * 13 + a) % 13);
+            rec.mag[a] = (int16_t)(300 - a * 100 + (i + a) % 7);
+        }
+        rec.seq = (uint16_t)i;
+        hal_trace_input(SIL_INPUT_SENSOR, &rec, sizeof(rec));
+        hal_trace_pwm(0, 0, (uint16_t)(4900 + i % 40));
+        hal_trace_pwm(0, 1, (uint16_t)(4900 - i % 40));
+    }
+    t_micro = now_ns() - t_micro;
+    size_t micro_len;
+    free(hal_trace_record_stop(&micro_len));
+    printf("recording cost alone: %.0f ns per control tick (%.1f bytes per tick)\n", (double)t_micro / MICRO_TICKS,
+           (double)micro_len / MICRO_TICKS);
+
+    // --- 2) 트레이스 크기 ---
+    printf("trace: %zu bytes = %.0f bytes per second of flight, %.1f bytes per control tick\n", trace_len,
+           trace_len / flight_s, (double)trace_len / ticks);
+    for (int e = 1; e < HAL_TRACE_EV_COUNT; ++e) {
+        printf("  %-6s %8u events %9llu bytes (%.2f bytes/event)\n", EVENT_NAMES[e], stats.events[e],
+               (unsigned long long)stats.bytes[e], stats.events[e] ? (double)stats.bytes[e] / stats.events[e] : 0.0);
+    }
+    printf("  (raw sensor records alone would be %.0f bytes per second)\n",
+           ticks * (double)sizeof(flight_record_t) / flight_s);
+
+    // --- 3) 재생 ---
+    uint32_t rf, rt;
+    if (!hal_trace_replay_start(trace, trace_len)) return 1;
+    uint64_t t0 = now_ns();
+    bool ok = sil_flight_replay(NAN, &rf, &rt);
+    uint64_t dt = now_ns() - t0;
+    printf("replay: %u flights, %u ticks in %.1f ms (%.2f Mticks/s) -> %s\n", rf, rt, dt / 1e6, rt / (dt * 1e-3),
+           ok ? "all PWM outputs identical" : hal_trace_error());
+
+    // --- 4) 어긋남 검출 ---
+    if (!hal_trace_replay_start(trace, trace_len)) return 1;
+    bool diverged = !sil_flight_replay(80.0f, &rf, &rt);
+    printf("replay with target heading 80 deg: %s after %u ticks\n  %s\n", diverged ? "divergence detected" : "NOT detected",
+           rt, diverged && hal_trace_error() ? hal_trace_error() : "");
+
+    free(trace);
+    return ok && diverged ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+// 지상 로그 처리 커널(logk) 벤치마크
+//
+// 합성 비행 데이터(flight_synth)를 펌웨어 collog 작성기로 기록한 뒤 채널을 원시 타입으로
+// 꺼내고, 커널마다 스칼라 구현과 벡터 구현(AVX2/NEON)의 처리량을 비교합니다.
+// 두 구현의 결과가 비트 단위로 같은지, 고정소수점 변환이 펌웨어(units.h)와 같은지,
+// 기압 고도가 배정밀도 pow() 기준과 얼마나 다른지도 확인합니다.
+//
+// 사용법: bench_logk [records_million] [dir]
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "collog.h"
+#include "collog_reader.h"
+#include "flight_record.h"
+#include "flight_synth.h"
+#include "logk.h"
+#include "units.h"
+
+#define REPEAT 5
+#define FIR_TAPS 63
+#define DECIMATE 10
+
+static FILE *out_file;
+
+static bool sink_to_file(const void *data, uint32_t len) {
+    return fwrite(data, 1, len, out_file) == len;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// stmt 를 REPEAT 번 실행한 최소 시간 (ns)
+#define BEST_NS(best, stmt)                               \
+    do {                                                  \
+        best = UINT64_MAX;                                \
+        for (int rep_ = 0; rep_ < REPEAT; ++rep_) {       \
+            uint64_t t0_ = now_ns();                      \
+            stmt;                                         \
+            uint64_t dt_ = now_ns() - t0_;                \
+            if (dt_ < best) best = dt_;                   \
+        }                                                 \
+    } while (0)
+
+static logk_isa_t vector_isa;
+
+static void report(const char *label, size_t n, uint64_t scalar_ns, uint64_t vector_ns, bool exact) {
+    printf("%-24s %9zu  scalar %8.1f Ms/s  %-6s %8.1f Ms/s  speedup %5.2fx  %s\n", label, n,
+           n / (scalar_ns / 1e3), logk_isa_name(vector_isa), n / (vector_ns / 1e3),
+           (double)scalar_ns / vector_ns, exact ? "bit-exact" : "MISMATCH");
+}
+
+int main(int argc, char **argv) {
+    double records_m = argc > 1 ? strtod(argv[1], NULL) : 4.0;
+    const char *dir = argc > 2 ? argv[2] : ".";
+    size_t n = (size_t)(records_m * 1e6);
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/bench_logk.clg", dir);
+
+    // --- 로그 생성 ---
+    static collog_writer_t w;
+    out_file = fopen(path, "wb");
+    if (!out_file || !collog_writer_init(&w, flight_record_channels, FLIGHT_RECORD_CHANNEL_COUNT, sink_to_file)) {
+        fprintf(stderr, "cannot create %s\n", path);
+        return 1;
+    }
+    flight_synth_t synth;
+    flight_synth_init(&synth, (uint32_t)n, 1);
+    for (size_t i = 0; i < n; ++i) {
+        flight_record_t r;
+        flight_synth_next(&synth, &r);
+        collog_writer_add(&w, &r);
+    }
+    collog_writer_close(&w);
+    fclose(out_file);
+
+    // --- 원시 채널 추출 ---
+    collog_reader_t reader;
+    if (!collog_reader_open(&reader, path, 0, 0)) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+    int16_t *accel = malloc(n * sizeof(int16_t)), *gyro = malloc(n * sizeof(int16_t));
+    int32_t *pressure = malloc(n * sizeof(int32_t));
+    int16_t *fix_a = malloc(n * sizeof(int16_t)), *fix_b = malloc(n * sizeof(int16_t));
+    float *fa = malloc(n * sizeof(float)), *fb = malloc(n * sizeof(float)), *phys = malloc(n * sizeof(float));
+    if (!accel || !gyro || !pressure || !fix_a || !fix_b || !fa || !fb || !phys) return 1;
+
+    uint64_t t0 = now_ns();
+    size_t na = collog_reader_extract_raw(&reader, collog_reader_find(&reader, "accel_z"), 0, UINT64_MAX, NULL,
+                                          accel, n);
+    size_t ng = collog_reader_extract_raw(&reader, collog_reader_find(&reader, "gyro_x"), 0, UINT64_MAX, NULL,
+                                          gyro, n);
+    size_t np = collog_reader_extract_raw(&reader, collog_reader_find(&reader, "pressure"), 0, UINT64_MAX, NULL,
+                                          pressure, n);
+    uint64_t extract_ns = now_ns() - t0;
+    collog_reader_close(&reader);
+    remove(path);
+    if (na != n || ng != n || np != n) {
+        fprintf(stderr, "extract returned %zu/%zu/%zu of %zu\n", na, ng, np, n);
+        return 1;
+    }
+    vector_isa = logk_best_isa();
+    printf("log: %zu records, 3 raw channels extracted in %.1f ms, vector isa: %s\n", n, extract_ns / 1e6,
+           logk_isa_name(vector_isa));
+    if (vector_isa == LOGK_SCALAR) printf("(no vector isa on this build/cpu: both columns run scalar)\n");
+
+    uint64_t s_ns, v_ns;
+    bool ok = true, exact;
+
+    // --- 단위 변환 ---
+    const float accel_scale = UNITS_ACCEL_MPS2_PER_LSB;
+    logk_use(LOGK_SCALAR);
+    BEST_NS(s_ns, logk_i16_to_f32(accel, fa, n, accel_scale));
+    logk_use(vector_isa);
+    BEST_NS(v_ns, logk_i16_to_f32(accel, fb, n, accel_scale));
+    exact = memcmp(fa, fb, n * sizeof(float)) == 0;
+    report("accel_z -> m/s^2", n, s_ns, v_ns, exact);
+    ok &= exact;
+    memcpy(phys, fb, n * sizeof(float));
+
+    // 펌웨어 텔레메트리와 같은 고정소수점 변환 (units.h 인라인 함수와 원소별 비교)
+    struct {
+        const char *label;
+        const int16_t *in;
+        int32_t mul;
+        uint32_t shift;
+        int16_t (*firmware)(int16_t);
+    } fixed[] = {
+        {"accel_z -> mg", accel, UNITS_ACCEL_MG_MUL, UNITS_ACCEL_MG_SHIFT, units_accel_to_mg},
+        {"gyro_x -> 0.1 dps", gyro, UNITS_GYRO_DPS10_MUL, UNITS_GYRO_DPS10_SHIFT, units_gyro_to_dps10},
+    };
+    for (size_t f = 0; f < sizeof(fixed) / sizeof(fixed[0]); ++f) {
+        logk_use(LOGK_SCALAR);
+        BEST_NS(s_ns, logk_i16_fixmul(fixed[f].in, fix_a, n, fixed[f].mul, fixed[f].shift));
+        logk_use(vector_isa);
+        BEST_NS(v_ns, logk_i16_fixmul(fixed[f].in, fix_b, n, fixed[f].mul, fixed[f].shift));
+        exact = memcmp(fix_a, fix_b, n * sizeof(int16_t)) == 0;
+        report(fixed[f].label, n, s_ns, v_ns, exact);
+        size_t firmware_diff = 0;
+        for (size_t i = 0; i < n; ++i) firmware_diff += fix_b[i] != fixed[f].firmware(fixed[f].in[i]);
+        printf("%-24s firmware units.h mismatches: %zu\n", "", firmware_diff);
+        ok &= exact && firmware_diff == 0;
+    }
+
+    // 모든 int16 입력에 대해서도 펌웨어와 같은지
+    static int16_t all_in[65536], all_out[65536];
+    for (int v = 0; v < 65536; ++v) all_in[v] = (int16_t)(v - 32768);
+    size_t sweep_diff = 0;
+    logk_i16_fixmul(all_in, all_out, 65536, UNITS_GYRO_DPS10_MUL, UNITS_GYRO_DPS10_SHIFT);
+    for (int v = 0; v < 65536; ++v) sweep_diff += all_out[v] != units_gyro_to_dps10(all_in[v]);
+    logk_i16_fixmul(all_in, all_out, 65536, UNITS_ACCEL_MG_MUL, UNITS_ACCEL_MG_SHIFT);
+    for (int v = 0; v < 65536; ++v) sweep_diff += all_out[v] != units_accel_to_mg(all_in[v]);
+    printf("%-24s full int16 sweep mismatches: %zu\n", "", sweep_diff);
+    ok &= sweep_diff == 0;
+
+    // --- 기압 고도 ---
+    const float p0 = (float)pressure[0];
+    uint64_t ref_ns;
+    double *ref = malloc(n * sizeof(double));
+    if (!ref) return 1;
+    BEST_NS(ref_ns, for (size_t i = 0; i < n; ++i) ref[i] =
+                        44330.77 * (1.0 - pow((pressure[i] > 1 ? pressure[i] : 1) / (double)p0, 0.190263)));
+    logk_use(LOGK_SCALAR);
+    BEST_NS(s_ns, logk_pressure_to_alt(pressure, fa, n, p0));
+    logk_use(vector_isa);
+    BEST_NS(v_ns, logk_pressure_to_alt(pressure, fb, n, p0));
+    exact = memcmp(fa, fb, n * sizeof(float)) == 0;
+    report("pressure -> altitude", n, s_ns, v_ns, exact);
+    double max_err = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double e = fabs(fb[i] - ref[i]);
+        if (e > max_err) max_err = e;
+    }
+    printf("%-24s libm pow() reference %.1f Ms/s, max |error| %.2f mm\n", "", n / (ref_ns / 1e3), max_err * 1e3);
+    ok &= exact && max_err < 0.01;
+    free(ref);
+
+    // --- 필터 / 데시메이션 (m/s^2 가속도) ---
+    float taps[FIR_TAPS];
+    logk_lowpass_taps(taps, FIR_TAPS, 0.4f / DECIMATE);
+    size_t nout = 0;
+    logk_use(LOGK_SCALAR);
+    BEST_NS(s_ns, nout = logk_fir(phys, n, taps, FIR_TAPS, fa));
+    logk_use(vector_isa);
+    BEST_NS(v_ns, logk_fir(phys, n, taps, FIR_TAPS, fb));
+    exact = memcmp(fa, fb, nout * sizeof(float)) == 0;
+    report("FIR 63 taps", n, s_ns, v_ns, exact);
+    ok &= exact;
+
+    logk_use(LOGK_SCALAR);
+    BEST_NS(s_ns, nout = logk_fir_decimate(phys, n, taps, FIR_TAPS, DECIMATE, fa));
+    logk_use(vector_isa);
+    BEST_NS(v_ns, logk_fir_decimate(phys, n, taps, FIR_TAPS, DECIMATE, fb));
+    exact = memcmp(fa, fb, nout * sizeof(float)) == 0;
+    report("FIR 63 taps / 10", n, s_ns, v_ns, exact);
+    ok &= exact;
+
+    // 1 g 정지 구간(발사대 대기)에서 저역 통과 결과가 중력 근처인지
+    printf("%-24s pad gravity after decimation: %.3f m/s^2 (%zu outputs)\n", "", fb[nout / 50], nout);
+
+    free(accel);
+    free(gyro);
+    free(pressure);
+    free(fix_a);
+    free(fix_b);
+    free(fa);
+    free(fb);
+    free(phys);
+    printf("%s\n", ok ? "all checks passed" : "CHECK FAILED");
+    return ok ? 0 : 1;
+}
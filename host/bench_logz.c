@@ -0,0 +1,198 @@
+// 로그 압축 벤치마크 (합성 비행 데이터)
+//
+// 1 kHz IMU/기압/서보 레코드(32 바이트)를 대기 -> 상승 -> 낙하산 하강 순서로 만들어
+//   1) LZ만 (원본 블록 그대로 logz_compress)
+//   2) 델타 + zigzag 필터 + 전치 + LZ (logz_writer)
+// 의 압축률, 압축/복원 MB/s, 블록당 최악 압축 시간을 비교합니다.
+//
+// 사용법: bench_logz [seconds]
+#define _POSIX_C_SOURCE 200809L
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "logz.h"
+
+typedef struct {
+    uint32_t timestamp_us;
+    int32_t pressure_pa;
+    int16_t accel[3];
+    int16_t gyro[3];
+    int16_t mag[3];
+    uint16_t servo_level[2];
+    uint16_t seq;
+} imu_record_t;
+
+_Static_assert(sizeof(imu_record_t) == 32, "IMU record must be 32 bytes");
+
+static const logz_layout_t imu_layout = {
+    .field_count = 14,
+    .field_size = { 4, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 },
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678u;
+
+static int32_t noise(int32_t amplitude) {
+    // xorshift32, 균등 분포 두 개 합 (삼각 분포)
+    int32_t sum = 0;
+    for (int i = 0; i < 2; ++i) {
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 17;
+        rng_state ^= rng_state << 5;
+        sum += (int32_t)(rng_state % (uint32_t)(2 * amplitude + 1)) - amplitude;
+    }
+    return sum / 2;
+}
+
+static void make_flight(imu_record_t *recs, uint32_t n) {
+    const uint32_t pad_end = n / 10, ascent_end = n / 10 + 3000;
+    double alt = 0.0, vel = 0.0;
+
+    for (uint32_t i = 0; i < n; ++i) {
+        imu_record_t *r = &recs[i];
+        double t = i * 1e-3;
+        double acc_g;
+        if (i < pad_end) {
+            acc_g = 1.0;
+        } else if (i < ascent_end) {
+            acc_g = 1.0 + 8.0 * (i < pad_end + 1500) - 0.5;
+        } else {
+            acc_g = 1.0 + 0.2 * __builtin_sin(t * 2.0); // 하강 중 흔들림
+        }
+        vel += (acc_g - 1.0) * 9.81e-3;
+        if (i >= ascent_end && vel < -6.0) vel = -6.0; // 낙하산 종단 속도
+        alt += vel * 1e-3;
+        if (alt < 0) alt = 0, vel = 0;
+
+        r->timestamp_us = i * 1000u + (uint32_t)noise(3);
+        r->pressure_pa = 101325 - (int32_t)(alt * 12.0) + noise(4);
+        r->accel[0] = (int16_t)(noise(12));
+        r->accel[1] = (int16_t)(noise(12));
+        r->accel[2] = (int16_t)(acc_g * 2048.0 + noise(12));
+        for (int a = 0; a < 3; ++a) {
+            r->gyro[a] = (int16_t)(i >= ascent_end ? 300.0 * __builtin_sin(t * (0.7 + a)) : 0) + (int16_t)noise(6);
+            r->mag[a] = (int16_t)(400.0 * __builtin_cos(t * 0.05 + a) + noise(3));
+        }
+        uint16_t level = (uint16_t)(4500 + (i >= ascent_end ? 1500.0 * __builtin_sin(t * 0.3) : 0));
+        r->servo_level[0] = level;
+        r->servo_level[1] = (uint16_t)(9000 - level);
+        r->seq = (uint16_t)i;
+    }
+}
+
+// --- LZ만 ---
+
+static uint8_t *frames;
+static uint32_t frames_len;
+
+static bool sink_to_memory(const void *data, uint32_t len) {
+    memcpy(frames + frames_len, data, len);
+    frames_len += len;
+    return true;
+}
+
+static void bench_lz_only(const imu_record_t *recs, uint32_t n) {
+    static uint16_t hash[1u << LOGZ_HASH_BITS];
+    static uint8_t out[LOGZ_BLOCK_BYTES], back[LOGZ_BLOCK_BYTES];
+    const uint8_t *src = (const uint8_t *)recs;
+    uint64_t bytes = (uint64_t)n * sizeof(imu_record_t), comp = 0, worst = 0;
+    uint32_t block = (LOGZ_BLOCK_BYTES / sizeof(imu_record_t)) * sizeof(imu_record_t);
+
+    uint64_t t0 = now_ns();
+    for (uint64_t off = 0; off < bytes; off += block) {
+        uint32_t len = (uint32_t)(bytes - off < block ? bytes - off : block);
+        uint64_t b0 = now_ns();
+        uint32_t c = logz_compress(src + off, len, out, hash);
+        uint64_t dt = now_ns() - b0;
+        if (dt > worst) worst = dt;
+        comp += LOGZ_FRAME_HEADER + (c ? c : len);
+    }
+    double sec = (now_ns() - t0) / 1e9;
+
+    // 복원 검증 (블록 하나씩)
+    bool ok = true;
+    for (uint64_t off = 0; off < bytes && ok; off += block) {
+        uint32_t len = (uint32_t)(bytes - off < block ? bytes - off : block);
+        uint32_t c = logz_compress(src + off, len, out, hash);
+        ok = c ? logz_decompress(out, c, back, len) && memcmp(back, src + off, len) == 0 : true;
+    }
+
+    printf("lz only      : ratio %.2fx  compress %.0f MB/s  worst block %.1f us  roundtrip %s\n",
+           (double)bytes / comp, bytes / 1e6 / sec, worst / 1e3, ok ? "ok" : "FAILED");
+}
+
+// --- 델타 + LZ ---
+
+static void bench_delta_lz(const imu_record_t *recs, uint32_t n) {
+    static logz_writer_t w;
+    uint64_t bytes = (uint64_t)n * sizeof(imu_record_t), worst = 0;
+    frames_len = 0;
+
+    if (!logz_writer_init(&w, &imu_layout, sink_to_memory)) {
+        printf("delta + lz   : invalid layout\n");
+        return;
+    }
+
+    uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t b0 = now_ns();
+        logz_writer_add(&w, &recs[i]);
+        uint64_t dt = now_ns() - b0;
+        if (dt > worst) worst = dt;
+    }
+    logz_writer_flush(&w);
+    double sec = (now_ns() - t0) / 1e9;
+
+    // 복원 + 검증
+    uint8_t *decoded = malloc(bytes + LOGZ_BLOCK_BYTES);
+    uint64_t pos = 0, out = 0;
+    uint64_t d0 = now_ns();
+    while (pos < frames_len) {
+        uint32_t rec_len, frame_len;
+        if (!logz_decode_frame(&imu_layout, frames + pos, frames_len - (uint32_t)pos,
+                               decoded + out, &rec_len, &frame_len)) {
+            break;
+        }
+        pos += frame_len;
+        out += rec_len;
+    }
+    double dsec = (now_ns() - d0) / 1e9;
+    bool ok = out == bytes && memcmp(decoded, recs, bytes) == 0;
+    free(decoded);
+
+    // worst add는 호스트 스케줄링 잡음 포함, avg block은 블록 하나 필터+압축 평균
+    printf("delta + lz   : ratio %.2fx  compress %.0f MB/s  decode %.0f MB/s  avg block %.1f us  worst add %.1f us  "
+           "frames %u (stored %u)  roundtrip %s\n",
+           (double)bytes / frames_len, bytes / 1e6 / sec, bytes / 1e6 / dsec, sec * 1e6 / w.stats.frames, worst / 1e3,
+           w.stats.frames, w.stats.frames_stored, ok ? "ok" : "FAILED");
+}
+
+int main(int argc, char **argv) {
+    uint32_t seconds = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 600;
+    uint32_t n = seconds * 1000u;
+
+    imu_record_t *recs = malloc((size_t)n * sizeof(imu_record_t));
+    frames = malloc((size_t)n * sizeof(imu_record_t) * 2 + LOGZ_FRAME_MAX);
+    if (!recs || !frames) return 1;
+    memset(frames, 0, (size_t)n * sizeof(imu_record_t) * 2 + LOGZ_FRAME_MAX); // 측정 중 페이지 폴트 방지
+    make_flight(recs, n);
+
+    printf("synthetic flight: %u s x 1 kHz x %zu B = %.1f MB, block %d B, state %zu B\n",
+           seconds, sizeof(imu_record_t), n * sizeof(imu_record_t) / 1e6, LOGZ_BLOCK_BYTES,
+           sizeof(logz_writer_t));
+    bench_lz_only(recs, n);
+    bench_delta_lz(recs, n);
+
+    free(frames);
+    free(recs);
+    return 0;
+}
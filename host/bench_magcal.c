@@ -0,0 +1,258 @@
+// 지자기 온라인 보정 벤치마크 (합성 데이터)
+//
+// 왜곡 모델: m = c + d1 u1 + d2 u2 + diag(k) h + 잡음 (h = 기체 좌표 지구 자기장, |h| = 500 LSB)
+//   하드 아이언 c = (120, -85, 40), 소프트 아이언 k = (1.00, 0.88, 1.12),
+//   서보 부하 오프셋 d1 = (40, -25, 12), d2 = (-18, 33, 22) LSB (부하 u = 0 ~ 1, 조향 중 변함)
+//
+// 자세 시나리오 (50 Hz, 학습 3000 샘플 후 새 2000 샘플로 평가):
+//   tumble  : 임의 자세 (지상 보정 / 상승 중 회전)
+//   descent : 선회하며 하강 (방위 0 ~ 360도, 기울기 +-25도 진자 운동)
+//   planar  : 수평 선회만 (z축 관측 불가 -> 해를 채택하지 않아야 함)
+//
+// 각 시나리오에서 보정 없음 / 서보 항 없는 보정 (loads = 0) / 서보 항 포함 보정 (loads = 2)의
+// 방향 오차(보정 벡터와 실제 h 사이 각도)와 방위 오차(기체 xy 평면 atan2)를 출력하고,
+// 마지막에 갱신/해 계산 시간을 출력합니다.
+//
+// 사용법: bench_magcal
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "magcal.h"
+
+#define RATE_HZ 50.0
+#define TRAIN_SAMPLES 3000
+#define EVAL_SAMPLES 2000
+#define FIELD_LSB 500.0
+#define NOISE_LSB 2.0
+#define INPUT_SHIFT 10
+#define TIMING_UPDATES 2000000u
+#define TIMING_SOLVES 20000u
+
+// RP2040 사이클 추정 (손으로 센 값): 누적 항 하나 = MULS + 64비트 덧셈 + 로드/스토어 약 9,
+// 해 = 촐레스키 n^3/6 곱셈-뺄셈 x (ROM float 곱 + 뺄셈 약 70)
+#define CYC_PER_ACC 9
+#define CYC_UPDATE_FIXED 250
+#define CYC_FLOAT_MAC 70
+
+static const double HARD[3] = { 120.0, -85.0, 40.0 };
+static const double SOFT[3] = { 1.00, 0.88, 1.12 };
+static const double LOAD_OFF[2][3] = { { 40.0, -25.0, 12.0 }, { -18.0, 33.0, 22.0 } };
+static const double WORLD[3] = { 0.0, 300.0, -400.0 };  // 북 + 아래 (LSB)
+
+typedef enum { SCEN_TUMBLE, SCEN_DESCENT, SCEN_PLANAR } scenario_t;
+static const char *SCEN_NAMES[] = { "tumble", "descent", "planar" };
+
+typedef struct {
+    uint32_t rng;
+    double t, yaw, u[2], u_target[2];
+    double q[4];
+} sim_t;
+
+typedef struct {
+    int16_t mag[3], load[2];
+    double h[3];                              // 실제 기체 좌표 자기장
+} sample_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double urand(uint32_t *s) {
+    return (double)xorshift(s) / 4294967296.0;
+}
+
+static double nrand(uint32_t *s) {
+    double u1 = urand(s) + 1e-12, u2 = urand(s);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// 오일러 (yaw, pitch, roll) -> 세계 좌표 벡터를 기체 좌표로
+static void world_to_body(double yaw, double pitch, double roll, const double w[3], double b[3]) {
+    double cy = cos(yaw), sy = sin(yaw), cp = cos(pitch), sp = sin(pitch), cr = cos(roll), sr = sin(roll);
+    // R = Rz(yaw) Ry(pitch) Rx(roll), b = R^T w
+    double r[3][3] = {
+        { cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr },
+        { sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr },
+        { -sp, cp * sr, cp * cr },
+    };
+    for (int i = 0; i < 3; ++i) b[i] = r[0][i] * w[0] + r[1][i] * w[1] + r[2][i] * w[2];
+}
+
+static void sim_next(sim_t *s, scenario_t scen, sample_t *out) {
+    s->t += 1.0 / RATE_HZ;
+    double yaw, pitch, roll;
+    if (scen == SCEN_TUMBLE) {
+        yaw = 2.0 * M_PI * urand(&s->rng);
+        pitch = asin(2.0 * urand(&s->rng) - 1.0);
+        roll = 2.0 * M_PI * urand(&s->rng);
+    } else {
+        s->yaw += (0.35 + 0.25 * sin(0.05 * s->t)) / RATE_HZ;   // 약 6 ~ 34 dps 선회
+        yaw = s->yaw;
+        double tilt = scen == SCEN_DESCENT ? 25.0 * M_PI / 180.0 : 0.0;
+        pitch = tilt * sin(1.3 * s->t);
+        roll = tilt * sin(0.9 * s->t + 1.0);
+    }
+    // 서보 부하: 0.5초마다 새 목표, 1차 지연으로 따라감
+    for (int i = 0; i < 2; ++i) {
+        if (xorshift(&s->rng) % 25u == 0) s->u_target[i] = urand(&s->rng);
+        s->u[i] += 0.2 * (s->u_target[i] - s->u[i]);
+        out->load[i] = (int16_t)lrint(s->u[i] * 32767.0);
+    }
+    world_to_body(yaw, pitch, roll, WORLD, out->h);
+    for (int a = 0; a < 3; ++a) {
+        double m = HARD[a] + SOFT[a] * out->h[a] + NOISE_LSB * nrand(&s->rng);
+        for (int i = 0; i < 2; ++i) m += LOAD_OFF[i][a] * out->load[i] / 32767.0;
+        out->mag[a] = (int16_t)lrint(m);
+    }
+}
+
+static double angle_between(const double a[3], const double b[3]) {
+    double dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    double na = sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]), nb = sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+    double c = dot / (na * nb);
+    return acos(c > 1.0 ? 1.0 : (c < -1.0 ? -1.0 : c)) * 180.0 / M_PI;
+}
+
+static double heading_err(const double a[3], const double b[3]) {
+    double d = (atan2(a[1], a[0]) - atan2(b[1], b[0])) * 180.0 / M_PI;
+    while (d > 180.0) d -= 360.0;
+    while (d < -180.0) d += 360.0;
+    return fabs(d);
+}
+
+typedef struct {
+    double dir_rms, dir_max, hdg_rms, hdg_max;
+} errors_t;
+
+static void accumulate(errors_t *e, const double c[3], const double h[3]) {
+    double d = angle_between(c, h), hd = heading_err(c, h);
+    e->dir_rms += d * d;
+    e->hdg_rms += hd * hd;
+    if (d > e->dir_max) e->dir_max = d;
+    if (hd > e->hdg_max) e->hdg_max = hd;
+}
+
+static void finish(errors_t *e, uint32_t n) {
+    e->dir_rms = sqrt(e->dir_rms / n);
+    e->hdg_rms = sqrt(e->hdg_rms / n);
+}
+
+static magcal_t cal0, cal2;
+
+static void run_scenario(scenario_t scen) {
+    sim_t sim;
+    memset(&sim, 0, sizeof(sim));
+    sim.rng = 0x1234567u + (uint32_t)scen * 7919u;
+    magcal_init(&cal0, INPUT_SHIFT, 0);
+    magcal_init(&cal2, INPUT_SHIFT, 2);
+
+    int first_valid0 = -1, first_valid2 = -1;
+    sample_t s;
+    for (int i = 0; i < TRAIN_SAMPLES; ++i) {
+        sim_next(&sim, scen, &s);
+        magcal_update(&cal0, s.mag, NULL);
+        magcal_update(&cal2, s.mag, s.load);
+        if (first_valid0 < 0 && cal0.sol.valid) first_valid0 = i + 1;
+        if (first_valid2 < 0 && cal2.sol.valid) first_valid2 = i + 1;
+    }
+
+    errors_t raw = { 0 }, e0 = { 0 }, e2 = { 0 };
+    for (int i = 0; i < EVAL_SAMPLES; ++i) {
+        sim_next(&sim, scen, &s);
+        int16_t out0[3], out2[3];
+        magcal_apply(&cal0, s.mag, NULL, out0);
+        magcal_apply(&cal2, s.mag, s.load, out2);
+        double m[3] = { s.mag[0], s.mag[1], s.mag[2] };
+        double c0[3] = { out0[0], out0[1], out0[2] }, c2[3] = { out2[0], out2[1], out2[2] };
+        accumulate(&raw, m, s.h);
+        accumulate(&e0, c0, s.h);
+        accumulate(&e2, c2, s.h);
+    }
+    finish(&raw, EVAL_SAMPLES);
+    finish(&e0, EVAL_SAMPLES);
+    finish(&e2, EVAL_SAMPLES);
+
+    printf("\n== %s ==\n", SCEN_NAMES[scen]);
+    printf("%-18s %8s %10s %10s %10s %10s\n", "", "valid@", "dir_rms", "dir_max", "hdg_rms", "hdg_max");
+    printf("%-18s %8s %10.2f %10.2f %10.2f %10.2f\n", "raw", "-", raw.dir_rms, raw.dir_max, raw.hdg_rms, raw.hdg_max);
+    printf("%-18s %8d %10.2f %10.2f %10.2f %10.2f\n", "magcal loads=0", first_valid0, e0.dir_rms, e0.dir_max,
+           e0.hdg_rms, e0.hdg_max);
+    printf("%-18s %8d %10.2f %10.2f %10.2f %10.2f\n", "magcal loads=2", first_valid2, e2.dir_rms, e2.dir_max,
+           e2.hdg_rms, e2.hdg_max);
+    if (cal2.sol.valid) {
+        const magcal_solution_t *p = &cal2.sol;
+        printf("estimate: center (%.1f, %.1f, %.1f) gain (%.3f, %.3f, %.3f) radius %u\n", p->center_q8[0] / 256.0,
+               p->center_q8[1] / 256.0, p->center_q8[2] / 256.0, p->gain_q14[0] / 16384.0, p->gain_q14[1] / 16384.0,
+               p->gain_q14[2] / 16384.0, p->radius);
+        printf("          servo1 (%.1f, %.1f, %.1f) servo2 (%.1f, %.1f, %.1f)\n", p->load_q8[0][0] / 256.0,
+               p->load_q8[0][1] / 256.0, p->load_q8[0][2] / 256.0, p->load_q8[1][0] / 256.0, p->load_q8[1][1] / 256.0,
+               p->load_q8[1][2] / 256.0);
+        printf("truth   : center (%.1f, %.1f, %.1f) gain (%.3f, %.3f, %.3f) radius %.0f\n", HARD[0], HARD[1], HARD[2],
+               1.0, SOFT[0] / SOFT[1], SOFT[0] / SOFT[2], FIELD_LSB * SOFT[0]);
+    }
+    printf("solves %u, rejected %u\n", cal2.solves, cal2.rejects);
+}
+
+static void timing(void) {
+    sim_t sim;
+    memset(&sim, 0, sizeof(sim));
+    sim.rng = 99;
+    enum { POOL = 1024 };
+    static sample_t pool[POOL];
+    for (int i = 0; i < POOL; ++i) sim_next(&sim, SCEN_TUMBLE, &pool[i]);
+
+    printf("\n== 시간 ==\n");
+    for (uint8_t loads = 0; loads <= MAGCAL_MAX_LOADS; loads += 2) {
+        magcal_init(&cal2, INPUT_SHIFT, loads);
+        uint64_t t0 = now_ns();
+        for (uint32_t i = 0; i < TIMING_UPDATES; ++i) {
+            const sample_t *s = &pool[i % POOL];
+            magcal_update(&cal2, s->mag, s->load);
+        }
+        double upd_total = (double)(now_ns() - t0) / TIMING_UPDATES;
+        uint32_t solves_in_loop = cal2.solves;
+
+        t0 = now_ns();
+        for (uint32_t i = 0; i < TIMING_SOLVES; ++i) magcal_solve(&cal2);
+        double solve_ns = (double)(now_ns() - t0) / TIMING_SOLVES;
+        double upd_ns = upd_total - solve_ns * solves_in_loop / TIMING_UPDATES;
+
+        int16_t out[3];
+        volatile int32_t sink = 0;
+        t0 = now_ns();
+        for (uint32_t i = 0; i < TIMING_UPDATES; ++i) {
+            const sample_t *s = &pool[i % POOL];
+            magcal_apply(&cal2, s->mag, s->load, out);
+            sink += out[0];
+        }
+        double apply_ns = (double)(now_ns() - t0) / TIMING_UPDATES;
+
+        uint32_t n = cal2.params;
+        double est_upd = (double)n * (n + 1) / 2 * CYC_PER_ACC + CYC_UPDATE_FIXED;
+        double est_solve = (double)n * n * n / 6.0 * CYC_FLOAT_MAC + (double)n * n * 2 * CYC_FLOAT_MAC;
+        printf("loads=%u params=%2u: update %.0f ns, solve %.0f ns, apply %.0f ns (host) | "
+               "RP2040 est. update %.0f cycles (%.1f us), solve %.0f cycles (%.2f ms)\n",
+               loads, n, upd_ns, solve_ns, apply_ns, est_upd, est_upd / 125.0, est_solve, est_solve / 125000.0);
+    }
+}
+
+int main(void) {
+    run_scenario(SCEN_TUMBLE);
+    run_scenario(SCEN_DESCENT);
+    run_scenario(SCEN_PLANAR);
+    timing();
+    return 0;
+}
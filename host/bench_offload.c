@@ -0,0 +1,234 @@
+// 로그 오프로드 프로토콜 루프백 테스트 / 처리량 측정
+//
+// 기체 쪽 엔진(offload_dev)을 스레드에서 돌리고 socketpair로 지상 클라이언트
+// (offload_client)와 연결합니다. 경우별로 전체 로그를 받아 원본과 비교합니다.
+//   1) raw      : 제한 없음 (프로토콜/CRC 처리 상한)
+//   2) usb-fs   : 송신을 full-speed bulk 상한(19 x 64 B / 1 ms)으로 제한하고,
+//                 소스 읽기에 SD SPI 지연(4 KB당 2.6 ms)을 넣어 이중 버퍼링 효과 확인
+//   3) corrupt  : 4 MB마다 송신 바이트 하나를 뒤집어 CRC 검출과 재요청 확인
+//
+// 사용법: bench_offload [log_mb]
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "offload_client.h"
+#include "offload_dev.h"
+
+#define USB_FS_BYTES_PER_US (19.0 * 64.0 / 1000.0) // bulk 이론 상한 약 1.216 MB/s
+
+typedef struct {
+    const char *name;
+    double tx_bytes_per_us;    // 0 = 제한 없음
+    uint32_t read_us_per_4k;   // 소스 읽기 지연
+    uint32_t corrupt_every;    // 0 = 없음
+} scenario_t;
+
+static uint8_t *log_data;
+static uint32_t log_size;
+static int dev_fd;
+static atomic_bool dev_stop;
+static scenario_t cur;
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+// --- 기체 쪽: 메모리 소스 (SD 지연 흉내) ---
+
+static uint8_t *pending_buf;
+static uint32_t pending_off, pending_len;
+static uint64_t pending_done_us;
+
+static bool src_size(uint8_t source, uint32_t *size) {
+    if (source != OFFLOAD_SRC_SDLOG) return false;
+    *size = log_size;
+    return true;
+}
+
+static bool src_read_start(uint8_t source, uint32_t offset, uint8_t *buf, uint32_t len) {
+    (void)source;
+    pending_buf = buf;
+    pending_off = offset;
+    pending_len = len;
+    pending_done_us = now_us() + (uint64_t)cur.read_us_per_4k * len / 4096u;
+    return true;
+}
+
+static int src_read_poll(void) {
+    if (now_us() < pending_done_us) return 0;
+    memcpy(pending_buf, log_data + pending_off, pending_len);
+    return 1;
+}
+
+static const offload_source_ops_t source_ops = { src_size, src_read_start, src_read_poll };
+
+// --- 기체 쪽: socketpair 전송 (USB 속도 제한 / 손상 주입) ---
+
+static uint64_t tx_start_us;
+static uint64_t tx_total;
+static uint64_t next_corrupt;
+
+static uint32_t dev_rx(void *buf, uint32_t cap) {
+    ssize_t n = read(dev_fd, buf, cap);
+    return n > 0 ? (uint32_t)n : 0;
+}
+
+static uint32_t dev_tx(const void *buf, uint32_t len) {
+    if (cur.tx_bytes_per_us > 0) {
+        // 지금까지 허용된 바이트만큼만, 64 바이트 패킷 단위로
+        uint64_t allowed = (uint64_t)((now_us() - tx_start_us) * cur.tx_bytes_per_us);
+        if (allowed <= tx_total) return 0;
+        uint64_t room = (allowed - tx_total) / 64 * 64;
+        if (room == 0) return 0;
+        if (len > room) len = (uint32_t)room;
+    }
+
+    uint8_t tmp[8192];
+    if (len > sizeof(tmp)) len = sizeof(tmp);
+    memcpy(tmp, buf, len);
+    if (cur.corrupt_every && tx_total + len > next_corrupt) {
+        tmp[next_corrupt - tx_total] ^= 0x10;
+        next_corrupt += cur.corrupt_every;
+    }
+
+    ssize_t n = write(dev_fd, tmp, len);
+    if (n <= 0) return 0;
+    tx_total += (uint64_t)n;
+    return (uint32_t)n;
+}
+
+static void dev_tx_flush(void) {
+}
+
+static const offload_transport_t transport = { dev_rx, dev_tx, dev_tx_flush };
+
+static void *device_thread(void *arg) {
+    (void)arg;
+    while (!atomic_load(&dev_stop)) offload_dev_poll();
+    return NULL;
+}
+
+// --- 지상 쪽 ---
+
+static int host_read(void *ctx, void *buf, uint32_t cap, int timeout_ms) {
+    int fd = *(int *)ctx;
+    struct pollfd p = { .fd = fd, .events = POLLIN };
+    int r = poll(&p, 1, timeout_ms);
+    if (r <= 0) return r;
+    ssize_t n = read(fd, buf, cap);
+    return n > 0 ? (int)n : -1;
+}
+
+static bool host_write(void *ctx, const void *buf, uint32_t len) {
+    return write(*(int *)ctx, buf, len) == (ssize_t)len;
+}
+
+static uint8_t *received;
+
+static bool store(void *user, uint32_t offset, const void *data, uint32_t len) {
+    (void)user;
+    memcpy(received + offset, data, len);
+    return true;
+}
+
+static void run(const scenario_t *s) {
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) return;
+    fcntl(sv[0], F_SETFL, O_NONBLOCK);
+    int bufsize = 64 * 1024;
+    setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
+
+    cur = *s;
+    dev_fd = sv[0];
+    tx_total = 0;
+    next_corrupt = s->corrupt_every;
+    tx_start_us = now_us();
+    atomic_store(&dev_stop, false);
+    offload_dev_init(&source_ops, &transport);
+
+    pthread_t th;
+    pthread_create(&th, NULL, device_thread, NULL);
+
+    static offload_client_t client;
+    int host_fd = sv[1];
+    offload_link_t link = { host_read, host_write, &host_fd, 200 };
+    offload_client_init(&client, &link);
+    memset(received, 0, log_size);
+
+    uint32_t size = 0;
+    bool info_ok = offload_client_info(&client, OFFLOAD_SRC_SDLOG, &size, NULL);
+    uint8_t flash_status = 0;
+    uint32_t dummy;
+    bool no_flash = !offload_client_info(&client, OFFLOAD_SRC_FLASH, &dummy, &flash_status) &&
+                    flash_status == OFFLOAD_ERR_SOURCE;
+
+    uint64_t t0 = now_us();
+    bool ok = offload_client_fetch(&client, OFFLOAD_SRC_SDLOG, 0, 0, store, NULL, 64);
+    double sec = (now_us() - t0) / 1e6;
+
+    atomic_store(&dev_stop, true);
+    pthread_join(th, NULL);
+    close(sv[0]);
+    close(sv[1]);
+
+    offload_dev_stats_t st;
+    offload_dev_get_stats(&st);
+    bool match = ok && info_ok && no_flash && size == log_size && memcmp(received, log_data, log_size) == 0;
+    printf("%-8s %6.1f MB in %6.2f s = %7.2f MB/s  frames %u  crc errors %u  retries %u  aborts %u  %s\n",
+           s->name, log_size / 1e6, sec, log_size / 1e6 / sec, st.frames_sent, client.crc_errors,
+           client.retries, st.aborts, match ? "ok" : "FAILED");
+}
+
+int main(int argc, char **argv) {
+    uint32_t log_mb = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 16;
+    log_size = log_mb * 1024u * 1024u + 1000u; // 프레임 경계가 아닌 끝
+    log_data = malloc(log_size);
+    received = malloc(log_size);
+    if (!log_data || !received) return 1;
+
+    uint32_t x = 0x9E3779B9u;
+    for (uint32_t i = 0; i < log_size; ++i) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        log_data[i] = (uint8_t)x;
+    }
+
+    const scenario_t scenarios[] = {
+        { "raw", 0, 0, 0 },
+        { "usb-fs", USB_FS_BYTES_PER_US, 2600, 0 },
+        { "corrupt", 0, 0, 4u * 1024u * 1024u },
+    };
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); ++i) {
+        if (i == 1 && log_mb > 4) {
+            // 실시간 제한 구간은 4 MB로 줄여 측정
+            uint32_t full = log_size;
+            log_size = 4u * 1024u * 1024u + 1000u;
+            run(&scenarios[i]);
+            log_size = full;
+            continue;
+        }
+        run(&scenarios[i]);
+    }
+
+    double sd = 4096.0 / 2600.0, usb = USB_FS_BYTES_PER_US;
+    printf("usb-fs reference: link limit %.2f MB/s, serial read+send would give %.2f MB/s, "
+           "UART 115200 gives 0.0115 MB/s\n", usb, 1.0 / (1.0 / usb + 1.0 / sd));
+
+    free(log_data);
+    free(received);
+    return 0;
+}
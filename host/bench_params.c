@@ -0,0 +1,83 @@
+// 파라미터 서브시스템 조회/갱신 비용 벤치마크
+//
+//   - find      : 해시 -> 식별자 이진 탐색
+//   - get       : 활성 뱅크에서 값 하나 읽기
+//   - acquire   : 제어 주기 스냅샷 acquire + release
+//   - set       : 값 하나 갱신 (뱅크 복사 + 공개)
+//   - save/load : 호스트 파일 저장소 왕복
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "params.h"
+
+#define BENCH_ITERS 10000000u
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void report(const char *name, uint64_t elapsed_ns, uint32_t iters) {
+    printf("%-10s %8.2f ns/op\n", name, (double)elapsed_ns / iters);
+}
+
+int main(void) {
+    setenv("CANSAT_PARAMS_FILE", "/tmp/cansat_bench_params.bin", 0); // 작업 트리에 저장 파일을 남기지 않도록
+    if (!params_init()) {
+        fprintf(stderr, "params_init failed: table hash/order mismatch\n");
+        return 1;
+    }
+
+    uint32_t hashes[PARAM_COUNT];
+    for (int i = 0; i < PARAM_COUNT; ++i) {
+        hashes[i] = params_info((param_id_t)i)->hash;
+    }
+
+    volatile uint32_t sink = 0;
+    uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERS; ++i) {
+        sink += (uint32_t)params_find(hashes[i % PARAM_COUNT]);
+    }
+    report("find", now_ns() - t0, BENCH_ITERS);
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERS; ++i) {
+        sink += params_get((param_id_t)(i % PARAM_COUNT)).u32;
+    }
+    report("get", now_ns() - t0, BENCH_ITERS);
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERS; ++i) {
+        const param_value_t *p = params_acquire();
+        sink += p[PARAM_CTRL_PERIOD_MS].u32;
+        params_release();
+    }
+    report("acquire", now_ns() - t0, BENCH_ITERS);
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERS; ++i) {
+        param_value_t v = { .u32 = 10 + (i & 63u) };
+        if (!params_set(PARAM_CTRL_PERIOD_MS, v)) {
+            fprintf(stderr, "params_set failed\n");
+            return 1;
+        }
+    }
+    report("set", now_ns() - t0, BENCH_ITERS);
+
+    const uint32_t io_iters = 1000;
+    t0 = now_ns();
+    for (uint32_t i = 0; i < io_iters; ++i) {
+        if (!params_save() || !params_load()) {
+            fprintf(stderr, "params save/load failed\n");
+            return 1;
+        }
+    }
+    report("save+load", now_ns() - t0, io_iters);
+
+    printf("params=%d sink=%u\n", PARAM_COUNT, (unsigned)sink);
+    return 0;
+}
@@ -0,0 +1,197 @@
+// 스키마 생성 코드 vs 범용 TLV 인코더 벤치마크
+//
+// 같은 telemetry / servo_state 메시지를
+//   - generated : schemac 가 생성한 고정 오프셋 C 인코더/디코더 + C++ 디스패처
+//   - tlv       : 필드 디스크립터 테이블을 런타임에 순회하는 [tag][len][value] 인코더
+// 로 인코딩/디코딩해 메시지당 ns 와 프레임 크기를 비교합니다.
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+extern "C" {
+#include "messages.h"
+}
+#include "messages.hpp"
+
+namespace {
+
+constexpr std::uint32_t kIters = 5000000;
+
+// --- 범용 TLV (비교 대상) ---
+
+struct TlvField {
+    std::uint8_t tag;
+    std::uint8_t elem_size;
+    std::uint8_t count;
+    std::size_t struct_offset;
+};
+
+const TlvField kTelemetryFields[] = {
+    {1, 4, 1, offsetof(msg_telemetry_t, timestamp_ms)},
+    {2, 4, 1, offsetof(msg_telemetry_t, pressure_pa)},
+    {3, 2, 1, offsetof(msg_telemetry_t, temperature_c100)},
+    {4, 4, 1, offsetof(msg_telemetry_t, altitude_cm)},
+    {5, 2, 3, offsetof(msg_telemetry_t, accel_mg)},
+    {6, 2, 3, offsetof(msg_telemetry_t, gyro_dps10)},
+    {7, 2, 1, offsetof(msg_telemetry_t, battery_mv)},
+    {8, 1, 1, offsetof(msg_telemetry_t, flight_phase)},
+};
+
+const TlvField kServoStateFields[] = {
+    {1, 4, 1, offsetof(msg_servo_state_t, timestamp_ms)},
+    {2, 1, 1, offsetof(msg_servo_state_t, count)},
+    {3, 1, 1, offsetof(msg_servo_state_t, attached_mask)},
+    {4, 1, 8, offsetof(msg_servo_state_t, angle)},
+    {5, 2, 8, offsetof(msg_servo_state_t, level)},
+};
+
+template <std::size_t N>
+std::size_t tlv_encode(const TlvField (&fields)[N], const void *msg, std::uint8_t *buf) {
+    const auto *src = static_cast<const std::uint8_t *>(msg);
+    std::size_t pos = 0;
+    for (const TlvField &f : fields) {
+        std::size_t len = static_cast<std::size_t>(f.elem_size) * f.count;
+        buf[pos++] = f.tag;
+        buf[pos++] = static_cast<std::uint8_t>(len);
+        for (std::size_t i = 0; i < f.count; ++i) {
+            std::uint64_t v = 0;
+            std::memcpy(&v, src + f.struct_offset + i * f.elem_size, f.elem_size);
+            for (std::size_t b = 0; b < f.elem_size; ++b) buf[pos++] = static_cast<std::uint8_t>(v >> (8 * b));
+        }
+    }
+    return pos;
+}
+
+template <std::size_t N>
+bool tlv_decode(const TlvField (&fields)[N], void *msg, const std::uint8_t *buf, std::size_t len) {
+    auto *dst = static_cast<std::uint8_t *>(msg);
+    std::size_t pos = 0;
+    while (pos + 2 <= len) {
+        std::uint8_t tag = buf[pos], flen = buf[pos + 1];
+        pos += 2;
+        if (pos + flen > len) return false;
+        for (const TlvField &f : fields) {
+            if (f.tag != tag) continue;
+            for (std::size_t i = 0; i < f.count; ++i) {
+                std::uint64_t v = 0;
+                for (std::size_t b = 0; b < f.elem_size; ++b) v |= static_cast<std::uint64_t>(buf[pos + i * f.elem_size + b]) << (8 * b);
+                std::memcpy(dst + f.struct_offset + i * f.elem_size, &v, f.elem_size);
+            }
+            break;
+        }
+        pos += flen;
+    }
+    return pos == len;
+}
+
+double elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char *name, double ns, std::size_t bytes) {
+    std::printf("%-28s %7.2f ns/msg  %3zu bytes\n", name, ns / kIters, bytes);
+}
+
+}  // namespace
+
+int main() {
+    msg_telemetry_t tlm{};
+    tlm.timestamp_ms = 123456;
+    tlm.pressure_pa = 101325;
+    tlm.temperature_c100 = 2315;
+    tlm.altitude_cm = 45012;
+    tlm.accel_mg[2] = 1000;
+    tlm.gyro_dps10[0] = -35;
+    tlm.battery_mv = 7400;
+    tlm.flight_phase = 3;
+
+    msg_servo_state_t servo{};
+    servo.timestamp_ms = 123456;
+    servo.count = 2;
+    servo.attached_mask = 3;
+    for (int i = 0; i < 8; ++i) {
+        servo.angle[i] = static_cast<std::uint8_t>(i * 20);
+        servo.level[i] = static_cast<std::uint16_t>(3000 + i);
+    }
+
+    std::uint8_t buf[128];
+    volatile std::uint32_t sink = 0;
+
+    // --- 인코딩 ---
+    auto t0 = std::chrono::steady_clock::now();
+    std::size_t gen_tlm_len = 0;
+    for (std::uint32_t i = 0; i < kIters; ++i) {
+        tlm.timestamp_ms = i;
+        gen_tlm_len = msg_telemetry_encode(&tlm, static_cast<std::uint16_t>(i), buf, sizeof(buf));
+        sink += buf[4];
+    }
+    report("generated telemetry encode", elapsed_ns(t0), gen_tlm_len);
+
+    t0 = std::chrono::steady_clock::now();
+    std::size_t tlv_tlm_len = 0;
+    for (std::uint32_t i = 0; i < kIters; ++i) {
+        tlm.timestamp_ms = i;
+        tlv_tlm_len = tlv_encode(kTelemetryFields, &tlm, buf);
+        sink += buf[2];
+    }
+    report("tlv telemetry encode", elapsed_ns(t0), tlv_tlm_len);
+
+    t0 = std::chrono::steady_clock::now();
+    std::size_t gen_servo_len = 0;
+    for (std::uint32_t i = 0; i < kIters; ++i) {
+        servo.timestamp_ms = i;
+        gen_servo_len = msg_servo_state_encode(&servo, static_cast<std::uint16_t>(i), buf, sizeof(buf));
+        sink += buf[4];
+    }
+    report("generated servo_state encode", elapsed_ns(t0), gen_servo_len);
+
+    t0 = std::chrono::steady_clock::now();
+    std::size_t tlv_servo_len = 0;
+    for (std::uint32_t i = 0; i < kIters; ++i) {
+        servo.timestamp_ms = i;
+        tlv_servo_len = tlv_encode(kServoStateFields, &servo, buf);
+        sink += buf[2];
+    }
+    report("tlv servo_state encode", elapsed_ns(t0), tlv_servo_len);
+
+    // --- 디코딩 ---
+    std::uint8_t gen_frame[MSG_MAX_FRAME_BYTES];
+    std::uint8_t tlv_frame[128];
+    msg_telemetry_encode(&tlm, 7, gen_frame, sizeof(gen_frame));
+    tlv_encode(kTelemetryFields, &tlm, tlv_frame);
+
+    msg_telemetry_t out{};
+    t0 = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < kIters; ++i) {
+        msg_telemetry_decode(&out, gen_frame, static_cast<std::uint32_t>(gen_tlm_len));
+        sink += out.timestamp_ms;
+    }
+    report("generated C decode", elapsed_ns(t0), gen_tlm_len);
+
+    t0 = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < kIters; ++i) {
+        cansat::msg::dispatch(gen_frame, gen_tlm_len, [&](const cansat::msg::FrameHeader &, const auto &m) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(m)>, cansat::msg::Telemetry>) sink += m.timestamp_ms;
+        });
+    }
+    report("generated C++ dispatch", elapsed_ns(t0), gen_tlm_len);
+
+    t0 = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < kIters; ++i) {
+        tlv_decode(kTelemetryFields, &out, tlv_frame, tlv_tlm_len);
+        sink += out.timestamp_ms;
+    }
+    report("tlv decode", elapsed_ns(t0), tlv_tlm_len);
+
+    // 왕복 검증
+    msg_telemetry_decode(&out, gen_frame, static_cast<std::uint32_t>(gen_tlm_len));
+    if (std::memcmp(&out, &tlm, sizeof(out)) != 0) {
+        std::fprintf(stderr, "round-trip mismatch\n");
+        return 1;
+    }
+    std::printf("sink=%u\n", static_cast<unsigned>(sink));
+    return 0;
+}
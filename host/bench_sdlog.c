@@ -0,0 +1,138 @@
+// SD 로거 처리량 / 지연 벤치마크 (디스크 이미지 백엔드)
+//
+//   1) throughput : busy 흉내 없이 로그 파일 전체를 채우는 호스트 처리량 (MB/s)
+//   2) realtime   : 가상 시간으로 1 kHz IMU 레코드를 생산하며 블록마다 카드 busy,
+//                   주기적인 긴 busy(카드 내부 정리)를 흉내내 버려진 레코드와
+//                   sdlog_write 최악 실행 시간을 측정
+//
+// 사용법: bench_sdlog [image_path] [image_mb] [log_mb]
+//   image_path 기본값은 /tmp/cansat_bench_sd.img (작업 트리에 큰 이미지를 남기지 않도록)
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "hal_sim.h"
+#include "pico/time.h"
+#include "sd_block.h"
+#include "sdlog.h"
+
+// 합성 IMU 레코드 (32 바이트)
+typedef struct {
+    uint32_t timestamp_us;
+    int32_t pressure_pa;
+    int16_t accel[3];
+    int16_t gyro[3];
+    int16_t mag[3];
+    uint16_t servo_level[2];
+    uint16_t seq;
+} imu_record_t;
+
+_Static_assert(sizeof(imu_record_t) == 32, "IMU record must be 32 bytes");
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void fill_record(imu_record_t *r, uint32_t i, uint64_t t_us) {
+    r->timestamp_us = (uint32_t)t_us;
+    for (int a = 0; a < 3; ++a) {
+        r->accel[a] = (int16_t)(i * (a + 1));
+        r->gyro[a] = (int16_t)(i ^ (uint32_t)a);
+        r->mag[a] = (int16_t)(i >> a);
+    }
+    r->pressure_pa = 101325 - (int32_t)(i % 5000);
+    r->servo_level[0] = (uint16_t)(3000 + i % 1000);
+    r->servo_level[1] = (uint16_t)(6000 - i % 1000);
+    r->seq = (uint16_t)i;
+}
+
+static int run_throughput(uint32_t log_bytes) {
+    sd_host_set_busy(0, 0, 0);
+    if (!sdlog_init(log_bytes)) {
+        fprintf(stderr, "sdlog_init failed\n");
+        return 1;
+    }
+
+    imu_record_t r;
+    uint64_t t0 = now_ns();
+    uint32_t i = 0;
+    while (true) {
+        fill_record(&r, i, i + 1);
+        ++i;
+        if (!sdlog_write(&r, sizeof(r))) {
+            sdlog_poll();
+            if (!sdlog_write(&r, sizeof(r))) break; // 파일 가득 참
+        }
+        sdlog_poll();
+    }
+    sdlog_close();
+    double sec = (double)(now_ns() - t0) / 1e9;
+
+    sdlog_stats_t st;
+    sdlog_get_stats(&st);
+    printf("throughput: %.1f MB in %.3f s = %.1f MB/s (records=%u)\n",
+           st.bytes_written / 1e6, sec, st.bytes_written / 1e6 / sec, i);
+    return 0;
+}
+
+static int run_realtime(uint32_t log_bytes, uint32_t block_us, uint32_t stall_every, uint32_t stall_us) {
+    hal_sim_use_virtual_time(true);
+    hal_sim_reset();
+    sd_host_set_busy(block_us, stall_every, stall_us);
+    if (!sdlog_init(log_bytes)) {
+        fprintf(stderr, "sdlog_init failed\n");
+        return 1;
+    }
+
+    const uint32_t rate_hz = 1000, seconds = 600;
+    const uint32_t poll_per_record = 4; // 레코드 사이 배경 루프 poll 횟수
+    imu_record_t r;
+    uint64_t worst_write_ns = 0;
+
+    for (uint32_t i = 0; i < rate_hz * seconds; ++i) {
+        fill_record(&r, i, time_us_64());
+        uint64_t t0 = now_ns();
+        sdlog_write(&r, sizeof(r));
+        uint64_t dt = now_ns() - t0;
+        if (dt > worst_write_ns) worst_write_ns = dt;
+
+        for (uint32_t p = 0; p < poll_per_record; ++p) {
+            sdlog_poll();
+            hal_sim_advance_us(1000000u / rate_hz / poll_per_record);
+        }
+    }
+    sdlog_close();
+    hal_sim_use_virtual_time(false);
+
+    sdlog_stats_t st;
+    sdlog_get_stats(&st);
+    printf("realtime: %u Hz x %zu B, busy %u us/block, stall %u us every %u blocks -> "
+           "dropped %u/%u records, buffers used max %u/%d, busy polls %u, worst sdlog_write %.0f ns\n",
+           rate_hz, sizeof(r), block_us, stall_us, stall_every,
+           st.records_dropped, rate_hz * seconds, st.max_buffers_used, SDLOG_BUFFERS,
+           st.busy_polls, (double)worst_write_ns);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *image = argc > 1 ? argv[1] : "/tmp/cansat_bench_sd.img";
+    uint64_t image_mb = argc > 2 ? strtoull(argv[2], NULL, 0) : 256;
+    uint32_t log_mb = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 0) : 64;
+
+    if (!sd_host_format_fat32(image, image_mb * 1024 * 1024)) {
+        fprintf(stderr, "cannot create %s\n", image);
+        return 1;
+    }
+    sd_host_set_image(image);
+
+    int rc = run_throughput(log_mb * 1024u * 1024u);
+    // 일반적인 SD 카드: 블록당 수백 us, 수 MB마다 수십~수백 ms 정리 구간
+    rc |= run_realtime(log_mb * 1024u * 1024u, 300, 0, 0);
+    rc |= run_realtime(log_mb * 1024u * 1024u, 300, 2048, 40000);
+    rc |= run_realtime(log_mb * 1024u * 1024u, 300, 2048, 250000);
+    return rc;
+}
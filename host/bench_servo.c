@@ -0,0 +1,109 @@
+// 서보 set 경로 벤치마크: 기본 인스턴스 함수(servo_set) vs 컨텍스트 API(servo_ctx_set)
+//
+// 서보 8개씩을 기본 인스턴스(GPIO 0-7)와 별도 컨텍스트(GPIO 8-15)에 붙이고 같은 각도열을
+// 설정하는 시간을 비교합니다. 기준으로 PWM 레벨 쓰기(pwm_set_gpio_level)만 하는 경우도 측정합니다.
+// 두 경로의 PWM 출력이 모두 같은지도 확인합니다.
+//
+// 사용법: bench_servo [calls]
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "hal_sim.h"
+#include "hardware/pwm.h"
+#include "servo.h"
+
+#define REPEAT 7
+#define N_SERVOS 8
+#define CTX_GPIO_BASE 8
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 호출 i의 서보 번호와 각도 (모든 경로가 같은 순서로 사용)
+static inline uint16_t servo_of(uint32_t i) {
+    return (uint16_t)(i % N_SERVOS);
+}
+
+static inline uint8_t angle_of(uint32_t i) {
+    return (uint8_t)((i * 7u) % 181u);
+}
+
+static uint64_t run_shim(uint32_t calls) {
+    uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < calls; ++i) {
+        if (!servo_set(servo_of(i), angle_of(i))) return 0;
+    }
+    return now_ns() - t0;
+}
+
+static uint64_t run_ctx(servo_ctx_t *ctx, uint32_t calls) {
+    uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < calls; ++i) {
+        if (!servo_ctx_set(ctx, CTX_GPIO_BASE + servo_of(i), angle_of(i))) return 0;
+    }
+    return now_ns() - t0;
+}
+
+static uint64_t run_level(uint32_t calls) {
+    uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < calls; ++i) {
+        pwm_set_gpio_level(servo_of(i), (uint16_t)(angle_of(i) * 16u));
+    }
+    return now_ns() - t0;
+}
+
+int main(int argc, char **argv) {
+    uint32_t calls = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 4000000u;
+    if (calls == 0) calls = 1;
+
+    hal_sim_reset();
+    servo_ctx_t ctx;
+    servo_ctx_init(&ctx);
+    for (uint16_t s = 0; s < N_SERVOS; ++s) {
+        if (!servo_init_default(s) || !servo_ctx_add(&ctx, CTX_GPIO_BASE + s, DEFAULT_SERVO_MIN_PULSE_US,
+                                                     DEFAULT_SERVO_MAX_PULSE_US)) {
+            fprintf(stderr, "servo init failed\n");
+            return 1;
+        }
+    }
+
+    // --- 출력 일치: 모든 각도에서 두 경로의 펄스 폭이 같아야 함 ---
+    int mismatches = 0;
+    for (uint32_t a = 0; a <= 180; ++a) {
+        for (uint16_t s = 0; s < N_SERVOS; ++s) {
+            servo_set(s, (uint8_t)a);
+            servo_ctx_set(&ctx, CTX_GPIO_BASE + s, (uint8_t)a);
+            mismatches += hal_sim_pwm_pulse_ns(s) != hal_sim_pwm_pulse_ns(CTX_GPIO_BASE + s);
+        }
+    }
+
+    // --- 시간: 경로를 번갈아 REPEAT번 실행해 각각 최소값 ---
+    uint64_t best_shim = UINT64_MAX, best_ctx = UINT64_MAX, best_level = UINT64_MAX;
+    for (int r = 0; r < REPEAT; ++r) {
+        uint64_t ns = run_shim(calls);
+        if (ns == 0) return 1;
+        if (ns < best_shim) best_shim = ns;
+        ns = run_ctx(&ctx, calls);
+        if (ns == 0) return 1;
+        if (ns < best_ctx) best_ctx = ns;
+        ns = run_level(calls);
+        if (ns < best_level) best_level = ns;
+    }
+
+    double shim_ns = (double)best_shim / calls, ctx_ns = (double)best_ctx / calls;
+    double level_ns = (double)best_level / calls;
+    printf("servo set path, %u calls x %d (best), %d servos\n", calls, REPEAT, N_SERVOS);
+    printf("  pwm_set_gpio_level only   %7.2f ns/call\n", level_ns);
+    printf("  servo_set (default ctx)   %7.2f ns/call\n", shim_ns);
+    printf("  servo_ctx_set             %7.2f ns/call\n", ctx_ns);
+    printf("  context vs default        %+7.2f ns/call (%+.1f%%)\n", ctx_ns - shim_ns,
+           100.0 * (ctx_ns - shim_ns) / shim_ns);
+    printf("  output check: %s\n", mismatches ? "MISMATCH" : "identical pulse widths for 0-180 deg");
+    return mismatches ? 1 : 0;
+}
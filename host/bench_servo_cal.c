@@ -0,0 +1,222 @@
+// 서보 끝점 자동 캘리브레이션 벤치마크 (servo_cal + 서보 기계 모델)
+//
+// 실제 펌웨어 경로 그대로: servo_cal_run()이 servo_lib으로 펄스를 내고 sleep_ms()로 기다리면 (가상 시간),
+// 측정 콜백이 그동안의 PWM 출력(hal_sim_pwm_pulse_ns)으로 서보 모델을 적분해 전류/피드백을 돌려줍니다.
+//
+// 서보마다 중립/기울기/링키지 정지점/부하/속도/내부 이득을 무작위로 바꾸고 (정지점은 중립에서 30 ~ 60도),
+// 감지 방법(전류, 피드백, 둘 다)별로:
+//   - 성공률, 검출한 정지점과 참 정지점 펄스의 차이, 중심 오차, 걸린 시간, 스윕 중 정지점에 민 시간
+// 끝점 사용 비교 (0도 / 180도 명령을 1 s씩 유지): 추정값(1000 / 2000 us)과 캘리브레이션 값의
+//   - 평균 전류, 정지점에 막혀 민 시간 비율, 쓸 수 있는 각도 (링키지 전체 대비)
+// 마지막에 servo_cal_step 호출 시간
+//
+// 사용법: bench_servo_cal [-n 서보 수]
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal_sim.h"
+#include "pico/time.h"
+#include "servo.h"
+#include "servo_cal.h"
+#include "servo_mech.h"
+
+#define GPIO 2
+#define GUESS_MIN_US 1000
+#define GUESS_MAX_US 2000
+#define HOLD_MS 1000u
+
+typedef struct {
+    servo_mech_t mech;
+    uint64_t last_us;
+} rig_t;
+
+static rig_t rig;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double urange(uint32_t *s, double lo, double hi) {
+    return lo + (hi - lo) * ((double)xorshift(s) / 4294967296.0);
+}
+
+// 지난 측정 이후의 PWM 출력으로 서보 모델을 지금(가상 시간)까지 진행
+static void rig_advance(void) {
+    uint64_t now = time_us_64();
+    servo_mech_step(&rig.mech, hal_sim_pwm_pulse_ns(GPIO), (double)(now - rig.last_us) * 1e-6);
+    rig.last_us = now;
+}
+
+static bool rig_read(void *arg, servo_cal_sample_t *s) {
+    (void)arg;
+    rig_advance();
+    s->current_ma = servo_mech_current_ma(&rig.mech);
+    s->feedback = servo_mech_feedback(&rig.mech);
+    return true;
+}
+
+static void random_servo(uint32_t seed, servo_mech_config_t *c, double *start_deg) {
+    uint32_t rng = seed * 747796405u + 2891336453u;
+    servo_mech_default_config(c);
+    c->center_us = urange(&rng, 1420.0, 1580.0);
+    c->us_per_deg = urange(&rng, 9.0, 11.5);
+    c->stop_lo_deg = 90.0 - urange(&rng, 30.0, 60.0);
+    c->stop_hi_deg = 90.0 + urange(&rng, 30.0, 60.0);
+    c->load = urange(&rng, -0.08, 0.08);
+    c->speed_dps = urange(&rng, 300.0, 450.0);
+    c->gain_per_deg = urange(&rng, 0.10, 0.25);
+    c->fb_offset = urange(&rng, 200.0, 600.0);
+    *start_deg = urange(&rng, c->stop_lo_deg, c->stop_hi_deg);
+}
+
+static void rig_reset(const servo_mech_config_t *c, double start_deg, uint32_t seed, servo_ctx_t *ctx) {
+    hal_sim_reset();
+    hal_sim_use_virtual_time(true);
+    servo_ctx_init(ctx);
+    servo_ctx_add(ctx, GPIO, GUESS_MIN_US, GUESS_MAX_US);
+    servo_mech_init(&rig.mech, c, start_deg, seed);
+    rig.last_us = time_us_64();
+}
+
+// 0도 / 180도를 HOLD_MS씩 유지: 평균 전류, 정지점에 민 시간 비율, 쓴 각도
+static void hold_endpoints(servo_ctx_t *ctx, double *ma, double *stall, double *travel_deg) {
+    double deg[2];
+    double charge0 = rig.mech.charge_mas, stall0 = rig.mech.stall_s;
+    for (int e = 0; e < 2; ++e) {
+        servo_ctx_set(ctx, GPIO, e ? 180 : 0);
+        sleep_ms(HOLD_MS);
+        rig_advance();
+        deg[e] = rig.mech.deg;
+    }
+    double sec = 2.0 * HOLD_MS / 1000.0;
+    *ma = (rig.mech.charge_mas - charge0) / sec;
+    *stall = (rig.mech.stall_s - stall0) / sec;
+    *travel_deg = deg[1] - deg[0];
+}
+
+typedef struct {
+    uint32_t ok;
+    double stop_err_sum, stop_err_max, center_err_sum, center_err_max;
+    double time_sum, time_max, stall_sum;
+    uint32_t steps;
+} cal_stats_t;
+
+typedef struct {
+    double ma, stall, travel;
+} hold_stats_t;
+
+int main(int argc, char **argv) {
+    uint32_t servos = 100;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) servos = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    if (servos == 0) servos = 1;
+
+    static const uint8_t SENSES[] = { SERVO_CAL_SENSE_CURRENT, SERVO_CAL_SENSE_FEEDBACK,
+                                      SERVO_CAL_SENSE_CURRENT | SERVO_CAL_SENSE_FEEDBACK };
+    static const char *SENSE_NAMES[] = { "current", "feedback", "both" };
+    enum { NSENSE = sizeof(SENSES) / sizeof(SENSES[0]) };
+    cal_stats_t stats[NSENSE];
+    hold_stats_t hold_guess = { 0 }, hold_cal = { 0 };
+    memset(stats, 0, sizeof(stats));
+    servo_ctx_t ctx;
+
+    for (uint32_t n = 0; n < servos; ++n) {
+        servo_mech_config_t mc;
+        double start_deg;
+        random_servo(n + 1u, &mc, &start_deg);
+        double true_lo = servo_mech_pulse_us(&mc, mc.stop_lo_deg), true_hi = servo_mech_pulse_us(&mc, mc.stop_hi_deg);
+        double true_center = (true_lo + true_hi) / 2.0;
+
+        // 추정값으로 끝점 유지
+        rig_reset(&mc, start_deg, n + 1u, &ctx);
+        double ma, stall, travel;
+        hold_endpoints(&ctx, &ma, &stall, &travel);
+        hold_guess.ma += ma;
+        hold_guess.stall += stall;
+        hold_guess.travel += travel / (mc.stop_hi_deg - mc.stop_lo_deg);
+
+        for (int k = 0; k < NSENSE; ++k) {
+            rig_reset(&mc, start_deg, n + 1u, &ctx);
+            servo_cal_config_t cc;
+            servo_cal_default_config(&cc);
+            cc.sense = SENSES[k];
+            servo_cal_result_t r;
+            bool ok = servo_cal_run(&ctx, GPIO, &cc, rig_read, NULL, &r);
+            cal_stats_t *st = &stats[k];
+            st->steps += r.steps;
+            st->time_sum += r.elapsed_ms / 1000.0;
+            if (r.elapsed_ms / 1000.0 > st->time_max) st->time_max = r.elapsed_ms / 1000.0;
+            st->stall_sum += rig.mech.stall_s;
+            if (!ok) continue;
+            ++st->ok;
+            double e_lo = fabs(r.stop_min_us - true_lo), e_hi = fabs(r.stop_max_us - true_hi);
+            double e_c = fabs(r.center_us - true_center);
+            st->stop_err_sum += e_lo + e_hi;
+            if (e_lo > st->stop_err_max) st->stop_err_max = e_lo;
+            if (e_hi > st->stop_err_max) st->stop_err_max = e_hi;
+            st->center_err_sum += e_c;
+            if (e_c > st->center_err_max) st->center_err_max = e_c;
+
+            // 캘리브레이션 값으로 끝점 유지 (둘 다 쓰는 경우만)
+            if (SENSES[k] == (SERVO_CAL_SENSE_CURRENT | SERVO_CAL_SENSE_FEEDBACK)) {
+                hold_endpoints(&ctx, &ma, &stall, &travel);
+                hold_cal.ma += ma;
+                hold_cal.stall += stall;
+                hold_cal.travel += travel / (mc.stop_hi_deg - mc.stop_lo_deg);
+            }
+        }
+    }
+
+    printf("서보 %u개, 정지점 중립에서 30 ~ 60도, 20/2 us 간격, 여유 20 us\n", servos);
+    printf("%-9s %6s %17s %17s %15s %9s %7s\n", "sense", "ok", "stop err us avg/max", "center err avg/max",
+           "time s avg/max", "stall ms", "steps");
+    for (int k = 0; k < NSENSE; ++k) {
+        const cal_stats_t *st = &stats[k];
+        double ok = st->ok ? st->ok : 1.0;
+        printf("%-9s %5.1f%% %9.1f / %5.1f %9.1f / %5.1f %7.2f / %5.2f %9.0f %7.1f\n", SENSE_NAMES[k],
+               100.0 * st->ok / servos, st->stop_err_sum / (2.0 * ok), st->stop_err_max, st->center_err_sum / ok,
+               st->center_err_max, st->time_sum / servos, st->time_max, 1000.0 * st->stall_sum / servos,
+               (double)st->steps / servos);
+    }
+
+    double ok = stats[NSENSE - 1].ok ? stats[NSENSE - 1].ok : 1.0;
+    printf("\n끝점 유지 (0도 / 180도 명령 %u ms씩): 평균 전류, 정지점에 민 시간, 쓴 각도 (링키지 전체 대비)\n", HOLD_MS);
+    printf("guess %u/%u us : %6.1f mA %6.1f%% %6.1f%%\n", GUESS_MIN_US, GUESS_MAX_US, hold_guess.ma / servos,
+           100.0 * hold_guess.stall / servos, 100.0 * hold_guess.travel / servos);
+    printf("calibrated      : %6.1f mA %6.1f%% %6.1f%%\n", hold_cal.ma / ok, 100.0 * hold_cal.stall / ok,
+           100.0 * hold_cal.travel / ok);
+
+    // --- servo_cal_step 연산 시간 (정지점 없는 서보를 흉내: 피드백이 펄스를 그대로 따라옴) ---
+    servo_cal_config_t cc;
+    servo_cal_default_config(&cc);
+    servo_cal_t cal;
+    const uint32_t iters = 2000000u;
+    uint32_t calls = 0;
+    uint64_t t0 = now_ns();
+    while (calls < iters) {
+        servo_cal_begin(&cal, &cc);
+        servo_cal_status_t st = SERVO_CAL_RUNNING;
+        while (st == SERVO_CAL_RUNNING) {
+            servo_cal_sample_t s = { 20, (int16_t)(cal.pulse_us * 2 - 1000) };
+            st = servo_cal_step(&cal, &s);
+            ++calls;
+        }
+    }
+    printf("\nservo_cal_step: %.1f ns/call (host)\n", (double)(now_ns() - t0) / calls);
+    return 0;
+}
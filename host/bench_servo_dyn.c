@@ -0,0 +1,249 @@
+// 서보 동특성 측정 / 모델 맞춤 벤치마크 (servo_dyn + 서보 기계 모델)
+//
+// 실제 펌웨어 경로 그대로: servo_dyn_run()이 servo_lib으로 계단 + 처프를 내고 sleep_us()로 기다리면 (가상 시간),
+// 측정 콜백이 그동안의 PWM 출력으로 서보 모델을 적분해 위치 피드백을 돌려줍니다.
+//
+// 서보마다 속도/모터 시정수/내부 이득/불감대/부하/중립을 무작위로 바꾸고:
+//   - 맞춘 모델과 서보 모델의 소신호 참값 (wn = sqrt(속도 x 이득 / 시정수), zeta = 1 / (2 시정수 wn)) 비교
+//   - 검증: 측정에 쓰지 않은 무작위 명령(크고 작은 계단을 무작위 간격으로)을 새로 기록해, 모델 없이 (위치 = 명령) /
+//     1차 / 2차 모델로 예측한 위치 오차 RMS
+//   - servo_dyn_fit 실행 시간 (호스트)과 모델 시뮬레이션 횟수
+//
+// 사용법: bench_servo_dyn [-n 서보 수] [-o 첫 서보 기록.csv] [-i 기록.csv]
+//   -o: t_us,cmd_us,feedback,model1_us,model2_us 로 저장 (그래프용)
+//   -i: 측정 펌웨어(CanSat-Galaxy-ServoDyn)가 출력한 기록(t_us,cmd_us,feedback)을 맞추기만 함
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal_sim.h"
+#include "pico/time.h"
+#include "servo.h"
+#include "servo_dyn.h"
+#include "servo_mech.h"
+
+#define GPIO 2
+#define VALIDATE_MS 3000u
+#define MAX_SAMPLES 8192u
+
+typedef struct {
+    servo_mech_t mech;
+    uint64_t last_us;
+} rig_t;
+
+static rig_t rig;
+static servo_dyn_sample_t record[MAX_SAMPLES], check[MAX_SAMPLES];
+static float pred1[MAX_SAMPLES], pred2[MAX_SAMPLES];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double urange(uint32_t *s, double lo, double hi) {
+    return lo + (hi - lo) * ((double)xorshift(s) / 4294967296.0);
+}
+
+// 지난 측정 이후의 PWM 출력으로 서보 모델을 지금(가상 시간)까지 진행
+static bool rig_read(void *arg, servo_cal_sample_t *s) {
+    (void)arg;
+    uint64_t now = time_us_64();
+    servo_mech_step(&rig.mech, hal_sim_pwm_pulse_ns(GPIO), (double)(now - rig.last_us) * 1e-6);
+    rig.last_us = now;
+    s->current_ma = servo_mech_current_ma(&rig.mech);
+    s->feedback = servo_mech_feedback(&rig.mech);
+    return true;
+}
+
+static void random_servo(uint32_t seed, servo_mech_config_t *c) {
+    uint32_t rng = seed * 2654435761u + 12345u;
+    servo_mech_default_config(c);
+    c->center_us = urange(&rng, 1420.0, 1580.0);
+    c->us_per_deg = urange(&rng, 9.0, 11.5);
+    c->speed_dps = urange(&rng, 250.0, 500.0);
+    c->tau_s = urange(&rng, 0.008, 0.030);
+    c->gain_per_deg = urange(&rng, 0.08, 0.25);
+    c->deadband_deg = urange(&rng, 0.1, 0.4);
+    c->load = urange(&rng, -0.08, 0.08);
+    c->fb_offset = urange(&rng, 200.0, 600.0);
+}
+
+// 캘리브레이션을 마친 서보: 참 중립을 center로, 30 ~ 150도를 min/max로
+static void rig_reset(const servo_mech_config_t *c, uint32_t seed, servo_ctx_t *ctx) {
+    hal_sim_reset();
+    hal_sim_use_virtual_time(true);
+    servo_ctx_init(ctx);
+    servo_ctx_add(ctx, GPIO, DEFAULT_SERVO_MIN_PULSE_US, DEFAULT_SERVO_MAX_PULSE_US);
+    servo_ctx_set_calibration(ctx, GPIO, (uint16_t)lround(servo_mech_pulse_us(c, 30.0)),
+                              (uint16_t)lround(servo_mech_pulse_us(c, 150.0)), (uint16_t)lround(c->center_us));
+    servo_mech_init(&rig.mech, c, 90.0, seed);
+    rig.last_us = time_us_64();
+}
+
+// 검증용 명령: 50 ~ 300 ms마다 중심 +-150 us 안의 무작위 목표 (절반은 +-30 us 안의 작은 움직임)
+static uint32_t record_validation(servo_ctx_t *ctx, uint16_t center_us, uint32_t seed) {
+    uint32_t rng = seed * 747796405u + 1u, n = VALIDATE_MS * 1000u / 2000u;
+    uint16_t cmd = center_us;
+    uint32_t next_change = 0;
+    uint64_t t0 = time_us_64();
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t due = t0 + (uint64_t)i * 2000u, now = time_us_64();
+        if (due > now) sleep_us(due - now);
+        servo_cal_sample_t s;
+        rig_read(NULL, &s);
+        uint32_t t = (uint32_t)(time_us_64() - t0);
+        if (t >= next_change) {
+            double span = xorshift(&rng) & 1u ? 30.0 : 150.0;
+            cmd = (uint16_t)lround(center_us + urange(&rng, -span, span));
+            next_change = t + (uint32_t)urange(&rng, 50000.0, 300000.0);
+        }
+        servo_ctx_set_pulse_us(ctx, GPIO, cmd);
+        check[i] = (servo_dyn_sample_t){ t, cmd, s.feedback };
+    }
+    return n;
+}
+
+static void print_model(const servo_dyn_fit_t *f) {
+    const servo_model_t *m = &f->model;
+    printf("피드백 %.1f + %.4f x 펄스, 속도 한계 %u us/s (계단 %u개)\n", f->fb_offset, f->fb_per_us, m->slew_us_per_s,
+           f->slew_steps);
+    printf("1차: 지연 %.1f ms, 시정수 %.1f ms           오차 %.2f us\n", m->delay1_us / 1000.0, m->tau_us / 1000.0,
+           f->rms_us[1]);
+    printf("2차: 지연 %.1f ms, wn %.1f rad/s, zeta %.3f  오차 %.2f us\n", m->delay2_us / 1000.0, m->wn_x100 / 100.0,
+           m->zeta_x1000 / 1000.0, f->rms_us[2]);
+    printf("동특성 없음 (위치 = 명령)                    오차 %.2f us -> %u차 모델 사용\n", f->rms_us[0], m->order);
+}
+
+// 측정 펌웨어 출력 (t_us,cmd_us,feedback, 숫자로 시작하지 않는 줄은 무시)
+static int fit_file(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    char line[128];
+    uint32_t n = 0;
+    while (n < MAX_SAMPLES && fgets(line, sizeof(line), f)) {
+        unsigned long t, cmd;
+        long fb;
+        if (sscanf(line, "%lu,%lu,%ld", &t, &cmd, &fb) != 3) continue;
+        record[n++] = (servo_dyn_sample_t){ (uint32_t)t, (uint16_t)cmd, (int16_t)fb };
+    }
+    fclose(f);
+
+    servo_dyn_fit_t fit;
+    uint64_t t0 = now_ns();
+    bool ok = servo_dyn_fit(record, n, &fit);
+    double ms = (double)(now_ns() - t0) / 1e6;
+    printf("%s: 샘플 %u개, %.2f s\n", path, n, n ? record[n - 1].t_us / 1e6 : 0.0);
+    if (!ok) {
+        printf("맞춤 실패 (계단 구간 부족 또는 피드백이 명령을 따라오지 않음)\n");
+        return 1;
+    }
+    print_model(&fit);
+    printf("맞춤 %.1f ms (호스트), 시뮬레이션 %u회\n", ms, fit.evals);
+    return 0;
+}
+
+static void save_csv(const char *path, uint32_t n) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return;
+    }
+    fprintf(f, "t_us,cmd_us,feedback,model1_us,model2_us\n");
+    for (uint32_t i = 0; i < n; ++i) {
+        fprintf(f, "%u,%u,%d,%.2f,%.2f\n", record[i].t_us, record[i].cmd_us, record[i].feedback, pred1[i], pred2[i]);
+    }
+    fclose(f);
+}
+
+int main(int argc, char **argv) {
+    uint32_t servos = 100;
+    const char *out_path = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) servos = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) return fit_file(argv[++i]);
+    }
+    if (servos == 0) servos = 1;
+
+    servo_dyn_config_t cfg;
+    servo_dyn_default_config(&cfg);
+    double wn_err = 0.0, zeta_err = 0.0, slew_err = 0.0, delay_sum = 0.0;
+    double rms_fit[3] = { 0 }, rms_check[3] = { 0 }, fit_ms = 0.0, fit_ms_max = 0.0;
+    uint32_t ok = 0, order2 = 0, evals = 0, samples = 0;
+    servo_ctx_t ctx;
+
+    for (uint32_t s = 0; s < servos; ++s) {
+        servo_mech_config_t mc;
+        random_servo(s + 1u, &mc);
+        rig_reset(&mc, s + 1u, &ctx);
+
+        uint32_t n;
+        if (!servo_dyn_record(&ctx, GPIO, &cfg, rig_read, NULL, record, MAX_SAMPLES, &n)) continue;
+        servo_dyn_fit_t fit;
+        uint64_t t0 = now_ns();
+        bool fitted = servo_dyn_fit(record, n, &fit);
+        double ms = (double)(now_ns() - t0) / 1e6;
+        if (!fitted) continue;
+        servo_ctx_set_model(&ctx, GPIO, &fit.model);
+        ++ok;
+        fit_ms += ms;
+        if (ms > fit_ms_max) fit_ms_max = ms;
+        evals += fit.evals;
+        samples += n;
+        order2 += fit.model.order == 2;
+
+        // 소신호 참값 (내부 P 제어 + 1차 모터 = 2차), 속도 한계 참값 = 무부하 속도 (부하는 방향마다 +-)
+        double wn = sqrt(mc.speed_dps * mc.gain_per_deg / mc.tau_s), zeta = 1.0 / (2.0 * mc.tau_s * wn);
+        double slew = mc.speed_dps * mc.us_per_deg;
+        wn_err += fabs(fit.model.wn_x100 / 100.0 - wn) / wn;
+        zeta_err += fabs(fit.model.zeta_x1000 / 1000.0 - zeta) / zeta;
+        slew_err += fabs(fit.model.slew_us_per_s - slew) / slew;
+        delay_sum += fit.model.delay2_us / 1000.0;
+        for (int k = 0; k < 3; ++k) rms_fit[k] += fit.rms_us[k];
+
+        uint32_t m = record_validation(&ctx, (uint16_t)lround(mc.center_us), s + 1u);
+        for (uint8_t k = 0; k < 3; ++k) rms_check[k] += servo_dyn_predict(&fit, k, check, m, NULL);
+
+        if (s == 0) {
+            printf("서보 0 (속도 %.0f dps, 모터 시정수 %.1f ms, 소신호 wn %.1f rad/s zeta %.3f)\n", mc.speed_dps,
+                   mc.tau_s * 1000.0, wn, zeta);
+            print_model(&fit);
+            if (out_path) {
+                servo_dyn_predict(&fit, 1, record, n, pred1);
+                servo_dyn_predict(&fit, 2, record, n, pred2);
+                save_csv(out_path, n);
+                printf("기록 저장: %s\n", out_path);
+            }
+            printf("\n");
+        }
+    }
+
+    double d = ok ? ok : 1.0;
+    printf("서보 %u개 (맞춤 성공 %u), 계단 +-%u us x %u + 처프 +-%u us %.1f ~ %.1f Hz, %u us 간격\n", servos, ok,
+           cfg.step_us, cfg.steps, cfg.chirp_amp_us, cfg.chirp_start_hz_x10 / 10.0, cfg.chirp_end_hz_x10 / 10.0,
+           cfg.sample_us);
+    printf("참값 대비 평균 오차: wn %.1f%%, zeta %.1f%%, 속도 한계 %.1f%% (2차 지연 평균 %.1f ms, 명령 프레임 20 ms)\n",
+           100.0 * wn_err / d, 100.0 * zeta_err / d, 100.0 * slew_err / d, delay_sum / d);
+    printf("위치 오차 RMS (us): 측정 기록 / 검증 기록\n");
+    static const char *NAMES[] = { "static (pos = cmd)", "1st + delay", "2nd + delay" };
+    for (int k = 0; k < 3; ++k) printf("  %-20s %8.2f %8.2f\n", NAMES[k], rms_fit[k] / d, rms_check[k] / d);
+    printf("2차 모델 선택 %u / %u\n", order2, ok);
+    printf("\nservo_dyn_fit: 평균 %.1f ms, 최대 %.1f ms (호스트), 샘플 %.0f개, 시뮬레이션 %.0f회 (샘플 x 횟수 %.2f M)\n",
+           fit_ms / d, fit_ms_max, samples / d, evals / d, (double)samples / d * evals / d / 1e6);
+    return 0;
+}
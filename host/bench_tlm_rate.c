@@ -0,0 +1,374 @@
+// 적응형 텔레메트리 송신률 제어 벤치마크 (하향 링크 채널 시뮬레이션)
+//
+// 채널 모델 (1 ms 단위):
+//   - 무선 모듈: 송신 버퍼 RADIO_BUF_BYTES, 실제 공중 전송률 AIR_BPS[] (스케줄러의 공칭 용량보다 낮음).
+//     버퍼가 넘치면 프레임을 버림 (혼잡 손실)
+//   - 프레임 손실: 지상국 RSSI에 따른 로지스틱 손실 + 사출 직후 기체 회전 중 깊은 페이드.
+//     RSSI = 1 m에서 -40 dBm, 자유 공간 감쇠 (거리 = 고도 + 바람에 밀린 수평 거리)
+//   - 지상국: 500 ms마다 link_report (업링크도 같은 손실, 20 ms 지연)
+//
+// 비행: PAD 10 s -> ASCENT 8 s (700 m) -> DESCENT 약 115 s (6 m/s, 수평 1.5 km까지 표류) -> LANDED 10 s
+// 이벤트: 발사/최고점/사출/착지 (flight_event), 하강 중 조향 서보 동작 1 ~ 3 s마다 (servo_state)
+//
+// 비교:
+//   fixed    : 텔레메트리 10 Hz, 진동 2 Hz 고정, 이벤트는 발생 즉시 한 번 (모두 무선 모듈 버퍼로 바로)
+//   adaptive : tlm_rate (단계별 송신률 + 링크 보고로 예산 조절 + 이벤트 우선/반복)
+//
+// 공중 전송률마다 출력: 단계별 텔레메트리/진동 전달률 (Hz), 비행 중 유효 처리량 (이벤트 중복 제외),
+//       이벤트가 0.5 s / 2 s 안에 도착한 비율, 끝내 못 간 비율, 도착한 이벤트의 평균 지연,
+//       버퍼 넘침/공중 손실. 마지막에 tlm_rate_next 호출 시간
+//
+// 사용법: bench_tlm_rate [-n 비행 수]
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "messages.h"
+#include "tlm_rate.h"
+
+#define LINK_OVERHEAD 6                       // COBS 1 + CRC-32 4 + 구분자 1
+#define NOMINAL_BPS 960u                      // 스케줄러가 아는 공칭 용량 (실제보다 낙관적으로 설정된 경우)
+#define RADIO_BUF_BYTES 256
+#define FADE_DBM (-100)
+#define SENSITIVITY_DBM (-105.0)
+#define REPORT_MS 500u
+#define UPLINK_DELAY_MS 20u
+#define FIFO_SLOTS 64
+#define FAST_MS 500u
+#define SLOW_MS 2000u
+#define MAX_EVENTS 128
+
+#define PAD_MS 10000u
+#define ASCENT_MS 8000u
+#define APOGEE_M 700.0
+#define SINK_MPS 6.0
+#define DRIFT_M 1500.0
+#define LANDED_MS 10000u
+#define TUMBLE_MS 3000u                       // 사출 직후 페이드 구간
+#define TUMBLE_DB 18.0
+
+enum { S_FLIGHT_EVENT, S_SERVO, S_TELEMETRY, S_VIBRATION, S_COUNT };
+static const char *PHASE_NAMES[TLM_RATE_PHASES] = { "pad", "ascent", "descent", "landed" };
+
+static const tlm_stream_config_t STREAMS[S_COUNT] = {
+    [S_FLIGHT_EVENT] = { MSG_FLIGHT_EVENT_FRAME_BYTES + LINK_OVERHEAD, 0, true, { 0 }, 0 },
+    [S_SERVO] = { MSG_SERVO_STATE_FRAME_BYTES + LINK_OVERHEAD, 1, true, { 0 }, 0 },
+    [S_TELEMETRY] = { MSG_TELEMETRY_FRAME_BYTES + LINK_OVERHEAD, 2, false, { 10, 200, 100, 5 }, 10 },
+    [S_VIBRATION] = { MSG_VIBRATION_FRAME_BYTES + LINK_OVERHEAD, 3, false, { 5, 40, 20, 0 }, 0 },
+};
+#define FIXED_TLM_MS 100u
+#define FIXED_VIB_MS 500u
+
+typedef struct {
+    uint8_t stream;
+    uint16_t seq;
+    uint32_t sent_ms;
+} frame_t;
+
+typedef struct {
+    uint8_t stream;
+    uint32_t raised_ms, delivered_ms;
+    uint32_t superseded_ms;                   // 같은 스트림의 다음 이벤트 (그 뒤에 보낸 프레임은 이 이벤트가 아님)
+    bool delivered;
+} event_t;
+
+typedef struct {
+    uint32_t rng;
+    // 무선 모듈
+    frame_t fifo[FIFO_SLOTS];
+    uint32_t head, tail, buf_bytes;
+    double air_progress;                      // 버퍼 맨 앞 프레임에서 이미 보낸 바이트
+    // 지상국
+    uint16_t rx_frames, last_seq;
+    uint32_t next_report_ms, report_due_ms;
+    bool report_pending;
+    uint16_t rep_seq, rep_rx;
+    int8_t rep_rssi;
+    // 이벤트
+    event_t events[MAX_EVENTS];
+    uint32_t event_count;
+    // 통계
+    uint32_t delivered[S_COUNT][TLM_RATE_PHASES];
+    uint32_t phase_ms[TLM_RATE_PHASES];
+    uint64_t useful_bytes;                    // 비행 중 (상승 + 하강)
+    uint32_t overflow, air_lost, sent_frames;
+} sim_t;
+
+typedef struct {
+    double tlm_hz[TLM_RATE_PHASES], vib_hz[TLM_RATE_PHASES];
+    double goodput_bps, overflow, air_lost, sent;
+    double lat_sum;
+    uint32_t events, delivered, fast, slow;
+} result_t;
+
+static const double AIR_BPS[] = { 640.0, 480.0, 320.0 };
+static double air_bps;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double urand(uint32_t *s) {
+    return (double)xorshift(s) / 4294967296.0;
+}
+
+// --- 비행 / 채널 ---
+
+static uint8_t phase_at(uint32_t t_ms, uint32_t land_ms) {
+    if (t_ms < PAD_MS) return 0;
+    if (t_ms < PAD_MS + ASCENT_MS) return 1;
+    if (t_ms < land_ms) return 2;
+    return 3;
+}
+
+static double rssi_at(uint32_t t_ms, uint32_t land_ms) {
+    double alt, horiz;
+    uint32_t apogee_ms = PAD_MS + ASCENT_MS;
+    if (t_ms < PAD_MS) {
+        alt = 0.0;
+        horiz = 0.0;
+    } else if (t_ms < apogee_ms) {
+        double f = (double)(t_ms - PAD_MS) / ASCENT_MS;
+        alt = APOGEE_M * f * (2.0 - f);
+        horiz = 0.0;
+    } else {
+        double f = t_ms < land_ms ? (double)(t_ms - apogee_ms) / (double)(land_ms - apogee_ms) : 1.0;
+        alt = APOGEE_M * (1.0 - f);
+        horiz = DRIFT_M * f;
+    }
+    double d = sqrt(alt * alt + horiz * horiz + 50.0 * 50.0);
+    double rssi = -40.0 - 20.0 * log10(d);
+    if (t_ms >= apogee_ms && t_ms < apogee_ms + TUMBLE_MS) {
+        rssi -= TUMBLE_DB * fabs(sin((double)(t_ms - apogee_ms) * 0.004)); // 안테나 방향이 돌며 깊은 널
+    }
+    return rssi;
+}
+
+static double loss_prob(double rssi) {
+    return 0.01 + 0.99 / (1.0 + exp((rssi - SENSITIVITY_DBM) / 1.5));
+}
+
+static void raise_event(sim_t *s, uint8_t stream, uint32_t t) {
+    if (s->event_count == MAX_EVENTS) return;
+    for (uint32_t i = 0; i < s->event_count; ++i) {
+        if (s->events[i].stream == stream && s->events[i].superseded_ms == UINT32_MAX) s->events[i].superseded_ms = t;
+    }
+    s->events[s->event_count++] = (event_t){ stream, t, 0, UINT32_MAX, false };
+}
+
+static bool radio_push(sim_t *s, uint8_t stream, uint16_t seq, uint32_t t) {
+    uint32_t bytes = STREAMS[stream].frame_bytes;
+    ++s->sent_frames;
+    if (s->buf_bytes + bytes > RADIO_BUF_BYTES || s->head - s->tail == FIFO_SLOTS) {
+        ++s->overflow;
+        return false;
+    }
+    s->fifo[s->head++ % FIFO_SLOTS] = (frame_t){ stream, seq, t };
+    s->buf_bytes += bytes;
+    return true;
+}
+
+// 1 ms 동안 공중으로 보내고 지상국 수신 처리
+static void radio_step(sim_t *s, uint32_t t, double rssi, uint8_t phase) {
+    s->air_progress += air_bps / 1000.0;
+    while (s->head != s->tail) {
+        frame_t *f = &s->fifo[s->tail % FIFO_SLOTS];
+        uint32_t bytes = STREAMS[f->stream].frame_bytes;
+        if (s->air_progress < bytes) return;
+        s->air_progress -= bytes;
+        s->buf_bytes -= bytes;
+        ++s->tail;
+        if (urand(&s->rng) < loss_prob(rssi)) {
+            ++s->air_lost;
+            continue;
+        }
+        ++s->rx_frames;
+        s->last_seq = f->seq;
+        bool useful = !STREAMS[f->stream].event;
+        for (uint32_t i = 0; i < s->event_count; ++i) {
+            event_t *e = &s->events[i];
+            if (e->stream == f->stream && !e->delivered && e->raised_ms <= f->sent_ms && f->sent_ms < e->superseded_ms) {
+                e->delivered = true;
+                e->delivered_ms = t;
+                useful = true; // 이벤트 프레임은 처음 도착한 사본만 유효
+            }
+        }
+        if (useful) {
+            ++s->delivered[f->stream][phase];
+            if (phase == 1 || phase == 2) s->useful_bytes += bytes;
+        }
+    }
+    s->air_progress = 0.0; // 보낼 것이 없으면 공중 시간을 쌓아 두지 않음
+}
+
+static void run_flight(uint32_t seed, bool adaptive, result_t *r) {
+    static sim_t sim;
+    sim_t *s = &sim;
+    memset(s, 0, sizeof(*s));
+    s->rng = seed * 2654435761u + 1u;
+    uint32_t land_ms = PAD_MS + ASCENT_MS + (uint32_t)(APOGEE_M / SINK_MPS * 1000.0);
+    uint32_t end_ms = land_ms + LANDED_MS;
+
+    // 하강 중 서보 동작 시각 (비행마다 다름, 두 방식에 같게)
+    uint32_t next_servo = PAD_MS + ASCENT_MS + 1000u + (uint32_t)(urand(&s->rng) * 2000.0);
+
+    tlm_rate_t tr;
+    tlm_rate_init(&tr, STREAMS, S_COUNT, NOMINAL_BPS, FADE_DBM);
+    uint32_t next_tlm = 0, next_vib = 0;
+    uint8_t prev_phase = 0;
+    s->next_report_ms = REPORT_MS;
+
+    for (uint32_t t = 0; t < end_ms; ++t) {
+        uint8_t phase = phase_at(t, land_ms);
+        double rssi = rssi_at(t, land_ms);
+        ++s->phase_ms[phase];
+
+        // 이벤트
+        int ev_stream = -1;
+        if (phase != prev_phase) {
+            ev_stream = S_FLIGHT_EVENT; // 발사 / 최고점+사출 / 착지
+            prev_phase = phase;
+            if (adaptive) tlm_rate_set_phase(&tr, phase);
+        } else if (phase == 2 && t >= next_servo) {
+            ev_stream = S_SERVO;
+            next_servo = t + 1000u + (uint32_t)(urand(&s->rng) * 2000.0);
+        }
+        if (ev_stream >= 0) {
+            raise_event(s, (uint8_t)ev_stream, t);
+            if (adaptive) {
+                tlm_rate_event(&tr, (uint8_t)ev_stream);
+            } else {
+                radio_push(s, (uint8_t)ev_stream, (uint16_t)s->sent_frames, t);
+            }
+        }
+
+        // 송신
+        if (adaptive) {
+            int i;
+            while ((i = tlm_rate_next(&tr, t)) >= 0) {
+                uint16_t seq = (uint16_t)s->sent_frames;
+                radio_push(s, (uint8_t)i, seq, t);
+                tlm_rate_sent(&tr, seq, STREAMS[i].frame_bytes);
+            }
+        } else {
+            if (t >= next_tlm) {
+                radio_push(s, S_TELEMETRY, (uint16_t)s->sent_frames, t);
+                next_tlm = t + FIXED_TLM_MS;
+            }
+            if (t >= next_vib) {
+                radio_push(s, S_VIBRATION, (uint16_t)s->sent_frames, t);
+                next_vib = t + FIXED_VIB_MS;
+            }
+        }
+
+        radio_step(s, t, rssi, phase);
+
+        // 지상국 보고 (업링크 손실 + 지연)
+        if (t >= s->next_report_ms) {
+            s->next_report_ms = t + REPORT_MS;
+            if (urand(&s->rng) >= loss_prob(rssi)) {
+                s->report_pending = true;
+                s->report_due_ms = t + UPLINK_DELAY_MS;
+                s->rep_seq = s->last_seq;
+                s->rep_rx = s->rx_frames;
+                s->rep_rssi = (int8_t)lround(rssi);
+            }
+        }
+        if (s->report_pending && t >= s->report_due_ms) {
+            s->report_pending = false;
+            if (adaptive) tlm_rate_report(&tr, s->rep_seq, s->rep_rx, s->rep_rssi, t);
+        }
+    }
+
+    for (int p = 0; p < TLM_RATE_PHASES; ++p) {
+        double sec = s->phase_ms[p] / 1000.0;
+        r->tlm_hz[p] += s->delivered[S_TELEMETRY][p] / sec;
+        r->vib_hz[p] += s->delivered[S_VIBRATION][p] / sec;
+    }
+    r->goodput_bps += (double)s->useful_bytes / ((s->phase_ms[1] + s->phase_ms[2]) / 1000.0);
+    r->overflow += s->overflow;
+    r->air_lost += s->air_lost;
+    r->sent += s->sent_frames;
+    for (uint32_t i = 0; i < s->event_count; ++i) {
+        ++r->events;
+        if (!s->events[i].delivered) continue;
+        uint32_t l = s->events[i].delivered_ms - s->events[i].raised_ms;
+        ++r->delivered;
+        r->lat_sum += l;
+        if (l <= FAST_MS) ++r->fast;
+        if (l <= SLOW_MS) ++r->slow;
+    }
+}
+
+static void print_result(const char *name, const result_t *r, uint32_t flights) {
+    printf("%-9s", name);
+    for (int p = 0; p < TLM_RATE_PHASES; ++p) printf(" %5.2f/%4.2f", r->tlm_hz[p] / flights, r->vib_hz[p] / flights);
+    double ev = r->events ? (double)r->events : 1.0;
+    printf(" %8.1f %6.1f%% %6.1f%% %6.1f%% %6.0f %5.1f%% %5.1f%%\n", r->goodput_bps / flights, 100.0 * r->fast / ev,
+           100.0 * r->slow / ev, 100.0 * (r->events - r->delivered) / ev, r->delivered ? r->lat_sum / r->delivered : 0.0,
+           100.0 * r->overflow / r->sent, 100.0 * r->air_lost / r->sent);
+}
+
+static void timing(void) {
+    tlm_rate_t tr;
+    tlm_rate_init(&tr, STREAMS, S_COUNT, NOMINAL_BPS, FADE_DBM);
+    tlm_rate_set_phase(&tr, 1);
+    const uint32_t iters = 5000000u;
+    uint32_t frames = 0;
+    uint16_t seq = 0;
+    uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < iters; ++i) {
+        if ((i & 1023u) == 0) tlm_rate_event(&tr, S_SERVO);
+        int k;
+        while ((k = tlm_rate_next(&tr, i)) >= 0) {
+            tlm_rate_sent(&tr, seq++, STREAMS[k].frame_bytes);
+            ++frames;
+        }
+        if ((i % REPORT_MS) == 0) tlm_rate_report(&tr, (uint16_t)(seq), (uint16_t)(seq - (i & 7u)), -90, i);
+    }
+    double ns = (double)(now_ns() - t0) / (iters + frames);
+    printf("\ntlm_rate_next: %.1f ns/call (host), %u frames in %u ms simulated\n", ns, frames, iters);
+}
+
+int main(int argc, char **argv) {
+    uint32_t flights = 50;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) flights = (uint32_t)strtoul(argv[++i], NULL, 10);
+    }
+
+    printf("== 하향 링크 시뮬레이션 (%u 비행, 공칭 %u B/s, 버퍼 %d B) ==\n", flights, NOMINAL_BPS, RADIO_BUF_BYTES);
+    for (size_t k = 0; k < sizeof(AIR_BPS) / sizeof(AIR_BPS[0]); ++k) {
+        result_t fixed, adaptive;
+        memset(&fixed, 0, sizeof(fixed));
+        memset(&adaptive, 0, sizeof(adaptive));
+        air_bps = AIR_BPS[k];
+        for (uint32_t f = 0; f < flights; ++f) {
+            run_flight(f, false, &fixed);
+            run_flight(f, true, &adaptive);
+        }
+
+        printf("\n공중 전송률 %.0f B/s\n%-9s", air_bps, "");
+        for (int p = 0; p < TLM_RATE_PHASES; ++p) printf(" %10s", PHASE_NAMES[p]);
+        printf(" %8s %7s %7s %7s %6s %6s %6s\n", "goodput", "ev<0.5s", "ev<2s", "ev_lost", "lat_ms", "ovfl", "air");
+        printf("%-9s", "");
+        for (int p = 0; p < TLM_RATE_PHASES; ++p) printf(" %10s", "tlm/vib Hz");
+        printf(" %8s\n", "B/s");
+        print_result("fixed", &fixed, flights);
+        print_result("adaptive", &adaptive, flights);
+    }
+    timing();
+    return 0;
+}
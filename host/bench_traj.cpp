@@ -0,0 +1,145 @@
+// 궤적 재구성(traj_smoother) 벤치마크
+//
+// 합성 비행(flight_synth)을 만들어 traj_smooth 도구와 같은 방식으로 수직 채널을 재구성합니다.
+//   1) 정확도   : 기압 고도 / 전방 필터 / RTS 스무더의 비행 구간 고도·속도 RMS 오차
+//                 (참값 = 합성 비행의 고도/속도)
+//   2) 구간 분할 : 한 번에 처리한 결과와 구간 병렬 결과의 최대 차이 (앞부분 20분)
+//   3) 처리량   : 전체 비행을 워커 수별로 처리한 속도
+//
+// 사용법: bench_traj [minutes]
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "flight_synth.h"
+#include "logk.h"
+#include "units.h"
+}
+#include "traj_smoother.hpp"
+
+namespace {
+
+using cansat::traj::Channel;
+using cansat::traj::Config;
+using cansat::traj::State;
+using cansat::traj::Stats;
+
+struct Flight {
+    std::vector<std::uint32_t> t_us;
+    std::vector<float> baro_alt, accel;
+    std::vector<double> true_alt, true_vel;
+    std::size_t flight_begin, flight_end;  // 발사 ~ 착지 후 10 s
+};
+
+Flight make_flight(std::size_t n) {
+    Flight f;
+    std::vector<std::int32_t> pressure(n);
+    std::vector<std::int16_t> accel_z(n);
+    f.t_us.resize(n);
+    f.true_alt.resize(n);
+    f.true_vel.resize(n);
+    flight_synth_t synth;
+    flight_synth_init(&synth, static_cast<std::uint32_t>(n), 7);
+    f.flight_begin = n / 10;
+    f.flight_end = n;
+    for (std::size_t i = 0; i < n; ++i) {
+        flight_record_t r;
+        flight_synth_next(&synth, &r);
+        f.t_us[i] = r.timestamp_us;
+        pressure[i] = r.pressure_pa;
+        accel_z[i] = r.accel[2];
+        f.true_alt[i] = synth.alt_m;
+        f.true_vel[i] = synth.vel_mps;
+        if (f.flight_end == n && i > f.flight_begin + 10000 && synth.alt_m == 0.0) f.flight_end = i + 10000;
+    }
+    f.flight_end = std::min(f.flight_end, n);
+
+    // traj_smooth 와 같은 변환 (기준 기압 = 첫 1초 평균)
+    double p_sum = 0.0;
+    for (std::size_t i = 0; i < 1000; ++i) p_sum += pressure[i];
+    float p0 = static_cast<float>(p_sum / 1000.0);
+    f.baro_alt.resize(n);
+    f.accel.resize(n);
+    logk_pressure_to_alt(pressure.data(), f.baro_alt.data(), n, p0);
+    logk_i16_to_f32(accel_z.data(), f.accel.data(), n, UNITS_ACCEL_MPS2_PER_LSB);
+    for (float &a : f.accel) a -= UNITS_STANDARD_GRAVITY;
+    return f;
+}
+
+void rms(const Flight &f, const char *label, const float *alt, const State *s) {
+    double ea = 0.0, ev = 0.0;
+    std::size_t n = f.flight_end - f.flight_begin;
+    for (std::size_t i = f.flight_begin; i < f.flight_end; ++i) {
+        double da = (s ? s[i].pos : alt[i]) - f.true_alt[i];
+        ea += da * da;
+        if (s) {
+            double dv = s[i].vel - f.true_vel[i];
+            ev += dv * dv;
+        }
+    }
+    if (s) {
+        std::printf("  %-18s alt rms %6.3f m   vel rms %6.3f m/s\n", label, std::sqrt(ea / n), std::sqrt(ev / n));
+    } else {
+        std::printf("  %-18s alt rms %6.3f m\n", label, std::sqrt(ea / n));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    double minutes = argc > 1 ? std::strtod(argv[1], nullptr) : 120.0;
+    std::size_t n = static_cast<std::size_t>(minutes * 60000.0);
+    if (n < 200000) n = 200000;
+    Flight f = make_flight(n);
+    std::printf("flight: %zu samples (%.0f min at 1 kHz), flight phase %zu..%zu, hw threads %u\n", n, n / 60000.0,
+                f.flight_begin, f.flight_end, std::thread::hardware_concurrency());
+    std::vector<Channel> channels = {{f.accel.data(), f.baro_alt.data(), {}}};
+
+    // --- 1) 정확도 ---
+    std::vector<State> filtered(n), smoothed(n);
+    Config config;
+    config.smooth = false;
+    cansat::traj::smooth(f.t_us.data(), n, channels, config, {filtered.data()});
+    config.smooth = true;
+    cansat::traj::smooth(f.t_us.data(), n, channels, config, {smoothed.data()});
+    std::printf("accuracy over the flight phase:\n");
+    rms(f, "barometer only", f.baro_alt.data(), nullptr);
+    rms(f, "forward filter", nullptr, filtered.data());
+    rms(f, "RTS smoother", nullptr, smoothed.data());
+
+    // --- 2) 구간 분할 vs 한 번에 ---
+    std::size_t prefix = std::min<std::size_t>(n, 1200000);
+    std::vector<State> whole(prefix), split(prefix);
+    Config single;
+    single.segment = 0;
+    single.workers = 1;
+    Stats s_single = cansat::traj::smooth(f.t_us.data(), prefix, channels, single, {whole.data()});
+    Stats s_split = cansat::traj::smooth(f.t_us.data(), prefix, channels, Config{}, {split.data()});
+    double max_da = 0.0, max_dv = 0.0;
+    for (std::size_t i = 0; i < prefix; ++i) {
+        max_da = std::max(max_da, static_cast<double>(std::fabs(whole[i].pos - split[i].pos)));
+        max_dv = std::max(max_dv, static_cast<double>(std::fabs(whole[i].vel - split[i].vel)));
+    }
+    std::printf("segmented vs single pass (%zu samples, %zu units): max |d alt| %.2e m, max |d vel| %.2e m/s\n",
+                prefix, s_split.units, max_da, max_dv);
+    std::printf("  single pass %.1f Msamples/s\n", prefix / (s_single.wall_ns / 1e3));
+
+    // --- 3) 처리량 ---
+    std::printf("throughput (segment %zu, overlap %zu):\n", Config{}.segment, Config{}.overlap);
+    double base = 0.0;
+    for (unsigned workers : {1u, 2u, 4u, 8u}) {
+        Config c;
+        c.workers = workers;
+        Stats s = cansat::traj::smooth(f.t_us.data(), n, channels, c, {smoothed.data()});
+        double rate = n / (s.wall_ns / 1e3);
+        if (workers == 1) base = rate;
+        std::printf("  workers %u  %7.1f ms  %6.2f Msamples/s  speedup %.2fx  (%.2f filter passes per sample)\n",
+                    workers, s.wall_ns / 1e6, rate, rate / base, static_cast<double>(s.samples_processed) / n);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+// 열 지향 로그에서 채널 하나를 CSV로 꺼내는 지상 도구
+//
+// 사용법: collog_extract <log> [channel] [t0_s] [t1_s] [offset]
+//   channel을 생략하면 채널 목록만 출력합니다.
+//   offset: 파일 안의 로그 시작 위치 (sdlog 파일이면 헤더 블록 512)
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "collog_reader.h"
+
+static const char *type_name(uint8_t type) {
+    static const char *names[] = { "u8", "i8", "u16", "i16", "u32", "i32", "f32" };
+    return type < sizeof(names) / sizeof(names[0]) ? names[type] : "?";
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <log> [channel] [t0_s] [t1_s] [offset]\n", argv[0]);
+        return 2;
+    }
+    size_t offset = argc > 5 ? strtoul(argv[5], NULL, 0) : 0;
+
+    collog_reader_t r;
+    if (!collog_reader_open(&r, argv[1], offset, 0)) {
+        fprintf(stderr, "cannot open %s as a column log\n", argv[1]);
+        return 1;
+    }
+
+    if (argc < 3) {
+        for (uint32_t c = 0; c < r.channel_count; ++c) {
+            printf("%2u %-12s %s\n", c, r.channels[c].name, type_name(r.channels[c].type));
+        }
+        printf("index: %s\n", r.index ? "present" : "missing (scanning chunk headers)");
+        collog_reader_close(&r);
+        return 0;
+    }
+
+    int channel = collog_reader_find(&r, argv[2]);
+    if (channel < 0) {
+        fprintf(stderr, "no channel '%s'\n", argv[2]);
+        collog_reader_close(&r);
+        return 1;
+    }
+    // 시각은 타임스탬프 바퀴 수를 붙인 값 (71.6분이 넘는 로그도 계속 증가)
+    uint64_t t0_us = argc > 3 ? (uint64_t)(strtod(argv[3], NULL) * 1e6) : 0;
+    uint64_t t1_us = argc > 4 ? (uint64_t)(strtod(argv[4], NULL) * 1e6) : UINT64_MAX;
+
+    // 청크 단위로 나눠 꺼내며 출력 (메모리 고정)
+    enum { BATCH = 65536 };
+    static uint64_t t[BATCH];
+    static double v[BATCH];
+    printf("t_us,%s\n", argv[2]);
+    while (t0_us <= t1_us) {
+        size_t n = collog_reader_extract(&r, channel, t0_us, t1_us, t, v, BATCH);
+        for (size_t i = 0; i < n; ++i) printf("%llu,%.10g\n", (unsigned long long)t[i], v[i]);
+        if (n < BATCH || t[n - 1] == UINT64_MAX) break;
+        t0_us = t[n - 1] + 1;
+    }
+
+    collog_reader_close(&r);
+    return 0;
+}
@@ -0,0 +1,215 @@
+#define _POSIX_C_SOURCE 200809L
+#include "collog_reader.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ALIGN4(x) (((x) + 3u) & ~3u)
+
+// --- 내부 함수 ---
+
+static const collog_chunk_header_t *chunk_at(const collog_reader_t *r, uint32_t offset) {
+    if ((uint64_t)offset + sizeof(collog_chunk_header_t) > r->data_end) return NULL;
+    const collog_chunk_header_t *h = (const collog_chunk_header_t *)(r->base + offset);
+    if (h->magic != COLLOG_CHUNK_MAGIC || h->channel_count != r->channel_count ||
+        h->chunk_bytes < sizeof(*h) || (uint64_t)offset + h->chunk_bytes > r->data_end) {
+        return NULL; // 패딩, 잘린 청크 또는 손상
+    }
+    // 열들이 청크 안에 들어가야 함 (rows가 손상되면 열 읽기가 청크 밖으로 나감)
+    uint64_t body = sizeof(*h);
+    for (uint32_t c = 0; c < r->channel_count; ++c) body += ALIGN4((uint64_t)h->rows * r->channels[c].size);
+    if (body > h->chunk_bytes) return NULL;
+    return h;
+}
+
+static const uint8_t *chunk_column(const collog_reader_t *r, const collog_chunk_header_t *h, int channel) {
+    uint32_t off = sizeof(*h);
+    for (int c = 0; c < channel; ++c) off += ALIGN4((uint32_t)h->rows * r->channels[c].size);
+    return (const uint8_t *)h + off;
+}
+
+// 바퀴 수를 붙인 64비트 시각
+static uint64_t extend(uint32_t epoch, uint32_t t_us) {
+    return ((uint64_t)epoch << 32) | t_us;
+}
+
+// 청크 안의 시각: 청크 첫 행으로부터의 차이 (청크 하나는 한 바퀴보다 짧음)
+static uint64_t extend_from(uint64_t first_us, uint32_t t_first_us, uint32_t t_us) {
+    return first_us + (uint32_t)(t_us - t_first_us);
+}
+
+static uint64_t index_time(const collog_index_entry_t *e) {
+    return extend(e->t_epoch, e->t_first_us);
+}
+
+// 첫 행 시각 <= t0_us 인 마지막 색인 항목의 청크 (없으면 첫 청크)
+static uint32_t seek(const collog_reader_t *r, uint64_t t0_us) {
+    if (!r->index || r->index_count == 0 || index_time(&r->index[0]) > t0_us) return r->data_offset;
+    uint32_t lo = 0, hi = r->index_count; // index[lo] <= t0_us < index[hi]
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (index_time(&r->index[mid]) <= t0_us) lo = mid;
+        else hi = mid;
+    }
+    return r->index[lo].offset;
+}
+
+static uint32_t read_u32(const uint8_t *col, uint32_t row) {
+    uint32_t v;
+    memcpy(&v, col + (size_t)row * 4, 4);
+    return v;
+}
+
+// 연속 구간 변환 (타입 분기를 루프 밖으로)
+#define CONVERT(ctype)                                              \
+    for (uint32_t i = 0; i < n; ++i) {                              \
+        ctype v;                                                    \
+        memcpy(&v, col + (size_t)(first + i) * sizeof(ctype), sizeof(ctype)); \
+        out[i] = (double)v;                                         \
+    }
+
+static void convert(const uint8_t *col, uint8_t type, uint32_t first, uint32_t n, double *out) {
+    switch (type) {
+        case COLLOG_U8: CONVERT(uint8_t) break;
+        case COLLOG_I8: CONVERT(int8_t) break;
+        case COLLOG_U16: CONVERT(uint16_t) break;
+        case COLLOG_I16: CONVERT(int16_t) break;
+        case COLLOG_U32: CONVERT(uint32_t) break;
+        case COLLOG_I32: CONVERT(int32_t) break;
+        case COLLOG_F32: CONVERT(float) break;
+    }
+}
+
+// 구간 안의 행을 청크별로 꺼냄 (raw이면 원래 타입 그대로 복사, 아니면 double 변환)
+static size_t extract(const collog_reader_t *r, int channel, uint64_t t0_us, uint64_t t1_us,
+                      uint64_t *t_out, void *out, bool raw, size_t cap) {
+    if (channel < 0 || (uint32_t)channel >= r->channel_count) return 0;
+    uint8_t type = r->channels[channel].type;
+    uint8_t size = r->channels[channel].size;
+    size_t count = 0;
+
+    uint32_t offset = seek(r, t0_us);
+    const collog_chunk_header_t *h;
+    while (count < cap && (h = chunk_at(r, offset)) != NULL) {
+        offset += h->chunk_bytes;
+        uint64_t chunk_first = extend(h->t_epoch, h->t_first_us);
+        uint64_t chunk_last = extend_from(chunk_first, h->t_first_us, h->t_last_us);
+        if (chunk_last < t0_us) continue;
+        if (chunk_first > t1_us) break;
+
+        const uint8_t *col = chunk_column(r, h, channel);
+        const uint8_t *tcol = (const uint8_t *)(h + 1); // 채널 0 = 타임스탬프
+
+        // 구간 안의 행 범위 [first, last)
+        uint32_t first = 0, last = h->rows;
+        if (chunk_first < t0_us) {
+            while (first < last && extend_from(chunk_first, h->t_first_us, read_u32(tcol, first)) < t0_us) ++first;
+        }
+        if (chunk_last > t1_us) {
+            while (last > first && extend_from(chunk_first, h->t_first_us, read_u32(tcol, last - 1)) > t1_us) --last;
+        }
+        uint32_t n = last - first;
+        if (n > cap - count) n = (uint32_t)(cap - count);
+
+        if (raw) {
+            memcpy((uint8_t *)out + count * size, col + (size_t)first * size, (size_t)n * size);
+        } else {
+            convert(col, type, first, n, (double *)out + count);
+        }
+        if (t_out) {
+            for (uint32_t i = 0; i < n; ++i) {
+                t_out[count + i] = extend_from(chunk_first, h->t_first_us, read_u32(tcol, first + i));
+            }
+        }
+        count += n;
+    }
+    return count;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool collog_reader_open(collog_reader_t *r, const char *path, size_t offset, size_t length) {
+    memset(r, 0, sizeof(*r));
+    r->fd = -1;
+    if (offset % 4 != 0) return false; // 청크 헤더/색인을 직접 읽으므로 4바이트 정렬
+    r->fd = open(path, O_RDONLY);
+    if (r->fd < 0) return false;
+
+    struct stat st;
+    if (fstat(r->fd, &st) != 0 || (size_t)st.st_size <= offset) goto fail;
+    size_t file_len = (size_t)st.st_size;
+    void *map = mmap(NULL, file_len, PROT_READ, MAP_SHARED, r->fd, 0);
+    if (map == MAP_FAILED) goto fail;
+    r->map = map;
+    r->map_len = file_len;
+    r->base = (const uint8_t *)map + offset;
+    r->len = file_len - offset;
+    if (length && length < r->len) r->len = length;
+    // 오프셋 계산이 u32이므로 4 GB 미만만 지원
+    if (r->len >= 0xFFFFFFFFu) goto fail;
+
+    collog_file_header_t h;
+    if (r->len < sizeof(h)) goto fail;
+    memcpy(&h, r->base, sizeof(h));
+    if (h.magic != COLLOG_FILE_MAGIC || h.version != COLLOG_VERSION || h.channel_count == 0 ||
+        h.channel_count > COLLOG_MAX_CHANNELS ||
+        h.header_bytes != sizeof(h) + h.channel_count * sizeof(collog_channel_desc_t) || h.header_bytes > r->len) {
+        goto fail;
+    }
+    r->channel_count = h.channel_count;
+    memcpy(r->channels, r->base + sizeof(h), h.channel_count * sizeof(collog_channel_desc_t));
+    for (uint32_t c = 0; c < r->channel_count; ++c) {
+        r->channels[c].name[COLLOG_NAME_LEN - 1] = '\0';
+        // 변환/열 위치 계산이 size를 믿으므로 타입과 맞아야 함. 채널 0은 u32 타임스탬프
+        if (r->channels[c].size == 0 || r->channels[c].size != collog_type_size((collog_type_t)r->channels[c].type)) {
+            goto fail;
+        }
+    }
+    if (r->channels[0].type != COLLOG_U32) goto fail;
+    r->data_offset = h.header_bytes;
+    r->data_end = (uint32_t)r->len;
+
+    // 트레일러가 정상이면 색인 사용, 아니면 청크 헤더를 처음부터 따라감
+    collog_trailer_t t;
+    if (r->len >= r->data_offset + sizeof(t)) {
+        memcpy(&t, r->base + r->len - sizeof(t), sizeof(t));
+        uint64_t index_end = (uint64_t)t.index_offset + (uint64_t)t.entries * sizeof(collog_index_entry_t);
+        if (t.magic == COLLOG_TRAILER_MAGIC && t.index_offset >= r->data_offset &&
+            index_end + sizeof(t) == r->len && t.index_offset % 4 == 0) {
+            r->index = (const collog_index_entry_t *)(r->base + t.index_offset);
+            r->index_count = t.entries;
+            r->data_end = t.index_offset;
+        }
+    }
+    return true;
+
+fail:
+    collog_reader_close(r);
+    return false;
+}
+
+void collog_reader_close(collog_reader_t *r) {
+    if (r->map) munmap((void *)r->map, r->map_len);
+    if (r->fd >= 0) close(r->fd);
+    memset(r, 0, sizeof(*r));
+    r->fd = -1;
+}
+
+int collog_reader_find(const collog_reader_t *r, const char *name) {
+    for (uint32_t c = 0; c < r->channel_count; ++c) {
+        if (strncmp(r->channels[c].name, name, COLLOG_NAME_LEN) == 0) return (int)c;
+    }
+    return -1;
+}
+
+size_t collog_reader_extract(const collog_reader_t *r, int channel, uint64_t t0_us, uint64_t t1_us,
+                             uint64_t *t_out, double *v_out, size_t cap) {
+    return extract(r, channel, t0_us, t1_us, t_out, v_out, false, cap);
+}
+
+size_t collog_reader_extract_raw(const collog_reader_t *r, int channel, uint64_t t0_us, uint64_t t1_us,
+                                 uint64_t *t_out, void *v_out, size_t cap) {
+    return extract(r, channel, t0_us, t1_us, t_out, v_out, true, cap);
+}
@@ -0,0 +1,74 @@
+#ifndef COLLOG_READER_H_
+#define COLLOG_READER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "collog.h"
+
+/*
+ * 열 지향 로그(collog.h) 호스트 리더.
+ *
+ * 파일을 mmap 하고, 트레일러의 청크 색인으로 시작 청크를 찾은 뒤 청크 헤더만 따라가며
+ * 요청한 채널의 열과(시간 범위 경계 청크에서만) 타임스탬프 열을 읽습니다.
+ * 다른 채널의 데이터는 건드리지 않으므로 페이지 캐시에도 올라오지 않습니다.
+ *
+ * 시각(t0_us, t1_us, t_out)은 모두 바퀴 수를 붙인 64비트 us입니다 (기록된 u32 타임스탬프가 71.6분마다
+ * 한 바퀴 돌아도 계속 증가). 한 바퀴 전 로그에서는 u32 값과 같습니다.
+ */
+typedef struct {
+    int fd;
+    const uint8_t *map;                     // mmap 전체 (offset 앞부분 포함)
+    size_t map_len;
+    const uint8_t *base;                    // 로그 시작 (map + offset)
+    size_t len;
+    uint32_t channel_count;
+    collog_channel_desc_t channels[COLLOG_MAX_CHANNELS];
+    uint32_t data_offset;                   // 첫 청크
+    uint32_t data_end;                      // 마지막 청크 끝 (색인 시작 또는 파일 끝)
+    const collog_index_entry_t *index;      // 트레일러가 없으면 NULL
+    uint32_t index_count;
+} collog_reader_t;
+
+/**
+ * @brief 로그 파일을 엽니다.
+ *
+ * @param length 유효한 바이트 수 (0이면 파일 크기). sdlog 파일처럼 뒤가 패딩된 경우 사용.
+ * @param offset 파일 안에서 로그가 시작하는 위치 (sdlog 헤더 블록 등을 건너뛸 때, 4의 배수).
+ * @return 성공 시 true, 파일이 없거나 형식이 다르면 false.
+ */
+bool collog_reader_open(collog_reader_t *r, const char *path, size_t offset, size_t length);
+
+void collog_reader_close(collog_reader_t *r);
+
+/**
+ * @brief 채널 이름으로 채널 번호를 찾습니다.
+ *
+ * @return 채널 번호, 없으면 -1.
+ */
+int collog_reader_find(const collog_reader_t *r, const char *name);
+
+/**
+ * @brief [t0_us, t1_us] 구간의 채널 값을 double로 꺼냅니다.
+ *
+ * @param channel 채널 번호.
+ * @param t_out 각 값의 타임스탬프 (64비트, NULL이면 생략).
+ * @param v_out 값.
+ * @param cap t_out / v_out 용량.
+ * @return 꺼낸 값의 개수 (cap에서 잘림).
+ */
+size_t collog_reader_extract(const collog_reader_t *r, int channel, uint64_t t0_us, uint64_t t1_us,
+                             uint64_t *t_out, double *v_out, size_t cap);
+
+/**
+ * @brief [t0_us, t1_us] 구간의 채널 값을 기록된 타입(collog_type_t) 그대로 꺼냅니다.
+ *
+ * 지상 처리 커널(logk.h)에 고정소수점 원시값을 그대로 넘길 때 사용합니다.
+ *
+ * @param v_out 값 (cap x 채널 크기 바이트).
+ * @return 꺼낸 값의 개수 (cap에서 잘림).
+ */
+size_t collog_reader_extract_raw(const collog_reader_t *r, int channel, uint64_t t0_us, uint64_t t1_us,
+                                 uint64_t *t_out, void *v_out, size_t cap);
+
+#endif // COLLOG_READER_H_
@@ -0,0 +1,46 @@
+// coro_hw.h 호스트 구현: 인터럽트 대신 시뮬레이션 코드가 coro_hw_host_fire_*()를 호출
+
+#include "coro_hw.h"
+#include <stddef.h>
+
+static coro_event_t *dma_events[CORO_HW_NUM_DMA_CHANNELS];
+static coro_event_t *gpio_events[CORO_HW_NUM_GPIOS];
+static coro_hw_notify_fn_t notify_fn = NULL;
+
+bool coro_hw_bind_dma(uint32_t channel, coro_event_t *ev) {
+    if (channel >= CORO_HW_NUM_DMA_CHANNELS || !ev || dma_events[channel]) return false;
+    dma_events[channel] = ev;
+    return true;
+}
+
+bool coro_hw_bind_gpio(uint32_t gpio, uint32_t edge_mask, coro_event_t *ev) {
+    if (gpio >= CORO_HW_NUM_GPIOS || !ev || edge_mask == 0 || gpio_events[gpio]) return false;
+    gpio_events[gpio] = ev;
+    return true;
+}
+
+void coro_hw_unbind_dma(uint32_t channel) {
+    if (channel < CORO_HW_NUM_DMA_CHANNELS) dma_events[channel] = NULL;
+}
+
+void coro_hw_unbind_gpio(uint32_t gpio) {
+    if (gpio < CORO_HW_NUM_GPIOS) gpio_events[gpio] = NULL;
+}
+
+void coro_hw_set_notify(coro_hw_notify_fn_t fn) {
+    notify_fn = fn;
+}
+
+void coro_hw_host_fire_dma(uint32_t channel) {
+    if (channel < CORO_HW_NUM_DMA_CHANNELS && dma_events[channel]) {
+        coro_event_signal(dma_events[channel]);
+        if (notify_fn) notify_fn();
+    }
+}
+
+void coro_hw_host_fire_gpio(uint32_t gpio) {
+    if (gpio < CORO_HW_NUM_GPIOS && gpio_events[gpio]) {
+        coro_event_signal(gpio_events[gpio]);
+        if (notify_fn) notify_fn();
+    }
+}
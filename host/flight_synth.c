@@ -0,0 +1,65 @@
+#include "flight_synth.h"
+#include <math.h>
+#include <stdbool.h>
+#include "units.h"
+
+// xorshift32, 균등 분포 두 개의 평균 (삼각 분포)
+static int32_t noise(flight_synth_t *s, int32_t amplitude) {
+    int32_t sum = 0;
+    for (int k = 0; k < 2; ++k) {
+        s->rng ^= s->rng << 13;
+        s->rng ^= s->rng >> 17;
+        s->rng ^= s->rng << 5;
+        sum += (int32_t)(s->rng % (uint32_t)(2 * amplitude + 1)) - amplitude;
+    }
+    return sum / 2;
+}
+
+void flight_synth_init(flight_synth_t *s, uint32_t total_records, uint32_t seed) {
+    s->i = 0;
+    s->total = total_records;
+    s->rng = seed ? seed : 0x12345678u;
+    s->alt_m = 0.0;
+    s->vel_mps = 0.0;
+}
+
+void flight_synth_next(flight_synth_t *s, flight_record_t *r) {
+    const uint32_t pad_end = s->total / 10, ascent_end = pad_end + 3000;
+    uint32_t i = s->i++;
+    double t = i * 1e-3;
+
+    // 가속도계 값(acc_g)과 실제 운동이 일치하도록 속도는 항상 (acc_g - 1) g 로 적분
+    double acc_g;
+    if (i < pad_end || (i >= ascent_end && s->alt_m <= 0.0)) {
+        acc_g = 1.0; // 발사대 대기 / 착지 후
+    } else if (i < ascent_end) {
+        acc_g = i < pad_end + 1500 ? 8.5 : 0.5; // 모터 연소 후 관성 상승
+    } else {
+        // 낙하산: 종단 속도 6 m/s로 수렴 (시상수 0.5 s) + 하강 중 흔들림
+        acc_g = 1.0 + 2.0 * (-6.0 - s->vel_mps) / UNITS_STANDARD_GRAVITY + 0.2 * sin(t * 2.0);
+        if (acc_g < -15.0) acc_g = -15.0; // 개방 충격 제한 (센서 범위 ±16 g 안)
+    }
+    s->vel_mps += (acc_g - 1.0) * UNITS_STANDARD_GRAVITY * 1e-3;
+    s->alt_m += s->vel_mps * 1e-3;
+    if (s->alt_m < 0) {
+        s->alt_m = 0;
+        s->vel_mps = 0;
+    }
+
+    bool descent = i >= ascent_end;
+    r->timestamp_us = (i + 1) * 1000u + (uint32_t)noise(s, 3); // 지터 ±3 us, 항상 증가
+    // 표준 대기 기압 (units.h UNITS_BARO_* 의 역함수)
+    double pressure = UNITS_SEA_LEVEL_PA * pow(1.0 - s->alt_m / UNITS_BARO_SCALE_M, 1.0 / UNITS_BARO_EXPONENT);
+    r->pressure_pa = (int32_t)lround(pressure) + noise(s, 4);
+    r->accel[0] = (int16_t)noise(s, 12);
+    r->accel[1] = (int16_t)noise(s, 12);
+    r->accel[2] = (int16_t)(acc_g * 2048.0 + noise(s, 12));
+    for (int a = 0; a < 3; ++a) {
+        r->gyro[a] = (int16_t)((descent ? 300.0 * sin(t * (0.7 + a)) : 0.0) + noise(s, 6));
+        r->mag[a] = (int16_t)(400.0 * cos(t * 0.05 + a) + noise(s, 3));
+    }
+    uint16_t level = (uint16_t)(4500 + (descent ? 1500.0 * sin(t * 0.3) : 0.0));
+    r->servo_level[0] = level;
+    r->servo_level[1] = (uint16_t)(9000 - level);
+    r->seq = (uint16_t)i;
+}
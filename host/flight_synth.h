@@ -0,0 +1,25 @@
+#ifndef FLIGHT_SYNTH_H_
+#define FLIGHT_SYNTH_H_
+
+#include <stdint.h>
+#include "flight_record.h"
+
+/*
+ * 호스트 벤치마크/도구용 합성 비행 데이터 (1 kHz).
+ * 발사대 대기(전체의 10%) -> 3 s 상승 -> 낙하산 하강(흔들림 + 서보 조향) 순서이며,
+ * 센서마다 작은 잡음이 섞여 있습니다. 같은 seed면 같은 데이터가 나옵니다.
+ */
+typedef struct {
+    uint32_t i;
+    uint32_t total;
+    uint32_t rng;
+    double alt_m;
+    double vel_mps;
+} flight_synth_t;
+
+void flight_synth_init(flight_synth_t *s, uint32_t total_records, uint32_t seed);
+
+// 다음 레코드 (total_records 이후에도 하강 구간이 계속됨)
+void flight_synth_next(flight_synth_t *s, flight_record_t *r);
+
+#endif // FLIGHT_SYNTH_H_
@@ -0,0 +1,382 @@
+#include "ground_station.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+extern "C" {
+#include "link_frame.h"
+}
+#include "messages.hpp"
+
+namespace cansat::ground {
+
+namespace {
+
+constexpr std::size_t kSlotBytes = 256;     // 정렬 버퍼 슬롯 (프레임 최대 LINK_FRAME_MAX_PAYLOAD)
+constexpr std::size_t kMessageKinds = cansat::msg::kIndexToId.size();
+
+static_assert(LINK_FRAME_MAX_PAYLOAD <= kSlotBytes, "frame must fit in a reorder slot");
+static_assert(LINK_FRAME_MAX_PAYLOAD <= 255, "archive stores frame length as u8");
+
+template <typename T, typename = void>
+struct HasTimestamp : std::false_type {};
+template <typename T>
+struct HasTimestamp<T, std::void_t<decltype(T::timestamp_ms)>> : std::true_type {};
+
+std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+std::uint64_t now_ms() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+void put_u16(char *p, std::uint16_t v) {
+    p[0] = static_cast<char>(v);
+    p[1] = static_cast<char>(v >> 8);
+}
+
+void put_u32(char *p, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<char>(v >> (8 * i));
+}
+
+// 정렬 버퍼 힙 순서: (timestamp, id, seq) 가 작은 것이 먼저
+struct PendingLater {
+    template <typename P>
+    bool operator()(const P &a, const P &b) const {
+        if (a.timestamp_ms != b.timestamp_ms) return a.timestamp_ms > b.timestamp_ms;
+        if (a.id != b.id) return a.id > b.id;
+        return a.seq > b.seq;
+    }
+};
+
+}  // namespace
+
+// --- FileArchive ---
+
+FileArchive::FileArchive(const std::string &path) : buffer_(1 << 20) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return;
+    std::setvbuf(file_, buffer_.data(), _IOFBF, buffer_.size());
+    char header[kArchiveHeaderBytes] = {};
+    put_u32(header, kArchiveMagic);
+    put_u16(header + 4, kArchiveVersion);
+    std::fwrite(header, 1, sizeof(header), file_);
+}
+
+FileArchive::~FileArchive() { close(); }
+
+void FileArchive::write(const ArchiveRecord &r) {
+    if (!file_) return;
+    char head[6];
+    put_u32(head, r.timestamp_ms);
+    head[4] = static_cast<char>(r.receiver);
+    head[5] = static_cast<char>(r.frame_len);
+    std::fwrite(head, 1, sizeof(head), file_);
+    std::fwrite(r.frame, 1, r.frame_len, file_);
+    count_++;
+}
+
+void FileArchive::close() {
+    if (!file_) return;
+    char count[4];
+    put_u32(count, count_);
+    std::fseek(file_, 8, SEEK_SET);
+    std::fwrite(count, 1, sizeof(count), file_);
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+// --- Queue ---
+
+template <typename T>
+void GroundStation::Queue<T>::push(T &&item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [&] { return items_.size() < cap_ || closed_; });
+    items_.push_back(std::move(item));
+    not_empty_.notify_one();
+}
+
+template <typename T>
+bool GroundStation::Queue<T>::pop(T &item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [&] { return !items_.empty() || closed_; });
+    if (items_.empty()) return false;
+    item = std::move(items_.front());
+    items_.pop_front();
+    not_full_.notify_one();
+    return true;
+}
+
+template <typename T>
+void GroundStation::Queue<T>::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+    not_full_.notify_all();
+}
+
+// --- GroundStation ---
+
+GroundStation::GroundStation(const Config &config, RecordSink sink)
+    : config_(config), sink_(std::move(sink)), raw_(config.queue_batches), decoded_(config.queue_batches),
+      dedup_(kMessageKinds + 1) {
+    if (config_.workers == 0) config_.workers = 1;
+    if (config_.batch_frames == 0) config_.batch_frames = 1;
+    for (std::vector<std::int64_t> &t : dedup_) t.assign(1u << 16, -1);
+    active_workers_ = config_.workers;
+    for (unsigned i = 0; i < config_.workers; ++i) workers_.emplace_back(&GroundStation::worker_loop, this);
+    merger_ = std::thread(&GroundStation::merge_loop, this);
+}
+
+GroundStation::~GroundStation() { finish(); }
+
+void GroundStation::ingest(unsigned receiver, const std::uint8_t *data, std::size_t len) {
+    if (receiver >= kMaxReceivers) return;
+    Splitter &s = splitters_[receiver];
+    std::uint64_t overruns = 0;
+
+    while (len > 0) {
+        const auto *delim = static_cast<const std::uint8_t *>(std::memchr(data, LINK_FRAME_DELIMITER, len));
+        std::size_t chunk = delim ? static_cast<std::size_t>(delim - data) : len;
+
+        if (!s.skipping) {
+            if (s.batch.bytes.empty() && s.batch.ends.empty()) s.batch_started_ms = now_ms();
+            std::size_t start = s.batch.ends.empty() ? 0 : s.batch.ends.back();
+            if (s.batch.bytes.size() - start + chunk > LINK_FRAME_MAX_BYTES) {
+                // 구분자가 너무 오래 없음: 지금 프레임을 버리고 다음 구분자부터 다시 시작
+                s.batch.bytes.resize(start);
+                s.skipping = true;
+                overruns++;
+            } else {
+                s.batch.bytes.insert(s.batch.bytes.end(), data, data + chunk);
+            }
+        }
+
+        if (delim) {
+            std::size_t start = s.batch.ends.empty() ? 0 : s.batch.ends.back();
+            if (!s.skipping && s.batch.bytes.size() > start) {
+                s.batch.ends.push_back(static_cast<std::uint32_t>(s.batch.bytes.size()));
+                ingested_frames_[receiver].fetch_add(1, std::memory_order_release);
+                if (s.batch.ends.size() >= config_.batch_frames) push_batch(receiver);
+            }
+            s.skipping = false;
+            chunk++;
+        }
+        data += chunk;
+        len -= chunk;
+    }
+
+    if (!s.batch.ends.empty() && now_ms() - s.batch_started_ms >= config_.max_batch_delay_ms) push_batch(receiver);
+
+    if (overruns) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.overruns += overruns;
+    }
+}
+
+void GroundStation::push_batch(unsigned receiver) {
+    Splitter &s = splitters_[receiver];
+    RawBatch batch;
+    batch.receiver = receiver;
+    batch.batch_no = s.next_batch_no++;
+
+    // 마지막 구분자 뒤의 미완성 프레임은 다음 배치로 넘김
+    std::size_t complete = s.batch.ends.back();
+    batch.bytes.assign(s.batch.bytes.begin(), s.batch.bytes.begin() + static_cast<std::ptrdiff_t>(complete));
+    batch.ends.swap(s.batch.ends);
+    s.batch.bytes.erase(s.batch.bytes.begin(), s.batch.bytes.begin() + static_cast<std::ptrdiff_t>(complete));
+    s.batch.ends.clear();
+    s.batch_started_ms = now_ms();
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.bytes_in += batch.bytes.size() + batch.ends.size();
+        stats_.frames_in += batch.ends.size();
+        stats_.per_receiver_frames[receiver] += batch.ends.size();
+    }
+    raw_.push(std::move(batch));
+}
+
+void GroundStation::worker_loop() {
+    RawBatch raw;
+    while (raw_.pop(raw)) {
+        std::uint64_t t0 = now_ns();
+        DecodedBatch out;
+        out.receiver = raw.receiver;
+        out.batch_no = raw.batch_no;
+        out.records.reserve(raw.ends.size());
+        out.frames.resize(raw.bytes.size());
+
+        std::uint32_t start = 0, out_pos = 0;
+        for (std::uint32_t end : raw.ends) {
+            std::uint8_t *dst = out.frames.data() + out_pos;
+            std::uint32_t n = link_frame_decode(raw.bytes.data() + start, end - start, dst, end - start);
+            start = end;
+            if (n == 0) {
+                out.bad++;
+                continue;
+            }
+
+            DecodedRecord rec{};
+            bool known = cansat::msg::dispatch(dst, n, [&](const cansat::msg::FrameHeader &h, const auto &m) {
+                rec.id = h.id;
+                rec.seq = h.seq;
+                if constexpr (HasTimestamp<std::decay_t<decltype(m)>>::value) {
+                    rec.timestamp_ms = m.timestamp_ms;
+                    rec.timed = true;
+                }
+            });
+            if (!known) {
+                out.unknown++;
+                continue;
+            }
+            rec.offset = out_pos;
+            rec.len = static_cast<std::uint8_t>(n);
+            out.records.push_back(rec);
+            out_pos += n;
+        }
+        out.frames.resize(out_pos);
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.decode_ns += now_ns() - t0;
+        }
+        decoded_.push(std::move(out));
+    }
+    if (--active_workers_ == 0) decoded_.close();
+}
+
+bool GroundStation::is_duplicate(std::uint16_t id, std::uint16_t seq, std::uint32_t ts, bool timed) {
+    int index = cansat::msg::message_index(id);
+    std::int64_t &slot = dedup_[index < 0 ? kMessageKinds : static_cast<std::size_t>(index)][seq];
+
+    // seq가 한 바퀴 돈 뒤의 다른 메시지와 구분하려고 timestamp도 비교. timestamp가 없는 메시지는
+    // 수신기마다 붙인 시각이 달라 가까우면 같은 메시지로 봄
+    if (slot >= 0) {
+        std::int64_t diff = slot - static_cast<std::int64_t>(ts);
+        if (timed ? diff == 0 : (diff < 0 ? -diff : diff) <= config_.receiver_stale_ms) return true;
+    }
+    slot = ts;
+    return false;
+}
+
+void GroundStation::emit_until(std::int64_t watermark) {
+    while (!heap_.empty() && static_cast<std::int64_t>(heap_.front().timestamp_ms) <= watermark) {
+        std::pop_heap(heap_.begin(), heap_.end(), PendingLater{});
+        const Pending p = heap_.back();
+        heap_.pop_back();
+        free_slots_.push_back(p.slot);
+        ArchiveRecord r{p.timestamp_ms, p.id, p.seq, p.receiver, p.len, slots_.data() + p.slot * kSlotBytes};
+        sink_(r);
+        last_emitted_ts_ = p.timestamp_ms;
+    }
+}
+
+void GroundStation::merge_batch(const DecodedBatch &batch) {
+    std::uint64_t t0 = now_ns();
+    unsigned receiver = batch.receiver;
+    merged_frames_[receiver] += batch.records.size() + batch.bad + batch.unknown;
+    merge_stats_.bad_frames += batch.bad;
+    merge_stats_.unknown_ids += batch.unknown;
+
+    for (const DecodedRecord &rec : batch.records) {
+        std::uint32_t ts = rec.timed ? rec.timestamp_ms : receiver_last_ts_[receiver];
+        if (rec.timed) {
+            receiver_last_ts_[receiver] = ts;
+            receiver_seen_[receiver] = true;
+        }
+
+        if (is_duplicate(rec.id, rec.seq, ts, rec.timed)) {
+            merge_stats_.duplicates++;
+            continue;
+        }
+
+        const std::uint8_t *frame = batch.frames.data() + rec.offset;
+        if (static_cast<std::int64_t>(ts) < last_emitted_ts_) {
+            // 정렬 창보다 늦게 도착: 버리지 않고 바로 씀
+            merge_stats_.late++;
+            merge_stats_.written++;
+            ArchiveRecord r{ts, rec.id, rec.seq, static_cast<std::uint8_t>(receiver), rec.len, frame};
+            sink_(r);
+            continue;
+        }
+
+        if (free_slots_.empty()) {
+            std::uint32_t first = static_cast<std::uint32_t>(slots_.size() / kSlotBytes);
+            slots_.resize(slots_.size() + 1024 * kSlotBytes);
+            for (std::uint32_t i = 1024; i-- > 0;) free_slots_.push_back(first + i);
+        }
+        std::uint32_t slot = free_slots_.back();
+        free_slots_.pop_back();
+        std::memcpy(slots_.data() + slot * kSlotBytes, frame, rec.len);
+        heap_.push_back(Pending{ts, rec.id, rec.seq, slot, static_cast<std::uint8_t>(receiver), rec.len});
+        std::push_heap(heap_.begin(), heap_.end(), PendingLater{});
+        merge_stats_.written++;
+
+        if (static_cast<std::int64_t>(ts) > max_ts_) max_ts_ = ts;
+    }
+
+    // 병합을 기다리는 프레임이 있는 수신기와, 살아 있는 수신기 중 가장 뒤처진 곳까지는 기다림
+    // (배치 단위로 도착하고 워커가 끝내는 순서도 제각각이라 수신기마다 진행이 다름)
+    std::int64_t watermark = max_ts_;
+    for (unsigned r = 0; r < kMaxReceivers; ++r) {
+        bool in_flight = ingested_frames_[r].load(std::memory_order_acquire) > merged_frames_[r];
+        std::int64_t last = receiver_seen_[r] ? static_cast<std::int64_t>(receiver_last_ts_[r]) : -1;
+        bool live = receiver_seen_[r] && last + config_.receiver_stale_ms >= max_ts_;
+        if ((in_flight || live) && last < watermark) watermark = last;
+    }
+    emit_until(watermark - static_cast<std::int64_t>(config_.reorder_window_ms));
+    merge_stats_.merge_ns += now_ns() - t0;
+    flush_merge_stats();
+}
+
+void GroundStation::flush_merge_stats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.bad_frames += merge_stats_.bad_frames;
+    stats_.unknown_ids += merge_stats_.unknown_ids;
+    stats_.duplicates += merge_stats_.duplicates;
+    stats_.late += merge_stats_.late;
+    stats_.written += merge_stats_.written;
+    stats_.merge_ns += merge_stats_.merge_ns;
+    merge_stats_ = Stats{};
+}
+
+void GroundStation::merge_loop() {
+    DecodedBatch batch;
+    while (decoded_.pop(batch)) {
+        // 워커가 끝낸 순서가 아니라 수신기별 배치 순서대로 병합
+        unsigned r = batch.receiver;
+        reseq_[r].emplace(batch.batch_no, std::move(batch));
+        for (auto it = reseq_[r].begin(); it != reseq_[r].end() && it->first == next_merge_no_[r];
+             it = reseq_[r].erase(it)) {
+            merge_batch(it->second);
+            next_merge_no_[r]++;
+        }
+    }
+    emit_until(INT64_MAX);
+    flush_merge_stats();
+}
+
+void GroundStation::finish() {
+    if (finished_) return;
+    finished_ = true;
+    for (unsigned r = 0; r < kMaxReceivers; ++r) {
+        if (!splitters_[r].batch.ends.empty()) push_batch(r);
+    }
+    raw_.close();
+    for (std::thread &t : workers_) t.join();
+    merger_.join();
+}
+
+Stats GroundStation::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+}  // namespace cansat::ground
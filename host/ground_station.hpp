@@ -0,0 +1,200 @@
+// 지상국 텔레메트리 디코더/아카이버
+//
+// 여러 수신기(시리얼/UDP)에서 들어온 링크 바이트 스트림(link_frame.h)을 받아
+//   수신기별 분할(ingest 호출 스레드) -> 디코딩(워커 풀) -> 병합(단일 스레드)
+// 순서로 처리합니다. 병합 단계는 수신기별 배치 순서를 복원한 뒤 (id, seq)로 중복을
+// 제거하고, 비행 시간(timestamp_ms) 순서로 다시 정렬해 아카이브에 씁니다.
+//
+// 아카이브 형식 (리틀 엔디언):
+//   파일 헤더 16 B : "CGSA", u16 version, u16 reserved, u32 record_count, u32 reserved
+//   레코드         : u32 timestamp_ms, u8 receiver, u8 frame_len, 메시지 프레임
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cansat::ground {
+
+constexpr std::uint32_t kArchiveMagic = 0x41534743u;  // "CGSA"
+constexpr std::uint16_t kArchiveVersion = 1;
+constexpr std::size_t kArchiveHeaderBytes = 16;
+constexpr std::size_t kMaxReceivers = 8;
+
+// 병합을 통과한 메시지 하나
+struct ArchiveRecord {
+    std::uint32_t timestamp_ms;
+    std::uint16_t id;
+    std::uint16_t seq;
+    std::uint8_t receiver;      // 먼저 도착한 수신기
+    std::uint8_t frame_len;
+    const std::uint8_t *frame;  // 콜백 동안만 유효
+};
+
+using RecordSink = std::function<void(const ArchiveRecord &)>;
+
+struct Config {
+    unsigned workers = 4;
+    std::uint32_t reorder_window_ms = 500;  // 수신기 사이 지연 차이 여유
+    std::uint32_t receiver_stale_ms = 5000; // 이만큼 뒤처진 수신기는 기다리지 않음 (이후 도착분은 late)
+    std::size_t batch_frames = 256;
+    std::uint32_t max_batch_delay_ms = 20;  // 실시간 수신 시 배치가 덜 차도 넘기는 시간
+    std::size_t queue_batches = 64;         // 단계 사이 큐 깊이 (가득 차면 ingest가 대기)
+};
+
+struct Stats {
+    std::uint64_t bytes_in;
+    std::uint64_t frames_in;
+    std::uint64_t bad_frames;      // COBS/CRC 오류
+    std::uint64_t unknown_ids;
+    std::uint64_t overruns;        // 구분자 없이 너무 긴 입력 (재동기)
+    std::uint64_t duplicates;
+    std::uint64_t late;            // 정렬 창을 넘겨 도착
+    std::uint64_t written;
+    std::uint64_t decode_ns;       // 워커 디코딩 시간 합 (병렬 구간)
+    std::uint64_t merge_ns;        // 병합 스레드 시간 합 (직렬 구간)
+    std::uint64_t per_receiver_frames[kMaxReceivers];
+};
+
+// 아카이브 파일 작성기 (RecordSink로 사용)
+class FileArchive {
+public:
+    explicit FileArchive(const std::string &path);
+    ~FileArchive();
+    FileArchive(const FileArchive &) = delete;
+    FileArchive &operator=(const FileArchive &) = delete;
+
+    bool ok() const { return file_ != nullptr; }
+    void write(const ArchiveRecord &r);
+    void close();  // 레코드 수를 헤더에 기록
+
+private:
+    std::FILE *file_ = nullptr;
+    std::vector<char> buffer_;
+    std::uint32_t count_ = 0;
+};
+
+class GroundStation {
+public:
+    GroundStation(const Config &config, RecordSink sink);
+    ~GroundStation();
+    GroundStation(const GroundStation &) = delete;
+    GroundStation &operator=(const GroundStation &) = delete;
+
+    // 수신기 바이트를 넣습니다. 수신기 하나는 한 스레드에서만 호출해야 하며,
+    // 데이터가 없을 때 len 0 으로 호출하면 오래된 배치를 넘깁니다.
+    void ingest(unsigned receiver, const std::uint8_t *data, std::size_t len);
+
+    // 남은 배치를 모두 처리하고 정렬 버퍼를 비운 뒤 스레드를 정리합니다.
+    void finish();
+
+    Stats stats() const;
+
+private:
+    struct RawBatch {
+        unsigned receiver = 0;
+        std::uint64_t batch_no = 0;
+        std::vector<std::uint8_t> bytes;   // 구분자를 뺀 링크 프레임들
+        std::vector<std::uint32_t> ends;
+    };
+
+    struct DecodedRecord {
+        std::uint32_t timestamp_ms;
+        std::uint16_t id;
+        std::uint16_t seq;
+        std::uint32_t offset;  // DecodedBatch::frames 안의 위치
+        std::uint8_t len;
+        bool timed;            // timestamp_ms 필드가 있는 메시지
+    };
+
+    struct DecodedBatch {
+        unsigned receiver = 0;
+        std::uint64_t batch_no = 0;
+        std::vector<DecodedRecord> records;
+        std::vector<std::uint8_t> frames;
+        std::uint32_t bad = 0;
+        std::uint32_t unknown = 0;
+    };
+
+    // 닫을 수 있는 유한 큐
+    template <typename T>
+    class Queue {
+    public:
+        explicit Queue(std::size_t cap) : cap_(cap) {}
+        void push(T &&item);
+        bool pop(T &item);  // 닫히고 비었으면 false
+        void close();
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable not_empty_, not_full_;
+        std::deque<T> items_;
+        std::size_t cap_;
+        bool closed_ = false;
+    };
+
+    struct Splitter {
+        RawBatch batch;
+        std::uint64_t next_batch_no = 0;
+        std::uint64_t batch_started_ms = 0;
+        bool skipping = false;  // 너무 긴 입력을 버리는 중 (다음 구분자까지)
+    };
+
+    // 병합 단계: 정렬 버퍼 항목 (프레임은 슬롯에 복사)
+    struct Pending {
+        std::uint32_t timestamp_ms;
+        std::uint16_t id;
+        std::uint16_t seq;
+        std::uint32_t slot;
+        std::uint8_t receiver;
+        std::uint8_t len;
+    };
+
+    void push_batch(unsigned receiver);
+    void worker_loop();
+    void merge_loop();
+    void merge_batch(const DecodedBatch &batch);
+    bool is_duplicate(std::uint16_t id, std::uint16_t seq, std::uint32_t ts, bool timed);
+    void flush_merge_stats();
+    void emit_until(std::int64_t watermark);
+
+    Config config_;
+    RecordSink sink_;
+    Queue<RawBatch> raw_;
+    Queue<DecodedBatch> decoded_;
+    std::vector<std::thread> workers_;
+    std::thread merger_;
+    std::atomic<unsigned> active_workers_{0};
+    bool finished_ = false;
+
+    Splitter splitters_[kMaxReceivers];
+    std::atomic<std::uint64_t> ingested_frames_[kMaxReceivers] = {};  // 분할기가 찾은 프레임
+
+    // 병합 스레드 전용 상태
+    std::map<std::uint64_t, DecodedBatch> reseq_[kMaxReceivers];  // 수신기별 batch_no 순서 복원
+    std::uint64_t next_merge_no_[kMaxReceivers] = {};
+    std::uint64_t merged_frames_[kMaxReceivers] = {};
+    std::uint32_t receiver_last_ts_[kMaxReceivers] = {};
+    bool receiver_seen_[kMaxReceivers] = {};
+    std::vector<std::vector<std::int64_t>> dedup_;  // 메시지 종류별 seq -> 마지막으로 본 timestamp
+    std::vector<Pending> heap_;
+    std::vector<std::uint8_t> slots_;
+    std::vector<std::uint32_t> free_slots_;
+    std::int64_t max_ts_ = -1;
+    std::int64_t last_emitted_ts_ = -1;
+    Stats merge_stats_{};
+
+    mutable std::mutex stats_mutex_;
+    Stats stats_{};
+};
+
+}  // namespace cansat::ground
@@ -0,0 +1,177 @@
+// 지상국 수신/아카이브 도구
+//
+// 사용법:
+//   ground_station -o flight.cgsa [-w workers] [-s /dev/ttyUSB0[:baud]]... [-u udp_port]...
+//
+// 수신기마다 읽기 스레드 하나가 GroundStation::ingest 를 호출하며, Ctrl+C 로 멈추면
+// 정렬 버퍼를 비우고 아카이브를 닫습니다.
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ground_station.hpp"
+
+namespace {
+
+using cansat::ground::Config;
+using cansat::ground::FileArchive;
+using cansat::ground::GroundStation;
+using cansat::ground::Stats;
+
+std::atomic<bool> g_stop{false};
+
+void on_signal(int) { g_stop = true; }
+
+speed_t baud_constant(unsigned baud) {
+    switch (baud) {
+    case 9600: return B9600;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return 0;
+    }
+}
+
+int open_serial(const std::string &spec) {
+    std::string path = spec;
+    unsigned baud = 115200;
+    std::size_t colon = spec.rfind(':');
+    if (colon != std::string::npos) {
+        path = spec.substr(0, colon);
+        baud = static_cast<unsigned>(std::strtoul(spec.c_str() + colon + 1, nullptr, 10));
+    }
+    speed_t speed = baud_constant(baud);
+    if (speed == 0) {
+        std::fprintf(stderr, "unsupported baud rate: %u\n", baud);
+        return -1;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        std::perror(path.c_str());
+        return -1;
+    }
+    termios tio{};
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tcsetattr(fd, TCSANOW, &tio);
+    return fd;
+}
+
+int open_udp(unsigned port) {
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<std::uint16_t>(port));
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+        std::perror("bind");
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// 시리얼과 UDP 모두 read() 로 읽음 (UDP 데이터그램 하나 = 링크 프레임 여러 개도 가능)
+void reader_loop(GroundStation &station, unsigned receiver, int fd) {
+    std::uint8_t buf[4096];
+    pollfd p{fd, POLLIN, 0};
+    while (!g_stop) {
+        int r = ::poll(&p, 1, 10);
+        ssize_t n = r > 0 ? ::read(fd, buf, sizeof(buf)) : 0;
+        station.ingest(receiver, buf, n > 0 ? static_cast<std::size_t>(n) : 0);
+    }
+}
+
+void print_stats(const Stats &s, unsigned receivers) {
+    std::fprintf(stderr, "frames %llu  written %llu  dup %llu  bad %llu  late %llu  rx:",
+                 static_cast<unsigned long long>(s.frames_in), static_cast<unsigned long long>(s.written),
+                 static_cast<unsigned long long>(s.duplicates), static_cast<unsigned long long>(s.bad_frames),
+                 static_cast<unsigned long long>(s.late));
+    for (unsigned r = 0; r < receivers; ++r) {
+        std::fprintf(stderr, " %llu", static_cast<unsigned long long>(s.per_receiver_frames[r]));
+    }
+    std::fprintf(stderr, "\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Config config;
+    std::string out_path;
+    std::vector<int> fds;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg == "-o" && value) {
+            out_path = value;
+        } else if (arg == "-w" && value) {
+            config.workers = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "-s" && value) {
+            int fd = open_serial(value);
+            if (fd < 0) return 1;
+            fds.push_back(fd);
+        } else if (arg == "-u" && value) {
+            int fd = open_udp(static_cast<unsigned>(std::strtoul(value, nullptr, 10)));
+            if (fd < 0) return 1;
+            fds.push_back(fd);
+        } else {
+            std::fprintf(stderr, "usage: %s -o out.cgsa [-w workers] [-s tty[:baud]]... [-u port]...\n", argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+    if (out_path.empty() || fds.empty() || fds.size() > cansat::ground::kMaxReceivers) {
+        std::fprintf(stderr, "need -o and 1..%zu receivers\n", cansat::ground::kMaxReceivers);
+        return 2;
+    }
+
+    FileArchive archive(out_path);
+    if (!archive.ok()) {
+        std::perror(out_path.c_str());
+        return 1;
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    GroundStation station(config, [&](const cansat::ground::ArchiveRecord &r) { archive.write(r); });
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < fds.size(); ++r) {
+        readers.emplace_back(reader_loop, std::ref(station), r, fds[r]);
+    }
+
+    unsigned ticks = 0;
+    while (!g_stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (++ticks % 50 == 0) print_stats(station.stats(), static_cast<unsigned>(fds.size()));
+    }
+
+    for (std::thread &t : readers) t.join();
+    station.finish();
+    archive.close();
+    print_stats(station.stats(), static_cast<unsigned>(fds.size()));
+    for (int fd : fds) ::close(fd);
+    return 0;
+}
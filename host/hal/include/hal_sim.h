@@ -0,0 +1,57 @@
+#ifndef HAL_SIM_H_
+#define HAL_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 호스트 HAL 에뮬레이션: 펌웨어 소스(servo.c 등)를 수정 없이 리눅스에서 빌드하기 위한
+// Pico SDK 부분 구현과, 시뮬레이터가 하드웨어 상태를 들여다보기 위한 API.
+
+// --- 설정값 (RP2040과 동일) ---
+#define HAL_SIM_NUM_GPIOS 30
+#define HAL_SIM_NUM_PWM_SLICES 8
+#define HAL_SIM_SYS_CLK_HZ 125000000u
+
+// PWM 슬라이스 하나의 레지스터 상태
+typedef struct {
+    uint16_t top;        // wrap 값
+    uint8_t div_int;
+    uint8_t div_frac;    // 1/16 단위
+    bool enabled;
+    uint16_t cc[2];      // 채널 A, B 비교 레벨
+} hal_sim_pwm_slice_t;
+
+/**
+ * @brief 모든 에뮬레이션 상태(PWM, GPIO, 가상 시간)를 리셋 상태로 되돌립니다.
+ */
+void hal_sim_reset(void);
+
+/**
+ * @brief PWM 슬라이스의 현재 레지스터 상태를 반환합니다.
+ *
+ * @return 슬라이스 번호가 범위를 벗어나면 NULL.
+ */
+const hal_sim_pwm_slice_t *hal_sim_pwm_slice(uint32_t slice_num);
+
+/**
+ * @brief GPIO에 출력되는 서보 펄스 폭을 ns 단위로 계산합니다.
+ *
+ * @return GPIO가 PWM 기능이 아니거나 슬라이스가 비활성이면 0.
+ */
+uint32_t hal_sim_pwm_pulse_ns(uint32_t gpio);
+
+/**
+ * @brief 시간 소스를 가상 시간으로 전환합니다.
+ *
+ * 가상 시간 모드에서는 time_us_64()가 hal_sim_advance_us()로만 증가하고,
+ * sleep_us()/sleep_ms()는 실제로 잠들지 않고 가상 시간을 전진시킵니다.
+ * 기본값은 CLOCK_MONOTONIC 기반 실시간입니다.
+ */
+void hal_sim_use_virtual_time(bool enable);
+
+/**
+ * @brief 가상 시간을 전진시킵니다 (실시간 모드에서는 무시).
+ */
+void hal_sim_advance_us(uint64_t delta_us);
+
+#endif // HAL_SIM_H_
@@ -0,0 +1,121 @@
+#ifndef HAL_TRACE_H_
+#define HAL_TRACE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * HAL 입력 기록/재생 (호스트 HAL 전용).
+ *
+ * 기록 모드에서는 펌웨어가 바깥 세계에서 받는 모든 값(타이머 읽기, GPIO 입력, 센서 바이트,
+ * 인터럽트 진입)을 순서대로 압축 바이너리 트레이스에 남깁니다. 재생 모드에서는 같은 HAL 호출이
+ * 실제 값 대신 트레이스의 값을 돌려주므로 펌웨어가 기록 당시와 똑같이 다시 실행됩니다.
+ * PWM 레벨 변경은 출력이지만 검증용으로 함께 기록하고, 재생 중 값이나 순서가 다르면 그 지점에서
+ * 어긋남(divergence)으로 멈춥니다.
+ *
+ * 트레이스: "HTR1" + 이벤트열 + END. 이벤트 = 종류 1 바이트 + 내용
+ *   TIME   : 읽은 간격이 직전 간격과 다른 만큼 (zigzag LEB128, 일정한 주기면 1 바이트)
+ *   GPIO   : (gpio << 1) | 값
+ *   INPUT  : 소스, 길이(LEB128), 16비트 단어마다 같은 소스 직전 값과의 차이 (zigzag LEB128)
+ *   IRQ    : 인터럽트 번호
+ *   PWM    : (slice << 1) | 채널, 레벨 (LEB128). 레벨이 바뀔 때만
+ *
+ * hal_sim과 마찬가지로 한 스레드에서만 사용합니다.
+ */
+
+#define HAL_TRACE_MAX_SOURCES 8
+#define HAL_TRACE_MAX_INPUT 64        // 입력 이벤트 하나의 최대 바이트 수
+
+typedef enum {
+    HAL_TRACE_OFF,
+    HAL_TRACE_RECORD,
+    HAL_TRACE_REPLAY,
+} hal_trace_mode_t;
+
+typedef enum {
+    HAL_TRACE_EV_END,
+    HAL_TRACE_EV_TIME,
+    HAL_TRACE_EV_GPIO,
+    HAL_TRACE_EV_INPUT,
+    HAL_TRACE_EV_IRQ,
+    HAL_TRACE_EV_PWM,
+    HAL_TRACE_EV_COUNT,
+} hal_trace_event_t;
+
+typedef struct {
+    uint32_t events[HAL_TRACE_EV_COUNT];  // 종류별 이벤트 수
+    uint64_t bytes[HAL_TRACE_EV_COUNT];   // 종류별 바이트 수 (종류 바이트 포함)
+} hal_trace_stats_t;
+
+/**
+ * @brief 기록을 시작합니다 (내부 버퍼, 필요하면 늘어남).
+ *
+ * @return 이미 기록/재생 중이거나 메모리 할당 실패 시 false.
+ */
+bool hal_trace_record_start(size_t initial_capacity);
+
+/**
+ * @brief 기록을 끝내고 트레이스를 넘겨줍니다 (호출자가 free).
+ *
+ * @param len 트레이스 바이트 수.
+ * @return 기록 중이 아니었거나 기록 중 메모리가 부족했으면 NULL.
+ */
+uint8_t *hal_trace_record_stop(size_t *len);
+
+/**
+ * @brief 트레이스 재생을 시작합니다. 데이터는 hal_trace_replay_stop()까지 유효해야 합니다.
+ *
+ * @return 헤더가 맞지 않으면 false.
+ */
+bool hal_trace_replay_start(const uint8_t *data, size_t len);
+
+/**
+ * @brief 재생을 끝냅니다.
+ *
+ * @return 어긋남 없이 END까지 모두 소비했으면 true.
+ */
+bool hal_trace_replay_stop(void);
+
+hal_trace_mode_t hal_trace_mode(void);
+
+/**
+ * @brief 마지막 오류(어긋남, 메모리 부족) 설명. 오류가 없으면 NULL.
+ */
+const char *hal_trace_error(void);
+
+/**
+ * @brief 지금까지 기록/재생한 이벤트 통계.
+ */
+void hal_trace_get_stats(hal_trace_stats_t *stats);
+
+/**
+ * @brief 외부 입력 바이트 (센서 읽기 등).
+ *
+ * 기록: data를 트레이스에 남김. 재생: data를 트레이스 값으로 덮어씀. 꺼져 있으면 아무것도 안 함.
+ *
+ * @param source 입력 소스 번호 (0 ~ HAL_TRACE_MAX_SOURCES-1). 소스마다 직전 값과의 차분으로 기록.
+ * @param len 최대 HAL_TRACE_MAX_INPUT.
+ * @return 재생 중 어긋났으면 false.
+ */
+bool hal_trace_input(uint8_t source, void *data, uint16_t len);
+
+/**
+ * @brief 인터럽트 진입을 기록합니다 (기록 모드에서만 동작).
+ */
+void hal_trace_irq(uint8_t irq);
+
+/**
+ * @brief 재생 모드에서 다음 인터럽트를 꺼냅니다. 재생 루프는 이것으로 핸들러를 호출합니다.
+ *
+ * @return 트레이스 끝이거나 다음 이벤트가 인터럽트가 아니면(어긋남) false.
+ */
+bool hal_trace_next_irq(uint8_t *irq);
+
+// --- HAL 내부 훅 (hal_sim.c) ---
+
+uint64_t hal_trace_time(uint64_t live_us);
+bool hal_trace_gpio(uint32_t gpio, bool live);
+void hal_trace_pwm(uint32_t slice_num, uint32_t chan, uint16_t level);
+
+#endif // HAL_TRACE_H_
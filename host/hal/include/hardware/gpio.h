@@ -0,0 +1,35 @@
+#ifndef _HARDWARE_GPIO_H
+#define _HARDWARE_GPIO_H
+
+// 호스트 HAL: hardware/gpio.h 부분 구현
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum gpio_function {
+    GPIO_FUNC_XIP = 0,
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_GPCK = 8,
+    GPIO_FUNC_USB = 9,
+    GPIO_FUNC_NULL = 0x1f,
+};
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+void gpio_init(uint32_t gpio);
+void gpio_set_function(uint32_t gpio, enum gpio_function fn);
+enum gpio_function gpio_get_function(uint32_t gpio);
+void gpio_set_dir(uint32_t gpio, bool out);
+void gpio_put(uint32_t gpio, bool value);
+bool gpio_get(uint32_t gpio);
+void gpio_pull_up(uint32_t gpio);
+void gpio_pull_down(uint32_t gpio);
+
+#endif
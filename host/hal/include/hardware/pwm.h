@@ -0,0 +1,51 @@
+#ifndef _HARDWARE_PWM_H
+#define _HARDWARE_PWM_H
+
+// 호스트 HAL: hardware/pwm.h 부분 구현. 레지스터 상태는 hal_sim_pwm_slice()로 조회
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum pwm_chan {
+    PWM_CHAN_A = 0,
+    PWM_CHAN_B = 1
+};
+
+typedef struct {
+    uint32_t csr;
+    uint32_t div;   // 8.4 고정소수점 (int << 4 | frac)
+    uint32_t top;
+} pwm_config;
+
+static inline uint32_t pwm_gpio_to_slice_num(uint32_t gpio) {
+    return (gpio >> 1u) & 7u;
+}
+
+static inline uint32_t pwm_gpio_to_channel(uint32_t gpio) {
+    return gpio & 1u;
+}
+
+static inline pwm_config pwm_get_default_config(void) {
+    pwm_config c = { 0, 1u << 4, 0xffffu };
+    return c;
+}
+
+static inline void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) {
+    c->top = wrap;
+}
+
+static inline void pwm_config_set_clkdiv_int_frac(pwm_config *c, uint8_t integer, uint8_t fract) {
+    c->div = ((uint32_t)integer << 4) | (fract & 0xfu);
+}
+
+static inline void pwm_config_set_clkdiv_int(pwm_config *c, uint32_t div) {
+    c->div = div << 4;
+}
+
+void pwm_init(uint32_t slice_num, pwm_config *c, bool start);
+void pwm_set_wrap(uint32_t slice_num, uint16_t wrap);
+void pwm_set_chan_level(uint32_t slice_num, uint32_t chan, uint16_t level);
+void pwm_set_gpio_level(uint32_t gpio, uint16_t level);
+void pwm_set_enabled(uint32_t slice_num, bool enabled);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+// 호스트 HAL: pico/stdlib.h 부분 구현
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+
+static inline void tight_loop_contents(void) {}
+
+bool stdio_init_all(void);
+
+#endif
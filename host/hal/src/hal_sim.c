@@ -0,0 +1,166 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hal_sim.h"
+#include "hal_trace.h"
+#include "pico/stdlib.h"
+#include "hardware/pwm.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+#include <string.h> // memset 사용
+#include <time.h>
+
+// --- 내부 상태 ---
+typedef struct {
+    enum gpio_function function;
+    bool out;
+    bool value;
+} gpio_sim_t;
+
+static hal_sim_pwm_slice_t pwm_slices[HAL_SIM_NUM_PWM_SLICES];
+static gpio_sim_t gpios[HAL_SIM_NUM_GPIOS];
+static bool virtual_time = false;
+static uint64_t virtual_now_us = 0;
+
+// --- 에뮬레이션 제어 ---
+
+void hal_sim_reset(void) {
+    memset(pwm_slices, 0, sizeof(pwm_slices));
+    for (int i = 0; i < HAL_SIM_NUM_PWM_SLICES; ++i) {
+        pwm_slices[i].top = 0xffff;
+        pwm_slices[i].div_int = 1;
+    }
+    for (int i = 0; i < HAL_SIM_NUM_GPIOS; ++i) {
+        gpios[i].function = GPIO_FUNC_NULL;
+        gpios[i].out = false;
+        gpios[i].value = false;
+    }
+    virtual_now_us = 0;
+}
+
+const hal_sim_pwm_slice_t *hal_sim_pwm_slice(uint32_t slice_num) {
+    return slice_num < HAL_SIM_NUM_PWM_SLICES ? &pwm_slices[slice_num] : NULL;
+}
+
+uint32_t hal_sim_pwm_pulse_ns(uint32_t gpio) {
+    if (gpio >= HAL_SIM_NUM_GPIOS || gpios[gpio].function != GPIO_FUNC_PWM) return 0;
+
+    const hal_sim_pwm_slice_t *s = &pwm_slices[pwm_gpio_to_slice_num(gpio)];
+    if (!s->enabled) return 0;
+
+    uint32_t level = s->cc[pwm_gpio_to_channel(gpio)];
+    if (level > (uint32_t)s->top + 1u) level = (uint32_t)s->top + 1u;
+
+    // 카운터 한 틱 = div / clk_sys. div는 1/16 단위
+    uint64_t div16 = ((uint64_t)s->div_int << 4) | s->div_frac;
+    return (uint32_t)(((uint64_t)level * div16 * 1000000000ull) / ((uint64_t)HAL_SIM_SYS_CLK_HZ * 16u));
+}
+
+void hal_sim_use_virtual_time(bool enable) {
+    virtual_time = enable;
+}
+
+void hal_sim_advance_us(uint64_t delta_us) {
+    if (virtual_time) virtual_now_us += delta_us;
+}
+
+// --- pico/stdlib, pico/time ---
+
+bool stdio_init_all(void) {
+    return true; // 호스트에서는 libc stdout 사용
+}
+
+uint64_t time_us_64(void) {
+    if (virtual_time) return hal_trace_time(virtual_now_us);
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return hal_trace_time((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
+void sleep_us(uint64_t us) {
+    if (virtual_time) {
+        virtual_now_us += us;
+        return;
+    }
+    struct timespec ts = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000 };
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+// --- hardware/gpio ---
+
+void gpio_init(uint32_t gpio) {
+    if (gpio >= HAL_SIM_NUM_GPIOS) return;
+    gpios[gpio].function = GPIO_FUNC_SIO;
+    gpios[gpio].out = false;
+    gpios[gpio].value = false;
+}
+
+void gpio_set_function(uint32_t gpio, enum gpio_function fn) {
+    if (gpio < HAL_SIM_NUM_GPIOS) gpios[gpio].function = fn;
+}
+
+enum gpio_function gpio_get_function(uint32_t gpio) {
+    return gpio < HAL_SIM_NUM_GPIOS ? gpios[gpio].function : GPIO_FUNC_NULL;
+}
+
+void gpio_set_dir(uint32_t gpio, bool out) {
+    if (gpio < HAL_SIM_NUM_GPIOS) gpios[gpio].out = out;
+}
+
+void gpio_put(uint32_t gpio, bool value) {
+    if (gpio < HAL_SIM_NUM_GPIOS) gpios[gpio].value = value;
+}
+
+bool gpio_get(uint32_t gpio) {
+    return hal_trace_gpio(gpio, gpio < HAL_SIM_NUM_GPIOS ? gpios[gpio].value : false);
+}
+
+void gpio_pull_up(uint32_t gpio) {
+    (void)gpio;
+}
+
+void gpio_pull_down(uint32_t gpio) {
+    (void)gpio;
+}
+
+// --- hardware/clocks ---
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index == clk_sys ? HAL_SIM_SYS_CLK_HZ : 0;
+}
+
+// --- hardware/pwm ---
+
+void pwm_init(uint32_t slice_num, pwm_config *c, bool start) {
+    if (slice_num >= HAL_SIM_NUM_PWM_SLICES) return;
+    hal_sim_pwm_slice_t *s = &pwm_slices[slice_num];
+    s->top = (uint16_t)c->top;
+    s->div_int = (uint8_t)(c->div >> 4);
+    s->div_frac = (uint8_t)(c->div & 0xfu);
+    s->cc[0] = 0;
+    s->cc[1] = 0;
+    s->enabled = start;
+}
+
+void pwm_set_wrap(uint32_t slice_num, uint16_t wrap) {
+    if (slice_num < HAL_SIM_NUM_PWM_SLICES) pwm_slices[slice_num].top = wrap;
+}
+
+void pwm_set_chan_level(uint32_t slice_num, uint32_t chan, uint16_t level) {
+    if (slice_num >= HAL_SIM_NUM_PWM_SLICES || chan >= 2) return;
+    if (pwm_slices[slice_num].cc[chan] != level) hal_trace_pwm(slice_num, chan, level); // 바뀔 때만 기록/검증
+    pwm_slices[slice_num].cc[chan] = level;
+}
+
+void pwm_set_gpio_level(uint32_t gpio, uint16_t level) {
+    if (gpio >= HAL_SIM_NUM_GPIOS) return;
+    pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), level);
+}
+
+void pwm_set_enabled(uint32_t slice_num, bool enabled) {
+    if (slice_num < HAL_SIM_NUM_PWM_SLICES) pwm_slices[slice_num].enabled = enabled;
+}
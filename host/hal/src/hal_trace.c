@@ -0,0 +1,311 @@
+#include "hal_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t MAGIC[4] = {'H', 'T', 'R', '1'};
+static const char *const EVENT_NAMES[HAL_TRACE_EV_COUNT] = {"END", "TIME", "GPIO", "INPUT", "IRQ", "PWM"};
+
+// --- 내부 상태 ---
+static hal_trace_mode_t mode = HAL_TRACE_OFF;
+static uint8_t *buf;                  // 기록: 소유, 재생: 호출자 데이터
+static size_t cap, pos, len;
+static uint64_t last_time;
+static int64_t last_delta;            // 직전 TIME 간격 (간격의 차이를 기록)
+static uint8_t prev_input[HAL_TRACE_MAX_SOURCES][HAL_TRACE_MAX_INPUT];
+static hal_trace_stats_t stats;
+static bool failed;
+static char error_msg[160];
+
+static void reset_state(void) {
+    pos = 0;
+    last_time = 0;
+    last_delta = 0;
+    memset(prev_input, 0, sizeof(prev_input));
+    memset(&stats, 0, sizeof(stats));
+    failed = false;
+    error_msg[0] = '\0';
+}
+
+static void fail(const char *fmt, const char *a, const char *b) {
+    if (failed) return;
+    failed = true;
+    snprintf(error_msg, sizeof(error_msg), fmt, a, b);
+    size_t n = strlen(error_msg);
+    uint32_t events = 0;
+    for (int i = 0; i < HAL_TRACE_EV_COUNT; ++i) events += stats.events[i];
+    snprintf(error_msg + n, sizeof(error_msg) - n, " (event %u, byte %zu)", events, pos);
+}
+
+// --- 인코딩 ---
+
+static uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1u);
+}
+
+// 리틀 엔디언 16비트 단어 (홀수 길이의 마지막 바이트는 상위 바이트 0)
+static uint16_t get_word(const uint8_t *p, uint16_t i, uint16_t n) {
+    return (uint16_t)(p[i] | (i + 1 < n ? p[i + 1] << 8 : 0));
+}
+
+// --- 기록 ---
+
+static bool reserve(size_t n) {
+    if (failed) return false;
+    if (pos + n <= cap) return true;
+    size_t new_cap = cap * 2 > pos + n ? cap * 2 : pos + n;
+    uint8_t *p = realloc(buf, new_cap);
+    if (!p) {
+        fail("%s%s", "out of memory while recording", "");
+        return false;
+    }
+    buf = p;
+    cap = new_cap;
+    return true;
+}
+
+static void put_byte(uint8_t b) {
+    if (reserve(1)) buf[pos++] = b;
+}
+
+static void put_uleb(uint64_t v) {
+    do {
+        uint8_t b = v & 0x7fu;
+        v >>= 7;
+        put_byte(v ? (uint8_t)(b | 0x80u) : b);
+    } while (v);
+}
+
+static void begin_event(hal_trace_event_t ev, size_t *start) {
+    *start = pos;
+    put_byte((uint8_t)ev);
+}
+
+static void end_event(hal_trace_event_t ev, size_t start) {
+    stats.events[ev]++;
+    stats.bytes[ev] += pos - start;
+}
+
+// --- 재생 ---
+
+static bool get_byte(uint8_t *b) {
+    if (pos >= len) {
+        fail("%s%s", "trace truncated", "");
+        return false;
+    }
+    *b = buf[pos++];
+    return true;
+}
+
+static bool get_uleb(uint64_t *v) {
+    *v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t b;
+        if (!get_byte(&b)) return false;
+        *v |= (uint64_t)(b & 0x7fu) << shift;
+        if (!(b & 0x80u)) return true;
+    }
+    fail("%s%s", "bad varint", "");
+    return false;
+}
+
+// 다음 이벤트 종류가 ev인지 확인하고 소비
+static bool expect(hal_trace_event_t ev, size_t *start) {
+    if (failed) return false;
+    *start = pos;
+    uint8_t tag;
+    if (!get_byte(&tag)) return false;
+    if (tag != ev) {
+        fail("replay reached %s but trace has %s", EVENT_NAMES[ev], tag < HAL_TRACE_EV_COUNT ? EVENT_NAMES[tag] : "?");
+        pos = *start;
+        return false;
+    }
+    return true;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool hal_trace_record_start(size_t initial_capacity) {
+    if (mode != HAL_TRACE_OFF) return false;
+    reset_state();
+    cap = initial_capacity < 64 ? 64 : initial_capacity;
+    buf = malloc(cap);
+    if (!buf) return false;
+    memcpy(buf, MAGIC, sizeof(MAGIC));
+    pos = sizeof(MAGIC);
+    mode = HAL_TRACE_RECORD;
+    return true;
+}
+
+uint8_t *hal_trace_record_stop(size_t *out_len) {
+    if (mode != HAL_TRACE_RECORD) return NULL;
+    size_t start;
+    begin_event(HAL_TRACE_EV_END, &start);
+    end_event(HAL_TRACE_EV_END, start);
+    mode = HAL_TRACE_OFF;
+    uint8_t *data = buf;
+    buf = NULL;
+    if (failed) {
+        free(data);
+        return NULL;
+    }
+    *out_len = pos;
+    return data;
+}
+
+bool hal_trace_replay_start(const uint8_t *data, size_t data_len) {
+    if (mode != HAL_TRACE_OFF || data_len < sizeof(MAGIC) + 1 || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    reset_state();
+    buf = (uint8_t *)data;
+    len = data_len;
+    pos = sizeof(MAGIC);
+    mode = HAL_TRACE_REPLAY;
+    return true;
+}
+
+bool hal_trace_replay_stop(void) {
+    if (mode != HAL_TRACE_REPLAY) return false;
+    size_t start;
+    bool ok = expect(HAL_TRACE_EV_END, &start);
+    if (ok) end_event(HAL_TRACE_EV_END, start);
+    mode = HAL_TRACE_OFF;
+    buf = NULL;
+    return ok && !failed;
+}
+
+hal_trace_mode_t hal_trace_mode(void) {
+    return mode;
+}
+
+const char *hal_trace_error(void) {
+    return failed ? error_msg : NULL;
+}
+
+void hal_trace_get_stats(hal_trace_stats_t *out) {
+    *out = stats;
+}
+
+bool hal_trace_input(uint8_t source, void *data, uint16_t n) {
+    if (mode == HAL_TRACE_OFF) return true;
+    if (source >= HAL_TRACE_MAX_SOURCES || n > HAL_TRACE_MAX_INPUT) {
+        fail("%s%s", "input source/length out of range", "");
+        return false;
+    }
+    uint8_t *bytes = data, *prev = prev_input[source];
+    size_t start;
+
+    if (mode == HAL_TRACE_RECORD) {
+        begin_event(HAL_TRACE_EV_INPUT, &start);
+        put_byte(source);
+        put_uleb(n);
+        // 16비트 단어마다 직전 값과의 차이 (센서 값은 천천히 변하므로 대부분 1 바이트)
+        for (uint16_t i = 0; i < n; i += 2) {
+            uint16_t cur = get_word(bytes, i, n), old = get_word(prev, i, n);
+            put_uleb(zigzag((int16_t)(uint16_t)(cur - old)));
+        }
+        memcpy(prev, bytes, n);
+        end_event(HAL_TRACE_EV_INPUT, start);
+        return !failed;
+    }
+
+    uint8_t s;
+    uint64_t rec_len;
+    if (!expect(HAL_TRACE_EV_INPUT, &start) || !get_byte(&s) || !get_uleb(&rec_len)) return false;
+    if (s != source || rec_len != n) {
+        fail("%s%s", "input source/length differs from trace", "");
+        return false;
+    }
+    for (uint16_t i = 0; i < n; i += 2) {
+        uint64_t z;
+        if (!get_uleb(&z)) return false;
+        uint16_t cur = (uint16_t)(get_word(prev, i, n) + (uint16_t)unzigzag(z));
+        prev[i] = (uint8_t)cur;
+        if (i + 1 < n) prev[i + 1] = (uint8_t)(cur >> 8);
+    }
+    memcpy(bytes, prev, n);
+    end_event(HAL_TRACE_EV_INPUT, start);
+    return true;
+}
+
+void hal_trace_irq(uint8_t irq) {
+    if (mode != HAL_TRACE_RECORD) return;
+    size_t start;
+    begin_event(HAL_TRACE_EV_IRQ, &start);
+    put_byte(irq);
+    end_event(HAL_TRACE_EV_IRQ, start);
+}
+
+bool hal_trace_next_irq(uint8_t *irq) {
+    if (mode != HAL_TRACE_REPLAY || failed || pos >= len || buf[pos] == HAL_TRACE_EV_END) return false;
+    size_t start;
+    if (!expect(HAL_TRACE_EV_IRQ, &start) || !get_byte(irq)) return false;
+    end_event(HAL_TRACE_EV_IRQ, start);
+    return true;
+}
+
+// --- HAL 내부 훅 ---
+
+uint64_t hal_trace_time(uint64_t live_us) {
+    size_t start;
+    if (mode == HAL_TRACE_RECORD) {
+        begin_event(HAL_TRACE_EV_TIME, &start);
+        int64_t delta = (int64_t)(live_us - last_time);
+        put_uleb(zigzag(delta - last_delta)); // 일정한 주기로 읽으면 0
+        last_time = live_us;
+        last_delta = delta;
+        end_event(HAL_TRACE_EV_TIME, start);
+    } else if (mode == HAL_TRACE_REPLAY) {
+        uint64_t dd;
+        if (!expect(HAL_TRACE_EV_TIME, &start) || !get_uleb(&dd)) return live_us;
+        last_delta += unzigzag(dd);
+        last_time += (uint64_t)last_delta;
+        end_event(HAL_TRACE_EV_TIME, start);
+        return last_time;
+    }
+    return live_us;
+}
+
+bool hal_trace_gpio(uint32_t gpio, bool live) {
+    size_t start;
+    if (mode == HAL_TRACE_RECORD) {
+        begin_event(HAL_TRACE_EV_GPIO, &start);
+        put_byte((uint8_t)((gpio << 1) | (live ? 1u : 0u)));
+        end_event(HAL_TRACE_EV_GPIO, start);
+    } else if (mode == HAL_TRACE_REPLAY) {
+        uint8_t b;
+        if (!expect(HAL_TRACE_EV_GPIO, &start) || !get_byte(&b)) return live;
+        if ((b >> 1) != gpio) fail("%s%s", "GPIO read on a different pin than recorded", "");
+        end_event(HAL_TRACE_EV_GPIO, start);
+        return (b & 1u) != 0;
+    }
+    return live;
+}
+
+void hal_trace_pwm(uint32_t slice_num, uint32_t chan, uint16_t level) {
+    size_t start;
+    uint8_t id = (uint8_t)((slice_num << 1) | chan);
+    if (mode == HAL_TRACE_RECORD) {
+        begin_event(HAL_TRACE_EV_PWM, &start);
+        put_byte(id);
+        put_uleb(level);
+        end_event(HAL_TRACE_EV_PWM, start);
+    } else if (mode == HAL_TRACE_REPLAY) {
+        uint8_t rec_id;
+        uint64_t rec_level;
+        if (!expect(HAL_TRACE_EV_PWM, &start) || !get_byte(&rec_id) || !get_uleb(&rec_level)) return;
+        if (rec_id != id || rec_level != level) {
+            char was[40], now[40];
+            snprintf(was, sizeof(was), "slice %u/%u level %u", rec_id >> 1, rec_id & 1u, (unsigned)rec_level);
+            snprintf(now, sizeof(now), "slice %u/%u level %u", (unsigned)slice_num, (unsigned)chan, level);
+            fail("PWM output diverged: recorded %s, replay %s", was, now);
+            return;
+        }
+        end_event(HAL_TRACE_EV_PWM, start);
+    }
+}
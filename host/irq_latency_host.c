@@ -0,0 +1,262 @@
+// 인터럽트 진입 지연 측정의 호스트 에뮬레이션
+//
+// 타깃 하네스(src/irq_latency.c)와 같은 소스/부하 조합과 같은 JSON 형식으로
+// 결과를 출력합니다. 하드웨어 인터럽트 대신
+//   - timer: POSIX 절대 시각 타이머 시그널의 핸들러 진입 시각
+//   - gpio : 파이프 쓰기 -> 대기 중인 "ISR" 스레드 깨어남 시각
+// 을 측정하며 단위는 ns 입니다. 부하는 플래시 -> fsync 파일 쓰기,
+// DMA -> 대용량 memcpy, UART -> 소켓 쌍 바이트 단위 송수신으로 대체합니다.
+#define _GNU_SOURCE
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "latency_hist.h"
+
+#define HOST_DEFAULT_SAMPLES 2000
+#define HOST_DEFAULT_BIN_NS 1000
+#define HOST_PERIOD_NS 200000
+#define HOST_DMA_BYTES (4u * 1024u * 1024u)
+
+typedef enum { LOAD_NONE = 0, LOAD_FLASH, LOAD_DMA, LOAD_UART, LOAD_COUNT } host_load_t;
+static const char *const load_names[LOAD_COUNT] = { "none", "flash", "dma", "uart" };
+
+static volatile int load_running;
+static volatile sig_atomic_t timer_fired;
+static struct timespec timer_entry;
+
+static uint64_t ts_to_ns(const struct timespec *ts) {
+    return (uint64_t)ts->tv_sec * 1000000000ull + (uint64_t)ts->tv_nsec;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts_to_ns(&ts);
+}
+
+static uint32_t clamp_u32(uint64_t v) {
+    return v > UINT32_MAX ? UINT32_MAX : (uint32_t)v;
+}
+
+// --- 배경 부하 ---
+
+static void *flash_load_thread(void *arg) {
+    (void)arg;
+    char path[] = "/tmp/irq_latency_flashXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    unlink(path);
+
+    char sector[4096];
+    memset(sector, 0xA5, sizeof(sector));
+    while (load_running) {
+        if (pwrite(fd, sector, sizeof(sector), 0) < 0) break;
+        fsync(fd);
+    }
+    close(fd);
+    return NULL;
+}
+
+static void *dma_load_thread(void *arg) {
+    (void)arg;
+    uint8_t *src = malloc(HOST_DMA_BYTES);
+    uint8_t *dst = malloc(HOST_DMA_BYTES);
+    if (src && dst) {
+        memset(src, 0x5A, HOST_DMA_BYTES);
+        while (load_running) {
+            memcpy(dst, src, HOST_DMA_BYTES);
+            __asm__ volatile("" : : "r"(dst) : "memory");
+        }
+    }
+    free(src);
+    free(dst);
+    return NULL;
+}
+
+static int uart_pair[2];
+
+static void *uart_rx_thread(void *arg) {
+    (void)arg;
+    char c;
+    while (read(uart_pair[1], &c, 1) == 1) {
+    }
+    return NULL;
+}
+
+static void *uart_load_thread(void *arg) {
+    (void)arg;
+    const char c = 0x55;
+    while (load_running) {
+        if (write(uart_pair[0], &c, 1) != 1) break;
+    }
+    return NULL;
+}
+
+typedef struct {
+    pthread_t threads[2];
+    int count;
+} load_handle_t;
+
+static void start_load(host_load_t load, load_handle_t *h) {
+    h->count = 0;
+    load_running = 1;
+    switch (load) {
+    case LOAD_FLASH:
+        pthread_create(&h->threads[h->count++], NULL, flash_load_thread, NULL);
+        break;
+    case LOAD_DMA:
+        pthread_create(&h->threads[h->count++], NULL, dma_load_thread, NULL);
+        break;
+    case LOAD_UART:
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, uart_pair) == 0) {
+            pthread_create(&h->threads[h->count++], NULL, uart_rx_thread, NULL);
+            pthread_create(&h->threads[h->count++], NULL, uart_load_thread, NULL);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void stop_load(host_load_t load, load_handle_t *h) {
+    load_running = 0;
+    if (load == LOAD_UART && h->count) {
+        shutdown(uart_pair[0], SHUT_RDWR); // 수신 스레드의 read()를 깨움
+    }
+    for (int i = h->count - 1; i >= 0; --i) {
+        pthread_join(h->threads[i], NULL);
+    }
+    if (load == LOAD_UART && h->count) {
+        close(uart_pair[0]);
+        close(uart_pair[1]);
+    }
+}
+
+// --- timer 소스 ---
+
+static void timer_handler(int sig) {
+    (void)sig;
+    clock_gettime(CLOCK_MONOTONIC, &timer_entry); // async-signal-safe
+    timer_fired = 1;
+}
+
+static int measure_timer(uint32_t samples, latency_hist_t *hist) {
+    // SIGRTMIN은 main()에서 모든 스레드에 대해 막혀 있으며 sigsuspend 동안에만 열림
+    sigset_t wait_mask;
+    pthread_sigmask(SIG_BLOCK, NULL, &wait_mask);
+    sigdelset(&wait_mask, SIGRTMIN);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = timer_handler;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGRTMIN, &sa, NULL) != 0) return -1;
+
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo = SIGRTMIN;
+    timer_t timer;
+    if (timer_create(CLOCK_MONOTONIC, &sev, &timer) != 0) return -1;
+
+    for (uint32_t i = 0; i < samples; ++i) {
+        timer_fired = 0;
+        uint64_t target = now_ns() + HOST_PERIOD_NS;
+        struct itimerspec its;
+        memset(&its, 0, sizeof(its));
+        its.it_value.tv_sec = (time_t)(target / 1000000000ull);
+        its.it_value.tv_nsec = (long)(target % 1000000000ull);
+        timer_settime(timer, TIMER_ABSTIME, &its, NULL);
+
+        while (!timer_fired) {
+            sigsuspend(&wait_mask);
+        }
+        latency_hist_add(hist, clamp_u32(ts_to_ns(&timer_entry) - target));
+    }
+
+    timer_delete(timer);
+    return 0;
+}
+
+// --- gpio 소스 (파이프 엣지 -> 대기 스레드) ---
+
+static int edge_pipe[2];
+static volatile uint64_t edge_entry_ns;
+static volatile int edge_seen;
+
+static void *edge_isr_thread(void *arg) {
+    (void)arg;
+    char c;
+    while (read(edge_pipe[0], &c, 1) == 1) {
+        edge_entry_ns = now_ns();
+        __atomic_store_n(&edge_seen, 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+static int measure_gpio(uint32_t samples, latency_hist_t *hist) {
+    if (pipe(edge_pipe) != 0) return -1;
+    pthread_t isr;
+    pthread_create(&isr, NULL, edge_isr_thread, NULL);
+
+    for (uint32_t i = 0; i < samples; ++i) {
+        __atomic_store_n(&edge_seen, 0, __ATOMIC_RELEASE);
+        const char c = 1;
+        uint64_t start = now_ns();
+        if (write(edge_pipe[1], &c, 1) != 1) break;
+        while (!__atomic_load_n(&edge_seen, __ATOMIC_ACQUIRE)) {
+        }
+        latency_hist_add(hist, clamp_u32(edge_entry_ns - start));
+
+        struct timespec gap = { 0, HOST_PERIOD_NS };
+        nanosleep(&gap, NULL);
+    }
+
+    close(edge_pipe[1]);
+    pthread_join(isr, NULL);
+    close(edge_pipe[0]);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    uint32_t samples = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : HOST_DEFAULT_SAMPLES;
+    uint32_t bin_ns = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : HOST_DEFAULT_BIN_NS;
+    if (samples == 0) {
+        fprintf(stderr, "usage: %s [samples] [bin_ns]\n", argv[0]);
+        return 1;
+    }
+
+    // 타이머 시그널이 부하 스레드로 배달되지 않도록 스레드 생성 전에 막아둠
+    sigset_t block;
+    sigemptyset(&block);
+    sigaddset(&block, SIGRTMIN);
+    pthread_sigmask(SIG_BLOCK, &block, NULL);
+
+    static latency_hist_t hist;
+    for (int src = 0; src < 2; ++src) {
+        for (int load = 0; load < LOAD_COUNT; ++load) {
+            load_handle_t h;
+            latency_hist_reset(&hist, bin_ns);
+            start_load((host_load_t)load, &h);
+            int rc = src == 0 ? measure_gpio(samples, &hist) : measure_timer(samples, &hist);
+            stop_load((host_load_t)load, &h);
+
+            const char *src_name = src == 0 ? "gpio" : "timer";
+            if (rc != 0) {
+                printf("{\"source\":\"%s\",\"load\":\"%s\",\"error\":\"%s\"}\n",
+                       src_name, load_names[load], strerror(errno));
+                continue;
+            }
+            latency_hist_print_json(&hist, src_name, load_names[load], "ns");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "logk.h"
+#include "logk_impl.h"
+
+// --- 스칼라 구현 ---
+
+static void scalar_i16_to_f32(const int16_t *in, float *out, size_t n, float scale) {
+    for (size_t i = 0; i < n; ++i) out[i] = (float)in[i] * scale;
+}
+
+static void scalar_i16_fixmul(const int16_t *in, int16_t *out, size_t n, int32_t mul, uint32_t shift) {
+    int32_t round = 1 << (shift - 1);
+    for (size_t i = 0; i < n; ++i) out[i] = logk_fixmul_one(in[i], mul, round, shift);
+}
+
+static void scalar_pressure_to_alt(const int32_t *pa, float *alt_m, size_t n, float inv_p0) {
+    for (size_t i = 0; i < n; ++i) alt_m[i] = logk_alt_one(pa[i], inv_p0);
+}
+
+static void scalar_fir(const float *in, size_t nout, const float *taps, size_t ntaps, float *out) {
+    for (size_t i = 0; i < nout; ++i) out[i] = logk_fir_one(in + i, taps, ntaps);
+}
+
+static void scalar_fir_decimate(const float *in, size_t nout, const float *taps, size_t ntaps, size_t factor,
+                                float *out) {
+    for (size_t j = 0; j < nout; ++j) out[j] = logk_fir_one(in + j * factor, taps, ntaps);
+}
+
+static const logk_ops_t scalar_ops = {
+    .i16_to_f32 = scalar_i16_to_f32,
+    .i16_fixmul = scalar_i16_fixmul,
+    .pressure_to_alt = scalar_pressure_to_alt,
+    .fir = scalar_fir,
+    .fir_decimate = scalar_fir_decimate,
+};
+
+// --- 구현 선택 ---
+
+static const logk_ops_t *ops;
+static logk_isa_t current_isa;
+
+static const logk_ops_t *ops_for(logk_isa_t isa) {
+    switch (isa) {
+        case LOGK_SCALAR:
+            return &scalar_ops;
+#ifdef LOGK_HAVE_AVX2
+        case LOGK_AVX2:
+            return __builtin_cpu_supports("avx2") ? &logk_avx2_ops : NULL;
+#endif
+#ifdef LOGK_HAVE_NEON
+        case LOGK_NEON:
+            return &logk_neon_ops; // AArch64 에서는 항상 있음
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static const logk_ops_t *active(void) {
+    if (!ops) logk_use(logk_best_isa());
+    return ops;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+logk_isa_t logk_best_isa(void) {
+    if (ops_for(LOGK_AVX2)) return LOGK_AVX2;
+    if (ops_for(LOGK_NEON)) return LOGK_NEON;
+    return LOGK_SCALAR;
+}
+
+bool logk_use(logk_isa_t isa) {
+    const logk_ops_t *o = ops_for(isa);
+    if (!o) return false;
+    ops = o;
+    current_isa = isa;
+    return true;
+}
+
+logk_isa_t logk_current_isa(void) {
+    active();
+    return current_isa;
+}
+
+const char *logk_isa_name(logk_isa_t isa) {
+    switch (isa) {
+        case LOGK_SCALAR: return "scalar";
+        case LOGK_AVX2: return "avx2";
+        case LOGK_NEON: return "neon";
+    }
+    return "?";
+}
+
+void logk_i16_to_f32(const int16_t *in, float *out, size_t n, float scale) {
+    active()->i16_to_f32(in, out, n, scale);
+}
+
+void logk_i16_fixmul(const int16_t *in, int16_t *out, size_t n, int32_t mul, uint32_t shift) {
+    active()->i16_fixmul(in, out, n, mul, shift);
+}
+
+void logk_pressure_to_alt(const int32_t *pa, float *alt_m, size_t n, float p0_pa) {
+    active()->pressure_to_alt(pa, alt_m, n, 1.0f / p0_pa);
+}
+
+size_t logk_fir(const float *in, size_t n, const float *taps, size_t ntaps, float *out) {
+    if (ntaps == 0 || n < ntaps) return 0;
+    size_t nout = n - ntaps + 1;
+    active()->fir(in, nout, taps, ntaps, out);
+    return nout;
+}
+
+size_t logk_fir_decimate(const float *in, size_t n, const float *taps, size_t ntaps, size_t factor,
+                         float *out) {
+    if (ntaps == 0 || factor == 0 || n < ntaps) return 0;
+    size_t nout = (n - ntaps) / factor + 1;
+    active()->fir_decimate(in, nout, taps, ntaps, factor, out);
+    return nout;
+}
+
+void logk_lowpass_taps(float *taps, size_t ntaps, float cutoff) {
+    const double pi = 3.14159265358979323846;
+    double center = (ntaps - 1) / 2.0, sum = 0.0;
+    for (size_t k = 0; k < ntaps; ++k) {
+        double x = k - center;
+        double sinc = x == 0.0 ? 2.0 * cutoff : sin(2.0 * pi * cutoff * x) / (pi * x);
+        double window = ntaps > 1 ? 0.54 - 0.46 * cos(2.0 * pi * k / (ntaps - 1)) : 1.0;
+        taps[k] = (float)(sinc * window);
+        sum += taps[k];
+    }
+    for (size_t k = 0; k < ntaps; ++k) taps[k] = (float)(taps[k] / sum);
+}
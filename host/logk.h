@@ -0,0 +1,96 @@
+#ifndef LOGK_H_
+#define LOGK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * 지상 로그 처리 커널 (열 지향 로그에서 꺼낸 채널 배열용).
+ *
+ * 단위 변환, 고정소수점 변환(units.h), 기압 고도, FIR 필터/데시메이션을 제공합니다.
+ * 실행 시점에 CPU가 지원하는 가장 넓은 구현(AVX2 / NEON)을 고르고, 없으면 스칼라로
+ * 동작합니다. 모든 구현은 같은 연산을 같은 순서로(FMA 없이) 수행하므로 결과가
+ * 비트 단위로 같습니다. 벡터 구현을 바꿔도 저장된 분석 결과가 달라지지 않습니다.
+ */
+
+typedef enum {
+    LOGK_SCALAR,
+    LOGK_AVX2,
+    LOGK_NEON,
+} logk_isa_t;
+
+/**
+ * @brief 이 CPU와 빌드에서 쓸 수 있는 가장 빠른 구현을 반환합니다.
+ */
+logk_isa_t logk_best_isa(void);
+
+/**
+ * @brief 이후 커널 호출에 쓸 구현을 고릅니다 (기본값: logk_best_isa()).
+ *
+ * @return 빌드에 없거나 CPU가 지원하지 않으면 false (기존 선택 유지).
+ */
+bool logk_use(logk_isa_t isa);
+
+logk_isa_t logk_current_isa(void);
+
+const char *logk_isa_name(logk_isa_t isa);
+
+// --- 변환 ---
+
+/**
+ * @brief out[i] = (float)in[i] * scale (예: 가속도 원시값 -> m/s^2).
+ */
+void logk_i16_to_f32(const int16_t *in, float *out, size_t n, float scale);
+
+/**
+ * @brief 펌웨어와 같은 고정소수점 변환 out[i] = (in[i] * mul + 2^(shift-1)) >> shift.
+ *
+ * units.h 의 UNITS_*_MUL / UNITS_*_SHIFT 를 넘깁니다. 결과는 int16으로 자릅니다
+ * (펌웨어 units_fixmul_i16 과 같음). in[i] * mul 은 int32 범위여야 합니다.
+ *
+ * @param shift 1..31.
+ */
+void logk_i16_fixmul(const int16_t *in, int16_t *out, size_t n, int32_t mul, uint32_t shift);
+
+/**
+ * @brief 기압(Pa)을 표준 대기 고도(m)로 변환합니다 (units.h UNITS_BARO_*).
+ *
+ * powf 대신 다항식 log2/exp2를 쓰며, 배정밀도 pow() 기준 오차는 수 mm 이하입니다.
+ * 1 Pa 미만의 입력은 1 Pa로 취급합니다.
+ *
+ * @param p0_pa 기준(지상) 기압.
+ */
+void logk_pressure_to_alt(const int32_t *pa, float *alt_m, size_t n, float p0_pa);
+
+// --- 필터 ---
+
+/**
+ * @brief FIR 필터 out[i] = sum_k taps[k] * in[i + k] (k = 0..ntaps-1).
+ *
+ * 입력이 모두 있는 구간만 계산하므로 출력 out[i] 는 입력 in[i + (ntaps - 1) / 2] 에
+ * 해당합니다 (대칭 탭 기준).
+ *
+ * @return 출력 개수 n - ntaps + 1 (n < ntaps 이면 0).
+ */
+size_t logk_fir(const float *in, size_t n, const float *taps, size_t ntaps, float *out);
+
+/**
+ * @brief FIR 필터 후 factor 개마다 하나만 남깁니다 (out[j] = FIR 출력 [j * factor]).
+ *
+ * 버리는 출력은 계산하지 않습니다.
+ *
+ * @return 출력 개수 (n - ntaps) / factor + 1 (n < ntaps 이면 0).
+ */
+size_t logk_fir_decimate(const float *in, size_t n, const float *taps, size_t ntaps, size_t factor,
+                         float *out);
+
+/**
+ * @brief 해밍 창 저역 통과 탭을 만듭니다 (DC 이득 1).
+ *
+ * @param cutoff 차단 주파수 / 샘플링 주파수 (0 < cutoff < 0.5). 데시메이션 전에는
+ *               0.5 / factor 보다 조금 낮게 잡습니다.
+ */
+void logk_lowpass_taps(float *taps, size_t ntaps, float cutoff);
+
+#endif // LOGK_H_
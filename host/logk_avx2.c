@@ -0,0 +1,152 @@
+// logk AVX2 구현 (-mavx2 로 컴파일, logk.c 가 CPU 지원을 확인한 뒤에만 호출)
+#include <immintrin.h>
+#include "logk_impl.h"
+
+// --- 변환 ---
+
+static void avx2_i16_to_f32(const int16_t *in, float *out, size_t n, float scale) {
+    __m256 s = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(x));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), s));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), s));
+    }
+    for (; i < n; ++i) out[i] = (float)in[i] * scale;
+}
+
+static void avx2_i16_fixmul(const int16_t *in, int16_t *out, size_t n, int32_t mul, uint32_t shift) {
+    int32_t round = 1 << (shift - 1);
+    __m256i m = _mm256_set1_epi32(mul);
+    __m256i r = _mm256_set1_epi32(round);
+    __m256i low16 = _mm256_set1_epi32(0xFFFF);
+    __m128i count = _mm_cvtsi32_si128((int)shift);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(x));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1));
+        lo = _mm256_sra_epi32(_mm256_add_epi32(_mm256_mullo_epi32(lo, m), r), count);
+        hi = _mm256_sra_epi32(_mm256_add_epi32(_mm256_mullo_epi32(hi, m), r), count);
+        // int16 로 자르기: 하위 16비트만 남기면 부호 없는 포화 팩이 그대로 통과시킴
+        __m256i packed = _mm256_packus_epi32(_mm256_and_si256(lo, low16), _mm256_and_si256(hi, low16));
+        packed = _mm256_permute4x64_epi64(packed, 0xD8); // 128비트 레인 교차 순서 복원
+        _mm256_storeu_si256((__m256i *)(out + i), packed);
+    }
+    for (; i < n; ++i) out[i] = logk_fixmul_one(in[i], mul, round, shift);
+}
+
+// logk_alt_one 과 같은 연산 순서
+static void avx2_pressure_to_alt(const int32_t *pa, float *alt_m, size_t n, float inv_p0) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 sqrt2 = _mm256_set1_ps(LOGK_SQRT2);
+    const __m256 k = _mm256_set1_ps(UNITS_BARO_EXPONENT);
+    const __m256 ln2 = _mm256_set1_ps(LOGK_LN2);
+    const __m256 scale = _mm256_set1_ps(UNITS_BARO_SCALE_M);
+    const __m256 ip0 = _mm256_set1_ps(inv_p0);
+    const __m256i mant = _mm256_set1_epi32(0x007FFFFF);
+    const __m256i one_bits = _mm256_set1_epi32(0x3F800000);
+    const __m256i bias = _mm256_set1_epi32(127);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 p = _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *)(pa + i)));
+        p = _mm256_max_ps(p, one);
+        __m256 r = _mm256_mul_ps(p, ip0);
+
+        __m256i bits = _mm256_castps_si256(r);
+        __m256i e = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), bias);
+        __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mant), one_bits));
+        __m256 big = _mm256_cmp_ps(m, sqrt2, _CMP_GT_OQ);
+        m = _mm256_blendv_ps(m, _mm256_mul_ps(m, half), big);
+        e = _mm256_sub_epi32(e, _mm256_castps_si256(big)); // 참인 레인은 -1
+        __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+        __m256 t2 = _mm256_mul_ps(t, t);
+        __m256 poly = _mm256_set1_ps(LOGK_LOG2_C7);
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(LOGK_LOG2_C5));
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(LOGK_LOG2_C3));
+        poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(LOGK_LOG2_C1));
+        __m256 lg = _mm256_add_ps(_mm256_mul_ps(poly, t), _mm256_cvtepi32_ps(e));
+
+        __m256 y = _mm256_mul_ps(lg, k);
+        __m256 nf = _mm256_round_ps(y, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256 g = _mm256_mul_ps(_mm256_sub_ps(y, nf), ln2);
+        __m256 q = _mm256_set1_ps(LOGK_EXP_C7);
+        q = _mm256_add_ps(_mm256_mul_ps(q, g), _mm256_set1_ps(LOGK_EXP_C6));
+        q = _mm256_add_ps(_mm256_mul_ps(q, g), _mm256_set1_ps(LOGK_EXP_C5));
+        q = _mm256_add_ps(_mm256_mul_ps(q, g), _mm256_set1_ps(LOGK_EXP_C4));
+        q = _mm256_add_ps(_mm256_mul_ps(q, g), _mm256_set1_ps(LOGK_EXP_C3));
+        q = _mm256_add_ps(_mm256_mul_ps(q, g), _mm256_set1_ps(LOGK_EXP_C2));
+        q = _mm256_add_ps(_mm256_mul_ps(q, g), one);
+        q = _mm256_add_ps(_mm256_mul_ps(q, g), one);
+        __m256i qi = _mm256_add_epi32(_mm256_castps_si256(q), _mm256_slli_epi32(_mm256_cvtps_epi32(nf), 23));
+        _mm256_storeu_ps(alt_m + i, _mm256_mul_ps(scale, _mm256_sub_ps(one, _mm256_castsi256_ps(qi))));
+    }
+    for (; i < n; ++i) alt_m[i] = logk_alt_one(pa[i], inv_p0);
+}
+
+// --- 필터 ---
+
+// 출력 32개(누산기 4개)씩 묶어 탭 하나를 브로드캐스트해 곱함: 탭마다 load 4번 + mul/add 4쌍
+static void avx2_fir(const float *in, size_t nout, const float *taps, size_t ntaps, float *out) {
+    size_t i = 0;
+    for (; i + 32 <= nout; i += 32) {
+        __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+        __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+        const float *x = in + i;
+        for (size_t k = 0; k < ntaps; ++k) {
+            __m256 h = _mm256_broadcast_ss(taps + k);
+            a0 = _mm256_add_ps(a0, _mm256_mul_ps(h, _mm256_loadu_ps(x + k)));
+            a1 = _mm256_add_ps(a1, _mm256_mul_ps(h, _mm256_loadu_ps(x + k + 8)));
+            a2 = _mm256_add_ps(a2, _mm256_mul_ps(h, _mm256_loadu_ps(x + k + 16)));
+            a3 = _mm256_add_ps(a3, _mm256_mul_ps(h, _mm256_loadu_ps(x + k + 24)));
+        }
+        _mm256_storeu_ps(out + i, a0);
+        _mm256_storeu_ps(out + i + 8, a1);
+        _mm256_storeu_ps(out + i + 16, a2);
+        _mm256_storeu_ps(out + i + 24, a3);
+    }
+    for (; i + 8 <= nout; i += 8) {
+        __m256 a = _mm256_setzero_ps();
+        for (size_t k = 0; k < ntaps; ++k) {
+            a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_broadcast_ss(taps + k), _mm256_loadu_ps(in + i + k)));
+        }
+        _mm256_storeu_ps(out + i, a);
+    }
+    for (; i < nout; ++i) out[i] = logk_fir_one(in + i, taps, ntaps);
+}
+
+// 출력 8개의 입력 위치가 factor 간격이므로 gather로 모음
+static void avx2_fir_decimate(const float *in, size_t nout, const float *taps, size_t ntaps, size_t factor,
+                              float *out) {
+    if (factor == 1) {
+        avx2_fir(in, nout, taps, ntaps, out);
+        return;
+    }
+    int f = (int)factor;
+    __m256i idx = _mm256_setr_epi32(0, f, 2 * f, 3 * f, 4 * f, 5 * f, 6 * f, 7 * f);
+    size_t j = 0;
+    for (; j + 16 <= nout; j += 16) {
+        const float *x0 = in + j * factor;
+        const float *x1 = x0 + 8 * factor;
+        __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+        for (size_t k = 0; k < ntaps; ++k) {
+            __m256 h = _mm256_broadcast_ss(taps + k);
+            a0 = _mm256_add_ps(a0, _mm256_mul_ps(h, _mm256_i32gather_ps(x0 + k, idx, 4)));
+            a1 = _mm256_add_ps(a1, _mm256_mul_ps(h, _mm256_i32gather_ps(x1 + k, idx, 4)));
+        }
+        _mm256_storeu_ps(out + j, a0);
+        _mm256_storeu_ps(out + j + 8, a1);
+    }
+    for (; j < nout; ++j) out[j] = logk_fir_one(in + j * factor, taps, ntaps);
+}
+
+const logk_ops_t logk_avx2_ops = {
+    .i16_to_f32 = avx2_i16_to_f32,
+    .i16_fixmul = avx2_i16_fixmul,
+    .pressure_to_alt = avx2_pressure_to_alt,
+    .fir = avx2_fir,
+    .fir_decimate = avx2_fir_decimate,
+};
@@ -0,0 +1,108 @@
+#ifndef LOGK_IMPL_H_
+#define LOGK_IMPL_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "logk.h"
+#include "units.h"
+
+/*
+ * logk 구현 공용 부분 (logk.c / logk_avx2.c / logk_neon.c 전용).
+ *
+ * 원소 하나짜리 스칼라 함수는 스칼라 구현과 벡터 구현의 나머지 처리에 함께 쓰이며,
+ * 벡터 구현은 같은 상수로 같은 순서의 연산을 해야 합니다.
+ */
+
+typedef struct {
+    void (*i16_to_f32)(const int16_t *in, float *out, size_t n, float scale);
+    void (*i16_fixmul)(const int16_t *in, int16_t *out, size_t n, int32_t mul, uint32_t shift);
+    void (*pressure_to_alt)(const int32_t *pa, float *alt_m, size_t n, float inv_p0);
+    void (*fir)(const float *in, size_t nout, const float *taps, size_t ntaps, float *out);
+    void (*fir_decimate)(const float *in, size_t nout, const float *taps, size_t ntaps, size_t factor,
+                         float *out);
+} logk_ops_t;
+
+#ifdef LOGK_HAVE_AVX2
+extern const logk_ops_t logk_avx2_ops;
+#endif
+#ifdef LOGK_HAVE_NEON
+extern const logk_ops_t logk_neon_ops;
+#endif
+
+// --- 기압 고도 상수 ---
+// log2(m), m in [sqrt(1/2), sqrt(2)) : t = (m-1)/(m+1), log2(m) = 2/ln2 * (t + t^3/3 + t^5/5 + t^7/7)
+#define LOGK_SQRT2 1.41421356f
+#define LOGK_LOG2_C1 2.88539008f
+#define LOGK_LOG2_C3 0.96179669f
+#define LOGK_LOG2_C5 0.57707801f
+#define LOGK_LOG2_C7 0.41219858f
+// e^g, |g| <= ln2/2 : 7차 테일러
+#define LOGK_LN2 0.69314718f
+#define LOGK_EXP_C2 (1.0f / 2.0f)
+#define LOGK_EXP_C3 (1.0f / 6.0f)
+#define LOGK_EXP_C4 (1.0f / 24.0f)
+#define LOGK_EXP_C5 (1.0f / 120.0f)
+#define LOGK_EXP_C6 (1.0f / 720.0f)
+#define LOGK_EXP_C7 (1.0f / 5040.0f)
+
+static inline uint32_t logk_f2u(float f) {
+    uint32_t u;
+    memcpy(&u, &f, 4);
+    return u;
+}
+
+static inline float logk_u2f(uint32_t u) {
+    float f;
+    memcpy(&f, &u, 4);
+    return f;
+}
+
+static inline int16_t logk_fixmul_one(int16_t x, int32_t mul, int32_t round, uint32_t shift) {
+    return (int16_t)(((int32_t)x * mul + round) >> shift);
+}
+
+static inline float logk_alt_one(int32_t pa, float inv_p0) {
+    float p = (float)pa;
+    p = p > 1.0f ? p : 1.0f;
+    float r = p * inv_p0;
+
+    // r = 2^e * m
+    uint32_t bits = logk_f2u(r);
+    int32_t e = (int32_t)(bits >> 23) - 127;
+    float m = logk_u2f((bits & 0x007FFFFFu) | 0x3F800000u);
+    if (m > LOGK_SQRT2) {
+        m = m * 0.5f;
+        e = e + 1;
+    }
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    float poly = LOGK_LOG2_C7;
+    poly = poly * t2 + LOGK_LOG2_C5;
+    poly = poly * t2 + LOGK_LOG2_C3;
+    poly = poly * t2 + LOGK_LOG2_C1;
+    float lg = poly * t + (float)e;
+
+    // (p / p0)^k = 2^(k * log2(r)) = 2^n * e^(f * ln2)
+    float y = lg * UNITS_BARO_EXPONENT;
+    float n = rintf(y);
+    float g = (y - n) * LOGK_LN2;
+    float q = LOGK_EXP_C7;
+    q = q * g + LOGK_EXP_C6;
+    q = q * g + LOGK_EXP_C5;
+    q = q * g + LOGK_EXP_C4;
+    q = q * g + LOGK_EXP_C3;
+    q = q * g + LOGK_EXP_C2;
+    q = q * g + 1.0f;
+    q = q * g + 1.0f;
+    q = logk_u2f(logk_f2u(q) + ((uint32_t)(int32_t)n << 23));
+    return UNITS_BARO_SCALE_M * (1.0f - q);
+}
+
+static inline float logk_fir_one(const float *in, const float *taps, size_t ntaps) {
+    float acc = 0.0f;
+    for (size_t k = 0; k < ntaps; ++k) acc = acc + taps[k] * in[k];
+    return acc;
+}
+
+#endif // LOGK_IMPL_H_
@@ -0,0 +1,131 @@
+// logk NEON 구현 (AArch64 전용: vdivq_f32 / vrndnq_f32 사용)
+#include <arm_neon.h>
+#include "logk_impl.h"
+
+// --- 변환 ---
+
+static void neon_i16_to_f32(const int16_t *in, float *out, size_t n, float scale) {
+    float32x4_t s = vdupq_n_f32(scale);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t x = vld1q_s16(in + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x)));
+        vst1q_f32(out + i, vmulq_f32(lo, s));
+        vst1q_f32(out + i + 4, vmulq_f32(hi, s));
+    }
+    for (; i < n; ++i) out[i] = (float)in[i] * scale;
+}
+
+static void neon_i16_fixmul(const int16_t *in, int16_t *out, size_t n, int32_t mul, uint32_t shift) {
+    int32_t round = 1 << (shift - 1);
+    int32x4_t m = vdupq_n_s32(mul);
+    int32x4_t r = vdupq_n_s32(round);
+    int32x4_t count = vdupq_n_s32(-(int32_t)shift); // 음수 시프트 = 산술 오른쪽 시프트
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t x = vld1q_s16(in + i);
+        int32x4_t lo = vshlq_s32(vaddq_s32(vmulq_s32(vmovl_s16(vget_low_s16(x)), m), r), count);
+        int32x4_t hi = vshlq_s32(vaddq_s32(vmulq_s32(vmovl_s16(vget_high_s16(x)), m), r), count);
+        vst1q_s16(out + i, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))); // vmovn = 하위 16비트 자르기
+    }
+    for (; i < n; ++i) out[i] = logk_fixmul_one(in[i], mul, round, shift);
+}
+
+// logk_alt_one 과 같은 연산 순서 (vmlaq 는 융합될 수 있어 쓰지 않음)
+static inline float32x4_t madd(float32x4_t a, float32x4_t b, float c) {
+    return vaddq_f32(vmulq_f32(a, b), vdupq_n_f32(c));
+}
+
+static void neon_pressure_to_alt(const int32_t *pa, float *alt_m, size_t n, float inv_p0) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t ip0 = vdupq_n_f32(inv_p0);
+    const float32x4_t sqrt2 = vdupq_n_f32(LOGK_SQRT2);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t p = vmaxq_f32(vcvtq_f32_s32(vld1q_s32(pa + i)), one);
+        float32x4_t r = vmulq_f32(p, ip0);
+
+        uint32x4_t bits = vreinterpretq_u32_f32(r);
+        int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127));
+        float32x4_t m = vreinterpretq_f32_u32(
+            vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFFu)), vdupq_n_u32(0x3F800000u)));
+        uint32x4_t big = vcgtq_f32(m, sqrt2);
+        m = vbslq_f32(big, vmulq_f32(m, vdupq_n_f32(0.5f)), m);
+        e = vsubq_s32(e, vreinterpretq_s32_u32(big)); // 참인 레인은 -1
+        float32x4_t t = vdivq_f32(vsubq_f32(m, one), vaddq_f32(m, one));
+        float32x4_t t2 = vmulq_f32(t, t);
+        float32x4_t poly = madd(vdupq_n_f32(LOGK_LOG2_C7), t2, LOGK_LOG2_C5);
+        poly = madd(poly, t2, LOGK_LOG2_C3);
+        poly = madd(poly, t2, LOGK_LOG2_C1);
+        float32x4_t lg = vaddq_f32(vmulq_f32(poly, t), vcvtq_f32_s32(e));
+
+        float32x4_t y = vmulq_f32(lg, vdupq_n_f32(UNITS_BARO_EXPONENT));
+        float32x4_t nf = vrndnq_f32(y);
+        float32x4_t g = vmulq_f32(vsubq_f32(y, nf), vdupq_n_f32(LOGK_LN2));
+        float32x4_t q = madd(vdupq_n_f32(LOGK_EXP_C7), g, LOGK_EXP_C6);
+        q = madd(q, g, LOGK_EXP_C5);
+        q = madd(q, g, LOGK_EXP_C4);
+        q = madd(q, g, LOGK_EXP_C3);
+        q = madd(q, g, LOGK_EXP_C2);
+        q = madd(q, g, 1.0f);
+        q = madd(q, g, 1.0f);
+        int32x4_t qi = vaddq_s32(vreinterpretq_s32_f32(q), vshlq_n_s32(vcvtq_s32_f32(nf), 23));
+        float32x4_t out = vmulq_f32(vdupq_n_f32(UNITS_BARO_SCALE_M), vsubq_f32(one, vreinterpretq_f32_s32(qi)));
+        vst1q_f32(alt_m + i, out);
+    }
+    for (; i < n; ++i) alt_m[i] = logk_alt_one(pa[i], inv_p0);
+}
+
+// --- 필터 ---
+
+static void neon_fir(const float *in, size_t nout, const float *taps, size_t ntaps, float *out) {
+    size_t i = 0;
+    for (; i + 16 <= nout; i += 16) {
+        float32x4_t a0 = vdupq_n_f32(0.0f), a1 = a0, a2 = a0, a3 = a0;
+        const float *x = in + i;
+        for (size_t k = 0; k < ntaps; ++k) {
+            float32x4_t h = vdupq_n_f32(taps[k]);
+            a0 = vaddq_f32(a0, vmulq_f32(h, vld1q_f32(x + k)));
+            a1 = vaddq_f32(a1, vmulq_f32(h, vld1q_f32(x + k + 4)));
+            a2 = vaddq_f32(a2, vmulq_f32(h, vld1q_f32(x + k + 8)));
+            a3 = vaddq_f32(a3, vmulq_f32(h, vld1q_f32(x + k + 12)));
+        }
+        vst1q_f32(out + i, a0);
+        vst1q_f32(out + i + 4, a1);
+        vst1q_f32(out + i + 8, a2);
+        vst1q_f32(out + i + 12, a3);
+    }
+    for (; i < nout; ++i) out[i] = logk_fir_one(in + i, taps, ntaps);
+}
+
+// NEON 에는 gather가 없으므로 factor 간격 입력을 레인별로 채움
+static void neon_fir_decimate(const float *in, size_t nout, const float *taps, size_t ntaps, size_t factor,
+                              float *out) {
+    if (factor == 1) {
+        neon_fir(in, nout, taps, ntaps, out);
+        return;
+    }
+    size_t j = 0;
+    for (; j + 4 <= nout; j += 4) {
+        const float *x = in + j * factor;
+        float32x4_t a = vdupq_n_f32(0.0f);
+        for (size_t k = 0; k < ntaps; ++k) {
+            float32x4_t v = vdupq_n_f32(x[k]);
+            v = vsetq_lane_f32(x[k + factor], v, 1);
+            v = vsetq_lane_f32(x[k + 2 * factor], v, 2);
+            v = vsetq_lane_f32(x[k + 3 * factor], v, 3);
+            a = vaddq_f32(a, vmulq_f32(vdupq_n_f32(taps[k]), v));
+        }
+        vst1q_f32(out + j, a);
+    }
+    for (; j < nout; ++j) out[j] = logk_fir_one(in + j * factor, taps, ntaps);
+}
+
+const logk_ops_t logk_neon_ops = {
+    .i16_to_f32 = neon_i16_to_f32,
+    .i16_fixmul = neon_i16_fixmul,
+    .pressure_to_alt = neon_pressure_to_alt,
+    .fir = neon_fir,
+    .fir_decimate = neon_fir_decimate,
+};
@@ -0,0 +1,128 @@
+#include "offload_client.h"
+#include "crc32.h"
+#include <string.h>
+
+// --- 내부 함수 ---
+
+// 수신 버퍼를 채움 (시간 초과/오류면 false)
+static bool fill(offload_client_t *c) {
+    if (c->rx_pos == c->rx_len) {
+        c->rx_pos = c->rx_len = 0;
+    } else if (c->rx_pos > 0) {
+        memmove(c->rx, c->rx + c->rx_pos, c->rx_len - c->rx_pos);
+        c->rx_len -= c->rx_pos;
+        c->rx_pos = 0;
+    }
+    int n = c->link.read(c->link.ctx, c->rx + c->rx_len, sizeof(c->rx) - c->rx_len, c->link.timeout_ms);
+    if (n <= 0) {
+        c->timeouts++;
+        return false;
+    }
+    c->rx_len += (uint32_t)n;
+    return true;
+}
+
+static bool read_exact(offload_client_t *c, void *buf, uint32_t len) {
+    uint8_t *dst = (uint8_t *)buf;
+    while (len) {
+        if (c->rx_pos == c->rx_len && !fill(c)) return false;
+        uint32_t n = c->rx_len - c->rx_pos;
+        if (n > len) n = len;
+        memcpy(dst, c->rx + c->rx_pos, n);
+        c->rx_pos += n;
+        dst += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool send_request(offload_client_t *c, uint8_t cmd, uint8_t source, uint32_t offset, uint32_t length) {
+    offload_request_t req = {
+        .magic = OFFLOAD_REQUEST_MAGIC, .cmd = cmd, .source = source, .offset = offset, .length = length,
+    };
+    return c->link.write(c->link.ctx, &req, sizeof(req));
+}
+
+// 응답 magic + cmd가 맞는 응답이 올 때까지 앞의 바이트(중단된 스트림 잔여분)를 버림
+static bool wait_response(offload_client_t *c, uint8_t cmd, offload_response_t *rsp) {
+    while (true) {
+        while (c->rx_len - c->rx_pos < sizeof(*rsp)) {
+            if (!fill(c)) return false;
+        }
+        memcpy(rsp, c->rx + c->rx_pos, sizeof(*rsp));
+        if (rsp->magic == OFFLOAD_RESPONSE_MAGIC && rsp->cmd == cmd && rsp->reserved == 0) {
+            c->rx_pos += sizeof(*rsp);
+            return true;
+        }
+        c->rx_pos++;
+        c->discarded++;
+    }
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void offload_client_init(offload_client_t *c, const offload_link_t *link) {
+    memset(c, 0, sizeof(*c));
+    c->link = *link;
+    if (c->link.timeout_ms <= 0) c->link.timeout_ms = 1000;
+}
+
+bool offload_client_info(offload_client_t *c, uint8_t source, uint32_t *size, uint8_t *status) {
+    offload_response_t rsp;
+    if (!send_request(c, OFFLOAD_CMD_INFO, source, 0, 0) || !wait_response(c, OFFLOAD_CMD_INFO, &rsp)) {
+        if (status) *status = OFFLOAD_ERR_IO;
+        return false;
+    }
+    if (status) *status = rsp.status;
+    *size = rsp.size;
+    return rsp.status == OFFLOAD_OK;
+}
+
+bool offload_client_fetch(offload_client_t *c, uint8_t source, uint32_t offset, uint32_t length,
+                          offload_data_fn fn, void *user, uint32_t max_retries) {
+    if (length == 0) {
+        uint32_t size;
+        if (!offload_client_info(c, source, &size, NULL) || offset > size) return false;
+        length = size - offset;
+    }
+
+    uint32_t pos = offset;
+    const uint32_t end = offset + length;
+    uint32_t attempts = 0;
+
+    while (pos < end) {
+        if (attempts++ > max_retries) return false;
+        if (attempts > 1) c->retries++;
+
+        offload_response_t rsp;
+        if (!send_request(c, OFFLOAD_CMD_READ, source, pos, end - pos) ||
+            !wait_response(c, OFFLOAD_CMD_READ, &rsp)) {
+            continue;
+        }
+        if (rsp.status != OFFLOAD_OK) return false; // 범위/소스 오류는 다시 해도 같음
+
+        while (true) {
+            offload_frame_header_t h;
+            if (!read_exact(c, &h, sizeof(h))) break;
+            if (h.magic != OFFLOAD_FRAME_MAGIC || h.offset != pos || h.length > OFFLOAD_FRAME_DATA) {
+                c->crc_errors++;
+                break;
+            }
+            if (h.length == 0) {
+                if (h.status != OFFLOAD_OK) break; // 기체 쪽 읽기 실패: 다시 요청
+                if (pos == end) return true;
+                c->crc_errors++;
+                break;
+            }
+            if (!read_exact(c, c->frame, h.length)) break;
+            if (crc32_update(0, c->frame, h.length) != h.crc) {
+                c->crc_errors++;
+                break;
+            }
+            if (!fn(user, pos, c->frame, h.length)) return false;
+            pos += h.length;
+        }
+        // 여기로 오면 스트림이 깨짐: 다음 READ가 기체 쪽 스트림을 중단시킴
+    }
+    return true;
+}
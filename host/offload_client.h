@@ -0,0 +1,56 @@
+#ifndef OFFLOAD_CLIENT_H_
+#define OFFLOAD_CLIENT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "offload_proto.h"
+
+/*
+ * 로그 오프로드 프로토콜의 지상 쪽 클라이언트 (전송 계층 독립).
+ * libusb 도구(offload_tool)와 루프백 벤치마크(bench_offload)가 함께 사용합니다.
+ */
+
+// 전송 계층. read는 timeout_ms 안에 받은 바이트 수 (시간 초과 0, 오류 -1)
+typedef struct {
+    int (*read)(void *ctx, void *buf, uint32_t cap, int timeout_ms);
+    bool (*write)(void *ctx, const void *buf, uint32_t len);
+    void *ctx;
+    int timeout_ms;
+} offload_link_t;
+
+typedef struct {
+    offload_link_t link;
+    uint8_t rx[16384];
+    uint32_t rx_pos, rx_len;
+    uint8_t frame[OFFLOAD_FRAME_DATA];
+    uint32_t crc_errors;      // CRC 또는 프레임 형식 오류
+    uint32_t timeouts;
+    uint32_t retries;         // 다시 요청한 횟수
+    uint32_t discarded;       // 동기를 다시 맞추며 버린 바이트
+} offload_client_t;
+
+// 검증된 데이터를 순서대로 받는 콜백. false를 반환하면 전송 중단
+typedef bool (*offload_data_fn)(void *user, uint32_t offset, const void *data, uint32_t len);
+
+void offload_client_init(offload_client_t *c, const offload_link_t *link);
+
+/**
+ * @brief 소스 크기를 조회합니다.
+ *
+ * @return 성공 시 true. 실패 시 status에 원인 (NULL 허용).
+ */
+bool offload_client_info(offload_client_t *c, uint8_t source, uint32_t *size, uint8_t *status);
+
+/**
+ * @brief [offset, offset + length) 를 받아 콜백으로 넘깁니다.
+ *
+ * CRC 오류, 시간 초과가 나면 마지막으로 검증된 위치부터 다시 요청합니다.
+ *
+ * @param length 0이면 소스 끝까지.
+ * @param max_retries 다시 요청할 최대 횟수.
+ * @return 전체를 받았으면 true.
+ */
+bool offload_client_fetch(offload_client_t *c, uint8_t source, uint32_t offset, uint32_t length,
+                          offload_data_fn fn, void *user, uint32_t max_retries);
+
+#endif // OFFLOAD_CLIENT_H_
@@ -0,0 +1,137 @@
+// USB 로그 오프로드 지상 도구 (libusb-1.0)
+//
+// 사용법:
+//   offload_tool info  [sdlog|flash]
+//   offload_tool get   [sdlog|flash] <out_file> [offset] [length]
+//
+// 기체는 CanSat-Galaxy-Offload 펌웨어(벤더 인터페이스 하나)로 부팅되어 있어야 합니다.
+#include <libusb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "offload_client.h"
+
+typedef struct {
+    libusb_device_handle *dev;
+    uint32_t total;
+    uint32_t last_report;
+    FILE *out;
+    struct timespec t0;
+} tool_t;
+
+static int usb_read(void *ctx, void *buf, uint32_t cap, int timeout_ms) {
+    tool_t *t = (tool_t *)ctx;
+    int got = 0;
+    // bulk IN은 패킷 단위로 받으므로 요청 크기를 패킷 배수로 맞춤
+    uint32_t n = cap / OFFLOAD_EP_SIZE * OFFLOAD_EP_SIZE;
+    if (n == 0) return 0;
+    int r = libusb_bulk_transfer(t->dev, OFFLOAD_EP_IN, buf, (int)n, &got, (unsigned)timeout_ms);
+    if (r == LIBUSB_ERROR_TIMEOUT) return got;
+    if (r != 0) return -1;
+    return got;
+}
+
+static bool usb_write(void *ctx, const void *buf, uint32_t len) {
+    tool_t *t = (tool_t *)ctx;
+    int sent = 0;
+    int r = libusb_bulk_transfer(t->dev, OFFLOAD_EP_OUT, (unsigned char *)buf, (int)len, &sent, 1000);
+    return r == 0 && sent == (int)len;
+}
+
+static double elapsed(const tool_t *t) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - t->t0.tv_sec) + (now.tv_nsec - t->t0.tv_nsec) / 1e9;
+}
+
+static bool write_out(void *user, uint32_t offset, const void *data, uint32_t len) {
+    tool_t *t = (tool_t *)user;
+    (void)offset;
+    if (fwrite(data, 1, len, t->out) != len) return false;
+    t->total += len;
+    if (t->total - t->last_report >= (1u << 20)) {
+        t->last_report = t->total;
+        fprintf(stderr, "\r%.1f MB  %.2f MB/s", t->total / 1e6, t->total / 1e6 / elapsed(t));
+    }
+    return true;
+}
+
+static int parse_source(const char *s) {
+    if (strcmp(s, "sdlog") == 0) return OFFLOAD_SRC_SDLOG;
+    if (strcmp(s, "flash") == 0) return OFFLOAD_SRC_FLASH;
+    return -1;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3 || (strcmp(argv[1], "info") != 0 && strcmp(argv[1], "get") != 0) ||
+        (strcmp(argv[1], "get") == 0 && argc < 4)) {
+        fprintf(stderr, "usage: %s info sdlog|flash\n       %s get sdlog|flash out_file [offset] [length]\n",
+                argv[0], argv[0]);
+        return 2;
+    }
+    int source = parse_source(argv[2]);
+    if (source < 0) {
+        fprintf(stderr, "unknown source: %s\n", argv[2]);
+        return 2;
+    }
+
+    if (libusb_init(NULL) != 0) return 1;
+    tool_t t = { 0 };
+    t.dev = libusb_open_device_with_vid_pid(NULL, OFFLOAD_USB_VID, OFFLOAD_USB_PID);
+    if (!t.dev) {
+        fprintf(stderr, "device %04x:%04x not found\n", OFFLOAD_USB_VID, OFFLOAD_USB_PID);
+        libusb_exit(NULL);
+        return 1;
+    }
+    libusb_set_auto_detach_kernel_driver(t.dev, 1);
+    if (libusb_claim_interface(t.dev, 0) != 0) {
+        fprintf(stderr, "claim interface failed\n");
+        libusb_close(t.dev);
+        libusb_exit(NULL);
+        return 1;
+    }
+
+    static offload_client_t client;
+    offload_link_t link = { usb_read, usb_write, &t, 500 };
+    offload_client_init(&client, &link);
+
+    // 이전 실행이 남긴 스트림 중단 (응답은 wait_response가 정리)
+    offload_request_t abort_req = { .magic = OFFLOAD_REQUEST_MAGIC, .cmd = OFFLOAD_CMD_ABORT };
+    usb_write(&t, &abort_req, sizeof(abort_req));
+
+    int rc = 0;
+    uint32_t size = 0;
+    uint8_t status = 0;
+    if (strcmp(argv[1], "info") == 0) {
+        if (offload_client_info(&client, (uint8_t)source, &size, &status)) {
+            printf("%s: %u bytes\n", argv[2], size);
+        } else {
+            fprintf(stderr, "info failed (status %u)\n", status);
+            rc = 1;
+        }
+    } else {
+        uint32_t offset = argc > 4 ? (uint32_t)strtoul(argv[4], NULL, 0) : 0;
+        uint32_t length = argc > 5 ? (uint32_t)strtoul(argv[5], NULL, 0) : 0;
+        t.out = fopen(argv[3], "wb");
+        if (!t.out) {
+            perror(argv[3]);
+            rc = 1;
+        } else {
+            clock_gettime(CLOCK_MONOTONIC, &t.t0);
+            bool ok = offload_client_fetch(&client, (uint8_t)source, offset, length, write_out, &t, 16);
+            double sec = elapsed(&t);
+            fclose(t.out);
+            fprintf(stderr, "\r%s: %u bytes in %.2f s (%.2f MB/s), crc errors %u, retries %u\n",
+                    ok ? "done" : "FAILED", t.total, sec, t.total / 1e6 / sec, client.crc_errors,
+                    client.retries);
+            rc = ok ? 0 : 1;
+        }
+    }
+
+    libusb_release_interface(t.dev, 0);
+    libusb_close(t.dev);
+    libusb_exit(NULL);
+    return rc;
+}
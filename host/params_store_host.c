@@ -0,0 +1,28 @@
+// params.h 저장소 백엔드 호스트 구현: 플래시 섹터 대신 파일 하나에 기록
+//
+// 파일 경로는 환경 변수 CANSAT_PARAMS_FILE, 없으면 현재 디렉터리의 params.bin
+
+#include "params.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *store_path(void) {
+    const char *path = getenv("CANSAT_PARAMS_FILE");
+    return path ? path : "params.bin";
+}
+
+bool params_storage_read(void *buf, uint32_t len) {
+    FILE *f = fopen(store_path(), "rb");
+    if (!f) return false;
+    bool ok = fread(buf, 1, len, f) == len;
+    fclose(f);
+    return ok;
+}
+
+bool params_storage_write(const void *buf, uint32_t len) {
+    FILE *f = fopen(store_path(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(buf, 1, len, f) == len;
+    ok = (fclose(f) == 0) && ok;
+    return ok;
+}
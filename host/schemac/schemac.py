@@ -0,0 +1,388 @@
+#!/usr/bin/env python3
+"""메시지 스키마 컴파일러.
+
+schema/messages.schema 를 읽어 고정 오프셋 인코더/디코더를 생성합니다.
+
+    schemac.py <schema> <out_dir>
+
+생성물:
+    messages.h / messages.c   펌웨어용 C (런타임 리플렉션 없음, 필드별 고정 오프셋)
+    messages.hpp              지상국용 C++17 디코더 (완전 해시로 ID -> 메시지 디스패치)
+"""
+
+import os
+import re
+import sys
+
+TYPES = {
+    # 이름: (바이트 수, C 타입, 부호 여부)
+    "u8": (1, "uint8_t", False),
+    "i8": (1, "int8_t", True),
+    "u16": (2, "uint16_t", False),
+    "i16": (2, "int16_t", True),
+    "u32": (4, "uint32_t", False),
+    "i32": (4, "int32_t", True),
+    "u64": (8, "uint64_t", False),
+    "i64": (8, "int64_t", True),
+    "f32": (4, "float", True),
+}
+
+FRAME_HEADER_BYTES = 4  # u16 id + u16 seq
+
+FIELD_RE = re.compile(r"^(\w+)\s+(\w+)(?:\[(\d+)\])?$")
+
+
+class Field:
+    def __init__(self, type_name, name, count, offset):
+        self.type_name = type_name
+        self.name = name
+        self.count = count  # 0 = 스칼라
+        self.offset = offset
+        self.size, self.ctype, self.signed = TYPES[type_name]
+
+    @property
+    def total_size(self):
+        return self.size * max(self.count, 1)
+
+
+class Message:
+    def __init__(self, name):
+        self.name = name
+        self.fields = []
+        self.size = 0
+        self.msg_id = fnv1a(name) & 0xFFFF
+
+    def add(self, type_name, name, count):
+        field = Field(type_name, name, count, self.size)
+        self.fields.append(field)
+        self.size += field.total_size
+
+
+def fnv1a(text):
+    h = 0x811C9DC5
+    for b in text.encode():
+        h ^= b
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def parse(path):
+    messages = []
+    current = None
+    with open(path, encoding="utf-8") as f:
+        for lineno, raw in enumerate(f, 1):
+            line = raw.split("#", 1)[0].strip()
+            if not line:
+                continue
+            if current is None:
+                m = re.match(r"^message\s+(\w+)\s*\{$", line)
+                if not m:
+                    sys.exit(f"{path}:{lineno}: expected 'message <name> {{'")
+                current = Message(m.group(1))
+                continue
+            if line == "}":
+                if not current.fields:
+                    sys.exit(f"{path}:{lineno}: message '{current.name}' has no fields")
+                messages.append(current)
+                current = None
+                continue
+            m = FIELD_RE.match(line)
+            if not m or m.group(1) not in TYPES:
+                sys.exit(f"{path}:{lineno}: bad field '{line}'")
+            count = int(m.group(3)) if m.group(3) else 0
+            if m.group(3) is not None and count == 0:
+                sys.exit(f"{path}:{lineno}: zero-length array")
+            current.add(m.group(1), m.group(2), count)
+    if current is not None:
+        sys.exit(f"{path}: unterminated message '{current.name}'")
+
+    ids = {}
+    for msg in messages:
+        if msg.msg_id in ids:
+            sys.exit(f"{path}: message id collision between '{ids[msg.msg_id]}' and '{msg.name}'")
+        ids[msg.msg_id] = msg.name
+    return messages
+
+
+def perfect_hash(messages):
+    """(id * seed) >> (32 - bits) 가 충돌 없는 seed 와 테이블 크기를 찾습니다."""
+    bits = max(1, (len(messages) - 1).bit_length())
+    while bits <= 16:
+        for seed in range(1, 1 << 20, 2):
+            seed = (seed * 0x9E3779B1) & 0xFFFFFFFF | 1
+            slots = {((m.msg_id * seed) & 0xFFFFFFFF) >> (32 - bits) for m in messages}
+            if len(slots) == len(messages):
+                return seed, bits
+        bits += 1
+    sys.exit("schemac: no perfect hash found")
+
+
+def slot_of(msg_id, seed, bits):
+    return ((msg_id * seed) & 0xFFFFFFFF) >> (32 - bits)
+
+
+# --- C 생성 ---
+
+def c_put(field, index_expr, offset_expr):
+    if field.type_name == "f32":
+        return f"put_f32(buf + {offset_expr}, m->{field.name}{index_expr});"
+    if field.size == 1:
+        return f"buf[{offset_expr}] = (uint8_t)m->{field.name}{index_expr};"
+    return f"put_u{field.size * 8}(buf + {offset_expr}, (uint{field.size * 8}_t)m->{field.name}{index_expr});"
+
+
+def c_get(field, index_expr, offset_expr):
+    if field.type_name == "f32":
+        return f"m->{field.name}{index_expr} = get_f32(buf + {offset_expr});"
+    if field.size == 1:
+        return f"m->{field.name}{index_expr} = ({field.ctype})buf[{offset_expr}];"
+    return f"m->{field.name}{index_expr} = ({field.ctype})get_u{field.size * 8}(buf + {offset_expr});"
+
+
+def gen_c_header(messages, schema_name):
+    out = []
+    out.append(f"// 자동 생성 파일: {schema_name} 에서 host/schemac/schemac.py 로 생성. 직접 수정하지 마세요.")
+    out.append("#ifndef MESSAGES_H_")
+    out.append("#define MESSAGES_H_")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("#include <stdbool.h>")
+    out.append("")
+    out.append(f"#define MSG_FRAME_HEADER_BYTES {FRAME_HEADER_BYTES}")
+    max_size = max(m.size for m in messages)
+    out.append(f"#define MSG_MAX_FRAME_BYTES {FRAME_HEADER_BYTES + max_size}")
+    out.append("")
+    for msg in messages:
+        up = msg.name.upper()
+        out.append(f"#define MSG_{up}_ID 0x{msg.msg_id:04X}u")
+        out.append(f"#define MSG_{up}_FRAME_BYTES {FRAME_HEADER_BYTES + msg.size}")
+    out.append("")
+    for msg in messages:
+        out.append("typedef struct {")
+        for f in msg.fields:
+            suffix = f"[{f.count}]" if f.count else ""
+            out.append(f"    {f.ctype} {f.name}{suffix};")
+        out.append(f"}} msg_{msg.name}_t;")
+        out.append("")
+    out.append("/**")
+    out.append(" * @brief 프레임 헤더에서 메시지 ID와 시퀀스 번호를 읽습니다.")
+    out.append(" *")
+    out.append(" * @return 헤더 길이보다 짧으면 false.")
+    out.append(" */")
+    out.append("bool msg_peek_header(const uint8_t *buf, uint32_t len, uint16_t *id, uint16_t *seq);")
+    out.append("")
+    for msg in messages:
+        out.append("/**")
+        out.append(f" * @brief {msg.name} 프레임을 인코딩합니다 (헤더 포함 {FRAME_HEADER_BYTES + msg.size} 바이트).")
+        out.append(" *")
+        out.append(" * @return 기록한 바이트 수, 버퍼가 작으면 0.")
+        out.append(" */")
+        out.append(f"uint32_t msg_{msg.name}_encode(const msg_{msg.name}_t *m, uint16_t seq, uint8_t *buf, uint32_t len);")
+        out.append("")
+        out.append("/**")
+        out.append(f" * @brief {msg.name} 프레임을 디코딩합니다.")
+        out.append(" *")
+        out.append(" * @return 성공 시 true, ID 불일치 또는 길이 부족 시 false.")
+        out.append(" */")
+        out.append(f"bool msg_{msg.name}_decode(msg_{msg.name}_t *m, const uint8_t *buf, uint32_t len);")
+        out.append("")
+    out.append("#endif // MESSAGES_H_")
+    return "\n".join(out) + "\n"
+
+
+def gen_c_source(messages, schema_name):
+    out = []
+    out.append(f"// 자동 생성 파일: {schema_name} 에서 host/schemac/schemac.py 로 생성. 직접 수정하지 마세요.")
+    out.append('#include "messages.h"')
+    out.append("#include <string.h> // memcpy 사용")
+    out.append("")
+    out.append("// --- 리틀엔디언 고정 폭 접근 (정렬되지 않은 주소 허용) ---")
+    out.append("static inline void put_u16(uint8_t *p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }")
+    out.append("static inline void put_u32(uint8_t *p, uint32_t v) { put_u16(p, (uint16_t)v); put_u16(p + 2, (uint16_t)(v >> 16)); }")
+    out.append("static inline void put_u64(uint8_t *p, uint64_t v) { put_u32(p, (uint32_t)v); put_u32(p + 4, (uint32_t)(v >> 32)); }")
+    out.append("static inline void put_f32(uint8_t *p, float v) { uint32_t u; memcpy(&u, &v, 4); put_u32(p, u); }")
+    out.append("static inline uint16_t get_u16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }")
+    out.append("static inline uint32_t get_u32(const uint8_t *p) { return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16); }")
+    out.append("static inline uint64_t get_u64(const uint8_t *p) { return get_u32(p) | ((uint64_t)get_u32(p + 4) << 32); }")
+    out.append("static inline float get_f32(const uint8_t *p) { uint32_t u = get_u32(p); float v; memcpy(&v, &u, 4); return v; }")
+    out.append("")
+    out.append("bool msg_peek_header(const uint8_t *buf, uint32_t len, uint16_t *id, uint16_t *seq) {")
+    out.append("    if (len < MSG_FRAME_HEADER_BYTES) return false;")
+    out.append("    *id = get_u16(buf);")
+    out.append("    *seq = get_u16(buf + 2);")
+    out.append("    return true;")
+    out.append("}")
+    out.append("")
+    for msg in messages:
+        up = msg.name.upper()
+        out.append(f"uint32_t msg_{msg.name}_encode(const msg_{msg.name}_t *m, uint16_t seq, uint8_t *buf, uint32_t len) {{")
+        out.append(f"    if (len < MSG_{up}_FRAME_BYTES) return 0;")
+        out.append(f"    put_u16(buf, MSG_{up}_ID);")
+        out.append("    put_u16(buf + 2, seq);")
+        out.append("    buf += MSG_FRAME_HEADER_BYTES;")
+        for f in msg.fields:
+            if f.count:
+                for i in range(f.count):
+                    out.append("    " + c_put(f, f"[{i}]", f.offset + i * f.size))
+            else:
+                out.append("    " + c_put(f, "", f.offset))
+        out.append(f"    return MSG_{up}_FRAME_BYTES;")
+        out.append("}")
+        out.append("")
+        out.append(f"bool msg_{msg.name}_decode(msg_{msg.name}_t *m, const uint8_t *buf, uint32_t len) {{")
+        out.append(f"    if (len < MSG_{up}_FRAME_BYTES || get_u16(buf) != MSG_{up}_ID) return false;")
+        out.append("    buf += MSG_FRAME_HEADER_BYTES;")
+        for f in msg.fields:
+            if f.count:
+                for i in range(f.count):
+                    out.append("    " + c_get(f, f"[{i}]", f.offset + i * f.size))
+            else:
+                out.append("    " + c_get(f, "", f.offset))
+        out.append("    return true;")
+        out.append("}")
+        out.append("")
+    return "\n".join(out).rstrip("\n") + "\n"
+
+
+# --- C++ 생성 ---
+
+def camel(name):
+    return "".join(part.capitalize() for part in name.split("_"))
+
+
+def cpp_type(f):
+    return f.ctype if f.type_name == "f32" else "std::" + f.ctype
+
+
+def cpp_read(f, offset):
+    if f.type_name == "f32":
+        return f"detail::get_f32(p + {offset})"
+    if f.size == 1:
+        return f"static_cast<{cpp_type(f)}>(p[{offset}])"
+    return f"static_cast<{cpp_type(f)}>(detail::get_u<{f.size}>(p + {offset}))"
+
+
+def gen_cpp(messages, schema_name):
+    seed, bits = perfect_hash(messages)
+    table_size = 1 << bits
+    slots = ["-1"] * table_size
+    for i, msg in enumerate(messages):
+        slots[slot_of(msg.msg_id, seed, bits)] = str(i)
+
+    out = []
+    out.append(f"// 자동 생성 파일: {schema_name} 에서 host/schemac/schemac.py 로 생성. 직접 수정하지 마세요.")
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include <array>")
+    out.append("#include <cstddef>")
+    out.append("#include <cstdint>")
+    out.append("#include <cstring>")
+    out.append("")
+    out.append("namespace cansat::msg {")
+    out.append("")
+    out.append(f"constexpr std::size_t kFrameHeaderBytes = {FRAME_HEADER_BYTES};")
+    out.append("")
+    out.append("namespace detail {")
+    out.append("template <int N>")
+    out.append("inline std::uint64_t get_u(const std::uint8_t *p) {")
+    out.append("    std::uint64_t v = 0;")
+    out.append("    for (int i = N - 1; i >= 0; --i) v = (v << 8) | p[i];")
+    out.append("    return v;")
+    out.append("}")
+    out.append("inline float get_f32(const std::uint8_t *p) {")
+    out.append("    std::uint32_t u = static_cast<std::uint32_t>(get_u<4>(p));")
+    out.append("    float v;")
+    out.append("    std::memcpy(&v, &u, sizeof(v));")
+    out.append("    return v;")
+    out.append("}")
+    out.append("}  // namespace detail")
+    out.append("")
+    for msg in messages:
+        out.append(f"struct {camel(msg.name)} {{")
+        out.append(f"    static constexpr std::uint16_t kId = 0x{msg.msg_id:04X};")
+        out.append(f"    static constexpr std::size_t kFrameBytes = {FRAME_HEADER_BYTES + msg.size};")
+        out.append(f'    static constexpr const char *kName = "{msg.name}";')
+        for f in msg.fields:
+            if f.count:
+                out.append(f"    std::array<{cpp_type(f)}, {f.count}> {f.name}{{}};")
+            else:
+                out.append(f"    {cpp_type(f)} {f.name}{{}};")
+        out.append("")
+        out.append("    // payload 는 프레임 헤더 다음 위치")
+        out.append(f"    static {camel(msg.name)} decode_payload(const std::uint8_t *p) {{")
+        out.append(f"        {camel(msg.name)} m;")
+        for f in msg.fields:
+            if f.count:
+                for i in range(f.count):
+                    out.append(f"        m.{f.name}[{i}] = {cpp_read(f, f.offset + i * f.size)};")
+            else:
+                out.append(f"        m.{f.name} = {cpp_read(f, f.offset)};")
+        out.append("        return m;")
+        out.append("    }")
+        out.append("};")
+        out.append("")
+    out.append("struct FrameHeader {")
+    out.append("    std::uint16_t id;")
+    out.append("    std::uint16_t seq;")
+    out.append("};")
+    out.append("")
+    out.append("// 완전 해시: (id * seed) >> (32 - bits) 가 메시지마다 서로 다른 슬롯")
+    out.append(f"constexpr std::uint32_t kHashSeed = 0x{seed:08X}u;")
+    out.append(f"constexpr int kHashBits = {bits};")
+    out.append(f"constexpr std::array<std::int8_t, {table_size}> kSlotToIndex = {{{', '.join(slots)}}};")
+    out.append(f"constexpr std::array<std::uint16_t, {len(messages)}> kIndexToId = {{{', '.join(f'0x{m.msg_id:04X}' for m in messages)}}};")
+    out.append("")
+    out.append("// ID -> 메시지 인덱스 (스키마 선언 순서), 모르는 ID면 -1")
+    out.append("inline int message_index(std::uint16_t id) {")
+    out.append("    std::uint32_t slot = (static_cast<std::uint32_t>(id) * kHashSeed) >> (32 - kHashBits);")
+    out.append("    int index = kSlotToIndex[slot];")
+    out.append("    return (index >= 0 && kIndexToId[static_cast<std::size_t>(index)] == id) ? index : -1;")
+    out.append("}")
+    out.append("")
+    out.append("// 프레임 하나를 디코딩해 visitor(header, message) 를 호출합니다.")
+    out.append("// 모르는 ID이거나 길이가 부족하면 false.")
+    out.append("template <typename Visitor>")
+    out.append("bool dispatch(const std::uint8_t *buf, std::size_t len, Visitor &&visitor) {")
+    out.append("    if (len < kFrameHeaderBytes) return false;")
+    out.append("    FrameHeader header{static_cast<std::uint16_t>(detail::get_u<2>(buf)),")
+    out.append("                       static_cast<std::uint16_t>(detail::get_u<2>(buf + 2))};")
+    out.append("    const std::uint8_t *p = buf + kFrameHeaderBytes;")
+    out.append("    switch (message_index(header.id)) {")
+    for i, msg in enumerate(messages):
+        out.append(f"    case {i}:")
+        out.append(f"        if (len < {camel(msg.name)}::kFrameBytes) return false;")
+        out.append(f"        visitor(header, {camel(msg.name)}::decode_payload(p));")
+        out.append("        return true;")
+    out.append("    default:")
+    out.append("        return false;")
+    out.append("    }")
+    out.append("}")
+    out.append("")
+    out.append("}  // namespace cansat::msg")
+    return "\n".join(out) + "\n"
+
+
+def write_if_changed(path, text):
+    # 내용이 같으면 건드리지 않아 불필요한 재빌드를 막음 (빌드 시스템은 별도 스탬프 파일로 최신 여부 판단)
+    if os.path.exists(path):
+        with open(path, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: schemac.py <schema> <out_dir>")
+    schema, out_dir = sys.argv[1], sys.argv[2]
+    messages = parse(schema)
+    name = os.path.basename(schema)
+    os.makedirs(out_dir, exist_ok=True)
+    write_if_changed(os.path.join(out_dir, "messages.h"), gen_c_header(messages, name))
+    write_if_changed(os.path.join(out_dir, "messages.c"), gen_c_source(messages, name))
+    write_if_changed(os.path.join(out_dir, "messages.hpp"), gen_cpp(messages, name))
+
+
+if __name__ == "__main__":
+    main()
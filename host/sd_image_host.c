@@ -0,0 +1,167 @@
+// sd_block.h 호스트 구현: SD 카드 대신 디스크 이미지 파일
+//
+// 연속 쓰기는 블록마다 pwrite 하며, sd_host_set_busy()로 카드 프로그래밍 busy 시간을
+// HAL 시간(hal_sim) 기준으로 흉내낼 수 있어 이중 버퍼링 동작을 호스트에서 확인할 수 있습니다.
+#define _POSIX_C_SOURCE 200809L
+#include "sd_block.h"
+#include "pico/time.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char *image_path = NULL;
+static int image_fd = -1;
+static uint32_t image_blocks = 0;
+
+static bool streaming = false;
+static uint32_t stream_lba;
+static uint32_t stream_count;
+static uint64_t busy_until_us;
+static uint32_t busy_block_us;
+static uint32_t busy_stall_every;
+static uint32_t busy_stall_us;
+
+// --- 내부 함수 ---
+
+static bool write_blocks(uint32_t lba, const uint8_t *buf, uint32_t count) {
+    if ((uint64_t)lba + count > image_blocks) return false;
+    ssize_t len = (ssize_t)count * SD_BLOCK_SIZE;
+    return pwrite(image_fd, buf, (size_t)len, (off_t)lba * SD_BLOCK_SIZE) == len;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void sd_host_set_image(const char *path) {
+    image_path = path;
+}
+
+void sd_host_set_busy(uint32_t block_us, uint32_t stall_every, uint32_t stall_us) {
+    busy_block_us = block_us;
+    busy_stall_every = stall_every;
+    busy_stall_us = stall_us;
+}
+
+bool sd_block_init(void) {
+    const char *path = image_path ? image_path : getenv("CANSAT_SD_IMAGE");
+    if (!path) path = "sd.img";
+
+    if (image_fd >= 0) close(image_fd);
+    image_fd = open(path, O_RDWR);
+    if (image_fd < 0) return false;
+
+    struct stat st;
+    if (fstat(image_fd, &st) != 0) return false;
+    image_blocks = (uint32_t)(st.st_size / SD_BLOCK_SIZE);
+    streaming = false;
+    busy_until_us = 0;
+    return image_blocks > 0;
+}
+
+uint32_t sd_block_count(void) {
+    return image_blocks;
+}
+
+bool sd_block_read(uint32_t lba, uint8_t *buf, uint32_t count) {
+    if (streaming || (uint64_t)lba + count > image_blocks) return false;
+    ssize_t len = (ssize_t)count * SD_BLOCK_SIZE;
+    return pread(image_fd, buf, (size_t)len, (off_t)lba * SD_BLOCK_SIZE) == len;
+}
+
+bool sd_block_write(uint32_t lba, const uint8_t *buf, uint32_t count) {
+    if (streaming) return false;
+    return write_blocks(lba, buf, count);
+}
+
+bool sd_stream_begin(uint32_t lba) {
+    if (streaming || lba >= image_blocks) return false;
+    streaming = true;
+    stream_lba = lba;
+    stream_count = 0;
+    return true;
+}
+
+bool sd_stream_poll(void) {
+    return true; // 호스트는 전송이 즉시 끝남 (busy는 sd_stream_write에서 흉내)
+}
+
+sd_status_t sd_stream_write(const uint8_t *block) {
+    if (!streaming) return SD_ERROR;
+    if (time_us_64() < busy_until_us) return SD_BUSY;
+    if (!write_blocks(stream_lba, block, 1)) return SD_ERROR;
+
+    ++stream_lba;
+    ++stream_count;
+    uint32_t busy = busy_block_us;
+    if (busy_stall_every && stream_count % busy_stall_every == 0) busy += busy_stall_us;
+    busy_until_us = time_us_64() + busy;
+    return SD_OK;
+}
+
+bool sd_stream_end(void) {
+    if (!streaming) return false;
+    streaming = false;
+    return true;
+}
+
+bool sd_host_format_fat32(const char *path, uint64_t bytes) {
+    const uint32_t reserved = 32, num_fats = 2;
+    uint32_t total = (uint32_t)(bytes / SD_BLOCK_SIZE);
+    uint8_t spc = bytes <= 260ull * 1024 * 1024 ? 1 : bytes <= 8ull * 1024 * 1024 * 1024 ? 8 : 32;
+
+    // Microsoft FAT32 FAT 크기 계산식
+    uint32_t tmp1 = total - reserved;
+    uint32_t tmp2 = (256u * spc + num_fats) / 2;
+    uint32_t fat_sectors = (tmp1 + tmp2 - 1) / tmp2;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    bool ok = ftruncate(fd, (off_t)total * SD_BLOCK_SIZE) == 0; // 희소 파일 (0으로 채워짐)
+
+    uint8_t s[SD_BLOCK_SIZE];
+    memset(s, 0, sizeof(s));
+    s[0] = 0xEB; s[1] = 0x58; s[2] = 0x90;
+    memcpy(s + 3, "CANSAT  ", 8);
+    s[0x0B] = 0x00; s[0x0C] = 0x02;                 // 512 bytes/sector
+    s[0x0D] = spc;
+    s[0x0E] = (uint8_t)reserved;
+    s[0x10] = (uint8_t)num_fats;
+    s[0x15] = 0xF8;                                 // media
+    s[0x18] = 32; s[0x1A] = 64;                     // sectors/track, heads
+    memcpy(s + 0x20, &total, 4);
+    memcpy(s + 0x24, &fat_sectors, 4);
+    s[0x2C] = 2;                                    // root cluster
+    s[0x30] = 1;                                    // FSInfo sector
+    s[0x32] = 6;                                    // backup boot sector
+    s[0x40] = 0x80;
+    s[0x42] = 0x29;
+    memcpy(s + 0x43, "\x47\x4C\x58\x59", 4);        // volume id
+    memcpy(s + 0x47, "NO NAME    ", 11);
+    memcpy(s + 0x52, "FAT32   ", 8);
+    s[0x1FE] = 0x55; s[0x1FF] = 0xAA;
+    ok = ok && pwrite(fd, s, sizeof(s), 0) == (ssize_t)sizeof(s);
+    ok = ok && pwrite(fd, s, sizeof(s), 6 * SD_BLOCK_SIZE) == (ssize_t)sizeof(s);
+
+    memset(s, 0, sizeof(s));
+    const uint32_t lead = 0x41615252u, struc = 0x61417272u, unknown = 0xFFFFFFFFu, trail = 0xAA550000u;
+    memcpy(s, &lead, 4);
+    memcpy(s + 484, &struc, 4);
+    memcpy(s + 488, &unknown, 4);
+    memcpy(s + 492, &unknown, 4);
+    memcpy(s + 508, &trail, 4);
+    ok = ok && pwrite(fd, s, sizeof(s), 1 * SD_BLOCK_SIZE) == (ssize_t)sizeof(s);
+    ok = ok && pwrite(fd, s, sizeof(s), 7 * SD_BLOCK_SIZE) == (ssize_t)sizeof(s);
+
+    // FAT[0], FAT[1] 예약, FAT[2] = 루트 디렉터리 (EOC)
+    memset(s, 0, sizeof(s));
+    const uint32_t fat_head[3] = { 0x0FFFFFF8u, 0x0FFFFFFFu, 0x0FFFFFFFu };
+    memcpy(s, fat_head, sizeof(fat_head));
+    for (uint32_t f = 0; f < num_fats; ++f) {
+        off_t off = (off_t)(reserved + f * fat_sectors) * SD_BLOCK_SIZE;
+        ok = ok && pwrite(fd, s, sizeof(s), off) == (ssize_t)sizeof(s);
+    }
+
+    ok = (close(fd) == 0) && ok;
+    return ok;
+}
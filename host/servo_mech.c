@@ -0,0 +1,116 @@
+#include "servo_mech.h"
+
+#include <math.h>
+#include <string.h>
+
+#define SUBSTEP_S 0.0002
+
+// --- 내부 함수 ---
+
+static uint32_t xorshift(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double gauss(uint32_t *s) {
+    double u1 = ((double)xorshift(s) + 1.0) / 4294967297.0;
+    double u2 = (double)xorshift(s) / 4294967296.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static void substep(servo_mech_t *m, uint32_t pulse_ns, double dt) {
+    const servo_mech_config_t *c = &m->config;
+
+    // 프레임이 시작될 때 펄스를 읽음
+    m->frame_t += dt;
+    if (m->frame_t >= c->frame_s) {
+        m->frame_t -= c->frame_s;
+        m->powered = pulse_ns != 0;
+        if (m->powered) m->cmd_deg = 90.0 + (pulse_ns / 1000.0 - c->center_us) / c->us_per_deg;
+    }
+
+    double u = 0.0;
+    if (m->powered) {
+        double err = m->cmd_deg - m->deg;
+        if (fabs(err) > c->deadband_deg) u = (err - copysign(c->deadband_deg, err)) * c->gain_per_deg;
+        if (u > 1.0) u = 1.0;
+        if (u < -1.0) u = -1.0;
+    }
+    m->u = u;
+
+    // 모터가 꺼져 있으면 기어 마찰로 부하를 버팀
+    double drive = m->powered ? u - c->load : 0.0;
+    m->w += (c->speed_dps * drive - m->w) * (dt / c->tau_s);
+    m->deg += m->w * dt;
+    int at_stop = 0;
+    if (m->deg <= c->stop_lo_deg) {
+        m->deg = c->stop_lo_deg;
+        if (m->w < 0.0) m->w = 0.0;
+        at_stop = u < -0.1;
+    } else if (m->deg >= c->stop_hi_deg) {
+        m->deg = c->stop_hi_deg;
+        if (m->w > 0.0) m->w = 0.0;
+        at_stop = u > 0.1;
+    }
+
+    m->current_ma = m->powered ? c->idle_ma + c->stall_ma * fabs(u - m->w / c->speed_dps) : 0.0;
+    m->charge_mas += m->current_ma * dt;
+    if (at_stop) m->stall_s += dt;
+}
+
+// --- 함수 구현 ---
+
+void servo_mech_default_config(servo_mech_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->center_us = 1500.0;
+    config->us_per_deg = 10.0;
+    config->stop_lo_deg = 0.0;
+    config->stop_hi_deg = 180.0;
+    config->speed_dps = 375.0;
+    config->tau_s = 0.015;
+    config->gain_per_deg = 0.15;
+    config->deadband_deg = 0.3;
+    config->load = 0.0;
+    config->frame_s = 0.020;
+    config->idle_ma = 12.0;
+    config->stall_ma = 700.0;
+    config->fb_offset = 300.0;
+    config->fb_per_deg = 19.0;
+    config->current_noise_ma = 6.0;
+    config->fb_noise = 1.5;
+}
+
+void servo_mech_init(servo_mech_t *m, const servo_mech_config_t *config, double deg, uint32_t seed) {
+    memset(m, 0, sizeof(*m));
+    m->config = *config;
+    m->rng = seed * 2654435761u + 1u;
+    m->deg = deg;
+    m->cmd_deg = deg;
+}
+
+void servo_mech_step(servo_mech_t *m, uint32_t pulse_ns, double dt) {
+    while (dt > 1e-12) {
+        double h = dt < SUBSTEP_S ? dt : SUBSTEP_S;
+        substep(m, pulse_ns, h);
+        dt -= h;
+    }
+}
+
+uint16_t servo_mech_current_ma(servo_mech_t *m) {
+    double v = m->current_ma + m->config.current_noise_ma * gauss(&m->rng);
+    if (v < 0.0) v = 0.0;
+    return (uint16_t)lround(v);
+}
+
+int16_t servo_mech_feedback(servo_mech_t *m) {
+    double v = m->config.fb_offset + m->config.fb_per_deg * m->deg + m->config.fb_noise * gauss(&m->rng);
+    if (v < 0.0) v = 0.0;
+    if (v > 4095.0) v = 4095.0;
+    return (int16_t)lround(v);
+}
+
+double servo_mech_pulse_us(const servo_mech_config_t *config, double deg) {
+    return config->center_us + (deg - 90.0) * config->us_per_deg;
+}
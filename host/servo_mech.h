@@ -0,0 +1,61 @@
+#ifndef SERVO_MECH_H_
+#define SERVO_MECH_H_
+
+#include <stdint.h>
+
+/*
+ * 호스트 벤치마크용 취미 서보 기계/전기 모델 (캘리브레이션 스윕, 응답 측정 검증).
+ *
+ *   - 명령: 펄스 주기(frame_s)마다 그 순간의 펄스 폭을 받아 목표 각도로 (주기 사이에는 이전 명령 유지).
+ *           목표 = 90 + (펄스 - center_us) / us_per_deg. 펄스가 없으면 모터를 끔
+ *   - 내부 제어: 구동 u = 오차 x gain_per_deg (불감대 안은 0, +-1 포화)
+ *   - 모터: 정규화 DC 모터. 속도 w는 시정수 tau_s로 w_max x (u - 부하) 를 따라감 (역기전력 = w / w_max)
+ *   - 링키지 정지점: 각도가 stop_lo_deg ~ stop_hi_deg 밖으로 못 나감 (부딪히면 속도 0)
+ *   - 전류 = idle_ma + stall_ma x |u - w / w_max| (정지점에 막혀 밀면 스톨 전류)
+ *   - 피드백 = 전위차계 ADC (fb_offset + fb_per_deg x 각도, 12비트)
+ * 측정값에는 가우스 잡음이 섞입니다. 같은 seed면 같은 결과가 나옵니다.
+ */
+typedef struct {
+    double center_us;                         // 90도 펄스 폭
+    double us_per_deg;
+    double stop_lo_deg, stop_hi_deg;          // 기계적 정지점
+    double speed_dps;                         // 무부하 최고 속도
+    double tau_s;                             // 모터 기계 시정수
+    double gain_per_deg;                      // 내부 제어 이득 (1 / 포화 오차)
+    double deadband_deg;
+    double load;                              // 일정 부하 (스톨 토크 대비, + = 각도 감소 방향으로 당김)
+    double frame_s;                           // 명령 갱신 주기 (PWM 주기)
+    double idle_ma, stall_ma;
+    double fb_offset, fb_per_deg;
+    double current_noise_ma, fb_noise;
+} servo_mech_config_t;
+
+typedef struct {
+    servo_mech_config_t config;
+    uint32_t rng;
+    double deg, w;                            // 각도, 속도 (도/s)
+    double cmd_deg;
+    double u;
+    int powered;                              // 마지막 프레임에 펄스가 있었는지
+    double frame_t;                           // 현재 프레임 안에서 지난 시간
+    double current_ma;                        // 잡음 없는 전류
+    double stall_s;                           // 정지점에 막혀 민 시간 (|u| > 0.1, 정지점에 닿음)
+    double charge_mas;                        // 누적 전하 (mA s)
+} servo_mech_t;
+
+// 표준 크기 아날로그 서보 (약 0.16 s/60도, 스톨 0.7 A, 10 us/도, 정지점 0 ~ 180도)
+void servo_mech_default_config(servo_mech_config_t *config);
+
+void servo_mech_init(servo_mech_t *m, const servo_mech_config_t *config, double deg, uint32_t seed);
+
+// pulse_ns: 지금 출력 중인 펄스 폭 (0 = 펄스 없음). dt는 내부에서 잘게 나눠 적분
+void servo_mech_step(servo_mech_t *m, uint32_t pulse_ns, double dt);
+
+// 측정 (잡음 포함)
+uint16_t servo_mech_current_ma(servo_mech_t *m);
+int16_t servo_mech_feedback(servo_mech_t *m);
+
+// 각도에 해당하는 펄스 폭 (참값, 벤치에서 오차 계산용)
+double servo_mech_pulse_us(const servo_mech_config_t *config, double deg);
+
+#endif // SERVO_MECH_H_
@@ -0,0 +1,148 @@
+#include "sil_flight.h"
+#include <math.h>
+#include <string.h>
+#include "app_tasks.h"
+#include "hal_sim.h"
+#include "hal_trace.h"
+#include "pico/time.h"
+
+#define MAX_FLIGHT_US 600000000ull
+#define AFTER_LANDING_US 10000000u
+#define HEADING_SETTLE_US 10000000u   // 사출 후 이 시간이 지나야 방위 오차 집계
+#define HEADING_MIN_ALT_M 5.0
+
+static double wrap180(double deg) {
+    while (deg > 180.0) deg -= 360.0;
+    while (deg < -180.0) deg += 360.0;
+    return deg;
+}
+
+// 비행 시작 인터럽트: HAL 리셋 후 설정을 입력으로 받아 비행 제어 초기화 (기록/재생 공용)
+static bool flight_start(flight_ctrl_t *ctrl, const flight_ctrl_config_t *config, float target_override_deg) {
+    hal_sim_reset();
+    hal_sim_use_virtual_time(true);
+    flight_ctrl_config_t c;
+    memset(&c, 0, sizeof(c)); // 패딩까지 같은 바이트로 기록
+    c.steer_left_gpio = config->steer_left_gpio;
+    c.steer_right_gpio = config->steer_right_gpio;
+    c.deploy_gpio = config->deploy_gpio;
+    c.target_heading_deg = config->target_heading_deg;
+    c.target_lat_e7 = config->target_lat_e7;
+    c.target_lon_e7 = config->target_lon_e7;
+    c.guided = config->guided;
+    if (!hal_trace_input(SIL_INPUT_CONFIG, &c, sizeof(c))) return false;
+    if (!isnan(target_override_deg)) c.target_heading_deg = target_override_deg;
+    return flight_ctrl_init(ctrl, &c);
+}
+
+// 제어 주기 인터럽트: 타이머로 시각을 찍은 센서 레코드를 받아 비행 제어 한 주기 (기록/재생 공용)
+static void control_tick(flight_ctrl_t *ctrl, flight_record_t *r) {
+    r->timestamp_us = (uint32_t)time_us_64();
+    hal_trace_input(SIL_INPUT_SENSOR, r, sizeof(*r));
+    flight_ctrl_step(ctrl, r);
+}
+
+// GPS 인터럽트: 수신기 항법 해를 입력으로 받아 비행 제어에 전달 (기록/재생 공용)
+static void gps_tick(flight_ctrl_t *ctrl, guidance_fix_t *fix) {
+    hal_trace_input(SIL_INPUT_GPS, fix, sizeof(*fix));
+    flight_ctrl_gps(ctrl, fix);
+}
+
+bool sil_flight_run(const sil_model_config_t *model_config, const flight_ctrl_config_t *ctrl_config, FILE *trace,
+                    uint32_t index, sil_flight_result_t *res) {
+    hal_trace_irq(SIL_IRQ_FLIGHT_START);
+    flight_ctrl_t ctrl;
+    if (!flight_start(&ctrl, ctrl_config, NAN)) return false;
+    sil_model_t model;
+    sil_model_init(&model, model_config);
+
+    const uint32_t control_steps = APP_CONTROL_PERIOD_MS * 1000u / SIL_PHYSICS_STEP_US;
+    const uint32_t gps_steps = SIL_GPS_PERIOD_US / SIL_PHYSICS_STEP_US;
+    double err_sum = 0.0;
+    uint32_t err_count = 0;
+    uint16_t seq = 0;
+    memset(res, 0, sizeof(*res));
+
+    while (model.t_us < MAX_FLIGHT_US && !(model.landed && model.t_us > model.landed_us + AFTER_LANDING_US)) {
+        sil_model_step(&model, SIL_PHYSICS_STEP_US);
+        hal_sim_advance_us(SIL_PHYSICS_STEP_US);
+        ++res->steps;
+        if (ctrl_config->guided && res->steps % gps_steps == 0) {
+            hal_trace_irq(SIL_IRQ_GPS);
+            guidance_fix_t fix;
+            sil_model_gps(&model, &fix);
+            gps_tick(&ctrl, &fix);
+        }
+        if (res->steps % control_steps != 0) continue;
+
+        hal_trace_irq(SIL_IRQ_CONTROL);
+        flight_record_t r;
+        sil_model_sense(&model, &r, seq++);
+        control_tick(&ctrl, &r);
+
+        double heading = sil_model_heading_deg(&model);
+        if (!ctrl_config->guided && model.deployed && !model.landed &&
+            model.t_us > model.deploy_us + HEADING_SETTLE_US && model.pos[2] > HEADING_MIN_ALT_M) {
+            err_sum += fabs(wrap180(heading - ctrl_config->target_heading_deg));
+            ++err_count;
+        }
+        if (trace) {
+            fprintf(trace, "%u,%.3f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%.1f,%.1f,%.3f,%.1f,%.1f\n", index,
+                    model.t_us * 1e-6, model.pos[0], model.pos[1], model.pos[2], model.vel[2], ctrl.alt_m,
+                    ctrl.vel_mps, (int)ctrl.phase, heading, ctrl.heading_deg, ctrl.steer, model.servo_deg[0],
+                    model.servo_deg[1]);
+        }
+    }
+    hal_trace_irq(SIL_IRQ_FLIGHT_END);
+    flight_ctrl_deinit(&ctrl);
+
+    res->apogee_m = model.apogee_m;
+    res->deploy_alt_m = model.deployed ? model.deploy_alt_m : NAN;
+    res->deploy_s = model.deployed ? (model.deploy_us - model_config->launch_us) * 1e-6 : NAN;
+    res->landed_s = model.landed ? (model.landed_us - model_config->launch_us) * 1e-6 : NAN;
+    res->land_e = model.pos[0];
+    res->land_n = model.pos[1];
+    res->heading_err_deg = err_count ? err_sum / err_count : NAN;
+    res->miss_m = NAN;
+    if (ctrl_config->guided) {
+        double te, tn;
+        sil_model_geo_to_local(model_config, ctrl_config->target_lat_e7, ctrl_config->target_lon_e7, &te, &tn);
+        res->miss_m = hypot(res->land_e - te, res->land_n - tn);
+    }
+    res->phase = ctrl.phase;
+    return true;
+}
+
+bool sil_flight_replay(float target_override_deg, uint32_t *flights, uint32_t *ticks) {
+    flight_ctrl_t ctrl;
+    bool active = false;
+    uint8_t irq;
+    *flights = 0;
+    *ticks = 0;
+    while (hal_trace_next_irq(&irq)) {
+        if (irq == SIL_IRQ_FLIGHT_START) {
+            const flight_ctrl_config_t unused = {0}; // 트레이스 값으로 덮어씀
+            active = flight_start(&ctrl, &unused, target_override_deg);
+            if (!active) break;
+            ++*flights;
+        } else if (irq == SIL_IRQ_CONTROL && active) {
+            flight_record_t r;
+            control_tick(&ctrl, &r);
+            ++*ticks;
+        } else if (irq == SIL_IRQ_GPS && active) {
+            guidance_fix_t fix;
+            gps_tick(&ctrl, &fix);
+        } else if (irq == SIL_IRQ_FLIGHT_END && active) {
+            flight_ctrl_deinit(&ctrl);
+            active = false;
+        } else {
+            break;
+        }
+    }
+    if (active) flight_ctrl_deinit(&ctrl);
+    return hal_trace_replay_stop();
+}
+
+bool sil_flight_ok(const sil_flight_result_t *res) {
+    return res->phase == FLIGHT_PHASE_LANDED && !isnan(res->deploy_alt_m);
+}
@@ -0,0 +1,74 @@
+#ifndef SIL_FLIGHT_H_
+#define SIL_FLIGHT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "flight_ctrl.h"
+#include "sil_model.h"
+
+/*
+ * SIL 비행 한 번 실행 (sil_sim / sil_mc 공용).
+ *
+ * hal_sim과 servo.c는 프로세스 전역 상태를 쓰므로 한 프로세스에서 동시에 비행 하나만
+ * 실행할 수 있습니다. 병렬 실행은 프로세스 단위로 나눕니다 (sil_mc).
+ *
+ * 펌웨어 쪽 입력은 HAL 트레이스(hal_trace.h)를 거칩니다: 비행 시작/제어 주기/비행 끝을 인터럽트로,
+ * 비행 제어 설정과 센서 레코드를 입력 바이트로, 레코드 시각은 time_us_64()로 받습니다.
+ * 기록 모드에서 sil_flight_run()을 돌리면 sil_flight_replay()가 기체 모델 없이 같은 실행을 재현합니다.
+ */
+
+#define SIL_PHYSICS_STEP_US 1000u
+#define SIL_GPS_PERIOD_US 200000u     // GPS 해 5 Hz (guided 설정일 때만)
+
+// 트레이스 인터럽트 번호 / 입력 소스
+#define SIL_IRQ_FLIGHT_START 0
+#define SIL_IRQ_CONTROL 1
+#define SIL_IRQ_FLIGHT_END 2
+#define SIL_IRQ_GPS 3
+#define SIL_INPUT_CONFIG 0
+#define SIL_INPUT_SENSOR 1
+#define SIL_INPUT_GPS 2
+
+typedef struct {
+    uint64_t steps;               // 물리 스텝 수
+    double apogee_m, deploy_alt_m, deploy_s, landed_s;
+    double land_e, land_n;        // 착지 위치 (발사대 기준, m)
+    double heading_err_deg;       // 하강 안정 구간 평균 |방위 오차| (guided가 아닐 때)
+    double miss_m;                // 착지 목표점과의 거리 (guided일 때)
+    flight_phase_t phase;         // 종료 시 펌웨어 단계
+} sil_flight_result_t;
+
+/**
+ * @brief HAL을 리셋하고 비행 하나를 착지 후까지 (또는 시간 제한까지) 실행합니다.
+ *
+ * @param trace NULL이 아니면 제어 주기마다 CSV 한 줄 (열 이름은 SIL_FLIGHT_TRACE_HEADER).
+ * @param index trace의 flight 열 값.
+ * @return flight_ctrl_init 실패 시 false.
+ */
+bool sil_flight_run(const sil_model_config_t *model_config, const flight_ctrl_config_t *ctrl_config, FILE *trace,
+                    uint32_t index, sil_flight_result_t *res);
+
+/**
+ * @brief 재생 중인 HAL 트레이스(hal_trace_replay_start)로 비행 제어를 다시 실행합니다.
+ *
+ * 기체 모델 없이 트레이스의 인터럽트 순서대로 핸들러를 호출합니다. 펌웨어의 PWM 출력이 기록과
+ * 다르면 hal_trace가 그 지점에서 어긋남을 기록하고 재생이 멈춥니다.
+ *
+ * @param target_override_deg NaN이 아니면 기록된 목표 방위 대신 사용 (수정한 펌웨어 흉내).
+ * @param flights 재생한 비행 수.
+ * @param ticks 재생한 제어 주기 수.
+ * @return 어긋남 없이 트레이스 끝까지 재생했으면 true (hal_trace_replay_stop 결과 포함).
+ */
+bool sil_flight_replay(float target_override_deg, uint32_t *flights, uint32_t *ticks);
+
+/**
+ * @brief 정상 비행 여부 (사출 후 펌웨어가 LANDED 단계에 도달).
+ */
+bool sil_flight_ok(const sil_flight_result_t *res);
+
+#define SIL_FLIGHT_TRACE_HEADER                                                                             \
+    "flight,t_s,east_m,north_m,alt_m,vz_mps,est_alt_m,est_vel_mps,phase,heading_deg,est_heading_deg,steer," \
+    "servo_left_deg,servo_right_deg\n"
+
+#endif // SIL_FLIGHT_H_
@@ -0,0 +1,240 @@
+// SIL 몬테카를로 비행 캠페인
+//
+// 비행마다 바람(세기/방향), 초기 방위, 센서 잡음 크기, 서보 장착 오차/기울기를 무작위로 바꿔
+// SIL 비행(sil_flight)을 여러 번 실행하고 사출/착지 통계를 냅니다.
+//
+// hal_sim과 servo.c의 상태가 프로세스 전역이므로 워커는 fork()한 프로세스입니다. 비행 번호는
+// 공유 메모리의 원자 카운터로 나눠 가지고, 결과도 공유 메모리의 비행 번호 자리에 씁니다.
+// 비행 i의 무작위 값은 (seed, i)로만 정해지므로 워커 수와 관계없이 결과가 같습니다.
+//
+// 사용법: sil_mc [-n flights] [-j workers] [-s seed] [-t target_heading] [-b]
+//   -b : 워커 1, 2, 4, ... , j 개로 같은 캠페인을 반복해 처리량 확장성 측정
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sil_flight.h"
+
+#define MAX_WIND_MPS 8.0
+#define NOISE_SCALE_MIN 0.5
+#define NOISE_SCALE_MAX 2.0
+#define SERVO_TRIM_DEG 5.0
+#define SERVO_SCALE_ERR 0.1
+
+typedef struct {
+    atomic_uint next;
+    sil_flight_result_t results[];
+} campaign_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// splitmix64: 비행마다 독립적인 난수열
+static uint64_t splitmix(uint64_t *s) {
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static double uniform(uint64_t *s, double lo, double hi) {
+    return lo + (hi - lo) * (double)(splitmix(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void make_flight(uint64_t seed, uint32_t index, const flight_ctrl_config_t *ctrl, sil_model_config_t *m) {
+    uint64_t s = seed * 0x100000001B3ull ^ index;
+    sil_model_config_default(m, ctrl->steer_left_gpio, ctrl->steer_right_gpio, ctrl->deploy_gpio);
+    double wind = uniform(&s, 0.0, MAX_WIND_MPS), dir = uniform(&s, 0.0, 2.0 * M_PI);
+    m->wind_e = wind * sin(dir);
+    m->wind_n = wind * cos(dir);
+    m->yaw0_deg = uniform(&s, 0.0, 360.0);
+    m->noise_scale = uniform(&s, NOISE_SCALE_MIN, NOISE_SCALE_MAX);
+    for (int i = 0; i < 3; ++i) {
+        m->servo_trim_deg[i] = uniform(&s, -SERVO_TRIM_DEG, SERVO_TRIM_DEG);
+        m->servo_scale[i] = uniform(&s, 1.0 - SERVO_SCALE_ERR, 1.0 + SERVO_SCALE_ERR);
+    }
+    m->seed = (uint32_t)splitmix(&s) | 1u;
+}
+
+static void worker(campaign_t *c, uint32_t flights, uint64_t seed, const flight_ctrl_config_t *ctrl) {
+    for (uint32_t i; (i = atomic_fetch_add(&c->next, 1u)) < flights;) {
+        sil_model_config_t m;
+        make_flight(seed, i, ctrl, &m);
+        if (!sil_flight_run(&m, ctrl, NULL, i, &c->results[i])) c->results[i].phase = FLIGHT_PHASE_PAD;
+    }
+}
+
+// 워커 프로세스 workers개로 캠페인 실행, 걸린 시간(ns) 반환 (실패 시 0)
+static uint64_t run_campaign(campaign_t *c, uint32_t flights, uint32_t workers, uint64_t seed,
+                             const flight_ctrl_config_t *ctrl) {
+    atomic_store(&c->next, 0u);
+    memset(c->results, 0, flights * sizeof(c->results[0]));
+    uint64_t t0 = now_ns();
+    bool ok = true;
+    uint32_t started = 0;
+    for (; started < workers; ++started) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            // 이미 시작한 워커는 남은 비행을 받지 못하게 하고, 진행 중인 비행이 끝날 때까지 기다림
+            // (공유 매핑을 다음 캠페인이 다시 쓰기 전에 모두 회수)
+            atomic_store(&c->next, flights);
+            ok = false;
+            break;
+        }
+        if (pid == 0) {
+            worker(c, flights, seed, ctrl);
+            _exit(0);
+        }
+    }
+    for (uint32_t w = 0; w < started; ++w) {
+        int status;
+        if (wait(&status) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = false;
+    }
+    return ok ? now_ns() - t0 : 0;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// 값 배열 정렬 후 평균 / 중앙값 / p90 / 최대 출력 (NaN은 제외)
+static void print_stat(const char *label, double *v, uint32_t n, const char *unit) {
+    uint32_t k = 0;
+    double sum = 0.0;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!isnan(v[i])) {
+            v[k++] = v[i];
+            sum += v[i];
+        }
+    }
+    if (k == 0) {
+        printf("  %-26s (no data)\n", label);
+        return;
+    }
+    qsort(v, k, sizeof(double), cmp_double);
+    printf("  %-26s mean %7.2f  min %7.2f  p50 %7.2f  p90 %7.2f  max %7.2f %s\n", label, sum / k, v[0], v[k / 2],
+           v[(uint32_t)(0.9 * (k - 1))], v[k - 1], unit);
+}
+
+static void report(const campaign_t *c, uint32_t flights) {
+    double *v = malloc(flights * sizeof(double));
+    if (!v) return;
+    uint32_t ok = 0;
+    uint64_t steps = 0;
+    for (uint32_t i = 0; i < flights; ++i) {
+        ok += sil_flight_ok(&c->results[i]);
+        steps += c->results[i].steps;
+    }
+    printf("landed normally: %u / %u (%.1f%%), %.0f s simulated\n", ok, flights, 100.0 * ok / flights, steps * 1e-3);
+
+#define STAT(label, unit, expr)                                                            \
+    do {                                                                                   \
+        for (uint32_t i = 0; i < flights; ++i) {                                           \
+            const sil_flight_result_t *r = &c->results[i];                                 \
+            v[i] = (expr);                                                                 \
+        }                                                                                  \
+        print_stat(label, v, flights, unit);                                               \
+    } while (0)
+
+    STAT("apogee", "m", r->apogee_m);
+    STAT("deploy below apogee", "m", r->apogee_m - r->deploy_alt_m);
+    STAT("deploy after launch", "s", r->deploy_s);
+    STAT("descent time", "s", r->landed_s - r->deploy_s);
+    STAT("landing distance from pad", "m", hypot(r->land_e, r->land_n));
+    STAT("|heading error| in descent", "deg", r->heading_err_deg);
+#undef STAT
+    free(v);
+}
+
+int main(int argc, char **argv) {
+    uint32_t flights = 1000;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t workers = cores > 0 ? (uint32_t)cores : 1u;
+    uint64_t seed = 1;
+    double target = 90.0;
+    bool bench = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-b") == 0) {
+            bench = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            fprintf(stderr, "usage: %s [-n flights] [-j workers] [-s seed] [-t target_heading] [-b]\n", argv[0]);
+            return 2;
+        }
+        if (strcmp(argv[i], "-n") == 0) flights = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-j") == 0) workers = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0) seed = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-t") == 0) target = strtod(argv[++i], NULL);
+        else {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (flights == 0) flights = 1;
+    if (workers == 0) workers = 1;
+
+    size_t bytes = sizeof(campaign_t) + flights * sizeof(sil_flight_result_t);
+    campaign_t *c = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (c == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    const flight_ctrl_config_t ctrl = {
+        .steer_left_gpio = 16, .steer_right_gpio = 17, .deploy_gpio = 18,
+        .target_heading_deg = (float)target,
+    };
+    printf("Monte Carlo: %u flights, seed %llu, wind 0-%.0f m/s, noise x%.1f-%.1f, servo trim +-%.0f deg / scale "
+           "+-%.0f%%, %ld online cores\n",
+           flights, (unsigned long long)seed, MAX_WIND_MPS, NOISE_SCALE_MIN, NOISE_SCALE_MAX, SERVO_TRIM_DEG,
+           SERVO_SCALE_ERR * 100.0, cores);
+
+    if (!bench) {
+        uint64_t ns = run_campaign(c, flights, workers, seed, &ctrl);
+        if (ns == 0) return 1;
+        report(c, flights);
+        printf("%u workers: %.2f s, %.0f flights/s\n", workers, ns * 1e-9, flights / (ns * 1e-9));
+        return 0;
+    }
+
+    // --- 확장성: 워커 수별 처리량, 결과는 워커 1개와 비트 단위로 같아야 함 ---
+    sil_flight_result_t *reference = malloc(flights * sizeof(sil_flight_result_t));
+    if (!reference) return 1;
+    double base = 0.0;
+    int mismatches = 0;
+    for (uint32_t w = 1;; w = w * 2 < workers ? w * 2 : workers) {
+        uint64_t ns = run_campaign(c, flights, w, seed, &ctrl);
+        if (ns == 0) return 1;
+        uint64_t steps = 0;
+        for (uint32_t i = 0; i < flights; ++i) steps += c->results[i].steps;
+        double rate = flights / (ns * 1e-9);
+        bool same = true;
+        if (w == 1) {
+            base = rate;
+            memcpy(reference, c->results, flights * sizeof(sil_flight_result_t));
+            report(c, flights);
+        } else {
+            same = memcmp(reference, c->results, flights * sizeof(sil_flight_result_t)) == 0;
+            mismatches += !same;
+        }
+        printf("  workers %3u  %8.2f s  %8.0f flights/s  %6.2f Msteps/s  speedup %.2fx  %s\n", w, ns * 1e-9, rate,
+               steps / (ns * 1e-3), rate / base, same ? "identical" : "MISMATCH");
+        if (w >= workers) break;
+    }
+    free(reference);
+    munmap(c, bytes);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,255 @@
+#include "sil_model.h"
+#include <math.h>
+#include <string.h>
+#include "hal_sim.h"
+#include "hardware/pwm.h"
+#include "units.h"
+
+// --- 기체 / 환경 상수 ---
+#define MASS_KG 0.35
+#define AIR_DENSITY 1.225
+#define THRUST_NET_G 7.5              // 모터 연소 중 알짜 가속도
+#define BURN_US 1500000u
+#define BODY_CDA_M2 0.002             // 낙하산 개방 전 동체
+#define CHUTE_CDA_M2 0.156            // 종단 속도 약 6 m/s
+#define CHUTE_INFLATE_US 500000u
+#define CHUTE_ARM_M 0.3               // 무게 중심에서 낙하산 연결점까지 (기체 +z)
+#define GLIDE_RATIO 0.35              // 활공 힘 / 동압 x CdA (기체 x축 수평 성분 방향)
+#define STEER_MOMENT_NM 0.003         // 최대 차동에서의 요 모멘트 (기준 대기 속도 6 m/s)
+#define SERVO_RATE_DPS 600.0
+static const double INERTIA[3] = {0.004, 0.004, 0.0015};  // kg m^2
+static const double DAMPING[3] = {0.02, 0.02, 0.004};     // N m s / rad
+static const double MAG_WORLD[3] = {0.0, 300.0, -400.0};  // 북쪽 + 아래 성분 (LSB)
+#define ORIGIN_LAT_E7 375665000       // 기본 발사대 위치
+#define ORIGIN_LON_E7 1269780000
+#define M_PER_DEG_LAT 111319.49       // WGS84 적도 반지름 기준
+#define GPS_POS_NOISE_E7 45           // 약 0.5 m
+#define GPS_VEL_NOISE_CMS 5
+
+// --- 내부 함수 ---
+
+// xorshift32, 균등 분포 두 개의 평균 (삼각 분포)
+static int32_t noise_from(uint32_t *rng, double scale, int32_t amplitude) {
+    amplitude = (int32_t)lround(amplitude * scale);
+    int32_t sum = 0;
+    for (int k = 0; k < 2; ++k) {
+        *rng ^= *rng << 13;
+        *rng ^= *rng >> 17;
+        *rng ^= *rng << 5;
+        sum += (int32_t)(*rng % (uint32_t)(2 * amplitude + 1)) - amplitude;
+    }
+    return sum / 2;
+}
+
+static int32_t noise(sil_model_t *m, int32_t amplitude) {
+    return noise_from(&m->rng, m->config.noise_scale, amplitude);
+}
+
+static double m_per_deg_lon(const sil_model_config_t *config) {
+    return M_PER_DEG_LAT * cos(config->origin_lat_e7 * 1e-7 * M_PI / 180.0);
+}
+
+// v_world = q * v_body * q^-1
+static void rotate(const double q[4], const double v[3], double out[3]) {
+    double w = q[0], x = q[1], y = q[2], z = q[3];
+    out[0] = (1 - 2 * (y * y + z * z)) * v[0] + 2 * (x * y - w * z) * v[1] + 2 * (x * z + w * y) * v[2];
+    out[1] = 2 * (x * y + w * z) * v[0] + (1 - 2 * (x * x + z * z)) * v[1] + 2 * (y * z - w * x) * v[2];
+    out[2] = 2 * (x * z - w * y) * v[0] + 2 * (y * z + w * x) * v[1] + (1 - 2 * (x * x + y * y)) * v[2];
+}
+
+static void rotate_inv(const double q[4], const double v[3], double out[3]) {
+    const double qc[4] = {q[0], -q[1], -q[2], -q[3]};
+    rotate(qc, v, out);
+}
+
+static void cross(const double a[3], const double b[3], double out[3]) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static int16_t saturate(double v) {
+    return (int16_t)lround(v > 32767.0 ? 32767.0 : (v < -32768.0 ? -32768.0 : v));
+}
+
+// PWM 펄스 폭 -> 서보 각도 (1000~2000 us = 0~180도), 출력이 없으면 이전 각도 유지
+static void update_servo(sil_model_t *m, int i, uint16_t gpio, double dt) {
+    uint32_t ns = hal_sim_pwm_pulse_ns(gpio);
+    if (ns == 0) return;
+    double target = ((double)ns * 1e-3 - 1000.0) * 0.18;
+    target = 90.0 + (target - 90.0) * m->config.servo_scale[i] + m->config.servo_trim_deg[i];
+    target = target < 0.0 ? 0.0 : (target > 180.0 ? 180.0 : target);
+    double step = SERVO_RATE_DPS * dt, d = target - m->servo_deg[i];
+    m->servo_deg[i] += d > step ? step : (d < -step ? -step : d);
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void sil_model_config_default(sil_model_config_t *config, uint16_t steer_left_gpio, uint16_t steer_right_gpio,
+                              uint16_t deploy_gpio) {
+    memset(config, 0, sizeof(*config));
+    config->launch_us = 2000000u;
+    config->seed = 1;
+    config->noise_scale = 1.0;
+    for (int i = 0; i < 3; ++i) config->servo_scale[i] = 1.0;
+    config->steer_left_gpio = steer_left_gpio;
+    config->steer_right_gpio = steer_right_gpio;
+    config->deploy_gpio = deploy_gpio;
+    config->origin_lat_e7 = ORIGIN_LAT_E7;
+    config->origin_lon_e7 = ORIGIN_LON_E7;
+}
+
+void sil_model_init(sil_model_t *m, const sil_model_config_t *config) {
+    memset(m, 0, sizeof(*m));
+    m->config = *config;
+    m->rng = config->seed ? config->seed : 0x12345678u;
+    m->gps_rng = m->rng ^ 0x9E3779B9u;
+    if (!m->gps_rng) m->gps_rng = 1;
+    // 기체 x축이 yaw0 방향을 보도록 세계 z축 기준 (90 - yaw0)도 회전
+    double half = (90.0 - config->yaw0_deg) * M_PI / 360.0;
+    m->q[0] = cos(half);
+    m->q[3] = sin(half);
+    m->servo_deg[0] = m->servo_deg[1] = 90.0;
+    m->specific_force[2] = UNITS_STANDARD_GRAVITY;
+}
+
+void sil_model_step(sil_model_t *m, uint32_t dt_us) {
+    const double dt = dt_us * 1e-6;
+    m->t_us += dt_us;
+    update_servo(m, 0, m->config.steer_left_gpio, dt);
+    update_servo(m, 1, m->config.steer_right_gpio, dt);
+    update_servo(m, 2, m->config.deploy_gpio, dt);
+
+    // 발사대 / 착지 후: 정지 (비력 = 중력 반작용)
+    if (m->t_us < m->config.launch_us || m->landed) {
+        m->specific_force[0] = m->specific_force[1] = 0.0;
+        m->specific_force[2] = UNITS_STANDARD_GRAVITY;
+        return;
+    }
+    uint64_t since_launch = m->t_us - m->config.launch_us;
+    if (!m->deployed && m->servo_deg[2] > 90.0) {
+        m->deployed = true;
+        m->deploy_us = m->t_us;
+        m->deploy_alt_m = m->pos[2];
+    }
+
+    // --- 힘 (세계 좌표, 중력 제외) ---
+    const double up[3] = {0.0, 0.0, 1.0}, fwd[3] = {1.0, 0.0, 0.0};
+    double axis[3], heading[3];
+    rotate(m->q, up, axis);
+    rotate(m->q, fwd, heading);
+    double air[3] = {m->vel[0] - m->config.wind_e, m->vel[1] - m->config.wind_n, m->vel[2]};
+    double speed = sqrt(air[0] * air[0] + air[1] * air[1] + air[2] * air[2]);
+
+    double force[3], body_q = 0.5 * AIR_DENSITY * BODY_CDA_M2 * speed;
+    for (int a = 0; a < 3; ++a) force[a] = -body_q * air[a];
+    if (since_launch < BURN_US) {
+        for (int a = 0; a < 3; ++a) force[a] += axis[a] * MASS_KG * (THRUST_NET_G + 1.0) * UNITS_STANDARD_GRAVITY;
+    }
+
+    double torque[3] = {0.0, 0.0, 0.0};
+    if (m->deployed) {
+        double inflate = (double)(m->t_us - m->deploy_us) / CHUTE_INFLATE_US;
+        if (inflate > 1.0) inflate = 1.0;
+        double cda = CHUTE_CDA_M2 * inflate;
+        double chute[3];
+        for (int a = 0; a < 3; ++a) chute[a] = -0.5 * AIR_DENSITY * cda * speed * air[a];
+        double hn = sqrt(heading[0] * heading[0] + heading[1] * heading[1]);
+        if (hn > 1e-6) {
+            double glide = 0.5 * AIR_DENSITY * cda * speed * speed * GLIDE_RATIO / hn;
+            chute[0] += glide * heading[0];
+            chute[1] += glide * heading[1];
+        }
+        for (int a = 0; a < 3; ++a) force[a] += chute[a];
+
+        // 연결점에 걸린 낙하산 힘 -> 진자 복원 모멘트, 차동 브레이크 -> 요 모멘트
+        double arm[3] = {axis[0] * CHUTE_ARM_M, axis[1] * CHUTE_ARM_M, axis[2] * CHUTE_ARM_M}, tw[3];
+        cross(arm, chute, tw);
+        rotate_inv(m->q, tw, torque);
+        double airspeed = speed / 6.0;
+        torque[2] += STEER_MOMENT_NM * inflate * (m->servo_deg[0] - m->servo_deg[1]) / 120.0 * airspeed * airspeed;
+    }
+
+    // --- 병진 ---
+    for (int a = 0; a < 3; ++a) {
+        m->specific_force[a] = force[a] / MASS_KG;
+        m->vel[a] += m->specific_force[a] * dt;
+    }
+    m->vel[2] -= UNITS_STANDARD_GRAVITY * dt;
+    for (int a = 0; a < 3; ++a) m->pos[a] += m->vel[a] * dt;
+    if (m->pos[2] > m->apogee_m) m->apogee_m = m->pos[2];
+
+    // --- 회전 (개방 전에는 핀 안정으로 수직 유지) ---
+    if (m->deployed) {
+        double iw[3] = {INERTIA[0] * m->rate[0], INERTIA[1] * m->rate[1], INERTIA[2] * m->rate[2]}, gyro[3];
+        cross(m->rate, iw, gyro);
+        for (int a = 0; a < 3; ++a) {
+            m->rate[a] += (torque[a] - DAMPING[a] * m->rate[a] - gyro[a]) / INERTIA[a] * dt;
+        }
+        double w = m->q[0], x = m->q[1], y = m->q[2], z = m->q[3];
+        double p = m->rate[0] * 0.5 * dt, q = m->rate[1] * 0.5 * dt, r = m->rate[2] * 0.5 * dt;
+        m->q[0] = w - x * p - y * q - z * r;
+        m->q[1] = x + w * p + y * r - z * q;
+        m->q[2] = y + w * q - x * r + z * p;
+        m->q[3] = z + w * r + x * q - y * p;
+        double norm = sqrt(m->q[0] * m->q[0] + m->q[1] * m->q[1] + m->q[2] * m->q[2] + m->q[3] * m->q[3]);
+        for (int a = 0; a < 4; ++a) m->q[a] /= norm;
+    }
+
+    if (m->pos[2] <= 0.0 && since_launch > BURN_US) {
+        m->pos[2] = 0.0;
+        memset(m->vel, 0, sizeof(m->vel));
+        memset(m->rate, 0, sizeof(m->rate));
+        m->landed = true;
+        m->landed_us = m->t_us;
+    }
+}
+
+void sil_model_sense(sil_model_t *m, flight_record_t *r, uint16_t seq) {
+    double f[3], mag[3];
+    rotate_inv(m->q, m->specific_force, f);
+    rotate_inv(m->q, MAG_WORLD, mag);
+    r->timestamp_us = (uint32_t)m->t_us;
+    double pressure = UNITS_SEA_LEVEL_PA * pow(1.0 - m->pos[2] / UNITS_BARO_SCALE_M, 1.0 / UNITS_BARO_EXPONENT);
+    r->pressure_pa = (int32_t)lround(pressure) + noise(m, 4);
+    for (int a = 0; a < 3; ++a) {
+        r->accel[a] = saturate(f[a] / UNITS_STANDARD_GRAVITY * UNITS_ACCEL_LSB_PER_G + noise(m, 12));
+        r->gyro[a] = saturate(m->rate[a] * (180.0 / M_PI) * UNITS_GYRO_LSB_PER_DPS + noise(m, 6));
+        r->mag[a] = saturate(mag[a] + noise(m, 3));
+    }
+    const uint16_t gpios[2] = {m->config.steer_left_gpio, m->config.steer_right_gpio};
+    for (int i = 0; i < 2; ++i) {
+        const hal_sim_pwm_slice_t *s = hal_sim_pwm_slice(pwm_gpio_to_slice_num(gpios[i]));
+        r->servo_level[i] = s ? s->cc[pwm_gpio_to_channel(gpios[i])] : 0;
+    }
+    r->seq = seq;
+}
+
+void sil_model_gps(sil_model_t *m, guidance_fix_t *fix) {
+    const double scale = m->config.noise_scale;
+    sil_model_local_to_geo(&m->config, m->pos[0], m->pos[1], &fix->lat_e7, &fix->lon_e7);
+    fix->lat_e7 += noise_from(&m->gps_rng, scale, GPS_POS_NOISE_E7);
+    fix->lon_e7 += noise_from(&m->gps_rng, scale, GPS_POS_NOISE_E7);
+    fix->vel_n_cms = (int32_t)lround(m->vel[1] * 100.0) + noise_from(&m->gps_rng, scale, GPS_VEL_NOISE_CMS);
+    fix->vel_e_cms = (int32_t)lround(m->vel[0] * 100.0) + noise_from(&m->gps_rng, scale, GPS_VEL_NOISE_CMS);
+}
+
+void sil_model_local_to_geo(const sil_model_config_t *config, double east_m, double north_m, int32_t *lat_e7,
+                            int32_t *lon_e7) {
+    *lat_e7 = config->origin_lat_e7 + (int32_t)lround(north_m / M_PER_DEG_LAT * 1e7);
+    *lon_e7 = config->origin_lon_e7 + (int32_t)lround(east_m / m_per_deg_lon(config) * 1e7);
+}
+
+void sil_model_geo_to_local(const sil_model_config_t *config, int32_t lat_e7, int32_t lon_e7, double *east_m,
+                            double *north_m) {
+    *north_m = (lat_e7 - config->origin_lat_e7) * 1e-7 * M_PER_DEG_LAT;
+    *east_m = (lon_e7 - config->origin_lon_e7) * 1e-7 * m_per_deg_lon(config);
+}
+
+double sil_model_heading_deg(const sil_model_t *m) {
+    const double fwd[3] = {1.0, 0.0, 0.0};
+    double h[3];
+    rotate(m->q, fwd, h);
+    double deg = atan2(h[0], h[1]) * (180.0 / M_PI);
+    return deg < 0.0 ? deg + 360.0 : deg;
+}
@@ -0,0 +1,93 @@
+#ifndef SIL_MODEL_H_
+#define SIL_MODEL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "flight_record.h"
+#include "guidance.h"
+
+/*
+ * SIL 시뮬레이터용 6자유도 기체 모델 (host/sil_sim).
+ *
+ * 좌표계: 세계 = ENU (x 동, y 북, z 위), 기체 = z축이 로켓 축(위), x축이 낙하산 활공 방향.
+ * 자세는 기체 -> 세계 쿼터니언. 모터 연소 -> 관성 상승 -> 사출 서보가 열리면 낙하산 개방
+ * (0.5 s 동안 팽창) -> 진자 운동을 하며 하강 -> 착지.
+ *
+ * 서보 입력은 hal_sim의 PWM 슬라이스에서 펄스 폭으로 읽고(펌웨어가 낸 그대로), 센서 출력은
+ * 펌웨어 센서 드라이버가 만들 원시값(flight_record_t)으로 냅니다.
+ */
+
+typedef struct {
+    uint64_t launch_us;           // 발사 시각 (그 전에는 발사대)
+    double wind_e, wind_n;        // 일정한 바람 (m/s)
+    double yaw0_deg;              // 초기 방위 (0 = 북, 시계 방향)
+    uint32_t seed;                // 센서 잡음
+    double noise_scale;           // 센서 잡음 진폭 배율 (1 = 기본)
+    double servo_trim_deg[3];     // 서보 장착 오차 (왼쪽, 오른쪽, 사출): 실제 각도 - 펄스 폭 각도
+    double servo_scale[3];        // 펄스 폭 -> 각도 기울기 배율 (중립 90도 기준, 1 = 기본)
+    uint16_t steer_left_gpio, steer_right_gpio, deploy_gpio;
+    int32_t origin_lat_e7, origin_lon_e7; // 발사대 위치 (GPS 출력 기준)
+} sil_model_config_t;
+
+typedef struct {
+    sil_model_config_t config;
+    uint64_t t_us;
+    double pos[3], vel[3];        // 세계 좌표
+    double q[4];                  // 기체 -> 세계 (w, x, y, z)
+    double rate[3];               // 기체 각속도 (rad/s)
+    double servo_deg[3];          // 서보 실제 각도 (왼쪽, 오른쪽, 사출), 속도 제한
+    double specific_force[3];     // 마지막 스텝의 비력 (세계 좌표, m/s^2)
+    bool deployed;
+    uint64_t deploy_us;
+    double deploy_alt_m;
+    double apogee_m;
+    bool landed;
+    uint64_t landed_us;
+    uint32_t rng;
+    uint32_t gps_rng;             // GPS 잡음 (센서 잡음 순서와 독립)
+} sil_model_t;
+
+/**
+ * @brief 기본 설정 (발사 2 s, 바람 없음, 잡음/서보 보정 기본값)을 채웁니다.
+ */
+void sil_model_config_default(sil_model_config_t *config, uint16_t steer_left_gpio, uint16_t steer_right_gpio,
+                              uint16_t deploy_gpio);
+
+/**
+ * @brief 발사대 위 정지 상태로 모델을 초기화합니다.
+ */
+void sil_model_init(sil_model_t *m, const sil_model_config_t *config);
+
+/**
+ * @brief 물리 한 스텝을 진행합니다. 서보 명령은 이 시점의 PWM 출력에서 읽습니다.
+ *
+ * @param dt_us 스텝 길이 (1000 us 권장).
+ */
+void sil_model_step(sil_model_t *m, uint32_t dt_us);
+
+/**
+ * @brief 현재 상태의 센서 원시값을 만듭니다 (잡음 포함).
+ *
+ * @param seq 레코드 순번.
+ */
+void sil_model_sense(sil_model_t *m, flight_record_t *r, uint16_t seq);
+
+/**
+ * @brief 현재 상태의 GPS 항법 해를 만듭니다 (위치/속도 잡음 포함).
+ */
+void sil_model_gps(sil_model_t *m, guidance_fix_t *fix);
+
+/**
+ * @brief 발사대 기준 지역 좌표 (m, 동/북) <-> 위도/경도 (1e-7 도).
+ */
+void sil_model_local_to_geo(const sil_model_config_t *config, double east_m, double north_m, int32_t *lat_e7,
+                            int32_t *lon_e7);
+void sil_model_geo_to_local(const sil_model_config_t *config, int32_t lat_e7, int32_t lon_e7, double *east_m,
+                            double *north_m);
+
+/**
+ * @brief 기체 x축의 방위 (도, 0 = 북, 시계 방향, 0..360).
+ */
+double sil_model_heading_deg(const sil_model_t *m);
+
+#endif // SIL_MODEL_H_
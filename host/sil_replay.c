@@ -0,0 +1,62 @@
+// HAL 트레이스 재생 도구
+//
+// sil_sim -r 로 기록한 트레이스를 기체 모델 없이 펌웨어 비행 제어에 다시 넣고, 펌웨어 PWM 출력이
+// 기록과 같은지 확인합니다. 다르면 처음 어긋난 이벤트 위치를 출력합니다 (펌웨어를 수정한 뒤 같은
+// 입력에 대한 동작 변화를 찾을 때).
+//
+// 사용법: sil_replay <hal_trace.bin> [-t target_heading]
+//   -t : 기록된 목표 방위 대신 사용
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hal_trace.h"
+#include "sil_flight.h"
+
+static const char *const EVENT_NAMES[HAL_TRACE_EV_COUNT] = {"end", "time", "gpio", "input", "irq", "pwm"};
+
+int main(int argc, char **argv) {
+    if (argc < 2 || (argc != 2 && !(argc == 4 && strcmp(argv[2], "-t") == 0))) {
+        fprintf(stderr, "usage: %s <hal_trace.bin> [-t target_heading]\n", argv[0]);
+        return 2;
+    }
+    float target = argc == 4 ? strtof(argv[3], NULL) : NAN;
+
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    uint8_t *data = size > 0 ? malloc((size_t)size) : NULL;
+    if (!data || fread(data, 1, (size_t)size, in) != (size_t)size) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    fclose(in);
+
+    if (!hal_trace_replay_start(data, (size_t)size)) {
+        fprintf(stderr, "%s is not a HAL trace\n", argv[1]);
+        return 1;
+    }
+    uint32_t flights, ticks;
+    bool ok = sil_flight_replay(target, &flights, &ticks);
+    hal_trace_stats_t stats;
+    hal_trace_get_stats(&stats);
+
+    printf("%s: %ld bytes, %u flights, %u control ticks replayed\n", argv[1], size, flights, ticks);
+    for (int e = 1; e < HAL_TRACE_EV_COUNT; ++e) {
+        printf("  %-6s %9u events %10llu bytes\n", EVENT_NAMES[e], stats.events[e], (unsigned long long)stats.bytes[e]);
+    }
+    if (ok) {
+        printf("replay matched the recording\n");
+    } else {
+        printf("replay DIVERGED: %s\n", hal_trace_error() ? hal_trace_error() : "unexpected interrupt");
+    }
+    free(data);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// SIL(software-in-the-loop) 비행 시뮬레이터
+//
+// 펌웨어 비행 제어 코드(src/flight_ctrl.c)와 서보 드라이버(src/servo.c)를 수정 없이 링크하고,
+// 6자유도 기체 모델(sil_model)과 1 ms 물리 스텝으로 맞물려 돌립니다.
+//   - 시간: hal_sim 가상 시간 (물리 스텝마다 전진, 실시간보다 빠르게)
+//   - 센서: 제어 주기(APP_CONTROL_PERIOD_MS)마다 모델이 만든 원시값을 flight_ctrl_step()에 전달
+//   - 서보: 펌웨어가 설정한 PWM 슬라이스 레지스터를 펄스 폭으로 읽어 모델에 입력
+// 비행마다 초기 방위/잡음 seed를 바꿔 최고 고도, 사출 고도, 착지 시각/위치, 하강 중 방위 오차를
+// 출력하고 마지막에 시뮬레이션 속도(스텝/초, 실시간 대비 배수)를 출력합니다.
+//
+// 사용법: sil_sim [-n flights] [-w wind_e,wind_n] [-t target_heading] [-g east,north] [-o trace.csv]
+//                [-r hal_trace.bin]
+//   -g : 발사대 기준 (east, north) m 지점을 착지 목표점으로 GPS 유도 (방위 오차 대신 목표점 거리 출력)
+//   -r : 펌웨어가 받은 HAL 입력을 기록 (sil_replay로 재현)
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "app_tasks.h"
+#include "hal_trace.h"
+#include "sil_flight.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    uint32_t flights = 8;
+    double wind_e = 2.0, wind_n = 1.0, target = 90.0, goal_e = 0.0, goal_n = 0.0;
+    bool guided = false;
+    const char *trace_path = NULL, *record_path = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "usage: %s [-n flights] [-w wind_e,wind_n] [-t target_heading] [-g east,north] "
+                            "[-o trace.csv] [-r hal_trace.bin]\n",
+                    argv[0]);
+            return 2;
+        }
+        if (strcmp(argv[i], "-n") == 0) flights = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-w") == 0) sscanf(argv[++i], "%lf,%lf", &wind_e, &wind_n);
+        else if (strcmp(argv[i], "-t") == 0) target = strtod(argv[++i], NULL);
+        else if (strcmp(argv[i], "-g") == 0) guided = sscanf(argv[++i], "%lf,%lf", &goal_e, &goal_n) == 2;
+        else if (strcmp(argv[i], "-o") == 0) trace_path = argv[++i];
+        else if (strcmp(argv[i], "-r") == 0) record_path = argv[++i];
+        else {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    FILE *trace = NULL;
+    if (trace_path) {
+        trace = fopen(trace_path, "w");
+        if (!trace) {
+            perror(trace_path);
+            return 1;
+        }
+        fputs(SIL_FLIGHT_TRACE_HEADER, trace);
+    }
+
+    if (record_path && !hal_trace_record_start(1u << 20)) {
+        fprintf(stderr, "cannot start HAL trace recording\n");
+        return 1;
+    }
+
+    flight_ctrl_config_t ctrl_config = {
+        .steer_left_gpio = 16, .steer_right_gpio = 17, .deploy_gpio = 18,
+        .target_heading_deg = (float)target,
+    };
+    if (guided) {
+        sil_model_config_t origin;
+        sil_model_config_default(&origin, 16, 17, 18);
+        sil_model_local_to_geo(&origin, goal_e, goal_n, &ctrl_config.target_lat_e7, &ctrl_config.target_lon_e7);
+        ctrl_config.guided = true;
+        printf("SIL: %u flights, wind (%.1f, %.1f) m/s, landing target (%.1f, %.1f) m, physics %u us, control %u ms\n",
+               flights, wind_e, wind_n, goal_e, goal_n, SIL_PHYSICS_STEP_US, APP_CONTROL_PERIOD_MS);
+    } else {
+        printf("SIL: %u flights, wind (%.1f, %.1f) m/s, target heading %.0f deg, physics %u us, control %u ms\n",
+               flights, wind_e, wind_n, target, SIL_PHYSICS_STEP_US, APP_CONTROL_PERIOD_MS);
+    }
+    printf("  #  yaw0  apogee   deploy@        landed    landing (E, N)      %s  phase\n",
+           guided ? "    miss" : "|hdg err|");
+
+    uint64_t total_steps = 0, t0 = now_ns();
+    int failures = 0;
+    for (uint32_t f = 0; f < flights; ++f) {
+        sil_model_config_t model_config;
+        sil_model_config_default(&model_config, ctrl_config.steer_left_gpio, ctrl_config.steer_right_gpio,
+                                 ctrl_config.deploy_gpio);
+        model_config.wind_e = wind_e;
+        model_config.wind_n = wind_n;
+        model_config.yaw0_deg = fmod(37.0 + 137.0 * f, 360.0);
+        model_config.seed = f + 1;
+        sil_flight_result_t res;
+        if (!sil_flight_run(&model_config, &ctrl_config, trace, f, &res)) {
+            fprintf(stderr, "flight_ctrl_init failed\n");
+            return 1;
+        }
+        total_steps += res.steps;
+        bool ok = sil_flight_ok(&res);
+        failures += !ok;
+        printf("%3u  %4.0f  %6.1f m  %5.1f m %4.1f s  %6.1f s  (%6.1f, %6.1f) m  %6.1f %-3s  %s\n", f,
+               model_config.yaw0_deg, res.apogee_m, res.deploy_alt_m, res.deploy_s, res.landed_s, res.land_e,
+               res.land_n, guided ? res.miss_m : res.heading_err_deg, guided ? "m" : "deg", ok ? "LANDED" : "FAIL");
+    }
+    double wall_s = (now_ns() - t0) * 1e-9;
+    if (trace) fclose(trace);
+    if (record_path) {
+        size_t len;
+        uint8_t *data = hal_trace_record_stop(&len);
+        FILE *out = data ? fopen(record_path, "wb") : NULL;
+        if (!out || fwrite(data, 1, len, out) != len) {
+            fprintf(stderr, "cannot write HAL trace %s: %s\n", record_path,
+                    hal_trace_error() ? hal_trace_error() : "write failed");
+            return 1;
+        }
+        fclose(out);
+        free(data);
+        printf("HAL trace: %zu bytes (%.0f bytes per simulated second)\n", len,
+               len / (total_steps * SIL_PHYSICS_STEP_US * 1e-6));
+    }
+
+    double sim_s = total_steps * SIL_PHYSICS_STEP_US * 1e-6;
+    printf("%llu physics steps (%.0f s simulated) in %.3f s: %.2f Msteps/s, %.0fx real time\n",
+           (unsigned long long)total_steps, sim_s, wall_s, total_steps / wall_s / 1e6, sim_s / wall_s);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+// 비행 로그 궤적 재구성 도구 (열 지향 로그 -> 스무딩된 고도/속도 CSV)
+//
+// 사용법:
+//   traj_smooth <log> <out.csv> [-w workers] [-d decimate] [-f] [-o offset] [-W servo_wrap]
+//     -d : N 샘플마다 한 줄 출력 (기본 10 = 100 Hz)
+//     -f : 스무딩 없이 전방 필터 결과만
+//     -o : 파일 안의 로그 시작 위치 (sdlog 파일이면 512)
+//     -W : 서보 PWM wrap 값 (레벨 -> 펄스 폭 변환, 기본 65465 = 125 MHz에서 servo.c가 고르는 값)
+//
+// 수직 채널 하나를 재구성합니다: 가속도 입력 = accel_z(m/s^2) - g (기체 z축이 위를 향한다고
+// 가정), 위치 측정 = 기압 고도 (기준 기압은 첫 1초 평균). 출력에는 같은 샘플의 서보 명령을
+// 펄스 폭으로 겹쳐 씁니다.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "collog_reader.h"
+#include "logk.h"
+#include "servo.h"
+#include "units.h"
+}
+#include "traj_smoother.hpp"
+
+namespace {
+
+template <typename T>
+bool extract(const collog_reader_t &r, const char *name, std::vector<T> &out) {
+    int c = collog_reader_find(&r, name);
+    if (c < 0 || r.channels[c].size != sizeof(T)) {
+        std::fprintf(stderr, "log has no %zu-byte channel '%s'\n", sizeof(T), name);
+        return false;
+    }
+    out.resize(out.capacity());
+    out.resize(collog_reader_extract_raw(&r, c, 0, UINT32_MAX, nullptr, out.data(), out.size()));
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <log> <out.csv> [-w workers] [-d decimate] [-f] [-o offset] [-W wrap]\n",
+                     argv[0]);
+        return 2;
+    }
+    cansat::traj::Config config;
+    std::size_t decimate = 10, offset = 0;
+    unsigned wrap = 65465;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg == "-f") {
+            config.smooth = false;
+            continue;
+        }
+        if (!value) {
+            std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return 2;
+        }
+        if (arg == "-w") config.workers = static_cast<unsigned>(std::strtoul(value, nullptr, 0));
+        else if (arg == "-d") decimate = std::strtoul(value, nullptr, 0);
+        else if (arg == "-o") offset = std::strtoul(value, nullptr, 0);
+        else if (arg == "-W") wrap = static_cast<unsigned>(std::strtoul(value, nullptr, 0));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return 2;
+        }
+        ++i;
+    }
+    if (decimate == 0) decimate = 1;
+
+    collog_reader_t reader;
+    if (!collog_reader_open(&reader, argv[1], offset, 0)) {
+        std::fprintf(stderr, "cannot open %s as a column log\n", argv[1]);
+        return 1;
+    }
+    // 행 수 상한: 파일 크기 / 행 크기 (정확한 행 수는 추출 결과)
+    std::size_t row_bytes = 0;
+    for (std::uint32_t c = 0; c < reader.channel_count; ++c) row_bytes += reader.channels[c].size;
+    std::size_t cap = reader.len / row_bytes + 1;
+    std::vector<std::uint32_t> t_us;
+    std::vector<std::int32_t> pressure;
+    std::vector<std::int16_t> accel_z;
+    std::vector<std::uint16_t> servo0, servo1;
+    t_us.reserve(cap);
+    pressure.reserve(cap);
+    accel_z.reserve(cap);
+    servo0.reserve(cap);
+    servo1.reserve(cap);
+    bool ok = extract(reader, "t_us", t_us) && extract(reader, "pressure", pressure) &&
+              extract(reader, "accel_z", accel_z) && extract(reader, "servo_0", servo0) &&
+              extract(reader, "servo_1", servo1);
+    collog_reader_close(&reader);
+    std::size_t n = t_us.size();
+    if (!ok || n < 2 || pressure.size() != n || accel_z.size() != n || servo0.size() != n || servo1.size() != n) {
+        std::fprintf(stderr, "log is empty or channels disagree\n");
+        return 1;
+    }
+
+    // 기준 기압: 첫 1초 평균
+    std::size_t pad = 0;
+    double p_sum = 0.0;
+    while (pad < n && static_cast<std::uint32_t>(t_us[pad] - t_us[0]) < 1000000u) p_sum += pressure[pad++];
+    float p0 = static_cast<float>(p_sum / pad);
+
+    std::vector<float> baro_alt(n), accel(n);
+    logk_pressure_to_alt(pressure.data(), baro_alt.data(), n, p0);
+    logk_i16_to_f32(accel_z.data(), accel.data(), n, UNITS_ACCEL_MPS2_PER_LSB);
+    for (float &a : accel) a -= UNITS_STANDARD_GRAVITY;
+
+    std::vector<cansat::traj::State> states(n);
+    std::vector<cansat::traj::Channel> channels = {{accel.data(), baro_alt.data(), {}}};
+    cansat::traj::Stats stats = cansat::traj::smooth(t_us.data(), n, channels, config, {states.data()});
+
+    std::FILE *out = std::fopen(argv[2], "w");
+    if (!out) {
+        std::perror(argv[2]);
+        return 1;
+    }
+    const double us_per_level = 1e6 / SERVO_PWM_FREQ_HZ / (wrap + 1.0);
+    std::fprintf(out, "t_us,alt_m,vel_mps,accel_bias,alt_sigma_m,vel_sigma_mps,baro_alt_m,servo_0_us,servo_1_us\n");
+    for (std::size_t k = 0; k < n; k += decimate) {
+        const cansat::traj::State &s = states[k];
+        std::fprintf(out, "%u,%.3f,%.3f,%.4f,%.3f,%.3f,%.3f,%.1f,%.1f\n", t_us[k], s.pos, s.vel, s.bias, s.pos_sigma,
+                     s.vel_sigma, baro_alt[k], servo0[k] * us_per_level, servo1[k] * us_per_level);
+    }
+    std::fclose(out);
+
+    std::fprintf(stderr, "%zu samples (%s, %s), %zu work units, %.1f ms, p0 %.0f Pa\n", n,
+                 config.smooth ? "RTS smoothed" : "forward filter", logk_isa_name(logk_current_isa()), stats.units,
+                 stats.wall_ns / 1e6, p0);
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include "traj_smoother.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace cansat::traj {
+
+namespace {
+
+using V3 = std::array<double, 3>;
+using M3 = std::array<double, 9>;  // 행 우선
+
+std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+M3 mul(const M3 &a, const M3 &b) {
+    M3 r;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            r[i * 3 + j] = a[i * 3] * b[j] + a[i * 3 + 1] * b[3 + j] + a[i * 3 + 2] * b[6 + j];
+        }
+    }
+    return r;
+}
+
+// a * b^T
+M3 mul_bt(const M3 &a, const M3 &b) {
+    M3 r;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            r[i * 3 + j] = a[i * 3] * b[j * 3] + a[i * 3 + 1] * b[j * 3 + 1] + a[i * 3 + 2] * b[j * 3 + 2];
+        }
+    }
+    return r;
+}
+
+V3 mul(const M3 &a, const V3 &v) {
+    return {a[0] * v[0] + a[1] * v[1] + a[2] * v[2], a[3] * v[0] + a[4] * v[1] + a[5] * v[2],
+            a[6] * v[0] + a[7] * v[1] + a[8] * v[2]};
+}
+
+M3 inverse(const M3 &m) {
+    M3 c = {m[4] * m[8] - m[5] * m[7], m[2] * m[7] - m[1] * m[8], m[1] * m[5] - m[2] * m[4],
+            m[5] * m[6] - m[3] * m[8], m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+            m[3] * m[7] - m[4] * m[6], m[1] * m[6] - m[0] * m[7], m[0] * m[4] - m[1] * m[3]};
+    double det = m[0] * c[0] + m[1] * c[3] + m[2] * c[6];
+    for (double &v : c) v /= det;
+    return c;
+}
+
+// 샘플 k -> k+1 예측 모델: 상태 [p, v, b], 입력 u (측정 가속도)
+//   p' = p + v dt + (u - b) dt^2 / 2,  v' = v + (u - b) dt,  b' = b
+// 가속도 잡음은 연속 백색 잡음(accel_noise^2), 바이어스는 랜덤 워크(bias_walk^2)
+struct Model {
+    M3 F;
+    V3 bu;
+    M3 Q;
+};
+
+Model make_model(const ChannelParams &p, double dt, double u) {
+    double dt2 = dt * dt, dt3 = dt2 * dt;
+    double q = p.accel_noise * p.accel_noise, qb = p.bias_walk * p.bias_walk;
+    Model m;
+    m.F = {1.0, dt, -0.5 * dt2, 0.0, 1.0, -dt, 0.0, 0.0, 1.0};
+    m.bu = {0.5 * dt2 * u, dt * u, 0.0};
+    m.Q = {q * dt3 / 3.0, q * dt2 / 2.0, 0.0, q * dt2 / 2.0, q * dt, 0.0, 0.0, 0.0, qb * dt};
+    return m;
+}
+
+struct Filtered {
+    V3 x;
+    M3 P;
+};
+
+void predict(const Model &m, const Filtered &f, V3 &xp, M3 &Pp) {
+    xp = mul(m.F, f.x);
+    for (int i = 0; i < 3; ++i) xp[i] += m.bu[i];
+    Pp = mul_bt(mul(m.F, f.P), m.F);
+    for (int i = 0; i < 9; ++i) Pp[i] += m.Q[i];
+}
+
+// 위치 측정 갱신 (H = [1 0 0]), 대칭을 유지하도록 P -= K S K^T
+void update(Filtered &f, double z, double r) {
+    double s = f.P[0] + r;
+    V3 k = {f.P[0] / s, f.P[3] / s, f.P[6] / s};
+    double innov = z - f.x[0];
+    for (int i = 0; i < 3; ++i) f.x[i] += k[i] * innov;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) f.P[i * 3 + j] -= k[i] * k[j] * s;
+    }
+}
+
+double dt_at(const std::uint32_t *t_us, std::size_t k) {
+    return static_cast<std::uint32_t>(t_us[k + 1] - t_us[k]) * 1e-6;
+}
+
+State to_state(const V3 &x, const M3 &P) {
+    return {static_cast<float>(x[0]), static_cast<float>(x[1]), static_cast<float>(x[2]),
+            static_cast<float>(std::sqrt(std::max(P[0], 0.0))), static_cast<float>(std::sqrt(std::max(P[4], 0.0)))};
+}
+
+struct Unit {
+    std::size_t channel;
+    std::size_t a, s, e, b;  // 계산 구간 [a, b), 출력 구간 [s, e)
+};
+
+// 작업 하나: [a, b) 전방 필터 후 [s, e) 출력 (스무딩 시 b-1 부터 s 까지 역방향)
+void run_unit(const std::uint32_t *t_us, const Channel &ch, const Unit &u, bool smooth, State *out,
+              std::vector<Filtered> &filt) {
+    const ChannelParams &p = ch.params;
+    const double r = p.meas_sigma * p.meas_sigma;
+    filt.resize(u.b - u.a);
+
+    // 첫 측정을 위치 초기값으로
+    double p0 = 0.0;
+    for (std::size_t k = u.a; k < u.b; ++k) {
+        if (!std::isnan(ch.meas[k])) {
+            p0 = ch.meas[k];
+            break;
+        }
+    }
+    Filtered f;
+    f.x = {p0, 0.0, 0.0};
+    f.P = {p.init_pos_sigma * p.init_pos_sigma, 0.0, 0.0, 0.0, p.init_vel_sigma * p.init_vel_sigma, 0.0,
+           0.0, 0.0, p.init_bias_sigma * p.init_bias_sigma};
+
+    for (std::size_t k = u.a; k < u.b; ++k) {
+        if (k > u.a) {
+            Model m = make_model(p, dt_at(t_us, k - 1), ch.accel[k - 1]);
+            Filtered prev = f;
+            predict(m, prev, f.x, f.P);
+        }
+        if (!std::isnan(ch.meas[k])) update(f, ch.meas[k], r);
+        filt[k - u.a] = f;
+    }
+
+    if (!smooth) {
+        for (std::size_t k = u.s; k < u.e; ++k) out[k] = to_state(filt[k - u.a].x, filt[k - u.a].P);
+        return;
+    }
+
+    V3 xs = filt[u.b - 1 - u.a].x;
+    M3 Ps = filt[u.b - 1 - u.a].P;
+    if (u.e == u.b) out[u.b - 1] = to_state(xs, Ps);
+    for (std::size_t k = u.b - 1; k-- > u.s;) {
+        const Filtered &fk = filt[k - u.a];
+        Model m = make_model(p, dt_at(t_us, k), ch.accel[k]);
+        V3 xp;
+        M3 Pp;
+        predict(m, fk, xp, Pp);
+        M3 C = mul(mul_bt(fk.P, m.F), inverse(Pp));  // 스무더 이득 Pf F^T Pp^-1
+
+        V3 dx;
+        M3 dP;
+        for (int i = 0; i < 3; ++i) dx[i] = xs[i] - xp[i];
+        for (int i = 0; i < 9; ++i) dP[i] = Ps[i] - Pp[i];
+        V3 cx = mul(C, dx);
+        M3 cpc = mul_bt(mul(C, dP), C);
+        for (int i = 0; i < 3; ++i) xs[i] = fk.x[i] + cx[i];
+        for (int i = 0; i < 9; ++i) Ps[i] = fk.P[i] + cpc[i];
+        if (k < u.e) out[k] = to_state(xs, Ps);
+    }
+}
+
+}  // namespace
+
+Stats smooth(const std::uint32_t *t_us, std::size_t n, const std::vector<Channel> &channels,
+             const Config &config, const std::vector<State *> &out) {
+    Stats stats{};
+    std::uint64_t t0 = now_ns();
+
+    // 작업 목록: 채널 x 구간
+    std::size_t seg = config.segment == 0 ? n : config.segment;
+    std::vector<Unit> units;
+    for (std::size_t c = 0; c < channels.size(); ++c) {
+        for (std::size_t s = 0; s < n; s += seg) {
+            Unit u;
+            u.channel = c;
+            u.s = s;
+            u.e = std::min(n, s + seg);
+            u.a = s > config.overlap ? s - config.overlap : 0;
+            u.b = config.smooth ? std::min(n, u.e + config.overlap) : u.e;
+            units.push_back(u);
+            stats.samples_processed += u.b - u.a;
+        }
+    }
+    stats.units = units.size();
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        std::vector<Filtered> filt;
+        for (std::size_t i; (i = next.fetch_add(1)) < units.size();) {
+            const Unit &u = units[i];
+            run_unit(t_us, channels[u.channel], u, config.smooth, out[u.channel], filt);
+        }
+    };
+
+    unsigned workers = static_cast<unsigned>(std::min<std::size_t>(std::max(config.workers, 1u), units.size()));
+    if (workers <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        for (unsigned w = 0; w < workers; ++w) threads.emplace_back(worker);
+        for (std::thread &t : threads) t.join();
+    }
+
+    stats.wall_ns = now_ns() - t0;
+    return stats;
+}
+
+}  // namespace cansat::traj
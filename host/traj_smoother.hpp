@@ -0,0 +1,56 @@
+// 비행 후 궤적 재구성 (칼만 필터 + Rauch-Tung-Striebel 스무더)
+//
+// 채널 하나는 축 하나의 상태 [위치, 속도, 가속도계 바이어스] 입니다. 가속도계 값은 예측
+// 단계의 입력으로, 위치 측정(기압 고도, GPS 등)은 있는 샘플에서만 갱신에 씁니다.
+// 전방 필터가 끝난 뒤 RTS 역방향 패스로 미래 측정까지 반영한 추정값을 만듭니다.
+//
+// 병렬화: 긴 로그를 구간(segment)으로 나누고, 구간마다 앞뒤로 overlap 샘플을 더 계산해
+// 필터와 스무더가 수렴한 가운데 부분만 출력에 씁니다. (채널, 구간) 하나가 작업 하나이며
+// 작업끼리 공유하는 상태가 없어 워커 수만큼 나눠 처리합니다. overlap 이 상태 상관 시간보다
+// 충분히 길면 결과는 한 번에 전체를 처리한 것과 (부동소수점 오차 수준으로) 같습니다.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cansat::traj {
+
+struct ChannelParams {
+    double accel_noise = 0.5;       // 가속도 입력 잡음 + 모델 오차 (m/s^2/sqrt(Hz))
+    double bias_walk = 0.01;        // 바이어스 랜덤 워크 (m/s^2/sqrt(s))
+    double meas_sigma = 0.3;        // 위치 측정 잡음 (m)
+    double init_pos_sigma = 100.0;  // 구간 시작 불확실성 (첫 측정 기준)
+    double init_vel_sigma = 20.0;
+    double init_bias_sigma = 1.0;
+};
+
+struct Channel {
+    const float *accel;  // 축 방향 가속도 (중력 제거, m/s^2). accel[k] 는 k -> k+1 구간 입력
+    const float *meas;   // 위치 측정 (m), NaN 이면 측정 없음
+    ChannelParams params;
+};
+
+struct State {
+    float pos, vel, bias;
+    float pos_sigma, vel_sigma;
+};
+
+struct Config {
+    unsigned workers = 4;
+    std::size_t segment = 60000;  // 구간 길이 (샘플). 0 이면 구간을 나누지 않음
+    std::size_t overlap = 10000;  // 구간 앞뒤로 더 계산하는 샘플
+    bool smooth = true;           // false 면 전방 필터 결과만 (실시간 필터와 같은 추정)
+};
+
+struct Stats {
+    std::size_t units;              // (채널, 구간) 작업 수
+    std::size_t samples_processed;  // overlap 포함 전방 필터 샘플 수
+    std::uint64_t wall_ns;
+};
+
+// t_us: 샘플 타임스탬프 (u32 래핑 허용, 간격만 사용). out[c] 는 채널 c 의 n 개 출력.
+Stats smooth(const std::uint32_t *t_us, std::size_t n, const std::vector<Channel> &channels,
+             const Config &config, const std::vector<State *> &out);
+
+}  // namespace cansat::traj
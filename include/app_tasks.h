@@ -0,0 +1,98 @@
+#ifndef APP_TASKS_H_
+#define APP_TASKS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "coro.h"
+
+// --- 설정값 ---
+// 아래 주기들은 파라미터 기본값이며, 런타임 값은 params.h (ctrl/tlm/log.period_ms)에서 읽음
+// 서보 제어 주기 (ms). 서보 PWM 주기(SERVO_PWM_FREQ_HZ = 50 Hz)와 맞춤
+#define APP_CONTROL_PERIOD_MS 20
+// ctrl.period_ms 하한. 로그 태스크가 APP_LOG_POLL_MS마다 큐를 비우므로 이 주기에서도 넘치지 않음
+#define APP_CONTROL_MIN_PERIOD_MS 5
+// 텔레메트리 / 로깅 태스크가 큐를 비우는 주기 (ms)
+#define APP_TELEMETRY_PERIOD_MS 100
+#define APP_LOG_PERIOD_MS 1000
+// 로그 태스크가 SD 카드로 블록을 보내는 주기 (ms). 한 번에 DMA 하나(512 B)씩이므로 출력 주기와 별개로 짧게
+#define APP_LOG_POLL_MS 2
+// 채우던 logz 블록을 강제로 넘기는 주기 (ms). 전원이 끊길 때 잃는 로그의 상한
+#define APP_LOG_FLUSH_MS 2000
+
+// 제어 태스크 -> 하위 태스크 큐 슬롯 수 (2의 거듭제곱)
+#define APP_QUEUE_SLOTS 64
+
+// 로그 태스크가 SD 카드에 미리 할당하는 압축 로그 파일 크기 (sdlog.h)
+#define APP_LOG_FILE_BYTES (16u * 1024u * 1024u)
+
+// 제어 대상 서보 GPIO
+#define APP_SERVO_GPIO 16
+
+// 태스크 우선순위 (숫자가 클수록 높음)
+#define APP_CONTROL_PRIORITY (tskIDLE_PRIORITY + 3)
+#define APP_TELEMETRY_PRIORITY (tskIDLE_PRIORITY + 2)
+#define APP_LOG_PRIORITY (tskIDLE_PRIORITY + 1)
+// 드라이버 코루틴 실행기. 인터럽트 알림을 받으면 곧바로 재개되도록 텔레메트리와 같은 우선순위
+#define APP_CORO_PRIORITY (tskIDLE_PRIORITY + 2)
+// 진동 분석은 유휴 태스크와 같은 우선순위 (configIDLE_SHOULD_YIELD로 번갈아 실행, 남는 시간만 사용)
+#define APP_VIBRATION_PRIORITY tskIDLE_PRIORITY
+
+// 진동 분석 입력(IMU 한 축) 샘플링 주파수와 분석할 블록이 없을 때 쉬는 시간 (ms)
+#define APP_VIBRATION_SAMPLE_RATE_HZ 1000
+#define APP_VIBRATION_IDLE_MS 10
+
+// 제어 태스크가 매 주기마다 하위 태스크로 넘기는 샘플.
+// SD 로그에는 servo_angle까지(패딩 제외 21 바이트)가 logz 프레임으로 기록됨
+typedef struct {
+    uint64_t timestamp_us;   // 제어 주기 시작 시각
+    uint32_t seq;            // 주기 번호
+    int32_t jitter_us;       // 예정 시각 대비 실제 시작 지연
+    uint32_t exec_us;        // 제어 주기 실행 시간
+    uint8_t servo_angle;     // 이번 주기에 출력한 각도
+} app_control_sample_t;
+
+/**
+ * @brief 진동 분석기에 IMU 샘플을 넣습니다 (IMU를 읽는 태스크 하나에서만 호출, 블로킹 없음).
+ *
+ * @param samples APP_VIBRATION_SAMPLE_RATE_HZ로 샘플링한 한 축 값 (자이로 권장).
+ */
+void app_vibration_feed(const int16_t *samples, uint32_t n);
+
+/**
+ * @brief SD 로그를 마무리합니다 (블로킹 없음, 실제 작업은 로그 태스크가 다음 주기에).
+ *
+ * 로그 큐와 채우던 logz 블록을 기록한 뒤 sdlog_close()로 파일 헤더를 갱신합니다 (착지 후, 전원 차단 전).
+ * 이후 로그 태스크는 요약 출력만 계속합니다.
+ */
+void app_log_close(void);
+
+/**
+ * @brief 드라이버 코루틴을 실행기 태스크에 등록합니다.
+ *
+ * app_tasks_create() 이후 vTaskStartScheduler 전에, 또는 이미 실행 중인 코루틴 안에서만 호출합니다
+ * (실행기는 잠금 없이 풀을 읽음). CORO_YIELD만 반복하면 하위 우선순위 태스크가 굶으므로
+ * 기다릴 때는 CORO_AWAIT_EVENT / CORO_SLEEP_US를 씁니다.
+ *
+ * @return 등록된 코루틴, 풀이 가득 찼으면 NULL.
+ */
+coro_t *app_coro_spawn(coro_fn_t fn, void *ctx);
+
+/**
+ * @brief 제어/텔레메트리/로깅 태스크를 생성합니다 (vTaskStartScheduler 전에 호출).
+ *
+ * 파라미터 서브시스템(params_init)도 여기서 초기화합니다.
+ * 제어 태스크는 서보를 APP_SERVO_GPIO에 초기화한 뒤 고정 주기로 실행되며,
+ * 하위 태스크와는 lock-free SPSC 큐로만 통신하므로 절대 블로킹되지 않습니다.
+ * SMP 빌드에서는 제어 태스크를 core 1에, 나머지를 core 0에 고정합니다.
+ * 로그 태스크는 SD 카드가 있으면 샘플을 logz로 압축해 sdlog 파일에 기록합니다
+ * (카드 전송은 APP_LOG_POLL_MS마다, 요약 출력은 log.period_ms마다).
+ * 진동 분석 태스크는 core 0 유휴 시간에 app_vibration_feed()로 들어온 블록을 분석하고,
+ * 텔레메트리 태스크가 새 결과를 VIB 줄로 출력합니다.
+ * 코루틴 태스크는 app_coro_spawn()으로 등록한 드라이버 코루틴을 실행하고, 할 일이 없으면
+ * coro_hw 인터럽트의 태스크 알림이나 다음 CORO_SLEEP 만료까지 블로킹됩니다.
+ *
+ * @return 모든 태스크 생성 성공 시 true, 실패 시 false.
+ */
+bool app_tasks_create(void);
+
+#endif // APP_TASKS_H_
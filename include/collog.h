@@ -0,0 +1,153 @@
+#ifndef COLLOG_H_
+#define COLLOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 열(column) 지향 청크 로그 작성기.
+ *
+ * 레코드를 COLLOG_CHUNK_ROWS 개씩 모아 채널별 열로 재배치한 청크로 기록합니다.
+ * 지상 도구는 청크 헤더의 시간 범위와 파일 끝의 청크 색인만 보고 필요한 청크의
+ * 필요한 열만 읽으면 되므로, 채널 하나를 그리려고 모든 레코드를 해석할 필요가 없습니다.
+ *
+ * 파일 형식 (리틀 엔디언, 모든 구조체 4바이트 정렬):
+ *   collog_file_header_t + collog_channel_desc_t x channel_count
+ *   청크 x N: collog_chunk_header_t + 채널 순서대로 열 (rows x 채널 크기, 4바이트로 올림)
+ *   색인: collog_index_entry_t x entries + collog_trailer_t (collog_writer_close에서 기록)
+ *
+ * 색인은 고정 크기(COLLOG_INDEX_ENTRIES)이며, 가득 차면 항목을 하나 걸러 버리고 간격을
+ * 두 배로 늘립니다. 리더는 색인으로 시작 청크 근처까지 간 뒤 청크 헤더의 크기로
+ * 건너뛰며, 트레일러가 없으면(비정상 종료) 첫 청크부터 헤더만 따라갑니다.
+ * 채널 0은 반드시 COLLOG_U32 타임스탬프(us)여야 합니다.
+ *
+ * u32 us 타임스탬프는 71.6분마다 한 바퀴 돕니다. 작성기는 값이 크게 줄어드는 것을 보고 바퀴 수(epoch)를
+ * 세어 청크 헤더와 색인에 t_first_us와 함께 기록하므로, 리더는 (epoch << 32) | t_us 의 64비트 시각으로
+ * 비교합니다. 청크 안의 행과 t_last_us는 t_first_us로부터의 차이(청크 하나는 71.6분보다 짧음)로 넓힙니다.
+ */
+
+// --- 설정값 ---
+#define COLLOG_MAX_CHANNELS 24
+#define COLLOG_NAME_LEN 12
+#define COLLOG_CHUNK_ROWS 64          // 청크 하나의 최대 행 수
+#define COLLOG_CHUNK_BYTES 2048       // 청크 열 데이터 최대 크기 (sdlog 버퍼 하나 이하)
+#define COLLOG_INDEX_ENTRIES 256      // 색인 항목 수 (12 B x 256 = 3 KB)
+
+#define COLLOG_FILE_MAGIC 0x4C4F4343u    // "CCOL"
+#define COLLOG_CHUNK_MAGIC 0x4B4E4843u   // "CHNK"
+#define COLLOG_TRAILER_MAGIC 0x58444943u // "CIDX"
+#define COLLOG_VERSION 2              // 2: 청크 헤더 / 색인에 t_epoch 추가
+
+typedef enum {
+    COLLOG_U8,
+    COLLOG_I8,
+    COLLOG_U16,
+    COLLOG_I16,
+    COLLOG_U32,
+    COLLOG_I32,
+    COLLOG_F32,
+} collog_type_t;
+
+// 채널 정의: 호출자 레코드 구조체 안의 위치와 타입
+typedef struct {
+    const char *name;         // COLLOG_NAME_LEN - 1 글자까지 기록
+    collog_type_t type;
+    uint16_t offset;          // offsetof(레코드, 필드)
+} collog_channel_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t channel_count;
+    uint32_t header_bytes;    // 첫 청크의 파일 오프셋
+} collog_file_header_t;
+
+typedef struct {
+    char name[COLLOG_NAME_LEN];
+    uint8_t type;             // collog_type_t
+    uint8_t size;             // 바이트
+    uint16_t reserved;
+} collog_channel_desc_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t rows;
+    uint16_t channel_count;
+    uint32_t chunk_bytes;     // 헤더 포함 청크 전체 크기 (다음 청크로 건너뛰기용)
+    uint32_t t_first_us;
+    uint32_t t_last_us;
+    uint32_t t_epoch;         // t_first_us까지 타임스탬프가 한 바퀴 돈 횟수
+} collog_chunk_header_t;
+
+typedef struct {
+    uint32_t offset;          // 청크의 파일 오프셋
+    uint32_t t_epoch;
+    uint32_t t_first_us;
+} collog_index_entry_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t entries;
+    uint32_t stride;          // 색인 항목 사이의 청크 수
+    uint32_t chunks;          // 기록된 청크 수
+    uint32_t index_offset;    // 첫 색인 항목의 파일 오프셋
+} collog_trailer_t;
+
+// 출력 싱크 (sdlog_write와 같은 형식). 통째로 받아들이거나 통째로 버려야 함
+typedef bool (*collog_sink_fn)(const void *data, uint32_t len);
+
+typedef struct {
+    const collog_channel_t *channels;
+    uint32_t channel_count;
+    collog_sink_fn sink;
+    uint8_t size[COLLOG_MAX_CHANNELS];
+    uint16_t column_offset[COLLOG_MAX_CHANNELS];    // 가득 찬 청크에서 열 시작 위치
+    uint32_t rows;                                  // 채우는 중인 청크의 행 수
+    uint32_t offset;                                // 다음 기록의 파일 오프셋
+    uint32_t t_first_us, t_last_us;                 // t_last_us: 마지막으로 추가한 레코드 (바퀴 감지용)
+    uint32_t t_epoch;                               // 현재 타임스탬프 바퀴 수
+    uint32_t t_first_epoch;                         // 채우는 중인 청크 첫 행의 바퀴 수
+    uint32_t chunks;
+    uint32_t chunks_dropped;
+    uint32_t index_count;
+    uint32_t index_stride;
+    collog_index_entry_t index[COLLOG_INDEX_ENTRIES];
+    uint8_t chunk[sizeof(collog_chunk_header_t) + COLLOG_CHUNK_BYTES] __attribute__((aligned(4)));
+} collog_writer_t;
+
+/**
+ * @brief 채널 크기(바이트)를 반환합니다.
+ */
+uint32_t collog_type_size(collog_type_t type);
+
+/**
+ * @brief 작성기를 초기화하고 파일 헤더(채널 목록)를 싱크로 기록합니다.
+ *
+ * @param w 대상 작성기 (정적 할당 권장, 약 5.4 KB).
+ * @param channels 채널 정의 배열. 호출자가 작성기 수명 동안 유지해야 합니다.
+ * @param channel_count 채널 수. 채널 0은 COLLOG_U32 타임스탬프.
+ * @param sink 출력 싱크.
+ * @return 성공 시 true, 채널 정의가 잘못되었거나 헤더 기록 실패 시 false.
+ */
+bool collog_writer_init(collog_writer_t *w, const collog_channel_t *channels, uint32_t channel_count,
+                        collog_sink_fn sink);
+
+/**
+ * @brief 레코드 하나를 열에 추가합니다. 청크가 차면 싱크로 넘깁니다.
+ *
+ * @param record channels의 offset이 가리키는 레코드 구조체.
+ * @return 청크를 넘기다 싱크가 거부하면 false (그 청크는 버려짐), 그 외 true.
+ */
+bool collog_writer_add(collog_writer_t *w, const void *record);
+
+/**
+ * @brief 채우던 청크를 즉시 넘깁니다.
+ */
+bool collog_writer_flush(collog_writer_t *w);
+
+/**
+ * @brief 남은 청크와 색인/트레일러를 기록합니다. 이후 작성기는 다시 init 해야 합니다.
+ */
+bool collog_writer_close(collog_writer_t *w);
+
+#endif // COLLOG_H_
@@ -0,0 +1,169 @@
+#ifndef CORO_H_
+#define CORO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 스택 없는(stackless) 협력형 코루틴 실행기.
+ *
+ * I2C/SPI/UART 드라이버를 콜백 대신 순차적인 코드로 작성하기 위한 것입니다.
+ * 코루틴 본문은 switch 기반 재개 지점으로 구현되므로 힙과 별도 스택이 필요 없고,
+ * 코루틴 제어 블록은 실행기 안의 정적 풀에서 할당됩니다.
+ *
+ * 주의: CORO_AWAIT_* / CORO_YIELD 를 지나면 지역 변수 값이 유지되지 않습니다.
+ *       유지해야 하는 값은 spawn 시 넘기는 ctx(프레임) 구조체에 두어야 합니다.
+ *       재개 지점은 __LINE__ 을 사용하므로 한 줄에 두 개의 await를 쓰면 안 됩니다.
+ *
+ * 사용 예:
+ *     static void sensor_task(coro_t *co) {
+ *         sensor_frame_t *f = co->ctx;
+ *         CORO_BEGIN(co);
+ *         while (true) {
+ *             start_spi_dma(f);
+ *             CORO_AWAIT_EVENT(co, &f->dma_done);
+ *             CORO_SLEEP_US(co, 1000);
+ *         }
+ *         CORO_END(co);
+ *     }
+ */
+
+// --- 설정값 ---
+// 실행기 하나가 가질 수 있는 최대 코루틴 수
+#define CORO_MAX_TASKS 16
+
+/**
+ * @brief 인터럽트 -> 코루틴 알림용 이벤트.
+ *
+ * signal 쪽(보통 ISR 하나)은 signaled만, 실행기는 consumed만 씁니다.
+ * 따라서 읽기-수정-쓰기 경쟁 없이 ISR에서 안전하게 signal 할 수 있고,
+ * 대기 전에 발생한 signal도 잃어버리지 않습니다.
+ */
+typedef struct {
+    volatile uint32_t signaled;
+    uint32_t consumed;
+} coro_event_t;
+
+typedef enum {
+    CORO_FREE = 0,
+    CORO_READY,
+    CORO_WAIT_EVENT,
+    CORO_WAIT_TIMER,
+    CORO_DONE,
+} coro_state_t;
+
+typedef struct coro coro_t;
+typedef void (*coro_fn_t)(coro_t *co);
+
+struct coro {
+    coro_fn_t fn;
+    void *ctx;                 // 사용자 프레임 (await 사이에 유지할 상태)
+    uint16_t resume_point;     // 재개할 줄 번호 (0 = 처음부터)
+    uint8_t state;             // coro_state_t
+    coro_event_t *event;       // CORO_WAIT_EVENT 일 때 대기 중인 이벤트
+    uint64_t wake_us;          // CORO_WAIT_TIMER 일 때 깨어날 시각
+};
+
+typedef struct {
+    coro_t tasks[CORO_MAX_TASKS];
+    uint32_t switches;         // 누적 재개 횟수 (통계)
+} coro_executor_t;
+
+// --- 코루틴 본문 매크로 ---
+
+#define CORO_BEGIN(co) switch ((co)->resume_point) { case 0:
+
+#define CORO_END(co) } (co)->state = CORO_DONE; return
+
+#define CORO_YIELD(co)                                             \
+    do {                                                           \
+        (co)->state = CORO_READY;                                  \
+        (co)->resume_point = __LINE__; return; case __LINE__:;     \
+    } while (0)
+
+#define CORO_AWAIT_EVENT(co, ev)                                   \
+    do {                                                           \
+        if (!coro_event_try_consume(ev)) {                         \
+            (co)->event = (ev);                                    \
+            (co)->state = CORO_WAIT_EVENT;                         \
+            (co)->resume_point = __LINE__; return; case __LINE__:; \
+        }                                                          \
+    } while (0)
+
+#define CORO_SLEEP_US(co, us)                                      \
+    do {                                                           \
+        (co)->wake_us = coro_now_us() + (us);                      \
+        (co)->state = CORO_WAIT_TIMER;                             \
+        (co)->resume_point = __LINE__; return; case __LINE__:;     \
+    } while (0)
+
+#define CORO_SLEEP_UNTIL_US(co, t_us)                              \
+    do {                                                           \
+        (co)->wake_us = (t_us);                                    \
+        (co)->state = CORO_WAIT_TIMER;                             \
+        (co)->resume_point = __LINE__; return; case __LINE__:;     \
+    } while (0)
+
+// --- 이벤트 ---
+
+static inline void coro_event_init(coro_event_t *ev) {
+    ev->signaled = 0;
+    ev->consumed = 0;
+}
+
+/**
+ * @brief 이벤트를 알립니다 (ISR에서 호출 가능, 이벤트당 signal 주체는 하나).
+ */
+static inline void coro_event_signal(coro_event_t *ev) {
+    ev->signaled = ev->signaled + 1;
+#if defined(__arm__)
+    __asm volatile ("sev"); // poll과 __wfe() 사이에 발생한 signal도 놓치지 않도록
+#endif
+}
+
+/**
+ * @brief 대기 중인 signal이 있으면 하나 소비합니다 (실행기 컨텍스트 전용).
+ */
+static inline bool coro_event_try_consume(coro_event_t *ev) {
+    if (ev->signaled == ev->consumed) return false;
+    ev->consumed++;
+    return true;
+}
+
+// --- 실행기 ---
+
+/**
+ * @brief 현재 시각 (us). 타깃은 하드웨어 타이머, 호스트는 HAL 에뮬레이션 시간.
+ */
+uint64_t coro_now_us(void);
+
+void coro_executor_init(coro_executor_t *exec);
+
+/**
+ * @brief 코루틴을 풀에 등록합니다. 다음 poll에서 처음 실행됩니다.
+ *
+ * @param fn 코루틴 본문.
+ * @param ctx 코루틴 프레임 (정적 저장소, 실행기 수명 동안 유효해야 함).
+ * @return 등록된 코루틴, 풀이 가득 찼으면 NULL.
+ */
+coro_t *coro_spawn(coro_executor_t *exec, coro_fn_t fn, void *ctx);
+
+/**
+ * @brief 실행 가능한 코루틴을 한 번씩 재개합니다 (슈퍼루프/RTOS 태스크에서 반복 호출).
+ *
+ * 완료된 코루틴의 슬롯은 풀에 반환됩니다.
+ *
+ * @param next_wake_us 다음 타이머 만료 시각을 받을 포인터 (NULL 허용).
+ *                     대기 중인 타이머가 없으면 UINT64_MAX.
+ * @return 이번 호출에서 재개한 코루틴 수.
+ */
+uint32_t coro_executor_poll(coro_executor_t *exec, uint64_t *next_wake_us);
+
+/**
+ * @brief 살아 있는 코루틴이 없을 때까지 poll 하며, 할 일이 없으면 대기합니다.
+ *
+ * 타깃에서는 __wfe()로 인터럽트/타이머까지 잠들고, 호스트에서는 다음 타이머까지 sleep 합니다.
+ */
+void coro_executor_run(coro_executor_t *exec);
+
+#endif // CORO_H_
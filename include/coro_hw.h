@@ -0,0 +1,60 @@
+#ifndef CORO_HW_H_
+#define CORO_HW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "coro.h"
+
+// 하드웨어 인터럽트 -> coro_event_t 연결 (DMA 완료, GPIO 엣지).
+// 타깃 구현은 src/coro_hw.c, 호스트 구현은 host/coro_hw_host.c 입니다.
+
+// --- 설정값 ---
+#define CORO_HW_NUM_DMA_CHANNELS 12
+#define CORO_HW_NUM_GPIOS 30
+
+/**
+ * @brief DMA 채널 완료 인터럽트(DMA_IRQ_0)를 이벤트에 연결합니다.
+ *
+ * 이후 해당 채널의 전송이 끝날 때마다 이벤트가 signal 됩니다.
+ *
+ * @param channel DMA 채널 번호.
+ * @param ev 완료 시 signal 할 이벤트.
+ * @return 성공 시 true, 실패 시 false (잘못된 채널, 이미 연결됨 등).
+ */
+bool coro_hw_bind_dma(uint32_t channel, coro_event_t *ev);
+
+/**
+ * @brief GPIO 엣지 인터럽트를 이벤트에 연결합니다.
+ *
+ * @param gpio GPIO 핀 번호.
+ * @param edge_mask GPIO_IRQ_EDGE_RISE / GPIO_IRQ_EDGE_FALL 조합.
+ * @param ev 엣지 발생 시 signal 할 이벤트.
+ * @return 성공 시 true, 실패 시 false.
+ */
+bool coro_hw_bind_gpio(uint32_t gpio, uint32_t edge_mask, coro_event_t *ev);
+
+/**
+ * @brief 연결을 해제하고 해당 인터럽트를 비활성화합니다.
+ */
+void coro_hw_unbind_dma(uint32_t channel);
+void coro_hw_unbind_gpio(uint32_t gpio);
+
+typedef void (*coro_hw_notify_fn_t)(void);
+
+/**
+ * @brief 연결된 인터럽트가 이벤트를 signal 한 뒤 호출할 함수를 지정합니다 (NULL이면 해제).
+ *
+ * 실행기를 RTOS 태스크에서 돌릴 때 태스크 알림(vTaskNotifyGiveFromISR)으로 깨우는 데 씁니다.
+ * 인터럽트 컨텍스트에서 호출되므로 짧아야 합니다. 연결 전에 지정해야 합니다.
+ */
+void coro_hw_set_notify(coro_hw_notify_fn_t fn);
+
+#ifdef CANSAT_HOST
+/**
+ * @brief (호스트 전용) 시뮬레이션된 드라이버가 DMA 완료/GPIO 엣지를 발생시킵니다.
+ */
+void coro_hw_host_fire_dma(uint32_t channel);
+void coro_hw_host_fire_gpio(uint32_t gpio);
+#endif
+
+#endif // CORO_HW_H_
@@ -0,0 +1,18 @@
+#ifndef CRC32_H_
+#define CRC32_H_
+
+#include <stdint.h>
+
+/**
+ * @brief CRC-32 (IEEE 802.3, zlib/PNG와 동일)을 이어서 계산합니다.
+ *
+ * 바이트당 테이블 조회 1회 (테이블 1 KB, 플래시 상주).
+ *
+ * @param crc 이전 결과 (처음에는 0).
+ * @param data 데이터.
+ * @param len 바이트 수.
+ * @return 갱신된 CRC.
+ */
+uint32_t crc32_update(uint32_t crc, const void *data, uint32_t len);
+
+#endif // CRC32_H_
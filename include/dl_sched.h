@@ -0,0 +1,105 @@
+#ifndef DL_SCHED_H_
+#define DL_SCHED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 하향 링크 패킷 스케줄러 (여러 송신원이 무선 하나를 나눠 쓸 때 송신 순서 결정).
+ *
+ * 트래픽 종류(클래스)마다 고정 크기 큐를 따로 둡니다. 송신 순서:
+ *   1) strict 클래스: 설정 순서대로 엄격한 우선순위 (서보/사출 이벤트 등 급한 프레임).
+ *      비어 있지 않은 strict 클래스가 있으면 항상 먼저 나감
+ *   2) 나머지 클래스: 가중치 비례 바이트 공정 분배 (deficit round robin, 한 바퀴에
+ *      weight x DL_SCHED_QUANTUM_BYTES 바이트). 텔레메트리/로그 발췌처럼 크기가 다른 프레임이 섞여도
+ *      포화 상태에서 각 클래스가 가중치만큼 대역을 받음
+ *
+ * 큐가 가득 찼을 때 정책:
+ *   DL_DROP_NEWEST  : 새 프레임을 버림 (로그 발췌처럼 순서대로 다 보내야 의미 있는 것)
+ *   DL_DROP_OLDEST  : 가장 오래된 프레임을 버리고 넣음 (최신 값이 중요한 것)
+ *   DL_DROP_REPLACE : 같은 메시지 ID가 큐에 있으면 그 자리에 덮어씀 (상태 메시지, 줄 선 순서 유지),
+ *                     없으면 DL_DROP_OLDEST. 큐가 가득 차지 않아도 항상 덮어씀
+ *
+ * 프레임은 메시지 프레임([u16 id][u16 seq][payload], messages.schema)으로 넣고, 꺼낼 때 송신 순서대로
+ * seq를 매긴 뒤 링크 프레임(link_frame.h)으로 감싸 돌려줍니다. 지상국은 seq로 손실을 셈합니다.
+ *
+ * 한 태스크에서만 사용하세요 (락 없음). 다른 태스크의 프레임은 spsc_queue로 받아 넣습니다.
+ */
+
+// --- 설정값 ---
+#define DL_SCHED_MAX_CLASSES 6
+#define DL_SCHED_QUANTUM_BYTES 64             // 가중치 1당 한 바퀴 바이트 (작을수록 큰 프레임 뒤 대기가 짧음)
+
+// 클래스 저장 공간 크기 (슬롯마다 길이 2바이트 + 프레임)
+#define DL_SCHED_STORAGE_BYTES(slots, frame_bytes) ((uint32_t)(slots) * ((frame_bytes) + 2u))
+
+typedef enum {
+    DL_DROP_NEWEST,
+    DL_DROP_OLDEST,
+    DL_DROP_REPLACE,
+} dl_drop_policy_t;
+
+typedef struct {
+    void *storage;                            // DL_SCHED_STORAGE_BYTES(slots, frame_bytes) 이상
+    uint16_t frame_bytes;                     // 슬롯 하나의 최대 메시지 프레임 크기
+    uint8_t slots;                            // 큐 길이
+    bool strict;                              // 엄격한 우선순위 클래스 (weight 무시)
+    uint8_t weight;                           // 공정 분배 가중치 (1 이상)
+    dl_drop_policy_t policy;
+} dl_class_config_t;
+
+typedef struct {
+    uint32_t enqueued;                        // 받은 프레임 (덮어쓴 것 포함)
+    uint32_t dropped;                         // 넘쳐서 버린 프레임 (새 것 또는 오래된 것)
+    uint32_t replaced;                        // DL_DROP_REPLACE로 덮어쓴 프레임
+    uint32_t sent;
+    uint32_t sent_bytes;                      // 링크 프레임 바이트
+} dl_class_stats_t;
+
+typedef struct {
+    dl_class_config_t config;
+    uint8_t head, count;
+    int32_t deficit;                          // DRR 잔여 바이트
+    dl_class_stats_t stats;
+} dl_class_t;
+
+typedef struct {
+    dl_class_t cls[DL_SCHED_MAX_CLASSES];
+    uint8_t count;
+    uint8_t rr;                               // DRR 현재 클래스
+    bool rr_credited;                         // 현재 클래스가 이번 방문에서 quantum을 받았는지
+    uint16_t tx_seq;                          // 다음 송신 seq
+} dl_sched_t;
+
+/**
+ * @brief 스케줄러를 초기화합니다.
+ *
+ * @param classes 클래스 설정 count개 (복사함). 클래스 번호는 배열 순서, strict 클래스끼리는 앞이 우선.
+ * @return 설정이 잘못되면 false (슬롯 0, 가중치 0, 프레임 크기가 헤더보다 작거나 링크 최대보다 큼 등).
+ */
+bool dl_sched_init(dl_sched_t *s, const dl_class_config_t *classes, uint8_t count);
+
+/**
+ * @brief 메시지 프레임을 클래스 큐에 넣습니다 (seq 필드는 꺼낼 때 덮어씀).
+ *
+ * @return 이 프레임이 큐에 들어갔으면 true. DL_DROP_NEWEST로 버렸거나 크기가 맞지 않으면 false.
+ */
+bool dl_sched_enqueue(dl_sched_t *s, uint8_t cls, const uint8_t *frame, uint32_t len);
+
+/**
+ * @brief 다음에 보낼 프레임을 꺼내 링크 프레임으로 만듭니다 (무선 모듈이 받을 준비가 됐을 때 호출).
+ *
+ * @param out 출력 버퍼 (LINK_FRAME_MAX_BYTES 이상).
+ * @param cap out 크기.
+ * @param cls_out 꺼낸 클래스 (NULL 가능).
+ * @param seq_out 매긴 seq (NULL 가능).
+ * @return 링크 프레임 길이, 보낼 것이 없거나 cap이 모자라면 0.
+ */
+uint32_t dl_sched_dequeue(dl_sched_t *s, uint8_t *out, uint32_t cap, uint8_t *cls_out, uint16_t *seq_out);
+
+/**
+ * @brief 전체 대기 프레임 수.
+ */
+uint32_t dl_sched_pending(const dl_sched_t *s);
+
+#endif // DL_SCHED_H_
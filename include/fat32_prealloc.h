@@ -0,0 +1,47 @@
+#ifndef FAT32_PREALLOC_H_
+#define FAT32_PREALLOC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 연속된 섹터로 이루어진 파일의 위치.
+ */
+typedef struct {
+    uint32_t first_lba;      // 파일 첫 섹터 (카드 기준 절대 LBA)
+    uint32_t block_count;    // 파일에 할당된 섹터 수
+    uint32_t first_cluster;
+} fat32_extent_t;
+
+/**
+ * @brief FAT32 루트 디렉터리에 연속된 클러스터로 이루어진 파일을 미리 할당합니다.
+ *
+ * 부팅 시 한 번 호출하며, 이후에는 extent의 섹터에 직접 쓰면 되므로
+ * 비행 중 FAT/디렉터리 갱신이 필요 없습니다.
+ * 같은 이름의 파일이 이미 있고 연속이며 충분히 크면 그대로 재사용하고 (더 길면 남는 클러스터는 해제),
+ * 아니면 기존 클러스터를 해제한 뒤 새로 할당합니다.
+ * 파일 크기는 할당한 전체 크기로 기록되며 클러스터 체인 길이와 항상 같습니다.
+ *
+ * 파티션 테이블(MBR 첫 번째 FAT32 파티션)과 파티션 없는 볼륨을 모두 지원하며,
+ * 섹터 크기는 512바이트만 지원합니다. sd_block_read/write를 사용합니다.
+ *
+ * @param name83 8.3 형식의 11자 이름 (예: "FLIGHT  LOG", 공백 패딩, 대문자).
+ * @param bytes 필요한 크기 (클러스터 단위로 올림).
+ * @param extent 할당된 파일 위치.
+ * @return 성공 시 true, 실패 시 false (FAT32 아님, 연속 공간 부족, 루트 디렉터리 가득 참,
+ *         클러스터 단위로 올린 크기가 4 GiB 이상 등).
+ */
+bool fat32_prealloc_contiguous(const char name83[11], uint32_t bytes, fat32_extent_t *extent);
+
+/**
+ * @brief 루트 디렉터리에서 연속 파일을 찾아 위치를 돌려줍니다 (읽기 전용).
+ *
+ * 로그 오프로드처럼 기록된 파일을 섹터 단위로 읽을 때 사용합니다.
+ *
+ * @param name83 8.3 형식의 11자 이름.
+ * @param extent 파일 위치.
+ * @return 파일이 있고 클러스터가 연속이면 true.
+ */
+bool fat32_find_contiguous(const char name83[11], fat32_extent_t *extent);
+
+#endif // FAT32_PREALLOC_H_
@@ -0,0 +1,110 @@
+#ifndef FLIGHT_CTRL_H_
+#define FLIGHT_CTRL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "flight_record.h"
+#include "guidance.h"
+#include "magcal.h"
+
+/*
+ * 비행 제어 (단계 판정 + 낙하산 사출 + 하강 중 방위 유지 조향).
+ *
+ * 제어 주기마다 센서 원시값(flight_record_t)을 하나 받아 상태를 갱신하고 서보 명령을
+ * servo_set()으로 냅니다. 하드웨어를 직접 건드리지 않으므로 호스트 SIL 시뮬레이터
+ * (host/sil_sim)에서 같은 코드를 그대로 실행할 수 있습니다.
+ *
+ *   PAD     : 기준 기압을 평균하며 대기. 가속도 > LAUNCH_G 가 연속되면 ASCENT
+ *   ASCENT  : 최고 고도보다 APOGEE_DROP_M 이상 내려가거나 하강 속도가 연속되면
+ *             (또는 DEPLOY_TIMEOUT) 사출 서보를 열고 DESCENT
+ *   DESCENT : 자기장 방위를 target_heading_deg 로 유지하도록 좌/우 브레이크 서보 차동 조향.
+ *             guided 설정이면 GPS 해(flight_ctrl_gps)를 받는 동안 착지 목표점으로 유도(guidance.h).
+ *             고도 변화가 LANDED_S 동안 없으면 LANDED
+ *   LANDED  : 조향 서보 중립
+ */
+
+// --- 설정값 ---
+#define FLIGHT_CTRL_LAUNCH_G 3.0f
+#define FLIGHT_CTRL_LAUNCH_SAMPLES 3
+#define FLIGHT_CTRL_APOGEE_DROP_M 2.0f
+#define FLIGHT_CTRL_APOGEE_SAMPLES 3
+#define FLIGHT_CTRL_DEPLOY_MIN_US 1000000u     // 발사 후 이 시간 전에는 사출하지 않음 (모터 연소 중)
+#define FLIGHT_CTRL_DEPLOY_TIMEOUT_US 20000000u
+#define FLIGHT_CTRL_LANDED_SPEED_MPS 0.5f
+#define FLIGHT_CTRL_LANDED_US 2000000u
+
+// 서보 각도 (도)
+#define FLIGHT_CTRL_DEPLOY_CLOSED_DEG 0
+#define FLIGHT_CTRL_DEPLOY_OPEN_DEG 180
+#define FLIGHT_CTRL_STEER_NEUTRAL_DEG 90
+#define FLIGHT_CTRL_STEER_RANGE_DEG 60        // 중립 기준 최대 차동
+
+// 조향 법칙: 방위 오차(도) -> 목표 선회율(dps) -> 차동 명령
+#define FLIGHT_CTRL_HEADING_GAIN 0.5f         // dps / 도
+#define FLIGHT_CTRL_MAX_TURN_DPS 20.0f
+#define FLIGHT_CTRL_RATE_GAIN 0.05f           // 차동(-1..1) / dps
+
+// 지자기 보정 (magcal.h): 원시값 범위 |mag| < 2^SHIFT, 조향 서보 두 개의 부하를 오프셋 입력으로
+#define FLIGHT_CTRL_MAG_INPUT_SHIFT 10
+
+typedef enum {
+    FLIGHT_PHASE_PAD,
+    FLIGHT_PHASE_ASCENT,
+    FLIGHT_PHASE_DESCENT,
+    FLIGHT_PHASE_LANDED,
+} flight_phase_t;
+
+typedef struct {
+    uint16_t steer_left_gpio;     // 왼쪽 브레이크 라인 서보 (당기면 왼쪽(반시계)으로 선회)
+    uint16_t steer_right_gpio;
+    uint16_t deploy_gpio;         // 낙하산 사출 서보
+    float target_heading_deg;     // 0 = 북, 시계 방향 (유도하지 않을 때 / GPS 해가 없을 때)
+    int32_t target_lat_e7;        // 착지 목표점 (1e-7 도), guided일 때
+    int32_t target_lon_e7;
+    bool guided;
+} flight_ctrl_config_t;
+
+typedef struct {
+    flight_ctrl_config_t config;
+    flight_phase_t phase;
+    uint32_t last_us;             // 직전 샘플 시각
+    uint32_t phase_us;            // 현재 단계 진입 시각
+    uint32_t still_us;            // 하강 중 정지 상태가 이어진 시간
+    float p0_pa;                  // 기준 기압 (PAD 동안 평균)
+    float alt_m, vel_mps;         // 기압 + 가속도 상보 필터
+    float max_alt_m;
+    float heading_deg;            // 자기장 방위
+    float steer;                  // 마지막 차동 명령 (-1..1, + = 시계 방향 선회)
+    uint8_t count;                // 단계 전환 조건이 연속된 샘플 수
+    guidance_t guidance;
+    magcal_t magcal;              // 매 주기 갱신, 방위는 보정된 자기장으로 계산
+    uint16_t steer_level_neutral[2], steer_level_span[2];  // 조향 서보 부하 정규화 (중립 / 최대 차동 레벨 차)
+} flight_ctrl_t;
+
+/**
+ * @brief 서보 세 개를 초기화하고 PAD 단계에서 시작합니다.
+ *
+ * 사출 서보는 닫힘, 조향 서보는 중립으로 둡니다. 지자기 보정은 처음부터 다시 학습합니다.
+ *
+ * @return 서보 초기화 실패 시 false.
+ */
+bool flight_ctrl_init(flight_ctrl_t *c, const flight_ctrl_config_t *config);
+
+/**
+ * @brief 제어 주기 한 번을 실행합니다 (APP_CONTROL_PERIOD_MS 마다).
+ *
+ * @param sample 이번 주기의 센서 원시값. timestamp_us 간격으로 적분합니다.
+ */
+void flight_ctrl_step(flight_ctrl_t *c, const flight_record_t *sample);
+
+/**
+ * @brief GPS 항법 해를 받습니다 (수신기 갱신 주기마다). guided 설정이 아니면 무시합니다.
+ */
+void flight_ctrl_gps(flight_ctrl_t *c, const guidance_fix_t *fix);
+
+/**
+ * @brief 서보를 해제합니다 (시뮬레이터에서 비행을 반복할 때).
+ */
+void flight_ctrl_deinit(flight_ctrl_t *c);
+
+#endif // FLIGHT_CTRL_H_
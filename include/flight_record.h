@@ -0,0 +1,23 @@
+#ifndef FLIGHT_RECORD_H_
+#define FLIGHT_RECORD_H_
+
+#include <stdint.h>
+#include "collog.h"
+
+// 1 kHz 비행 레코드 (IMU / 기압 / 서보 출력). 32 바이트, 패딩 없음
+typedef struct {
+    uint32_t timestamp_us;    // 71.6분마다 한 바퀴 (collog가 바퀴 수를 청크에 기록)
+    int32_t pressure_pa;
+    int16_t accel[3];         // 2048 LSB/g
+    int16_t gyro[3];
+    int16_t mag[3];
+    uint16_t servo_level[2];  // PWM 레벨
+    uint16_t seq;
+} flight_record_t;
+
+#define FLIGHT_RECORD_CHANNEL_COUNT 14
+
+// collog 채널 정의 (채널 0 = timestamp_us)
+extern const collog_channel_t flight_record_channels[FLIGHT_RECORD_CHANNEL_COUNT];
+
+#endif // FLIGHT_RECORD_H_
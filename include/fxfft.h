@@ -0,0 +1,42 @@
+#ifndef FXFFT_H_
+#define FXFFT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 고정소수점 복소 FFT (Q15, 제자리, 기수 4 + 필요하면 마지막 기수 2 단).
+ *
+ * 기수 4 DIF 나비의 출력을 (0, 2, 1, 3) 순서로 두면 기수 2 두 단과 같은 배치가 되므로,
+ * log2(n)이 홀수일 때 마지막에 기수 2 단 하나를 붙이고 끝에서 비트 역순 정렬 한 번으로 끝납니다.
+ *
+ * 오버플로는 블록 부동소수점으로 막습니다: 각 단 전에 데이터 크기를 보고 필요한 만큼만
+ * 오른쪽으로 밀고(반올림) 그 횟수를 지수로 돌려줍니다. 작은 진동 신호도 정밀도를 잃지 않습니다.
+ *
+ * 곱셈은 모두 16 x 16 -> 32비트 (Cortex-M0+ 1사이클 MULS), 회전 인자는 fxmath의 cos로
+ * 채운 FXFFT_MAX_SIZE 크기 표(4 KB)를 간격을 두고 읽습니다.
+ */
+
+// --- 설정값 ---
+#define FXFFT_MAX_LOG2 11
+#define FXFFT_MAX_SIZE (1 << FXFFT_MAX_LOG2)  // 2048
+
+typedef struct {
+    int16_t re, im;
+} fxfft_cpx_t;
+
+/**
+ * @brief 회전 인자 표를 채웁니다. 시작 시 한 번 (안 하면 첫 fxfft_forward()에서 채움).
+ */
+void fxfft_init(void);
+
+/**
+ * @brief 정방향 FFT X[k] = sum x[i] e^(-j 2 pi i k / n) 를 제자리에서 계산합니다.
+ *
+ * @param x n개 복소 샘플 (Q15). 결과는 자연 순서 (비트 역순 정렬까지 끝난 상태).
+ * @param log2n 4 ~ FXFFT_MAX_LOG2 (n = 16 ~ 2048).
+ * @return 블록 지수 e (실제 X[k] = x[k] x 2^e), log2n이 범위를 벗어나면 -1.
+ */
+int fxfft_forward(fxfft_cpx_t *x, uint8_t log2n);
+
+#endif // FXFFT_H_
@@ -0,0 +1,130 @@
+#ifndef FXFILTER_H_
+#define FXFILTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 고정소수점 필터 (고속 ADC / IMU 스트림 데시메이션용).
+ *
+ * 모든 필터는 int16_t 샘플 블록을 제자리(in place)에서 처리합니다. 데시메이터는 출력을
+ * 버퍼 앞쪽부터 덮어쓰고 출력 개수를 돌려줍니다 (출력 j는 입력 j x factor 이후에만 쓰므로 안전).
+ *
+ * Cortex-M0+의 곱셈기는 32x32 -> 32비트(1사이클)뿐이라 64비트 곱은 라이브러리 호출이 됩니다.
+ * 그래서 곱셈은 모두 16비트 샘플 x 16비트 계수 -> 32비트로 하고, 합은 부호 없는 32비트로
+ * 더해 중간 오버플로가 최종 결과에서 상쇄되도록 합니다 (2의 보수 모듈러 산술).
+ *
+ *   바이쿼드  : 2차 IIR 직렬 연결, 직접형 I, 계수 Q14 (|a1| < 2), 1차 오차 되먹임(잡음 정형)
+ *   FIR       : 다상(polyphase) 데시메이터. 버리는 출력은 계산하지 않아 입력 샘플당 탭/factor 회 곱셈.
+ *               탭 Q15, 탭 절댓값 합 < 2
+ *   CIC       : N차 적분-빗 데시메이터 (곱셈 없음, 차분 지연 1). 16 + N x ceil(log2 R) <= 32비트
+ */
+
+// --- 설정값 ---
+#define FXFILTER_MAX_BIQUADS 4                // 8차까지
+#define FXFILTER_MAX_TAPS 64
+#define FXFILTER_CIC_MAX_ORDER 4
+#define FXFILTER_COEF_SHIFT 14                // 바이쿼드 계수 Q14
+
+// --- 바이쿼드 ---
+
+// y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2 (Q14, a0 = 1)
+typedef struct {
+    int32_t b0, b1, b2, a1, a2;
+} fxfilter_biquad_coef_t;
+
+typedef struct {
+    fxfilter_biquad_coef_t coef[FXFILTER_MAX_BIQUADS];
+    int16_t x1[FXFILTER_MAX_BIQUADS], x2[FXFILTER_MAX_BIQUADS];
+    int16_t y1[FXFILTER_MAX_BIQUADS], y2[FXFILTER_MAX_BIQUADS];
+    int32_t err[FXFILTER_MAX_BIQUADS];        // 지난 출력에서 버린 하위 비트
+    uint8_t stages;
+} fxfilter_biquad_t;
+
+/**
+ * @brief 버터워스 저역 통과 필터 계수를 구합니다 (2차 x stages 직렬. 부동소수점 연산이므로 초기화 때 한 번).
+ *
+ * @param coef stages개 계수를 받을 배열.
+ * @param stages 2차 구간 수 (차수 = 2 x stages).
+ * @param fc_ratio 차단 주파수 / 샘플링 주파수 (0 ~ 0.5).
+ * @return 인자가 범위를 벗어나면 false.
+ */
+bool fxfilter_design_butter_lowpass(fxfilter_biquad_coef_t *coef, uint8_t stages, float fc_ratio);
+
+/**
+ * @brief 노치 필터 계수를 구합니다 (서보/모터 진동 제거 등).
+ *
+ * @param q 선택도 (중심 주파수 / -3 dB 대역폭).
+ */
+bool fxfilter_design_notch(fxfilter_biquad_coef_t *coef, float f0_ratio, float q);
+
+/**
+ * @brief 계수를 복사하고 상태를 0으로 초기화합니다.
+ *
+ * @return stages가 0이거나 FXFILTER_MAX_BIQUADS보다 크면 false.
+ */
+bool fxfilter_biquad_init(fxfilter_biquad_t *f, const fxfilter_biquad_coef_t *coef, uint8_t stages);
+
+/**
+ * @brief 블록을 제자리에서 필터링합니다 (출력은 int16_t 범위로 포화).
+ */
+void fxfilter_biquad_process(fxfilter_biquad_t *f, int16_t *buf, size_t n);
+
+// --- FIR 데시메이터 ---
+
+typedef struct {
+    int16_t taps[FXFILTER_MAX_TAPS];          // 역순 저장 (가장 최근 샘플에 곱할 탭이 마지막)
+    int16_t hist[2 * FXFILTER_MAX_TAPS];      // 같은 샘플을 두 번 저장해 창이 끊기지 않음
+    uint16_t ntaps, pos;
+    uint8_t factor, phase;
+} fxfilter_fir_t;
+
+/**
+ * @brief 창 함수(Hamming) 방식 저역 통과 FIR 탭을 구합니다. DC 이득이 정확히 1(탭 합 32768)이 되도록 맞춥니다.
+ *
+ * @param fc_ratio 차단 주파수 / 입력 샘플링 주파수. 데시메이션 factor면 0.5 / factor 이하로.
+ */
+bool fxfilter_design_fir_lowpass(int16_t *taps, uint16_t ntaps, float fc_ratio);
+
+/**
+ * @brief FIR 데시메이터를 초기화합니다 (factor = 1이면 일반 FIR).
+ *
+ * @param taps Q15 탭 (h[0]이 가장 최근 샘플에 곱해짐).
+ * @return ntaps가 0이거나 FXFILTER_MAX_TAPS보다 크거나 factor가 0이면 false.
+ */
+bool fxfilter_fir_init(fxfilter_fir_t *f, const int16_t *taps, uint16_t ntaps, uint8_t factor);
+
+/**
+ * @brief 블록을 필터링/데시메이션합니다.
+ *
+ * @return buf 앞쪽에 쓴 출력 샘플 수 (블록 경계와 무관하게 입력 factor개마다 하나).
+ */
+size_t fxfilter_fir_process(fxfilter_fir_t *f, int16_t *buf, size_t n);
+
+// --- CIC 데시메이터 ---
+
+typedef struct {
+    uint32_t integ[FXFILTER_CIC_MAX_ORDER], comb[FXFILTER_CIC_MAX_ORDER];
+    uint16_t factor, count;
+    uint8_t order, shift;
+    int32_t gain_q14;                         // 2^shift / R^N (DC 이득 1로 정규화)
+} fxfilter_cic_t;
+
+/**
+ * @brief CIC 데시메이터를 초기화합니다.
+ *
+ * @param order 적분기/빗 단 수 N (1 ~ FXFILTER_CIC_MAX_ORDER).
+ * @param factor 데시메이션 비율 R (2 이상).
+ * @return 레지스터 폭 16 + N x ceil(log2 R)이 32비트를 넘으면 false.
+ */
+bool fxfilter_cic_init(fxfilter_cic_t *f, uint8_t order, uint16_t factor);
+
+/**
+ * @brief 블록을 데시메이션합니다.
+ *
+ * @return buf 앞쪽에 쓴 출력 샘플 수.
+ */
+size_t fxfilter_cic_process(fxfilter_cic_t *f, int16_t *buf, size_t n);
+
+#endif // FXFILTER_H_
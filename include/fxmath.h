@@ -0,0 +1,106 @@
+#ifndef FXMATH_H_
+#define FXMATH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 고정소수점 삼각 함수 / 제곱근 (RP2040에는 FPU가 없어 float 삼각 함수는 소프트웨어 에뮬레이션).
+ *
+ *   각도   : 16비트 이진 각도 fx_angle_t (65536 = 360도). 뺄셈 결과를 int16_t로 보면 -180~180도
+ *   sin/cos: Q15 (32767 = 1.0)
+ *   atan2  : 정수 벡터 (x, y) -> x축에서 y축 방향 각도. 크기(hypot)도 같이 구할 수 있음
+ *
+ * 구현이 두 가지 있습니다.
+ *   CORDIC : 시프트/덧셈 FXMATH_CORDIC_ITERATIONS 회. 표가 필요 없음 (약 100 바이트)
+ *   LUT    : 2^FXMATH_LUT_BITS 구간 표 + 선형 보간. 곱셈/나눗셈 몇 번으로 끝나 더 빠름
+ *            (표 세 개, 기본 8비트에서 RAM 약 1.5 KB). 표는 fxmath_init()에서 CORDIC으로 채움
+ * fx_sin(), fx_atan2() 등 접미사 없는 함수는 FXMATH_USE_LUT로 고른 구현을 씁니다.
+ * 두 구현 모두 명시적으로 호출할 수도 있습니다 (벤치마크, 정밀도 비교).
+ */
+
+// --- 설정값 (컴파일 시 -D로 변경) ---
+#ifndef FXMATH_USE_LUT
+#define FXMATH_USE_LUT 1
+#endif
+#ifndef FXMATH_CORDIC_ITERATIONS
+#define FXMATH_CORDIC_ITERATIONS 18           // 1 ~ 24. 18이면 sin/cos, atan2 모두 오차 1 LSB 이내
+#endif
+#ifndef FXMATH_LUT_BITS
+#define FXMATH_LUT_BITS 8                     // 4 ~ 12. 사분면(sin) / 팔분원(atan) 당 구간 수의 log2
+#endif
+
+typedef uint16_t fx_angle_t;
+
+#define FX_ANGLE_90 16384
+#define FX_ANGLE_FROM_DEG(deg) ((fx_angle_t)(int32_t)((deg) * (65536.0f / 360.0f)))
+#define FX_ANGLE_TO_DEG(a) ((float)(a) * (360.0f / 65536.0f))
+
+/**
+ * @brief LUT 구현의 표를 채웁니다. LUT 함수를 쓰기 전에 호출해야 합니다 (두 번째 호출부터는 바로 반환).
+ *
+ * 표를 쓰는 모듈의 초기화 함수(flight_ctrl_init, guidance_init, fxfft_init, servo_dyn_record)가 호출합니다.
+ * 호출 전에는 표가 0이라 sin/cos/atan2가 0을 돌려줍니다 (DEBUG_FXMATH면 경고 후 채움).
+ */
+void fxmath_init(void);
+
+// --- CORDIC ---
+
+void fx_sincos_cordic(fx_angle_t a, int16_t *sin_q15, int16_t *cos_q15);
+
+/**
+ * @brief atan2(y, x)와 sqrt(x^2 + y^2).
+ *
+ * @param mag NULL이 아니면 벡터 크기 (입력과 같은 단위, 내림).
+ * @return (0, 0)이면 0.
+ */
+fx_angle_t fx_atan2_cordic(int32_t y, int32_t x, uint32_t *mag);
+
+// --- LUT ---
+
+void fx_sincos_lut(fx_angle_t a, int16_t *sin_q15, int16_t *cos_q15);
+fx_angle_t fx_atan2_lut(int32_t y, int32_t x, uint32_t *mag);
+
+/**
+ * @brief 정수 제곱근 (내림). 비트 단위 16회 반복.
+ */
+uint32_t fx_isqrt(uint32_t v);
+
+// --- 설정한 구현 ---
+
+static inline void fx_sincos(fx_angle_t a, int16_t *sin_q15, int16_t *cos_q15) {
+#if FXMATH_USE_LUT
+    fx_sincos_lut(a, sin_q15, cos_q15);
+#else
+    fx_sincos_cordic(a, sin_q15, cos_q15);
+#endif
+}
+
+static inline int16_t fx_sin(fx_angle_t a) {
+    int16_t s, c;
+    fx_sincos(a, &s, &c);
+    return s;
+}
+
+static inline int16_t fx_cos(fx_angle_t a) {
+    int16_t s, c;
+    fx_sincos(a, &s, &c);
+    return c;
+}
+
+static inline fx_angle_t fx_atan2(int32_t y, int32_t x, uint32_t *mag) {
+#if FXMATH_USE_LUT
+    return fx_atan2_lut(y, x, mag);
+#else
+    return fx_atan2_cordic(y, x, mag);
+#endif
+}
+
+static inline uint32_t fx_hypot(int32_t x, int32_t y) {
+    uint32_t mag;
+    fx_atan2(y, x, &mag);
+    return mag;
+}
+
+#endif // FXMATH_H_
@@ -0,0 +1,113 @@
+#ifndef GUIDANCE_H_
+#define GUIDANCE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fxmath.h"
+
+/*
+ * 파라포일 유도 (하강 중 착지 목표점으로 브레이크 라인 조향).
+ *
+ * 정수 고정소수점만 사용합니다 (RP2040에는 FPU가 없음).
+ *   각도 : 16비트 이진 각도 (65536 = 360도, 0 = 북, 시계 방향). 뺄셈 결과를 int16_t로 보면 -180~180도
+ *   위치 : 목표점 기준 지역 좌표 (cm, 동/북)
+ *   브레이크 : Q15 (0 = 풀림, 32767 = 최대 당김)
+ *
+ * GPS 해(guidance_fix)가 들어올 때만 기하 계산(방위각/거리/지상 항적, fxmath)을 하고,
+ * 제어 주기마다의 guidance_step()은 GPS 해 이후 자기 방위가 바뀐 만큼 항적 오차를 갱신해
+ * 브레이크를 정하므로 삼각 함수 없이 덧셈/곱셈 몇 번으로 끝납니다.
+ *
+ * 경유점을 순서대로 지나간 뒤(반경 안에 들어오거나 구간 끝 수직선을 넘으면 다음 경유점)
+ * 목표점으로 향합니다. 경유점은 GPS 지상 항적으로 추적합니다. 목표점은 GPS 속도와 자기 방위로
+ * 추정한 바람에 착지까지 밀릴 거리만큼 바람 반대쪽으로 옮겨 자기 방위로 추적하고, 남은 고도로
+ * 갈 수 있는 거리가 충분히 남으면 그 주위를 선회하며 고도를 버립니다.
+ * 목표점 고도는 발사대와 같다고 가정합니다.
+ */
+
+// --- 설정값 ---
+#define GUIDANCE_MAX_WAYPOINTS 8              // 목표점 제외
+#define GUIDANCE_ACCEPT_RADIUS_CM 1500        // 경유점 도달 반경
+#define GUIDANCE_LOITER_RADIUS_CM 1500        // 목표점 선회 반경
+#define GUIDANCE_MIN_GROUND_SPEED_CMS 30      // 이보다 느리면 지상 항적 대신 자기 방위로 조향
+#define GUIDANCE_MIN_SINK_CMS 50              // 이보다 느리게 내려가면 바람/도달 거리 계산 안 함
+#define GUIDANCE_GLIDE_RATIO_Q8 90            // 수평 대기 속도 / 하강 속도 (0.35)
+#define GUIDANCE_WIND_FILTER_SHIFT 4          // 바람 추정 저역 통과 (GPS 해 16개, 5 Hz에서 약 3 s)
+#define GUIDANCE_FIX_TIMEOUT_STEPS 100        // GPS 해 없이 이만큼 주기가 지나면 유도 중단
+
+// 조향 법칙 (flight_ctrl의 방위 유지 법칙과 같은 이득): 항적 오차 -> 목표 선회율 -> 차동 브레이크
+#define GUIDANCE_TURN_GAIN_Q8 128             // (각도/s) / 각도, 0.5
+#define GUIDANCE_MAX_TURN_RATE 3641           // 각도/s, 20 dps
+#define GUIDANCE_RATE_GAIN_Q15 9              // 차동(Q15) / (각도/s), 0.05 / dps
+
+typedef enum {
+    GUIDANCE_MODE_NO_FIX,     // GPS 해를 아직 받지 못했거나 끊김
+    GUIDANCE_MODE_WAYPOINT,   // 경유점으로 이동
+    GUIDANCE_MODE_HOMING,     // 목표점으로 직진
+    GUIDANCE_MODE_LOITER,     // 목표점 주위 선회 (고도 소모)
+} guidance_mode_t;
+
+// GPS 수신기 항법 해 (u-blox NAV-PVT 단위)
+typedef struct {
+    int32_t lat_e7, lon_e7;       // 1e-7 도
+    int32_t vel_n_cms, vel_e_cms; // 지상 속도 (cm/s)
+} guidance_fix_t;
+
+typedef struct {
+    int32_t lat0_e7, lon0_e7;     // 목표점 (지역 좌표 원점)
+    int32_t lon_scale_q16;        // 경도 1e-7 도당 cm (Q16, cos(위도) 반영)
+    int32_t wp_e[GUIDANCE_MAX_WAYPOINTS], wp_n[GUIDANCE_MAX_WAYPOINTS];
+    uint8_t wp_count, wp_index;   // wp_index == wp_count 이면 목표점으로 향함
+    int32_t leg_e, leg_n;         // 현재 구간 시작점
+    guidance_mode_t mode;
+    int32_t pos_e, pos_n;         // 마지막 GPS 위치
+    uint32_t dist_cm;             // 현재 경유점/목표점(공기 기준)까지 거리
+    uint32_t ground_speed_cms;
+    int32_t wind_e_cms, wind_n_cms; // 추정 바람
+    uint16_t bearing;             // 현재 경유점/목표점 방위각
+    uint16_t desired;             // 원하는 지상 항적 (경유점) / 자기 방위 (목표점)
+    uint16_t heading_at_fix;      // GPS 해 시점의 자기 방위
+    int16_t track_err_at_fix;     // GPS 해 시점의 desired - (지상 항적 또는 자기 방위)
+    uint16_t steps_since_fix;
+    bool have_fix;
+} guidance_t;
+
+typedef struct {
+    int16_t track_err;            // 원하는 항적 - 현재 항적 (이진 각도)
+    int32_t turn_rate_cmd;        // 목표 선회율 (이진 각도/s, + = 시계 방향)
+    int16_t brake_left_q15, brake_right_q15;
+} guidance_output_t;
+
+/**
+ * @brief 착지 목표점을 정하고 경유점을 비웁니다.
+ */
+void guidance_init(guidance_t *g, int32_t target_lat_e7, int32_t target_lon_e7);
+
+/**
+ * @brief 목표점 앞에 지나갈 경유점을 추가합니다 (추가한 순서대로 방문).
+ *
+ * @param east_cm 목표점 기준 동쪽 거리 (cm).
+ * @param north_cm 목표점 기준 북쪽 거리 (cm).
+ * @return 경유점이 GUIDANCE_MAX_WAYPOINTS 개를 넘으면 false.
+ */
+bool guidance_add_waypoint(guidance_t *g, int32_t east_cm, int32_t north_cm);
+
+/**
+ * @brief 새 GPS 해로 위치, 경유점 진행, 원하는 항적을 갱신합니다 (GPS 갱신 주기마다).
+ *
+ * @param heading 이 시점의 자기 방위 (이진 각도).
+ * @param height_cm 목표점 위 고도 (cm).
+ * @param sink_cms 하강 속도 (cm/s, 내려가면 +).
+ */
+void guidance_fix(guidance_t *g, const guidance_fix_t *fix, uint16_t heading, int32_t height_cm, int32_t sink_cms);
+
+/**
+ * @brief 제어 주기 한 번: 자기 방위와 선회율로 브레이크 당김 양을 정합니다.
+ *
+ * @param heading 자기 방위 (이진 각도).
+ * @param yaw_rate 선회율 (이진 각도/s, + = 시계 방향).
+ * @return GPS 해가 없거나 끊겨 유도할 수 없으면 false (out은 브레이크 0).
+ */
+bool guidance_step(guidance_t *g, uint16_t heading, int32_t yaw_rate, guidance_output_t *out);
+
+#endif // GUIDANCE_H_
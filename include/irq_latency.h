@@ -0,0 +1,56 @@
+#ifndef IRQ_LATENCY_H_
+#define IRQ_LATENCY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "latency_hist.h"
+
+// --- 설정값 ---
+// GPIO 소스 히스토그램 구간 폭 (CPU 사이클)
+#define IRQ_LATENCY_GPIO_BIN_CYCLES 4
+// 타이머 소스 히스토그램 구간 폭 (us, 타이머 분해능이 1us)
+#define IRQ_LATENCY_TIMER_BIN_US 1
+
+// 인터럽트 발생 소스
+typedef enum {
+    IRQ_LATENCY_SRC_GPIO = 0,  // 출력 핀 -> 입력 핀 점퍼 루프백 엣지 (SysTick 사이클 단위)
+    IRQ_LATENCY_SRC_TIMER,     // 하드웨어 타이머 알람 0 (us 단위)
+} irq_latency_source_t;
+
+// core 1에서 돌리는 배경 부하
+typedef enum {
+    IRQ_LATENCY_LOAD_NONE = 0,
+    IRQ_LATENCY_LOAD_FLASH,    // 플래시 마지막 섹터 반복 erase/program (core 0 lockout 발생)
+    IRQ_LATENCY_LOAD_DMA,      // 메모리 -> 메모리 DMA 연속 전송 (버스 경합)
+    IRQ_LATENCY_LOAD_UART,     // uart1 연속 송신
+    IRQ_LATENCY_LOAD_COUNT
+} irq_latency_load_t;
+
+typedef struct {
+    irq_latency_source_t source;
+    irq_latency_load_t load;
+    uint32_t samples;          // 측정 횟수
+    uint16_t trigger_gpio;     // GPIO 소스: 엣지를 만드는 출력 핀
+    uint16_t sense_gpio;       // GPIO 소스: 인터럽트를 받는 입력 핀 (trigger_gpio와 점퍼 연결)
+    uint32_t period_us;        // 샘플 사이 간격
+} irq_latency_config_t;
+
+/**
+ * @brief 인터럽트 진입 지연을 측정해 히스토그램에 누적합니다 (core 0에서 호출).
+ *
+ * 배경 부하는 core 1에서 실행되며 측정이 끝나면 core 1은 리셋됩니다.
+ * 진입 시각은 핸들러 첫 명령에서 기록하고, 히스토그램 갱신은 핸들러 밖에서 합니다.
+ *
+ * @param config 측정 설정.
+ * @param hist 결과 히스토그램 (함수 안에서 reset 됨).
+ * @return 성공 시 true, 실패 시 false (잘못된 설정, 응답 없는 인터럽트 등).
+ */
+bool irq_latency_run(const irq_latency_config_t *config, latency_hist_t *hist);
+
+/**
+ * @brief 소스/부하 열거값을 JSON 출력용 이름으로 변환합니다.
+ */
+const char *irq_latency_source_name(irq_latency_source_t source);
+const char *irq_latency_load_name(irq_latency_load_t load);
+
+#endif // IRQ_LATENCY_H_
@@ -0,0 +1,62 @@
+#ifndef LATENCY_HIST_H_
+#define LATENCY_HIST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- 설정값 ---
+// 히스토그램 구간(bin) 개수. 마지막 구간을 넘는 값은 overflow로 집계됨
+#define LATENCY_HIST_BINS 64
+
+/**
+ * @brief 지연 시간 히스토그램.
+ *
+ * 단위(사이클, us, ns 등)는 호출자가 정하며 bin_width도 같은 단위를 사용합니다.
+ * 동적 메모리를 사용하지 않으므로 타깃과 호스트 양쪽에서 그대로 사용할 수 있습니다.
+ */
+typedef struct {
+    uint32_t bin_width;                 // 구간 하나의 폭
+    uint32_t bins[LATENCY_HIST_BINS];   // 구간별 샘플 수
+    uint32_t overflow;                  // bin_width * LATENCY_HIST_BINS 이상인 샘플 수
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} latency_hist_t;
+
+/**
+ * @brief 히스토그램을 비우고 구간 폭을 설정합니다.
+ *
+ * @param hist 대상 히스토그램.
+ * @param bin_width 구간 폭 (0이면 1로 취급).
+ */
+void latency_hist_reset(latency_hist_t *hist, uint32_t bin_width);
+
+/**
+ * @brief 샘플 하나를 히스토그램에 추가합니다.
+ *
+ * 인터럽트 핸들러에서 호출하지 않도록 합니다 (핸들러는 타임스탬프만 기록).
+ */
+void latency_hist_add(latency_hist_t *hist, uint32_t value);
+
+/**
+ * @brief 누적 분포에서 백분위 값을 구합니다 (구간 상한 기준).
+ *
+ * @param percent 0 ~ 100.
+ * @return 해당 백분위가 속한 구간의 상한. overflow 영역이면 max.
+ */
+uint32_t latency_hist_percentile(const latency_hist_t *hist, uint8_t percent);
+
+/**
+ * @brief 히스토그램을 JSON 한 줄로 stdout에 출력합니다.
+ *
+ * 회귀 추적 스크립트가 줄 단위로 파싱할 수 있도록 개행 하나로 끝납니다.
+ *
+ * @param source 인터럽트 소스 이름 (예: "gpio", "timer").
+ * @param load 배경 부하 이름 (예: "none", "flash").
+ * @param unit 값의 단위 (예: "cycles", "us", "ns").
+ */
+void latency_hist_print_json(const latency_hist_t *hist, const char *source,
+                             const char *load, const char *unit);
+
+#endif // LATENCY_HIST_H_
@@ -0,0 +1,44 @@
+#ifndef LINK_FRAME_H_
+#define LINK_FRAME_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 무선 링크 프레이밍 (펌웨어 송신, 지상국 수신 공용).
+ *
+ *   [COBS( 메시지 프레임 + CRC-32 LE )] 0x00
+ *
+ * 메시지 프레임은 messages.schema의 [u16 id][u16 seq][payload] 입니다.
+ * COBS로 0x00을 없앴으므로 수신 쪽은 0x00만 찾으면 프레임 경계를 되찾을 수 있고,
+ * 깨진 프레임은 CRC에서 걸러집니다.
+ */
+
+// --- 설정값 ---
+#define LINK_FRAME_MAX_PAYLOAD 250 // COBS 코드 블록 하나(254)에 CRC까지 들어가는 크기
+#define LINK_FRAME_MAX_BYTES (LINK_FRAME_MAX_PAYLOAD + 4 + 2) // COBS 오버헤드 1 + 구분자 1
+#define LINK_FRAME_DELIMITER 0x00
+
+/**
+ * @brief 메시지 프레임을 링크 프레임으로 감쌉니다.
+ *
+ * @param frame 메시지 프레임.
+ * @param len 메시지 프레임 길이 (LINK_FRAME_MAX_PAYLOAD 이하).
+ * @param out 출력 버퍼.
+ * @param cap 출력 버퍼 크기.
+ * @return 구분자를 포함한 출력 길이, 공간이 부족하면 0.
+ */
+uint32_t link_frame_encode(const uint8_t *frame, uint32_t len, uint8_t *out, uint32_t cap);
+
+/**
+ * @brief 구분자 사이의 바이트를 메시지 프레임으로 되돌립니다.
+ *
+ * @param in 구분자를 뺀 링크 프레임.
+ * @param len in 길이.
+ * @param out 메시지 프레임 버퍼 (in 과 같은 버퍼여도 됨).
+ * @param cap 출력 버퍼 크기.
+ * @return 메시지 프레임 길이, COBS/CRC 오류면 0.
+ */
+uint32_t link_frame_decode(const uint8_t *in, uint32_t len, uint8_t *out, uint32_t cap);
+
+#endif // LINK_FRAME_H_
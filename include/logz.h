@@ -0,0 +1,123 @@
+#ifndef LOGZ_H_
+#define LOGZ_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 고정 메모리 스트리밍 로그 압축기.
+ *
+ * 로그 생산자와 저장 백엔드(sdlog_write 등) 사이에 들어가는 압축 단계입니다.
+ * 고정 크기 레코드를 받아 필드별 델타 + zigzag 필터를 적용하고, LOGZ_BLOCK_BYTES
+ * 블록이 차면 바이트 열 단위로 전치(shuffle)한 뒤 LZ4 계열(바이트 정렬 토큰,
+ * 4바이트 최소 일치, 해시 1회 탐색) 압축을 해서 프레임 하나로 싱크에 넘깁니다.
+ *
+ *  - 메모리: 작성기 하나당 약 4.2 KB (정적 할당, malloc 없음)
+ *  - 시간: 블록 하나 압축은 입력 바이트마다 해시 탐색 1회라 블록 크기에 비례하는
+ *          상한을 가지며, 레코드 추가(logz_writer_add)는 블록이 찰 때만 압축합니다.
+ *  - 블록마다 해시 테이블과 델타 기준값을 초기화하므로 프레임끼리 독립적입니다.
+ *    싱크가 프레임을 통째로 버려도(sdlog 버퍼 부족) 나머지 프레임은 복원됩니다.
+ *
+ * 프레임 형식 (리틀 엔디언):
+ *   u8 magic(LOGZ_FRAME_MAGIC) | u8 flags | u16 raw_len | u16 payload_len | payload
+ *   flags & LOGZ_FLAG_STORED 이면 payload는 필터/전치만 거친 원본 (압축이 이득 없을 때)
+ */
+
+// --- 설정값 ---
+#define LOGZ_BLOCK_BYTES 1024   // 압축 단위 = 일치 탐색 창 크기
+#define LOGZ_HASH_BITS 10       // 해시 테이블 1024 x u16 = 2 KB
+#define LOGZ_MAX_FIELDS 16
+#define LOGZ_MAX_RECORD 64
+
+#define LOGZ_FRAME_MAGIC 0xC5
+#define LOGZ_FLAG_STORED 0x01
+#define LOGZ_FRAME_HEADER 6
+// 최악의 경우에도 저장(STORED) 프레임으로 떨어지므로 프레임 크기 상한은 고정
+#define LOGZ_FRAME_MAX (LOGZ_FRAME_HEADER + LOGZ_BLOCK_BYTES)
+
+// 레코드 배치: 필드 폭(1, 2, 4, 8 바이트)을 순서대로 나열. 모든 필드가 델타 필터 대상
+typedef struct {
+    uint8_t field_count;
+    uint8_t field_size[LOGZ_MAX_FIELDS];
+} logz_layout_t;
+
+// 프레임 싱크 (sdlog_write와 같은 형식). 프레임은 통째로 받아들이거나 통째로 버려야 함
+typedef bool (*logz_sink_fn)(const void *data, uint32_t len);
+
+typedef struct {
+    uint32_t records_in;
+    uint32_t bytes_in;        // 필터 전 레코드 바이트
+    uint32_t bytes_out;       // 싱크가 받아들인 프레임 바이트 (헤더 포함)
+    uint32_t frames;
+    uint32_t frames_stored;   // 압축 이득이 없어 원본으로 저장한 프레임
+    uint32_t frames_dropped;  // 싱크가 거부한 프레임
+} logz_stats_t;
+
+typedef struct {
+    logz_layout_t layout;
+    uint32_t record_size;
+    logz_sink_fn sink;
+    uint32_t fill;                                  // block 안의 바이트 수
+    uint8_t prev[LOGZ_MAX_RECORD];                  // 델타 기준 (직전 레코드)
+    uint8_t block[LOGZ_BLOCK_BYTES];
+    uint8_t frame[LOGZ_FRAME_MAX];
+    uint16_t hash[1u << LOGZ_HASH_BITS];
+    logz_stats_t stats;
+} logz_writer_t;
+
+/**
+ * @brief 압축 작성기를 초기화합니다.
+ *
+ * @param w 대상 작성기 (정적 할당 권장, 약 4.2 KB).
+ * @param layout 레코드 필드 배치. 필드 폭 합이 레코드 크기입니다.
+ * @param sink 완성된 프레임을 받을 함수.
+ * @return 성공 시 true, 배치가 잘못되었으면 false.
+ */
+bool logz_writer_init(logz_writer_t *w, const logz_layout_t *layout, logz_sink_fn sink);
+
+/**
+ * @brief 레코드 하나를 추가합니다. 블록이 차면 압축해서 싱크로 넘깁니다.
+ *
+ * @param record layout 크기만큼의 레코드.
+ * @return 레코드를 받아들였으면 true. 블록을 넘기다 싱크가 거부하면 false
+ *         (그 블록은 버려지고, 레코드 자체는 새 블록에 들어감).
+ */
+bool logz_writer_add(logz_writer_t *w, const void *record);
+
+/**
+ * @brief 채우던 블록을 즉시 압축해서 넘깁니다 (종료 전, 또는 주기적으로).
+ *
+ * @return 넘길 것이 없거나 싱크가 받아들였으면 true, 거부했으면 false.
+ */
+bool logz_writer_flush(logz_writer_t *w);
+
+/**
+ * @brief 블록 하나를 압축합니다 (저수준).
+ *
+ * @param hash 1 << LOGZ_HASH_BITS 크기의 작업 공간.
+ * @return 압축 크기. 결과가 in_len 이상이 되면 중간에 포기하고 0을 반환합니다.
+ */
+uint32_t logz_compress(const uint8_t *in, uint32_t in_len, uint8_t *out, uint16_t *hash);
+
+/**
+ * @brief logz_compress 결과를 정확히 out_len 바이트로 복원합니다.
+ *
+ * @return 성공 시 true, 데이터가 손상되었으면 false.
+ */
+bool logz_decompress(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len);
+
+/**
+ * @brief 프레임 하나를 레코드로 복원합니다 (지상국/호스트 도구용).
+ *
+ * @param layout 기록할 때와 같은 배치.
+ * @param frame 프레임 시작 위치.
+ * @param avail frame부터 읽을 수 있는 바이트 수.
+ * @param records 복원된 레코드를 쓸 버퍼 (LOGZ_BLOCK_BYTES 이상).
+ * @param records_len 복원된 바이트 수 (레코드 크기의 배수).
+ * @param frame_len 이 프레임이 차지한 바이트 수 (다음 프레임 위치 계산용).
+ * @return 성공 시 true, 프레임이 없거나 손상되었으면 false.
+ */
+bool logz_decode_frame(const logz_layout_t *layout, const uint8_t *frame, uint32_t avail,
+                       uint8_t *records, uint32_t *records_len, uint32_t *frame_len);
+
+#endif // LOGZ_H_
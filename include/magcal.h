@@ -0,0 +1,96 @@
+#ifndef MAGCAL_H_
+#define MAGCAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 지자기 센서 온라인 보정 (하드/소프트 아이언 + 서보 전류 오프셋).
+ *
+ * 모델: 측정값 m = c + sum_i d_i u_i + diag(1/s) h  (|h| = 일정)
+ *   c   : 하드 아이언 중심 (LSB)
+ *   s   : 축별 소프트 아이언 이득 (x축 기준, 축에 정렬된 타원체. 축 사이 결합은 모델링하지 않음)
+ *   d_i : 서보 i가 최대 부하일 때 생기는 오프셋 (LSB). u_i = 서보 부하 0 ~ 1 (Q15)
+ *
+ * 타원체 식을 전개하면 m, u의 다항식(m_y^2, m_z^2, m, 1, m u_i, u_i, u_i u_j)에 대해 선형이므로
+ * m_x^2 = phi^T theta 를 최소제곱으로 풉니다. 매 샘플 갱신은 정규 방정식(phi phi^T, phi m_x^2)을
+ * 지수 망각으로 누적하는 정보 행렬 형태의 재귀 최소제곱입니다:
+ *   - 갱신: Q14 회귀자의 16 x 16 -> 32비트 곱을 64비트 누적 (파라미터 n개일 때 n(n+1)/2번, O(1) 메모리)
+ *   - 해  : MAGCAL_SOLVE_INTERVAL 샘플마다 대각 정규화 + 릿지(구 사전값) 후 촐레스키 (float)
+ * 공분산 P를 직접 갱신하는 RLS와 달리 고정소수점에서 정밀도 손실/발산이 없고, 서보가 움직이지 않아
+ * 관측되지 않는 항은 릿지 때문에 0(영향 없음)에 머뭅니다.
+ *
+ * 해는 회전 범위가 충분할 때만(기본 항의 정규화 피벗, 이득/반경 범위 검사) 채택하며,
+ * 그 전까지 magcal_apply()는 원시값을 그대로 돌려줍니다. 수평 선회만으로는 z축이 관측되지 않아
+ * 채택되지 않고, 하강 중 진자 운동 정도(+-25도)의 기울기가 섞이면 채택됩니다 (host/bench_magcal).
+ */
+
+// --- 설정값 ---
+#define MAGCAL_MAX_LOADS 2                    // 서보 부하 입력 수
+#define MAGCAL_BASE_PARAMS 6                  // m_y^2, m_z^2, m_x, m_y, m_z, 1
+#define MAGCAL_MAX_PARAMS (MAGCAL_BASE_PARAMS + 4 * MAGCAL_MAX_LOADS + MAGCAL_MAX_LOADS * (MAGCAL_MAX_LOADS + 1) / 2)
+#define MAGCAL_FORGET_SHIFT 12                // 망각 시정수 2^12 샘플 (50 Hz에서 약 80 s)
+#define MAGCAL_FORGET_BLOCK_LOG2 4            // 망각은 16 샘플마다 한 번에 적용
+#define MAGCAL_SOLVE_INTERVAL 64              // 이 샘플 수마다 해를 다시 구함
+#define MAGCAL_MIN_SAMPLES 256                // 첫 해를 채택하기 전 최소 샘플 수
+#define MAGCAL_MIN_PIVOT 1e-3f                // 기본 항 정규화 촐레스키 피벗 하한 (회전 범위 부족 판정)
+#define MAGCAL_MIN_GAIN_RATIO 0.5f            // 축 이득 비 허용 범위 (y, z 대 x)
+#define MAGCAL_MAX_GAIN_RATIO 2.0f
+
+#define MAGCAL_PACKED(n) ((n) * ((n) + 1u) / 2u)
+
+typedef struct {
+    int32_t center_q8[3];                     // 하드 아이언 중심 (LSB x 256)
+    int32_t load_q8[MAGCAL_MAX_LOADS][3];     // 최대 부하 시 서보 오프셋 (LSB x 256)
+    int32_t gain_q14[3];                      // 소프트 아이언 보정 이득 (x축 = 1)
+    uint16_t radius;                          // 보정 후 자기장 크기 (LSB)
+    bool valid;
+} magcal_solution_t;
+
+typedef struct {
+    uint8_t input_shift;                      // |m| < 2^input_shift 인 샘플만 사용
+    uint8_t loads;                            // 사용하는 서보 부하 입력 수
+    uint8_t params;
+    uint16_t since_solve;
+    uint32_t samples;                         // 누적한 샘플 수 (범위 밖 샘플 제외)
+    uint32_t skipped;                         // 범위 밖이라 버린 샘플 수
+    uint32_t solves, rejects;                 // 해 계산 / 채택하지 않은 횟수
+    int64_t ata[MAGCAL_PACKED(MAGCAL_MAX_PARAMS)];  // sum phi phi^T (위 삼각, Q28)
+    int64_t aty[MAGCAL_MAX_PARAMS];           // sum phi m_x^2 (Q28)
+    float work[MAGCAL_PACKED(MAGCAL_MAX_PARAMS)];   // 촐레스키 작업 공간
+    magcal_solution_t sol;
+} magcal_t;
+
+/**
+ * @brief 보정기를 초기화합니다.
+ *
+ * @param input_shift 원시값 범위 (|m| < 2^input_shift, 7 ~ 15). 지구 자기장 + 오프셋이 들어가는 최소값으로.
+ * @param loads 서보 부하 입력 수 (0 ~ MAGCAL_MAX_LOADS). 0이면 하드/소프트 아이언만 추정.
+ * @return 인자가 범위를 벗어나면 false.
+ */
+bool magcal_init(magcal_t *cal, uint8_t input_shift, uint8_t loads);
+
+/**
+ * @brief 샘플 하나를 누적합니다. MAGCAL_SOLVE_INTERVAL 샘플마다 해를 다시 구합니다.
+ *
+ * @param mag 원시 자기장 (LSB).
+ * @param load_q15 서보 부하 loads개 (0 ~ 32767). loads가 0이면 NULL 가능.
+ * @return 이번 호출에서 새 해를 채택했으면 true.
+ */
+bool magcal_update(magcal_t *cal, const int16_t mag[3], const int16_t *load_q15);
+
+/**
+ * @brief 지금까지 누적한 데이터로 해를 구합니다 (magcal_update()가 주기적으로 호출).
+ *
+ * @return 해를 채택했으면 true (회전 범위 부족 / 범위 검사 실패 시 이전 해 유지, false).
+ */
+bool magcal_solve(magcal_t *cal);
+
+/**
+ * @brief 보정을 적용합니다 (정수 연산). 채택한 해가 없으면 원시값을 그대로 복사합니다.
+ *
+ * @param out 보정된 자기장 (x축 이득 기준 LSB, int16_t 범위로 포화).
+ */
+void magcal_apply(const magcal_t *cal, const int16_t mag[3], const int16_t *load_q15, int16_t out[3]);
+
+#endif // MAGCAL_H_
@@ -0,0 +1,59 @@
+#ifndef OFFLOAD_DEV_H_
+#define OFFLOAD_DEV_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "offload_proto.h"
+
+/*
+ * 로그 오프로드 프로토콜의 기체 쪽 엔진 (전송 계층/저장소 독립).
+ *
+ * 프레임 버퍼 두 개를 번갈아 쓰며, 한 버퍼를 전송 계층으로 내보내는 동안 다른 버퍼를
+ * 소스(플래시 DMA, SD 블록 읽기)에서 채웁니다. offload_dev_poll()은 블로킹하지 않으므로
+ * 메인 루프에서 tud_task()와 번갈아 호출합니다.
+ */
+
+// 데이터 소스. 읽기는 비동기: read_start 후 read_poll이 완료를 알릴 때까지 buf를 건드리지 않음
+typedef struct {
+    bool (*size)(uint8_t source, uint32_t *size);
+    bool (*read_start)(uint8_t source, uint32_t offset, uint8_t *buf, uint32_t len);
+    int (*read_poll)(void);   // 1 = 완료, 0 = 진행 중, -1 = 실패
+} offload_source_ops_t;
+
+// 전송 계층 (블로킹 없음). rx/tx는 실제로 처리한 바이트 수를 반환
+typedef struct {
+    uint32_t (*rx)(void *buf, uint32_t cap);
+    uint32_t (*tx)(const void *buf, uint32_t len);
+    void (*tx_flush)(void);
+} offload_transport_t;
+
+typedef struct {
+    uint32_t requests;
+    uint32_t bad_requests;
+    uint32_t frames_sent;
+    uint32_t bytes_sent;      // 프레임 데이터 바이트
+    uint32_t read_errors;
+    uint32_t aborts;
+} offload_dev_stats_t;
+
+/**
+ * @brief 엔진을 초기화합니다.
+ *
+ * @param source 데이터 소스 (호출자가 수명 유지).
+ * @param transport 전송 계층 (호출자가 수명 유지).
+ */
+void offload_dev_init(const offload_source_ops_t *source, const offload_transport_t *transport);
+
+/**
+ * @brief 요청 수신, 소스 읽기, 프레임 송신을 진행합니다 (블로킹 없음).
+ */
+void offload_dev_poll(void);
+
+/**
+ * @brief 스트림 전송 중이면 true.
+ */
+bool offload_dev_busy(void);
+
+void offload_dev_get_stats(offload_dev_stats_t *stats);
+
+#endif // OFFLOAD_DEV_H_
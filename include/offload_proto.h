@@ -0,0 +1,84 @@
+#ifndef OFFLOAD_PROTO_H_
+#define OFFLOAD_PROTO_H_
+
+#include <stdint.h>
+
+/*
+ * 로그 오프로드 프로토콜 (USB vendor bulk, 펌웨어와 지상 도구 공용 정의).
+ *
+ *   지상 -> 기체 : offload_request_t (16 바이트)
+ *   기체 -> 지상 : offload_response_t (16 바이트)
+ *                  READ 성공이면 이어서 데이터 프레임들
+ *                  (offload_frame_header_t + length 바이트, 마지막 프레임은 length 0)
+ *
+ * 프레임마다 CRC-32(crc32.h)가 있어 지상 도구는 마지막으로 검증된 오프셋부터 다시
+ * 요청할 수 있습니다. 읽기 도중 새 요청을 보내면 진행 중인 스트림은 중단되며,
+ * 지상 도구는 응답 magic을 찾을 때까지 남은 바이트를 버립니다.
+ * 모든 필드는 리틀 엔디언입니다.
+ */
+
+// --- USB 식별자 ---
+#define OFFLOAD_USB_VID 0xCAFE      // TinyUSB 예제용 VID (양산 시 교체)
+#define OFFLOAD_USB_PID 0x4C47      // "LG"
+#define OFFLOAD_EP_OUT 0x01
+#define OFFLOAD_EP_IN 0x81
+#define OFFLOAD_EP_SIZE 64          // full-speed bulk 최대 패킷
+
+// --- 프로토콜 ---
+#define OFFLOAD_REQUEST_MAGIC 0x514C464Fu  // "OFLQ"
+#define OFFLOAD_RESPONSE_MAGIC 0x524C464Fu // "OFLR"
+#define OFFLOAD_FRAME_MAGIC 0x444C464Fu    // "OFLD"
+#define OFFLOAD_FRAME_DATA 4096            // 프레임 데이터 최대 크기 (SD 블록 8개)
+
+typedef enum {
+    OFFLOAD_CMD_INFO = 1,   // 소스 크기 조회
+    OFFLOAD_CMD_READ = 2,   // [offset, offset + length) 스트리밍 (length 0 = 끝까지)
+    OFFLOAD_CMD_ABORT = 3,  // 진행 중인 스트림 중단 (응답 있음)
+} offload_cmd_t;
+
+typedef enum {
+    OFFLOAD_OK = 0,
+    OFFLOAD_ERR_BAD_REQUEST = 1,
+    OFFLOAD_ERR_SOURCE = 2,   // 없는 소스 (SD 카드 없음 등)
+    OFFLOAD_ERR_RANGE = 3,    // 범위 밖 또는 정렬 안 됨
+    OFFLOAD_ERR_IO = 4,       // 읽기 실패 (스트림 중이면 마지막 프레임의 status)
+} offload_status_t;
+
+typedef enum {
+    OFFLOAD_SRC_SDLOG = 0,    // SD 카드의 비행 로그 파일 (sdlog 헤더 블록 포함)
+    OFFLOAD_SRC_FLASH = 1,    // 온보드 QSPI 플래시 전체
+    OFFLOAD_SOURCES
+} offload_source_id_t;
+
+typedef struct {
+    uint32_t magic;
+    uint8_t cmd;
+    uint8_t source;
+    uint16_t reserved;
+    uint32_t offset;
+    uint32_t length;
+} offload_request_t;
+
+typedef struct {
+    uint32_t magic;
+    uint8_t cmd;
+    uint8_t status;
+    uint16_t reserved;
+    uint32_t size;            // 소스 전체 크기
+    uint32_t length;          // READ: 이어서 보낼 데이터 바이트 수
+} offload_response_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t offset;          // 소스 안의 위치
+    uint16_t length;          // 0이면 스트림 끝
+    uint8_t status;           // offload_status_t (끝 프레임에서 의미 있음)
+    uint8_t reserved;
+    uint32_t crc;             // 데이터의 CRC-32
+} offload_frame_header_t;
+
+_Static_assert(sizeof(offload_request_t) == 16, "request layout");
+_Static_assert(sizeof(offload_response_t) == 16, "response layout");
+_Static_assert(sizeof(offload_frame_header_t) == 16, "frame header layout");
+
+#endif // OFFLOAD_PROTO_H_
@@ -0,0 +1,26 @@
+#ifndef PARAM_DEFS_H_
+#define PARAM_DEFS_H_
+
+#include "servo.h"
+#include "app_tasks.h"
+
+/*
+ * 런타임 파라미터 테이블 (X-macro).
+ *
+ * X(식별자, 이름 해시, 이름, 타입, 값 필드, 기본값, 최솟값, 최댓값)
+ *
+ * - 해시는 이름의 FNV-1a 32비트 값이며, 지상국 명령은 이 해시로 파라미터를 지정합니다.
+ * - 항목은 반드시 해시 오름차순으로 유지해야 합니다 (이진 탐색).
+ *   params_init()이 해시 값과 정렬 순서를 검증하므로 잘못 추가하면 초기화가 실패합니다.
+ * - 새 항목의 해시는 params_hash("이름")으로 구할 수 있습니다.
+ * - 실제로 읽는 코드가 있는 값만 둡니다. 서보 PWM 주파수는 모든 슬라이스가 공유하는 컴파일 시 상수
+ *   (SERVO_PWM_FREQ_HZ)라 런타임 파라미터가 아닙니다.
+ */
+#define PARAM_TABLE(X) \
+    X(PARAM_SERVO_MIN_PULSE_US, 0x2F44F1B3u, "servo.min_pulse_us", PARAM_TYPE_U32, u32, DEFAULT_SERVO_MIN_PULSE_US, 500, 2500) \
+    X(PARAM_CTRL_PERIOD_MS,     0x8F54BED4u, "ctrl.period_ms",     PARAM_TYPE_U32, u32, APP_CONTROL_PERIOD_MS, APP_CONTROL_MIN_PERIOD_MS, 1000) \
+    X(PARAM_LOG_PERIOD_MS,      0x8FF9F8EDu, "log.period_ms",      PARAM_TYPE_U32, u32, APP_LOG_PERIOD_MS, 100, 60000) \
+    X(PARAM_TLM_PERIOD_MS,      0x9B2BDAC0u, "tlm.period_ms",      PARAM_TYPE_U32, u32, APP_TELEMETRY_PERIOD_MS, 20, 60000) \
+    X(PARAM_SERVO_MAX_PULSE_US, 0xD4DE5C41u, "servo.max_pulse_us", PARAM_TYPE_U32, u32, DEFAULT_SERVO_MAX_PULSE_US, 500, 2500)
+
+#endif // PARAM_DEFS_H_
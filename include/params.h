@@ -0,0 +1,154 @@
+#ifndef PARAMS_H_
+#define PARAMS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "param_defs.h"
+
+/*
+ * 런타임 파라미터 서브시스템.
+ *
+ * 값은 두 개의 뱅크에 저장되며, 쓰기 쪽(명령 처리 코어)은 비활성 뱅크를 수정한 뒤
+ * 활성 뱅크 인덱스를 바꾸는 것으로 변경을 공개합니다. 읽기 쪽(제어 코어)은
+ * params_acquire()로 얻은 뱅크를 params_release()까지 일관된 스냅샷으로 사용하며,
+ * 어느 쪽도 락이나 인터럽트 차단을 사용하지 않습니다.
+ *
+ * 제약: 읽기 주체와 쓰기 주체는 각각 하나여야 합니다 (예: core 1 제어 루프, core 0 명령 처리).
+ */
+
+typedef enum {
+    PARAM_TYPE_U32 = 0,
+    PARAM_TYPE_I32,
+    PARAM_TYPE_F32,
+} param_type_t;
+
+typedef union {
+    uint32_t u32;
+    int32_t i32;
+    float f32;
+} param_value_t;
+
+// 파라미터 식별자 (테이블 순서 = 해시 오름차순)
+typedef enum {
+#define PARAM_ENUM_ENTRY(sym, hash, name, type, field, def, min, max) sym,
+    PARAM_TABLE(PARAM_ENUM_ENTRY)
+#undef PARAM_ENUM_ENTRY
+    PARAM_COUNT
+} param_id_t;
+
+typedef struct {
+    uint32_t hash;
+    const char *name;
+    param_type_t type;
+    param_value_t def;
+    param_value_t min;
+    param_value_t max;
+} param_info_t;
+
+/**
+ * @brief 테이블을 검증하고 기본값을 적재한 뒤, 저장소에 유효한 값이 있으면 덮어씁니다.
+ *
+ * @return 성공 시 true, 실패 시 false (테이블 해시 불일치 또는 정렬 오류).
+ *         저장소가 비어 있거나 손상된 경우는 기본값으로 동작하므로 실패가 아닙니다.
+ */
+bool params_init(void);
+
+/**
+ * @brief 이름의 FNV-1a 32비트 해시를 계산합니다.
+ */
+uint32_t params_hash(const char *name);
+
+/**
+ * @brief 해시로 파라미터를 찾습니다 (이진 탐색).
+ *
+ * @return 파라미터 식별자, 없으면 -1.
+ */
+int params_find(uint32_t hash);
+
+/**
+ * @brief 파라미터의 메타데이터(이름, 타입, 범위)를 반환합니다.
+ *
+ * @return id가 범위를 벗어나면 NULL.
+ */
+const param_info_t *params_info(param_id_t id);
+
+// --- 읽기 (제어 코어) ---
+
+/**
+ * @brief 현재 활성 뱅크를 스냅샷으로 잡습니다.
+ *
+ * 반환된 배열은 params_release() 전까지 변경되지 않습니다.
+ * 제어 주기 시작 시 잡고 주기 끝에서 놓는 것을 권장합니다.
+ *
+ * @return PARAM_COUNT 개의 값 배열 (param_id_t로 인덱싱).
+ */
+const param_value_t *params_acquire(void);
+
+/**
+ * @brief params_acquire()로 잡은 스냅샷을 놓습니다.
+ */
+void params_release(void);
+
+/**
+ * @brief 값 하나를 읽습니다 (스냅샷 없이, 32비트 단일 읽기라 찢어지지 않음).
+ */
+param_value_t params_get(param_id_t id);
+
+// --- 쓰기 (명령 처리 코어) ---
+
+/**
+ * @brief 여러 값을 한 번에 바꾸기 위한 갱신을 시작합니다.
+ *
+ * @return 시작 성공 시 true, 읽기 쪽이 아직 이전 스냅샷을 잡고 있으면 false (나중에 재시도).
+ */
+bool params_update_begin(void);
+
+/**
+ * @brief 진행 중인 갱신에 값을 기록합니다 (commit 전까지 읽기 쪽에 보이지 않음).
+ *
+ * @return 성공 시 true, 실패 시 false (잘못된 id, 범위 초과, 갱신 미시작).
+ */
+bool params_update_stage(param_id_t id, param_value_t value);
+
+/**
+ * @brief 진행 중인 갱신을 원자적으로 공개합니다.
+ */
+void params_update_commit(void);
+
+/**
+ * @brief 값 하나를 바로 갱신합니다 (begin + stage + commit).
+ *
+ * @return 성공 시 true, 실패 시 false (범위 초과 또는 읽기 쪽 사용 중).
+ */
+bool params_set(param_id_t id, param_value_t value);
+
+/**
+ * @brief 해시로 지정한 값 하나를 갱신합니다 (지상국 명령용).
+ */
+bool params_set_by_hash(uint32_t hash, param_value_t value);
+
+// --- 영구 저장 ---
+
+/**
+ * @brief 현재 활성 값을 저장소(플래시)에 기록합니다.
+ *
+ * 타깃에서는 플래시 섹터를 지우는 동안 양 코어가 잠시 멈추므로 비행 중에는 호출하지 않습니다.
+ */
+bool params_save(void);
+
+/**
+ * @brief 저장소의 값을 읽어 적용합니다. 해시로 매칭하므로 테이블이 바뀌어도 남은 항목은 복원됩니다.
+ *
+ * @return 유효한 기록이 있어 적용했으면 true.
+ */
+bool params_load(void);
+
+// --- 저장소 백엔드 (타깃: src/params_flash.c, 호스트: host/params_store_host.c) ---
+
+// 저장 레코드 최대 크기 (플래시 페이지 단위)
+#define PARAMS_STORE_BYTES 256
+
+bool params_storage_read(void *buf, uint32_t len);
+bool params_storage_write(const void *buf, uint32_t len);
+
+#endif // PARAMS_H_
@@ -0,0 +1,102 @@
+#ifndef SD_BLOCK_H_
+#define SD_BLOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// SD 카드 블록 장치 (타깃: src/sd_spi.c SPI+DMA, 호스트: host/sd_image_host.c 디스크 이미지)
+
+// --- 설정값 ---
+#define SD_BLOCK_SIZE 512
+
+// SPI 연결 (타깃 전용). SPI0의 GPIO 4 ~ 7 묶음 (16 ~ 19 묶음은 APP_SERVO_GPIO와 겹침)
+#define SD_SPI_PORT spi0
+#define SD_SPI_SCK_GPIO 6
+#define SD_SPI_MOSI_GPIO 7
+#define SD_SPI_MISO_GPIO 4
+#define SD_SPI_CS_GPIO 5
+#define SD_SPI_INIT_BAUD_HZ 400000
+#define SD_SPI_BAUD_HZ 25000000
+
+typedef enum {
+    SD_OK = 0,
+    SD_BUSY,      // 지금은 처리할 수 없음 (카드 프로그래밍 중 또는 DMA 진행 중), 나중에 재시도
+    SD_ERROR,
+} sd_status_t;
+
+/**
+ * @brief 카드를 초기화합니다 (SPI 모드 진입, 용량 확인).
+ *
+ * @return 성공 시 true, 실패 시 false (카드 없음, 응답 없음, 지원하지 않는 카드 등).
+ */
+bool sd_block_init(void);
+
+/**
+ * @brief 카드의 전체 블록(512바이트) 수.
+ */
+uint32_t sd_block_count(void);
+
+/**
+ * @brief 블록을 읽습니다 (블로킹).
+ */
+bool sd_block_read(uint32_t lba, uint8_t *buf, uint32_t count);
+
+/**
+ * @brief 블록을 씁니다 (블로킹, count > 1 이면 다중 블록 쓰기).
+ */
+bool sd_block_write(uint32_t lba, const uint8_t *buf, uint32_t count);
+
+// --- 비블로킹 연속 쓰기 (다중 블록 쓰기 명령 하나를 계속 열어둠) ---
+
+/**
+ * @brief lba부터 연속 쓰기를 시작합니다 (블로킹, 명령 전송만).
+ */
+bool sd_stream_begin(uint32_t lba);
+
+/**
+ * @brief 다음 블록 전송을 시작합니다.
+ *
+ * SD_OK를 반환하면 DMA가 block을 읽기 시작한 것이므로, block 버퍼는
+ * sd_stream_poll()이 true를 반환할 때까지 유지해야 합니다.
+ *
+ * @param block SD_BLOCK_SIZE 바이트.
+ * @return SD_OK (전송 시작), SD_BUSY (이전 블록 전송 중 또는 카드 busy), SD_ERROR.
+ */
+sd_status_t sd_stream_write(const uint8_t *block);
+
+/**
+ * @brief 진행 중인 블록 전송을 마무리합니다 (비블로킹).
+ *
+ * @return 진행 중인 전송이 없으면 true (마지막으로 넘긴 버퍼 재사용 가능).
+ */
+bool sd_stream_poll(void);
+
+/**
+ * @brief 연속 쓰기를 종료합니다 (블로킹, 마지막 블록 프로그래밍 완료까지 대기).
+ */
+bool sd_stream_end(void);
+
+#ifdef CANSAT_HOST
+/**
+ * @brief (호스트 전용) 디스크 이미지 경로를 지정합니다. sd_block_init 전에 호출.
+ *
+ * 지정하지 않으면 환경 변수 CANSAT_SD_IMAGE, 없으면 sd.img.
+ */
+void sd_host_set_image(const char *path);
+
+/**
+ * @brief (호스트 전용) 블록마다 카드 프로그래밍 시간을 흉내냅니다 (HAL 시간 기준).
+ *
+ * @param block_us 블록 하나당 busy 시간.
+ * @param stall_every 이 블록 수마다 한 번 긴 busy (카드 내부 정리), 0이면 없음.
+ * @param stall_us 긴 busy 시간.
+ */
+void sd_host_set_busy(uint32_t block_us, uint32_t stall_every, uint32_t stall_us);
+
+/**
+ * @brief (호스트 전용) 지정한 크기의 빈 FAT32 이미지(파티션 테이블 없음)를 만듭니다.
+ */
+bool sd_host_format_fat32(const char *path, uint64_t bytes);
+#endif
+
+#endif // SD_BLOCK_H_
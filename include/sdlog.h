@@ -0,0 +1,75 @@
+#ifndef SDLOG_H_
+#define SDLOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * SD 카드 비행 로거.
+ *
+ * 부팅 시 FAT32에 연속 파일(SDLOG_FILE_NAME)을 미리 할당하고, 비행 중에는 그 섹터에
+ * 다중 블록 쓰기로 직접 기록합니다 (FAT/디렉터리 갱신 없음).
+ * 생산자(sdlog_write)는 RAM 버퍼에 복사만 하고 즉시 반환하며, 카드 전송은
+ * core 0 배경 루프의 sdlog_poll()이 DMA로 처리합니다. 버퍼가 모두 차 있으면
+ * 생산자를 멈추는 대신 레코드를 버리고 dropped 통계를 올립니다.
+ *
+ * 파일 첫 블록은 헤더(sdlog_header_t), 데이터는 두 번째 블록부터입니다.
+ * 생산자와 sdlog_poll()은 각각 한 컨텍스트에서만 호출해야 합니다.
+ */
+
+// --- 설정값 ---
+#define SDLOG_FILE_NAME "FLIGHT  LOG" // 8.3 형식 (FLIGHT.LOG)
+#define SDLOG_BLOCKS_PER_BUFFER 8     // 버퍼 하나 = 4 KB
+#define SDLOG_BUFFERS 2               // 이중 버퍼링
+#define SDLOG_HEADER_MAGIC 0x474C5343u // "CSLG"
+#define SDLOG_HEADER_VERSION 1
+
+// 파일 첫 블록에 기록되는 헤더
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t block_size;
+    uint32_t data_blocks;     // 데이터 영역 블록 수
+    uint32_t bytes_written;   // 유효한 데이터 바이트 수 (sdlog_close에서 갱신, 0이면 비정상 종료)
+    uint32_t bytes_dropped;
+} sdlog_header_t;
+
+typedef struct {
+    uint32_t bytes_written;   // 카드로 전송된 바이트 (패딩 포함)
+    uint32_t bytes_accepted;  // sdlog_write가 받아들인 바이트
+    uint32_t bytes_dropped;   // 버퍼/파일 부족으로 버린 바이트
+    uint32_t records_dropped;
+    uint32_t busy_polls;      // 카드 busy로 전송을 미룬 poll 횟수
+    uint32_t max_buffers_used;
+} sdlog_stats_t;
+
+/**
+ * @brief 카드를 초기화하고 로그 파일을 미리 할당한 뒤 연속 쓰기를 시작합니다.
+ *
+ * @param file_bytes 로그 파일 크기 (헤더 블록 포함, 클러스터 단위로 올림).
+ * @return 성공 시 true, 실패 시 false (카드 없음, FAT32 아님, 공간 부족 등).
+ */
+bool sdlog_init(uint32_t file_bytes);
+
+/**
+ * @brief 레코드 하나를 로그에 추가합니다 (블로킹 없음).
+ *
+ * 레코드는 통째로 들어가거나 통째로 버려집니다.
+ *
+ * @return 받아들였으면 true, 버퍼 또는 파일 공간이 없어 버렸으면 false.
+ */
+bool sdlog_write(const void *data, uint32_t len);
+
+/**
+ * @brief 찬 버퍼를 카드로 전송합니다 (블로킹 없음, 배경 루프에서 자주 호출).
+ */
+void sdlog_poll(void);
+
+/**
+ * @brief 남은 데이터를 블록 단위로 채워 기록하고, 연속 쓰기를 끝낸 뒤 헤더를 갱신합니다 (블로킹).
+ */
+bool sdlog_close(void);
+
+void sdlog_get_stats(sdlog_stats_t *stats);
+
+#endif // SDLOG_H_
@@ -15,6 +15,142 @@
 // 서보 모터 PWM 주파수 (Hz)
 #define SERVO_PWM_FREQ_HZ 50
 
+/*
+ * 서보 동특성 모델 (servo_dyn으로 측정, 캘리브레이션과 같이 서보 슬롯에 저장). 모두 펄스 폭 단위:
+ *   1차: 명령이 delay1_us 뒤에 도착해 시정수 tau_us로 따라감
+ *   2차: 명령이 delay2_us 뒤에 도착해 고유진동수 wn, 감쇠비 zeta로 따라감
+ * 두 모델 모두 속도는 slew_us_per_s로 제한됩니다 (0이면 제한 없음). 전체를 0으로 두면 측정 안 함.
+ */
+typedef struct {
+    uint8_t order;            // 측정 기록에 더 잘 맞은 모델 (1 또는 2), 0이면 측정 안 함
+    uint16_t slew_us_per_s;   // 최대 속도
+    uint32_t delay1_us;
+    uint32_t tau_us;
+    uint32_t delay2_us;
+    uint16_t wn_x100;         // rad/s x 100
+    uint16_t zeta_x1000;
+} servo_model_t;
+
+// 서보 하나의 상태
+typedef struct {
+    uint16_t gpio_num;
+    uint16_t slice_num;
+    uint16_t chan_num; // A=0, B=1
+    uint16_t wrap_val;
+    uint16_t min_pulse_us;
+    uint16_t max_pulse_us;
+    uint16_t center_pulse_us; // 90도 펄스 폭 (0이면 min/max 중간, servo_cal로 측정한 값)
+    servo_model_t model; // 동특성 모델 (servo_dyn으로 측정한 값)
+    uint16_t level; // 마지막으로 출력한 PWM 레벨
+    bool is_initialized;
+    bool is_attached; // PWM 슬라이스가 활성화되어 있는지 여부
+} servo_info_t;
+
+/*
+ * 서보 컨트롤러 인스턴스. 서보 슬롯 MAX_SERVOS개를 가지며, 인스턴스끼리는 상태를 공유하지 않습니다
+ * (호스트 시뮬레이션을 여러 개 띄우거나 PWM 백엔드별로 컨트롤러를 나눌 때).
+ * 0으로 채우거나 servo_ctx_init()으로 초기화한 뒤 사용합니다.
+ *
+ * 아래의 컨텍스트 없는 servo_xxx() 함수들은 라이브러리 내부 기본 인스턴스(servo_default_ctx())를
+ * 사용하는 기존 API입니다.
+ */
+typedef struct {
+    servo_info_t servos[MAX_SERVOS];
+} servo_ctx_t;
+
+// --- 컨텍스트 API ---
+
+/**
+ * @brief 컨텍스트의 모든 슬롯을 비웁니다 (PWM 하드웨어는 건드리지 않음).
+ */
+void servo_ctx_init(servo_ctx_t *ctx);
+
+/**
+ * @brief 라이브러리 기본 인스턴스. 컨텍스트 없는 servo_xxx() 함수들이 사용합니다.
+ */
+servo_ctx_t *servo_default_ctx(void);
+
+/**
+ * @brief servo_init()과 같으나 지정한 컨텍스트에 서보를 추가합니다.
+ */
+bool servo_ctx_add(servo_ctx_t *ctx, uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us);
+
+/**
+ * @brief servo_set()과 같으나 지정한 컨텍스트의 서보를 사용합니다.
+ */
+bool servo_ctx_set(servo_ctx_t *ctx, uint16_t gpio_num, uint8_t angle);
+
+/**
+ * @brief servo_detach()와 같으나 지정한 컨텍스트의 서보를 사용합니다.
+ */
+bool servo_ctx_detach(servo_ctx_t *ctx, uint16_t gpio_num);
+
+/**
+ * @brief servo_attach()와 같으나 지정한 컨텍스트의 서보를 사용합니다.
+ */
+bool servo_ctx_attach(servo_ctx_t *ctx, uint16_t gpio_num);
+
+/**
+ * @brief servo_deinit()과 같으나 지정한 컨텍스트에서 서보를 제거합니다.
+ */
+bool servo_ctx_remove(servo_ctx_t *ctx, uint16_t gpio_num);
+
+/**
+ * @brief servo_get_level()과 같으나 지정한 컨텍스트의 서보를 사용합니다.
+ */
+bool servo_ctx_get_level(const servo_ctx_t *ctx, uint16_t gpio_num, uint16_t *level);
+
+/**
+ * @brief servo_angle_to_level()과 같으나 지정한 컨텍스트의 서보를 사용합니다.
+ */
+bool servo_ctx_angle_to_level(const servo_ctx_t *ctx, uint16_t gpio_num, uint8_t angle, uint16_t *level);
+
+/**
+ * @brief 각도 대신 펄스 폭을 직접 출력합니다 (캘리브레이션 스윕 / 응답 측정용).
+ *
+ * min/max 범위로 제한하지 않으므로 기계적 정지점 너머로 밀 수 있습니다. detach 상태면 attach합니다.
+ *
+ * @param pulse_us 펄스 폭 (마이크로초, PWM 주기보다 길면 주기로 제한).
+ * @return 설정 성공 시 true, 실패 시 false (초기화되지 않은 서보).
+ */
+bool servo_ctx_set_pulse_us(servo_ctx_t *ctx, uint16_t gpio_num, uint16_t pulse_us);
+
+/**
+ * @brief 각도 -> 펄스 폭 캘리브레이션을 바꿉니다 (출력은 다음 servo_ctx_set()부터 적용).
+ *
+ * center_pulse_us가 0이 아니면 0 ~ 90도는 min ~ center, 90 ~ 180도는 center ~ max로 나눠 보간합니다.
+ *
+ * @param center_pulse_us 90도 펄스 폭, 0이면 min/max 중간.
+ * @return 성공 시 true, 실패 시 false (초기화되지 않은 서보, min >= max, center가 min/max 밖).
+ */
+bool servo_ctx_set_calibration(servo_ctx_t *ctx, uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us,
+                               uint16_t center_pulse_us);
+
+/**
+ * @brief 현재 캘리브레이션을 읽습니다.
+ *
+ * @param center_pulse_us 90도 펄스 폭 (0이면 min/max 중간을 쓰는 중).
+ * @return 성공 시 true, 실패 시 false (초기화되지 않은 서보).
+ */
+bool servo_ctx_get_calibration(const servo_ctx_t *ctx, uint16_t gpio_num, uint16_t *min_pulse_us,
+                               uint16_t *max_pulse_us, uint16_t *center_pulse_us);
+
+/**
+ * @brief 동특성 모델을 저장합니다 (출력에는 영향 없음, 제어기 튜닝 / 지연 보상용).
+ *
+ * @return 성공 시 true, 실패 시 false (초기화되지 않은 서보, order가 0 ~ 2가 아님).
+ */
+bool servo_ctx_set_model(servo_ctx_t *ctx, uint16_t gpio_num, const servo_model_t *model);
+
+/**
+ * @brief 저장된 동특성 모델을 읽습니다 (측정 안 했으면 order 0).
+ *
+ * @return 성공 시 true, 실패 시 false (초기화되지 않은 서보).
+ */
+bool servo_ctx_get_model(const servo_ctx_t *ctx, uint16_t gpio_num, servo_model_t *model);
+
+// --- 기본 인스턴스 API ---
+
 /**
  * @brief 지정된 GPIO 핀을 서보 모터 제어용으로 초기화합니다.
  *
@@ -72,5 +208,59 @@ bool servo_detach(uint16_t gpio_num);
  */
 bool servo_attach(uint16_t gpio_num);
 
+/**
+ * @brief 서보의 펄스 출력을 0으로 만들고 슬롯을 비웁니다.
+ *
+ * 이후 같은 GPIO에 servo_init()을 다시 호출할 수 있습니다 (시뮬레이터에서 비행을 반복할 때 등).
+ * PWM 슬라이스는 끄지 않으므로 같은 슬라이스의 다른 서보는 계속 동작합니다.
+ *
+ * @param gpio_num 서보 모터가 연결된 GPIO 핀 번호.
+ * @return 성공 시 true, 실패 시 false (초기화되지 않은 서보 등).
+ */
+bool servo_deinit(uint16_t gpio_num);
+
+/**
+ * @brief 서보에 마지막으로 출력한 PWM 레벨을 읽습니다 (서보 전류 추정 / 자기장 보정 등).
+ *
+ * @param level 레벨 (wrap 기준 카운트, 0도 레벨 ~ 180도 레벨).
+ * @return 성공 시 true, 실패 시 false (초기화되지 않은 서보).
+ */
+bool servo_get_level(uint16_t gpio_num, uint16_t *level);
+
+/**
+ * @brief 각도에 해당하는 PWM 레벨을 계산합니다 (출력은 바꾸지 않음).
+ *
+ * servo_get_level() 값을 각도 범위에 대해 정규화할 때 사용합니다.
+ *
+ * @return 성공 시 true, 실패 시 false (초기화되지 않은 서보).
+ */
+bool servo_angle_to_level(uint16_t gpio_num, uint8_t angle, uint16_t *level);
+
+/**
+ * @brief servo_ctx_set_pulse_us()와 같으나 기본 인스턴스의 서보를 사용합니다.
+ */
+bool servo_set_pulse_us(uint16_t gpio_num, uint16_t pulse_us);
+
+/**
+ * @brief servo_ctx_set_calibration()과 같으나 기본 인스턴스의 서보를 사용합니다.
+ */
+bool servo_set_calibration(uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us, uint16_t center_pulse_us);
+
+/**
+ * @brief servo_ctx_get_calibration()과 같으나 기본 인스턴스의 서보를 사용합니다.
+ */
+bool servo_get_calibration(uint16_t gpio_num, uint16_t *min_pulse_us, uint16_t *max_pulse_us,
+                           uint16_t *center_pulse_us);
+
+/**
+ * @brief servo_ctx_set_model()과 같으나 기본 인스턴스의 서보를 사용합니다.
+ */
+bool servo_set_model(uint16_t gpio_num, const servo_model_t *model);
+
+/**
+ * @brief servo_ctx_get_model()과 같으나 기본 인스턴스의 서보를 사용합니다.
+ */
+bool servo_get_model(uint16_t gpio_num, servo_model_t *model);
+
 
 #endif // SERVO_H_
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef SERVO_CAL_H_
+#define SERVO_CAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "servo.h"
+
+/*
+ * 서보 끝점 자동 캘리브레이션 (기계적 정지점 검출 스윕).
+ *
+ * 시작 펄스(보통 중립)에서 한쪽으로 coarse 간격씩 밀다가 정지점을 검출하면, 한 칸 물러났다가
+ * 마지막 정상 위치부터 fine 간격으로 다시 다가가 정지점을 좁힙니다. 시작점으로 돌아와 반대쪽도 같이 합니다.
+ * 검출은 펄스마다 서보가 자리 잡은 뒤의 측정값(평균)으로:
+ *   - 전류  : 시작점에서 잰 유지 전류보다 stall_ma 이상 크면 (정지점에 막혀 계속 미는 중)
+ *   - 피드백: 위치(전위차계 ADC)가 펄스를 따라오지 않음. 지금까지의 기울기(카운트/us)로 coarse 단계의
+ *             마지막 정상 위치에서 예측한 값보다 lag_us 이상 모자라면 (첫 두 칸은 기울기를 배우는 중이라 전류로만 판단)
+ * 검출되면 같은 펄스에서 한 번 더 재서 확인합니다 (잡음 한 번으로 끝점을 잘못 잡지 않도록). 정지점에 미는 시간은
+ * 검출 + 확인 두 번뿐입니다.
+ *
+ * 결과: 정지점(마지막 정상 펄스) 양쪽에서 margin_us 안쪽을 min/max, 두 정지점의 중간을 center(90도)로 씁니다.
+ * 한쪽에서 정지점을 못 찾으면 스윕 한계를 정지점으로 씁니다.
+ *
+ * 스윕은 측정을 넣어 주면 다음 펄스와 기다릴 시간을 내주는 상태 기계(servo_cal_step)이고,
+ * servo_cal_run()은 servo_lib + sleep_ms()로 이것을 끝까지 돌리는 블로킹 도우미입니다.
+ */
+
+// --- 설정값 ---
+#define SERVO_CAL_SENSE_CURRENT 0x01          // 서보 전원 전류 측정
+#define SERVO_CAL_SENSE_FEEDBACK 0x02         // 위치 피드백 (전위차계 ADC)
+#define SERVO_CAL_MIN_RANGE_US 200            // 두 정지점 사이가 이보다 좁으면 실패
+#define SERVO_CAL_START_WAIT_MS 500           // 시작점으로 움직일 때 기다리는 최소 시간 (처음엔 위치를 모름)
+#define SERVO_CAL_SAMPLE_GAP_MS 1             // servo_cal_run()의 측정 간격
+
+typedef enum {
+    SERVO_CAL_RUNNING,
+    SERVO_CAL_DONE,
+    SERVO_CAL_FAILED,
+} servo_cal_status_t;
+
+typedef struct {
+    uint16_t start_us;                        // 시작 펄스 (정지점 안쪽이어야 함)
+    uint16_t limit_min_us, limit_max_us;      // 이 너머로는 보내지 않음
+    uint16_t coarse_step_us, fine_step_us;
+    uint16_t margin_us;                       // 정지점에서 물러설 여유
+    uint8_t sense;                            // SERVO_CAL_SENSE_xxx 조합
+    uint16_t stall_ma;                        // 전류 검출 문턱 (유지 전류 대비)
+    uint16_t lag_us;                          // 피드백 검출 문턱 (펄스 환산)
+    uint16_t settle_ms;                       // 펄스를 바꾼 뒤 측정 전 기본 대기
+    uint16_t slew_us_per_ms;                  // 서보 속도 (큰 이동은 이동 시간만큼 더 기다림)
+    uint8_t samples;                          // 측정마다 평균할 수 (servo_cal_run)
+} servo_cal_config_t;
+
+typedef struct {
+    uint16_t current_ma;
+    int16_t feedback;                         // ADC 카운트 (방향/오프셋 무관)
+} servo_cal_sample_t;
+
+typedef struct {
+    uint16_t min_us, max_us, center_us;       // servo_ctx_set_calibration()에 넣을 값
+    uint16_t stop_min_us, stop_max_us;        // 정지점 직전의 마지막 정상 펄스 (못 찾았으면 스윕 한계)
+    bool min_found, max_found;
+    uint16_t steps;                           // 측정 횟수
+    uint16_t stalled_steps;                   // 정지점에 민 상태로 잰 횟수
+    uint32_t elapsed_ms;                      // 기다린 시간 합 (servo_cal_run은 측정 시간 포함)
+} servo_cal_result_t;
+
+typedef struct {
+    servo_cal_config_t config;
+    uint8_t state;
+    int8_t dir;                               // -1: min 쪽, +1: max 쪽
+    uint16_t pulse_us;                        // 지금 출력해야 할 펄스
+    uint16_t wait_ms;                         // 측정 전 기다릴 시간
+    uint16_t good_us;                         // 이번 방향의 마지막 정상 펄스
+    uint16_t base_ma;                         // 시작점 유지 전류
+    int16_t start_fb;
+    uint16_t ref_us;                          // 피드백 예측 기준 (coarse 단계의 마지막 정상 펄스)
+    int16_t ref_fb;
+    int32_t slope_q8;                         // 피드백 기울기 (카운트/us, Q8), 0이면 아직 모름
+    servo_cal_result_t result;
+} servo_cal_t;
+
+/**
+ * @brief 기본 설정 (1500 us에서 시작, 500 ~ 2500 us 안에서 20/2 us 간격, 여유 20 us, 전류 + 피드백).
+ */
+void servo_cal_default_config(servo_cal_config_t *config);
+
+/**
+ * @brief 스윕을 시작합니다. cal->pulse_us를 출력하고 cal->wait_ms 뒤에 잰 값을 servo_cal_step()에 넣으세요.
+ *
+ * @return 설정이 잘못되면 false (감지 방법 없음, 간격 0, 시작점이 한계 밖 등).
+ */
+bool servo_cal_begin(servo_cal_t *cal, const servo_cal_config_t *config);
+
+/**
+ * @brief 지금 펄스에서 잰 값을 넣고 다음 펄스를 정합니다.
+ *
+ * @return SERVO_CAL_RUNNING이면 cal->pulse_us / cal->wait_ms로 계속, DONE이면 cal->result에 결과.
+ *         FAILED는 정지점 사이가 너무 좁거나 피드백이 펄스를 전혀 따라오지 않을 때.
+ */
+servo_cal_status_t servo_cal_step(servo_cal_t *cal, const servo_cal_sample_t *sample);
+
+/**
+ * @brief 측정 함수. 서보 전류/피드백 한 번을 읽어 채웁니다 (사용하지 않는 항목은 0).
+ *
+ * @return 읽기 실패 시 false (스윕 중단).
+ */
+typedef bool (*servo_cal_read_fn)(void *arg, servo_cal_sample_t *sample);
+
+/**
+ * @brief 서보 하나의 캘리브레이션을 끝까지 돌리고 결과를 서보 상태에 저장합니다 (블로킹).
+ *
+ * 끝나면 서보를 center로 돌려 놓습니다. 실패하면 기존 캘리브레이션을 그대로 둡니다.
+ *
+ * @param result 결과 (NULL 가능).
+ * @return 성공 시 true.
+ */
+bool servo_cal_run(servo_ctx_t *ctx, uint16_t gpio_num, const servo_cal_config_t *config, servo_cal_read_fn read,
+                   void *arg, servo_cal_result_t *result);
+
+#endif // SERVO_CAL_H_
@@ -0,0 +1,114 @@
+#ifndef SERVO_DYN_H_
+#define SERVO_DYN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "servo.h"
+#include "servo_cal.h"
+
+/*
+ * 서보 동특성 측정 (계단 + 처프 응답 기록, 1차/2차 모델 맞춤).
+ *
+ * 기록: 중심 펄스에서 한 번 멈춘 뒤 +-step_us 계단을 steps번 (계단마다 step_hold_ms 유지) 주고,
+ * 이어서 chirp_amp_us 진폭의 선형 주파수 스윕(처프)을 chirp_ms 동안 줍니다. sample_us마다 위치 피드백을 읽고
+ * 그 시각(time_us_64)과 곧바로 낸 명령 펄스를 같이 기록합니다. 계단은 속도 한계와 피드백 배율을, 작은 처프는
+ * 내부 제어가 포화하지 않는 선형 구간의 지연/대역폭을 드러냅니다.
+ *
+ * 맞춤 (servo_dyn_fit, 설정 없이 기록만으로):
+ *   1. 명령이 오래 같았던 구간(계단)의 끝부분으로 피드백 = fb_offset + fb_per_us x 펄스 를 맞춰 펄스 단위로 바꿈
+ *   2. 큰 계단마다 최대 속도 -> slew_us_per_s
+ *   3. 기록 전체를 모델로 시뮬레이션(기록된 명령, 실제 시각 간격)해 출력 오차 제곱합이 최소인 파라미터를 패턴 탐색으로:
+ *      1차 (지연, 시정수), 2차 (지연, 고유진동수, 감쇠비). 둘 다 속도 한계 포함
+ * 출력 오차 방식이라 피드백 잡음에 편향되지 않지만 시뮬레이션을 수백 번 합니다 (float, 측정 모드에서 한 번).
+ *
+ * servo_dyn_run()은 기록 + 맞춤 후 모델을 서보 슬롯에 저장합니다 (servo_ctx_set_model).
+ */
+
+// --- 설정값 ---
+#define SERVO_DYN_MIN_HOLD_MS 150             // 명령이 이만큼 같아야 계단 구간으로 봄 (처프와 구분)
+#define SERVO_DYN_SETTLED_PCT 30              // 계단 구간의 마지막 이 비율을 자리 잡은 값으로 씀
+#define SERVO_DYN_SLEW_MIN_STEP_US 100        // 속도 한계를 잴 최소 계단 크기
+#define SERVO_DYN_SLEW_WINDOW_US 10000        // 속도 계산 구간 (피드백 잡음 평균)
+#define SERVO_DYN_MAX_DELAY_US 60000
+#define SERVO_DYN_MAX_EVALS 400               // 모델당 시뮬레이션 횟수 한도
+
+typedef struct {
+    uint16_t center_us;                       // 중심 펄스, 0이면 서보 캘리브레이션의 center
+    uint16_t step_us;                         // 계단 크기 (중심에서 +-, 캘리브레이션 min/max 안으로 줄임)
+    uint8_t steps;                            // +, - 번갈아
+    uint16_t step_hold_ms;
+    uint16_t chirp_amp_us;                    // 작게: 내부 제어가 포화하지 않는 선형 구간
+    uint16_t chirp_start_hz_x10, chirp_end_hz_x10;
+    uint16_t chirp_ms;
+    uint16_t sample_us;                       // 명령 / 측정 간격
+} servo_dyn_config_t;
+
+typedef struct {
+    uint32_t t_us;                            // 기록 시작부터 (피드백을 읽은 시각, 명령도 이때 냄)
+    uint16_t cmd_us;
+    int16_t feedback;
+} servo_dyn_sample_t;
+
+typedef struct {
+    servo_model_t model;
+    float fb_offset, fb_per_us;               // 피드백 = fb_offset + fb_per_us x 펄스
+    float rms_us[3];                          // 측정 기록에 대한 출력 오차 (0: 동특성 없음, 1: 1차, 2: 2차)
+    uint8_t slew_steps;                       // 속도 한계를 잰 계단 수
+    uint16_t evals;                           // 모델 시뮬레이션 횟수 (연산량)
+} servo_dyn_fit_t;
+
+/**
+ * @brief 기본 설정 (+-200 us 계단 6번 400 ms씩, +-25 us 처프 0.5 ~ 8 Hz 4 s, 2 ms 간격: 약 3400 샘플).
+ */
+void servo_dyn_default_config(servo_dyn_config_t *config);
+
+/**
+ * @brief 기록에 필요한 샘플 수.
+ */
+uint32_t servo_dyn_sample_count(const servo_dyn_config_t *config);
+
+/**
+ * @brief 기록 시작 후 t_us 시각의 명령 펄스 (center_us / step_us는 이미 정해진 값이어야 함, fxmath_init() 이후).
+ */
+uint16_t servo_dyn_command(const servo_dyn_config_t *config, uint32_t t_us);
+
+/**
+ * @brief 계단 + 처프를 출력하며 피드백을 기록합니다 (블로킹, 끝나면 중심 펄스 유지).
+ *
+ * @param read 피드백 측정 함수 (servo_cal과 같음, current_ma는 쓰지 않음).
+ * @param count 기록한 샘플 수.
+ * @return 실패 시 false (초기화되지 않은 서보, 버퍼 부족, 측정 실패, 중심 펄스가 캘리브레이션 밖).
+ */
+bool servo_dyn_record(servo_ctx_t *ctx, uint16_t gpio_num, const servo_dyn_config_t *config, servo_cal_read_fn read,
+                      void *arg, servo_dyn_sample_t *samples, uint32_t capacity, uint32_t *count);
+
+/**
+ * @brief 기록에 1차/2차 모델을 맞춥니다.
+ *
+ * @return 피드백이 명령을 따라오지 않으면 (계단 구간이 두 개 미만, 배율이 너무 작음) false.
+ */
+bool servo_dyn_fit(const servo_dyn_sample_t *samples, uint32_t count, servo_dyn_fit_t *fit);
+
+/**
+ * @brief 맞춘 모델(fit->model)로 기록의 명령을 시뮬레이션해 피드백(펄스 환산)과 비교합니다.
+ *
+ * 다른 명령으로 새로 잰 기록에 쓰면 모델 검증이 됩니다.
+ *
+ * @param order 0: 동특성 없음 (위치 = 명령), 1: 1차, 2: 2차.
+ * @param out_us NULL이 아니면 샘플마다 모델 출력 (펄스 단위).
+ * @return 출력 오차 RMS (us).
+ */
+float servo_dyn_predict(const servo_dyn_fit_t *fit, uint8_t order, const servo_dyn_sample_t *samples, uint32_t count,
+                        float *out_us);
+
+/**
+ * @brief 기록 + 맞춤 후 모델을 서보 슬롯에 저장합니다 (블로킹).
+ *
+ * @param samples 기록 버퍼 (servo_dyn_sample_count() 이상).
+ * @param fit 결과 (NULL 가능).
+ * @return 성공 시 true.
+ */
+bool servo_dyn_run(servo_ctx_t *ctx, uint16_t gpio_num, const servo_dyn_config_t *config, servo_cal_read_fn read,
+                   void *arg, servo_dyn_sample_t *samples, uint32_t capacity, servo_dyn_fit_t *fit);
+
+#endif // SERVO_DYN_H_
@@ -0,0 +1,55 @@
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 단일 생산자/단일 소비자 lock-free 링 버퍼.
+ *
+ * 생산자와 소비자가 서로 다른 코어/태스크에 있어도 락이나 인터럽트 차단 없이 동작합니다.
+ * Cortex-M0+에는 LDREX/STREX가 없으므로 읽기-수정-쓰기 없이 정렬된 32비트
+ * load/store와 메모리 배리어만 사용합니다.
+ * 저장 공간은 호출자가 정적으로 제공하며, 슬롯 개수는 2의 거듭제곱이어야 합니다.
+ */
+typedef struct {
+    uint8_t *storage;
+    uint32_t elem_size;
+    uint32_t mask;               // 슬롯 개수 - 1
+    _Atomic uint32_t head;       // 생산자만 쓰기
+    _Atomic uint32_t tail;       // 소비자만 쓰기
+    _Atomic uint32_t dropped;    // 가득 차서 버려진 항목 수 (생산자만 쓰기)
+} spsc_queue_t;
+
+/**
+ * @brief 큐를 초기화합니다.
+ *
+ * @param q 대상 큐.
+ * @param storage elem_size * slots 바이트 이상의 저장 공간.
+ * @param elem_size 항목 하나의 크기 (바이트).
+ * @param slots 슬롯 개수 (2의 거듭제곱).
+ * @return 성공 시 true, 실패 시 false (slots가 2의 거듭제곱이 아님 등).
+ */
+bool spsc_queue_init(spsc_queue_t *q, void *storage, uint32_t elem_size, uint32_t slots);
+
+/**
+ * @brief 항목 하나를 넣습니다 (생산자 전용, 블로킹 없음).
+ *
+ * @return 성공 시 true, 큐가 가득 찼으면 false (dropped 카운터 증가).
+ */
+bool spsc_queue_push(spsc_queue_t *q, const void *item);
+
+/**
+ * @brief 항목 하나를 꺼냅니다 (소비자 전용, 블로킹 없음).
+ *
+ * @return 꺼냈으면 true, 큐가 비었으면 false.
+ */
+bool spsc_queue_pop(spsc_queue_t *q, void *item);
+
+/**
+ * @brief 현재 대기 중인 항목 수 (어느 쪽에서 호출해도 근사값으로 유효).
+ */
+uint32_t spsc_queue_count(const spsc_queue_t *q);
+
+#endif // SPSC_QUEUE_H_
@@ -0,0 +1,140 @@
+#ifndef TLM_RATE_H_
+#define TLM_RATE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 적응형 텔레메트리 송신률 제어 (무엇을 언제 보낼지 결정).
+ *
+ * 메시지 종류마다 스트림을 하나 두고, 비행 단계별 목표 송신률과 우선순위를 줍니다.
+ *   - 주기 스트림 : 단계별 목표 송신률 (0.1 Hz 단위). 예산이 모자라면 우선순위 순으로 나눠 줌
+ *                   (먼저 모든 스트림의 최소 송신률, 그다음 우선순위가 높은 스트림부터 목표까지)
+ *   - 이벤트 스트림: tlm_rate_event()로 요청할 때만 보냄 (서보 동작, 최고점 등). 주기 스트림보다
+ *                   먼저 나가고, 링크 전달률이 낮으면 같은 프레임을 여러 번 보내 전달 확률을 맞춤
+ *
+ * 송신은 바이트 예산(토큰 버킷)으로 제한합니다. 예산은 지상국의 링크 보고(link_report 메시지:
+ * 마지막으로 받은 seq, 누적 수신 프레임 수, 수신 RSSI)로 조절합니다:
+ *   - 보고 구간 전달률이 높고 예산을 절반 이상 쓰고 있으면 예산을 조금씩 늘림 (가산 증가, 공칭 용량까지)
+ *   - 지상국이 아직 받지 못한 바이트(마지막 보고 seq 이후 보낸 양)가 지금 송신량으로 QUEUE_MS 이상이면
+ *     무선 모듈 버퍼에 쌓이는 중(혼잡)이므로 예산을 줄임 (승산 감소). 버퍼가 넘치기 전에 잡아 이벤트 지연을 막음
+ *   - 전달률이 낮은데 RSSI가 충분하면 버퍼가 넘친 것(혼잡)으로 보고 마찬가지로 줄임
+ *   - RSSI가 페이드 기준보다 낮으면 손실은 예산과 무관하므로 예산은 두고 이벤트 반복만 늘림
+ *   - 보고가 끊기면 (업링크도 끊긴 것) 예산을 줄이고 전달률을 0 쪽으로 내림
+ *
+ * seq는 실제 송신 순서대로 매기므로 (dl_sched) 이 스케줄러가 고르지 않은 프레임까지 하향 링크로 나가는
+ * 모든 프레임을 tlm_rate_sent()로 알려야 전달률/대기량 계산이 맞습니다. 시간은 ms 단위 32비트 (넘침 허용).
+ */
+
+// --- 설정값 ---
+#define TLM_RATE_MAX_STREAMS 8
+#define TLM_RATE_PHASES 4                     // flight_phase_t 수 (PAD, ASCENT, DESCENT, LANDED)
+#define TLM_RATE_MAX_REPEAT 4                 // 이벤트 반복 송신 상한
+#define TLM_RATE_REPEAT_GAP_MS 250            // 같은 이벤트 사본 사이 간격 (페이드가 지나가도록)
+#define TLM_RATE_EVENT_RESERVE_SHIFT 3        // 예산의 1/8은 주기 스트림에 배정하지 않고 이벤트용으로 남김
+#define TLM_RATE_EVENT_MISS_Q16 655           // 이벤트를 놓칠 확률 목표 (1%)
+#define TLM_RATE_GOOD_Q8 243                  // 보고 구간 전달률이 이 이상이면 예산 증가 (95%)
+#define TLM_RATE_BAD_Q8 205                   // 이 미만이면 예산 감소 (80%)
+#define TLM_RATE_INCREASE_SHIFT 4             // 가산 증가 폭 = 공칭 용량 / 16
+#define TLM_RATE_MIN_BUDGET_SHIFT 3           // 예산 하한 = 공칭 용량 / 8
+#define TLM_RATE_EWMA_SHIFT 2                 // 전달률 평활 (보고 4개)
+#define TLM_RATE_REPORT_TIMEOUT_MS 3000       // 보고가 이만큼 없으면 링크 끊김으로 봄
+#define TLM_RATE_QUEUE_MS 300                 // 지상국에 아직 닿지 않은 양이 이만큼이면 혼잡
+#define TLM_RATE_SEQ_HISTORY 64               // seq별 누적 송신 바이트 기록 (2의 거듭제곱)
+#define TLM_RATE_BURST_MS 100                 // 토큰 버킷 깊이 (예산 x 이 시간, 최소 프레임 하나)
+#define TLM_RATE_RSSI_UNKNOWN INT8_MIN
+
+typedef struct {
+    uint16_t frame_bytes;                     // 링크 프레임 크기 (COBS/CRC/구분자 포함)
+    uint8_t priority;                         // 0이 가장 높음
+    bool event;                               // 이벤트 스트림 (rate_dhz, min_rate_dhz 무시)
+    uint16_t rate_dhz[TLM_RATE_PHASES];       // 단계별 목표 송신률 (0.1 Hz), 0이면 그 단계에서 안 보냄
+    uint16_t min_rate_dhz;                    // 예산이 모자라도 지키는 송신률 (목표보다 크면 목표까지)
+} tlm_stream_config_t;
+
+typedef struct {
+    uint16_t alloc_dhz;                       // 현재 배정된 송신률
+    uint32_t period_ms;                       // 10000 / alloc_dhz
+    uint32_t next_ms;                         // 다음 송신 예정 시각
+    uint8_t repeat;                           // 남은 이벤트 송신 횟수 (다음 사본은 next_ms 이후)
+    uint32_t sent;                            // 보낸 프레임 수 (이벤트 반복 포함)
+    uint32_t deferred;                        // 예정 시각이 됐지만 예산이 없어 미룬 횟수
+} tlm_stream_state_t;
+
+typedef struct {
+    tlm_stream_config_t config[TLM_RATE_MAX_STREAMS];
+    tlm_stream_state_t state[TLM_RATE_MAX_STREAMS];
+    uint8_t order[TLM_RATE_MAX_STREAMS];      // 우선순위 순 스트림 번호
+    uint8_t count;
+    uint8_t phase;
+    uint32_t max_bps;                         // 공칭 링크 용량 (바이트/s)
+    uint32_t budget_bps;                      // 현재 송신 예산 (바이트/s)
+    uint32_t tokens_mb;                       // 토큰 (밀리바이트)
+    uint32_t last_ms;
+    bool started;
+    uint16_t tx_seq;                          // 마지막으로 보낸 프레임 seq + 1
+    uint32_t tx_bytes;                        // 누적 송신 바이트 (넘침 허용)
+    uint32_t seq_bytes[TLM_RATE_SEQ_HISTORY]; // seq & (HISTORY - 1) 프레임까지의 tx_bytes
+    uint16_t report_seq, report_rx;           // 직전 보고의 마지막 seq / 누적 수신 수
+    uint32_t report_ms;                       // 직전 보고 (또는 끊김 처리) 시각
+    uint32_t report_bytes;                    // 직전 보고 이후 보낸 바이트
+    bool have_report;
+    uint16_t delivery_q8;                     // 전달률 EWMA (256 = 100%)
+    int8_t rssi_dbm;                          // 마지막 보고의 지상국 RSSI
+    int8_t fade_dbm;                          // 이보다 낮으면 손실을 혼잡으로 보지 않음
+    uint8_t event_repeat;                     // 현재 전달률에서 이벤트 하나당 송신 횟수
+} tlm_rate_t;
+
+/**
+ * @brief 스케줄러를 초기화합니다. PAD 단계, 예산 = 공칭 용량, 전달률 100%로 시작합니다.
+ *
+ * @param streams 스트림 설정 count개 (복사함). 스트림 번호는 배열 순서.
+ * @param max_bps 공칭 링크 용량 (바이트/s). 무선 모듈 공중 전송률에서 오버헤드를 뺀 값.
+ * @param fade_dbm 지상국 RSSI가 이보다 낮으면 페이드로 판단 (수신 감도 + 여유).
+ * @return 인자가 범위를 벗어나면 false.
+ */
+bool tlm_rate_init(tlm_rate_t *t, const tlm_stream_config_t *streams, uint8_t count, uint32_t max_bps,
+                   int8_t fade_dbm);
+
+/**
+ * @brief 비행 단계를 바꿉니다 (단계별 송신률로 다시 배정).
+ */
+void tlm_rate_set_phase(tlm_rate_t *t, uint8_t phase);
+
+/**
+ * @brief 이벤트 스트림의 송신을 요청합니다. 아직 다 보내지 못한 이전 요청은 새 요청으로 바뀝니다.
+ *
+ * 첫 사본은 다음 tlm_rate_next()에서 바로 나가고, 반복 사본은 TLM_RATE_REPEAT_GAP_MS 간격으로 나갑니다.
+ *
+ * @return 이벤트 스트림이 아니면 false.
+ */
+bool tlm_rate_event(tlm_rate_t *t, uint8_t stream);
+
+/**
+ * @brief 지금 보낼 스트림을 하나 고릅니다. 보낼 것이 없을 때까지 반복 호출하세요.
+ *
+ * 고른 스트림은 예산을 쓴 것으로 처리하므로 호출자는 반드시 그 메시지를 송신 큐에 넣어야 합니다.
+ *
+ * @param now_ms 현재 시각.
+ * @return 스트림 번호, 보낼 것이 없거나 예산이 없으면 -1.
+ */
+int tlm_rate_next(tlm_rate_t *t, uint32_t now_ms);
+
+/**
+ * @brief 하향 링크로 프레임 하나를 내보냈음을 알립니다 (송신 순서대로, 모든 프레임).
+ *
+ * @param seq 프레임에 매긴 seq (dl_sched_dequeue).
+ * @param bytes 링크 프레임 크기.
+ */
+void tlm_rate_sent(tlm_rate_t *t, uint16_t seq, uint32_t bytes);
+
+/**
+ * @brief 지상국 링크 보고를 반영합니다.
+ *
+ * @param last_seq 지상국이 마지막으로 받은 프레임 seq.
+ * @param rx_frames 지상국 누적 수신 프레임 수 (16비트 넘침 허용).
+ * @param rssi_dbm 지상국 수신 RSSI, 모르면 TLM_RATE_RSSI_UNKNOWN.
+ */
+void tlm_rate_report(tlm_rate_t *t, uint16_t last_seq, uint16_t rx_frames, int8_t rssi_dbm, uint32_t now_ms);
+
+#endif // TLM_RATE_H_
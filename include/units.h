@@ -0,0 +1,54 @@
+#ifndef UNITS_H_
+#define UNITS_H_
+
+#include <stdint.h>
+
+/*
+ * 센서 원시값 <-> 물리량 변환 규약.
+ *
+ * flight_record_t 에는 센서 원시값이, 텔레메트리(messages.schema)에는 고정소수점 물리량이
+ * 들어갑니다. 기체와 지상 도구가 같은 결과를 내도록 변환은 모두 이 파일의 상수와
+ * "곱한 뒤 반올림 시프트" 형식 하나로 정의합니다:
+ *
+ *     out = (raw * MUL + (1 << (SHIFT - 1))) >> SHIFT      (32비트 정수, 산술 시프트)
+ *
+ * 지상 도구의 벡터 커널(host/logk.h)도 이 식을 그대로 구현하므로 결과가 비트 단위로 같습니다.
+ */
+
+// --- 센서 설정 ---
+#define UNITS_ACCEL_LSB_PER_G 2048      // ±16 g
+#define UNITS_GYRO_LSB_PER_DPS 16.4f    // ±2000 dps
+#define UNITS_STANDARD_GRAVITY 9.80665f
+#define UNITS_SEA_LEVEL_PA 101325
+
+// --- 고정소수점 변환 상수 ---
+// 가속도 원시값 -> mg : raw * 1000 / 2048
+#define UNITS_ACCEL_MG_MUL 1000
+#define UNITS_ACCEL_MG_SHIFT 11
+
+// 자이로 원시값 -> 0.1 dps : raw * 10 / 16.4 = raw * round(65536 * 10 / 16.4) >> 16
+#define UNITS_GYRO_DPS10_MUL 39961
+#define UNITS_GYRO_DPS10_SHIFT 16
+
+// --- 물리량 배율 (지상 도구의 부동소수점 변환) ---
+#define UNITS_ACCEL_MPS2_PER_LSB (UNITS_STANDARD_GRAVITY / UNITS_ACCEL_LSB_PER_G)
+#define UNITS_GYRO_DPS_PER_LSB (1.0f / UNITS_GYRO_LSB_PER_DPS)
+
+// --- 기압 고도 (국제 표준 대기, 대류권) ---
+// alt_m = UNITS_BARO_SCALE_M * (1 - (p / p0) ^ UNITS_BARO_EXPONENT)
+#define UNITS_BARO_SCALE_M 44330.77f
+#define UNITS_BARO_EXPONENT 0.190263f
+
+static inline int16_t units_fixmul_i16(int16_t raw, int32_t mul, uint32_t shift) {
+    return (int16_t)(((int32_t)raw * mul + (1 << (shift - 1))) >> shift);
+}
+
+static inline int16_t units_accel_to_mg(int16_t raw) {
+    return units_fixmul_i16(raw, UNITS_ACCEL_MG_MUL, UNITS_ACCEL_MG_SHIFT);
+}
+
+static inline int16_t units_gyro_to_dps10(int16_t raw) {
+    return units_fixmul_i16(raw, UNITS_GYRO_DPS10_MUL, UNITS_GYRO_DPS10_SHIFT);
+}
+
+#endif // UNITS_H_
@@ -0,0 +1,30 @@
+#ifndef USB_OFFLOAD_H_
+#define USB_OFFLOAD_H_
+
+#include <stdbool.h>
+
+/*
+ * USB 로그 오프로드 (타깃 전용).
+ *
+ * TinyUSB vendor 인터페이스(bulk EP 0x01/0x81) 위에서 offload_dev 엔진을 돌리며,
+ * 두 가지 소스를 제공합니다.
+ *   OFFLOAD_SRC_SDLOG : SD 카드의 FLIGHT.LOG (헤더 블록 + 기록된 데이터)
+ *   OFFLOAD_SRC_FLASH : 온보드 QSPI 플래시 전체 (XIP 캐시 우회 주소에서 DMA)
+ * 지상 쪽은 host/offload_tool 을 사용합니다.
+ */
+
+/**
+ * @brief 소스와 전송 계층을 준비합니다. tusb_init() 뒤에 호출합니다.
+ *
+ * SD 카드나 로그 파일이 없으면 SDLOG 소스만 비활성화되고 FLASH는 계속 제공합니다.
+ *
+ * @return SD 로그 파일을 찾았으면 true.
+ */
+bool usb_offload_init(void);
+
+/**
+ * @brief 요청 처리와 프레임 전송을 진행합니다 (블로킹 없음, tud_task()와 번갈아 호출).
+ */
+void usb_offload_task(void);
+
+#endif // USB_OFFLOAD_H_
@@ -0,0 +1,105 @@
+#ifndef VIBRATION_H_
+#define VIBRATION_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "fxfft.h"
+#include "fxfilter.h"
+#include "spsc_queue.h"
+
+/*
+ * 기체 진동 스펙트럼 분석 (IMU 한 축 샘플 블록 -> 우세 진동 주파수).
+ *
+ * 생산자(IMU 샘플링, 제어 코어)는 vibration_add_samples()로 샘플을 넣기만 하고, 블록이 차면
+ * SPSC 큐로 넘깁니다. 소비자(core 0 유휴 우선순위 태스크)는 vibration_process()로
+ * 평균 제거 -> Hann 창 -> 고정소수점 FFT -> 파워 스펙트럼 -> 중앙값 잡음 바닥 대비 피크 검출을 하고
+ * 결과를 시퀀스 잠금(seqlock)으로 게시합니다. 텔레메트리와 제어 루프가 각자 최신 결과를 읽습니다.
+ *
+ * 피크 주파수는 로그 파워 3점 포물선 보간으로 빈 간격의 약 1/20까지, 진폭은 입력 LSB 단위
+ * (사인파 진폭, Hann 창 이득/스캘럽 손실 보정)로 보고합니다.
+ */
+
+// --- 설정값 ---
+#define VIBRATION_FFT_LOG2 9
+#define VIBRATION_FFT_SIZE (1 << VIBRATION_FFT_LOG2)   // 512 (1 kHz에서 약 0.5초, 빈 간격 1.95 Hz)
+#define VIBRATION_QUEUE_BLOCKS 2                        // 생산자 -> 분석 블록 큐 (2의 거듭제곱)
+#define VIBRATION_MAX_PEAKS 3
+#define VIBRATION_MIN_FREQ_DHZ 50                       // 이보다 낮은 성분(자세 변화)은 무시 (0.1 Hz 단위)
+#define VIBRATION_MIN_SNR_DB 12                         // 잡음 바닥 대비 최소 피크 높이
+#define VIBRATION_DYN_RANGE_DB 30                       // 최대 피크보다 이만큼 낮은 피크는 버림 (Hann 부엽 -31 dB)
+#define VIBRATION_MAX_RATE_HZ 8000
+
+typedef struct {
+    uint16_t freq_dhz;       // 주파수 (0.1 Hz)
+    uint16_t amplitude;      // 사인파 진폭 (입력 LSB)
+    uint8_t snr_db;          // 잡음 바닥 대비 (dB)
+} vibration_peak_t;
+
+typedef struct {
+    uint32_t block_seq;      // 분석한 블록 번호 (1부터)
+    uint8_t count;           // 유효한 피크 수 (파워 내림차순)
+    vibration_peak_t peaks[VIBRATION_MAX_PEAKS];
+} vibration_result_t;
+
+typedef struct {
+    // 생산자 전용
+    int16_t fill[VIBRATION_FFT_SIZE];
+    uint16_t fill_count;
+
+    spsc_queue_t blocks;
+    int16_t block_slots[VIBRATION_QUEUE_BLOCKS][VIBRATION_FFT_SIZE];
+
+    // 소비자 전용
+    int16_t window[VIBRATION_FFT_SIZE];               // Hann, Q15
+    fxfft_cpx_t work[VIBRATION_FFT_SIZE];
+    uint32_t power[VIBRATION_FFT_SIZE / 2];
+    uint32_t sample_rate_hz;
+    uint32_t block_seq;
+
+    // 게시된 결과 (seq가 홀수면 쓰는 중)
+    _Atomic uint32_t result_seq;
+    vibration_result_t result;
+} vibration_t;
+
+/**
+ * @brief 분석기를 초기화합니다 (창/회전 인자 표 계산 포함, 시작 시 한 번).
+ *
+ * @param sample_rate_hz 입력 샘플링 주파수 (VIBRATION_MAX_RATE_HZ 이하).
+ * @return sample_rate_hz가 범위를 벗어나면 false.
+ */
+bool vibration_init(vibration_t *v, uint32_t sample_rate_hz);
+
+/**
+ * @brief 샘플을 추가합니다 (생산자 전용, 블로킹 없음).
+ *
+ * 블록(VIBRATION_FFT_SIZE개)이 찰 때마다 분석 큐에 넣습니다. 큐가 가득 차면 그 블록은 버려지고
+ * blocks.dropped가 증가합니다 (분석이 유휴 시간에만 돌기 때문에 정상적인 상황).
+ */
+void vibration_add_samples(vibration_t *v, const int16_t *samples, size_t n);
+
+/**
+ * @brief 대기 중인 블록 하나를 분석해 결과를 게시합니다 (소비자 전용).
+ *
+ * @return 분석한 블록이 있으면 true, 큐가 비었으면 false.
+ */
+bool vibration_process(vibration_t *v);
+
+/**
+ * @brief 최신 분석 결과를 복사합니다 (어느 코어/태스크에서나 호출 가능, 여러 독자 허용).
+ *
+ * @return 결과가 한 번 이상 게시되었으면 true (out->block_seq로 새 결과인지 판단).
+ */
+bool vibration_get_result(const vibration_t *v, vibration_result_t *out);
+
+/**
+ * @brief 피크 주파수에 맞춘 노치 필터 계수를 구합니다 (부동소수점, 결과가 바뀔 때만 호출).
+ *
+ * @param filter_rate_hz 노치를 적용할 신호의 샘플링 주파수.
+ * @param q 선택도 (중심 주파수 / -3 dB 대역폭).
+ * @return 피크가 filter_rate_hz의 나이퀴스트 주파수 이상이면 false.
+ */
+bool vibration_notch(const vibration_peak_t *peak, uint32_t filter_rate_hz, float q, fxfilter_biquad_coef_t *coef);
+
+#endif // VIBRATION_H_
@@ -0,0 +1,297 @@
+#include "app_tasks.h"
+#include "servo.h"
+#include "spsc_queue.h"
+#include "params.h"
+#include "sdlog.h"
+#include "sd_block.h"
+#include "logz.h"
+#include "vibration.h"
+#include "coro.h"
+#include "coro_hw.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// 태스크 스택 크기 (word 단위)
+#define CONTROL_STACK_WORDS 512
+#define TELEMETRY_STACK_WORDS 1024
+#define LOG_STACK_WORDS 1024
+#define VIBRATION_STACK_WORDS 256
+#define CORO_STACK_WORDS 512
+
+// 코루틴 태스크가 타이머 대기 중 한 번에 블로킹하는 최대 시간 (ms). 더 길면 깨어나 다시 poll
+#define CORO_MAX_BLOCK_MS 1000u
+
+// --- 태스크 간 큐 (제어 태스크가 유일한 생산자) ---
+static app_control_sample_t telemetry_slots[APP_QUEUE_SLOTS];
+static app_control_sample_t log_slots[APP_QUEUE_SLOTS];
+static spsc_queue_t telemetry_queue;
+static spsc_queue_t log_queue;
+
+// --- SD 로그 (로그 태스크 전용) ---
+// 제어 태스크가 서보 핀을 PWM으로 바꾸므로 SD 카드 SPI 핀과 겹치면 안 됨
+_Static_assert(APP_SERVO_GPIO != SD_SPI_SCK_GPIO && APP_SERVO_GPIO != SD_SPI_MOSI_GPIO &&
+                   APP_SERVO_GPIO != SD_SPI_MISO_GPIO && APP_SERVO_GPIO != SD_SPI_CS_GPIO,
+               "servo GPIO overlaps the SD card SPI pins");
+// 가장 짧은 제어 주기에서도 로그 태스크가 큐를 비우기 전에 넘치지 않도록 (주기 4번 밀려도 여유)
+_Static_assert(4u * APP_LOG_POLL_MS < APP_QUEUE_SLOTS * APP_CONTROL_MIN_PERIOD_MS, "log queue too small for poll period");
+// app_control_sample_t 앞부분(패딩 없는 21 바이트)을 필드별 델타로 압축
+_Static_assert(offsetof(app_control_sample_t, servo_angle) == 20, "sample fields must be contiguous");
+
+static const logz_layout_t sample_layout = {
+    .field_count = 5,
+    .field_size = { 8, 4, 4, 4, 1 }, // timestamp, seq, jitter, exec, angle
+};
+static logz_writer_t log_writer;
+static atomic_bool log_close_requested;
+
+// --- 진동 분석 (생산자: app_vibration_feed 호출 태스크, 소비자: 진동 태스크) ---
+static vibration_t vibration;
+
+// --- 드라이버 코루틴 (코루틴 태스크가 실행, coro_hw 인터럽트가 태스크 알림으로 깨움) ---
+static coro_executor_t coro_exec;
+static TaskHandle_t coro_handle = NULL;
+
+// --- 내부 함수 ---
+
+// 다음 서보 명령 계산. 실제 제어 법칙이 들어오기 전까지는 0~180도 삼각파 스윕
+static uint8_t next_servo_angle(uint32_t seq) {
+    uint32_t phase = seq % 360u;
+    return (uint8_t)(phase <= 180u ? phase : 360u - phase);
+}
+
+static void control_task(void *param) {
+    (void)param;
+
+    uint16_t min_pulse_us = (uint16_t)params_get(PARAM_SERVO_MIN_PULSE_US).u32;
+    uint16_t max_pulse_us = (uint16_t)params_get(PARAM_SERVO_MAX_PULSE_US).u32;
+    if (!servo_init(APP_SERVO_GPIO, min_pulse_us, max_pulse_us)) {
+        printf("Error: servo init failed on GPIO %d, control task stopped.\n", APP_SERVO_GPIO);
+        vTaskDelete(NULL); // 반환되지 않음
+    }
+
+    TickType_t last_wake = xTaskGetTickCount();
+    uint64_t expected_us = time_us_64();
+    uint32_t seq = 0;
+
+    while (true) {
+        uint64_t start_us = time_us_64();
+        // 이번 주기 동안 사용할 파라미터 스냅샷 (지상국 갱신은 다음 주기부터 반영)
+        const param_value_t *p = params_acquire();
+        uint32_t period_ms = p[PARAM_CTRL_PERIOD_MS].u32;
+
+        // 지상국이 펄스 범위를 바꾸면 캘리브레이션에 반영 (min >= max처럼 잘못된 조합은 거부되고 이전 값 유지)
+        uint16_t new_min_us = (uint16_t)p[PARAM_SERVO_MIN_PULSE_US].u32;
+        uint16_t new_max_us = (uint16_t)p[PARAM_SERVO_MAX_PULSE_US].u32;
+        if (new_min_us != min_pulse_us || new_max_us != max_pulse_us) {
+            if (!servo_set_calibration(APP_SERVO_GPIO, new_min_us, new_max_us, 0)) {
+                printf("Error: servo pulse range %u..%u rejected.\n", new_min_us, new_max_us);
+            }
+            min_pulse_us = new_min_us;
+            max_pulse_us = new_max_us;
+        }
+
+        app_control_sample_t sample;
+        sample.timestamp_us = start_us;
+        sample.seq = seq;
+        sample.jitter_us = (int32_t)(start_us - expected_us);
+        sample.servo_angle = next_servo_angle(seq);
+
+        servo_set(APP_SERVO_GPIO, sample.servo_angle);
+        sample.exec_us = (uint32_t)(time_us_64() - start_us);
+
+        // 가득 차면 버리고 계속 진행 (제어 주기는 하위 태스크를 기다리지 않음)
+        spsc_queue_push(&telemetry_queue, &sample);
+        spsc_queue_push(&log_queue, &sample);
+
+        params_release();
+
+        ++seq;
+        expected_us += (uint64_t)period_ms * 1000u;
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(period_ms));
+    }
+}
+
+static void telemetry_task(void *param) {
+    (void)param;
+    app_control_sample_t sample;
+    vibration_result_t vib;
+    uint32_t vib_seq = 0;
+
+    while (true) {
+        // 최신 샘플만 송신, 나머지는 건너뜀
+        bool have = false;
+        while (spsc_queue_pop(&telemetry_queue, &sample)) {
+            have = true;
+        }
+        if (have) {
+            printf("TLM seq=%lu t=%llu angle=%u jitter=%ld\n",
+                   (unsigned long)sample.seq, (unsigned long long)sample.timestamp_us,
+                   sample.servo_angle, (long)sample.jitter_us);
+        }
+        // 새 진동 분석 결과가 있으면 우세 주파수 (0.1 Hz), 진폭 (LSB), SNR (dB)
+        if (vibration_get_result(&vibration, &vib) && vib.block_seq != vib_seq) {
+            vib_seq = vib.block_seq;
+            printf("VIB block=%lu", (unsigned long)vib.block_seq);
+            for (uint8_t i = 0; i < vib.count; ++i) {
+                printf(" f%u=%u.%u a%u=%u snr%u=%u", i, vib.peaks[i].freq_dhz / 10u, vib.peaks[i].freq_dhz % 10u,
+                       i, vib.peaks[i].amplitude, i, vib.peaks[i].snr_db);
+            }
+            printf(" dropped=%lu\n", (unsigned long)atomic_load(&vibration.blocks.dropped));
+        }
+        vTaskDelay(pdMS_TO_TICKS(params_get(PARAM_TLM_PERIOD_MS).u32));
+    }
+}
+
+static void log_task(void *param) {
+    (void)param;
+    app_control_sample_t sample;
+
+    // 카드가 없으면 요약 출력만 계속함
+    bool sd_ok = sdlog_init(APP_LOG_FILE_BYTES) && logz_writer_init(&log_writer, &sample_layout, sdlog_write);
+    if (!sd_ok) {
+        printf("Warning: SD log unavailable, printing summaries only.\n");
+    }
+
+    TickType_t last_print = xTaskGetTickCount();
+    TickType_t last_flush = last_print;
+    uint32_t n = 0;             // 이번 출력 주기의 샘플 수 / 최댓값
+    int32_t max_jitter = 0;
+    uint32_t max_exec = 0;
+
+    while (true) {
+        TickType_t now = xTaskGetTickCount();
+
+        if (sd_ok && atomic_load_explicit(&log_close_requested, memory_order_acquire)) {
+            // 큐에 남은 샘플과 채우던 logz 블록까지 기록한 뒤 파일을 닫음
+            while (spsc_queue_pop(&log_queue, &sample)) logz_writer_add(&log_writer, &sample);
+            logz_writer_flush(&log_writer);
+            bool closed = sdlog_close();
+            printf("LOG closed sd=%s\n", closed ? "ok" : "error");
+            sd_ok = false;
+        }
+
+        if (sd_ok) {
+            // 채우던 블록이 오래 머물지 않도록 (전원이 끊기면 잃는 양의 상한)
+            if (now - last_flush >= pdMS_TO_TICKS(APP_LOG_FLUSH_MS)) {
+                logz_writer_flush(&log_writer);
+                last_flush = now;
+            }
+            // 블록 전송은 DMA 하나씩이라 짧은 주기로 자주 호출해야 카드 속도를 씀
+            sdlog_poll();
+        }
+
+        // 큐는 출력 주기와 무관하게 매 주기 비움 (log.period_ms가 길어도 APP_QUEUE_SLOTS를 넘지 않도록)
+        while (spsc_queue_pop(&log_queue, &sample)) {
+            int32_t j = sample.jitter_us < 0 ? -sample.jitter_us : sample.jitter_us;
+            if (j > max_jitter) max_jitter = j;
+            if (sample.exec_us > max_exec) max_exec = sample.exec_us;
+            if (sd_ok) logz_writer_add(&log_writer, &sample); // 블록이 찰 때만 압축 (1 KB당 상한 있음)
+            ++n;
+        }
+
+        if (now - last_print >= pdMS_TO_TICKS(params_get(PARAM_LOG_PERIOD_MS).u32)) {
+            last_print = now;
+            printf("LOG samples=%lu max_jitter_us=%ld max_exec_us=%lu dropped=%lu/%lu sd=%lu/%lu\n",
+                   (unsigned long)n, (long)max_jitter, (unsigned long)max_exec,
+                   (unsigned long)atomic_load(&telemetry_queue.dropped),
+                   (unsigned long)atomic_load(&log_queue.dropped),
+                   (unsigned long)log_writer.stats.bytes_out, (unsigned long)log_writer.stats.bytes_in);
+            n = 0;
+            max_jitter = 0;
+            max_exec = 0;
+        }
+        vTaskDelay(pdMS_TO_TICKS(APP_LOG_POLL_MS));
+    }
+}
+
+static void vibration_task(void *param) {
+    (void)param;
+
+    while (true) {
+        // 블록이 밀려 있으면 쉬지 않고 처리 (같은 우선순위의 유휴 태스크와 번갈아 실행)
+        if (!vibration_process(&vibration)) {
+            vTaskDelay(pdMS_TO_TICKS(APP_VIBRATION_IDLE_MS));
+        }
+    }
+}
+
+static void coro_task(void *param) {
+    (void)param;
+
+    while (true) {
+        uint64_t next_wake;
+        if (coro_executor_poll(&coro_exec, &next_wake)) {
+            continue; // 방금 실행한 코루틴이 다른 코루틴의 이벤트를 signal 했을 수 있음
+        }
+
+        // 인터럽트 알림 또는 다음 타이머 만료까지 블로킹. poll 이후에 온 알림은 카운트로 남아 바로 깨어남
+        TickType_t ticks = portMAX_DELAY;
+        if (next_wake != UINT64_MAX) {
+            uint64_t now = coro_now_us();
+            if (next_wake <= now) continue;
+            uint64_t wait_ms = (next_wake - now + 999u) / 1000u; // 일찍 깨지 않도록 올림
+            ticks = pdMS_TO_TICKS(wait_ms < CORO_MAX_BLOCK_MS ? (uint32_t)wait_ms : CORO_MAX_BLOCK_MS);
+        }
+        ulTaskNotifyTake(pdTRUE, ticks);
+    }
+}
+
+// coro_hw 인터럽트에서 호출 (이벤트를 signal 한 뒤)
+static void coro_notify_from_isr(void) {
+    if (!coro_handle) return;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(coro_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void app_log_close(void) {
+    atomic_store_explicit(&log_close_requested, true, memory_order_release);
+}
+
+coro_t *app_coro_spawn(coro_fn_t fn, void *ctx) {
+    return coro_spawn(&coro_exec, fn, ctx);
+}
+
+void app_vibration_feed(const int16_t *samples, uint32_t n) {
+    vibration_add_samples(&vibration, samples, n);
+}
+
+bool app_tasks_create(void) {
+    if (!params_init()) {
+        return false;
+    }
+
+    if (!spsc_queue_init(&telemetry_queue, telemetry_slots, sizeof(app_control_sample_t), APP_QUEUE_SLOTS) ||
+        !spsc_queue_init(&log_queue, log_slots, sizeof(app_control_sample_t), APP_QUEUE_SLOTS) ||
+        !vibration_init(&vibration, APP_VIBRATION_SAMPLE_RATE_HZ)) {
+        return false;
+    }
+    coro_executor_init(&coro_exec);
+
+    TaskHandle_t control = NULL, telemetry = NULL, log = NULL, vib = NULL;
+    if (xTaskCreate(control_task, "control", CONTROL_STACK_WORDS, NULL, APP_CONTROL_PRIORITY, &control) != pdPASS ||
+        xTaskCreate(telemetry_task, "telemetry", TELEMETRY_STACK_WORDS, NULL, APP_TELEMETRY_PRIORITY, &telemetry) != pdPASS ||
+        xTaskCreate(log_task, "log", LOG_STACK_WORDS, NULL, APP_LOG_PRIORITY, &log) != pdPASS ||
+        xTaskCreate(vibration_task, "vibration", VIBRATION_STACK_WORDS, NULL, APP_VIBRATION_PRIORITY, &vib) != pdPASS ||
+        xTaskCreate(coro_task, "coro", CORO_STACK_WORDS, NULL, APP_CORO_PRIORITY, &coro_handle) != pdPASS) {
+        return false;
+    }
+    coro_hw_set_notify(coro_notify_from_isr);
+
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+    // 제어 태스크는 core 1 전용, 출력/로깅/진동 분석/코루틴은 core 0 (UART 인터럽트와 같은 코어)
+    vTaskCoreAffinitySet(control, 1u << 1);
+    vTaskCoreAffinitySet(telemetry, 1u << 0);
+    vTaskCoreAffinitySet(log, 1u << 0);
+    vTaskCoreAffinitySet(vib, 1u << 0);
+    vTaskCoreAffinitySet(coro_handle, 1u << 0);
+#endif
+
+    return true;
+}
@@ -0,0 +1,183 @@
+#include "collog.h"
+#include <string.h> // memcpy, memmove, memset 사용
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_COLLOG
+
+#ifdef DEBUG_COLLOG
+#include <stdio.h>
+#endif
+
+#define ALIGN4(x) (((x) + 3u) & ~3u)
+
+_Static_assert(sizeof(collog_file_header_t) == 12, "file header layout");
+_Static_assert(sizeof(collog_channel_desc_t) == 16, "channel descriptor layout");
+_Static_assert(sizeof(collog_chunk_header_t) == 24, "chunk header layout");
+_Static_assert(sizeof(collog_index_entry_t) == 12, "index entry layout");
+_Static_assert(sizeof(collog_trailer_t) == 20, "trailer layout");
+
+// --- 내부 함수 ---
+
+static uint8_t *column(collog_writer_t *w, uint32_t c) {
+    return &w->chunk[w->column_offset[c]];
+}
+
+static void index_add(collog_writer_t *w, uint32_t offset, uint32_t t_epoch, uint32_t t_first_us) {
+    if (w->chunks % w->index_stride != 0) return;
+
+    if (w->index_count == COLLOG_INDEX_ENTRIES) {
+        // 가득 참: 짝수 번째만 남기고 간격을 두 배로 (메모리 고정)
+        for (uint32_t i = 0; i < COLLOG_INDEX_ENTRIES / 2; ++i) w->index[i] = w->index[2 * i];
+        w->index_count = COLLOG_INDEX_ENTRIES / 2;
+        w->index_stride *= 2;
+        if (w->chunks % w->index_stride != 0) return;
+    }
+    w->index[w->index_count].offset = offset;
+    w->index[w->index_count].t_epoch = t_epoch;
+    w->index[w->index_count].t_first_us = t_first_us;
+    w->index_count++;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+uint32_t collog_type_size(collog_type_t type) {
+    switch (type) {
+        case COLLOG_U8:
+        case COLLOG_I8:
+            return 1;
+        case COLLOG_U16:
+        case COLLOG_I16:
+            return 2;
+        case COLLOG_U32:
+        case COLLOG_I32:
+        case COLLOG_F32:
+            return 4;
+    }
+    return 0;
+}
+
+bool collog_writer_init(collog_writer_t *w, const collog_channel_t *channels, uint32_t channel_count,
+                        collog_sink_fn sink) {
+    memset(w, 0, sizeof(*w));
+    if (!sink || channel_count == 0 || channel_count > COLLOG_MAX_CHANNELS || channels[0].type != COLLOG_U32) {
+        return false;
+    }
+
+    uint32_t row_bytes = 0;
+    for (uint32_t c = 0; c < channel_count; ++c) {
+        w->size[c] = (uint8_t)collog_type_size(channels[c].type);
+        if (w->size[c] == 0) return false;
+        // 가득 찬 청크 기준 열 위치 (COLLOG_CHUNK_ROWS 행이면 모든 열이 4바이트 정렬)
+        w->column_offset[c] = (uint16_t)(sizeof(collog_chunk_header_t) + row_bytes * COLLOG_CHUNK_ROWS);
+        row_bytes += w->size[c];
+    }
+    if (row_bytes * COLLOG_CHUNK_ROWS > COLLOG_CHUNK_BYTES) {
+#ifdef DEBUG_COLLOG
+        printf("Error: collog row of %lu bytes does not fit in a chunk.\n", (unsigned long)row_bytes);
+#endif
+        return false;
+    }
+
+    w->channels = channels;
+    w->channel_count = channel_count;
+    w->sink = sink;
+    w->index_stride = 1;
+
+    // 파일 헤더 + 채널 목록 (청크 버퍼를 잠시 빌려 씀)
+    collog_file_header_t header = {
+        .magic = COLLOG_FILE_MAGIC,
+        .version = COLLOG_VERSION,
+        .channel_count = (uint16_t)channel_count,
+        .header_bytes = sizeof(collog_file_header_t) + channel_count * sizeof(collog_channel_desc_t),
+    };
+    memcpy(w->chunk, &header, sizeof(header));
+    for (uint32_t c = 0; c < channel_count; ++c) {
+        collog_channel_desc_t desc = { .type = (uint8_t)channels[c].type, .size = w->size[c] };
+        strncpy(desc.name, channels[c].name, COLLOG_NAME_LEN - 1);
+        memcpy(w->chunk + sizeof(header) + c * sizeof(desc), &desc, sizeof(desc));
+    }
+    if (!sink(w->chunk, header.header_bytes)) return false;
+
+    w->offset = header.header_bytes;
+    return true;
+}
+
+bool collog_writer_add(collog_writer_t *w, const void *record) {
+    const uint8_t *src = (const uint8_t *)record;
+    uint32_t row = w->rows;
+
+    for (uint32_t c = 0; c < w->channel_count; ++c) {
+        uint32_t n = w->size[c];
+        memcpy(column(w, c) + row * n, src + w->channels[c].offset, n);
+    }
+
+    uint32_t t;
+    memcpy(&t, src + w->channels[0].offset, sizeof(t));
+    // 반 바퀴 넘게 줄면 u32가 넘친 것으로 봄 (작은 역행은 그대로 둠)
+    if (t < w->t_last_us && w->t_last_us - t > 0x80000000u) w->t_epoch++;
+    if (row == 0) {
+        w->t_first_us = t;
+        w->t_first_epoch = w->t_epoch;
+    }
+    w->t_last_us = t;
+
+    if (++w->rows < COLLOG_CHUNK_ROWS) return true;
+    return collog_writer_flush(w);
+}
+
+bool collog_writer_flush(collog_writer_t *w) {
+    uint32_t rows = w->rows;
+    if (rows == 0) return true;
+    w->rows = 0;
+
+    // 덜 찬 청크는 열을 앞으로 당겨 빈 행을 없앰 (열 시작은 4바이트 정렬 유지)
+    uint32_t off = sizeof(collog_chunk_header_t);
+    for (uint32_t c = 0; c < w->channel_count; ++c) {
+        uint8_t *src = column(w, c);
+        if (src != &w->chunk[off]) memmove(&w->chunk[off], src, rows * w->size[c]);
+        off += ALIGN4(rows * w->size[c]);
+    }
+
+    collog_chunk_header_t header = {
+        .magic = COLLOG_CHUNK_MAGIC,
+        .rows = (uint16_t)rows,
+        .channel_count = (uint16_t)w->channel_count,
+        .chunk_bytes = off,
+        .t_first_us = w->t_first_us,
+        .t_last_us = w->t_last_us,
+        .t_epoch = w->t_first_epoch,
+    };
+    memcpy(w->chunk, &header, sizeof(header));
+
+    if (!w->sink(w->chunk, off)) {
+        w->chunks_dropped++;
+        return false;
+    }
+    index_add(w, w->offset, header.t_epoch, header.t_first_us);
+    w->offset += off;
+    w->chunks++;
+    return true;
+}
+
+bool collog_writer_close(collog_writer_t *w) {
+    bool ok = collog_writer_flush(w);
+
+    collog_trailer_t trailer = {
+        .magic = COLLOG_TRAILER_MAGIC,
+        .entries = w->index_count,
+        .stride = w->index_stride,
+        .chunks = w->chunks,
+        .index_offset = w->offset,
+    };
+    uint32_t index_bytes = w->index_count * sizeof(collog_index_entry_t);
+
+    // 색인과 트레일러를 한 번에 (싱크가 일부만 받는 일이 없도록)
+    if (index_bytes + sizeof(trailer) <= sizeof(w->chunk)) {
+        memcpy(w->chunk, w->index, index_bytes);
+        memcpy(w->chunk + index_bytes, &trailer, sizeof(trailer));
+        ok = w->sink(w->chunk, index_bytes + sizeof(trailer)) && ok;
+    } else {
+        ok = w->sink(w->index, index_bytes) && w->sink(&trailer, sizeof(trailer)) && ok;
+    }
+    return ok;
+}
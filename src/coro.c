@@ -0,0 +1,112 @@
+#include "coro.h"
+#include "pico/stdlib.h"
+#include <string.h> // memset 사용
+
+#ifndef CANSAT_HOST
+#include "hardware/sync.h"
+#endif
+
+// --- 내부 함수 ---
+
+// 대기 조건이 충족되었는지 확인. 현재 시각은 타이머 대기 코루틴이 있을 때만 읽음
+static bool is_runnable(coro_t *co, uint64_t *now_us, uint64_t *next_wake_us) {
+    switch (co->state) {
+    case CORO_READY:
+        return true;
+    case CORO_WAIT_EVENT:
+        return coro_event_try_consume(co->event);
+    case CORO_WAIT_TIMER:
+        if (*now_us == 0) *now_us = coro_now_us();
+        if (*now_us >= co->wake_us) return true;
+        if (co->wake_us < *next_wake_us) *next_wake_us = co->wake_us;
+        return false;
+    default:
+        return false;
+    }
+}
+
+// --- 라이브러리 함수 구현 ---
+
+uint64_t coro_now_us(void) {
+    return time_us_64();
+}
+
+void coro_executor_init(coro_executor_t *exec) {
+    memset(exec, 0, sizeof(*exec)); // 모든 슬롯 CORO_FREE
+}
+
+coro_t *coro_spawn(coro_executor_t *exec, coro_fn_t fn, void *ctx) {
+    if (!fn) return NULL;
+    for (int i = 0; i < CORO_MAX_TASKS; ++i) {
+        coro_t *co = &exec->tasks[i];
+        if (co->state == CORO_FREE) {
+            co->fn = fn;
+            co->ctx = ctx;
+            co->resume_point = 0;
+            co->event = NULL;
+            co->wake_us = 0;
+            co->state = CORO_READY;
+            return co;
+        }
+    }
+    return NULL; // 풀 부족 (CORO_MAX_TASKS 초과)
+}
+
+uint32_t coro_executor_poll(coro_executor_t *exec, uint64_t *next_wake_us) {
+    uint64_t next = UINT64_MAX;
+    uint64_t now = 0; // 필요할 때 읽음
+    uint32_t resumed = 0;
+
+    for (int i = 0; i < CORO_MAX_TASKS; ++i) {
+        coro_t *co = &exec->tasks[i];
+        if (!is_runnable(co, &now, &next)) continue;
+
+        co->state = CORO_READY;
+        co->fn(co); // 다음 await 또는 CORO_END 까지 실행
+        ++resumed;
+
+        if (co->state == CORO_DONE) {
+            co->state = CORO_FREE; // 슬롯 반환
+        } else if (co->state == CORO_READY) {
+            next = 0; // yield 한 코루틴은 바로 다시 실행 가능
+        } else if (co->state == CORO_WAIT_TIMER && co->wake_us < next) {
+            next = co->wake_us;
+        }
+    }
+
+    exec->switches += resumed;
+    if (next_wake_us) *next_wake_us = next;
+    return resumed;
+}
+
+void coro_executor_run(coro_executor_t *exec) {
+    while (true) {
+        uint64_t next_wake;
+        uint32_t resumed = coro_executor_poll(exec, &next_wake);
+
+        bool alive = false;
+        for (int i = 0; i < CORO_MAX_TASKS; ++i) {
+            if (exec->tasks[i].state != CORO_FREE) {
+                alive = true;
+                break;
+            }
+        }
+        if (!alive) return;
+        if (resumed) continue; // 방금 실행한 코루틴이 이벤트를 signal 했을 수 있음
+
+        uint64_t now = coro_now_us();
+        if (next_wake <= now) continue;
+
+#ifdef CANSAT_HOST
+        // 호스트: ISR 대신 다른 스레드가 signal 하므로 짧게 나눠 잠듦
+        uint64_t wait = next_wake - now;
+        sleep_us(wait > 100 ? 100 : wait);
+#else
+        if (next_wake == UINT64_MAX) {
+            __wfe(); // 인터럽트(이벤트 signal)까지 대기
+        } else {
+            best_effort_wfe_or_timeout(from_us_since_boot(next_wake));
+        }
+#endif
+    }
+}
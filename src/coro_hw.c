@@ -0,0 +1,92 @@
+#include "coro_hw.h"
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+// --- 연결 테이블 ---
+static coro_event_t *dma_events[CORO_HW_NUM_DMA_CHANNELS];
+static coro_event_t *gpio_events[CORO_HW_NUM_GPIOS];
+static uint32_t gpio_edge_masks[CORO_HW_NUM_GPIOS];
+static bool dma_handler_installed = false;
+static bool gpio_handler_installed = false;
+static coro_hw_notify_fn_t notify_fn = NULL;
+
+// --- 인터럽트 핸들러 ---
+
+static void __not_in_flash_func(coro_dma_isr)(void) {
+    uint32_t ints = dma_hw->ints0;
+    bool signaled = false;
+    for (uint32_t ch = 0; ch < CORO_HW_NUM_DMA_CHANNELS; ++ch) {
+        if ((ints & (1u << ch)) && dma_events[ch]) {
+            dma_hw->ints0 = 1u << ch; // 우리가 연결한 채널만 acknowledge
+            coro_event_signal(dma_events[ch]);
+            signaled = true;
+        }
+    }
+    if (signaled && notify_fn) notify_fn();
+}
+
+static void __not_in_flash_func(coro_gpio_isr)(void) {
+    bool signaled = false;
+    for (uint32_t gpio = 0; gpio < CORO_HW_NUM_GPIOS; ++gpio) {
+        if (!gpio_events[gpio]) continue;
+        uint32_t events = gpio_get_irq_event_mask(gpio) & gpio_edge_masks[gpio];
+        if (events) {
+            gpio_acknowledge_irq(gpio, events);
+            coro_event_signal(gpio_events[gpio]);
+            signaled = true;
+        }
+    }
+    if (signaled && notify_fn) notify_fn();
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool coro_hw_bind_dma(uint32_t channel, coro_event_t *ev) {
+    if (channel >= CORO_HW_NUM_DMA_CHANNELS || !ev || dma_events[channel]) return false;
+
+    if (!dma_handler_installed) {
+        // 다른 드라이버도 DMA_IRQ_0을 쓸 수 있으므로 공유 핸들러로 등록
+        irq_add_shared_handler(DMA_IRQ_0, coro_dma_isr, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        dma_handler_installed = true;
+    }
+
+    dma_events[channel] = ev;
+    dma_channel_set_irq0_enabled(channel, true);
+    return true;
+}
+
+bool coro_hw_bind_gpio(uint32_t gpio, uint32_t edge_mask, coro_event_t *ev) {
+    if (gpio >= CORO_HW_NUM_GPIOS || !ev || edge_mask == 0 || gpio_events[gpio]) return false;
+
+    if (!gpio_handler_installed) {
+        // 핸들러 하나가 연결 테이블 전체를 검사하므로 한 번만 등록
+        gpio_add_raw_irq_handler_masked((1u << CORO_HW_NUM_GPIOS) - 1u, coro_gpio_isr);
+        gpio_handler_installed = true;
+    }
+
+    gpio_events[gpio] = ev;
+    gpio_edge_masks[gpio] = edge_mask;
+    gpio_set_irq_enabled(gpio, edge_mask, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+    return true;
+}
+
+void coro_hw_unbind_dma(uint32_t channel) {
+    if (channel >= CORO_HW_NUM_DMA_CHANNELS || !dma_events[channel]) return;
+    dma_channel_set_irq0_enabled(channel, false);
+    dma_events[channel] = NULL;
+}
+
+void coro_hw_unbind_gpio(uint32_t gpio) {
+    if (gpio >= CORO_HW_NUM_GPIOS || !gpio_events[gpio]) return;
+    gpio_set_irq_enabled(gpio, gpio_edge_masks[gpio], false);
+    gpio_events[gpio] = NULL;
+    gpio_edge_masks[gpio] = 0;
+}
+
+void coro_hw_set_notify(coro_hw_notify_fn_t fn) {
+    notify_fn = fn;
+}
@@ -0,0 +1,165 @@
+#include "dl_sched.h"
+#include "link_frame.h"
+#include <string.h>
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_DL_SCHED
+
+#ifdef DEBUG_DL_SCHED
+#include <stdio.h>
+#endif
+
+#define HEADER_BYTES 4                        // [u16 id][u16 seq]
+#define LINK_OVERHEAD (LINK_FRAME_MAX_BYTES - LINK_FRAME_MAX_PAYLOAD)
+
+// --- 내부 함수 ---
+
+static uint8_t *slot(const dl_class_t *c, uint8_t i) {
+    return (uint8_t *)c->config.storage + (uint32_t)i * (c->config.frame_bytes + 2u);
+}
+
+static uint16_t slot_len(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static void slot_put(uint8_t *p, const uint8_t *frame, uint32_t len) {
+    p[0] = (uint8_t)len;
+    p[1] = (uint8_t)(len >> 8);
+    memcpy(p + 2, frame, len);
+}
+
+static uint8_t wrap(const dl_class_t *c, uint32_t i) {
+    return (uint8_t)(i >= c->config.slots ? i - c->config.slots : i);
+}
+
+// 같은 메시지 ID(헤더 첫 2바이트)를 가진 대기 프레임, 없으면 -1
+static int find_id(const dl_class_t *c, const uint8_t *frame) {
+    for (uint8_t k = 0; k < c->count; ++k) {
+        uint8_t i = wrap(c, (uint32_t)c->head + k);
+        const uint8_t *p = slot(c, i) + 2;
+        if (p[0] == frame[0] && p[1] == frame[1]) return i;
+    }
+    return -1;
+}
+
+// 맨 앞 프레임에 seq를 매겨 링크 프레임으로 만들고 큐에서 뺌
+static uint32_t pop(dl_sched_t *s, uint8_t cls, uint8_t *out, uint32_t cap, uint16_t *seq_out) {
+    dl_class_t *c = &s->cls[cls];
+    uint8_t *p = slot(c, c->head);
+    uint16_t len = slot_len(p);
+    uint16_t seq = s->tx_seq++;
+    p[2 + 2] = (uint8_t)seq;
+    p[2 + 3] = (uint8_t)(seq >> 8);
+    uint32_t n = link_frame_encode(p + 2, len, out, cap);
+
+    c->head = wrap(c, (uint32_t)c->head + 1u);
+    --c->count;
+    ++c->stats.sent;
+    c->stats.sent_bytes += n;
+    if (seq_out) *seq_out = seq;
+    return n;
+}
+
+// DRR에서 현재 클래스를 넘김 (비었으면 남은 몫도 버림: 쉬던 클래스가 몫을 모아 몰아 보내지 않도록)
+static void rr_advance(dl_sched_t *s) {
+    dl_class_t *c = &s->cls[s->rr];
+    if (c->count == 0) c->deficit = 0;
+    s->rr = (uint8_t)(s->rr + 1u >= s->count ? 0 : s->rr + 1u);
+    s->rr_credited = false;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool dl_sched_init(dl_sched_t *s, const dl_class_config_t *classes, uint8_t count) {
+    if (count == 0 || count > DL_SCHED_MAX_CLASSES) return false;
+    memset(s, 0, sizeof(*s));
+    for (uint8_t i = 0; i < count; ++i) {
+        const dl_class_config_t *c = &classes[i];
+        if (c->storage == NULL || c->slots == 0 || c->frame_bytes < HEADER_BYTES ||
+            c->frame_bytes > LINK_FRAME_MAX_PAYLOAD || (!c->strict && c->weight == 0)) {
+            return false;
+        }
+        s->cls[i].config = *c;
+    }
+    s->count = count;
+    return true;
+}
+
+bool dl_sched_enqueue(dl_sched_t *s, uint8_t cls, const uint8_t *frame, uint32_t len) {
+    if (cls >= s->count) return false;
+    dl_class_t *c = &s->cls[cls];
+    if (len < HEADER_BYTES || len > c->config.frame_bytes) return false;
+    ++c->stats.enqueued;
+
+    if (c->config.policy == DL_DROP_REPLACE) {
+        int i = find_id(c, frame);
+        if (i >= 0) {
+            slot_put(slot(c, (uint8_t)i), frame, len);
+            ++c->stats.replaced;
+            return true;
+        }
+    }
+
+    if (c->count == c->config.slots) {
+        ++c->stats.dropped;
+        if (c->config.policy == DL_DROP_NEWEST) {
+#ifdef DEBUG_DL_SCHED
+            printf("dl_sched: class %u full, dropped new frame\n", cls);
+#endif
+            return false;
+        }
+        c->head = wrap(c, (uint32_t)c->head + 1u);
+        --c->count;
+    }
+    slot_put(slot(c, wrap(c, (uint32_t)c->head + c->count)), frame, len);
+    ++c->count;
+    return true;
+}
+
+uint32_t dl_sched_dequeue(dl_sched_t *s, uint8_t *out, uint32_t cap, uint8_t *cls_out, uint16_t *seq_out) {
+    if (cap < LINK_FRAME_MAX_BYTES) return 0;
+
+    // 1) strict 클래스: 설정 순서대로
+    bool weighted = false;
+    for (uint8_t i = 0; i < s->count; ++i) {
+        dl_class_t *c = &s->cls[i];
+        if (c->count == 0) continue;
+        if (!c->config.strict) {
+            weighted = true;
+            continue;
+        }
+        if (cls_out) *cls_out = i;
+        return pop(s, i, out, cap, seq_out);
+    }
+    if (!weighted) return 0;
+
+    // 2) DRR: 비어 있지 않은 클래스가 있으므로 몫이 쌓여 LINK_FRAME_MAX_BYTES / quantum 바퀴 안에 반드시 끝남
+    for (;;) {
+        dl_class_t *c = &s->cls[s->rr];
+        if (c->config.strict || c->count == 0) {
+            rr_advance(s);
+            continue;
+        }
+        if (!s->rr_credited) {
+            c->deficit += (int32_t)c->config.weight * DL_SCHED_QUANTUM_BYTES;
+            s->rr_credited = true;
+        }
+        int32_t cost = (int32_t)slot_len(slot(c, c->head)) + LINK_OVERHEAD;
+        if (cost > c->deficit) {
+            rr_advance(s);
+            continue;
+        }
+        c->deficit -= cost;
+        uint8_t i = s->rr;
+        uint32_t n = pop(s, i, out, cap, seq_out);
+        if (c->count == 0) rr_advance(s);
+        if (cls_out) *cls_out = i;
+        return n;
+    }
+}
+
+uint32_t dl_sched_pending(const dl_sched_t *s) {
+    uint32_t n = 0;
+    for (uint8_t i = 0; i < s->count; ++i) n += s->cls[i].count;
+    return n;
+}
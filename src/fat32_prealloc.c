@@ -0,0 +1,326 @@
+#include "fat32_prealloc.h"
+#include "sd_block.h"
+#include <string.h> // memcpy, memcmp, memset 사용
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_FAT32
+
+#ifdef DEBUG_FAT32
+#include <stdio.h>
+#endif
+
+#define FAT_ENTRY_MASK 0x0FFFFFFFu
+#define FAT_EOC 0x0FFFFFFFu
+#define FAT_ENTRIES_PER_SECTOR (SD_BLOCK_SIZE / 4)
+#define DIR_ENTRY_SIZE 32
+#define DIR_ATTR_ARCHIVE 0x20
+#define DIR_ATTR_LFN 0x0F
+
+// --- 볼륨 정보 ---
+typedef struct {
+    uint32_t volume_lba;      // BPB 섹터
+    uint32_t fat_lba;         // 첫 번째 FAT
+    uint32_t fat_sectors;     // FAT 하나의 섹터 수
+    uint8_t num_fats;
+    uint8_t sectors_per_cluster;
+    uint32_t data_lba;        // 클러스터 2의 섹터
+    uint32_t cluster_count;   // 데이터 클러스터 수
+    uint32_t root_cluster;
+    uint16_t fsinfo_sector;   // 볼륨 기준
+} fat32_volume_t;
+
+static uint8_t sector[SD_BLOCK_SIZE];
+
+// --- 내부 함수 ---
+
+static uint16_t rd16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t rd32(const uint8_t *p) {
+    return rd16(p) | ((uint32_t)rd16(p + 2) << 16);
+}
+
+static void wr16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void wr32(uint8_t *p, uint32_t v) {
+    wr16(p, (uint16_t)v);
+    wr16(p + 2, (uint16_t)(v >> 16));
+}
+
+static bool is_fat32_bpb(const uint8_t *s) {
+    return (s[0] == 0xEB || s[0] == 0xE9) && rd16(s + 0x0B) == SD_BLOCK_SIZE && s[0x0D] != 0 &&
+           rd16(s + 0x11) == 0 && rd32(s + 0x24) != 0 && rd16(s + 0x1FE) == 0xAA55;
+}
+
+static bool mount(fat32_volume_t *vol) {
+    if (!sd_block_read(0, sector, 1) || rd16(sector + 0x1FE) != 0xAA55) return false;
+
+    uint32_t volume_lba = 0;
+    if (!is_fat32_bpb(sector)) {
+        // MBR: 첫 번째 FAT32 파티션 (0x0B: CHS, 0x0C: LBA)
+        for (int i = 0; i < 4; ++i) {
+            const uint8_t *entry = sector + 0x1BE + i * 16;
+            if (entry[4] == 0x0B || entry[4] == 0x0C) {
+                volume_lba = rd32(entry + 8);
+                break;
+            }
+        }
+        if (volume_lba == 0 || !sd_block_read(volume_lba, sector, 1) || !is_fat32_bpb(sector)) {
+            return false;
+        }
+    }
+
+    uint16_t reserved = rd16(sector + 0x0E);
+    uint32_t total = rd16(sector + 0x13) ? rd16(sector + 0x13) : rd32(sector + 0x20);
+
+    vol->volume_lba = volume_lba;
+    vol->sectors_per_cluster = sector[0x0D];
+    vol->num_fats = sector[0x10];
+    vol->fat_sectors = rd32(sector + 0x24);
+    vol->fat_lba = volume_lba + reserved;
+    vol->data_lba = vol->fat_lba + vol->num_fats * vol->fat_sectors;
+    vol->cluster_count = (total - reserved - vol->num_fats * vol->fat_sectors) / vol->sectors_per_cluster;
+    vol->root_cluster = rd32(sector + 0x2C);
+    vol->fsinfo_sector = rd16(sector + 0x30);
+
+    // FAT 크기가 클러스터 수를 다 담지 못하는 볼륨은 거부
+    if (vol->cluster_count + 2 > vol->fat_sectors * FAT_ENTRIES_PER_SECTOR) return false;
+    return true;
+}
+
+static uint32_t cluster_lba(const fat32_volume_t *vol, uint32_t cluster) {
+    return vol->data_lba + (cluster - 2) * vol->sectors_per_cluster;
+}
+
+// FAT 항목 읽기 (sector 버퍼 사용)
+static bool fat_get(const fat32_volume_t *vol, uint32_t cluster, uint32_t *value) {
+    if (!sd_block_read(vol->fat_lba + cluster / FAT_ENTRIES_PER_SECTOR, sector, 1)) return false;
+    *value = rd32(sector + (cluster % FAT_ENTRIES_PER_SECTOR) * 4) & FAT_ENTRY_MASK;
+    return true;
+}
+
+// first..first+count-1 클러스터의 FAT 항목을 모든 FAT 사본에 기록.
+// chain=true 면 연속 체인(마지막은 EOC), false 면 해제(0)
+static bool fat_set_run(const fat32_volume_t *vol, uint32_t first, uint32_t count, bool chain) {
+    uint32_t last = first + count - 1;
+    uint32_t fat_sec = first / FAT_ENTRIES_PER_SECTOR;
+
+    while (fat_sec <= last / FAT_ENTRIES_PER_SECTOR) {
+        if (!sd_block_read(vol->fat_lba + fat_sec, sector, 1)) return false;
+
+        for (uint32_t i = 0; i < FAT_ENTRIES_PER_SECTOR; ++i) {
+            uint32_t c = fat_sec * FAT_ENTRIES_PER_SECTOR + i;
+            if (c < first || c > last) continue;
+            uint32_t v = !chain ? 0 : (c == last ? FAT_EOC : c + 1);
+            uint8_t *p = sector + i * 4;
+            wr32(p, (rd32(p) & ~FAT_ENTRY_MASK) | v); // 상위 4비트는 보존
+        }
+
+        for (uint8_t f = 0; f < vol->num_fats; ++f) {
+            if (!sd_block_write(vol->fat_lba + f * vol->fat_sectors + fat_sec, sector, 1)) return false;
+        }
+        ++fat_sec;
+    }
+    return true;
+}
+
+// 체인이 first부터 끊김 없이 연속이면 길이를, 아니면 0을 반환. 체인을 해제해야 하면 free_chain 사용
+static uint32_t contiguous_length(const fat32_volume_t *vol, uint32_t first) {
+    uint32_t c = first, length = 0, next;
+    while (c >= 2 && c < vol->cluster_count + 2) {
+        if (!fat_get(vol, c, &next)) return 0;
+        ++length;
+        if (next >= 0x0FFFFFF8u) return length;
+        if (next != c + 1) return 0;
+        c = next;
+    }
+    return 0;
+}
+
+static bool free_chain(const fat32_volume_t *vol, uint32_t first) {
+    uint32_t c = first, next;
+    while (c >= 2 && c < vol->cluster_count + 2) {
+        if (!fat_get(vol, c, &next)) return false;
+        if (!fat_set_run(vol, c, 1, false)) return false;
+        if (next >= 0x0FFFFFF8u || next < 2) break;
+        c = next;
+    }
+    return true;
+}
+
+// 연속된 빈 클러스터 count개 찾기 (FAT 섹터 순차 스캔)
+static uint32_t find_free_run(const fat32_volume_t *vol, uint32_t count) {
+    uint32_t run_start = 0, run_len = 0;
+    uint32_t end = vol->cluster_count + 2;
+
+    for (uint32_t fat_sec = 0; fat_sec * FAT_ENTRIES_PER_SECTOR < end; ++fat_sec) {
+        if (!sd_block_read(vol->fat_lba + fat_sec, sector, 1)) return 0;
+        for (uint32_t i = 0; i < FAT_ENTRIES_PER_SECTOR; ++i) {
+            uint32_t c = fat_sec * FAT_ENTRIES_PER_SECTOR + i;
+            if (c < 2) continue;
+            if (c >= end) return 0;
+            if ((rd32(sector + i * 4) & FAT_ENTRY_MASK) == 0) {
+                if (run_len++ == 0) run_start = c;
+                if (run_len == count) return run_start;
+            } else {
+                run_len = 0;
+            }
+        }
+    }
+    return 0;
+}
+
+// 루트 디렉터리에서 이름이 같은 항목(또는 빈 항목) 위치 찾기
+static bool find_dir_entry(const fat32_volume_t *vol, const char name83[11],
+                           uint32_t *entry_lba, uint16_t *entry_off, bool *exists) {
+    bool have_free = false;
+    uint32_t free_lba = 0;
+    uint16_t free_off = 0;
+    uint32_t c = vol->root_cluster;
+
+    while (c >= 2 && c < vol->cluster_count + 2) {
+        for (uint8_t s = 0; s < vol->sectors_per_cluster; ++s) {
+            uint32_t lba = cluster_lba(vol, c) + s;
+            if (!sd_block_read(lba, sector, 1)) return false;
+
+            for (uint16_t off = 0; off < SD_BLOCK_SIZE; off += DIR_ENTRY_SIZE) {
+                const uint8_t *e = sector + off;
+                bool end_marker = e[0] == 0x00;
+                if ((end_marker || e[0] == 0xE5) && !have_free) {
+                    have_free = true;
+                    free_lba = lba;
+                    free_off = off;
+                }
+                if (end_marker) goto not_found; // 이후 항목은 모두 비어 있음
+                if (e[0x0B] != DIR_ATTR_LFN && memcmp(e, name83, 11) == 0) {
+                    *entry_lba = lba;
+                    *entry_off = off;
+                    *exists = true;
+                    return true;
+                }
+            }
+        }
+        uint32_t next;
+        if (!fat_get(vol, c, &next)) return false;
+        if (next >= 0x0FFFFFF8u) break;
+        c = next;
+    }
+
+not_found:
+    if (!have_free) return false; // 루트 디렉터리 확장은 지원하지 않음
+    *entry_lba = free_lba;
+    *entry_off = free_off;
+    *exists = false;
+    return true;
+}
+
+// FSInfo의 빈 클러스터 수/다음 빈 클러스터 힌트를 "알 수 없음"으로 무효화
+static bool invalidate_fsinfo(const fat32_volume_t *vol) {
+    if (vol->fsinfo_sector == 0 || vol->fsinfo_sector == 0xFFFF) return true;
+    uint32_t lba = vol->volume_lba + vol->fsinfo_sector;
+    if (!sd_block_read(lba, sector, 1)) return false;
+    if (rd32(sector) != 0x41615252u || rd32(sector + 484) != 0x61417272u) return true;
+    wr32(sector + 488, 0xFFFFFFFFu);
+    wr32(sector + 492, 0xFFFFFFFFu);
+    return sd_block_write(lba, sector, 1);
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool fat32_prealloc_contiguous(const char name83[11], uint32_t bytes, fat32_extent_t *extent) {
+    fat32_volume_t vol;
+    if (bytes == 0 || !mount(&vol)) {
+#ifdef DEBUG_FAT32
+        printf("Error: no FAT32 volume found.\n");
+#endif
+        return false;
+    }
+
+    uint32_t cluster_bytes = (uint32_t)vol.sectors_per_cluster * SD_BLOCK_SIZE;
+    uint32_t clusters = (uint32_t)(((uint64_t)bytes + cluster_bytes - 1) / cluster_bytes);
+    // 디렉터리 항목의 파일 크기는 32비트: 클러스터 단위로 올린 크기가 넘치면 체인과 크기가 어긋나므로 거부
+    uint64_t size = (uint64_t)clusters * cluster_bytes;
+    if (size > 0xFFFFFFFFu) {
+#ifdef DEBUG_FAT32
+        printf("Error: %lu clusters exceed the FAT32 file size limit.\n", (unsigned long)clusters);
+#endif
+        return false;
+    }
+
+    uint32_t entry_lba;
+    uint16_t entry_off;
+    bool exists;
+    if (!find_dir_entry(&vol, name83, &entry_lba, &entry_off, &exists)) return false;
+
+    uint32_t first = 0;
+    if (exists) {
+        // find_dir_entry 직후라 sector 버퍼에 디렉터리 섹터가 들어 있음
+        const uint8_t *e = sector + entry_off;
+        uint32_t old_first = ((uint32_t)rd16(e + 0x14) << 16) | rd16(e + 0x1A);
+        uint32_t old_length = old_first >= 2 ? contiguous_length(&vol, old_first) : 0;
+        if (old_length >= clusters) {
+            first = old_first; // 그대로 재사용
+            // 더 길면 남는 꼬리를 해제하고 clusters번째에서 체인을 끝냄 (크기와 체인 길이 일치)
+            if (old_length > clusters &&
+                (!fat_set_run(&vol, first + clusters - 1, 1, true) ||
+                 !fat_set_run(&vol, first + clusters, old_length - clusters, false) || !invalidate_fsinfo(&vol))) {
+                return false;
+            }
+        } else if (old_first >= 2 && !free_chain(&vol, old_first)) {
+            return false;
+        }
+    }
+
+    if (first == 0) {
+        first = find_free_run(&vol, clusters);
+        if (first == 0) {
+#ifdef DEBUG_FAT32
+            printf("Error: no contiguous run of %lu free clusters.\n", (unsigned long)clusters);
+#endif
+            return false;
+        }
+        if (!fat_set_run(&vol, first, clusters, true) || !invalidate_fsinfo(&vol)) return false;
+    }
+
+    // 디렉터리 항목 기록 (파일 크기 = 할당 전체)
+    if (!sd_block_read(entry_lba, sector, 1)) return false;
+    uint8_t *e = sector + entry_off;
+    if (!exists) {
+        memset(e, 0, DIR_ENTRY_SIZE);
+        memcpy(e, name83, 11);
+        e[0x0B] = DIR_ATTR_ARCHIVE;
+    }
+    wr16(e + 0x14, (uint16_t)(first >> 16));
+    wr16(e + 0x1A, (uint16_t)first);
+    wr32(e + 0x1C, (uint32_t)size);
+    if (!sd_block_write(entry_lba, sector, 1)) return false;
+
+    extent->first_cluster = first;
+    extent->first_lba = cluster_lba(&vol, first);
+    extent->block_count = clusters * vol.sectors_per_cluster;
+    return true;
+}
+
+bool fat32_find_contiguous(const char name83[11], fat32_extent_t *extent) {
+    fat32_volume_t vol;
+    if (!mount(&vol)) return false;
+
+    uint32_t entry_lba;
+    uint16_t entry_off;
+    bool exists;
+    if (!find_dir_entry(&vol, name83, &entry_lba, &entry_off, &exists) || !exists) return false;
+
+    const uint8_t *e = sector + entry_off;
+    uint32_t first = ((uint32_t)rd16(e + 0x14) << 16) | rd16(e + 0x1A);
+    uint32_t clusters = first >= 2 ? contiguous_length(&vol, first) : 0;
+    if (clusters == 0) return false;
+
+    extent->first_cluster = first;
+    extent->first_lba = cluster_lba(&vol, first);
+    extent->block_count = clusters * vol.sectors_per_cluster;
+    return true;
+}
@@ -0,0 +1,197 @@
+#include "flight_ctrl.h"
+#include "servo.h"
+#include "units.h"
+#include "fxmath.h"
+#include <math.h>
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_FLIGHT_CTRL
+
+#ifdef DEBUG_FLIGHT_CTRL
+#include <stdio.h>
+#endif
+
+// 상보 필터 대역 (rad/s) / 감쇠비: 기압 잡음은 거르고 가속도 적분 표류는 잡음
+#define ALT_FILTER_OMEGA 2.0f
+#define ALT_FILTER_ZETA 0.7f
+#define PAD_P0_ALPHA 0.02f
+
+// --- 내부 함수 ---
+
+static float clampf(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+static float wrap180(float deg) {
+    while (deg > 180.0f) deg -= 360.0f;
+    while (deg < -180.0f) deg += 360.0f;
+    return deg;
+}
+
+static void set_phase(flight_ctrl_t *c, flight_phase_t phase, uint32_t now_us) {
+#ifdef DEBUG_FLIGHT_CTRL
+    printf("Flight phase %d -> %d at %lu us, alt %.1f m\n", c->phase, phase, (unsigned long)now_us, c->alt_m);
+#endif
+    c->phase = phase;
+    c->phase_us = now_us;
+    c->count = 0;
+}
+
+static void set_steer(flight_ctrl_t *c, float steer) {
+    c->steer = steer;
+    float d = steer * FLIGHT_CTRL_STEER_RANGE_DEG;
+    servo_set(c->config.steer_left_gpio, (uint8_t)lroundf(FLIGHT_CTRL_STEER_NEUTRAL_DEG - d));
+    servo_set(c->config.steer_right_gpio, (uint8_t)lroundf(FLIGHT_CTRL_STEER_NEUTRAL_DEG + d));
+}
+
+// 기압 고도 + 수직 가속도 상보 필터 (기체 z축이 위를 향한다고 가정)
+static void update_altitude(flight_ctrl_t *c, const flight_record_t *s, float dt) {
+    float p = (float)s->pressure_pa;
+    float baro = UNITS_BARO_SCALE_M * (1.0f - powf(p / c->p0_pa, UNITS_BARO_EXPONENT));
+    float acc = (float)s->accel[2] * UNITS_ACCEL_MPS2_PER_LSB - UNITS_STANDARD_GRAVITY;
+
+    c->alt_m += c->vel_mps * dt + 0.5f * acc * dt * dt;
+    c->vel_mps += acc * dt;
+    float e = baro - c->alt_m;
+    c->alt_m += 2.0f * ALT_FILTER_ZETA * ALT_FILTER_OMEGA * dt * e;
+    c->vel_mps += ALT_FILTER_OMEGA * ALT_FILTER_OMEGA * dt * e;
+}
+
+// 조향 서보 부하 (Q15): 현재 PWM 레벨이 중립에서 벗어난 정도 (브레이크 라인 장력 -> 서보 전류)
+static void steer_loads(const flight_ctrl_t *c, int16_t load_q15[2]) {
+    const uint16_t gpios[2] = { c->config.steer_left_gpio, c->config.steer_right_gpio };
+    for (int i = 0; i < 2; ++i) {
+        uint16_t level;
+        load_q15[i] = 0;
+        if (!servo_get_level(gpios[i], &level) || c->steer_level_span[i] == 0) continue;
+        int32_t d = (int32_t)level - (int32_t)c->steer_level_neutral[i];
+        uint32_t load = (uint32_t)(d < 0 ? -d : d) * 32767u / c->steer_level_span[i];
+        load_q15[i] = (int16_t)(load > 32767u ? 32767u : load);
+    }
+}
+
+// 지자기 보정을 갱신/적용하고 방위 계산
+static void update_heading(flight_ctrl_t *c, const flight_record_t *s) {
+    int16_t loads[2], mag[3];
+    steer_loads(c, loads);
+    magcal_update(&c->magcal, s->mag, loads);
+    magcal_apply(&c->magcal, s->mag, loads, mag);
+    c->heading_deg = FX_ANGLE_TO_DEG(fx_atan2(mag[1], mag[0], NULL));
+}
+
+static uint16_t heading_angle(const flight_ctrl_t *c) {
+    return FX_ANGLE_FROM_DEG(c->heading_deg);
+}
+
+// 방위 유지: 방위 오차 -> 목표 선회율, 선회율 오차 -> 차동 (+ = 시계 방향)
+static float steer_law(flight_ctrl_t *c, const flight_record_t *s) {
+    float err = wrap180(c->config.target_heading_deg - c->heading_deg);
+    float rate_cmd = clampf(FLIGHT_CTRL_HEADING_GAIN * err, -FLIGHT_CTRL_MAX_TURN_DPS, FLIGHT_CTRL_MAX_TURN_DPS);
+    float rate = -(float)s->gyro[2] * UNITS_GYRO_DPS_PER_LSB; // 자이로 z는 반시계 +
+    return clampf(FLIGHT_CTRL_RATE_GAIN * (rate_cmd - rate), -1.0f, 1.0f);
+}
+
+// 목표점 유도: 브레이크 당김 차이 -> 차동. GPS 해가 없으면 방위 유지로 대신함
+static float guided_steer(flight_ctrl_t *c, const flight_record_t *s) {
+    float rate_dps = -(float)s->gyro[2] * UNITS_GYRO_DPS_PER_LSB;
+    guidance_output_t out;
+    if (!guidance_step(&c->guidance, heading_angle(c), (int32_t)lroundf(rate_dps * (65536.0f / 360.0f)), &out)) {
+        return steer_law(c, s);
+    }
+    return (float)(out.brake_right_q15 - out.brake_left_q15) * (1.0f / 32767.0f);
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool flight_ctrl_init(flight_ctrl_t *c, const flight_ctrl_config_t *config) {
+    fxmath_init(); // 방위각 atan2 (LUT)
+    c->config = *config;
+    c->phase = FLIGHT_PHASE_PAD;
+    c->last_us = 0;
+    c->phase_us = 0;
+    c->still_us = 0;
+    c->p0_pa = 0.0f;
+    c->alt_m = 0.0f;
+    c->vel_mps = 0.0f;
+    c->max_alt_m = 0.0f;
+    c->heading_deg = 0.0f;
+    c->steer = 0.0f;
+    c->count = 0;
+    guidance_init(&c->guidance, config->target_lat_e7, config->target_lon_e7);
+    magcal_init(&c->magcal, FLIGHT_CTRL_MAG_INPUT_SHIFT, 2);
+
+    if (!servo_init_default(config->steer_left_gpio) || !servo_init_default(config->steer_right_gpio) ||
+        !servo_init_default(config->deploy_gpio)) {
+        return false;
+    }
+    // 같은 슬라이스의 서보를 나중에 초기화하면 앞 서보의 레벨이 지워지므로 모두 초기화한 뒤 설정
+    servo_set(config->deploy_gpio, FLIGHT_CTRL_DEPLOY_CLOSED_DEG);
+    set_steer(c, 0.0f);
+
+    const uint16_t gpios[2] = { config->steer_left_gpio, config->steer_right_gpio };
+    for (int i = 0; i < 2; ++i) {
+        uint16_t full;
+        servo_angle_to_level(gpios[i], FLIGHT_CTRL_STEER_NEUTRAL_DEG, &c->steer_level_neutral[i]);
+        servo_angle_to_level(gpios[i], FLIGHT_CTRL_STEER_NEUTRAL_DEG + FLIGHT_CTRL_STEER_RANGE_DEG, &full);
+        c->steer_level_span[i] = (uint16_t)(full - c->steer_level_neutral[i]);
+    }
+    return true;
+}
+
+void flight_ctrl_step(flight_ctrl_t *c, const flight_record_t *s) {
+    uint32_t now = s->timestamp_us;
+    float dt = c->last_us ? (float)(uint32_t)(now - c->last_us) * 1e-6f : 0.0f;
+    c->last_us = now;
+
+    if (c->p0_pa == 0.0f) c->p0_pa = (float)s->pressure_pa;
+    update_heading(c, s);
+
+    switch (c->phase) {
+        case FLIGHT_PHASE_PAD:
+            c->p0_pa += PAD_P0_ALPHA * ((float)s->pressure_pa - c->p0_pa);
+            c->alt_m = 0.0f;
+            c->vel_mps = 0.0f;
+            c->count = s->accel[2] > (int16_t)(FLIGHT_CTRL_LAUNCH_G * UNITS_ACCEL_LSB_PER_G) ? c->count + 1 : 0;
+            if (c->count >= FLIGHT_CTRL_LAUNCH_SAMPLES) set_phase(c, FLIGHT_PHASE_ASCENT, now);
+            break;
+
+        case FLIGHT_PHASE_ASCENT: {
+            update_altitude(c, s, dt);
+            if (c->alt_m > c->max_alt_m) c->max_alt_m = c->alt_m;
+            uint32_t since = now - c->phase_us;
+            bool falling = c->alt_m < c->max_alt_m - FLIGHT_CTRL_APOGEE_DROP_M || c->vel_mps < 0.0f;
+            c->count = since >= FLIGHT_CTRL_DEPLOY_MIN_US && falling ? c->count + 1 : 0;
+            if (c->count >= FLIGHT_CTRL_APOGEE_SAMPLES || since >= FLIGHT_CTRL_DEPLOY_TIMEOUT_US) {
+                servo_set(c->config.deploy_gpio, FLIGHT_CTRL_DEPLOY_OPEN_DEG);
+                set_phase(c, FLIGHT_PHASE_DESCENT, now);
+            }
+            break;
+        }
+
+        case FLIGHT_PHASE_DESCENT:
+            update_altitude(c, s, dt);
+            set_steer(c, c->config.guided ? guided_steer(c, s) : steer_law(c, s));
+            c->still_us = fabsf(c->vel_mps) < FLIGHT_CTRL_LANDED_SPEED_MPS ? c->still_us + (uint32_t)(dt * 1e6f) : 0;
+            if (c->still_us >= FLIGHT_CTRL_LANDED_US) {
+                set_steer(c, 0.0f);
+                set_phase(c, FLIGHT_PHASE_LANDED, now);
+            }
+            break;
+
+        case FLIGHT_PHASE_LANDED:
+            break;
+    }
+}
+
+void flight_ctrl_gps(flight_ctrl_t *c, const guidance_fix_t *fix) {
+    if (!c->config.guided) return;
+    int32_t height_cm = (int32_t)lroundf(c->alt_m * 100.0f);
+    int32_t sink_cms = (int32_t)lroundf(-c->vel_mps * 100.0f);
+    guidance_fix(&c->guidance, fix, heading_angle(c), height_cm, sink_cms);
+}
+
+void flight_ctrl_deinit(flight_ctrl_t *c) {
+    servo_deinit(c->config.steer_left_gpio);
+    servo_deinit(c->config.steer_right_gpio);
+    servo_deinit(c->config.deploy_gpio);
+}
@@ -0,0 +1,23 @@
+#include "flight_record.h"
+#include <stddef.h>
+
+_Static_assert(sizeof(flight_record_t) == 32, "flight record must be 32 bytes");
+
+#define CHANNEL(name, type, field) { name, type, (uint16_t)offsetof(flight_record_t, field) }
+
+const collog_channel_t flight_record_channels[FLIGHT_RECORD_CHANNEL_COUNT] = {
+    CHANNEL("t_us", COLLOG_U32, timestamp_us),
+    CHANNEL("pressure", COLLOG_I32, pressure_pa),
+    CHANNEL("accel_x", COLLOG_I16, accel[0]),
+    CHANNEL("accel_y", COLLOG_I16, accel[1]),
+    CHANNEL("accel_z", COLLOG_I16, accel[2]),
+    CHANNEL("gyro_x", COLLOG_I16, gyro[0]),
+    CHANNEL("gyro_y", COLLOG_I16, gyro[1]),
+    CHANNEL("gyro_z", COLLOG_I16, gyro[2]),
+    CHANNEL("mag_x", COLLOG_I16, mag[0]),
+    CHANNEL("mag_y", COLLOG_I16, mag[1]),
+    CHANNEL("mag_z", COLLOG_I16, mag[2]),
+    CHANNEL("servo_0", COLLOG_U16, servo_level[0]),
+    CHANNEL("servo_1", COLLOG_U16, servo_level[1]),
+    CHANNEL("seq", COLLOG_U16, seq),
+};
@@ -0,0 +1,130 @@
+#include "fxfft.h"
+#include "fxmath.h"
+
+#define MIN_LOG2 4
+
+static int16_t cos_tab[FXFFT_MAX_SIZE];        // cos(2 pi i / FXFFT_MAX_SIZE), Q15
+static bool tab_ready;
+
+// --- 내부 함수 ---
+
+// |v|의 상한을 OR로 모음 (v ^ (v >> 31)은 음수에서 |v| - 1, 상한 판단에는 충분)
+#define ACC_BITS(bits, v) ((bits) |= (uint32_t)((v) ^ ((v) >> 31)))
+
+// 반올림 오른쪽 시프트 (s = 0이면 그대로)
+static inline int32_t rshift(int32_t v, uint8_t s) {
+    return s ? (v + (1 << (s - 1))) >> s : v;
+}
+
+// (re + j im) x e^(-j 2 pi t / MAX) = (re + j im)(c - j s), Q15 반올림
+static inline void twiddle(int32_t re, int32_t im, uint32_t t, int16_t *out_re, int16_t *out_im) {
+    int32_t c = cos_tab[t], s = cos_tab[(t - FXFFT_MAX_SIZE / 4) & (FXFFT_MAX_SIZE - 1)];
+    *out_re = (int16_t)((re * c + im * s + (1 << 14)) >> 15);
+    *out_im = (int16_t)((im * c - re * s + (1 << 14)) >> 15);
+}
+
+static uint32_t scan_bits(const fxfft_cpx_t *x, uint32_t n) {
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        int32_t re = x[i].re, im = x[i].im;
+        ACC_BITS(bits, re);
+        ACC_BITS(bits, im);
+    }
+    return bits;
+}
+
+// 기수 4 단 하나 (구간 길이 len). 한 단에서 성분이 최대 4 sqrt(2)배가 되므로 입력을 4096 미만으로 줄임
+static uint32_t radix4_stage(fxfft_cpx_t *x, uint32_t n, uint32_t len, uint32_t bits, uint8_t *exp) {
+    uint8_t s = bits < 4096u ? 0 : (bits < 8192u ? 1 : (bits < 16384u ? 2 : 3));
+    *exp += s;
+    const uint32_t q = len / 4, step = FXFFT_MAX_SIZE / len;
+    uint32_t out_bits = 0;
+    for (uint32_t g = 0; g < n; g += len) {
+        fxfft_cpx_t *p = &x[g];
+        for (uint32_t i = 0; i < q; ++i) {
+            int32_t ar = rshift(p[i].re, s), ai = rshift(p[i].im, s);
+            int32_t br = rshift(p[i + q].re, s), bi = rshift(p[i + q].im, s);
+            int32_t cr = rshift(p[i + 2 * q].re, s), ci = rshift(p[i + 2 * q].im, s);
+            int32_t dr = rshift(p[i + 3 * q].re, s), di = rshift(p[i + 3 * q].im, s);
+            int32_t t0r = ar + cr, t0i = ai + ci, t1r = ar - cr, t1i = ai - ci;
+            int32_t t2r = br + dr, t2i = bi + di, t3r = br - dr, t3i = bi - di;
+            // X0 = t0 + t2, X2 = t0 - t2, X1 = t1 - j t3, X3 = t1 + j t3. 출력은 (0, 2, 1, 3) 순서
+            int32_t x0r = t0r + t2r, x0i = t0i + t2i, x2r = t0r - t2r, x2i = t0i - t2i;
+            int32_t x1r = t1r + t3i, x1i = t1i - t3r, x3r = t1r - t3i, x3i = t1i + t3r;
+            p[i].re = (int16_t)x0r;
+            p[i].im = (int16_t)x0i;
+            if (i == 0) { // 회전 인자 1
+                p[q].re = (int16_t)x2r;
+                p[q].im = (int16_t)x2i;
+                p[2 * q].re = (int16_t)x1r;
+                p[2 * q].im = (int16_t)x1i;
+                p[3 * q].re = (int16_t)x3r;
+                p[3 * q].im = (int16_t)x3i;
+            } else {
+                uint32_t t = i * step;
+                twiddle(x2r, x2i, 2 * t, &p[i + q].re, &p[i + q].im);
+                twiddle(x1r, x1i, t, &p[i + 2 * q].re, &p[i + 2 * q].im);
+                twiddle(x3r, x3i, 3 * t, &p[i + 3 * q].re, &p[i + 3 * q].im);
+            }
+            for (uint32_t k = 0; k < 4; ++k) {
+                int32_t re = p[i + k * q].re, im = p[i + k * q].im;
+                ACC_BITS(out_bits, re);
+                ACC_BITS(out_bits, im);
+            }
+        }
+    }
+    return out_bits;
+}
+
+// 마지막 기수 2 단 (구간 길이 2, 회전 인자 1). 성분이 최대 2배
+static void radix2_stage(fxfft_cpx_t *x, uint32_t n, uint32_t bits, uint8_t *exp) {
+    uint8_t s = bits < 16384u ? 0 : 1;
+    *exp += s;
+    for (uint32_t i = 0; i < n; i += 2) {
+        int32_t ar = rshift(x[i].re, s), ai = rshift(x[i].im, s);
+        int32_t br = rshift(x[i + 1].re, s), bi = rshift(x[i + 1].im, s);
+        x[i].re = (int16_t)(ar + br);
+        x[i].im = (int16_t)(ai + bi);
+        x[i + 1].re = (int16_t)(ar - br);
+        x[i + 1].im = (int16_t)(ai - bi);
+    }
+}
+
+static void bit_reverse(fxfft_cpx_t *x, uint32_t n) {
+    for (uint32_t i = 0, j = 0; i < n; ++i) {
+        if (i < j) {
+            fxfft_cpx_t t = x[i];
+            x[i] = x[j];
+            x[j] = t;
+        }
+        uint32_t bit = n >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void fxfft_init(void) {
+    fxmath_init();
+    for (uint32_t i = 0; i < FXFFT_MAX_SIZE; ++i) {
+        cos_tab[i] = fx_cos((fx_angle_t)(i << (16 - FXFFT_MAX_LOG2)));
+    }
+    tab_ready = true;
+}
+
+int fxfft_forward(fxfft_cpx_t *x, uint8_t log2n) {
+    if (log2n < MIN_LOG2 || log2n > FXFFT_MAX_LOG2) return -1;
+    if (!tab_ready) fxfft_init();
+    const uint32_t n = 1u << log2n;
+    uint8_t exp = 0;
+    uint32_t bits = scan_bits(x, n);
+    uint32_t len = n;
+    for (; len >= 4; len >>= 2) bits = radix4_stage(x, n, len, bits, &exp);
+    if (len == 2) radix2_stage(x, n, bits, &exp);
+    bit_reverse(x, n);
+    return exp;
+}
@@ -0,0 +1,213 @@
+#include "fxfilter.h"
+#include <math.h>
+#include <string.h>
+
+#define COEF_ONE (1 << FXFILTER_COEF_SHIFT)
+#define COEF_FRAC_MASK (COEF_ONE - 1)
+
+// --- 내부 함수 ---
+
+static inline int16_t sat16(int32_t v) {
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+static int32_t to_q14(double v) {
+    return (int32_t)lround(v * COEF_ONE);
+}
+
+// a0로 정규화해 Q14로 바꾼 뒤 DC 이득이 정확히 1이 되도록 b1으로 반올림 오차를 흡수
+static void quantize_unity_dc(fxfilter_biquad_coef_t *c, double b0, double b2, double a0, double a1, double a2) {
+    c->a1 = to_q14(a1 / a0);
+    c->a2 = to_q14(a2 / a0);
+    c->b0 = to_q14(b0 / a0);
+    c->b2 = to_q14(b2 / a0);
+    c->b1 = COEF_ONE + c->a1 + c->a2 - c->b0 - c->b2;
+}
+
+// 바이쿼드 한 샘플. 곱은 16 x 17비트 -> 32비트 안, 합은 부호 없는 32비트 (중간 오버플로 상쇄)
+static inline int16_t biquad_step(const fxfilter_biquad_coef_t *c, int32_t *err, int32_t x0, int32_t x1, int32_t x2,
+                                  int32_t y1, int32_t y2) {
+    uint32_t acc = (uint32_t)*err + (uint32_t)(c->b0 * x0) + (uint32_t)(c->b1 * x1) + (uint32_t)(c->b2 * x2) -
+                   (uint32_t)(c->a1 * y1) - (uint32_t)(c->a2 * y2);
+    int32_t a = (int32_t)acc;
+    *err = a & COEF_FRAC_MASK; // 버린 하위 비트는 다음 샘플에 더함 (1차 잡음 정형)
+    return sat16(a >> FXFILTER_COEF_SHIFT);
+}
+
+// 창(오래된 것 -> 최근) x 역순 탭, 4개씩 펼침
+static inline int16_t fir_dot(const int16_t *w, const int16_t *h, uint16_t n) {
+    uint32_t acc = 1u << 14; // Q15 반올림
+    uint16_t k = 0;
+    for (; (uint16_t)(k + 4u) <= n; k += 4) {
+        acc += (uint32_t)(w[k] * h[k]) + (uint32_t)(w[k + 1] * h[k + 1]) + (uint32_t)(w[k + 2] * h[k + 2]) +
+               (uint32_t)(w[k + 3] * h[k + 3]);
+    }
+    for (; k < n; ++k) acc += (uint32_t)(w[k] * h[k]);
+    return sat16((int32_t)acc >> 15);
+}
+
+// --- 라이브러리 함수 구현: 설계 ---
+
+bool fxfilter_design_butter_lowpass(fxfilter_biquad_coef_t *coef, uint8_t stages, float fc_ratio) {
+    if (!coef || stages == 0 || stages > FXFILTER_MAX_BIQUADS || !(fc_ratio > 0.0f && fc_ratio < 0.5f)) return false;
+    double w0 = 2.0 * M_PI * fc_ratio, cw = cos(w0), sw = sin(w0);
+    for (uint8_t k = 0; k < stages; ++k) {
+        // 2 x stages차 버터워스의 k번째 극 쌍: Q = 1 / (2 cos((2k + 1) pi / (4 stages)))
+        double q = 1.0 / (2.0 * cos((2 * k + 1) * M_PI / (4.0 * stages)));
+        double alpha = sw / (2.0 * q);
+        quantize_unity_dc(&coef[k], (1.0 - cw) / 2.0, (1.0 - cw) / 2.0, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+    }
+    return true;
+}
+
+bool fxfilter_design_notch(fxfilter_biquad_coef_t *coef, float f0_ratio, float q) {
+    if (!coef || !(f0_ratio > 0.0f && f0_ratio < 0.5f) || !(q > 0.0f)) return false;
+    double w0 = 2.0 * M_PI * f0_ratio, cw = cos(w0), alpha = sin(w0) / (2.0 * q);
+    quantize_unity_dc(coef, 1.0, 1.0, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+    return true;
+}
+
+bool fxfilter_design_fir_lowpass(int16_t *taps, uint16_t ntaps, float fc_ratio) {
+    if (!taps || ntaps == 0 || ntaps > FXFILTER_MAX_TAPS || !(fc_ratio > 0.0f && fc_ratio < 0.5f)) return false;
+    double h[FXFILTER_MAX_TAPS], sum = 0.0, mid = (ntaps - 1) / 2.0;
+    for (uint16_t k = 0; k < ntaps; ++k) {
+        double t = k - mid;
+        double sinc = t == 0.0 ? 2.0 * fc_ratio : sin(2.0 * M_PI * fc_ratio * t) / (M_PI * t);
+        double win = ntaps > 1 ? 0.54 - 0.46 * cos(2.0 * M_PI * k / (ntaps - 1)) : 1.0;
+        h[k] = sinc * win;
+        sum += h[k];
+    }
+    // Q15로 반올림 후 합이 32768이 되도록 가운데 탭으로 보정
+    int32_t qsum = 0;
+    for (uint16_t k = 0; k < ntaps; ++k) {
+        int32_t v = (int32_t)lround(h[k] / sum * 32768.0);
+        taps[k] = sat16(v);
+        qsum += taps[k];
+    }
+    int32_t center = sat16(taps[ntaps / 2] + 32768 - qsum);
+    taps[ntaps / 2] = (int16_t)center;
+    return true;
+}
+
+// --- 라이브러리 함수 구현: 바이쿼드 ---
+
+bool fxfilter_biquad_init(fxfilter_biquad_t *f, const fxfilter_biquad_coef_t *coef, uint8_t stages) {
+    if (!f || !coef || stages == 0 || stages > FXFILTER_MAX_BIQUADS) return false;
+    memset(f, 0, sizeof(*f));
+    memcpy(f->coef, coef, stages * sizeof(*coef));
+    f->stages = stages;
+    return true;
+}
+
+void fxfilter_biquad_process(fxfilter_biquad_t *f, int16_t *buf, size_t n) {
+    // 구간 하나씩 블록 전체를 통과 (상태를 레지스터에 두고, 두 샘플씩 펼쳐 상태 이동을 줄임)
+    for (uint8_t s = 0; s < f->stages; ++s) {
+        const fxfilter_biquad_coef_t *c = &f->coef[s];
+        int32_t x1 = f->x1[s], x2 = f->x2[s], y1 = f->y1[s], y2 = f->y2[s], err = f->err[s];
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            int32_t xa = buf[i], xb = buf[i + 1];
+            int32_t ya = biquad_step(c, &err, xa, x1, x2, y1, y2);
+            int32_t yb = biquad_step(c, &err, xb, xa, x1, ya, y1);
+            buf[i] = (int16_t)ya;
+            buf[i + 1] = (int16_t)yb;
+            x2 = xa;
+            x1 = xb;
+            y2 = ya;
+            y1 = yb;
+        }
+        if (i < n) {
+            int32_t x0 = buf[i];
+            int32_t y0 = biquad_step(c, &err, x0, x1, x2, y1, y2);
+            buf[i] = (int16_t)y0;
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+        }
+        f->x1[s] = (int16_t)x1;
+        f->x2[s] = (int16_t)x2;
+        f->y1[s] = (int16_t)y1;
+        f->y2[s] = (int16_t)y2;
+        f->err[s] = err;
+    }
+}
+
+// --- 라이브러리 함수 구현: FIR ---
+
+bool fxfilter_fir_init(fxfilter_fir_t *f, const int16_t *taps, uint16_t ntaps, uint8_t factor) {
+    if (!f || !taps || ntaps == 0 || ntaps > FXFILTER_MAX_TAPS || factor == 0) return false;
+    memset(f, 0, sizeof(*f));
+    for (uint16_t k = 0; k < ntaps; ++k) f->taps[ntaps - 1 - k] = taps[k];
+    f->ntaps = ntaps;
+    f->factor = factor;
+    return true;
+}
+
+size_t fxfilter_fir_process(fxfilter_fir_t *f, int16_t *buf, size_t n) {
+    const uint16_t nt = f->ntaps;
+    uint16_t pos = f->pos;
+    uint8_t phase = f->phase;
+    size_t out = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int16_t x = buf[i];
+        f->hist[pos] = x;
+        f->hist[pos + nt] = x;
+        if (++pos == nt) pos = 0;
+        if (++phase < f->factor) continue; // 버려질 출력은 계산하지 않음
+        phase = 0;
+        buf[out++] = fir_dot(&f->hist[pos], f->taps, nt); // hist[pos .. pos + nt): 오래된 것 -> 최근
+    }
+    f->pos = pos;
+    f->phase = phase;
+    return out;
+}
+
+// --- 라이브러리 함수 구현: CIC ---
+
+bool fxfilter_cic_init(fxfilter_cic_t *f, uint8_t order, uint16_t factor) {
+    if (!f || order == 0 || order > FXFILTER_CIC_MAX_ORDER || factor < 2) return false;
+    uint8_t bits = 0;
+    while ((1u << bits) < factor) ++bits;
+    if (16 + order * bits > 32) return false;
+
+    memset(f, 0, sizeof(*f));
+    f->order = order;
+    f->factor = factor;
+    uint64_t gain = 1;
+    for (uint8_t k = 0; k < order; ++k) gain *= factor;
+    while ((1ull << f->shift) < gain) ++f->shift;
+    f->gain_q14 = (int32_t)(((1ull << (f->shift + 14)) + gain / 2) / gain);
+    return true;
+}
+
+size_t fxfilter_cic_process(fxfilter_cic_t *f, int16_t *buf, size_t n) {
+    // 적분기는 차수와 상관없이 4단 모두 갱신 (분기 없음, 안 쓰는 단은 버림)
+    uint32_t i0 = f->integ[0], i1 = f->integ[1], i2 = f->integ[2], i3 = f->integ[3];
+    const uint8_t last = f->order - 1;
+    uint16_t count = f->count;
+    size_t out = 0;
+    for (size_t i = 0; i < n; ++i) {
+        i0 += (uint32_t)(int32_t)buf[i];
+        i1 += i0;
+        i2 += i1;
+        i3 += i2;
+        if (++count < f->factor) continue;
+        count = 0;
+        uint32_t v = last == 0 ? i0 : (last == 1 ? i1 : (last == 2 ? i2 : i3));
+        for (uint8_t k = 0; k < f->order; ++k) {
+            uint32_t t = v;
+            v -= f->comb[k];
+            f->comb[k] = t;
+        }
+        // 이득 R^N 정규화: 2^shift로 나누고(반올림) 2^shift / R^N (Q14)를 곱함
+        int32_t y = (int32_t)(v + (1u << (f->shift - 1))) >> f->shift;
+        buf[out++] = sat16((y * f->gain_q14 + (1 << 13)) >> 14);
+    }
+    f->integ[0] = i0;
+    f->integ[1] = i1;
+    f->integ[2] = i2;
+    f->integ[3] = i3;
+    f->count = count;
+    return out;
+}
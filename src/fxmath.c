@@ -0,0 +1,232 @@
+#include "fxmath.h"
+
+// 디버그 검사 활성화 (필요 시 주석 해제): fxmath_init() 전에 LUT 함수를 부르면 경고 후 표를 채움
+// #define DEBUG_FXMATH
+
+#ifdef DEBUG_FXMATH
+#include <stdio.h>
+#endif
+
+#if FXMATH_CORDIC_ITERATIONS < 1 || FXMATH_CORDIC_ITERATIONS > 24
+#error "FXMATH_CORDIC_ITERATIONS must be 1..24"
+#endif
+#if FXMATH_LUT_BITS < 4 || FXMATH_LUT_BITS > 12
+#error "FXMATH_LUT_BITS must be 4..12"
+#endif
+
+#define CORDIC_MAX_ITERATIONS 24
+#define LUT_SIZE (1 << FXMATH_LUT_BITS)
+#define SIN_SHIFT (14 - FXMATH_LUT_BITS)      // 사분면 안 각도(14비트) -> 표 번호
+#define RATIO_SHIFT (16 - FXMATH_LUT_BITS)    // 비율(Q16) -> 표 번호
+#define ATAN_FRAC_BITS 2                      // atan 표는 이진 각도의 1/4 단위
+
+// atan(2^-i), 32비트 이진 각도
+static const uint32_t CORDIC_ATAN[CORDIC_MAX_ITERATIONS] = {
+    0x20000000u, 0x12e4051eu, 0x09fb385bu, 0x051111d4u, 0x028b0d43u, 0x0145d7e1u, 0x00a2f61eu, 0x00517c55u,
+    0x0028be53u, 0x00145f2fu, 0x000a2f98u, 0x000517ccu, 0x00028be6u, 0x000145f3u, 0x0000a2fau, 0x0000517du,
+    0x000028beu, 0x0000145fu, 0x00000a30u, 0x00000518u, 0x0000028cu, 0x00000146u, 0x000000a3u, 0x00000051u,
+};
+
+// 반복 n회의 이득 역수 1 / prod(sqrt(1 + 2^-2i)), Q30
+static const int32_t CORDIC_INV_GAIN_Q30[CORDIC_MAX_ITERATIONS] = {
+    759250125, 679093957, 658817909, 653730436, 652457347, 652138997, 652059405, 652039507,
+    652034532, 652033289, 652032978, 652032900, 652032881, 652032876, 652032874, 652032874,
+    652032874, 652032874, 652032874, 652032874, 652032874, 652032874, 652032874, 652032874,
+};
+
+// --- 표 (마지막 항목은 보간이 표 끝을 읽을 때를 위한 중복) ---
+static uint16_t sin_tab[LUT_SIZE + 2];        // sin(i / N x 90도) x 65534 (Q15의 2배, 보간 후 반올림)
+static uint16_t atan_tab[LUT_SIZE + 2];       // atan(i / N), 이진 각도 << ATAN_FRAC_BITS
+static uint16_t hyp_tab[LUT_SIZE + 2];        // sqrt(1 + (i / N)^2) - 1, Q16
+static bool lut_ready;
+
+// --- 내부 함수: CORDIC ---
+
+// 벡터 모드. 큰 성분을 [2^28, 2^29)로 맞춘 뒤 n회 반복.
+// 반환: 32비트 이진 각도, *mag_scaled = 크기 x 2^shift (이득 보정 전), *shift
+static uint32_t cordic_vector(int32_t y_in, int32_t x_in, int n, int32_t *mag_scaled, int *shift_out) {
+    int64_t x = x_in, y = y_in;
+    uint32_t angle = 0;
+    if (x < 0) { // 오른쪽 반평면으로 180도 회전
+        x = -x;
+        y = -y;
+        angle = 0x80000000u;
+    }
+    int64_t m = x > (y < 0 ? -y : y) ? x : (y < 0 ? -y : y);
+    if (m == 0) {
+        *mag_scaled = 0;
+        *shift_out = 0;
+        return 0;
+    }
+    int shift = 0;
+    while (m < (1 << 28)) {
+        m <<= 1;
+        ++shift;
+    }
+    while (m >= (1 << 29)) {
+        m >>= 1;
+        --shift;
+    }
+    int32_t xi = (int32_t)(shift >= 0 ? x * ((int64_t)1 << shift) : x >> -shift);
+    int32_t yi = (int32_t)(shift >= 0 ? y * ((int64_t)1 << shift) : y >> -shift);
+
+    for (int i = 0; i < n; ++i) {
+        int32_t dx = xi >> i, dy = yi >> i;
+        if (yi > 0) {
+            xi += dy;
+            yi -= dx;
+            angle += CORDIC_ATAN[i];
+        } else {
+            xi -= dy;
+            yi += dx;
+            angle -= CORDIC_ATAN[i];
+        }
+    }
+    *mag_scaled = (int32_t)(((int64_t)xi * CORDIC_INV_GAIN_Q30[n - 1]) >> 30);
+    *shift_out = shift;
+    return angle;
+}
+
+// 회전 모드. (cos, sin) Q30, angle은 32비트 이진 각도 (전 범위)
+static void cordic_rotate(uint32_t angle, int n, int32_t *c, int32_t *s) {
+    int32_t x = CORDIC_INV_GAIN_Q30[n - 1], y = 0;
+    bool flip = angle + 0x40000000u >= 0x80000000u; // |angle| > 90도: 180도 돌려서 계산 후 부호 반전
+    int32_t z = (int32_t)(flip ? angle + 0x80000000u : angle);
+    for (int i = 0; i < n; ++i) {
+        int32_t dx = x >> i, dy = y >> i;
+        if (z >= 0) {
+            x -= dy;
+            y += dx;
+            z -= (int32_t)CORDIC_ATAN[i];
+        } else {
+            x += dy;
+            y -= dx;
+            z += (int32_t)CORDIC_ATAN[i];
+        }
+    }
+    *c = flip ? -x : x;
+    *s = flip ? -y : y;
+}
+
+// Q30 (1.0 = 2^30) -> Q15 (1.0 = 32767), 반올림
+static int16_t q30_to_q15(int32_t v) {
+    int32_t r = (int32_t)(((int64_t)v * 32767 + (1 << 29)) >> 30);
+    return (int16_t)(r > 32767 ? 32767 : (r < -32767 ? -32767 : r));
+}
+
+// --- 내부 함수: LUT ---
+
+// sin(x / 16384 x 90도), x = 0 ~ 16384
+static int16_t quarter_sin(uint32_t x) {
+    uint32_t i = x >> SIN_SHIFT, f = x & ((1u << SIN_SHIFT) - 1u);
+    int32_t a = sin_tab[i], d = (int32_t)sin_tab[i + 1] - a;
+    return (int16_t)(((a << SIN_SHIFT) + d * (int32_t)f + (1 << SIN_SHIFT)) >> (SIN_SHIFT + 1));
+}
+
+static uint32_t lerp_u16(const uint16_t *tab, uint32_t r) {
+    uint32_t i = r >> RATIO_SHIFT, f = r & ((1u << RATIO_SHIFT) - 1u);
+    int32_t a = tab[i], d = (int32_t)tab[i + 1] - a;
+    return (uint32_t)(a + ((d * (int32_t)f + (1 << (RATIO_SHIFT - 1))) >> RATIO_SHIFT));
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void fxmath_init(void) {
+    if (lut_ready) return; // 여러 모듈의 초기화에서 호출됨
+    for (int i = 0; i <= LUT_SIZE; ++i) {
+        int32_t c, s, mag;
+        int shift;
+        cordic_rotate((uint32_t)i << (30 - FXMATH_LUT_BITS), CORDIC_MAX_ITERATIONS, &c, &s);
+        sin_tab[i] = (uint16_t)(((int64_t)s * 65534 + (1 << 29)) >> 30);
+        uint32_t a = cordic_vector(i, LUT_SIZE, CORDIC_MAX_ITERATIONS, &mag, &shift);
+        atan_tab[i] = (uint16_t)((a + (1u << (15 - ATAN_FRAC_BITS))) >> (16 - ATAN_FRAC_BITS));
+        // 크기 / N - 1 (Q16): mag는 N x 2^shift 배율
+        int64_t den = (int64_t)LUT_SIZE << shift;
+        hyp_tab[i] = (uint16_t)((((int64_t)mag << 16) + den / 2) / den - 65536);
+    }
+    sin_tab[LUT_SIZE + 1] = sin_tab[LUT_SIZE];
+    atan_tab[LUT_SIZE + 1] = atan_tab[LUT_SIZE];
+    hyp_tab[LUT_SIZE + 1] = hyp_tab[LUT_SIZE];
+    lut_ready = true;
+}
+
+void fx_sincos_cordic(fx_angle_t a, int16_t *sin_q15, int16_t *cos_q15) {
+    int32_t c, s;
+    cordic_rotate((uint32_t)a << 16, FXMATH_CORDIC_ITERATIONS, &c, &s);
+    *sin_q15 = q30_to_q15(s);
+    *cos_q15 = q30_to_q15(c);
+}
+
+fx_angle_t fx_atan2_cordic(int32_t y, int32_t x, uint32_t *mag) {
+    int32_t m;
+    int shift;
+    uint32_t angle = cordic_vector(y, x, FXMATH_CORDIC_ITERATIONS, &m, &shift);
+    if (mag) *mag = (uint32_t)(shift >= 0 ? (uint32_t)m >> shift : (uint32_t)m << -shift);
+    return (fx_angle_t)((angle + 0x8000u) >> 16);
+}
+
+void fx_sincos_lut(fx_angle_t a, int16_t *sin_q15, int16_t *cos_q15) {
+#ifdef DEBUG_FXMATH
+    if (!lut_ready) {
+        printf("fxmath: LUT used before fxmath_init()\n");
+        fxmath_init();
+    }
+#endif
+    uint32_t x = a & 0x3FFFu;
+    int16_t s = quarter_sin(x), c = quarter_sin(16384u - x);
+    switch (a >> 14) {
+        case 0: *sin_q15 = s; *cos_q15 = c; break;
+        case 1: *sin_q15 = c; *cos_q15 = (int16_t)-s; break;
+        case 2: *sin_q15 = (int16_t)-s; *cos_q15 = (int16_t)-c; break;
+        default: *sin_q15 = (int16_t)-c; *cos_q15 = s; break;
+    }
+}
+
+fx_angle_t fx_atan2_lut(int32_t y, int32_t x, uint32_t *mag) {
+#ifdef DEBUG_FXMATH
+    if (!lut_ready) {
+        printf("fxmath: LUT used before fxmath_init()\n");
+        fxmath_init();
+    }
+#endif
+    uint32_t ax = x < 0 ? 0u - (uint32_t)x : (uint32_t)x, ay = y < 0 ? 0u - (uint32_t)y : (uint32_t)y;
+    bool swap = ay > ax;
+    uint32_t hi = swap ? ay : ax, lo = swap ? ax : ay;
+    if (hi == 0) {
+        if (mag) *mag = 0;
+        return 0;
+    }
+
+    // 비율 lo / hi (Q16): hi를 16비트 안으로 줄여 32비트 나눗셈 한 번으로 (RP2040 하드웨어 나눗셈기)
+    uint32_t h = hi, l = lo;
+    if (h >= 1u << 24) { h >>= 8; l >>= 8; }
+    if (h >= 1u << 20) { h >>= 4; l >>= 4; }
+    if (h >= 1u << 18) { h >>= 2; l >>= 2; }
+    if (h >= 1u << 17) { h >>= 1; l >>= 1; }
+    if (h >= 1u << 16) { h >>= 1; l >>= 1; }
+    uint32_t r = (l << 16) / h;
+
+    // 첫 팔분원 각도 -> 사분면 -> 전체
+    uint32_t a = (lerp_u16(atan_tab, r) + (1u << (ATAN_FRAC_BITS - 1))) >> ATAN_FRAC_BITS;
+    if (swap) a = 16384u - a;
+    if (x < 0) a = 32768u - a;
+    if (y < 0) a = 65536u - a;
+
+    if (mag) *mag = hi + (uint32_t)(((uint64_t)hi * lerp_u16(hyp_tab, r)) >> 16);
+    return (fx_angle_t)a;
+}
+
+uint32_t fx_isqrt(uint32_t v) {
+    uint32_t root = 0, bit = 1u << 30;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
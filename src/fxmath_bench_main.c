@@ -0,0 +1,117 @@
+#include <math.h>
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#include "fxmath.h"
+#include "fxfft.h"
+
+// 고정소수점 수학 함수의 RP2040 사이클 수를 newlib float (소프트웨어 에뮬레이션 / pico 부동소수점 ROM)와 비교.
+// 함수마다 입력 BENCH_INPUTS개를 BENCH_ROUNDS번 돌려 호출당 평균/최대 사이클을 JSON 한 줄씩 출력
+
+#define BENCH_INPUTS 64
+#define BENCH_ROUNDS 50
+
+static fx_angle_t angles[BENCH_INPUTS];
+static float fangles[BENCH_INPUTS];
+static int32_t vx[BENCH_INPUTS], vy[BENCH_INPUTS];
+static float fx[BENCH_INPUTS], fy[BENCH_INPUTS];
+static volatile int32_t sink;
+static volatile float fsink;
+static fxfft_cpx_t fft_in[FXFFT_MAX_SIZE], fft_buf[FXFFT_MAX_SIZE];
+
+// SysTick은 24비트 하향 카운터 (프로세서 클록)
+static inline uint32_t cycles_between(uint32_t start, uint32_t end) {
+    return (start - end) & 0x00FFFFFFu;
+}
+
+// BENCH(name, body): body를 i = 0..BENCH_INPUTS-1로 실행해 호출당 사이클 측정 (빈 루프 시간 제외)
+#define BENCH(name, body)                                                                       \
+    do {                                                                                        \
+        uint32_t total = 0, worst = 0;                                                          \
+        for (int r = 0; r < BENCH_ROUNDS; ++r) {                                                \
+            uint32_t t0 = systick_hw->cvr;                                                      \
+            for (int i = 0; i < BENCH_INPUTS; ++i) {                                            \
+                body;                                                                           \
+            }                                                                                   \
+            uint32_t c = cycles_between(t0, systick_hw->cvr);                                   \
+            c = c > loop_cycles ? c - loop_cycles : 0;                                          \
+            total += c;                                                                         \
+            if (c > worst) worst = c;                                                           \
+        }                                                                                       \
+        printf("{\"func\":\"%s\",\"cycles_avg\":%lu,\"cycles_worst_batch_avg\":%lu}\n", name, \
+               (unsigned long)(total / (BENCH_ROUNDS * BENCH_INPUTS)),                          \
+               (unsigned long)(worst / BENCH_INPUTS));                                          \
+    } while (0)
+
+int main()
+{
+    stdio_init_all();
+    sleep_ms(2000); // 터미널 연결 대기
+
+    uint32_t seed = 99;
+    for (int i = 0; i < BENCH_INPUTS; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        angles[i] = (fx_angle_t)(seed >> 16);
+        fangles[i] = angles[i] * (2.0f * (float)M_PI / 65536.0f);
+        seed = seed * 1664525u + 1013904223u;
+        vx[i] = (int32_t)(seed >> 14) - 131072;
+        seed = seed * 1664525u + 1013904223u;
+        vy[i] = (int32_t)(seed >> 14) - 131072;
+        fx[i] = (float)vx[i];
+        fy[i] = (float)vy[i];
+    }
+    fxmath_init();
+
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // 프로세서 클록, 인터럽트 없음
+
+    // 빈 루프 (입력 읽기 + sink 쓰기) 시간
+    uint32_t loop_cycles = 0;
+    {
+        uint32_t t0 = systick_hw->cvr;
+        for (int i = 0; i < BENCH_INPUTS; ++i) sink = vx[i];
+        loop_cycles = cycles_between(t0, systick_hw->cvr);
+    }
+
+    printf("{\"cordic_iterations\":%d,\"lut_bits\":%d,\"loop_cycles\":%lu}\n", FXMATH_CORDIC_ITERATIONS,
+           FXMATH_LUT_BITS, (unsigned long)loop_cycles);
+
+    int16_t s, c;
+    uint32_t m;
+    BENCH("fx_sincos_cordic", (fx_sincos_cordic(angles[i], &s, &c), sink = s + c));
+    BENCH("fx_sincos_lut", (fx_sincos_lut(angles[i], &s, &c), sink = s + c));
+    BENCH("sinf+cosf", fsink = sinf(fangles[i]) + cosf(fangles[i]));
+    BENCH("fx_atan2_cordic", sink = fx_atan2_cordic(vy[i], vx[i], &m) + (int32_t)m);
+    BENCH("fx_atan2_lut", sink = fx_atan2_lut(vy[i], vx[i], &m) + (int32_t)m);
+    BENCH("atan2f+hypotf", fsink = atan2f(fy[i], fx[i]) + hypotf(fx[i], fy[i]));
+    BENCH("fx_isqrt", sink = (int32_t)fx_isqrt((uint32_t)vx[i] * 7u));
+    BENCH("sqrtf", fsink = sqrtf((float)((uint32_t)vx[i] * 7u)));
+
+    // FFT: 크기마다 한 번 호출당 사이클 (입력 복사 제외). 2048점도 SysTick 24비트 범위 안 (약 134 ms)
+    for (int i = 0; i < FXFFT_MAX_SIZE; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        fft_in[i].re = (int16_t)(seed >> 18) - 8192;
+        fft_in[i].im = (int16_t)(seed >> 4) >> 2;
+    }
+    fxfft_init();
+    for (uint8_t log2n = 8; log2n <= FXFFT_MAX_LOG2; ++log2n) {
+        uint32_t worst = 0, total = 0;
+        for (int r = 0; r < 8; ++r) {
+            for (int i = 0; i < (1 << log2n); ++i) fft_buf[i] = fft_in[i];
+            uint32_t t0 = systick_hw->cvr;
+            sink = fxfft_forward(fft_buf, log2n);
+            uint32_t c = cycles_between(t0, systick_hw->cvr);
+            total += c;
+            if (c > worst) worst = c;
+        }
+        printf("{\"func\":\"fxfft_forward\",\"n\":%d,\"cycles_avg\":%lu,\"cycles_worst\":%lu}\n", 1 << log2n,
+               (unsigned long)(total / 8), (unsigned long)worst);
+    }
+
+    systick_hw->csr = 0;
+
+    while (true) {
+        sleep_ms(1000);
+    }
+}
@@ -0,0 +1,147 @@
+#include "guidance.h"
+#include <string.h>
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_GUIDANCE
+
+#ifdef DEBUG_GUIDANCE
+#include <stdio.h>
+#endif
+
+#define ANGLE_30 5461
+#define CM_PER_LAT_E7_Q16 72954               // 위도 1e-7 도 = 1.11319 cm (WGS84 적도 반지름)
+
+// --- 내부 함수 ---
+
+static int32_t clamp32(int32_t v, int32_t lo, int32_t hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+static uint16_t bearing_to(int32_t de, int32_t dn, uint32_t *dist) {
+    return fx_atan2(de, dn, dist); // 0 = 북, 시계 방향이므로 y = 동, x = 북
+}
+
+// 목표점으로 갈 때: 남은 고도로 (공기 기준) 갈 수 있는 거리에 따라 직진 / 선회 결정.
+// 반경 2배보다 많이 남으면 선회, 반경 절반 이하로 남으면 목표점으로 (선회를 빠져나와 돌아서는 몫)
+static void update_energy(guidance_t *g, int64_t reach_cm) {
+    const int32_t r = GUIDANCE_LOITER_RADIUS_CM;
+    if (reach_cm < 0) {
+        g->mode = GUIDANCE_MODE_HOMING;
+    } else if (g->mode != GUIDANCE_MODE_LOITER && reach_cm > (int64_t)g->dist_cm + 2 * r) {
+        g->mode = GUIDANCE_MODE_LOITER;
+    } else if (g->mode == GUIDANCE_MODE_LOITER && reach_cm < (int64_t)g->dist_cm + r / 2) {
+        g->mode = GUIDANCE_MODE_HOMING;
+    } else if (g->mode != GUIDANCE_MODE_LOITER) {
+        g->mode = GUIDANCE_MODE_HOMING;
+    }
+}
+
+// 바람 추정: 지상 속도 - 대기 속도(자기 방위 방향, 하강 속도 x 활공비)를 저역 통과
+static void update_wind(guidance_t *g, const guidance_fix_t *fix, uint16_t heading, int32_t sink_cms) {
+    int32_t air = (sink_cms * GUIDANCE_GLIDE_RATIO_Q8) >> 8;
+    int16_t s, c;
+    fx_sincos(heading, &s, &c);
+    int32_t air_e = (air * s) >> 15, air_n = (air * c) >> 15;
+    g->wind_e_cms += (fix->vel_e_cms - air_e - g->wind_e_cms) >> GUIDANCE_WIND_FILTER_SHIFT;
+    g->wind_n_cms += (fix->vel_n_cms - air_n - g->wind_n_cms) >> GUIDANCE_WIND_FILTER_SHIFT;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void guidance_init(guidance_t *g, int32_t target_lat_e7, int32_t target_lon_e7) {
+    fxmath_init();
+    memset(g, 0, sizeof(*g));
+    g->lat0_e7 = target_lat_e7;
+    g->lon0_e7 = target_lon_e7;
+    // 경도 1e-7 도의 길이 = 위도 1e-7 도 x cos(위도). 초기화 때 한 번만 계산
+    fx_angle_t lat_angle = (fx_angle_t)((((int64_t)target_lat_e7 << 16) + 1800000000ll) / 3600000000ll);
+    g->lon_scale_q16 = (CM_PER_LAT_E7_Q16 * fx_cos(lat_angle) + (1 << 14)) >> 15;
+    g->mode = GUIDANCE_MODE_NO_FIX;
+}
+
+bool guidance_add_waypoint(guidance_t *g, int32_t east_cm, int32_t north_cm) {
+    if (g->wp_count >= GUIDANCE_MAX_WAYPOINTS) return false;
+    g->wp_e[g->wp_count] = east_cm;
+    g->wp_n[g->wp_count] = north_cm;
+    ++g->wp_count;
+    return true;
+}
+
+void guidance_fix(guidance_t *g, const guidance_fix_t *fix, uint16_t heading, int32_t height_cm, int32_t sink_cms) {
+    g->pos_n = (int32_t)(((int64_t)(fix->lat_e7 - g->lat0_e7) * CM_PER_LAT_E7_Q16 + 0x8000) >> 16);
+    g->pos_e = (int32_t)(((int64_t)(fix->lon_e7 - g->lon0_e7) * g->lon_scale_q16 + 0x8000) >> 16);
+    uint16_t course = fx_atan2(fix->vel_e_cms, fix->vel_n_cms, &g->ground_speed_cms);
+    if (!g->have_fix) { // 첫 구간은 현재 위치에서 시작
+        g->leg_e = g->pos_e;
+        g->leg_n = g->pos_n;
+    }
+
+    // 경유점: 반경 안에 들어오거나 구간 끝의 수직선을 넘으면 다음으로
+    while (g->wp_index < g->wp_count) {
+        int32_t we = g->wp_e[g->wp_index], wn = g->wp_n[g->wp_index];
+        g->bearing = bearing_to(we - g->pos_e, wn - g->pos_n, &g->dist_cm);
+        int64_t along = (int64_t)(we - g->leg_e) * (g->pos_e - we) + (int64_t)(wn - g->leg_n) * (g->pos_n - wn);
+        if (g->dist_cm > GUIDANCE_ACCEPT_RADIUS_CM && along <= 0) break;
+#ifdef DEBUG_GUIDANCE
+        printf("Waypoint %u reached (%ld, %ld) cm\n", g->wp_index, (long)g->pos_e, (long)g->pos_n);
+#endif
+        g->leg_e = we;
+        g->leg_n = wn;
+        ++g->wp_index;
+    }
+
+    bool descending = sink_cms >= GUIDANCE_MIN_SINK_CMS && height_cm > 0;
+    if (descending) update_wind(g, fix, heading, sink_cms);
+
+    uint16_t ref;
+    if (g->wp_index < g->wp_count) {
+        // 경유점: 지상 항적을 알 수 있으면 항적 기준 (바람에 밀리는 만큼 자동으로 보정)
+        g->mode = GUIDANCE_MODE_WAYPOINT;
+        g->desired = g->bearing;
+        ref = g->ground_speed_cms >= GUIDANCE_MIN_GROUND_SPEED_CMS ? course : heading;
+    } else {
+        // 목표점: 착지까지 바람에 밀릴 거리만큼 바람 반대쪽으로 옮긴 점(공기 기준 목표점)을 자기 방위로 추적
+        int32_t aim_e = -g->pos_e, aim_n = -g->pos_n;
+        int64_t reach = -1;
+        if (descending) {
+            aim_e -= (int32_t)((int64_t)g->wind_e_cms * height_cm / sink_cms);
+            aim_n -= (int32_t)((int64_t)g->wind_n_cms * height_cm / sink_cms);
+            reach = ((int64_t)height_cm * GUIDANCE_GLIDE_RATIO_Q8) >> 8;
+        }
+        g->bearing = bearing_to(aim_e, aim_n, &g->dist_cm);
+        update_energy(g, reach);
+        if (g->mode == GUIDANCE_MODE_LOITER) {
+            // 목표점을 오른쪽에 두고 시계 방향 선회: 반경에서 접선(90도), 멀수록 목표점 쪽, 가까우면 바깥쪽
+            int32_t off = (int32_t)(((int64_t)((int32_t)g->dist_cm - GUIDANCE_LOITER_RADIUS_CM) * FX_ANGLE_90) /
+                                    GUIDANCE_LOITER_RADIUS_CM);
+            g->desired = (uint16_t)(g->bearing - (FX_ANGLE_90 - clamp32(off, -ANGLE_30, FX_ANGLE_90)));
+        } else {
+            g->desired = g->bearing;
+        }
+        ref = heading;
+    }
+
+    g->track_err_at_fix = (int16_t)(uint16_t)(g->desired - ref);
+    g->heading_at_fix = heading;
+    g->steps_since_fix = 0;
+    g->have_fix = true;
+}
+
+bool guidance_step(guidance_t *g, uint16_t heading, int32_t yaw_rate, guidance_output_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (!g->have_fix || g->steps_since_fix >= GUIDANCE_FIX_TIMEOUT_STEPS) {
+        g->mode = GUIDANCE_MODE_NO_FIX;
+        return false;
+    }
+    ++g->steps_since_fix;
+
+    // GPS 해 이후 기체가 돈 만큼 항적도 돌았다고 보고 오차 갱신 (삼각 함수 없음)
+    uint16_t turned = (uint16_t)(heading - g->heading_at_fix);
+    out->track_err = (int16_t)(uint16_t)((uint16_t)g->track_err_at_fix - turned);
+    out->turn_rate_cmd = clamp32((out->track_err * GUIDANCE_TURN_GAIN_Q8) >> 8, -GUIDANCE_MAX_TURN_RATE,
+                                 GUIDANCE_MAX_TURN_RATE);
+    int32_t diff = clamp32(GUIDANCE_RATE_GAIN_Q15 * (out->turn_rate_cmd - yaw_rate), -32767, 32767);
+    out->brake_left_q15 = (int16_t)(diff < 0 ? -diff : 0);
+    out->brake_right_q15 = (int16_t)(diff > 0 ? diff : 0);
+    return true;
+}
@@ -0,0 +1,248 @@
+#include "irq_latency.h"
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "pico/flash.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#include "hardware/dma.h"
+#include "hardware/uart.h"
+#include "hardware/flash.h"
+#include "hardware/structs/systick.h"
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_IRQ_LATENCY
+
+#ifdef DEBUG_IRQ_LATENCY
+#include <stdio.h>
+#endif
+
+// 인터럽트 응답을 기다리는 최대 시간 (us). 플래시 erase 중 lockout을 고려해 넉넉히
+#define IRQ_WAIT_TIMEOUT_US 200000
+
+// 플래시 부하가 사용하는 영역: 플래시 마지막 섹터 (프로그램 영역과 겹치지 않음)
+#define LOAD_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+
+#define LOAD_DMA_WORDS 1024
+#define LOAD_UART_BAUD 921600
+
+// --- 내부 상태 ---
+static volatile bool irq_fired;
+static volatile uint32_t irq_entry_stamp; // GPIO: SysTick CVR, 타이머: timerawl
+static uint16_t sense_gpio_num;
+
+static volatile bool load_running;
+static irq_latency_load_t load_kind;
+static uint32_t dma_src[LOAD_DMA_WORDS];
+static uint32_t dma_dst[LOAD_DMA_WORDS];
+static uint8_t flash_page[FLASH_PAGE_SIZE];
+
+// --- 인터럽트 핸들러 (RAM에서 실행해 XIP 캐시 미스 영향을 제외) ---
+
+static void __not_in_flash_func(gpio_latency_isr)(void) {
+    irq_entry_stamp = systick_hw->cvr; // 가장 먼저 기록
+    gpio_acknowledge_irq(sense_gpio_num, GPIO_IRQ_EDGE_RISE);
+    irq_fired = true;
+}
+
+static void __not_in_flash_func(timer_latency_isr)(void) {
+    irq_entry_stamp = timer_hw->timerawl;
+    hw_clear_bits(&timer_hw->intr, 1u << 0);
+    irq_fired = true;
+}
+
+// --- 배경 부하 (core 1) ---
+
+static void flash_load_op(void *param) {
+    (void)param;
+    flash_range_erase(LOAD_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(LOAD_FLASH_OFFSET, flash_page, FLASH_PAGE_SIZE);
+}
+
+static void load_core1_entry(void) {
+    switch (load_kind) {
+    case IRQ_LATENCY_LOAD_FLASH:
+        while (load_running) {
+            // core 0을 lockout 시킨 뒤 실행됨 (core 0은 multicore_lockout_victim_init 필요)
+            flash_safe_execute(flash_load_op, NULL, 100);
+        }
+        break;
+
+    case IRQ_LATENCY_LOAD_DMA: {
+        int chan = dma_claim_unused_channel(true);
+        dma_channel_config c = dma_channel_get_default_config(chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, true);
+        while (load_running) {
+            dma_channel_configure(chan, &c, dma_dst, dma_src, LOAD_DMA_WORDS, true);
+            dma_channel_wait_for_finish_blocking(chan);
+        }
+        dma_channel_unclaim(chan);
+        break;
+    }
+
+    case IRQ_LATENCY_LOAD_UART:
+        uart_init(uart1, LOAD_UART_BAUD);
+        while (load_running) {
+            uart_putc_raw(uart1, 0x55);
+        }
+        uart_deinit(uart1);
+        break;
+
+    default:
+        break;
+    }
+
+    while (true) {
+        tight_loop_contents();
+    }
+}
+
+static void start_load(irq_latency_load_t load) {
+    if (load == IRQ_LATENCY_LOAD_NONE) return;
+    load_kind = load;
+    load_running = true;
+    multicore_reset_core1();
+    multicore_launch_core1(load_core1_entry);
+}
+
+static void stop_load(irq_latency_load_t load) {
+    if (load == IRQ_LATENCY_LOAD_NONE) return;
+    load_running = false;
+    sleep_ms(10); // 진행 중인 플래시/DMA 작업 완료 대기
+    multicore_reset_core1();
+}
+
+// --- 측정 루프 ---
+
+static bool wait_for_irq(void) {
+    absolute_time_t deadline = make_timeout_time_us(IRQ_WAIT_TIMEOUT_US);
+    while (!irq_fired) {
+        if (time_reached(deadline)) return false;
+    }
+    return true;
+}
+
+static bool measure_gpio(const irq_latency_config_t *config, latency_hist_t *hist) {
+    sense_gpio_num = config->sense_gpio;
+
+    gpio_init(config->trigger_gpio);
+    gpio_set_dir(config->trigger_gpio, GPIO_OUT);
+    gpio_put(config->trigger_gpio, 0);
+    gpio_init(config->sense_gpio);
+    gpio_set_dir(config->sense_gpio, GPIO_IN);
+    gpio_pull_down(config->sense_gpio);
+
+    // SDK의 공용 GPIO 콜백 디스패치를 거치지 않도록 뱅크 인터럽트를 직접 점유
+    irq_set_exclusive_handler(IO_IRQ_BANK0, gpio_latency_isr);
+    gpio_set_irq_enabled(config->sense_gpio, GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    // SysTick: 프로세서 클럭, 24비트 최대 reload (다운 카운터)
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+
+    const uint32_t trigger_mask = 1u << config->trigger_gpio;
+    bool ok = true;
+    for (uint32_t i = 0; i < config->samples; ++i) {
+        irq_fired = false;
+        uint32_t start = systick_hw->cvr;
+        sio_hw->gpio_set = trigger_mask;
+
+        if (!wait_for_irq()) {
+            ok = false;
+            break;
+        }
+        sio_hw->gpio_clr = trigger_mask;
+
+        latency_hist_add(hist, (start - irq_entry_stamp) & 0x00FFFFFF);
+        sleep_us(config->period_us);
+    }
+
+    gpio_set_irq_enabled(config->sense_gpio, GPIO_IRQ_EDGE_RISE, false);
+    irq_set_enabled(IO_IRQ_BANK0, false);
+    irq_remove_handler(IO_IRQ_BANK0, gpio_latency_isr);
+    systick_hw->csr = 0;
+    return ok;
+}
+
+static bool measure_timer(const irq_latency_config_t *config, latency_hist_t *hist) {
+    // 알람 0은 SDK 알람 풀이 쓰지 않도록 직접 점유
+    hardware_alarm_claim(0);
+    irq_set_exclusive_handler(TIMER_IRQ_0, timer_latency_isr);
+    hw_set_bits(&timer_hw->inte, 1u << 0);
+    irq_set_enabled(TIMER_IRQ_0, true);
+
+    bool ok = true;
+    for (uint32_t i = 0; i < config->samples; ++i) {
+        irq_fired = false;
+        uint32_t target = timer_hw->timerawl + config->period_us;
+        timer_hw->alarm[0] = target;
+
+        if (!wait_for_irq()) {
+            ok = false;
+            break;
+        }
+        latency_hist_add(hist, irq_entry_stamp - target);
+    }
+
+    irq_set_enabled(TIMER_IRQ_0, false);
+    hw_clear_bits(&timer_hw->inte, 1u << 0);
+    irq_remove_handler(TIMER_IRQ_0, timer_latency_isr);
+    hardware_alarm_unclaim(0);
+    return ok;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool irq_latency_run(const irq_latency_config_t *config, latency_hist_t *hist) {
+    if (!config || !hist || config->samples == 0 || config->load >= IRQ_LATENCY_LOAD_COUNT) {
+        return false;
+    }
+
+    static bool lockout_initialized = false;
+    if (!lockout_initialized) {
+        multicore_lockout_victim_init(); // 플래시 부하가 core 0을 멈출 수 있도록
+        lockout_initialized = true;
+    }
+
+    bool ok;
+    switch (config->source) {
+    case IRQ_LATENCY_SRC_GPIO:
+        latency_hist_reset(hist, IRQ_LATENCY_GPIO_BIN_CYCLES);
+        start_load(config->load);
+        ok = measure_gpio(config, hist);
+        break;
+    case IRQ_LATENCY_SRC_TIMER:
+        latency_hist_reset(hist, IRQ_LATENCY_TIMER_BIN_US);
+        start_load(config->load);
+        ok = measure_timer(config, hist);
+        break;
+    default:
+        return false;
+    }
+    stop_load(config->load);
+
+#ifdef DEBUG_IRQ_LATENCY
+    if (!ok) {
+        printf("Error: IRQ from %s did not fire within %d us.\n",
+               irq_latency_source_name(config->source), IRQ_WAIT_TIMEOUT_US);
+    }
+#endif
+    return ok;
+}
+
+const char *irq_latency_source_name(irq_latency_source_t source) {
+    switch (source) {
+    case IRQ_LATENCY_SRC_GPIO:  return "gpio";
+    case IRQ_LATENCY_SRC_TIMER: return "timer";
+    default:                    return "unknown";
+    }
+}
+
+const char *irq_latency_load_name(irq_latency_load_t load) {
+    static const char *const names[IRQ_LATENCY_LOAD_COUNT] = { "none", "flash", "dma", "uart" };
+    return load < IRQ_LATENCY_LOAD_COUNT ? names[load] : "unknown";
+}
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "irq_latency.h"
+
+// GPIO 루프백 핀: 두 핀을 점퍼로 연결해야 GPIO 소스 측정이 가능
+#define LATENCY_TRIGGER_GPIO 14
+#define LATENCY_SENSE_GPIO 15
+
+#define LATENCY_SAMPLES 2000
+#define LATENCY_PERIOD_US 200
+
+// 모든 소스 x 부하 조합을 측정해 JSON 한 줄씩 출력 (회귀 추적용)
+int main()
+{
+    stdio_init_all();
+    sleep_ms(2000); // 터미널 연결 대기
+
+    static latency_hist_t hist;
+    for (int src = IRQ_LATENCY_SRC_GPIO; src <= IRQ_LATENCY_SRC_TIMER; ++src) {
+        for (int load = IRQ_LATENCY_LOAD_NONE; load < IRQ_LATENCY_LOAD_COUNT; ++load) {
+            irq_latency_config_t config = {
+                .source = (irq_latency_source_t)src,
+                .load = (irq_latency_load_t)load,
+                .samples = LATENCY_SAMPLES,
+                .trigger_gpio = LATENCY_TRIGGER_GPIO,
+                .sense_gpio = LATENCY_SENSE_GPIO,
+                .period_us = LATENCY_PERIOD_US,
+            };
+
+            if (!irq_latency_run(&config, &hist)) {
+                printf("{\"source\":\"%s\",\"load\":\"%s\",\"error\":\"timeout\"}\n",
+                       irq_latency_source_name(config.source), irq_latency_load_name(config.load));
+                continue;
+            }
+            latency_hist_print_json(&hist, irq_latency_source_name(config.source),
+                                    irq_latency_load_name(config.load),
+                                    src == IRQ_LATENCY_SRC_GPIO ? "cycles" : "us");
+        }
+    }
+
+    while (true) {
+        sleep_ms(1000);
+    }
+}
@@ -0,0 +1,60 @@
+#include "latency_hist.h"
+#include <stdio.h>
+#include <string.h> // memset 사용
+
+void latency_hist_reset(latency_hist_t *hist, uint32_t bin_width) {
+    memset(hist, 0, sizeof(*hist));
+    hist->bin_width = bin_width ? bin_width : 1;
+    hist->min = UINT32_MAX;
+}
+
+void latency_hist_add(latency_hist_t *hist, uint32_t value) {
+    uint32_t bin = value / hist->bin_width;
+    if (bin < LATENCY_HIST_BINS) {
+        hist->bins[bin]++;
+    } else {
+        hist->overflow++;
+    }
+
+    if (value < hist->min) hist->min = value;
+    if (value > hist->max) hist->max = value;
+    hist->sum += value;
+    hist->count++;
+}
+
+uint32_t latency_hist_percentile(const latency_hist_t *hist, uint8_t percent) {
+    if (hist->count == 0) return 0;
+    if (percent > 100) percent = 100;
+
+    // 올림 처리: 최소 한 개의 샘플은 포함되도록
+    uint64_t target = ((uint64_t)hist->count * percent + 99) / 100;
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_HIST_BINS; ++i) {
+        seen += hist->bins[i];
+        if (seen >= target) {
+            uint32_t upper = (uint32_t)(i + 1) * hist->bin_width - 1;
+            return upper < hist->max ? upper : hist->max;
+        }
+    }
+    return hist->max; // overflow 영역
+}
+
+void latency_hist_print_json(const latency_hist_t *hist, const char *source,
+                             const char *load, const char *unit) {
+    printf("{\"source\":\"%s\",\"load\":\"%s\",\"unit\":\"%s\",\"count\":%lu",
+           source, load, unit, (unsigned long)hist->count);
+    printf(",\"min\":%lu,\"max\":%lu,\"sum\":%llu",
+           (unsigned long)(hist->count ? hist->min : 0), (unsigned long)hist->max,
+           (unsigned long long)hist->sum);
+    printf(",\"p50\":%lu,\"p99\":%lu",
+           (unsigned long)latency_hist_percentile(hist, 50),
+           (unsigned long)latency_hist_percentile(hist, 99));
+    printf(",\"bin_width\":%lu,\"overflow\":%lu,\"bins\":[",
+           (unsigned long)hist->bin_width, (unsigned long)hist->overflow);
+    for (int i = 0; i < LATENCY_HIST_BINS; ++i) {
+        printf(i ? ",%lu" : "%lu", (unsigned long)hist->bins[i]);
+    }
+    printf("]}\n");
+}
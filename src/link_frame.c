@@ -0,0 +1,48 @@
+#include "link_frame.h"
+#include "crc32.h"
+
+// --- 라이브러리 함수 구현 ---
+
+uint32_t link_frame_encode(const uint8_t *frame, uint32_t len, uint8_t *out, uint32_t cap) {
+    if (len > LINK_FRAME_MAX_PAYLOAD || cap < len + 4 + 2) return 0;
+
+    uint32_t crc = crc32_update(0, frame, len);
+    uint32_t code_pos = 0, pos = 1;
+    uint8_t code = 1;
+    for (uint32_t i = 0; i < len + 4; ++i) {
+        uint8_t b = i < len ? frame[i] : (uint8_t)(crc >> (8 * (i - len)));
+        if (b == 0) {
+            out[code_pos] = code;
+            code_pos = pos++;
+            code = 1;
+        } else {
+            out[pos++] = b;
+            code++;
+        }
+    }
+    out[code_pos] = code;
+    out[pos++] = LINK_FRAME_DELIMITER;
+    return pos;
+}
+
+uint32_t link_frame_decode(const uint8_t *in, uint32_t len, uint8_t *out, uint32_t cap) {
+    uint32_t i = 0, n = 0;
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1u > len) return 0;
+        for (uint8_t k = 1; k < code; ++k) {
+            if (n == cap) return 0;
+            out[n++] = in[i++];
+        }
+        // 마지막 블록이 아니면 0이 하나 생략되어 있음 (코드 0xFF는 0 없음)
+        if (i < len && code != 0xFF) {
+            if (n == cap) return 0;
+            out[n++] = 0;
+        }
+    }
+    if (n < 4) return 0;
+    n -= 4;
+    uint32_t crc = (uint32_t)out[n] | ((uint32_t)out[n + 1] << 8) | ((uint32_t)out[n + 2] << 16) |
+                   ((uint32_t)out[n + 3] << 24);
+    return crc32_update(0, out, n) == crc ? n : 0;
+}
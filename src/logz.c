@@ -0,0 +1,317 @@
+#include "logz.h"
+#include <string.h> // memcpy, memset 사용
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_LOGZ
+
+#ifdef DEBUG_LOGZ
+#include <stdio.h>
+#endif
+
+#define MIN_MATCH 4
+#define HASH_SIZE (1u << LOGZ_HASH_BITS)
+
+_Static_assert(LOGZ_BLOCK_BYTES <= 0xFFFF, "block offsets are stored as u16");
+
+// --- 내부 함수: 델타 + zigzag 필터 ---
+
+static uint64_t load_le(const uint8_t *p, uint32_t n) {
+    uint64_t v = 0;
+    for (uint32_t i = 0; i < n; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static void store_le(uint8_t *p, uint64_t v, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+// 작은 양/음의 델타를 모두 작은 부호 없는 값으로 (-1 -> 1, 1 -> 2, -2 -> 3, ...)
+static uint64_t zigzag(uint64_t d, uint32_t bits) {
+    uint64_t mask = bits == 64 ? ~0ull : (1ull << bits) - 1;
+    uint64_t sign = (d >> (bits - 1)) & 1;
+    return ((d << 1) ^ (0 - sign)) & mask;
+}
+
+static uint64_t unzigzag(uint64_t z, uint32_t bits) {
+    uint64_t mask = bits == 64 ? ~0ull : (1ull << bits) - 1;
+    return ((z >> 1) ^ (0 - (z & 1))) & mask;
+}
+
+static void delta_encode(const logz_layout_t *layout, const uint8_t *rec, uint8_t *prev, uint8_t *out) {
+    uint32_t off = 0;
+    for (uint32_t f = 0; f < layout->field_count; ++f) {
+        uint32_t n = layout->field_size[f];
+        uint64_t cur = load_le(rec + off, n);
+        uint64_t d = cur - load_le(prev + off, n);
+        store_le(out + off, zigzag(d, n * 8), n);
+        off += n;
+    }
+    memcpy(prev, rec, off);
+}
+
+static void delta_decode(const logz_layout_t *layout, uint8_t *rec, uint8_t *prev) {
+    uint32_t off = 0;
+    for (uint32_t f = 0; f < layout->field_count; ++f) {
+        uint32_t n = layout->field_size[f];
+        uint64_t v = load_le(prev + off, n) + unzigzag(load_le(rec + off, n), n * 8);
+        store_le(rec + off, v, n);
+        off += n;
+    }
+    memcpy(prev, rec, off);
+}
+
+static uint32_t layout_size(const logz_layout_t *layout) {
+    if (layout->field_count == 0 || layout->field_count > LOGZ_MAX_FIELDS) return 0;
+    uint32_t size = 0;
+    for (uint32_t f = 0; f < layout->field_count; ++f) {
+        uint32_t n = layout->field_size[f];
+        if (n != 1 && n != 2 && n != 4 && n != 8) return 0;
+        size += n;
+    }
+    return size <= LOGZ_MAX_RECORD ? size : 0;
+}
+
+// 블록 안 레코드를 바이트 열 단위로 전치 (레코드 i의 바이트 j -> j * count + i).
+// 델타 후 상위 바이트는 대부분 0이라 같은 열끼리 모이면 LZ가 긴 반복으로 잡음
+static void shuffle(const uint8_t *rows, uint8_t *cols, uint32_t size, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t j = 0; j < size; ++j) cols[j * count + i] = rows[i * size + j];
+    }
+}
+
+static void unshuffle(const uint8_t *cols, uint8_t *rows, uint32_t size, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t j = 0; j < size; ++j) rows[i * size + j] = cols[j * count + i];
+    }
+}
+
+// --- 내부 함수: LZ ---
+
+static inline uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - LOGZ_HASH_BITS);
+}
+
+// 15 이상인 길이의 나머지를 255 단위로 기록. 출력 한계를 넘으면 NULL
+static uint8_t *put_length(uint8_t *op, const uint8_t *oend, uint32_t len) {
+    while (len >= 255) {
+        if (op >= oend) return NULL;
+        *op++ = 255;
+        len -= 255;
+    }
+    if (op >= oend) return NULL;
+    *op++ = (uint8_t)len;
+    return op;
+}
+
+// 토큰(상위 4비트 리터럴 길이, 하위 4비트 일치 길이 - 4) + 리터럴 [+ u16 오프셋]
+static uint8_t *put_sequence(uint8_t *op, const uint8_t *oend, const uint8_t *lit, uint32_t lit_len,
+                             uint32_t offset, uint32_t match_len) {
+    if (op >= oend) return NULL;
+    uint8_t *token = op++;
+    uint32_t ml = match_len ? match_len - MIN_MATCH : 0;
+    *token = (uint8_t)(((lit_len < 15 ? lit_len : 15) << 4) | (ml < 15 ? ml : 15));
+
+    if (lit_len >= 15 && !(op = put_length(op, oend, lit_len - 15))) return NULL;
+    if ((uint32_t)(oend - op) < lit_len) return NULL;
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+
+    if (!match_len) return op; // 마지막 시퀀스는 리터럴만
+    if (oend - op < 2) return NULL;
+    *op++ = (uint8_t)offset;
+    *op++ = (uint8_t)(offset >> 8);
+    if (ml >= 15 && !(op = put_length(op, oend, ml - 15))) return NULL;
+    return op;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+uint32_t logz_compress(const uint8_t *in, uint32_t in_len, uint8_t *out, uint16_t *hash) {
+    if (in_len > LOGZ_BLOCK_BYTES) return 0;
+
+    // 블록마다 초기화: 0은 "없음", 위치는 +1 해서 저장
+    memset(hash, 0, HASH_SIZE * sizeof(hash[0]));
+
+    uint8_t *op = out;
+    const uint8_t *oend = out + in_len; // 원본보다 커지면 압축 포기
+    uint32_t anchor = 0;
+    uint32_t ip = 0;
+
+    while (ip + MIN_MATCH <= in_len) {
+        uint32_t seq = read32(in + ip);
+        uint32_t h = hash4(seq);
+        uint32_t cand = hash[h];
+        hash[h] = (uint16_t)(ip + 1);
+
+        if (cand == 0 || read32(in + cand - 1) != seq) {
+            ++ip;
+            continue;
+        }
+        cand -= 1;
+
+        uint32_t len = MIN_MATCH;
+        while (ip + len < in_len && in[cand + len] == in[ip + len]) ++len;
+
+        op = put_sequence(op, oend, in + anchor, ip - anchor, ip - cand, len);
+        if (!op) return 0;
+
+        // 일치 구간 안의 위치도 몇 개 등록해서 다음 탐색 적중률을 높임 (상수 비용)
+        uint32_t end = ip + len;
+        for (uint32_t p = end >= 2 ? end - 2 : 0; p < end && p + MIN_MATCH <= in_len; ++p) {
+            hash[hash4(read32(in + p))] = (uint16_t)(p + 1);
+        }
+        ip = end;
+        anchor = ip;
+    }
+
+    op = put_sequence(op, oend, in + anchor, in_len - anchor, 0, 0);
+    if (!op) return 0;
+    return (uint32_t)(op - out);
+}
+
+bool logz_decompress(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len) {
+    const uint8_t *ip = in, *iend = in + in_len;
+    uint32_t op = 0;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        uint32_t lit = token >> 4;
+        if (lit == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) return false;
+                b = *ip++;
+                lit += b;
+            } while (b == 255);
+        }
+        if ((uint32_t)(iend - ip) < lit || out_len - op < lit) return false;
+        memcpy(out + op, ip, lit);
+        ip += lit;
+        op += lit;
+
+        if (ip == iend) break; // 마지막 시퀀스
+
+        if (iend - ip < 2) return false;
+        uint32_t offset = ip[0] | ((uint32_t)ip[1] << 8);
+        ip += 2;
+        uint32_t len = (token & 0x0F) + MIN_MATCH;
+        if ((token & 0x0F) == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) return false;
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+        }
+        if (offset == 0 || offset > op || out_len - op < len) return false;
+
+        // 겹치는 복사(offset < len)가 있으므로 바이트 단위
+        for (uint32_t i = 0; i < len; ++i, ++op) out[op] = out[op - offset];
+    }
+    return op == out_len;
+}
+
+bool logz_writer_init(logz_writer_t *w, const logz_layout_t *layout, logz_sink_fn sink) {
+    uint32_t size = layout_size(layout);
+    if (!size || !sink) {
+#ifdef DEBUG_LOGZ
+        printf("Error: invalid logz layout.\n");
+#endif
+        return false;
+    }
+
+    memset(w, 0, sizeof(*w));
+    w->layout = *layout;
+    w->record_size = size;
+    w->sink = sink;
+    return true;
+}
+
+bool logz_writer_flush(logz_writer_t *w) {
+    if (w->fill == 0) return true;
+
+    // 전치 결과는 프레임 payload 자리에 두고, 압축 결과는 비워진 block에 받았다가 옮김
+    // (추가 작업 버퍼 없이 고정 메모리 유지)
+    uint8_t *payload = w->frame + LOGZ_FRAME_HEADER;
+    shuffle(w->block, payload, w->record_size, w->fill / w->record_size);
+    uint32_t len = logz_compress(payload, w->fill, w->block, w->hash);
+    uint8_t flags = 0;
+    if (len == 0) {
+        len = w->fill; // 전치만 된 원본 그대로
+        flags |= LOGZ_FLAG_STORED;
+    } else {
+        memcpy(payload, w->block, len);
+    }
+
+    w->frame[0] = LOGZ_FRAME_MAGIC;
+    w->frame[1] = flags;
+    store_le(w->frame + 2, w->fill, 2);
+    store_le(w->frame + 4, len, 2);
+
+    // 다음 블록은 독립적으로 복원되어야 하므로 델타 기준을 0으로
+    w->fill = 0;
+    memset(w->prev, 0, sizeof(w->prev));
+
+    w->stats.frames++;
+    if (flags & LOGZ_FLAG_STORED) w->stats.frames_stored++;
+    if (!w->sink(w->frame, LOGZ_FRAME_HEADER + len)) {
+        w->stats.frames_dropped++;
+        return false;
+    }
+    w->stats.bytes_out += LOGZ_FRAME_HEADER + len;
+    return true;
+}
+
+bool logz_writer_add(logz_writer_t *w, const void *record) {
+    bool ok = true;
+    if (w->fill + w->record_size > LOGZ_BLOCK_BYTES) {
+        ok = logz_writer_flush(w);
+    }
+
+    delta_encode(&w->layout, (const uint8_t *)record, w->prev, w->block + w->fill);
+    w->fill += w->record_size;
+    w->stats.records_in++;
+    w->stats.bytes_in += w->record_size;
+    return ok;
+}
+
+bool logz_decode_frame(const logz_layout_t *layout, const uint8_t *frame, uint32_t avail,
+                       uint8_t *records, uint32_t *records_len, uint32_t *frame_len) {
+    uint32_t size = layout_size(layout);
+    if (!size || avail < LOGZ_FRAME_HEADER || frame[0] != LOGZ_FRAME_MAGIC) return false;
+
+    uint8_t flags = frame[1];
+    uint32_t raw_len = (uint32_t)load_le(frame + 2, 2);
+    uint32_t payload_len = (uint32_t)load_le(frame + 4, 2);
+    if (raw_len == 0 || raw_len > LOGZ_BLOCK_BYTES || raw_len % size != 0 ||
+        payload_len > avail - LOGZ_FRAME_HEADER) {
+        return false;
+    }
+
+    // 복원 결과(전치 상태)를 임시 버퍼에 받았다가 행 순서로 되돌림
+    uint8_t cols[LOGZ_BLOCK_BYTES];
+    const uint8_t *payload = frame + LOGZ_FRAME_HEADER;
+    if (flags & LOGZ_FLAG_STORED) {
+        if (payload_len != raw_len) return false;
+        memcpy(cols, payload, raw_len);
+    } else if (!logz_decompress(payload, payload_len, cols, raw_len)) {
+        return false;
+    }
+    unshuffle(cols, records, size, raw_len / size);
+
+    uint8_t prev[LOGZ_MAX_RECORD] = {0};
+    for (uint32_t off = 0; off < raw_len; off += size) {
+        delta_decode(layout, records + off, prev);
+    }
+
+    *records_len = raw_len;
+    *frame_len = LOGZ_FRAME_HEADER + payload_len;
+    return true;
+}
@@ -0,0 +1,205 @@
+#include "magcal.h"
+#include <math.h>
+#include <string.h>
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_MAGCAL
+
+#ifdef DEBUG_MAGCAL
+#include <stdio.h>
+#endif
+
+#define ONE_Q14 16384
+// 릿지: 파라미터마다 크기 1인 회귀자 샘플 1/1024개만큼의 사전 정보 (Q28에서 2^-10).
+// 관측되는 항에는 영향이 없고, 관측되지 않는 항(회전하지 않은 축, 움직이지 않은 서보)만 사전값에 머뭄
+#define RIDGE 262144.0f
+#define MIN_PIVOT_EXTRA 1e-7f                 // 서보 항은 릿지가 있으므로 수치적 하한만
+
+// 파라미터 배치: [0] m_y^2, [1] m_z^2, [2..4] m_x..m_z, [5] 1,
+//                부하 i마다 [6 + 4i + a] m_a u_i, [6 + 4i + 3] u_i, 그 뒤 u_i u_j (i <= j)
+#define LOAD_BASE(i) (MAGCAL_BASE_PARAMS + 4 * (i))
+
+// --- 내부 함수 ---
+
+static inline int16_t mul_q14(int32_t a, int32_t b) {
+    return (int16_t)((a * b + (1 << 13)) >> 14);
+}
+
+// 원시값 -> 회귀자 (Q14). 범위 밖이면 false
+static bool build_phi(const magcal_t *cal, const int16_t mag[3], const int16_t *load_q15, int16_t *phi, int16_t *y) {
+    int32_t m[3];
+    for (int a = 0; a < 3; ++a) {
+        int32_t v = mag[a];
+        if (v >= (1 << cal->input_shift) || v <= -(1 << cal->input_shift)) return false;
+        m[a] = cal->input_shift <= 14 ? v << (14 - cal->input_shift) : v >> (cal->input_shift - 14);
+    }
+    phi[0] = mul_q14(m[1], m[1]);
+    phi[1] = mul_q14(m[2], m[2]);
+    phi[2] = (int16_t)m[0];
+    phi[3] = (int16_t)m[1];
+    phi[4] = (int16_t)m[2];
+    phi[5] = ONE_Q14;
+    int32_t u[MAGCAL_MAX_LOADS];
+    for (uint8_t i = 0; i < cal->loads; ++i) {
+        u[i] = load_q15[i] >> 1;
+        int16_t *p = &phi[LOAD_BASE(i)];
+        p[0] = mul_q14(m[0], u[i]);
+        p[1] = mul_q14(m[1], u[i]);
+        p[2] = mul_q14(m[2], u[i]);
+        p[3] = (int16_t)u[i];
+    }
+    uint8_t k = LOAD_BASE(cal->loads);
+    for (uint8_t i = 0; i < cal->loads; ++i) {
+        for (uint8_t j = i; j < cal->loads; ++j) phi[k++] = mul_q14(u[i], u[j]);
+    }
+    *y = mul_q14(m[0], m[0]);
+    return true;
+}
+
+// 정규 방정식을 풀어 theta에 씀. 대각이 1이 되도록 정규화해서 항마다 크기가 수십 배 달라도
+// float 정밀도로 충분하게 함. 기본 항 피벗이 작으면 (회전 범위 부족) false
+static bool solve_normal(magcal_t *cal, float *theta) {
+    const uint8_t n = cal->params;
+    float scale[MAGCAL_MAX_PARAMS];
+    uint32_t row[MAGCAL_MAX_PARAMS];
+    for (uint8_t i = 0, r = 0; i < n; r += n - i, ++i) row[i] = r;
+
+    for (uint8_t i = 0; i < n; ++i) scale[i] = 1.0f / sqrtf((float)cal->ata[row[i]] + RIDGE);
+    // 릿지 사전값: 중심이 원점인 구 (m_x^2 = -(-1) m_y^2 - (-1) m_z^2 ...)
+    float *u = cal->work;
+    for (uint8_t i = 0; i < n; ++i) {
+        float prior = i < 2 ? -1.0f : 0.0f;
+        theta[i] = ((float)cal->aty[i] + RIDGE * prior) * scale[i];
+        for (uint8_t j = i; j < n; ++j) {
+            float a = (float)cal->ata[row[i] + (j - i)] + (i == j ? RIDGE : 0.0f);
+            u[row[i] + (j - i)] = a * scale[i] * scale[j];
+        }
+    }
+
+    // 촐레스키 M = U^T U (제자리, 위 삼각 행 우선). row[i] = U_ii의 위치
+    for (uint8_t i = 0; i < n; ++i) {
+        for (uint8_t j = i; j < n; ++j) {
+            float sum = u[row[i] + (j - i)];
+            for (uint8_t m = 0; m < i; ++m) sum -= u[row[m] + (i - m)] * u[row[m] + (j - m)];
+            if (i == j) {
+                if (sum < (i < MAGCAL_BASE_PARAMS ? MAGCAL_MIN_PIVOT : MIN_PIVOT_EXTRA)) {
+#ifdef DEBUG_MAGCAL
+                    printf("magcal: pivot %d = %g, rotation coverage too small\n", i, sum);
+#endif
+                    return false;
+                }
+                u[row[i]] = sqrtf(sum);
+            } else {
+                u[row[i] + (j - i)] = sum / u[row[i]];
+            }
+        }
+    }
+    // U^T v = w, U z = v, theta = scale z
+    for (uint8_t i = 0; i < n; ++i) {
+        for (uint8_t m = 0; m < i; ++m) theta[i] -= u[row[m] + (i - m)] * theta[m];
+        theta[i] /= u[row[i]];
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        for (uint8_t j = (uint8_t)(i + 1); j < n; ++j) theta[i] -= u[row[i] + (j - i)] * theta[j];
+        theta[i] /= u[row[i]];
+    }
+    for (uint8_t i = 0; i < n; ++i) theta[i] *= scale[i];
+    return true;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool magcal_init(magcal_t *cal, uint8_t input_shift, uint8_t loads) {
+    if (input_shift < 7 || input_shift > 15 || loads > MAGCAL_MAX_LOADS) return false;
+    memset(cal, 0, sizeof(*cal));
+    cal->input_shift = input_shift;
+    cal->loads = loads;
+    cal->params = (uint8_t)(LOAD_BASE(loads) + loads * (loads + 1) / 2);
+    return true;
+}
+
+bool magcal_update(magcal_t *cal, const int16_t mag[3], const int16_t *load_q15) {
+    int16_t phi[MAGCAL_MAX_PARAMS], y;
+    if (!build_phi(cal, mag, load_q15, phi, &y)) {
+        ++cal->skipped;
+        return false;
+    }
+    const uint8_t n = cal->params;
+
+    // 지수 망각: 블록마다 (1 - 2^-(FORGET - BLOCK))배
+    if ((cal->samples & ((1u << MAGCAL_FORGET_BLOCK_LOG2) - 1u)) == 0 && cal->samples > 0) {
+        const int s = MAGCAL_FORGET_SHIFT - MAGCAL_FORGET_BLOCK_LOG2;
+        for (uint32_t k = 0; k < MAGCAL_PACKED(n); ++k) cal->ata[k] -= cal->ata[k] >> s;
+        for (uint8_t i = 0; i < n; ++i) cal->aty[i] -= cal->aty[i] >> s;
+    }
+
+    // 위 삼각 누적 (곱은 모두 16 x 16 -> 32비트)
+    int64_t *p = cal->ata;
+    for (uint8_t i = 0; i < n; ++i) {
+        int32_t pi = phi[i];
+        for (uint8_t j = i; j < n; ++j) *p++ += pi * phi[j];
+        cal->aty[i] += pi * y;
+    }
+    ++cal->samples;
+
+    if (++cal->since_solve < MAGCAL_SOLVE_INTERVAL || cal->samples < MAGCAL_MIN_SAMPLES) return false;
+    cal->since_solve = 0;
+    return magcal_solve(cal);
+}
+
+bool magcal_solve(magcal_t *cal) {
+    float theta[MAGCAL_MAX_PARAMS];
+    ++cal->solves;
+    if (!solve_normal(cal, theta)) {
+        ++cal->rejects;
+        return false;
+    }
+
+    // theta -> 물리 파라미터 (정규화 단위: 원시값 / 2^input_shift)
+    float r[3] = { 1.0f, -theta[0], -theta[1] }, c[3], r2 = theta[5];
+    for (int a = 0; a < 3; ++a) {
+        if (r[a] < MAGCAL_MIN_GAIN_RATIO * MAGCAL_MIN_GAIN_RATIO || r[a] > MAGCAL_MAX_GAIN_RATIO * MAGCAL_MAX_GAIN_RATIO) {
+            ++cal->rejects;
+            return false;
+        }
+        c[a] = theta[2 + a] / (2.0f * r[a]);
+        r2 += r[a] * c[a] * c[a];
+    }
+    if (r2 <= 0.0f || r2 >= 1.0f) {
+        ++cal->rejects;
+        return false;
+    }
+
+    const float lsb_q8 = (float)(1u << cal->input_shift) * 256.0f;
+    magcal_solution_t sol;
+    memset(&sol, 0, sizeof(sol));
+    for (int a = 0; a < 3; ++a) {
+        sol.center_q8[a] = (int32_t)lroundf(c[a] * lsb_q8);
+        sol.gain_q14[a] = (int32_t)lroundf(sqrtf(r[a]) * ONE_Q14);
+        for (uint8_t i = 0; i < cal->loads; ++i) {
+            sol.load_q8[i][a] = (int32_t)lroundf(theta[LOAD_BASE(i) + a] / (2.0f * r[a]) * lsb_q8);
+        }
+    }
+    sol.radius = (uint16_t)lroundf(sqrtf(r2) * (float)(1u << cal->input_shift));
+    sol.valid = true;
+    cal->sol = sol;
+
+#ifdef DEBUG_MAGCAL
+    printf("magcal: center %.1f %.1f %.1f gain %.3f %.3f %.3f radius %u\n", sol.center_q8[0] / 256.0f, sol.center_q8[1] / 256.0f, sol.center_q8[2] / 256.0f,
+           sol.gain_q14[0] / 16384.0f, sol.gain_q14[1] / 16384.0f, sol.gain_q14[2] / 16384.0f, sol.radius);
+#endif
+    return true;
+}
+
+void magcal_apply(const magcal_t *cal, const int16_t mag[3], const int16_t *load_q15, int16_t out[3]) {
+    if (!cal->sol.valid) {
+        for (int a = 0; a < 3; ++a) out[a] = mag[a];
+        return;
+    }
+    for (int a = 0; a < 3; ++a) {
+        int64_t off = cal->sol.center_q8[a];
+        for (uint8_t i = 0; i < cal->loads; ++i) off += ((int64_t)cal->sol.load_q8[i][a] * load_q15[i]) >> 15;
+        int64_t v = ((((int64_t)mag[a] << 8) - off) * cal->sol.gain_q14[a] + (1 << 21)) >> 22;
+        out[a] = (int16_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+    }
+}
@@ -0,0 +1,22 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "app_tasks.h"
+
+int main()
+{
+    stdio_init_all();
+
+    if (!app_tasks_create()) {
+        printf("Error: failed to create application tasks.\n");
+        while (true) {
+            sleep_ms(1000);
+        }
+    }
+
+    vTaskStartScheduler(); // 반환되지 않음
+
+    while (true) {
+    }
+}
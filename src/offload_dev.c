@@ -0,0 +1,259 @@
+#include "offload_dev.h"
+#include "crc32.h"
+#include <stddef.h>
+#include <string.h> // memcpy, memset 사용
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_OFFLOAD
+
+#ifdef DEBUG_OFFLOAD
+#include <stdio.h>
+#endif
+
+#define FRAME_BYTES (sizeof(offload_frame_header_t) + OFFLOAD_FRAME_DATA)
+
+typedef enum {
+    BUF_FREE,
+    BUF_FILLING,   // 소스 읽기 진행 중
+    BUF_READY,     // 헤더까지 완성, 송신 대기/진행 중
+} buf_state_t;
+
+typedef struct {
+    uint8_t data[FRAME_BYTES] __attribute__((aligned(4)));
+    uint32_t len;      // 헤더 포함
+    uint32_t sent;
+    uint32_t gen;      // 이 버퍼를 채운 스트림 (중단된 스트림의 읽기 결과는 버림)
+    buf_state_t state;
+} frame_buf_t;
+
+static const offload_source_ops_t *src;
+static const offload_transport_t *xport;
+
+// 프레임 이중 버퍼: 하나는 송신, 하나는 소스에서 채우기
+static frame_buf_t bufs[2];
+static int reading_buf = -1;          // read_start가 진행 중인 버퍼
+
+static uint8_t req_buf[sizeof(offload_request_t)];
+static uint32_t req_fill;
+
+static offload_response_t rsp;
+static uint32_t rsp_sent = sizeof(rsp); // == sizeof(rsp) 이면 보낼 응답 없음
+
+// 현재 스트림
+static bool streaming;
+static uint32_t gen;
+static uint8_t stream_source;
+static uint32_t read_pos, read_end;
+static uint32_t fill_seq, send_seq;   // 버퍼 = seq % 2 (채운 순서대로 송신)
+static bool end_queued;
+
+static offload_dev_stats_t stats;
+
+// --- 내부 함수 ---
+
+static offload_frame_header_t *frame_header(frame_buf_t *b) {
+    return (offload_frame_header_t *)b->data;
+}
+
+static void queue_response(uint8_t cmd, uint8_t status, uint32_t size, uint32_t length) {
+    rsp = (offload_response_t){
+        .magic = OFFLOAD_RESPONSE_MAGIC, .cmd = cmd, .status = status, .size = size, .length = length,
+    };
+    rsp_sent = 0;
+}
+
+static void stop_stream(void) {
+    streaming = false;
+    gen++;
+    for (int i = 0; i < 2; ++i) {
+        if (bufs[i].state == BUF_READY) bufs[i].state = BUF_FREE; // FILLING은 읽기 완료 후 해제
+    }
+}
+
+static void handle_request(void) {
+    offload_request_t req;
+    memcpy(&req, req_buf, sizeof(req));
+    stats.requests++;
+
+    if (req.magic != OFFLOAD_REQUEST_MAGIC) {
+        // 동기 어긋남: 한 바이트씩 밀면서 magic을 다시 찾음 (응답 없음)
+        stats.bad_requests++;
+        memmove(req_buf, req_buf + 1, sizeof(req_buf) - 1);
+        req_fill = sizeof(req_buf) - 1;
+        return;
+    }
+    if (streaming) {
+        stats.aborts++;
+        stop_stream();
+    }
+
+    uint32_t size = 0;
+    switch (req.cmd) {
+        case OFFLOAD_CMD_INFO:
+            if (!src->size(req.source, &size)) {
+                queue_response(req.cmd, OFFLOAD_ERR_SOURCE, 0, 0);
+            } else {
+                queue_response(req.cmd, OFFLOAD_OK, size, 0);
+            }
+            break;
+
+        case OFFLOAD_CMD_READ: {
+            if (!src->size(req.source, &size)) {
+                queue_response(req.cmd, OFFLOAD_ERR_SOURCE, 0, 0);
+                break;
+            }
+            uint32_t length = req.length ? req.length : size - (req.offset < size ? req.offset : size);
+            if (req.offset > size || length > size - req.offset) {
+                queue_response(req.cmd, OFFLOAD_ERR_RANGE, size, 0);
+                break;
+            }
+            queue_response(req.cmd, OFFLOAD_OK, size, length);
+            streaming = true;
+            stream_source = req.source;
+            read_pos = req.offset;
+            read_end = req.offset + length;
+            fill_seq = send_seq = 0;
+            end_queued = false;
+            break;
+        }
+
+        case OFFLOAD_CMD_ABORT:
+            queue_response(req.cmd, OFFLOAD_OK, 0, 0);
+            break;
+
+        default:
+            stats.bad_requests++;
+            queue_response(req.cmd, OFFLOAD_ERR_BAD_REQUEST, 0, 0);
+            break;
+    }
+}
+
+// 끝 프레임 (데이터 없음, 스트림 결과 status)
+static void queue_end_frame(frame_buf_t *b, uint8_t status) {
+    offload_frame_header_t *h = frame_header(b);
+    *h = (offload_frame_header_t){
+        .magic = OFFLOAD_FRAME_MAGIC, .offset = read_pos, .length = 0, .status = status, .crc = 0, // 빈 데이터의 CRC
+    };
+    b->len = sizeof(*h);
+    b->sent = 0;
+    b->gen = gen;
+    b->state = BUF_READY;
+    fill_seq++;
+    end_queued = true;
+}
+
+static void advance_reads(void) {
+    // 진행 중인 읽기 완료 확인
+    if (reading_buf >= 0) {
+        int r = src->read_poll();
+        if (r == 0) return;
+
+        frame_buf_t *b = &bufs[reading_buf];
+        reading_buf = -1;
+        if (b->gen != gen || !streaming) {
+            b->state = BUF_FREE; // 중단된 스트림
+        } else if (r < 0) {
+            stats.read_errors++;
+            read_end = read_pos; // 더 읽지 않음
+            queue_end_frame(b, OFFLOAD_ERR_IO);
+        } else {
+            offload_frame_header_t *h = frame_header(b);
+            uint32_t n = b->len - sizeof(*h);
+            h->magic = OFFLOAD_FRAME_MAGIC;
+            h->offset = read_pos;
+            h->length = (uint16_t)n;
+            h->status = OFFLOAD_OK;
+            h->reserved = 0;
+            h->crc = crc32_update(0, b->data + sizeof(*h), n);
+            b->sent = 0;
+            b->state = BUF_READY;
+            read_pos += n;
+            fill_seq++;
+        }
+    }
+
+    if (!streaming || end_queued) return;
+    frame_buf_t *b = &bufs[fill_seq % 2];
+    if (b->state != BUF_FREE) return; // 송신 중인 버퍼가 비워지길 기다림
+
+    if (read_pos >= read_end) {
+        queue_end_frame(b, OFFLOAD_OK);
+        return;
+    }
+
+    uint32_t n = read_end - read_pos;
+    if (n > OFFLOAD_FRAME_DATA) n = OFFLOAD_FRAME_DATA;
+    b->len = sizeof(offload_frame_header_t) + n;
+    b->gen = gen;
+    b->state = BUF_FILLING;
+    if (!src->read_start(stream_source, read_pos, b->data + sizeof(offload_frame_header_t), n)) {
+        stats.read_errors++;
+        read_end = read_pos;
+        queue_end_frame(b, OFFLOAD_ERR_IO);
+        return;
+    }
+    reading_buf = (int)(b - bufs);
+}
+
+static void advance_send(void) {
+    if (!streaming) return;
+    frame_buf_t *b = &bufs[send_seq % 2];
+    if (b->state != BUF_READY) return;
+
+    b->sent += xport->tx(b->data + b->sent, b->len - b->sent);
+    if (b->sent < b->len) return;
+
+    xport->tx_flush();
+    uint32_t n = b->len - sizeof(offload_frame_header_t);
+    b->state = BUF_FREE;
+    send_seq++;
+    if (n == 0) {
+        streaming = false; // 끝 프레임까지 보냄
+        return;
+    }
+    stats.frames_sent++;
+    stats.bytes_sent += n;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void offload_dev_init(const offload_source_ops_t *source, const offload_transport_t *transport) {
+    src = source;
+    xport = transport;
+    memset(bufs, 0, sizeof(bufs));
+    reading_buf = -1;
+    req_fill = 0;
+    rsp_sent = sizeof(rsp);
+    streaming = false;
+    gen = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+void offload_dev_poll(void) {
+    // 1. 요청 수신 (스트림 중에도 받아서 중단/새 요청 처리)
+    req_fill += xport->rx(req_buf + req_fill, sizeof(req_buf) - req_fill);
+    if (req_fill == sizeof(req_buf)) {
+        req_fill = 0;
+        handle_request(); // magic이 틀리면 req_fill을 다시 설정
+    }
+
+    // 2. 응답 헤더가 프레임보다 먼저
+    if (rsp_sent < sizeof(rsp)) {
+        rsp_sent += xport->tx((const uint8_t *)&rsp + rsp_sent, sizeof(rsp) - rsp_sent);
+        if (rsp_sent < sizeof(rsp)) return;
+        xport->tx_flush();
+    }
+
+    // 3. 다음 프레임 읽기 + 4. 준비된 프레임 송신 (둘이 겹쳐서 진행)
+    advance_reads();
+    advance_send();
+    advance_reads(); // 방금 비운 버퍼에 바로 다음 읽기 시작
+}
+
+bool offload_dev_busy(void) {
+    return streaming;
+}
+
+void offload_dev_get_stats(offload_dev_stats_t *out) {
+    *out = stats;
+}
@@ -0,0 +1,221 @@
+#include "params.h"
+#include "crc32.h"
+#include <stdatomic.h>
+#include <string.h> // memcpy, memset 사용
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_PARAMS
+
+#ifdef DEBUG_PARAMS
+#include <stdio.h>
+#endif
+
+#define PARAMS_STORE_MAGIC 0x50524D53u // "PRMS"
+#define PARAMS_STORE_VERSION 1
+#define BANK_NONE 0xFFu
+
+// --- 파라미터 메타데이터 (플래시에 상주) ---
+static const param_info_t param_table[PARAM_COUNT] = {
+#define PARAM_INFO_ENTRY(sym, hash_, name_, type_, field, def_, min_, max_) \
+    [sym] = { .hash = hash_, .name = name_, .type = type_,                  \
+              .def = { .field = def_ }, .min = { .field = min_ }, .max = { .field = max_ } },
+    PARAM_TABLE(PARAM_INFO_ENTRY)
+#undef PARAM_INFO_ENTRY
+};
+
+// --- 저장 레코드 형식 ---
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+} store_header_t;
+
+typedef struct {
+    uint32_t hash;
+    param_value_t value;
+} store_entry_t;
+
+_Static_assert(sizeof(store_header_t) + PARAM_COUNT * sizeof(store_entry_t) + sizeof(uint32_t) <= PARAMS_STORE_BYTES,
+               "parameter table does not fit in PARAMS_STORE_BYTES");
+_Static_assert(sizeof(store_header_t) % _Alignof(store_entry_t) == 0, "store entries must stay word aligned");
+
+// --- 이중 뱅크 상태 ---
+static param_value_t banks[2][PARAM_COUNT];
+static _Atomic uint8_t active_bank;     // 쓰기 쪽만 변경
+static _Atomic uint8_t reader_bank;     // 읽기 쪽만 변경 (BANK_NONE = 스냅샷 없음)
+static int8_t staging_bank = -1;        // 갱신 중인 뱅크 (쓰기 쪽 전용)
+
+// --- 내부 함수 ---
+
+static bool value_in_range(const param_info_t *info, param_value_t v) {
+    switch (info->type) {
+    case PARAM_TYPE_U32: return v.u32 >= info->min.u32 && v.u32 <= info->max.u32;
+    case PARAM_TYPE_I32: return v.i32 >= info->min.i32 && v.i32 <= info->max.i32;
+    case PARAM_TYPE_F32: return v.f32 >= info->min.f32 && v.f32 <= info->max.f32; // NaN 거부
+    default:             return false;
+    }
+}
+
+// --- 라이브러리 함수 구현 ---
+
+uint32_t params_hash(const char *name) {
+    uint32_t h = 0x811C9DC5u;
+    while (*name) {
+        h ^= (uint8_t)*name++;
+        h *= 0x01000193u;
+    }
+    return h;
+}
+
+bool params_init(void) {
+    for (int i = 0; i < PARAM_COUNT; ++i) {
+        if (params_hash(param_table[i].name) != param_table[i].hash ||
+            (i > 0 && param_table[i - 1].hash >= param_table[i].hash)) {
+#ifdef DEBUG_PARAMS
+            printf("Error: param table entry %d (%s) has wrong hash or order.\n", i, param_table[i].name);
+#endif
+            return false;
+        }
+    }
+
+    for (int i = 0; i < PARAM_COUNT; ++i) {
+        banks[0][i] = param_table[i].def;
+        banks[1][i] = param_table[i].def;
+    }
+    atomic_store(&active_bank, 0);
+    atomic_store(&reader_bank, BANK_NONE);
+    staging_bank = -1;
+
+    params_load(); // 저장값이 없으면 기본값 유지
+    return true;
+}
+
+int params_find(uint32_t hash) {
+    int lo = 0, hi = PARAM_COUNT - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        uint32_t h = param_table[mid].hash;
+        if (h == hash) return mid;
+        if (h < hash) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+const param_info_t *params_info(param_id_t id) {
+    return (unsigned)id < PARAM_COUNT ? &param_table[id] : NULL;
+}
+
+const param_value_t *params_acquire(void) {
+    // 사용할 뱅크를 먼저 공개한 뒤 여전히 활성인지 확인 (seq_cst: 쓰기 쪽의
+    // "reader_bank 확인"과 서로 엇갈려 같은 뱅크를 동시에 쓰고 읽는 일이 없음)
+    while (true) {
+        uint8_t b = atomic_load(&active_bank);
+        atomic_store(&reader_bank, b);
+        if (atomic_load(&active_bank) == b) {
+            return banks[b];
+        }
+    }
+}
+
+void params_release(void) {
+    atomic_store_explicit(&reader_bank, BANK_NONE, memory_order_release);
+}
+
+param_value_t params_get(param_id_t id) {
+    uint8_t b = atomic_load_explicit(&active_bank, memory_order_acquire);
+    return banks[b][(unsigned)id < PARAM_COUNT ? id : 0];
+}
+
+bool params_update_begin(void) {
+    uint8_t active = atomic_load_explicit(&active_bank, memory_order_relaxed);
+    uint8_t target = active ^ 1u;
+
+    if (atomic_load(&reader_bank) == target) {
+        return false; // 읽기 쪽이 아직 이전 스냅샷 사용 중
+    }
+
+    memcpy(banks[target], banks[active], sizeof(banks[target]));
+    staging_bank = (int8_t)target;
+    return true;
+}
+
+bool params_update_stage(param_id_t id, param_value_t value) {
+    if (staging_bank < 0 || (unsigned)id >= PARAM_COUNT) return false;
+    if (!value_in_range(&param_table[id], value)) {
+#ifdef DEBUG_PARAMS
+        printf("Error: value for %s out of range.\n", param_table[id].name);
+#endif
+        return false;
+    }
+    banks[staging_bank][id] = value;
+    return true;
+}
+
+void params_update_commit(void) {
+    if (staging_bank < 0) return;
+    atomic_store(&active_bank, (uint8_t)staging_bank); // 이 시점부터 읽기 쪽에 보임
+    staging_bank = -1;
+}
+
+bool params_set(param_id_t id, param_value_t value) {
+    if ((unsigned)id >= PARAM_COUNT || !value_in_range(&param_table[id], value)) return false;
+    if (!params_update_begin()) return false;
+    params_update_stage(id, value);
+    params_update_commit();
+    return true;
+}
+
+bool params_set_by_hash(uint32_t hash, param_value_t value) {
+    int id = params_find(hash);
+    if (id < 0) return false;
+    return params_set((param_id_t)id, value);
+}
+
+bool params_save(void) {
+    static uint8_t record[PARAMS_STORE_BYTES] __attribute__((aligned(4))); // store_entry_t로 접근 (M0+ 비정렬 접근 불가)
+    memset(record, 0xFF, sizeof(record)); // 지워진 플래시와 같은 값으로 채움
+
+    store_header_t header = { PARAMS_STORE_MAGIC, PARAMS_STORE_VERSION, PARAM_COUNT };
+    memcpy(record, &header, sizeof(header));
+
+    uint8_t b = atomic_load_explicit(&active_bank, memory_order_relaxed);
+    store_entry_t *entries = (store_entry_t *)(record + sizeof(header));
+    for (int i = 0; i < PARAM_COUNT; ++i) {
+        entries[i].hash = param_table[i].hash;
+        entries[i].value = banks[b][i];
+    }
+
+    uint32_t body_len = sizeof(header) + PARAM_COUNT * sizeof(store_entry_t);
+    uint32_t crc = crc32_update(0, record, body_len);
+    memcpy(record + body_len, &crc, sizeof(crc));
+
+    return params_storage_write(record, sizeof(record));
+}
+
+bool params_load(void) {
+    static uint8_t record[PARAMS_STORE_BYTES] __attribute__((aligned(4)));
+    if (!params_storage_read(record, sizeof(record))) return false;
+
+    store_header_t header;
+    memcpy(&header, record, sizeof(header));
+    if (header.magic != PARAMS_STORE_MAGIC || header.version != PARAMS_STORE_VERSION) return false;
+
+    uint32_t body_len = sizeof(header) + header.count * sizeof(store_entry_t);
+    if (body_len + sizeof(uint32_t) > PARAMS_STORE_BYTES) return false;
+
+    uint32_t crc;
+    memcpy(&crc, record + body_len, sizeof(crc));
+    if (crc32_update(0, record, body_len) != crc) return false;
+
+    if (!params_update_begin()) return false;
+    const store_entry_t *entries = (const store_entry_t *)(record + sizeof(header));
+    for (uint16_t i = 0; i < header.count; ++i) {
+        int id = params_find(entries[i].hash);
+        if (id >= 0) {
+            params_update_stage((param_id_t)id, entries[i].value); // 범위를 벗어난 값은 무시
+        }
+    }
+    params_update_commit();
+    return true;
+}
@@ -0,0 +1,35 @@
+#include "params.h"
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include <string.h> // memcpy 사용
+
+// 파라미터 저장 영역: 플래시 끝에서 두 번째 섹터 (마지막 섹터는 측정용 부하가 사용)
+#define PARAMS_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - 2 * FLASH_SECTOR_SIZE)
+#define PARAMS_FLASH_TIMEOUT_MS 100
+
+_Static_assert(PARAMS_STORE_BYTES % FLASH_PAGE_SIZE == 0, "record must be a whole number of flash pages");
+
+typedef struct {
+    const void *buf;
+    uint32_t len;
+} flash_write_req_t;
+
+static void flash_write_op(void *param) {
+    const flash_write_req_t *req = (const flash_write_req_t *)param;
+    flash_range_erase(PARAMS_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(PARAMS_FLASH_OFFSET, (const uint8_t *)req->buf, req->len);
+}
+
+bool params_storage_read(void *buf, uint32_t len) {
+    if (len > FLASH_SECTOR_SIZE) return false;
+    memcpy(buf, (const void *)(XIP_BASE + PARAMS_FLASH_OFFSET), len);
+    return true;
+}
+
+bool params_storage_write(const void *buf, uint32_t len) {
+    if (len > FLASH_SECTOR_SIZE || len % FLASH_PAGE_SIZE != 0) return false;
+    // 다른 코어를 lockout 한 상태에서 실행 (SDK multicore lockout 또는 FreeRTOS SMP)
+    flash_write_req_t req = { buf, len };
+    return flash_safe_execute(flash_write_op, &req, PARAMS_FLASH_TIMEOUT_MS) == PICO_OK;
+}
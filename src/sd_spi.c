@@ -0,0 +1,322 @@
+#include "sd_block.h"
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_SD
+
+#ifdef DEBUG_SD
+#include <stdio.h>
+#endif
+
+// --- SD 명령 / 토큰 ---
+#define CMD0   0   // GO_IDLE_STATE
+#define CMD8   8   // SEND_IF_COND
+#define CMD9   9   // SEND_CSD
+#define CMD12  12  // STOP_TRANSMISSION
+#define CMD16  16  // SET_BLOCKLEN
+#define CMD17  17  // READ_SINGLE_BLOCK
+#define CMD24  24  // WRITE_BLOCK
+#define CMD25  25  // WRITE_MULTIPLE_BLOCK
+#define CMD55  55  // APP_CMD
+#define CMD58  58  // READ_OCR
+#define ACMD41 41  // SD_SEND_OP_COND
+
+#define TOKEN_START_BLOCK 0xFE
+#define TOKEN_START_MULTI 0xFC
+#define TOKEN_STOP_MULTI  0xFD
+#define DATA_RESP_MASK    0x1F
+#define DATA_RESP_OK      0x05
+
+#define SD_INIT_TIMEOUT_US  1000000
+#define SD_READ_TIMEOUT_US  200000
+#define SD_WRITE_TIMEOUT_US 500000
+
+// --- 내부 상태 ---
+typedef enum {
+    STREAM_IDLE = 0,   // 연속 쓰기 없음
+    STREAM_READY,      // 다음 블록 가능 (카드 busy 일 수 있음)
+    STREAM_SENDING,    // DMA로 데이터 전송 중
+} stream_state_t;
+
+static bool card_block_addressing = false; // SDHC/SDXC: 블록 주소, SDSC: 바이트 주소
+static uint32_t card_blocks = 0;
+static int dma_tx = -1;
+static int dma_rx = -1;
+static stream_state_t stream_state = STREAM_IDLE;
+static uint8_t dma_rx_sink;
+
+// --- SPI 저수준 ---
+
+static inline void cs_select(void) {
+    gpio_put(SD_SPI_CS_GPIO, 0);
+}
+
+static inline void cs_deselect(void) {
+    gpio_put(SD_SPI_CS_GPIO, 1);
+    uint8_t ff = 0xFF;
+    spi_write_blocking(SD_SPI_PORT, &ff, 1); // CS 해제 후 MISO 해제용 클럭
+}
+
+static inline uint8_t spi_xfer(uint8_t out) {
+    uint8_t in;
+    spi_write_read_blocking(SD_SPI_PORT, &out, &in, 1);
+    return in;
+}
+
+static bool wait_ready(uint32_t timeout_us) {
+    absolute_time_t deadline = make_timeout_time_us(timeout_us);
+    while (spi_xfer(0xFF) != 0xFF) {
+        if (time_reached(deadline)) return false;
+    }
+    return true;
+}
+
+// 명령 전송 후 R1 응답 반환 (0xFF = 응답 없음). CS는 선택된 상태로 남음
+static uint8_t send_cmd(uint8_t cmd, uint32_t arg) {
+    if (cmd & 0x80) { // ACMD
+        cmd &= 0x7F;
+        uint8_t r = send_cmd(CMD55, 0);
+        if (r > 1) return r;
+    }
+
+    cs_deselect();
+    cs_select();
+    if (cmd != CMD0 && !wait_ready(SD_READ_TIMEOUT_US)) return 0xFF;
+
+    uint8_t frame[6] = {
+        (uint8_t)(0x40 | cmd), (uint8_t)(arg >> 24), (uint8_t)(arg >> 16), (uint8_t)(arg >> 8), (uint8_t)arg,
+        cmd == CMD0 ? 0x95 : cmd == CMD8 ? 0x87 : 0x01, // SPI 모드에서는 CMD0/CMD8만 CRC 검사
+    };
+    spi_write_blocking(SD_SPI_PORT, frame, sizeof(frame));
+    if (cmd == CMD12) spi_xfer(0xFF); // stuff byte
+
+    uint8_t r1 = 0xFF;
+    for (int i = 0; i < 10 && (r1 & 0x80); ++i) {
+        r1 = spi_xfer(0xFF);
+    }
+    return r1;
+}
+
+static bool read_data(uint8_t *buf, uint32_t len) {
+    absolute_time_t deadline = make_timeout_time_us(SD_READ_TIMEOUT_US);
+    uint8_t token;
+    while ((token = spi_xfer(0xFF)) == 0xFF) {
+        if (time_reached(deadline)) return false;
+    }
+    if (token != TOKEN_START_BLOCK) return false;
+
+    spi_read_blocking(SD_SPI_PORT, 0xFF, buf, len);
+    spi_xfer(0xFF); // CRC (무시)
+    spi_xfer(0xFF);
+    return true;
+}
+
+static uint32_t block_arg(uint32_t lba) {
+    return card_block_addressing ? lba : lba * SD_BLOCK_SIZE;
+}
+
+// CSD 레지스터에서 블록 수 계산
+static uint32_t parse_csd_blocks(const uint8_t *csd) {
+    if ((csd[0] >> 6) == 1) { // CSD v2.0 (SDHC/SDXC)
+        uint32_t c_size = ((uint32_t)(csd[7] & 0x3F) << 16) | ((uint32_t)csd[8] << 8) | csd[9];
+        return (c_size + 1) * 1024u;
+    }
+    // CSD v1.0 (SDSC)
+    uint32_t read_bl_len = csd[5] & 0x0F;
+    uint32_t c_size = ((uint32_t)(csd[6] & 0x03) << 10) | ((uint32_t)csd[7] << 2) | (csd[8] >> 6);
+    uint32_t c_size_mult = ((csd[9] & 0x03) << 1) | (csd[10] >> 7);
+    uint64_t bytes = (uint64_t)(c_size + 1) << (c_size_mult + 2 + read_bl_len);
+    return (uint32_t)(bytes / SD_BLOCK_SIZE);
+}
+
+// 이전 데이터 블록의 CRC 전송 + 데이터 응답 확인
+static bool finish_block(void) {
+    uint8_t crc[2] = { 0xFF, 0xFF };
+    spi_write_blocking(SD_SPI_PORT, crc, 2);
+    uint8_t resp = spi_xfer(0xFF);
+    return (resp & DATA_RESP_MASK) == DATA_RESP_OK;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool sd_block_init(void) {
+    spi_init(SD_SPI_PORT, SD_SPI_INIT_BAUD_HZ);
+    gpio_set_function(SD_SPI_SCK_GPIO, GPIO_FUNC_SPI);
+    gpio_set_function(SD_SPI_MOSI_GPIO, GPIO_FUNC_SPI);
+    gpio_set_function(SD_SPI_MISO_GPIO, GPIO_FUNC_SPI);
+    gpio_pull_up(SD_SPI_MISO_GPIO);
+    gpio_init(SD_SPI_CS_GPIO);
+    gpio_set_dir(SD_SPI_CS_GPIO, GPIO_OUT);
+    gpio_put(SD_SPI_CS_GPIO, 1);
+
+    // CS 해제 상태에서 74 클럭 이상
+    for (int i = 0; i < 10; ++i) spi_xfer(0xFF);
+
+    bool ok = false;
+    if (send_cmd(CMD0, 0) == 0x01) {
+        bool v2 = false;
+        if (send_cmd(CMD8, 0x1AA) == 0x01) {
+            uint8_t r7[4];
+            spi_read_blocking(SD_SPI_PORT, 0xFF, r7, 4);
+            if (r7[2] != 0x01 || r7[3] != 0xAA) goto done; // 전압 범위 불일치
+            v2 = true;
+        }
+
+        absolute_time_t deadline = make_timeout_time_us(SD_INIT_TIMEOUT_US);
+        uint8_t r1;
+        while ((r1 = send_cmd(0x80 | ACMD41, v2 ? 0x40000000u : 0)) != 0) {
+            if (r1 > 1 || time_reached(deadline)) goto done;
+        }
+
+        card_block_addressing = false;
+        if (v2 && send_cmd(CMD58, 0) == 0) {
+            uint8_t ocr[4];
+            spi_read_blocking(SD_SPI_PORT, 0xFF, ocr, 4);
+            card_block_addressing = (ocr[0] & 0x40) != 0; // CCS
+        }
+        if (!card_block_addressing && send_cmd(CMD16, SD_BLOCK_SIZE) != 0) goto done;
+
+        uint8_t csd[16];
+        if (send_cmd(CMD9, 0) != 0 || !read_data(csd, sizeof(csd))) goto done;
+        card_blocks = parse_csd_blocks(csd);
+        ok = card_blocks > 0;
+    }
+
+done:
+    cs_deselect();
+    if (!ok) {
+#ifdef DEBUG_SD
+        printf("Error: SD card initialization failed.\n");
+#endif
+        return false;
+    }
+
+    spi_set_baudrate(SD_SPI_PORT, SD_SPI_BAUD_HZ);
+
+    if (dma_tx < 0) {
+        dma_tx = dma_claim_unused_channel(true);
+        dma_rx = dma_claim_unused_channel(true);
+    }
+    stream_state = STREAM_IDLE;
+
+#ifdef DEBUG_SD
+    printf("SD card ready: %lu blocks, %s addressing.\n", (unsigned long)card_blocks,
+           card_block_addressing ? "block" : "byte");
+#endif
+    return true;
+}
+
+uint32_t sd_block_count(void) {
+    return card_blocks;
+}
+
+bool sd_block_read(uint32_t lba, uint8_t *buf, uint32_t count) {
+    if (stream_state != STREAM_IDLE) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        bool ok = send_cmd(CMD17, block_arg(lba + i)) == 0 && read_data(buf + i * SD_BLOCK_SIZE, SD_BLOCK_SIZE);
+        if (!ok) {
+            cs_deselect();
+            return false;
+        }
+    }
+    cs_deselect();
+    return true;
+}
+
+bool sd_block_write(uint32_t lba, const uint8_t *buf, uint32_t count) {
+    if (stream_state != STREAM_IDLE || count == 0) return false;
+
+    if (count == 1) {
+        if (send_cmd(CMD24, block_arg(lba)) != 0) {
+            cs_deselect();
+            return false;
+        }
+        spi_xfer(TOKEN_START_BLOCK);
+        spi_write_blocking(SD_SPI_PORT, buf, SD_BLOCK_SIZE);
+        bool ok = finish_block() && wait_ready(SD_WRITE_TIMEOUT_US);
+        cs_deselect();
+        return ok;
+    }
+
+    if (!sd_stream_begin(lba)) return false;
+    bool ok = true;
+    for (uint32_t i = 0; i < count && ok; ++i) {
+        sd_status_t st;
+        while ((st = sd_stream_write(buf + i * SD_BLOCK_SIZE)) == SD_BUSY) {
+        }
+        ok = st == SD_OK;
+    }
+    return sd_stream_end() && ok;
+}
+
+bool sd_stream_begin(uint32_t lba) {
+    if (stream_state != STREAM_IDLE) return false;
+    if (send_cmd(CMD25, block_arg(lba)) != 0) {
+        cs_deselect();
+        return false;
+    }
+    spi_xfer(0xFF); // 명령과 첫 데이터 토큰 사이 1바이트 이상
+    stream_state = STREAM_READY;
+    return true; // CS는 스트림이 끝날 때까지 선택 상태 유지
+}
+
+bool sd_stream_poll(void) {
+    if (stream_state != STREAM_SENDING) return true;
+    if (dma_channel_is_busy(dma_tx) || dma_channel_is_busy(dma_rx)) return false;
+
+    // RX DMA까지 끝났으면 SPI 시프트도 끝난 상태
+    if (!finish_block()) {
+#ifdef DEBUG_SD
+        printf("Error: SD rejected streamed block.\n");
+#endif
+        stream_state = STREAM_IDLE;
+        cs_deselect();
+        return true; // 버퍼는 재사용 가능, 다음 write가 SD_ERROR 반환
+    }
+    stream_state = STREAM_READY;
+    return true;
+}
+
+sd_status_t sd_stream_write(const uint8_t *block) {
+    if (!sd_stream_poll()) return SD_BUSY;
+    if (stream_state != STREAM_READY) return SD_ERROR;
+
+    // 카드가 이전 블록을 프로그래밍하는 동안 MISO는 0으로 유지됨
+    if (spi_xfer(0xFF) != 0xFF) return SD_BUSY;
+
+    spi_xfer(TOKEN_START_MULTI);
+
+    // TX: 블록 -> SPI, RX: SPI -> 더미 (오버런 방지)
+    dma_channel_config rx = dma_channel_get_default_config(dma_rx);
+    channel_config_set_transfer_data_size(&rx, DMA_SIZE_8);
+    channel_config_set_dreq(&rx, spi_get_dreq(SD_SPI_PORT, false));
+    channel_config_set_read_increment(&rx, false);
+    channel_config_set_write_increment(&rx, false);
+    dma_channel_configure(dma_rx, &rx, &dma_rx_sink, &spi_get_hw(SD_SPI_PORT)->dr, SD_BLOCK_SIZE, true);
+
+    dma_channel_config tx = dma_channel_get_default_config(dma_tx);
+    channel_config_set_transfer_data_size(&tx, DMA_SIZE_8);
+    channel_config_set_dreq(&tx, spi_get_dreq(SD_SPI_PORT, true));
+    dma_channel_configure(dma_tx, &tx, &spi_get_hw(SD_SPI_PORT)->dr, block, SD_BLOCK_SIZE, true);
+
+    stream_state = STREAM_SENDING;
+    return SD_OK;
+}
+
+bool sd_stream_end(void) {
+    if (stream_state == STREAM_IDLE) return false;
+    while (!sd_stream_poll()) {
+    }
+    bool ok = stream_state == STREAM_READY && wait_ready(SD_WRITE_TIMEOUT_US);
+    if (ok) {
+        spi_xfer(TOKEN_STOP_MULTI);
+        spi_xfer(0xFF);
+        ok = wait_ready(SD_WRITE_TIMEOUT_US);
+    }
+    stream_state = STREAM_IDLE;
+    cs_deselect();
+    return ok;
+}
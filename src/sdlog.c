@@ -0,0 +1,190 @@
+#include "sdlog.h"
+#include "sd_block.h"
+#include "fat32_prealloc.h"
+#include "pico/stdlib.h"
+#include <stdatomic.h>
+#include <string.h> // memcpy, memset 사용
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_SDLOG
+
+#ifdef DEBUG_SDLOG
+#include <stdio.h>
+#endif
+
+#define BUFFER_BYTES (SDLOG_BLOCKS_PER_BUFFER * SD_BLOCK_SIZE)
+
+_Static_assert(sizeof(sdlog_header_t) <= SD_BLOCK_SIZE, "header must fit in one block");
+
+// --- 버퍼 (생산자 -> sdlog_poll) ---
+static uint8_t buffers[SDLOG_BUFFERS][BUFFER_BYTES] __attribute__((aligned(4)));
+static _Atomic uint32_t head;      // 가득 찬 버퍼 누적 수 (생산자만 쓰기)
+static _Atomic uint32_t tail;      // 카드로 내보낸 버퍼 누적 수 (sdlog_poll만 쓰기)
+
+// 생산자 전용
+static uint32_t fill_pos;          // head 버퍼 안의 쓰기 위치
+static uint32_t produced_bytes;    // 버퍼에 넣은 누적 바이트 (패딩 포함)
+
+// sdlog_poll 전용
+static uint32_t flush_block;       // tail 버퍼에서 다음에 보낼 블록
+static bool release_pending;       // tail 버퍼의 마지막 블록 DMA 완료 대기 중
+
+static bool logging = false;
+static bool stream_failed = false;
+static uint32_t header_lba;
+static uint32_t data_blocks;
+static uint32_t capacity_bytes;    // 버퍼 단위로 내림한 데이터 영역 크기
+static sdlog_stats_t stats;
+
+// --- 내부 함수 ---
+
+static bool write_header(uint32_t bytes_written, uint32_t bytes_dropped) {
+    static uint8_t block[SD_BLOCK_SIZE];
+    memset(block, 0, sizeof(block));
+    sdlog_header_t header = {
+        .magic = SDLOG_HEADER_MAGIC,
+        .version = SDLOG_HEADER_VERSION,
+        .block_size = SD_BLOCK_SIZE,
+        .data_blocks = data_blocks,
+        .bytes_written = bytes_written,
+        .bytes_dropped = bytes_dropped,
+    };
+    memcpy(block, &header, sizeof(header));
+    return sd_block_write(header_lba, block, 1);
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool sdlog_init(uint32_t file_bytes) {
+    logging = false;
+    if (!sd_block_init()) return false;
+
+    fat32_extent_t extent;
+    if (!fat32_prealloc_contiguous(SDLOG_FILE_NAME, file_bytes, &extent) || extent.block_count < 2) {
+#ifdef DEBUG_SDLOG
+        printf("Error: could not preallocate %s.\n", SDLOG_FILE_NAME);
+#endif
+        return false;
+    }
+
+    header_lba = extent.first_lba;
+    data_blocks = extent.block_count - 1;
+    capacity_bytes = (data_blocks / SDLOG_BLOCKS_PER_BUFFER) * BUFFER_BYTES;
+
+    atomic_store(&head, 0);
+    atomic_store(&tail, 0);
+    fill_pos = 0;
+    produced_bytes = 0;
+    flush_block = 0;
+    release_pending = false;
+    stream_failed = false;
+    memset(&stats, 0, sizeof(stats));
+
+    if (!write_header(0, 0) || !sd_stream_begin(header_lba + 1)) return false;
+
+#ifdef DEBUG_SDLOG
+    printf("SD log: %lu data blocks at LBA %lu.\n", (unsigned long)data_blocks, (unsigned long)(header_lba + 1));
+#endif
+    logging = true;
+    return true;
+}
+
+bool sdlog_write(const void *data, uint32_t len) {
+    if (!logging) return false;
+
+    uint32_t used = atomic_load_explicit(&head, memory_order_relaxed) -
+                    atomic_load_explicit(&tail, memory_order_acquire);
+    uint32_t free_bytes = (SDLOG_BUFFERS - used) * BUFFER_BYTES - fill_pos;
+
+    if (len > free_bytes || produced_bytes + len > capacity_bytes) {
+        stats.bytes_dropped += len;
+        stats.records_dropped++;
+        return false;
+    }
+    if (used + 1 > stats.max_buffers_used) stats.max_buffers_used = used + 1;
+
+    const uint8_t *src = (const uint8_t *)data;
+    produced_bytes += len;
+    stats.bytes_accepted += len;
+
+    while (len) {
+        uint32_t h = atomic_load_explicit(&head, memory_order_relaxed);
+        uint32_t n = BUFFER_BYTES - fill_pos;
+        if (n > len) n = len;
+        memcpy(&buffers[h % SDLOG_BUFFERS][fill_pos], src, n);
+        src += n;
+        len -= n;
+        fill_pos += n;
+        if (fill_pos == BUFFER_BYTES) {
+            fill_pos = 0;
+            atomic_store_explicit(&head, h + 1, memory_order_release); // 버퍼 넘김
+        }
+    }
+    return true;
+}
+
+void sdlog_poll(void) {
+    if (stream_failed) return;
+
+    if (release_pending) {
+        if (!sd_stream_poll()) return;
+        release_pending = false;
+        atomic_store_explicit(&tail, atomic_load_explicit(&tail, memory_order_relaxed) + 1, memory_order_release);
+    }
+
+    uint32_t t = atomic_load_explicit(&tail, memory_order_relaxed);
+    while (t != atomic_load_explicit(&head, memory_order_acquire)) {
+        const uint8_t *block = &buffers[t % SDLOG_BUFFERS][flush_block * SD_BLOCK_SIZE];
+
+        sd_status_t st = sd_stream_write(block);
+        if (st == SD_BUSY) {
+            stats.busy_polls++;
+            return;
+        }
+        if (st == SD_ERROR) {
+#ifdef DEBUG_SDLOG
+            printf("Error: SD stream write failed, logging stopped.\n");
+#endif
+            stream_failed = true;
+            return;
+        }
+
+        stats.bytes_written += SD_BLOCK_SIZE;
+        if (++flush_block < SDLOG_BLOCKS_PER_BUFFER) continue;
+
+        // 버퍼의 마지막 블록: DMA가 끝나야 생산자에게 돌려줄 수 있음
+        flush_block = 0;
+        if (!sd_stream_poll()) {
+            release_pending = true;
+            return;
+        }
+        atomic_store_explicit(&tail, ++t, memory_order_release);
+    }
+}
+
+bool sdlog_close(void) {
+    if (!logging) return false;
+    logging = false; // 이후 sdlog_write는 거부
+
+    // 채우던 버퍼를 0으로 채워 넘김 (capacity_bytes가 버퍼 단위라 항상 들어감)
+    // (fill_pos > 0 이면 head 버퍼는 비어 있는 슬롯이므로 기다릴 필요 없음)
+    if (fill_pos > 0) {
+        uint32_t h = atomic_load_explicit(&head, memory_order_relaxed);
+        memset(&buffers[h % SDLOG_BUFFERS][fill_pos], 0, BUFFER_BYTES - fill_pos);
+        fill_pos = 0;
+        atomic_store_explicit(&head, h + 1, memory_order_release);
+    }
+
+    while (!stream_failed &&
+           (release_pending || atomic_load(&tail) != atomic_load(&head))) {
+        sdlog_poll();
+        sleep_us(10); // 카드 busy 동안 양보
+    }
+
+    bool ok = sd_stream_end() && !stream_failed;
+    return write_header(stats.bytes_accepted, stats.bytes_dropped) && ok;
+}
+
+void sdlog_get_stats(sdlog_stats_t *out) {
+    *out = stats;
+}
@@ -12,52 +12,25 @@
 #include <stdio.h>
 #endif
 
-// --- 내부 상태 구조체 ---
-typedef struct {
-    uint16_t gpio_num;
-    uint16_t slice_num;
-    uint16_t chan_num; // A=0, B=1
-    uint16_t wrap_val;
-    uint16_t min_pulse_us;
-    uint16_t max_pulse_us;
-    bool is_initialized;
-    bool is_attached; // PWM 슬라이스가 활성화되어 있는지 여부
-} servo_info_t;
-
-// --- 상태 저장 배열 ---
-static servo_info_t servo_state[MAX_SERVOS];
-static bool servo_state_initialized = false; // 배열 초기화 여부 플래그
+// --- 기본 인스턴스 ---
+static servo_ctx_t default_ctx; // 정적 0 초기화 = 빈 컨텍스트
 
 // --- 내부 함수 ---
 
-// servo_state 배열 초기화
-static void initialize_servo_state() {
-    if (!servo_state_initialized) {
-        memset(servo_state, 0, sizeof(servo_state)); // 모든 멤버를 0 또는 false로 초기화
-        // is_initialized 는 false 로 초기화됨
-        servo_state_initialized = true;
-#ifdef DEBUG_SERVO
-        printf("Servo state array initialized.\n");
-#endif
-    }
-}
-
-// GPIO 번호로 servo_state 배열 인덱스 찾기
-static int find_servo_index(uint16_t gpio_num) {
-    initialize_servo_state(); // 배열이 초기화되었는지 확인
+// GPIO 번호로 슬롯 인덱스 찾기
+static int find_servo_index(const servo_ctx_t *ctx, uint16_t gpio_num) {
     for (int i = 0; i < MAX_SERVOS; ++i) {
-        if (servo_state[i].is_initialized && servo_state[i].gpio_num == gpio_num) {
+        if (ctx->servos[i].is_initialized && ctx->servos[i].gpio_num == gpio_num) {
             return i; // 찾음
         }
     }
     return -1; // 못 찾음
 }
 
-// servo_state 배열에서 빈 슬롯 인덱스 찾기
-static int find_free_index() {
-    initialize_servo_state();
+// 빈 슬롯 인덱스 찾기
+static int find_free_index(const servo_ctx_t *ctx) {
     for (int i = 0; i < MAX_SERVOS; ++i) {
-        if (!servo_state[i].is_initialized) {
+        if (!ctx->servos[i].is_initialized) {
             return i; // 빈 슬롯 찾음
         }
     }
@@ -65,44 +38,47 @@ static int find_free_index() {
 }
 
 
-// PWM 파라미터 계산 (이전과 거의 동일, 약간의 개선)
+// PWM 파라미터 계산
+// 분주비를 1/16 단위로 올림해서 wrap이 16비트를 넘지 않게 함. 내림하면 125 MHz / 50 Hz에서
+// wrap 계산값(65572)이 uint16_t로 잘려 36이 되는 문제가 있었음.
 static bool calculate_pwm_params(uint32_t freq_hz, uint16_t *wrap_val, uint16_t *clk_div_int, uint16_t *clk_div_frac) {
     uint32_t sys_clk_hz = clock_get_hz(clk_sys);
-    if (sys_clk_hz == 0) return false; // 클럭이 아직 설정되지 않았을 수 있음
+    if (sys_clk_hz == 0 || freq_hz == 0) return false; // 클럭이 아직 설정되지 않았을 수 있음
 
-    // 목표 분주비 계산 (wrap 값 최대 65535 고려)
-    float divider = (float)sys_clk_hz / (freq_hz * 65536.0f);
+    // 목표 분주비 (1/16 단위, 올림) = sys_clk / (freq * 65536)
+    uint64_t period_div = (uint64_t)freq_hz * 65536u;
+    uint64_t div16 = ((uint64_t)sys_clk_hz * 16u + period_div - 1u) / period_div;
 
     // Pico PWM 분주기는 1.0 ~ 255.9375 범위
-    if (divider < 1.0f) divider = 1.0f;
-    const float MAX_DIVIDER = 255.0f + (15.0f / 16.0f);
-    if (divider > MAX_DIVIDER) {
+    if (div16 < 16u) div16 = 16u;
+    if (div16 > 255u * 16u + 15u) {
 #ifdef DEBUG_SERVO
-        printf("Error: Cannot achieve %lu Hz with sys_clk %lu Hz. Required divider %.2f > %.2f\n",
-               freq_hz, sys_clk_hz, divider, MAX_DIVIDER);
+        printf("Error: Cannot achieve %lu Hz with sys_clk %lu Hz. Required divider %.2f > 255.94\n",
+               freq_hz, sys_clk_hz, div16 / 16.0f);
 #endif
         return false; // 요청된 주파수 생성 불가
     }
 
-    *clk_div_int = (uint16_t)divider;
-    *clk_div_frac = (uint16_t)((divider - *clk_div_int) * 16.0f);
+    *clk_div_int = (uint16_t)(div16 >> 4);
+    *clk_div_frac = (uint16_t)(div16 & 0xFu);
 
-    // 실제 적용될 분주비로 wrap 값 계산
-    float effective_divider = *clk_div_int + (*clk_div_frac / 16.0f);
-    *wrap_val = (uint16_t)(((float)sys_clk_hz / (effective_divider * freq_hz)) - 1.0f);
-
-    // wrap 값이 0이거나 너무 크면 문제 발생 가능성 있음 (실제로는 거의 발생 안함)
-    if (*wrap_val == 0 || *wrap_val > 65535) { // wrap은 uint16_t이므로 > 65535는 불필요하나 명시적 표현
-#ifdef DEBUG_SERVO
-        printf("Warning: Calculated wrap value (%u) is out of optimal range.\n", *wrap_val);
-#endif
-         // 실제로는 분주기 제한으로 인해 이 조건에 도달하기 어려움
-         if (*wrap_val == 0) return false; // 0이면 PWM 생성 불가
-         *wrap_val = 65535; // 최대값으로 설정 (최선책)
-    }
+    // 실제 적용될 분주비로 한 주기의 카운트 수(wrap + 1) 계산
+    uint64_t counts = (uint64_t)sys_clk_hz * 16u / (div16 * freq_hz);
+    if (counts < 2u) return false; // 주파수가 너무 높음
+    if (counts > 65536u) counts = 65536u; // 분주비 하한(1.0)에 걸린 경우만
+    *wrap_val = (uint16_t)(counts - 1u);
     return true;
 }
 
+// 펄스 폭(us x 180)을 PWM 레벨로 변환
+// level = pulse_us / (1000000 / SERVO_PWM_FREQ_HZ) x (wrap + 1)
+static uint16_t pulse_x180_to_level(int32_t pulse_x180, const servo_info_t *servo) {
+    if (pulse_x180 < 0) pulse_x180 = 0;
+    uint32_t level_u = (uint32_t)(((uint64_t)pulse_x180 * (servo->wrap_val + 1u) * SERVO_PWM_FREQ_HZ) /
+                                  (180ull * 1000000ull));
+    return level_u > servo->wrap_val ? servo->wrap_val : (uint16_t)level_u;
+}
+
 // 각도를 PWM 레벨로 변환 (상태 구조체 사용)
 static uint16_t angle_to_level(uint8_t angle, const servo_info_t *servo) {
     if (!servo || !servo->is_initialized) return 0; // 안전장치
@@ -112,29 +88,46 @@ static uint16_t angle_to_level(uint8_t angle, const servo_info_t *servo) {
         angle = 180;
     }
 
-    // 각도(0-180) -> 펄스 폭(us) 변환 (캘리브레이션 값 사용)
-    float pulse_us = servo->min_pulse_us + ((float)angle / 180.0f) * (servo->max_pulse_us - servo->min_pulse_us);
-
-    // 펄스 폭(us) -> PWM 레벨 변환
-    float period_us = 1000000.0f / SERVO_PWM_FREQ_HZ;
-    uint16_t level = (uint16_t)((pulse_us / period_us) * (servo->wrap_val + 1));
-
-    // 레벨 값이 wrap 값보다 크지 않도록 보장
-    if (level > servo->wrap_val) {
-        level = servo->wrap_val;
+    // 각도(0-180) -> 펄스 폭(us x 180) -> PWM 레벨 (정수 연산, 캘리브레이션 값 사용)
+    int32_t min_us = servo->min_pulse_us, max_us = servo->max_pulse_us, center_us = servo->center_pulse_us;
+    int32_t pulse_x180;
+    if (center_us == 0) {
+        pulse_x180 = min_us * 180 + (int32_t)angle * (max_us - min_us);
+    } else if (angle <= 90) {
+        pulse_x180 = min_us * 180 + (int32_t)angle * (center_us - min_us) * 2;
+    } else {
+        pulse_x180 = center_us * 180 + ((int32_t)angle - 90) * (max_us - center_us) * 2;
     }
+    return pulse_x180_to_level(pulse_x180, servo);
+}
 
-    return level;
+// attach 상태로 만들고 레벨 출력
+static void output_level(servo_info_t *servo, uint16_t level) {
+    if (!servo->is_attached) {
+        pwm_set_enabled(servo->slice_num, true);
+        servo->is_attached = true;
+#ifdef DEBUG_SERVO
+        printf("Servo on GPIO %d re-attached (Slice %d enabled).\n", servo->gpio_num, servo->slice_num);
+#endif
+    }
+    pwm_set_gpio_level(servo->gpio_num, level);
+    servo->level = level;
 }
 
 
 // --- 라이브러리 함수 구현 ---
 
-bool servo_init(uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us) {
-    initialize_servo_state(); // 상태 배열 초기화 (최초 1회)
+void servo_ctx_init(servo_ctx_t *ctx) {
+    memset(ctx, 0, sizeof(*ctx)); // 모든 슬롯의 is_initialized = false
+}
+
+servo_ctx_t *servo_default_ctx(void) {
+    return &default_ctx;
+}
 
+bool servo_ctx_add(servo_ctx_t *ctx, uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us) {
     // 1. 빈 슬롯 찾기
-    int index = find_free_index();
+    int index = find_free_index(ctx);
     if (index == -1) {
 #ifdef DEBUG_SERVO
         printf("Error: Maximum number of servos (%d) reached.\n", MAX_SERVOS);
@@ -143,7 +136,7 @@ bool servo_init(uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us)
     }
 
     // 2. 이미 초기화된 GPIO인지 확인
-    if (find_servo_index(gpio_num) != -1) {
+    if (find_servo_index(ctx, gpio_num) != -1) {
 #ifdef DEBUG_SERVO
         printf("Error: Servo on GPIO %d already initialized.\n", gpio_num);
 #endif
@@ -190,7 +183,7 @@ bool servo_init(uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us)
     pwm_init(slice_num, &config, true); // true: PWM 즉시 시작 (attached 상태)
 
     // 9. 상태 정보 저장
-    servo_info_t *servo = &servo_state[index];
+    servo_info_t *servo = &ctx->servos[index];
     servo->gpio_num = gpio_num;
     servo->slice_num = slice_num;
     servo->chan_num = chan_num;
@@ -202,6 +195,7 @@ bool servo_init(uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us)
 
     // 10. 초기 각도(0도) 설정
     uint16_t initial_level = angle_to_level(0, servo);
+    servo->level = initial_level;
     pwm_set_gpio_level(gpio_num, initial_level); // 또는 pwm_set_chan_level(slice_num, chan_num, initial_level);
 
 #ifdef DEBUG_SERVO
@@ -212,14 +206,8 @@ bool servo_init(uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us)
     return true; // 성공
 }
 
-// 기본값 사용하는 초기화 함수
-bool servo_init_default(uint16_t gpio_num) {
-    return servo_init(gpio_num, DEFAULT_SERVO_MIN_PULSE_US, DEFAULT_SERVO_MAX_PULSE_US);
-}
-
-
-bool servo_set(uint16_t gpio_num, uint8_t angle) {
-    int index = find_servo_index(gpio_num);
+bool servo_ctx_set(servo_ctx_t *ctx, uint16_t gpio_num, uint8_t angle) {
+    int index = find_servo_index(ctx, gpio_num);
     if (index == -1) {
 #ifdef DEBUG_SERVO
         printf("Error: Servo on GPIO %d not initialized for set().\n", gpio_num);
@@ -227,32 +215,82 @@ bool servo_set(uint16_t gpio_num, uint8_t angle) {
         return false; // 초기화되지 않음
     }
 
-    servo_info_t *servo = &servo_state[index];
+    servo_info_t *servo = &ctx->servos[index];
+
+    // 각도를 레벨로 변환해 출력 (detach 상태였다면 re-attach)
+    output_level(servo, angle_to_level(angle, servo));
 
-    // 1. 만약 detach 상태였다면 re-attach (PWM 활성화)
-    if (!servo->is_attached) {
-        pwm_set_enabled(servo->slice_num, true);
-        servo->is_attached = true;
 #ifdef DEBUG_SERVO
-        printf("Servo on GPIO %d re-attached (Slice %d enabled).\n", gpio_num, servo->slice_num);
+    // printf("Servo on GPIO %d set to angle %u (Level: %u).\n", gpio_num, angle, level);
 #endif
-    }
 
-    // 2. 각도를 레벨로 변환
-    uint16_t level = angle_to_level(angle, servo);
+    return true; // 성공
+}
 
-    // 3. PWM 레벨 설정
-    pwm_set_gpio_level(servo->gpio_num, level);
+bool servo_ctx_set_pulse_us(servo_ctx_t *ctx, uint16_t gpio_num, uint16_t pulse_us) {
+    int index = find_servo_index(ctx, gpio_num);
+    if (index == -1) {
+        return false; // 초기화되지 않음
+    }
+    servo_info_t *servo = &ctx->servos[index];
+    output_level(servo, pulse_x180_to_level((int32_t)pulse_us * 180, servo));
+    return true;
+}
 
+bool servo_ctx_set_calibration(servo_ctx_t *ctx, uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us,
+                               uint16_t center_pulse_us) {
+    int index = find_servo_index(ctx, gpio_num);
+    if (index == -1) {
+        return false; // 초기화되지 않음
+    }
+    if (min_pulse_us == 0 || min_pulse_us >= max_pulse_us ||
+        (center_pulse_us != 0 && (center_pulse_us <= min_pulse_us || center_pulse_us >= max_pulse_us))) {
 #ifdef DEBUG_SERVO
-    // printf("Servo on GPIO %d set to angle %u (Level: %u).\n", gpio_num, angle, level);
+        printf("Error: Invalid calibration for GPIO %d (min: %u, max: %u, center: %u)\n", gpio_num, min_pulse_us,
+               max_pulse_us, center_pulse_us);
 #endif
+        return false;
+    }
+    servo_info_t *servo = &ctx->servos[index];
+    servo->min_pulse_us = min_pulse_us;
+    servo->max_pulse_us = max_pulse_us;
+    servo->center_pulse_us = center_pulse_us;
+    return true;
+}
 
-    return true; // 성공
+bool servo_ctx_get_calibration(const servo_ctx_t *ctx, uint16_t gpio_num, uint16_t *min_pulse_us,
+                               uint16_t *max_pulse_us, uint16_t *center_pulse_us) {
+    int index = find_servo_index(ctx, gpio_num);
+    if (index == -1) {
+        return false; // 초기화되지 않음
+    }
+    const servo_info_t *servo = &ctx->servos[index];
+    *min_pulse_us = servo->min_pulse_us;
+    *max_pulse_us = servo->max_pulse_us;
+    *center_pulse_us = servo->center_pulse_us;
+    return true;
 }
 
-bool servo_detach(uint16_t gpio_num) {
-    int index = find_servo_index(gpio_num);
+bool servo_ctx_set_model(servo_ctx_t *ctx, uint16_t gpio_num, const servo_model_t *model) {
+    int index = find_servo_index(ctx, gpio_num);
+    if (index == -1 || model->order > 2) {
+        return false;
+    }
+    ctx->servos[index].model = *model;
+    return true;
+}
+
+bool servo_ctx_get_model(const servo_ctx_t *ctx, uint16_t gpio_num, servo_model_t *model) {
+    int index = find_servo_index(ctx, gpio_num);
+    if (index == -1) {
+        return false; // 초기화되지 않음
+    }
+    *model = ctx->servos[index].model;
+    return true;
+}
+
+bool servo_ctx_detach(servo_ctx_t *ctx, uint16_t gpio_num) {
+    int index = find_servo_index(ctx, gpio_num);
     if (index == -1) {
 #ifdef DEBUG_SERVO
         printf("Error: Servo on GPIO %d not initialized for detach().\n", gpio_num);
@@ -260,7 +298,7 @@ bool servo_detach(uint16_t gpio_num) {
         return false; // 초기화되지 않음
     }
 
-    servo_info_t *servo = &servo_state[index];
+    servo_info_t *servo = &ctx->servos[index];
 
     if (!servo->is_attached) {
 #ifdef DEBUG_SERVO
@@ -281,8 +319,8 @@ bool servo_detach(uint16_t gpio_num) {
     return true; // 성공
 }
 
-bool servo_attach(uint16_t gpio_num) {
-     int index = find_servo_index(gpio_num);
+bool servo_ctx_attach(servo_ctx_t *ctx, uint16_t gpio_num) {
+    int index = find_servo_index(ctx, gpio_num);
     if (index == -1) {
 #ifdef DEBUG_SERVO
         printf("Error: Servo on GPIO %d not initialized for attach().\n", gpio_num);
@@ -290,7 +328,7 @@ bool servo_attach(uint16_t gpio_num) {
         return false; // 초기화되지 않음
     }
 
-    servo_info_t *servo = &servo_state[index];
+    servo_info_t *servo = &ctx->servos[index];
 
     if (servo->is_attached) {
 #ifdef DEBUG_SERVO
@@ -311,4 +349,98 @@ bool servo_attach(uint16_t gpio_num) {
     // 필요하다면 여기서 특정 각도로 설정하는 로직 추가 가능
 
     return true; // 성공
-}
\ No newline at end of file
+}
+
+bool servo_ctx_remove(servo_ctx_t *ctx, uint16_t gpio_num) {
+    int index = find_servo_index(ctx, gpio_num);
+    if (index == -1) {
+#ifdef DEBUG_SERVO
+        printf("Error: Servo on GPIO %d not initialized for deinit().\n", gpio_num);
+#endif
+        return false; // 초기화되지 않음
+    }
+
+    // 출력을 멈추고 슬롯을 비움 (GPIO 기능은 그대로 둠)
+    pwm_set_gpio_level(gpio_num, 0);
+    memset(&ctx->servos[index], 0, sizeof(ctx->servos[index]));
+
+#ifdef DEBUG_SERVO
+    printf("Servo on GPIO %d deinitialized.\n", gpio_num);
+#endif
+
+    return true; // 성공
+}
+
+bool servo_ctx_get_level(const servo_ctx_t *ctx, uint16_t gpio_num, uint16_t *level) {
+    int index = find_servo_index(ctx, gpio_num);
+    if (index == -1) {
+        return false; // 초기화되지 않음
+    }
+    *level = ctx->servos[index].level;
+    return true;
+}
+
+bool servo_ctx_angle_to_level(const servo_ctx_t *ctx, uint16_t gpio_num, uint8_t angle, uint16_t *level) {
+    int index = find_servo_index(ctx, gpio_num);
+    if (index == -1) {
+        return false; // 초기화되지 않음
+    }
+    *level = angle_to_level(angle, &ctx->servos[index]);
+    return true;
+}
+
+// --- 기본 인스턴스 API (기존 함수) ---
+
+bool servo_init(uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us) {
+    return servo_ctx_add(&default_ctx, gpio_num, min_pulse_us, max_pulse_us);
+}
+
+// 기본값 사용하는 초기화 함수
+bool servo_init_default(uint16_t gpio_num) {
+    return servo_init(gpio_num, DEFAULT_SERVO_MIN_PULSE_US, DEFAULT_SERVO_MAX_PULSE_US);
+}
+
+bool servo_set(uint16_t gpio_num, uint8_t angle) {
+    return servo_ctx_set(&default_ctx, gpio_num, angle);
+}
+
+bool servo_detach(uint16_t gpio_num) {
+    return servo_ctx_detach(&default_ctx, gpio_num);
+}
+
+bool servo_attach(uint16_t gpio_num) {
+    return servo_ctx_attach(&default_ctx, gpio_num);
+}
+
+bool servo_deinit(uint16_t gpio_num) {
+    return servo_ctx_remove(&default_ctx, gpio_num);
+}
+
+bool servo_get_level(uint16_t gpio_num, uint16_t *level) {
+    return servo_ctx_get_level(&default_ctx, gpio_num, level);
+}
+
+bool servo_angle_to_level(uint16_t gpio_num, uint8_t angle, uint16_t *level) {
+    return servo_ctx_angle_to_level(&default_ctx, gpio_num, angle, level);
+}
+
+bool servo_set_pulse_us(uint16_t gpio_num, uint16_t pulse_us) {
+    return servo_ctx_set_pulse_us(&default_ctx, gpio_num, pulse_us);
+}
+
+bool servo_set_calibration(uint16_t gpio_num, uint16_t min_pulse_us, uint16_t max_pulse_us, uint16_t center_pulse_us) {
+    return servo_ctx_set_calibration(&default_ctx, gpio_num, min_pulse_us, max_pulse_us, center_pulse_us);
+}
+
+bool servo_get_calibration(uint16_t gpio_num, uint16_t *min_pulse_us, uint16_t *max_pulse_us,
+                           uint16_t *center_pulse_us) {
+    return servo_ctx_get_calibration(&default_ctx, gpio_num, min_pulse_us, max_pulse_us, center_pulse_us);
+}
+
+bool servo_set_model(uint16_t gpio_num, const servo_model_t *model) {
+    return servo_ctx_set_model(&default_ctx, gpio_num, model);
+}
+
+bool servo_get_model(uint16_t gpio_num, servo_model_t *model) {
+    return servo_ctx_get_model(&default_ctx, gpio_num, model);
+}
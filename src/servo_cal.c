@@ -0,0 +1,239 @@
+#include "servo_cal.h"
+#include "pico/stdlib.h"
+#include <string.h>
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_SERVO_CAL
+
+#ifdef DEBUG_SERVO_CAL
+#include <stdio.h>
+#endif
+
+#define MIN_SLOPE_Q8 8                        // 피드백 기울기 하한 (0.03 카운트/us): 이보다 작으면 안 움직이는 것
+
+// 스윕 상태
+enum {
+    ST_START,                                 // 시작점: 유지 전류 / 피드백 기준
+    ST_COARSE,
+    ST_COARSE_CONFIRM,
+    ST_BACKOFF,                               // 정지점에서 한 칸 물러남 (다시 다가가기 전)
+    ST_FINE,
+    ST_FINE_CONFIRM,
+    ST_RETURN,                                // 시작점으로 돌아옴: 반대쪽 기준
+    ST_DONE,
+};
+
+// --- 내부 함수 ---
+
+static uint16_t clamp_pulse(const servo_cal_t *cal, int32_t us) {
+    if (us < cal->config.limit_min_us) return cal->config.limit_min_us;
+    if (us > cal->config.limit_max_us) return cal->config.limit_max_us;
+    return (uint16_t)us;
+}
+
+// 다음 펄스와 기다릴 시간 (기본 대기 + 이동 시간)
+static void move(servo_cal_t *cal, int32_t us) {
+    uint16_t to = clamp_pulse(cal, us);
+    uint32_t dist = to > cal->pulse_us ? to - cal->pulse_us : cal->pulse_us - to;
+    uint32_t wait = cal->config.settle_ms + dist / cal->config.slew_us_per_ms;
+    cal->wait_ms = (uint16_t)(wait > UINT16_MAX ? UINT16_MAX : wait);
+    cal->pulse_us = to;
+}
+
+static bool stalled(const servo_cal_t *cal, const servo_cal_sample_t *s) {
+    const servo_cal_config_t *c = &cal->config;
+    if ((c->sense & SERVO_CAL_SENSE_CURRENT) && s->current_ma > (uint32_t)cal->base_ma + c->stall_ma) return true;
+    if ((c->sense & SERVO_CAL_SENSE_FEEDBACK) && cal->slope_q8 != 0) {
+        // coarse 단계의 마지막 정상 위치에서 기울기로 예측한 위치보다 진행 방향으로 모자란 양 (펄스 환산).
+        // fine 단계에서도 기준을 옮기지 않음 (한 칸씩 비교하면 lag_us보다 작은 간격으로 정지점을 지나쳐 감)
+        int32_t dp = (int32_t)cal->pulse_us - cal->ref_us;
+        int32_t predicted = cal->ref_fb + (cal->slope_q8 * dp) / 256;
+        int32_t shortfall = (predicted - s->feedback) * 256 / cal->slope_q8 * cal->dir;
+        if (shortfall > c->lag_us) return true;
+    }
+    return false;
+}
+
+// 정상 위치로 기록. coarse 단계면 피드백 기준도 옮기고 기울기를 다시 구함 (시작점에서 두 칸 이상 떨어진 뒤부터)
+static bool accept(servo_cal_t *cal, const servo_cal_sample_t *s, bool coarse) {
+    cal->good_us = cal->pulse_us;
+    if (!coarse) return true;
+    cal->ref_us = cal->pulse_us;
+    cal->ref_fb = s->feedback;
+    int32_t dp = (int32_t)cal->ref_us - cal->config.start_us;
+    if (!(cal->config.sense & SERVO_CAL_SENSE_FEEDBACK) || dp * cal->dir < 2 * cal->config.coarse_step_us) return true;
+    int32_t slope = ((int32_t)cal->ref_fb - cal->start_fb) * 256 / dp;
+    if (slope > -MIN_SLOPE_Q8 && slope < MIN_SLOPE_Q8) {
+#ifdef DEBUG_SERVO_CAL
+        printf("servo_cal: feedback not following (slope %ld/256 per us)\n", (long)slope);
+#endif
+        return false;
+    }
+    cal->slope_q8 = slope;
+    return true;
+}
+
+// 이번 방향 끝: 정지점 기록 후 시작점으로 돌아가거나 결과 계산
+static servo_cal_status_t finish_dir(servo_cal_t *cal, bool found) {
+    servo_cal_result_t *r = &cal->result;
+    if (cal->dir < 0) {
+        r->stop_min_us = cal->good_us;
+        r->min_found = found;
+        cal->state = ST_RETURN;
+        move(cal, cal->config.start_us);
+        // 반대쪽 기준을 재는 자리라 큰 이동 뒤의 흔들림이 다 가라앉을 때까지 기다림
+        if (cal->wait_ms < SERVO_CAL_START_WAIT_MS) cal->wait_ms = SERVO_CAL_START_WAIT_MS;
+        return SERVO_CAL_RUNNING;
+    }
+    r->stop_max_us = cal->good_us;
+    r->max_found = found;
+#ifdef DEBUG_SERVO_CAL
+    printf("servo_cal: stops %u%s ~ %u%s us, %u steps (%u stalled)\n", r->stop_min_us, r->min_found ? "" : "(limit)",
+           r->stop_max_us, r->max_found ? "" : "(limit)", r->steps, r->stalled_steps);
+#endif
+    if (r->stop_max_us < r->stop_min_us + SERVO_CAL_MIN_RANGE_US) return SERVO_CAL_FAILED;
+    r->min_us = (uint16_t)(r->stop_min_us + cal->config.margin_us);
+    r->max_us = (uint16_t)(r->stop_max_us - cal->config.margin_us);
+    r->center_us = (uint16_t)((r->stop_min_us + r->stop_max_us) / 2u);
+    cal->state = ST_DONE;
+    move(cal, r->center_us);
+    return SERVO_CAL_DONE;
+}
+
+// 정상 위치에서 한 칸 더 (한계에 닿았으면 이번 방향 끝)
+static servo_cal_status_t advance(servo_cal_t *cal, uint16_t step_us) {
+    uint16_t limit = cal->dir < 0 ? cal->config.limit_min_us : cal->config.limit_max_us;
+    if (cal->good_us == limit) return finish_dir(cal, false);
+    move(cal, (int32_t)cal->good_us + cal->dir * (int32_t)step_us);
+    return SERVO_CAL_RUNNING;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void servo_cal_default_config(servo_cal_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->start_us = 1500;
+    config->limit_min_us = 500;
+    config->limit_max_us = 2500;
+    config->coarse_step_us = 20;
+    config->fine_step_us = 2;
+    config->margin_us = 20;
+    config->sense = SERVO_CAL_SENSE_CURRENT | SERVO_CAL_SENSE_FEEDBACK;
+    config->stall_ma = 80;
+    config->lag_us = 8;
+    config->settle_ms = 40;
+    config->slew_us_per_ms = 4;               // 약 0.16 s/60도 (10 us/도)
+    config->samples = 4;
+}
+
+bool servo_cal_begin(servo_cal_t *cal, const servo_cal_config_t *config) {
+    const servo_cal_config_t *c = config;
+    if (c->sense == 0 || c->coarse_step_us == 0 || c->fine_step_us == 0 || c->fine_step_us > c->coarse_step_us ||
+        c->slew_us_per_ms == 0 || c->limit_min_us >= c->limit_max_us || c->start_us <= c->limit_min_us ||
+        c->start_us >= c->limit_max_us) {
+        return false;
+    }
+    memset(cal, 0, sizeof(*cal));
+    cal->config = *c;
+    cal->state = ST_START;
+    cal->dir = -1;
+    cal->pulse_us = c->start_us;
+    cal->wait_ms = SERVO_CAL_START_WAIT_MS;
+    return true;
+}
+
+servo_cal_status_t servo_cal_step(servo_cal_t *cal, const servo_cal_sample_t *sample) {
+    servo_cal_result_t *r = &cal->result;
+    ++r->steps;
+    r->elapsed_ms += cal->wait_ms;
+
+    switch (cal->state) {
+    case ST_START:
+    case ST_RETURN:
+        // 시작점 기준 (반대쪽은 정지점에서 풀린 뒤 다시 잼)
+        if (cal->state == ST_RETURN) cal->dir = 1;
+        cal->base_ma = sample->current_ma;
+        cal->start_fb = sample->feedback;
+        cal->good_us = cal->ref_us = cal->pulse_us;
+        cal->ref_fb = sample->feedback;
+        cal->state = ST_COARSE;
+        return advance(cal, cal->config.coarse_step_us);
+
+    case ST_COARSE:
+    case ST_FINE: {
+        bool coarse = cal->state == ST_COARSE;
+        if (stalled(cal, sample)) {
+            ++r->stalled_steps;
+            cal->state = coarse ? ST_COARSE_CONFIRM : ST_FINE_CONFIRM;
+            cal->wait_ms = cal->config.settle_ms; // 같은 펄스에서 다시 잼
+            return SERVO_CAL_RUNNING;
+        }
+        if (!accept(cal, sample, coarse)) return SERVO_CAL_FAILED;
+        return advance(cal, coarse ? cal->config.coarse_step_us : cal->config.fine_step_us);
+    }
+
+    case ST_COARSE_CONFIRM:
+    case ST_FINE_CONFIRM: {
+        bool coarse = cal->state == ST_COARSE_CONFIRM;
+        if (!stalled(cal, sample)) {
+            // 잡음이었음: 정상 위치로 보고 계속
+            cal->state = coarse ? ST_COARSE : ST_FINE;
+            if (!accept(cal, sample, coarse)) return SERVO_CAL_FAILED;
+            return advance(cal, coarse ? cal->config.coarse_step_us : cal->config.fine_step_us);
+        }
+        ++r->stalled_steps;
+        if (!coarse) return finish_dir(cal, true);
+        cal->state = ST_BACKOFF;
+        move(cal, (int32_t)cal->good_us - cal->dir * (int32_t)cal->config.coarse_step_us);
+        return SERVO_CAL_RUNNING;
+    }
+
+    case ST_BACKOFF:
+        // 마지막 정상 위치 다음부터 fine 간격으로 다시 다가감 (같은 방향에서 접근)
+        cal->state = ST_FINE;
+        move(cal, (int32_t)cal->good_us + cal->dir * (int32_t)cal->config.fine_step_us);
+        return SERVO_CAL_RUNNING;
+
+    default:
+        return SERVO_CAL_DONE;
+    }
+}
+
+bool servo_cal_run(servo_ctx_t *ctx, uint16_t gpio_num, const servo_cal_config_t *config, servo_cal_read_fn read,
+                   void *arg, servo_cal_result_t *result) {
+    servo_cal_t cal;
+    if (!servo_cal_begin(&cal, config)) return false;
+    uint8_t n = config->samples ? config->samples : 1;
+    uint64_t t0 = time_us_64();
+
+    servo_cal_status_t status = SERVO_CAL_RUNNING;
+    while (status == SERVO_CAL_RUNNING) {
+        if (!servo_ctx_set_pulse_us(ctx, gpio_num, cal.pulse_us)) return false;
+        sleep_ms(cal.wait_ms);
+
+        uint32_t current = 0;
+        int32_t feedback = 0;
+        for (uint8_t i = 0; i < n; ++i) {
+            servo_cal_sample_t s;
+            if (i > 0) sleep_ms(SERVO_CAL_SAMPLE_GAP_MS);
+            if (!read(arg, &s)) {
+                status = SERVO_CAL_FAILED;
+                break;
+            }
+            current += s.current_ma;
+            feedback += s.feedback;
+        }
+        if (status == SERVO_CAL_FAILED) break;
+        servo_cal_sample_t avg = { (uint16_t)(current / n), (int16_t)(feedback / n) };
+        status = servo_cal_step(&cal, &avg);
+    }
+    cal.result.elapsed_ms = (uint32_t)((time_us_64() - t0) / 1000u);
+    if (result) *result = cal.result;
+
+    if (status != SERVO_CAL_DONE ||
+        !servo_ctx_set_calibration(ctx, gpio_num, cal.result.min_us, cal.result.max_us, cal.result.center_us)) {
+        servo_ctx_set_pulse_us(ctx, gpio_num, config->start_us); // 정지점에 민 채로 두지 않음
+        return false;
+    }
+    return servo_ctx_set(ctx, gpio_num, 90);
+}
@@ -0,0 +1,384 @@
+#include "servo_dyn.h"
+#include "fxmath.h"
+#include "pico/stdlib.h"
+#include <math.h>
+#include <string.h>
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_SERVO_DYN
+
+#ifdef DEBUG_SERVO_DYN
+#include <stdio.h>
+#endif
+
+#define MIN_FB_PER_US 0.01f                   // 피드백 배율 하한 (카운트/us): 이보다 작으면 안 움직이는 것
+#define SUBSTEP_WN_DT 0.3f                    // 2차 모델 적분: 한 번에 wn x dt가 이보다 크면 나눠 적분
+#define ORDER2_GAIN 0.9f                      // 2차 모델이 오차를 이 비율 아래로 줄여야 2차로 씀
+
+// 2차 모델 탐색 시작 격자
+static const float GRID_WN[] = { 20.0f, 35.0f, 60.0f, 100.0f };
+static const float GRID_ZETA[] = { 0.3f, 0.6f, 1.0f };
+
+// 모델 시뮬레이션 입력 (float 파라미터)
+typedef struct {
+    uint8_t order;
+    float delay_us;
+    float tau_s;                              // 1차
+    float wn, zeta;                           // 2차
+    float slew;                               // us/s, 0이면 제한 없음
+} sim_model_t;
+
+typedef struct {
+    const servo_dyn_sample_t *s;
+    uint32_t n;
+    float fb_offset, us_per_fb;
+    float slew;
+    uint16_t evals;
+} problem_t;
+
+// --- 내부 함수 ---
+
+static float clampf(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// 명령 구간 [a, b] (us, 지연 적용한 시각)의 평균 명령. 명령은 샘플 시각마다 바뀌는 계단이라 적분이 정확하고,
+// 지연이 샘플 간격보다 잘게 바뀌어도 결과가 연속으로 바뀜 (패턴 탐색이 지연을 좁힐 수 있도록).
+// *j는 a가 속한 명령 구간 (시각이 늘어나므로 앞으로만 움직임). 기록 시작 전은 첫 명령
+static float mean_cmd(const servo_dyn_sample_t *s, uint32_t n, uint32_t *j, float a, float b) {
+    while (*j + 1 < n && (float)s[*j + 1].t_us <= a) ++*j;
+    uint32_t k = *j;
+    float t = a, sum = 0.0f;
+    while (k + 1 < n && (float)s[k + 1].t_us < b) {
+        sum += (float)s[k].cmd_us * ((float)s[k + 1].t_us - t);
+        t = (float)s[k + 1].t_us;
+        ++k;
+    }
+    sum += (float)s[k].cmd_us * (b - t);
+    return sum / (b - a);
+}
+
+// 기록의 명령으로 모델을 돌려 피드백(펄스 환산)과의 오차 제곱합. 첫 샘플 위치에서 정지 상태로 시작
+static float simulate(const sim_model_t *m, const servo_dyn_sample_t *s, uint32_t n, float fb_offset,
+                      float us_per_fb, float *out_us) {
+    float x = ((float)s[0].feedback - fb_offset) * us_per_fb, v = 0.0f, sse = 0.0f;
+    uint32_t j = 0;
+    if (out_us) out_us[0] = x;
+    for (uint32_t i = 1; i < n; ++i) {
+        float dt_us = (float)(s[i].t_us - s[i - 1].t_us);
+        float dt = dt_us * 1e-6f;
+        float u = mean_cmd(s, n, &j, (float)s[i - 1].t_us - m->delay_us, (float)s[i].t_us - m->delay_us);
+
+        if (m->order == 0) {
+            x = u;
+        } else if (m->order == 1) {
+            float dx = (u - x) * dt / (m->tau_s + dt);
+            if (m->slew > 0.0f) dx = clampf(dx, -m->slew * dt, m->slew * dt);
+            x += dx;
+        } else {
+            uint32_t sub = 1u + (uint32_t)(m->wn * dt / SUBSTEP_WN_DT);
+            float h = dt / (float)sub, wn2 = m->wn * m->wn, c = 2.0f * m->zeta * m->wn;
+            for (uint32_t k = 0; k < sub; ++k) {
+                v += (wn2 * (u - x) - c * v) * h;
+                if (m->slew > 0.0f) v = clampf(v, -m->slew, m->slew);
+                x += v * h;
+            }
+        }
+
+        float e = ((float)s[i].feedback - fb_offset) * us_per_fb - x;
+        sse += e * e;
+        if (out_us) out_us[i] = x;
+    }
+    return sse;
+}
+
+// 탐색 좌표 -> 모델. 1차: (지연, ln 시정수), 2차: (지연, ln wn, 감쇠비)
+static void to_model(const problem_t *p, uint8_t order, const float *q, sim_model_t *m) {
+    memset(m, 0, sizeof(*m));
+    m->order = order;
+    m->delay_us = q[0];
+    m->slew = p->slew;
+    if (order == 1) {
+        m->tau_s = expf(q[1]);
+    } else {
+        m->wn = expf(q[1]);
+        m->zeta = q[2];
+    }
+}
+
+static float cost(problem_t *p, uint8_t order, const float *q) {
+    sim_model_t m;
+    to_model(p, order, q, &m);
+    ++p->evals;
+    return simulate(&m, p->s, p->n, p->fb_offset, p->us_per_fb, NULL);
+}
+
+// 좌표별 +-step 시도, 좋아지면 그 자리로 옮기고 아니면 간격을 반으로 (모든 좌표가 tol 아래면 끝)
+static float pattern_search(problem_t *p, uint8_t order, float *q, float *step, const float *lo, const float *hi,
+                            const float *tol) {
+    uint8_t dims = order == 1 ? 2 : 3;
+    uint16_t limit = (uint16_t)(p->evals + SERVO_DYN_MAX_EVALS);
+    float best = cost(p, order, q);
+    while (p->evals < limit) {
+        bool improved = false;
+        for (uint8_t d = 0; d < dims && !improved; ++d) {
+            for (int sign = -1; sign <= 1 && !improved; sign += 2) {
+                float trial[3] = { q[0], q[1], q[2] };
+                trial[d] = clampf(q[d] + (float)sign * step[d], lo[d], hi[d]);
+                if (trial[d] == q[d]) continue;
+                float c = cost(p, order, trial);
+                if (c < best) {
+                    best = c;
+                    q[d] = trial[d];
+                    improved = true;
+                }
+            }
+        }
+        if (improved) continue;
+        bool done = true;
+        for (uint8_t d = 0; d < dims; ++d) {
+            step[d] *= 0.5f;
+            if (step[d] > tol[d]) done = false;
+        }
+        if (done) break;
+    }
+    return best;
+}
+
+// 명령이 같은 구간 [a, b). 기록 끝까지 이어지면 b = n
+static uint32_t run_end(const servo_dyn_sample_t *s, uint32_t n, uint32_t a) {
+    uint32_t b = a + 1;
+    while (b < n && s[b].cmd_us == s[a].cmd_us) ++b;
+    return b;
+}
+
+// 계단 구간의 끝부분으로 피드백 배율, 큰 계단의 최대 속도
+static bool fit_scale(problem_t *p, servo_dyn_fit_t *fit) {
+    const servo_dyn_sample_t *s = p->s;
+    uint32_t n = p->n;
+    float ref = (float)s[0].cmd_us;           // 상쇄 오차를 줄이려고 기준을 빼고 합산
+    float sx = 0.0f, sy = 0.0f, sxx = 0.0f, sxy = 0.0f;
+    uint32_t count = 0, runs = 0;
+
+    for (uint32_t a = 0; a < n;) {
+        uint32_t b = run_end(s, n, a);
+        uint32_t t_end = b < n ? s[b].t_us : s[n - 1].t_us;
+        uint32_t hold = t_end - s[a].t_us;
+        if (hold >= SERVO_DYN_MIN_HOLD_MS * 1000u) {
+            uint32_t settled = s[a].t_us + hold / 100u * (100u - SERVO_DYN_SETTLED_PCT);
+            for (uint32_t i = a; i < b; ++i) {
+                if (s[i].t_us < settled) continue;
+                float x = (float)s[i].cmd_us - ref, y = (float)s[i].feedback;
+                sx += x;
+                sy += y;
+                sxx += x * x;
+                sxy += x * y;
+                ++count;
+            }
+            ++runs;
+        }
+        a = b;
+    }
+    if (runs < 2) return false;
+    float var = sxx - sx * sx / (float)count;
+    if (var <= 0.0f) return false;
+    float k = (sxy - sx * sy / (float)count) / var;
+    if (fabsf(k) < MIN_FB_PER_US) {
+#ifdef DEBUG_SERVO_DYN
+        printf("servo_dyn: feedback not following (%.4f counts/us)\n", (double)k);
+#endif
+        return false;
+    }
+    fit->fb_per_us = k;
+    fit->fb_offset = (sy - k * sx) / (float)count - k * ref;
+    p->fb_offset = fit->fb_offset;
+    p->us_per_fb = 1.0f / k;
+
+    // 속도 한계: 큰 계단마다 SLEW_WINDOW 구간 평균 속도의 최대값
+    float slew_sum = 0.0f;
+    fit->slew_steps = 0;
+    for (uint32_t a = 1; a < n;) {
+        uint32_t b = run_end(s, n, a);
+        int32_t jump = (int32_t)s[a].cmd_us - s[a - 1].cmd_us;
+        uint32_t t_end = b < n ? s[b].t_us : s[n - 1].t_us;
+        if ((jump >= SERVO_DYN_SLEW_MIN_STEP_US || jump <= -SERVO_DYN_SLEW_MIN_STEP_US) &&
+            t_end - s[a].t_us >= SERVO_DYN_MIN_HOLD_MS * 1000u) {
+            float dir = jump > 0 ? 1.0f : -1.0f, best = 0.0f;
+            uint32_t i2 = a;
+            for (uint32_t i = a; i < b; ++i) {
+                while (i2 < b && s[i2].t_us - s[i].t_us < SERVO_DYN_SLEW_WINDOW_US) ++i2;
+                if (i2 == b) break;
+                float dy = (float)(s[i2].feedback - s[i].feedback) * p->us_per_fb;
+                float rate = dir * dy * 1e6f / (float)(s[i2].t_us - s[i].t_us);
+                if (rate > best) best = rate;
+            }
+            slew_sum += best;
+            ++fit->slew_steps;
+        }
+        a = b;
+    }
+    p->slew = fit->slew_steps ? slew_sum / (float)fit->slew_steps : 0.0f;
+    return true;
+}
+
+static uint32_t round_u32(float v, uint32_t max) {
+    if (v <= 0.0f) return 0;
+    return v >= (float)max ? max : (uint32_t)(v + 0.5f);
+}
+
+// --- 라이브러리 함수 구현 ---
+
+void servo_dyn_default_config(servo_dyn_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->step_us = 200;
+    config->steps = 6;
+    config->step_hold_ms = 400;
+    config->chirp_amp_us = 25;
+    config->chirp_start_hz_x10 = 5;
+    config->chirp_end_hz_x10 = 80;
+    config->chirp_ms = 4000;
+    config->sample_us = 2000;
+}
+
+uint32_t servo_dyn_sample_count(const servo_dyn_config_t *config) {
+    uint32_t duration_us = ((uint32_t)config->steps + 1u) * config->step_hold_ms * 1000u + config->chirp_ms * 1000u;
+    return config->sample_us ? duration_us / config->sample_us + 1u : 0;
+}
+
+uint16_t servo_dyn_command(const servo_dyn_config_t *config, uint32_t t_us) {
+    const servo_dyn_config_t *c = config;
+    uint32_t hold_us = c->step_hold_ms * 1000u;
+    uint32_t steps_end = ((uint32_t)c->steps + 1u) * hold_us;
+    if (t_us < hold_us) return c->center_us;
+    if (t_us < steps_end) {
+        uint32_t k = t_us / hold_us;          // 1부터: 홀수 +, 짝수 -
+        return (uint16_t)(k & 1u ? c->center_us + c->step_us : c->center_us - c->step_us);
+    }
+
+    uint32_t t = t_us - steps_end, len_us = c->chirp_ms * 1000u;
+    if (t >= len_us) return c->center_us;
+    // 위상 (바퀴) = f0 t + (f1 - f0) t^2 / (2 T). 16비트 이진 각도로, 64비트 정수 안에서 (t^2 / T는 us 단위로 내림:
+    // 위상 오차 0.01도 미만)
+    int64_t df = (int64_t)c->chirp_end_hz_x10 - c->chirp_start_hz_x10;
+    int64_t phase = (int64_t)c->chirp_start_hz_x10 * t * 65536 / 10000000 +
+                    df * (int64_t)((uint64_t)t * t / len_us) * 65536 / 20000000;
+    int32_t offset = ((int32_t)c->chirp_amp_us * fx_sin((fx_angle_t)phase) + 16384) >> 15;
+    return (uint16_t)((int32_t)c->center_us + offset);
+}
+
+bool servo_dyn_record(servo_ctx_t *ctx, uint16_t gpio_num, const servo_dyn_config_t *config, servo_cal_read_fn read,
+                      void *arg, servo_dyn_sample_t *samples, uint32_t capacity, uint32_t *count) {
+    uint16_t min_us, max_us, center_us;
+    if (!servo_ctx_get_calibration(ctx, gpio_num, &min_us, &max_us, &center_us) || config->sample_us == 0) {
+        return false;
+    }
+    fxmath_init(); // 처프 (servo_dyn_command)
+    servo_dyn_config_t c = *config;
+    if (c.center_us == 0) c.center_us = center_us ? center_us : (uint16_t)((min_us + max_us) / 2u);
+    if (c.center_us <= min_us || c.center_us >= max_us) return false;
+    // 계단 / 처프가 캘리브레이션 범위(정지점 안쪽) 밖으로 나가지 않게
+    uint16_t room = c.center_us - min_us < max_us - c.center_us ? c.center_us - min_us : max_us - c.center_us;
+    if (c.step_us > room) c.step_us = room;
+    if (c.chirp_amp_us > room) c.chirp_amp_us = room;
+    uint32_t n = servo_dyn_sample_count(&c);
+    if (capacity < n) return false;
+
+    uint64_t t0 = time_us_64();
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t due = t0 + (uint64_t)i * c.sample_us, now = time_us_64();
+        if (due > now) sleep_us(due - now);
+
+        // 지난 명령의 결과를 먼저 읽고, 읽은 시각 기준의 명령을 곧바로 냄
+        servo_cal_sample_t s;
+        if (!read(arg, &s)) return false;
+        uint32_t t = (uint32_t)(time_us_64() - t0);
+        uint16_t cmd = servo_dyn_command(&c, t);
+        if (!servo_ctx_set_pulse_us(ctx, gpio_num, cmd)) return false;
+        samples[i].t_us = t;
+        samples[i].cmd_us = cmd;
+        samples[i].feedback = s.feedback;
+    }
+    *count = n;
+    return servo_ctx_set_pulse_us(ctx, gpio_num, c.center_us);
+}
+
+bool servo_dyn_fit(const servo_dyn_sample_t *samples, uint32_t count, servo_dyn_fit_t *fit) {
+    memset(fit, 0, sizeof(*fit));
+    if (count < 2) return false;
+    problem_t p = { .s = samples, .n = count };
+    if (!fit_scale(&p, fit)) return false;
+
+    // 1차: 지연 10 ms, 시정수 30 ms에서 시작
+    float q1[3] = { 10000.0f, logf(0.03f), 0.0f };
+    float step1[3] = { 8000.0f, 0.7f, 0.0f };
+    const float lo1[3] = { 0.0f, logf(0.001f), 0.0f }, hi1[3] = { SERVO_DYN_MAX_DELAY_US, logf(1.0f), 0.0f };
+    const float tol1[3] = { 100.0f, 0.01f, 0.0f };
+    pattern_search(&p, 1, q1, step1, lo1, hi1, tol1);
+
+    // 2차: 국소 최소(wn이 아주 크고 지연이 1차만큼 긴 해)에 빠지지 않게 wn / 감쇠비 격자에서 가장 나은 점부터.
+    // 지연은 전체 지연(1차: 지연 + 시정수, 2차: 지연 + 2 zeta / wn)이 1차 결과와 같도록
+    float lag_us = q1[0] + expf(q1[1]) * 1e6f, q2[3] = { 0 }, best = INFINITY;
+    for (uint8_t i = 0; i < sizeof(GRID_WN) / sizeof(GRID_WN[0]); ++i) {
+        for (uint8_t k = 0; k < sizeof(GRID_ZETA) / sizeof(GRID_ZETA[0]); ++k) {
+            float q[3] = { clampf(lag_us - 2e6f * GRID_ZETA[k] / GRID_WN[i], 0.0f, SERVO_DYN_MAX_DELAY_US),
+                           logf(GRID_WN[i]), GRID_ZETA[k] };
+            float c = cost(&p, 2, q);
+            if (c < best) {
+                best = c;
+                memcpy(q2, q, sizeof(q2));
+            }
+        }
+    }
+    float step2[3] = { 2000.0f, 0.3f, 0.2f };
+    const float lo2[3] = { 0.0f, logf(1.0f), 0.05f }, hi2[3] = { SERVO_DYN_MAX_DELAY_US, logf(500.0f), 3.0f };
+    const float tol2[3] = { 100.0f, 0.01f, 0.005f };
+    pattern_search(&p, 2, q2, step2, lo2, hi2, tol2);
+
+    servo_model_t *m = &fit->model;
+    m->slew_us_per_s = (uint16_t)round_u32(p.slew, UINT16_MAX);
+    m->delay1_us = round_u32(q1[0], UINT32_MAX);
+    m->tau_us = round_u32(expf(q1[1]) * 1e6f, UINT32_MAX);
+    m->delay2_us = round_u32(q2[0], UINT32_MAX);
+    m->wn_x100 = (uint16_t)round_u32(expf(q2[1]) * 100.0f, UINT16_MAX);
+    m->zeta_x1000 = (uint16_t)round_u32(q2[2] * 1000.0f, UINT16_MAX);
+    fit->evals = p.evals;
+
+    // 저장하는 (반올림한) 모델로 오차를 다시 계산
+    for (uint8_t order = 0; order <= 2; ++order) fit->rms_us[order] = servo_dyn_predict(fit, order, samples, count, NULL);
+    m->order = fit->rms_us[2] < ORDER2_GAIN * fit->rms_us[1] ? 2 : 1;
+#ifdef DEBUG_SERVO_DYN
+    printf("servo_dyn: slew %u us/s, 1st %lu us + tau %lu us (rms %.1f), 2nd %lu us + wn %.2f zeta %.3f (rms %.1f), "
+           "%u evals\n",
+           m->slew_us_per_s, (unsigned long)m->delay1_us, (unsigned long)m->tau_us, (double)fit->rms_us[1],
+           (unsigned long)m->delay2_us, m->wn_x100 / 100.0, m->zeta_x1000 / 1000.0, (double)fit->rms_us[2],
+           fit->evals);
+#endif
+    return true;
+}
+
+float servo_dyn_predict(const servo_dyn_fit_t *fit, uint8_t order, const servo_dyn_sample_t *samples, uint32_t count,
+                        float *out_us) {
+    if (count == 0 || fit->fb_per_us == 0.0f) return 0.0f;
+    const servo_model_t *m = &fit->model;
+    sim_model_t sm = { .order = order, .slew = (float)m->slew_us_per_s };
+    if (order == 1) {
+        sm.delay_us = (float)m->delay1_us;
+        sm.tau_s = (float)m->tau_us * 1e-6f;
+    } else if (order == 2) {
+        sm.delay_us = (float)m->delay2_us;
+        sm.wn = (float)m->wn_x100 / 100.0f;
+        sm.zeta = (float)m->zeta_x1000 / 1000.0f;
+    }
+    float sse = simulate(&sm, samples, count, fit->fb_offset, 1.0f / fit->fb_per_us, out_us);
+    return sqrtf(sse / (float)count);
+}
+
+bool servo_dyn_run(servo_ctx_t *ctx, uint16_t gpio_num, const servo_dyn_config_t *config, servo_cal_read_fn read,
+                   void *arg, servo_dyn_sample_t *samples, uint32_t capacity, servo_dyn_fit_t *fit) {
+    uint32_t count;
+    if (!servo_dyn_record(ctx, gpio_num, config, read, arg, samples, capacity, &count)) return false;
+    servo_dyn_fit_t result;
+    bool ok = servo_dyn_fit(samples, count, &result);
+    if (fit) *fit = result;
+    return ok && servo_ctx_set_model(ctx, gpio_num, &result.model);
+}
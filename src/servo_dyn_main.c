@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "servo.h"
+#include "servo_cal.h"
+#include "servo_dyn.h"
+
+// 서보 동특성 측정 펌웨어: 서보 위치 피드백(전위차계 와이퍼)을 ADC0(GPIO 26)에 연결해야 함.
+// 피드백으로 끝점을 캘리브레이션한 뒤 계단 + 처프 응답을 기록해 모델을 맞추고, 결과를 JSON 한 줄로,
+// 기록을 CSV(t_us,cmd_us,feedback)로 출력 (호스트 분석: bench_servo_dyn -i 기록.csv)
+
+#define SERVO_DYN_GPIO 2
+#define SERVO_DYN_ADC_GPIO 26
+#define SERVO_DYN_ADC_INPUT 0
+#define SERVO_DYN_BUFFER 3500                 // 기본 설정 3401 샘플 (28 KB)
+
+static servo_dyn_sample_t samples[SERVO_DYN_BUFFER];
+
+static bool read_feedback(void *arg, servo_cal_sample_t *s) {
+    (void)arg;
+    s->current_ma = 0;
+    s->feedback = (int16_t)adc_read();
+    return true;
+}
+
+int main()
+{
+    stdio_init_all();
+    sleep_ms(2000); // 터미널 연결 대기
+
+    adc_init();
+    adc_gpio_init(SERVO_DYN_ADC_GPIO);
+    adc_select_input(SERVO_DYN_ADC_INPUT);
+    if (!servo_init_default(SERVO_DYN_GPIO)) {
+        printf("{\"error\":\"servo init\"}\n");
+        while (true) sleep_ms(1000);
+    }
+
+    servo_cal_config_t cal_config;
+    servo_cal_default_config(&cal_config);
+    cal_config.sense = SERVO_CAL_SENSE_FEEDBACK;
+    servo_cal_result_t cal;
+    if (!servo_cal_run(servo_default_ctx(), SERVO_DYN_GPIO, &cal_config, read_feedback, NULL, &cal)) {
+        printf("{\"error\":\"calibration\"}\n");
+        while (true) sleep_ms(1000);
+    }
+
+    servo_dyn_config_t config;
+    servo_dyn_default_config(&config);
+    servo_dyn_fit_t fit;
+    uint32_t count = 0;
+    bool ok = servo_dyn_record(servo_default_ctx(), SERVO_DYN_GPIO, &config, read_feedback, NULL, samples,
+                               SERVO_DYN_BUFFER, &count);
+    uint64_t t0 = time_us_64();
+    ok = ok && servo_dyn_fit(samples, count, &fit);
+    uint32_t fit_us = (uint32_t)(time_us_64() - t0);
+
+    if (!ok) {
+        printf("{\"error\":\"fit\",\"samples\":%lu}\n", (unsigned long)count);
+    } else {
+        const servo_model_t *m = &fit.model;
+        printf("{\"min_us\":%u,\"max_us\":%u,\"center_us\":%u,\"order\":%u,\"slew_us_per_s\":%u,"
+               "\"delay1_us\":%lu,\"tau_us\":%lu,\"delay2_us\":%lu,\"wn_x100\":%u,\"zeta_x1000\":%u,"
+               "\"rms_us\":[%.2f,%.2f,%.2f],\"samples\":%lu,\"evals\":%u,\"fit_us\":%lu}\n",
+               cal.min_us, cal.max_us, cal.center_us, m->order, m->slew_us_per_s, (unsigned long)m->delay1_us,
+               (unsigned long)m->tau_us, (unsigned long)m->delay2_us, m->wn_x100, m->zeta_x1000,
+               (double)fit.rms_us[0], (double)fit.rms_us[1], (double)fit.rms_us[2], (unsigned long)count, fit.evals,
+               (unsigned long)fit_us);
+        servo_set_model(SERVO_DYN_GPIO, m);
+    }
+
+    printf("t_us,cmd_us,feedback\n");
+    for (uint32_t i = 0; i < count; ++i) {
+        printf("%lu,%u,%d\n", (unsigned long)samples[i].t_us, samples[i].cmd_us, samples[i].feedback);
+    }
+    servo_set(SERVO_DYN_GPIO, 90);
+
+    while (true) {
+        sleep_ms(1000);
+    }
+}
@@ -0,0 +1,50 @@
+#include "spsc_queue.h"
+#include <string.h> // memcpy 사용
+
+bool spsc_queue_init(spsc_queue_t *q, void *storage, uint32_t elem_size, uint32_t slots) {
+    if (!q || !storage || elem_size == 0 || slots == 0 || (slots & (slots - 1)) != 0) {
+        return false;
+    }
+    q->storage = (uint8_t *)storage;
+    q->elem_size = elem_size;
+    q->mask = slots - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->dropped, 0);
+    return true;
+}
+
+bool spsc_queue_push(spsc_queue_t *q, const void *item) {
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    if (head - tail > q->mask) {
+        // 가득 참: 생산자만 쓰므로 fetch_add 대신 load/store로 충분
+        uint32_t dropped = atomic_load_explicit(&q->dropped, memory_order_relaxed);
+        atomic_store_explicit(&q->dropped, dropped + 1, memory_order_relaxed);
+        return false;
+    }
+
+    memcpy(q->storage + (head & q->mask) * q->elem_size, item, q->elem_size);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release); // 데이터 복사 후 공개
+    return true;
+}
+
+bool spsc_queue_pop(spsc_queue_t *q, void *item) {
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    if (head == tail) {
+        return false; // 비어 있음
+    }
+
+    memcpy(item, q->storage + (tail & q->mask) * q->elem_size, q->elem_size);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release); // 슬롯 반환
+    return true;
+}
+
+uint32_t spsc_queue_count(const spsc_queue_t *q) {
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    return head - tail;
+}
@@ -0,0 +1,219 @@
+#include "tlm_rate.h"
+#include <string.h>
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_TLM_RATE
+
+#ifdef DEBUG_TLM_RATE
+#include <stdio.h>
+#endif
+
+// --- 내부 함수 ---
+
+static uint32_t min_budget(const tlm_rate_t *t) {
+    return t->max_bps >> TLM_RATE_MIN_BUDGET_SHIFT;
+}
+
+// 우선순위 순으로 예산 배정 (바이트/s x 10 = 송신률(0.1 Hz) x 프레임 크기 단위)
+static void allocate(tlm_rate_t *t) {
+    uint32_t remaining = (t->budget_bps - (t->budget_bps >> TLM_RATE_EVENT_RESERVE_SHIFT)) * 10u;
+    uint16_t alloc[TLM_RATE_MAX_STREAMS] = { 0 };
+
+    // 1차: 최소 송신률, 2차: 목표 송신률까지
+    for (int pass = 0; pass < 2; ++pass) {
+        for (uint8_t k = 0; k < t->count; ++k) {
+            uint8_t i = t->order[k];
+            const tlm_stream_config_t *c = &t->config[i];
+            if (c->event) continue;
+            uint32_t want = c->rate_dhz[t->phase];
+            if (pass == 0 && want > c->min_rate_dhz) want = c->min_rate_dhz;
+            uint32_t give = want > alloc[i] ? want - alloc[i] : 0;
+            if (give * c->frame_bytes > remaining) give = remaining / c->frame_bytes;
+            alloc[i] = (uint16_t)(alloc[i] + give);
+            remaining -= give * c->frame_bytes;
+        }
+    }
+
+    for (uint8_t i = 0; i < t->count; ++i) {
+        tlm_stream_state_t *s = &t->state[i];
+        if (t->config[i].event) continue;
+        if (s->alloc_dhz == 0 && alloc[i] != 0) s->next_ms = t->last_ms; // 새로 켜진 스트림은 바로 한 번
+        s->alloc_dhz = alloc[i];
+        s->period_ms = alloc[i] ? 10000u / alloc[i] : 0;
+    }
+}
+
+// 이벤트를 놓칠 확률 (1 - 전달률)^k 가 목표 이하가 되는 최소 k
+static uint8_t event_repeat(uint16_t delivery_q8) {
+    uint32_t loss = 256u - (delivery_q8 > 256u ? 256u : delivery_q8);
+    uint32_t miss = 65536u;
+    for (uint8_t k = 1; k < TLM_RATE_MAX_REPEAT; ++k) {
+        miss = (miss * loss) >> 8;
+        if (miss <= TLM_RATE_EVENT_MISS_Q16) return k;
+    }
+    return TLM_RATE_MAX_REPEAT;
+}
+
+// 보고 구간 전달률로 예산/반복 횟수 조정. rate_bps = 보고 구간 동안 실제로 보낸 양 (바이트/s),
+// queued = 버퍼에 쌓이는 중. 줄일 때는 예산과 실제 송신량 중 작은 쪽에서 줄이고 (예산이 남는 단계에서도
+// 바로 효과가 있도록), 늘리는 것은 예산을 절반 이상 쓸 때만 (적게 보내는 단계의 높은 전달률은 용량을 말해 주지 않음)
+static void adapt(tlm_rate_t *t, uint32_t delivered_q8, uint32_t rate_bps, bool queued) {
+    t->delivery_q8 = (uint16_t)((int32_t)t->delivery_q8 + (((int32_t)delivered_q8 - (int32_t)t->delivery_q8) >> TLM_RATE_EWMA_SHIFT));
+    bool fading = t->rssi_dbm != TLM_RATE_RSSI_UNKNOWN && t->rssi_dbm < t->fade_dbm;
+    uint32_t budget = t->budget_bps;
+    if (queued || (delivered_q8 < TLM_RATE_BAD_Q8 && !fading)) {
+        if (budget > rate_bps) budget = rate_bps;
+        budget = budget * 3u / 4u;
+        if (budget < min_budget(t)) budget = min_budget(t);
+    } else if (delivered_q8 >= TLM_RATE_GOOD_Q8 && rate_bps * 2u >= budget) {
+        budget += t->max_bps >> TLM_RATE_INCREASE_SHIFT;
+        if (budget > t->max_bps) budget = t->max_bps;
+    }
+#ifdef DEBUG_TLM_RATE
+    printf("tlm_rate: delivered %lu/256 (avg %u) rssi %d%s%s budget %lu -> %lu B/s\n", (unsigned long)delivered_q8,
+           t->delivery_q8, t->rssi_dbm, fading ? " fading" : "", queued ? " queued" : "", (unsigned long)t->budget_bps, (unsigned long)budget);
+#endif
+    t->budget_bps = budget;
+    t->event_repeat = event_repeat(t->delivery_q8);
+    allocate(t);
+}
+
+static void refill(tlm_rate_t *t, uint32_t now_ms) {
+    uint32_t dt = t->started ? now_ms - t->last_ms : 0;
+    if (dt > 1000u) dt = 1000u;
+    t->started = true;
+    t->last_ms = now_ms;
+
+    uint32_t cap = t->budget_bps * TLM_RATE_BURST_MS;
+    for (uint8_t i = 0; i < t->count; ++i) {
+        if (cap < t->config[i].frame_bytes * 1000u) cap = t->config[i].frame_bytes * 1000u;
+    }
+    t->tokens_mb += t->budget_bps * dt; // 바이트/s x ms = 밀리바이트
+    if (t->tokens_mb > cap) t->tokens_mb = cap;
+}
+
+static int take(tlm_rate_t *t, uint8_t i) {
+    t->tokens_mb -= t->config[i].frame_bytes * 1000u;
+    ++t->state[i].sent;
+    return i;
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool tlm_rate_init(tlm_rate_t *t, const tlm_stream_config_t *streams, uint8_t count, uint32_t max_bps,
+                   int8_t fade_dbm) {
+    if (count == 0 || count > TLM_RATE_MAX_STREAMS || max_bps == 0 || max_bps > 1000000u) return false;
+    memset(t, 0, sizeof(*t));
+    for (uint8_t i = 0; i < count; ++i) {
+        if (streams[i].frame_bytes == 0) return false;
+        t->config[i] = streams[i];
+    }
+    t->count = count;
+
+    // 우선순위 순 (같으면 스트림 번호 순) 삽입 정렬
+    for (uint8_t i = 0; i < count; ++i) {
+        uint8_t j = i;
+        while (j > 0 && t->config[t->order[j - 1]].priority > streams[i].priority) {
+            t->order[j] = t->order[j - 1];
+            --j;
+        }
+        t->order[j] = i;
+    }
+
+    t->max_bps = max_bps;
+    t->budget_bps = max_bps;
+    t->fade_dbm = fade_dbm;
+    t->rssi_dbm = TLM_RATE_RSSI_UNKNOWN;
+    t->delivery_q8 = 256;
+    t->event_repeat = 1;
+    allocate(t);
+    return true;
+}
+
+void tlm_rate_set_phase(tlm_rate_t *t, uint8_t phase) {
+    if (phase >= TLM_RATE_PHASES || phase == t->phase) return;
+    t->phase = phase;
+    allocate(t);
+}
+
+bool tlm_rate_event(tlm_rate_t *t, uint8_t stream) {
+    if (stream >= t->count || !t->config[stream].event) return false;
+    t->state[stream].repeat = t->event_repeat;
+    t->state[stream].next_ms = t->last_ms;
+    return true;
+}
+
+int tlm_rate_next(tlm_rate_t *t, uint32_t now_ms) {
+    refill(t, now_ms);
+
+    // 보고가 끊김: 업링크도 안 들어오는 상태이므로 혼잡/페이드 구분 없이 줄임 (보고를 받은 뒤부터만)
+    if (t->have_report && now_ms - t->report_ms >= TLM_RATE_REPORT_TIMEOUT_MS) {
+        t->report_ms = now_ms;
+        t->rssi_dbm = TLM_RATE_RSSI_UNKNOWN;
+        t->report_bytes = 0;
+        adapt(t, 0, t->budget_bps, false);
+    }
+
+    // 이벤트 먼저 (가장 높은 이벤트가 예산을 기다리는 동안 다른 스트림은 보내지 않음)
+    for (uint8_t k = 0; k < t->count; ++k) {
+        uint8_t i = t->order[k];
+        tlm_stream_state_t *s = &t->state[i];
+        if (!t->config[i].event || s->repeat == 0 || (int32_t)(now_ms - s->next_ms) < 0) continue;
+        if (t->tokens_mb < t->config[i].frame_bytes * 1000u) return -1;
+        --s->repeat;
+        s->next_ms = now_ms + TLM_RATE_REPEAT_GAP_MS;
+        return take(t, i);
+    }
+
+    // 예정 시각이 된 주기 스트림 중 우선순위가 가장 높은 것
+    for (uint8_t k = 0; k < t->count; ++k) {
+        uint8_t i = t->order[k];
+        tlm_stream_state_t *s = &t->state[i];
+        if (t->config[i].event || s->period_ms == 0 || (int32_t)(now_ms - s->next_ms) < 0) continue;
+        if (t->tokens_mb < t->config[i].frame_bytes * 1000u) {
+            ++s->deferred;
+            return -1;
+        }
+        // 늦었으면 밀린 몫을 따라잡지 않고 지금부터 다시 셈 (텔레메트리는 최신 값만 의미 있음)
+        s->next_ms += s->period_ms;
+        if ((int32_t)(now_ms - s->next_ms) >= 0) s->next_ms = now_ms + s->period_ms;
+        return take(t, i);
+    }
+    return -1;
+}
+
+void tlm_rate_sent(tlm_rate_t *t, uint16_t seq, uint32_t bytes) {
+    t->report_bytes += bytes;
+    t->tx_bytes += bytes;
+    t->seq_bytes[seq & (TLM_RATE_SEQ_HISTORY - 1)] = t->tx_bytes;
+    t->tx_seq = (uint16_t)(seq + 1u);
+}
+
+void tlm_rate_report(tlm_rate_t *t, uint16_t last_seq, uint16_t rx_frames, int8_t rssi_dbm, uint32_t now_ms) {
+    t->rssi_dbm = rssi_dbm;
+    if (!t->have_report) {
+        t->have_report = true;
+        t->report_seq = last_seq;
+        t->report_rx = rx_frames;
+        t->report_ms = now_ms;
+        return;
+    }
+    uint16_t sent = (uint16_t)(last_seq - t->report_seq);
+    uint16_t delivered = (uint16_t)(rx_frames - t->report_rx);
+    if (sent >= 0x8000u) return; // 순서가 뒤바뀐 옛 보고
+    uint32_t dt = now_ms - t->report_ms;
+    t->report_ms = now_ms;
+    if (sent == 0 || dt == 0) return;
+    uint32_t rate_bps = (uint32_t)((uint64_t)t->report_bytes * 1000u / dt);
+
+    // 지상국에 아직 닿지 않은 바이트를 지금 송신량으로 나눈 시간 (기록보다 많이 밀렸으면 그 자체로 혼잡)
+    uint16_t outstanding = (uint16_t)(t->tx_seq - 1u - last_seq);
+    uint32_t inflight = t->tx_bytes - t->seq_bytes[last_seq & (TLM_RATE_SEQ_HISTORY - 1)];
+    bool queued = outstanding >= TLM_RATE_SEQ_HISTORY ||
+                  (uint64_t)inflight * 1000u > (uint64_t)rate_bps * TLM_RATE_QUEUE_MS;
+
+    t->report_seq = last_seq;
+    t->report_rx = rx_frames;
+    t->report_bytes = 0;
+    adapt(t, delivered >= sent ? 256u : (uint32_t)delivered * 256u / sent, rate_bps, queued);
+}
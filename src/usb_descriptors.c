@@ -0,0 +1,70 @@
+#include "tusb.h"
+#include "offload_proto.h"
+#include <string.h> // strlen 사용
+
+// USB 로그 오프로드 펌웨어의 디스크립터 (vendor 인터페이스 하나, bulk OUT 0x01 / IN 0x81)
+
+enum {
+    STRID_LANGID = 0,
+    STRID_MANUFACTURER,
+    STRID_PRODUCT,
+    STRID_SERIAL,
+};
+
+static const tusb_desc_device_t device_descriptor = {
+    .bLength = sizeof(tusb_desc_device_t),
+    .bDescriptorType = TUSB_DESC_DEVICE,
+    .bcdUSB = 0x0200,
+    .bDeviceClass = 0x00,
+    .bDeviceSubClass = 0x00,
+    .bDeviceProtocol = 0x00,
+    .bMaxPacketSize0 = CFG_TUD_ENDPOINT0_SIZE,
+    .idVendor = OFFLOAD_USB_VID,
+    .idProduct = OFFLOAD_USB_PID,
+    .bcdDevice = 0x0100,
+    .iManufacturer = STRID_MANUFACTURER,
+    .iProduct = STRID_PRODUCT,
+    .iSerialNumber = STRID_SERIAL,
+    .bNumConfigurations = 1,
+};
+
+#define CONFIG_TOTAL_LEN (TUD_CONFIG_DESC_LEN + TUD_VENDOR_DESC_LEN)
+
+static const uint8_t config_descriptor[] = {
+    TUD_CONFIG_DESCRIPTOR(1, 1, 0, CONFIG_TOTAL_LEN, 0x00, 100),
+    TUD_VENDOR_DESCRIPTOR(0, 0, OFFLOAD_EP_OUT, OFFLOAD_EP_IN, OFFLOAD_EP_SIZE),
+};
+
+static const char *const strings[] = {
+    [STRID_MANUFACTURER] = "CanSat Galaxy",
+    [STRID_PRODUCT] = "CanSat Galaxy Log Offload",
+    [STRID_SERIAL] = "0001",
+};
+
+static uint16_t string_buf[32];
+
+const uint8_t *tud_descriptor_device_cb(void) {
+    return (const uint8_t *)&device_descriptor;
+}
+
+const uint8_t *tud_descriptor_configuration_cb(uint8_t index) {
+    (void)index;
+    return config_descriptor;
+}
+
+const uint16_t *tud_descriptor_string_cb(uint8_t index, uint16_t langid) {
+    (void)langid;
+    uint8_t len;
+    if (index == STRID_LANGID) {
+        string_buf[1] = 0x0409; // 영어
+        len = 1;
+    } else {
+        if (index >= sizeof(strings) / sizeof(strings[0])) return NULL;
+        const char *s = strings[index];
+        len = (uint8_t)strlen(s);
+        if (len > 31) len = 31;
+        for (uint8_t i = 0; i < len; ++i) string_buf[1 + i] = (uint8_t)s[i];
+    }
+    string_buf[0] = (uint16_t)((TUSB_DESC_STRING << 8) | (2 * len + 2));
+    return string_buf;
+}
@@ -0,0 +1,164 @@
+#include "usb_offload.h"
+#include "offload_dev.h"
+#include "fat32_prealloc.h"
+#include "sd_block.h"
+#include "sdlog.h"
+#include "hardware/dma.h"
+#include "hardware/regs/addressmap.h"
+#include "tusb.h"
+#include <string.h> // memcpy 사용
+
+// 디버그 메시지 활성화 (필요 시 주석 해제)
+// #define DEBUG_USB_OFFLOAD
+
+#ifdef DEBUG_USB_OFFLOAD
+#include <stdio.h>
+#endif
+
+// --- 소스 상태 ---
+
+static bool sd_ready;
+static uint32_t sd_first_lba;
+static uint32_t sd_size;
+
+static int flash_dma_chan = -1;
+
+// 진행 중인 읽기
+static uint8_t pending_source;
+static uint8_t *pending_buf;
+static uint32_t pending_offset, pending_len, pending_done;
+static uint8_t bounce[SD_BLOCK_SIZE] __attribute__((aligned(4)));
+
+// --- 소스 ---
+
+static bool source_size(uint8_t source, uint32_t *size) {
+    switch (source) {
+        case OFFLOAD_SRC_SDLOG:
+            if (!sd_ready) return false;
+            *size = sd_size;
+            return true;
+        case OFFLOAD_SRC_FLASH:
+            *size = PICO_FLASH_SIZE_BYTES;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool source_read_start(uint8_t source, uint32_t offset, uint8_t *buf, uint32_t len) {
+    pending_source = source;
+    pending_buf = buf;
+    pending_offset = offset;
+    pending_len = len;
+    pending_done = 0;
+
+    if (source == OFFLOAD_SRC_FLASH) {
+        // XIP 캐시를 거치지 않는 주소에서 읽어 실행 중인 코드의 캐시 라인을 밀어내지 않음
+        bool aligned = ((offset | len) & 3u) == 0;
+        dma_channel_config c = dma_channel_get_default_config((uint)flash_dma_chan);
+        channel_config_set_transfer_data_size(&c, aligned ? DMA_SIZE_32 : DMA_SIZE_8);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, true);
+        dma_channel_configure((uint)flash_dma_chan, &c, buf,
+                              (const void *)(XIP_NOCACHE_NOALLOC_BASE + offset),
+                              aligned ? len / 4 : len, true);
+    }
+    return true;
+}
+
+// SD는 poll 한 번에 블록 하나씩 읽어 tud_task()가 밀리지 않게 함
+static int sd_read_step(void) {
+    uint32_t pos = pending_offset + pending_done;
+    uint32_t lba = sd_first_lba + pos / SD_BLOCK_SIZE;
+    uint32_t within = pos % SD_BLOCK_SIZE;
+    uint32_t take = SD_BLOCK_SIZE - within;
+    if (take > pending_len - pending_done) take = pending_len - pending_done;
+
+    if (within == 0 && take == SD_BLOCK_SIZE) {
+        if (!sd_block_read(lba, pending_buf + pending_done, 1)) return -1;
+    } else {
+        if (!sd_block_read(lba, bounce, 1)) return -1;
+        memcpy(pending_buf + pending_done, bounce + within, take);
+    }
+    pending_done += take;
+    return pending_done == pending_len ? 1 : 0;
+}
+
+static int source_read_poll(void) {
+    if (pending_source == OFFLOAD_SRC_FLASH) {
+        return dma_channel_is_busy((uint)flash_dma_chan) ? 0 : 1;
+    }
+    return sd_read_step();
+}
+
+static const offload_source_ops_t source_ops = {
+    .size = source_size,
+    .read_start = source_read_start,
+    .read_poll = source_read_poll,
+};
+
+// --- TinyUSB vendor 전송 계층 ---
+
+static uint32_t usb_rx(void *buf, uint32_t cap) {
+    if (!tud_vendor_available()) return 0;
+    return tud_vendor_read(buf, cap);
+}
+
+static uint32_t usb_tx(const void *buf, uint32_t len) {
+    uint32_t room = tud_vendor_write_available();
+    if (room == 0) return 0;
+    if (len > room) len = room;
+    return tud_vendor_write(buf, len);
+}
+
+static void usb_tx_flush(void) {
+    tud_vendor_write_flush();
+}
+
+static const offload_transport_t transport = {
+    .rx = usb_rx,
+    .tx = usb_tx,
+    .tx_flush = usb_tx_flush,
+};
+
+// --- 라이브러리 함수 구현 ---
+
+bool usb_offload_init(void) {
+    if (flash_dma_chan < 0) flash_dma_chan = dma_claim_unused_channel(true);
+
+    sd_ready = false;
+    fat32_extent_t extent;
+    if (sd_block_init() && fat32_find_contiguous(SDLOG_FILE_NAME, &extent) && extent.block_count >= 2) {
+        static uint8_t block[SD_BLOCK_SIZE] __attribute__((aligned(4)));
+        uint32_t full = extent.block_count * SD_BLOCK_SIZE;
+        sd_first_lba = extent.first_lba;
+        sd_size = full;
+        if (sd_block_read(extent.first_lba, block, 1)) {
+            sdlog_header_t header;
+            memcpy(&header, block, sizeof(header));
+            // 정상 종료된 로그는 기록된 만큼만, 비정상 종료(bytes_written 0)는 파일 전체
+            if (header.magic == SDLOG_HEADER_MAGIC && header.bytes_written != 0 &&
+                header.bytes_written <= full - SD_BLOCK_SIZE) {
+                sd_size = SD_BLOCK_SIZE + header.bytes_written;
+            }
+        }
+        sd_ready = true;
+    }
+
+#ifdef DEBUG_USB_OFFLOAD
+    if (sd_ready) {
+        printf("Offload: %s %lu bytes at LBA %lu.\n", SDLOG_FILE_NAME, (unsigned long)sd_size,
+               (unsigned long)sd_first_lba);
+    } else {
+        printf("Offload: no SD log, flash only.\n");
+    }
+#endif
+
+    offload_dev_init(&source_ops, &transport);
+    return sd_ready;
+}
+
+void usb_offload_task(void) {
+    if (!tud_mounted()) return;
+    offload_dev_poll();
+}
@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "tusb.h"
+#include "usb_offload.h"
+
+// 로그 오프로드 펌웨어: 착륙 후 이 이미지로 부팅해 USB로 SD 로그/플래시를 내려받음.
+// USB는 vendor 인터페이스가 차지하므로 stdio는 UART만 사용합니다.
+int main()
+{
+    stdio_init_all();
+    tusb_init();
+
+    bool have_log = usb_offload_init();
+    printf("Log offload ready (%s).\n", have_log ? "SD log + flash" : "flash only");
+
+    while (true) {
+        tud_task();
+        usb_offload_task();
+    }
+}
@@ -0,0 +1,218 @@
+#include "vibration.h"
+#include "fxmath.h"
+#include <string.h>
+
+#define HALF (VIBRATION_FFT_SIZE / 2)
+
+// 파워 dB = 10 log10(2) x log2 = log2_q8 x 771 / 65536
+#define DB_FROM_L2(l2) (((l2) * 771) >> 16)
+#define L2_FROM_DB(db) (((db) << 16) / 771)
+
+// --- 내부 함수 ---
+
+// floor(log2(p)), p > 0
+static int32_t ilog2(uint32_t p) {
+    int32_t n = 0;
+    if (p >= 1u << 16) { p >>= 16; n += 16; }
+    if (p >= 1u << 8) { p >>= 8; n += 8; }
+    if (p >= 1u << 4) { p >>= 4; n += 4; }
+    if (p >= 1u << 2) { p >>= 2; n += 2; }
+    if (p >= 1u << 1) { n += 1; }
+    return n;
+}
+
+// log2(p), 소수부 8비트 (p = 0이면 0). 가수를 Q15로 맞춘 뒤 제곱을 반복해 한 비트씩 구함
+static int32_t log2_q8(uint32_t p) {
+    if (p == 0) return 0;
+    int32_t n = ilog2(p);
+    uint32_t m = n >= 15 ? p >> (n - 15) : p << (15 - n);  // [32768, 65536) = [1, 2)
+    int32_t frac = 0;
+    for (int i = 0; i < 8; ++i) {
+        m = (m * m) >> 15;
+        frac <<= 1;
+        if (m >= 65536u) {
+            m >>= 1;
+            frac |= 1;
+        }
+    }
+    return (n << 8) | frac;
+}
+
+// Hann 창 스캘럽 손실 보정 1 / |W(d)| (d = 빈 중심에서 떨어진 거리 0 ~ 1/2, 1/32 간격, Q14)
+// |W(d)| / |W(0)| = sinc(d) / (1 - d^2)
+static const uint16_t scallop_q14[17] = {
+    16384, 16394, 16425, 16477, 16550, 16644, 16761, 16899, 17061,
+    17246, 17456, 17692, 17954, 18245, 18565, 18917, 19302,
+};
+
+// |delta| (Q8, 0 ~ 128)에서 보정값을 선형 보간
+static uint32_t scallop_gain_q14(int32_t delta_q8) {
+    uint32_t d = (uint32_t)(delta_q8 < 0 ? -delta_q8 : delta_q8);
+    if (d >= 128u) return scallop_q14[16];
+    uint32_t i = d >> 3, f = d & 7u;
+    return (scallop_q14[i] * (8u - f) + scallop_q14[i + 1] * f + 4u) >> 3;
+}
+
+static void publish(vibration_t *v, const vibration_result_t *r) {
+    uint32_t seq = atomic_load_explicit(&v->result_seq, memory_order_relaxed);
+    atomic_store_explicit(&v->result_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    v->result = *r;
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&v->result_seq, seq + 2, memory_order_relaxed);
+}
+
+// --- 라이브러리 함수 구현 ---
+
+bool vibration_init(vibration_t *v, uint32_t sample_rate_hz) {
+    if (sample_rate_hz == 0 || sample_rate_hz > VIBRATION_MAX_RATE_HZ) return false;
+    memset(v, 0, sizeof(*v));
+    if (!spsc_queue_init(&v->blocks, v->block_slots, sizeof(v->block_slots[0]), VIBRATION_QUEUE_BLOCKS)) {
+        return false;
+    }
+    fxfft_init();
+    // 주기형 Hann: w[i] = (1 - cos(2 pi i / N)) / 2
+    for (uint32_t i = 0; i < VIBRATION_FFT_SIZE; ++i) {
+        v->window[i] = (int16_t)((32768 - fx_cos((fx_angle_t)(i << (16 - VIBRATION_FFT_LOG2)))) >> 1);
+    }
+    v->sample_rate_hz = sample_rate_hz;
+    return true;
+}
+
+void vibration_add_samples(vibration_t *v, const int16_t *samples, size_t n) {
+    while (n > 0) {
+        size_t take = VIBRATION_FFT_SIZE - v->fill_count;
+        if (take > n) take = n;
+        memcpy(&v->fill[v->fill_count], samples, take * sizeof(int16_t));
+        v->fill_count += (uint16_t)take;
+        samples += take;
+        n -= take;
+        if (v->fill_count == VIBRATION_FFT_SIZE) {
+            spsc_queue_push(&v->blocks, v->fill); // 가득 차면 버림 (dropped 증가)
+            v->fill_count = 0;
+        }
+    }
+}
+
+bool vibration_process(vibration_t *v) {
+    // 블록을 work의 실수부 자리에 잠시 받음 (int16_t 2개 = fxfft_cpx_t 1개 크기)
+    int16_t *block = (int16_t *)&v->work[HALF];
+    if (!spsc_queue_pop(&v->blocks, block)) return false;
+
+    // 평균(자이로 바이어스/중력) 제거 후 창 적용
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < VIBRATION_FFT_SIZE; ++i) sum += block[i];
+    int32_t mean = (sum + HALF) >> VIBRATION_FFT_LOG2;
+    // work[i]를 쓰면 block[2i - N], block[2i - N + 1]이 덮이는데 둘 다 이미 읽은 샘플이므로 제자리로 풀어 씀
+    for (uint32_t i = 0; i < VIBRATION_FFT_SIZE; ++i) {
+        int32_t d = block[i] - mean;
+        if (d > INT16_MAX) d = INT16_MAX;
+        if (d < INT16_MIN) d = INT16_MIN;
+        v->work[i].re = (int16_t)((d * v->window[i] + (1 << 14)) >> 15);
+        v->work[i].im = 0;
+    }
+    int e = fxfft_forward(v->work, VIBRATION_FFT_LOG2);
+
+    // 파워 스펙트럼 (실수 입력이므로 0 ~ N/2 - 1만)
+    for (uint32_t k = 0; k < HALF; ++k) {
+        int32_t re = v->work[k].re, im = v->work[k].im;
+        v->power[k] = (uint32_t)(re * re) + (uint32_t)(im * im);
+    }
+
+    // 분석 대역 [kmin, N/2 - 1). 평균을 빼도 Hann 주엽이 걸치는 빈 0, 1은 제외
+    uint32_t kmin = (VIBRATION_MIN_FREQ_DHZ * VIBRATION_FFT_SIZE + 10 * v->sample_rate_hz - 1) / (10 * v->sample_rate_hz);
+    if (kmin < 2) kmin = 2;
+
+    // 잡음 바닥: 로그 파워 중앙값 (반 옥타브 = 1.5 dB 히스토그램)
+    uint16_t hist[64] = { 0 };
+    uint32_t bins = 0;
+    for (uint32_t k = kmin; k < HALF; ++k) {
+        ++hist[log2_q8(v->power[k]) >> 7];
+        ++bins;
+    }
+    int32_t floor_l2 = 0;
+    for (uint32_t b = 0, acc = 0; b < 64; ++b) {
+        acc += hist[b];
+        if (2 * acc >= bins) {
+            floor_l2 = (int32_t)(b << 7) + 64;
+            break;
+        }
+    }
+
+    // 잡음 바닥보다 충분히 높은 극대점 중 파워 상위 VIBRATION_MAX_PEAKS개 (내림차순 삽입)
+    uint32_t top_k[VIBRATION_MAX_PEAKS];
+    uint8_t ntop = 0;
+    int32_t min_l2 = floor_l2 + L2_FROM_DB(VIBRATION_MIN_SNR_DB);
+    for (uint32_t k = kmin; k < HALF - 1; ++k) {
+        uint32_t p = v->power[k];
+        if (p <= v->power[k - 1] || p < v->power[k + 1]) continue;
+        if (ntop == VIBRATION_MAX_PEAKS && p <= v->power[top_k[ntop - 1]]) continue;
+        if (log2_q8(p) < min_l2) continue;
+        uint8_t j = ntop < VIBRATION_MAX_PEAKS ? ntop++ : ntop - 1;
+        while (j > 0 && v->power[top_k[j - 1]] < p) {
+            top_k[j] = top_k[j - 1];
+            --j;
+        }
+        top_k[j] = k;
+    }
+
+    vibration_result_t r;
+    memset(&r, 0, sizeof(r));
+    r.block_seq = ++v->block_seq;
+    int32_t strongest_l2 = 0;
+    for (uint8_t i = 0; i < ntop; ++i) {
+        uint32_t k = top_k[i];
+        int32_t la = log2_q8(v->power[k - 1]);
+        int32_t lb = log2_q8(v->power[k]);
+        int32_t lc = log2_q8(v->power[k + 1]);
+        if (i == 0) {
+            strongest_l2 = lb;
+        } else if (lb < strongest_l2 - L2_FROM_DB(VIBRATION_DYN_RANGE_DB)) {
+            break; // 이후 피크는 더 약함 (강한 피크의 부엽일 수 있음)
+        }
+
+        // 로그 파워 3점 포물선의 꼭짓점 위치 delta (빈, Q8). Hann 주엽은 로그 영역에서 포물선에 가까움
+        int32_t den = la - 2 * lb + lc;
+        int32_t delta = den < 0 ? (128 * (la - lc)) / den : 0;
+        if (delta > 128) delta = 128;
+        if (delta < -128) delta = -128;
+
+        // 주파수 = (k + delta) x rate / N (0.1 Hz 단위, 반올림)
+        uint32_t kq = (uint32_t)((int32_t)(k << 8) + delta);
+        uint32_t freq = (kq * v->sample_rate_hz * 5u + (1u << (VIBRATION_FFT_LOG2 + 6))) >> (VIBRATION_FFT_LOG2 + 7);
+
+        // 진폭 = |X| x 2^e x 4 / N (Hann 창 이득 1/2, 양쪽 스펙트럼 중 한쪽) x 스캘럽 보정
+        uint32_t amp = (fx_isqrt(v->power[k]) * scallop_gain_q14(delta) + (1u << 13)) >> 14;
+        int shift = e + 2 - VIBRATION_FFT_LOG2;
+        if (shift >= 0) {
+            amp = amp > (65535u >> shift) ? 65535u : amp << shift;
+        } else {
+            amp = (amp + (1u << (-shift - 1))) >> -shift;
+        }
+
+        int32_t snr = DB_FROM_L2(lb - floor_l2);
+        vibration_peak_t *pk = &r.peaks[r.count++];
+        pk->freq_dhz = (uint16_t)(freq > 65535u ? 65535u : freq);
+        pk->amplitude = (uint16_t)(amp > 65535u ? 65535u : amp);
+        pk->snr_db = (uint8_t)(snr > 255 ? 255 : snr);
+    }
+
+    publish(v, &r);
+    return true;
+}
+
+bool vibration_get_result(const vibration_t *v, vibration_result_t *out) {
+    uint32_t s1, s2;
+    do {
+        s1 = atomic_load_explicit(&v->result_seq, memory_order_acquire);
+        *out = v->result;
+        atomic_thread_fence(memory_order_acquire);
+        s2 = atomic_load_explicit(&v->result_seq, memory_order_relaxed);
+    } while ((s1 & 1u) || s1 != s2);
+    return s1 != 0;
+}
+
+bool vibration_notch(const vibration_peak_t *peak, uint32_t filter_rate_hz, float q, fxfilter_biquad_coef_t *coef) {
+    if (filter_rate_hz == 0 || peak->freq_dhz == 0 || peak->freq_dhz >= filter_rate_hz * 5u) return false;
+    return fxfilter_design_notch(coef, (float)peak->freq_dhz / (10.0f * (float)filter_rate_hz), q);
+}